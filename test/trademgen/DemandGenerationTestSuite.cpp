@@ -9,7 +9,13 @@
 #include <sstream>
 #include <fstream>
 #include <map>
+#include <set>
+#include <vector>
+#include <algorithm>
+#include <string>
 #include <cmath>
+#include <cctype>
+#include <thread>
 // Boost Unit Test Framework (UTF)
 #define BOOST_TEST_DYN_LINK
 #define BOOST_TEST_MAIN
@@ -17,6 +23,7 @@
 #include <boost/test/unit_test.hpp>
 // StdAir
 #include <stdair/stdair_basic_types.hpp>
+#include <stdair/stdair_date_time_types.hpp>
 #include <stdair/basic/BasConst_General.hpp>
 #include <stdair/basic/BasLogParams.hpp>
 #include <stdair/basic/BasDBParams.hpp>
@@ -28,7 +35,20 @@
 // TraDemGen
 #include <trademgen/TRADEMGEN_Exceptions.hpp>
 #include <trademgen/TRADEMGEN_Service.hpp>
+#include <trademgen/RequestSink.hpp>
+#include <trademgen/basic/ArrivalCountTable.hpp>
+#include <trademgen/basic/RequestFieldMask.hpp>
+#include <trademgen/bom/DemandAdjustmentStruct.hpp>
+#include <trademgen/bom/DemandFilterStruct.hpp>
+#include <trademgen/bom/DemandScenarioStruct.hpp>
 #include <trademgen/bom/DemandStreamKey.hpp>
+#include <trademgen/command/RequestPipeline.hpp>
+#include <trademgen/command/RequestShardWriter.hpp>
+#include <trademgen/command/RequestShardMerger.hpp>
+#include <trademgen/command/SharedRequestRingReader.hpp>
+#include <trademgen/command/SharedRequestRingWriter.hpp>
+#include <trademgen/command/DemandGenerationClient.hpp>
+#include <trademgen/service/DemandGenerationServer.hpp>
 #include <trademgen/config/trademgen-paths.hpp>
 
 namespace boost_utf = boost::unit_test;
@@ -347,6 +367,278 @@ void testDemandGenerationHelper (const unsigned short iTestFlag,
 
 }
 
+// //////////////////////////////////////////////////////////////////////
+/**
+ * Pop the booking requests out of the event queue (at most the given
+ * number of them), generating the next ones along the way, and return
+ * their descriptions, in the order of the generation.
+ */
+std::vector<std::string>
+generateNextRequests (TRADEMGEN::TRADEMGEN_Service& ioTrademgenService,
+                      const stdair::DemandGenerationMethod& iDemandGenerationMethod,
+                      const std::size_t iMaxNbOfRequests = std::size_t (-1)) {
+  std::vector<std::string> oRequestList;
+
+  while (ioTrademgenService.isQueueDone() == false
+         && oRequestList.size() != iMaxNbOfRequests) {
+    stdair::EventStruct lEventStruct;
+    stdair::ProgressStatusSet lPPS = ioTrademgenService.popEvent (lEventStruct);
+
+    const stdair::BookingRequestStruct& lPoppedRequest =
+      lEventStruct.getBookingRequest();
+    oRequestList.push_back (lPoppedRequest.describe());
+
+    const stdair::DemandGeneratorKey_T& lDemandStreamKey =
+      lPoppedRequest.getDemandGeneratorKey();
+    if (ioTrademgenService.
+        stillHavingRequestsToBeGenerated (lDemandStreamKey, lPPS,
+                                          iDemandGenerationMethod) == true) {
+      ioTrademgenService.generateNextRequest (lDemandStreamKey,
+                                              iDemandGenerationMethod);
+    }
+  }
+  return oRequestList;
+}
+
+// //////////////////////////////////////////////////////////////////////
+/**
+ * Generate all the booking requests of a single run, and return their
+ * descriptions, in the order of the generation.
+ */
+std::vector<std::string>
+generateAllRequests (TRADEMGEN::TRADEMGEN_Service& ioTrademgenService,
+                     const stdair::DemandGenerationMethod& iDemandGenerationMethod) {
+  ioTrademgenService.generateFirstRequests (iDemandGenerationMethod);
+  return generateNextRequests (ioTrademgenService, iDemandGenerationMethod);
+}
+
+// //////////////////////////////////////////////////////////////////////
+/**
+ * Generate all the booking requests of a single run, and return their
+ * demand stream keys and date-times, in the order of the generation
+ * (the willingness-to-pay depending on the order in which the demand
+ * streams draw with the shared generator).
+ */
+std::vector<std::string>
+generateAllRequestDateTimes (TRADEMGEN::TRADEMGEN_Service& ioTrademgenService,
+                             const stdair::DemandGenerationMethod& iDemandGenerationMethod) {
+  std::vector<std::string> oRequestList;
+
+  ioTrademgenService.generateFirstRequests (iDemandGenerationMethod);
+  while (ioTrademgenService.isQueueDone() == false) {
+    stdair::EventStruct lEventStruct;
+    stdair::ProgressStatusSet lPPS = ioTrademgenService.popEvent (lEventStruct);
+    if (lEventStruct.getEventType() != stdair::EventType::BKG_REQ) {
+      continue;
+    }
+
+    const stdair::BookingRequestStruct& lPoppedRequest =
+      lEventStruct.getBookingRequest();
+    const stdair::DemandGeneratorKey_T& lDemandStreamKey =
+      lPoppedRequest.getDemandGeneratorKey();
+    std::ostringstream oStr;
+    oStr << lDemandStreamKey << " " << lPoppedRequest.getRequestDateTime();
+    oRequestList.push_back (oStr.str());
+
+    if (ioTrademgenService.
+        stillHavingRequestsToBeGenerated (lDemandStreamKey, lPPS,
+                                          iDemandGenerationMethod) == true) {
+      ioTrademgenService.generateNextRequest (lDemandStreamKey,
+                                              iDemandGenerationMethod);
+    }
+  }
+  return oRequestList;
+}
+
+
+// //////////////////////////////////////////////////////////////////////
+/**
+ * Get the demand stream keys of the given booking requests, as returned
+ * by generateAllRequestDateTimes() (the request date-time being made of
+ * the last two words).
+ */
+std::set<std::string>
+getDemandStreamKeySet (const std::vector<std::string>& iRequestList) {
+  std::set<std::string> oDemandStreamKeySet;
+  for (std::vector<std::string>::const_iterator itRequest =
+         iRequestList.begin(); itRequest != iRequestList.end(); ++itRequest) {
+    const std::string& lRequest = *itRequest;
+    const std::size_t lTimePos = lRequest.rfind (' ');
+    const std::size_t lDatePos = lRequest.rfind (' ', lTimePos - 1);
+    oDemandStreamKeySet.insert (lRequest.substr (0, lDatePos));
+  }
+  return oDemandStreamKeySet;
+}
+
+// //////////////////////////////////////////////////////////////////////
+/**
+ * Copy the given demand input file, commenting out its first demand
+ * (i.e., the first line, out of the comments, starting with a letter).
+ */
+void removeFirstDemand (const stdair::Filename_T& iInputFilename,
+                        const stdair::Filename_T& iOutputFilename) {
+  std::ifstream lInputFile (iInputFilename.c_str());
+  std::ofstream lOutputFile (iOutputFilename.c_str());
+
+  bool isWithinComment = false;
+  bool hasRemovedDemand = false;
+  std::string lLine;
+  while (std::getline (lInputFile, lLine)) {
+    if (isWithinComment == false && hasRemovedDemand == false
+        && lLine.empty() == false && std::isalpha (lLine[0]) != 0) {
+      lOutputFile << "// ";
+      hasRemovedDemand = true;
+    }
+    lOutputFile << lLine << std::endl;
+
+    const std::size_t lOpeningPos = lLine.rfind ("/*");
+    const std::size_t lClosingPos = lLine.rfind ("*/");
+    if (lOpeningPos != std::string::npos
+        && (lClosingPos == std::string::npos || lClosingPos < lOpeningPos)) {
+      isWithinComment = true;
+    } else if (lClosingPos != std::string::npos) {
+      isWithinComment = false;
+    }
+  }
+}
+
+// //////////////////////////////////////////////////////////////////////
+/**
+ * Sink keeping the descriptions of the booking requests, prefixed by
+ * their run number.
+ */
+class RequestListSink : public TRADEMGEN::RequestSink {
+public:
+  RequestListSink() : _runNumber (0) {}
+
+  void setRunNumber (const unsigned int iRunNumber) {
+    _runNumber = iRunNumber;
+  }
+
+  void write (const stdair::BookingRequestStruct& iRequest) {
+    std::ostringstream oStr;
+    oStr << _runNumber << ": " << iRequest.describe();
+    _requestList.push_back (oStr.str());
+    _demandStreamKeyList.push_back (iRequest.getDemandGeneratorKey());
+  }
+
+  unsigned int _runNumber;
+  std::vector<std::string> _requestList;
+  std::vector<std::string> _demandStreamKeyList;
+};
+
+// //////////////////////////////////////////////////////////////////////
+/**
+ * Sink counting the booking requests, and the passengers thereof.
+ */
+class PassengerCountSink : public TRADEMGEN::RequestSink {
+public:
+  PassengerCountSink() : _nbOfRequests (0), _nbOfPassengers (0) {}
+
+  void write (const stdair::BookingRequestStruct& iRequest) {
+    ++_nbOfRequests;
+    _nbOfPassengers += iRequest.getPartySize();
+  }
+
+  unsigned int _nbOfRequests;
+  unsigned int _nbOfPassengers;
+};
+
+// //////////////////////////////////////////////////////////////////////
+/**
+ * Sink gathering the demand streams of the booking requests, counting
+ * the passengers of every cabin, and checking that the preferred cabin
+ * of every booking request is one of the cabins of its demand stream
+ * (e.g., "C/Y").
+ */
+class CabinRequestSink : public TRADEMGEN::RequestSink {
+public:
+  CabinRequestSink() : _nbOfRequests (0), _nbOfMisplacedRequests (0) {}
+
+  void write (const stdair::BookingRequestStruct& iRequest) {
+    const std::string& lDemandStreamKey = iRequest.getDemandGeneratorKey();
+    _demandStreamKeySet.insert (lDemandStreamKey);
+    ++_nbOfRequests;
+
+    const std::string lCabins =
+      "/" + lDemandStreamKey.substr (lDemandStreamKey.rfind (' ') + 1) + "/";
+    const std::string lCabin = "/" + iRequest.getPreferredCabin() + "/";
+    if (lCabins.find (lCabin) == std::string::npos) {
+      ++_nbOfMisplacedRequests;
+    }
+    _nbOfPassengersByCabin[iRequest.getPreferredCabin()] +=
+      iRequest.getPartySize();
+  }
+
+  std::set<std::string> _demandStreamKeySet;
+  std::map<std::string, unsigned int> _nbOfPassengersByCabin;
+  unsigned int _nbOfRequests;
+  unsigned int _nbOfMisplacedRequests;
+};
+
+// //////////////////////////////////////////////////////////////////////
+/**
+ * Sink gathering the demand stream, date-time, preferred cabin and WTP
+ * of the booking requests, along with the WTP of the first booking
+ * request of every demand stream, and counting the booking requests
+ * the POS or channel of which are drawn.
+ */
+class ProjectedRequestSink : public TRADEMGEN::RequestSink {
+public:
+  ProjectedRequestSink() : _nbOfRequestsWithPOS (0),
+                           _nbOfRequestsWithChannel (0) {}
+
+  void write (const stdair::BookingRequestStruct& iRequest) {
+    std::ostringstream oStr;
+    oStr << iRequest.getDemandGeneratorKey() << " "
+         << iRequest.getRequestDateTime() << " "
+         << iRequest.getPreferredCabin() << " " << iRequest.getWTP();
+    _requestList.push_back (oStr.str());
+    const std::string& lDemandStreamKey = iRequest.getDemandGeneratorKey();
+    _firstWTPByDemandStream.insert (std::make_pair (lDemandStreamKey,
+                                                    iRequest.getWTP()));
+    if (iRequest.getPOS().empty() == false) {
+      ++_nbOfRequestsWithPOS;
+    }
+    if (iRequest.getBookingChannel().empty() == false) {
+      ++_nbOfRequestsWithChannel;
+    }
+  }
+
+  std::vector<std::string> _requestList;
+  std::map<std::string, stdair::WTP_T> _firstWTPByDemandStream;
+  unsigned int _nbOfRequestsWithPOS;
+  unsigned int _nbOfRequestsWithChannel;
+};
+
+// //////////////////////////////////////////////////////////////////////
+/**
+ * Sink summing up the sampling weights of the booking requests.
+ */
+class WeightedRequestSink : public TRADEMGEN::RequestSink {
+public:
+  WeightedRequestSink (const TRADEMGEN::TRADEMGEN_Service& iService)
+    : _trademgenService (iService), _nbOfRequests (0),
+      _weightedNbOfRequests (0.0), _minWeight (0.0), _maxWeight (0.0) {}
+
+  void write (const stdair::BookingRequestStruct& iRequest) {
+    const double lWeight = _trademgenService.getSamplingWeight (iRequest);
+    if (_nbOfRequests == 0 || lWeight < _minWeight) {
+      _minWeight = lWeight;
+    }
+    if (_nbOfRequests == 0 || lWeight > _maxWeight) {
+      _maxWeight = lWeight;
+    }
+    ++_nbOfRequests;
+    _weightedNbOfRequests += lWeight;
+  }
+
+  const TRADEMGEN::TRADEMGEN_Service& _trademgenService;
+  unsigned int _nbOfRequests;
+  double _weightedNbOfRequests;
+  double _minWeight;
+  double _maxWeight;
+};
 
 // /////////////// Main: Unit Test Suite //////////////
 
@@ -431,6 +723,1678 @@ BOOST_AUTO_TEST_CASE (trademgen_poisson_process_test) {
   
 }
 
+/**
+ * Test the compiled demand model: loading it must give exactly the same
+ * demand streams (and thus booking requests) as parsing the demand input
+ * file it has been compiled from
+ */
+BOOST_AUTO_TEST_CASE (trademgen_compiled_demand_model_test) {
+
+  // Input file name, and compiled demand model file name
+  const stdair::Filename_T lInputFilename (STDAIR_SAMPLE_DIR "/demand01.csv");
+  const stdair::Filename_T lCompiledFilename ("DemandGenerationTestSuite.tdgm");
+  const TRADEMGEN::DemandFilePath lDemandFilePath (lInputFilename);
+
+  // Generate the date time of the requests with the statistic order method.
+  const stdair::DemandGenerationMethod lDemandGenerationMethod (stdair::DemandGenerationMethod::STA_ORD);
+
+  // Output log File
+  std::ofstream logOutputFile;
+  logOutputFile.open ("DemandGenerationTestSuite_compiled.log");
+  logOutputFile.clear();
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+
+  // Compile the demand input file
+  {
+    TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                   stdair::DEFAULT_RANDOM_SEED);
+    BOOST_CHECK_NO_THROW (trademgenService.compileDemand (lDemandFilePath,
+                                                          lCompiledFilename));
+  }
+
+  // Reference: parse the demand input file
+  std::vector<std::string> lParsedRequestList;
+  stdair::Count_T lParsedExpectedNbOfEvents (0);
+  {
+    TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                   stdair::DEFAULT_RANDOM_SEED);
+    trademgenService.parseAndLoad (lDemandFilePath);
+    lParsedExpectedNbOfEvents =
+      trademgenService.getExpectedTotalNumberOfRequestsToBeGenerated();
+    lParsedRequestList = generateAllRequests (trademgenService,
+                                              lDemandGenerationMethod);
+  }
+
+  // Load the compiled demand model
+  std::vector<std::string> lCompiledRequestList;
+  stdair::Count_T lCompiledExpectedNbOfEvents (0);
+  {
+    TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                   stdair::DEFAULT_RANDOM_SEED);
+    trademgenService.loadCompiledModel (lCompiledFilename);
+    lCompiledExpectedNbOfEvents =
+      trademgenService.getExpectedTotalNumberOfRequestsToBeGenerated();
+    lCompiledRequestList = generateAllRequests (trademgenService,
+                                                lDemandGenerationMethod);
+  }
+
+  // Close the log file
+  logOutputFile.close();
+
+  BOOST_CHECK_EQUAL (std::floor (lParsedExpectedNbOfEvents), 40);
+  BOOST_CHECK_EQUAL (lCompiledExpectedNbOfEvents, lParsedExpectedNbOfEvents);
+  BOOST_CHECK (lParsedRequestList.empty() == false);
+  BOOST_CHECK (lCompiledRequestList == lParsedRequestList);
+}
+
+/**
+ * Test that loading the demand input file with several threads gives the
+ * same booking requests as loading it with a single one
+ */
+BOOST_AUTO_TEST_CASE (trademgen_parallel_loading_test) {
+
+  // Input file name
+  const stdair::Filename_T lInputFilename (STDAIR_SAMPLE_DIR "/demand01.csv");
+  TRADEMGEN::DemandFilePathList_T lDemandFilePathList;
+  lDemandFilePathList.push_back (TRADEMGEN::DemandFilePath (lInputFilename));
+
+  // Generate the date time of the requests with the statistic order method.
+  const stdair::DemandGenerationMethod lDemandGenerationMethod (stdair::DemandGenerationMethod::STA_ORD);
+
+  // Output log File
+  std::ofstream logOutputFile;
+  logOutputFile.open ("DemandGenerationTestSuite_parallel.log");
+  logOutputFile.clear();
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+
+  // Reference: load the demand input file with a single thread
+  std::vector<std::string> lSerialRequestList;
+  stdair::Count_T lSerialExpectedNbOfEvents (0);
+  {
+    TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                   stdair::DEFAULT_RANDOM_SEED);
+    trademgenService.parseAndLoad (lDemandFilePathList, 1);
+    lSerialExpectedNbOfEvents =
+      trademgenService.getExpectedTotalNumberOfRequestsToBeGenerated();
+    lSerialRequestList = generateAllRequests (trademgenService,
+                                              lDemandGenerationMethod);
+  }
+
+  // Load the demand input file with several threads
+  std::vector<std::string> lParallelRequestList;
+  stdair::Count_T lParallelExpectedNbOfEvents (0);
+  {
+    TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                   stdair::DEFAULT_RANDOM_SEED);
+    trademgenService.parseAndLoad (lDemandFilePathList, 4);
+    lParallelExpectedNbOfEvents =
+      trademgenService.getExpectedTotalNumberOfRequestsToBeGenerated();
+    lParallelRequestList = generateAllRequests (trademgenService,
+                                                lDemandGenerationMethod);
+  }
+
+  // Close the log file
+  logOutputFile.close();
+
+  BOOST_CHECK_EQUAL (lParallelExpectedNbOfEvents, lSerialExpectedNbOfEvents);
+  BOOST_CHECK (lSerialRequestList.empty() == false);
+  BOOST_CHECK (lParallelRequestList == lSerialRequestList);
+}
+
+/**
+ * Test the incremental reloading of the demand input file: reloading
+ * the same file changes nothing, whereas removing a demand decreases
+ * the expected number of requests, and adding it back gives again the
+ * very same requests.
+ */
+BOOST_AUTO_TEST_CASE (trademgen_reload_demand_test) {
+
+  // Input file names
+  const stdair::Filename_T lInputFilename (STDAIR_SAMPLE_DIR "/demand01.csv");
+  const stdair::Filename_T
+    lReducedInputFilename ("DemandGenerationTestSuite_reload.csv");
+  removeFirstDemand (lInputFilename, lReducedInputFilename);
+
+  // Generate the date time of the requests with the statistic order method.
+  const stdair::DemandGenerationMethod lDemandGenerationMethod (stdair::DemandGenerationMethod::STA_ORD);
+
+  // Output log File
+  std::ofstream logOutputFile;
+  logOutputFile.open ("DemandGenerationTestSuite_reload.log");
+  logOutputFile.clear();
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+
+  // Reference: load the demand input file once
+  std::vector<std::string> lReferenceRequestList;
+  stdair::Count_T lReferenceExpectedNbOfEvents (0);
+  {
+    TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                   stdair::DEFAULT_RANDOM_SEED);
+    trademgenService.parseAndLoad (lInputFilename);
+    lReferenceExpectedNbOfEvents =
+      trademgenService.getExpectedTotalNumberOfRequestsToBeGenerated();
+    trademgenService.reset();
+    lReferenceRequestList = generateAllRequests (trademgenService,
+                                                 lDemandGenerationMethod);
+  }
+
+  // Reload the same demand input file: nothing changes
+  {
+    TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                   stdair::DEFAULT_RANDOM_SEED);
+    trademgenService.parseAndLoad (lInputFilename);
+    trademgenService.reloadDemand (lInputFilename);
+    BOOST_CHECK_EQUAL (trademgenService.
+                       getExpectedTotalNumberOfRequestsToBeGenerated(),
+                       lReferenceExpectedNbOfEvents);
+    trademgenService.reset();
+    const std::vector<std::string> lRequestList =
+      generateAllRequests (trademgenService, lDemandGenerationMethod);
+    BOOST_CHECK (lRequestList == lReferenceRequestList);
+  }
+
+  // Remove a demand, and add it back
+  {
+    TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                   stdair::DEFAULT_RANDOM_SEED);
+    trademgenService.parseAndLoad (lInputFilename);
+    trademgenService.reloadDemand (lReducedInputFilename);
+    BOOST_CHECK (trademgenService.
+                 getExpectedTotalNumberOfRequestsToBeGenerated()
+                 < lReferenceExpectedNbOfEvents);
+
+    trademgenService.reloadDemand (lInputFilename);
+    trademgenService.reset();
+    const std::vector<std::string> lRequestList =
+      generateAllRequests (trademgenService, lDemandGenerationMethod);
+    BOOST_CHECK (lRequestList == lReferenceRequestList);
+  }
+
+  // With the Poisson process, the demand streams of the removed demand
+  // do not generate any request either: the same demand streams
+  // generate requests as when only the reduced file is loaded
+  const stdair::DemandGenerationMethod
+    lPoissonProcessMethod (stdair::DemandGenerationMethod::POI_PRO);
+  std::set<std::string> lReducedDemandStreamKeySet;
+  {
+    TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                   stdair::DEFAULT_RANDOM_SEED);
+    trademgenService.parseAndLoad (lReducedInputFilename);
+    const std::vector<std::string> lRequestList =
+      generateAllRequestDateTimes (trademgenService, lPoissonProcessMethod);
+    lReducedDemandStreamKeySet = getDemandStreamKeySet (lRequestList);
+  }
+  BOOST_REQUIRE (lReducedDemandStreamKeySet.empty() == false);
+  {
+    TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                   stdair::DEFAULT_RANDOM_SEED);
+    trademgenService.parseAndLoad (lInputFilename);
+    trademgenService.reloadDemand (lReducedInputFilename);
+    trademgenService.reset();
+    const std::vector<std::string> lRequestList =
+      generateAllRequestDateTimes (trademgenService, lPoissonProcessMethod);
+    BOOST_CHECK (getDemandStreamKeySet (lRequestList)
+                 == lReducedDemandStreamKeySet);
+  }
+
+  // Close the log file
+  logOutputFile.close();
+}
+
+/**
+ * Test the runtime adjustment of the demand distributions: doubling
+ * the demand doubles the expected number of requests, and halving it
+ * back gives again the very same requests.
+ */
+BOOST_AUTO_TEST_CASE (trademgen_adjust_demand_test) {
+
+  // Input file name
+  const stdair::Filename_T lInputFilename (STDAIR_SAMPLE_DIR "/demand01.csv");
+
+  // Generate the date time of the requests with the statistic order method.
+  const stdair::DemandGenerationMethod lDemandGenerationMethod (stdair::DemandGenerationMethod::STA_ORD);
+
+  // Output log File
+  std::ofstream logOutputFile;
+  logOutputFile.open ("DemandGenerationTestSuite_adjust.log");
+  logOutputFile.clear();
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+
+  // Reference: the demand as given by the demand input file
+  std::vector<std::string> lReferenceRequestList;
+  stdair::Count_T lReferenceExpectedNbOfEvents (0);
+  {
+    TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                   stdair::DEFAULT_RANDOM_SEED);
+    trademgenService.parseAndLoad (lInputFilename);
+    lReferenceExpectedNbOfEvents =
+      trademgenService.getExpectedTotalNumberOfRequestsToBeGenerated();
+    trademgenService.reset();
+    lReferenceRequestList = generateAllRequests (trademgenService,
+                                                 lDemandGenerationMethod);
+  }
+
+  {
+    TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                   stdair::DEFAULT_RANDOM_SEED);
+    trademgenService.parseAndLoad (lInputFilename);
+
+    // No demand stream departs in 1990
+    TRADEMGEN::DemandAdjustmentStruct lNoAdjustment;
+    lNoAdjustment._dateRange =
+      stdair::DatePeriod_T (stdair::Date_T (1990, 1, 1),
+                            stdair::Date_T (1991, 1, 1));
+    lNoAdjustment._meanMultiplier = 2.0;
+    BOOST_CHECK_EQUAL (trademgenService.adjustDemand (lNoAdjustment), 0);
+    BOOST_CHECK_EQUAL (trademgenService.
+                       getExpectedTotalNumberOfRequestsToBeGenerated(),
+                       lReferenceExpectedNbOfEvents);
+
+    // Double the demand of all the demand streams
+    TRADEMGEN::DemandAdjustmentStruct lAdjustment;
+    lAdjustment._meanMultiplier = 2.0;
+    const stdair::Count_T lNbOfAdjustedDemandStreams =
+      trademgenService.adjustDemand (lAdjustment);
+    BOOST_CHECK (lNbOfAdjustedDemandStreams > 0);
+    BOOST_CHECK (std::abs (trademgenService.
+                           getExpectedTotalNumberOfRequestsToBeGenerated()
+                           - 2 * lReferenceExpectedNbOfEvents) <= 1);
+
+    // Halve it back
+    lAdjustment._meanMultiplier = 0.5;
+    BOOST_CHECK_EQUAL (trademgenService.adjustDemand (lAdjustment),
+                       lNbOfAdjustedDemandStreams);
+    trademgenService.reset();
+    const std::vector<std::string> lRequestList =
+      generateAllRequests (trademgenService, lDemandGenerationMethod);
+    BOOST_CHECK (lRequestList == lReferenceRequestList);
+  }
+
+  // No demand at all: no request is generated, even with the Poisson
+  // process
+  {
+    TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                   stdair::DEFAULT_RANDOM_SEED);
+    trademgenService.parseAndLoad (lInputFilename);
+    TRADEMGEN::DemandAdjustmentStruct lNoDemandAdjustment;
+    lNoDemandAdjustment._meanMultiplier = 0.0;
+    BOOST_CHECK (trademgenService.adjustDemand (lNoDemandAdjustment) > 0);
+    BOOST_CHECK (std::abs (trademgenService.
+                           getExpectedTotalNumberOfRequestsToBeGenerated())
+                 <= 1);
+    trademgenService.reset();
+    const stdair::DemandGenerationMethod
+      lPoissonProcessMethod (stdair::DemandGenerationMethod::POI_PRO);
+    BOOST_CHECK (generateAllRequests (trademgenService,
+                                      lPoissonProcessMethod).empty() == true);
+  }
+
+  // Close the log file
+  logOutputFile.close();
+}
+
+/**
+ * Generate several scenarios out of a single loaded demand model
+ */
+BOOST_AUTO_TEST_CASE (trademgen_multi_scenario_test) {
+
+  // Input file name
+  const stdair::Filename_T lInputFilename (STDAIR_SAMPLE_DIR "/demand01.csv");
+
+  // Generate the date time of the requests with the statistic order method.
+  const stdair::DemandGenerationMethod lDemandGenerationMethod (stdair::DemandGenerationMethod::STA_ORD);
+
+  // Output log File
+  std::ofstream logOutputFile;
+  logOutputFile.open ("DemandGenerationTestSuite_scenario.log");
+  logOutputFile.clear();
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+
+  TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                 stdair::DEFAULT_RANDOM_SEED);
+  trademgenService.parseAndLoad (lInputFilename);
+  const stdair::Count_T lExpectedNbOfEvents =
+    trademgenService.getExpectedTotalNumberOfRequestsToBeGenerated();
+
+  // Two identical baseline scenarios, and a doubled demand one
+  const unsigned int lNbOfRuns = 2;
+  RequestListSink lBaselineSink, lSameBaselineSink, lDoubleSink;
+  TRADEMGEN::DemandScenarioList_T lScenarioList;
+  lScenarioList.push_back (TRADEMGEN::DemandScenarioStruct (1, &lBaselineSink));
+  lScenarioList.push_back (TRADEMGEN::DemandScenarioStruct (1, &lDoubleSink,
+                                                            2.0));
+  lScenarioList.push_back (TRADEMGEN::DemandScenarioStruct (1,
+                                                            &lSameBaselineSink));
+  const stdair::Count_T lNbOfRequests =
+    trademgenService.generateScenarios (lScenarioList, lNbOfRuns,
+                                        lDemandGenerationMethod);
+  BOOST_CHECK_EQUAL (lNbOfRequests, lBaselineSink._requestList.size()
+                     + lSameBaselineSink._requestList.size()
+                     + lDoubleSink._requestList.size());
+
+  // The same seed gives the same requests, whatever the scenarios
+  // generated in between
+  BOOST_CHECK (lBaselineSink._requestList.empty() == false);
+  BOOST_CHECK (lBaselineSink._requestList == lSameBaselineSink._requestList);
+  BOOST_CHECK (lDoubleSink._requestList.size()
+               > lBaselineSink._requestList.size());
+
+  // The demand distributions of the demand input file are restored
+  BOOST_CHECK (std::abs (trademgenService.
+                         getExpectedTotalNumberOfRequestsToBeGenerated()
+                         - lExpectedNbOfEvents) <= 1);
+
+  // A scenario without any demand gives no request, even with the
+  // Poisson process
+  RequestListSink lNoDemandSink;
+  TRADEMGEN::DemandScenarioList_T lNoDemandScenarioList;
+  lNoDemandScenarioList.push_back (TRADEMGEN::DemandScenarioStruct (1,
+                                                                    &lNoDemandSink,
+                                                                    0.0));
+  const stdair::DemandGenerationMethod
+    lPoissonProcessMethod (stdair::DemandGenerationMethod::POI_PRO);
+  BOOST_CHECK_EQUAL (trademgenService.
+                     generateScenarios (lNoDemandScenarioList, lNbOfRuns,
+                                        lPoissonProcessMethod), 0);
+  BOOST_CHECK (lNoDemandSink._requestList.empty() == true);
+
+  // Generating the scenarios again gives the same requests
+  RequestListSink lOtherBaselineSink;
+  TRADEMGEN::DemandScenarioList_T lOtherScenarioList;
+  lOtherScenarioList.push_back (TRADEMGEN::DemandScenarioStruct (1,
+                                                                 &lOtherBaselineSink));
+  trademgenService.generateScenarios (lOtherScenarioList, lNbOfRuns,
+                                      lDemandGenerationMethod);
+  BOOST_CHECK (lOtherBaselineSink._requestList == lBaselineSink._requestList);
+
+  // Close the log file
+  logOutputFile.close();
+}
+
+/**
+ * Draw in advance the total numbers of requests of several runs
+ */
+BOOST_AUTO_TEST_CASE (trademgen_predrawn_totals_test) {
+
+  // Input file name
+  const stdair::Filename_T lInputFilename (STDAIR_SAMPLE_DIR "/demand01.csv");
+
+  // Generate the date time of the requests with the statistic order method.
+  const stdair::DemandGenerationMethod lDemandGenerationMethod (stdair::DemandGenerationMethod::STA_ORD);
+
+  // Output log File
+  std::ofstream logOutputFile;
+  logOutputFile.open ("DemandGenerationTestSuite_predrawn.log");
+  logOutputFile.clear();
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+
+  // Generate a few runs, with the totals drawn in advance for all but
+  // the last one, twice with the same seed
+  const unsigned int lNbOfRuns = 4;
+  std::vector<std::string> lRunRequestLists[2][lNbOfRuns];
+  for (unsigned short idx = 0; idx != 2; ++idx) {
+    TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                   stdair::DEFAULT_RANDOM_SEED);
+    trademgenService.parseAndLoad (lInputFilename);
+    trademgenService.drawTotalNumberOfRequests (lNbOfRuns - 1);
+    for (unsigned int lRun = 0; lRun != lNbOfRuns; ++lRun) {
+      trademgenService.reset();
+      lRunRequestLists[idx][lRun] = generateAllRequests (trademgenService,
+                                                         lDemandGenerationMethod);
+      BOOST_CHECK (lRunRequestLists[idx][lRun].empty() == false);
+    }
+  }
+
+  for (unsigned int lRun = 0; lRun != lNbOfRuns; ++lRun) {
+    BOOST_CHECK (lRunRequestLists[0][lRun] == lRunRequestLists[1][lRun]);
+  }
+
+  // Close the log file
+  logOutputFile.close();
+}
+
+/**
+ * Go back to a snapshot of the demand streams
+ */
+BOOST_AUTO_TEST_CASE (trademgen_snapshot_test) {
+
+  // Input file name
+  const stdair::Filename_T lInputFilename (STDAIR_SAMPLE_DIR "/demand01.csv");
+
+  // Generate the date time of the requests with the statistic order method.
+  const stdair::DemandGenerationMethod lDemandGenerationMethod (stdair::DemandGenerationMethod::STA_ORD);
+
+  // Output log File
+  std::ofstream logOutputFile;
+  logOutputFile.open ("DemandGenerationTestSuite_snapshot.log");
+  logOutputFile.clear();
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+
+  TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                 stdair::DEFAULT_RANDOM_SEED);
+  trademgenService.parseAndLoad (lInputFilename);
+
+  // No snapshot has been taken yet
+  BOOST_CHECK_THROW (trademgenService.restoreSnapshot(),
+                     TRADEMGEN::DemandSnapshotException);
+
+  // Nothing to be restored right after the snapshot
+  trademgenService.takeSnapshot();
+  BOOST_CHECK_EQUAL (trademgenService.restoreSnapshot(), 0);
+
+  // Going back to the snapshot replays the same run
+  const std::vector<std::string> lFirstRequestList =
+    generateAllRequests (trademgenService, lDemandGenerationMethod);
+  BOOST_CHECK (lFirstRequestList.empty() == false);
+  BOOST_CHECK (trademgenService.restoreSnapshot() > 0);
+  BOOST_CHECK (generateAllRequests (trademgenService, lDemandGenerationMethod)
+               == lFirstRequestList);
+
+  // Even after a regular reset, which draws a different run
+  trademgenService.reset();
+  generateAllRequests (trademgenService, lDemandGenerationMethod);
+  trademgenService.restoreSnapshot();
+  BOOST_CHECK (generateAllRequests (trademgenService, lDemandGenerationMethod)
+               == lFirstRequestList);
+
+  // Close the log file
+  logOutputFile.close();
+}
+
+/**
+ * Resume a demand generation from a checkpoint
+ */
+BOOST_AUTO_TEST_CASE (trademgen_checkpoint_test) {
+
+  // Input file name
+  const stdair::Filename_T lInputFilename (STDAIR_SAMPLE_DIR "/demand01.csv");
+
+  // Checkpoint file names
+  const stdair::Filename_T
+    lCheckpointFilename ("DemandGenerationTestSuite_checkpoint.tdgc");
+  const stdair::Filename_T
+    lCorruptedFilename ("DemandGenerationTestSuite_corrupted.tdgc");
+  {
+    std::ofstream lCorruptedFile (lCorruptedFilename.c_str());
+    lCorruptedFile << "This is not a checkpoint" << std::endl;
+  }
+
+  // Generate the date time of the requests with the statistic order method.
+  const stdair::DemandGenerationMethod lDemandGenerationMethod (stdair::DemandGenerationMethod::STA_ORD);
+
+  // Output log File
+  std::ofstream logOutputFile;
+  logOutputFile.open ("DemandGenerationTestSuite_checkpoint.log");
+  logOutputFile.clear();
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+
+  // Stop the demand generation in the middle, and save a checkpoint
+  std::vector<std::string> lNextRequestList;
+  {
+    TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                   stdair::DEFAULT_RANDOM_SEED);
+    trademgenService.parseAndLoad (lInputFilename);
+    trademgenService.generateFirstRequests (lDemandGenerationMethod);
+    const std::vector<std::string> lFirstRequestList =
+      generateNextRequests (trademgenService, lDemandGenerationMethod, 10);
+    BOOST_REQUIRE (lFirstRequestList.size() == 10);
+    trademgenService.checkpoint (lCheckpointFilename);
+    lNextRequestList = generateNextRequests (trademgenService,
+                                             lDemandGenerationMethod);
+    BOOST_CHECK (lNextRequestList.empty() == false);
+
+    // Resuming from the checkpoint gives the same booking requests
+    trademgenService.restore (lCheckpointFilename);
+    BOOST_CHECK (generateNextRequests (trademgenService,
+                                       lDemandGenerationMethod)
+                 == lNextRequestList);
+
+    // Invalid checkpoints are rejected
+    BOOST_CHECK_THROW (trademgenService.restore ("missing_checkpoint.tdgc"),
+                       TRADEMGEN::DemandSnapshotException);
+    BOOST_CHECK_THROW (trademgenService.restore (lCorruptedFilename),
+                       TRADEMGEN::DemandSnapshotException);
+  }
+
+  // Even within another service (with another seed), having loaded the
+  // same demand input file
+  {
+    TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams, 1);
+    trademgenService.parseAndLoad (lInputFilename);
+    trademgenService.restore (lCheckpointFilename);
+    BOOST_CHECK (generateNextRequests (trademgenService,
+                                       lDemandGenerationMethod)
+                 == lNextRequestList);
+  }
+
+  // Close the log file
+  logOutputFile.close();
+}
+
+/**
+ * Generate the demand with a rolling horizon
+ */
+BOOST_AUTO_TEST_CASE (trademgen_rolling_horizon_test) {
+
+  // Input file name
+  const stdair::Filename_T lInputFilename (STDAIR_SAMPLE_DIR "/demand01.csv");
+
+  // Generate the date time of the requests with the statistic order method.
+  const stdair::DemandGenerationMethod lDemandGenerationMethod (stdair::DemandGenerationMethod::STA_ORD);
+
+  // Output log File
+  std::ofstream logOutputFile;
+  logOutputFile.open ("DemandGenerationTestSuite_rolling.log");
+  logOutputFile.clear();
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+
+  // All the demand streams created upfront
+  std::vector<std::string> lRequestList;
+  {
+    TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                   stdair::DEFAULT_RANDOM_SEED);
+    trademgenService.parseAndLoad (lInputFilename);
+    lRequestList = generateAllRequestDateTimes (trademgenService,
+                                                lDemandGenerationMethod);
+    BOOST_REQUIRE (lRequestList.empty() == false);
+  }
+
+  // The demand streams created along the generation give the same
+  // booking requests
+  {
+    TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                   stdair::DEFAULT_RANDOM_SEED);
+    trademgenService.parseAndSchedule (lInputFilename);
+    BOOST_CHECK (generateAllRequestDateTimes (trademgenService,
+                                              lDemandGenerationMethod)
+                 == lRequestList);
+    BOOST_CHECK_EQUAL (trademgenService.getNbOfOpenDemandStreams(), 0);
+
+    // The demand input file cannot be reloaded
+    BOOST_CHECK_THROW (trademgenService.reloadDemand (lInputFilename),
+                       TRADEMGEN::DemandReloadException);
+  }
+
+  // Close the log file
+  logOutputFile.close();
+}
+
+/**
+ * Generate the demand day by day
+ */
+BOOST_AUTO_TEST_CASE (trademgen_generate_until_test) {
+
+  // Input file name
+  const stdair::Filename_T lInputFilename (STDAIR_SAMPLE_DIR "/demand01.csv");
+
+  // Generate the date time of the requests with the statistic order method.
+  const stdair::DemandGenerationMethod lDemandGenerationMethod (stdair::DemandGenerationMethod::STA_ORD);
+
+  // Output log File
+  std::ofstream logOutputFile;
+  logOutputFile.open ("DemandGenerationTestSuite_until.log");
+  logOutputFile.clear();
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+
+  // Booking requests popped one by one
+  std::vector<std::string> lRequestList;
+  {
+    TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                   stdair::DEFAULT_RANDOM_SEED);
+    trademgenService.parseAndLoad (lInputFilename);
+    const std::vector<std::string> lDescriptionList =
+      generateAllRequests (trademgenService, lDemandGenerationMethod);
+    for (std::vector<std::string>::const_iterator itDescription =
+           lDescriptionList.begin();
+         itDescription != lDescriptionList.end(); ++itDescription) {
+      lRequestList.push_back ("0: " + *itDescription);
+    }
+    BOOST_REQUIRE (lRequestList.empty() == false);
+  }
+
+  // Booking requests generated one simulated day at a time
+  {
+    TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                   stdair::DEFAULT_RANDOM_SEED);
+    trademgenService.parseAndLoad (lInputFilename);
+    trademgenService.generateFirstRequests (lDemandGenerationMethod);
+
+    RequestListSink lSink;
+    stdair::DateTime_T lDateTime (stdair::Date_T (2009, boost::gregorian::Jan, 1));
+    unsigned short lNbOfDays = 0;
+    unsigned short lNbOfActiveDays = 0;
+    while (trademgenService.isQueueDone() == false && lNbOfDays != 2000) {
+      const stdair::Count_T lNbOfRequests =
+        trademgenService.generateUntil (lDateTime, lSink,
+                                        lDemandGenerationMethod);
+      if (lNbOfRequests != 0) {
+        ++lNbOfActiveDays;
+      }
+      lDateTime += boost::gregorian::days (1);
+      ++lNbOfDays;
+    }
+    BOOST_CHECK (trademgenService.isQueueDone() == true);
+    BOOST_CHECK (lNbOfActiveDays > 1);
+    BOOST_CHECK (lSink._requestList == lRequestList);
+  }
+
+  // Close the log file
+  logOutputFile.close();
+}
+
+/**
+ * Generate the demand on a background thread
+ */
+BOOST_AUTO_TEST_CASE (trademgen_request_pipeline_test) {
+
+  // Input file name
+  const stdair::Filename_T lInputFilename (STDAIR_SAMPLE_DIR "/demand01.csv");
+
+  // Generate the date time of the requests with the statistic order method.
+  const stdair::DemandGenerationMethod lDemandGenerationMethod (stdair::DemandGenerationMethod::STA_ORD);
+
+  // Output log File
+  std::ofstream logOutputFile;
+  logOutputFile.open ("DemandGenerationTestSuite_pipeline.log");
+  logOutputFile.clear();
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+
+  TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                 stdair::DEFAULT_RANDOM_SEED);
+  trademgenService.parseAndLoad (lInputFilename);
+
+  // The pipeline gives the same booking requests as popping them one by
+  // one, on the same thread (blocking variant)
+  {
+    trademgenService.takeSnapshot();
+    TRADEMGEN::RequestPipeline lPipeline (4);
+    trademgenService.startRequestPipeline (lPipeline, lDemandGenerationMethod);
+    BOOST_CHECK_THROW (trademgenService.startRequestPipeline (lPipeline,
+                                                              lDemandGenerationMethod),
+                       TRADEMGEN::RequestPipelineException);
+
+    std::vector<std::string> lPoppedRequestList;
+    stdair::BookingRequestPtr_T lBookingRequest_ptr;
+    while (lPipeline.pop (lBookingRequest_ptr) == true) {
+      lPoppedRequestList.push_back (lBookingRequest_ptr->describe());
+    }
+    BOOST_CHECK (lPipeline.isDone() == true);
+    BOOST_CHECK (lPoppedRequestList.empty() == false);
+
+    trademgenService.restoreSnapshot();
+    BOOST_CHECK (generateAllRequests (trademgenService, lDemandGenerationMethod)
+                 == lPoppedRequestList);
+  }
+
+  // Non-blocking variant, and stop in the middle of the run
+  {
+    trademgenService.reset();
+    TRADEMGEN::RequestPipeline lPipeline (1);
+    trademgenService.startRequestPipeline (lPipeline, lDemandGenerationMethod);
+
+    stdair::Count_T lNbOfPoppedRequests = 0;
+    stdair::BookingRequestPtr_T lBookingRequest_ptr;
+    while (lNbOfPoppedRequests != 5 && lPipeline.isDone() == false) {
+      if (lPipeline.tryPop (lBookingRequest_ptr) == true) {
+        ++lNbOfPoppedRequests;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+    BOOST_CHECK_EQUAL (lNbOfPoppedRequests, 5);
+    lPipeline.stop();
+    BOOST_CHECK (lPipeline.tryPop (lBookingRequest_ptr) == false);
+
+    // The service can be used again, once reset
+    trademgenService.reset();
+    BOOST_CHECK (generateAllRequests (trademgenService,
+                                      lDemandGenerationMethod).empty() == false);
+  }
+
+  // Close the log file
+  logOutputFile.close();
+}
+
+/**
+ * Publish the demand into a shared memory ring, consumed by several readers
+ */
+BOOST_AUTO_TEST_CASE (trademgen_shared_request_ring_test) {
+
+  // Input file name
+  const stdair::Filename_T lInputFilename (STDAIR_SAMPLE_DIR "/demand01.csv");
+
+  // Generate the date time of the requests with the statistic order method.
+  const stdair::DemandGenerationMethod lDemandGenerationMethod (stdair::DemandGenerationMethod::STA_ORD);
+
+  // Output log File
+  std::ofstream logOutputFile;
+  logOutputFile.open ("DemandGenerationTestSuite_ring.log");
+  logOutputFile.clear();
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+
+  TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                 stdair::DEFAULT_RANDOM_SEED);
+  trademgenService.parseAndLoad (lInputFilename);
+
+  // Booking requests popped one by one
+  trademgenService.takeSnapshot();
+  const std::vector<std::string> lRequestList =
+    generateAllRequests (trademgenService, lDemandGenerationMethod);
+  BOOST_REQUIRE (lRequestList.empty() == false);
+  trademgenService.restoreSnapshot();
+
+  // Nobody has created that ring
+  BOOST_CHECK_THROW (TRADEMGEN::SharedRequestRingReader lReader ("DemandGenerationTestSuite_none"),
+                     TRADEMGEN::SharedRequestRingException);
+
+  // A tiny ring, so that the writer has to wait for the readers. Each
+  // reader gets all the booking requests, at its own pace
+  const std::string lRingName ("DemandGenerationTestSuite_ring");
+  TRADEMGEN::SharedRequestRingWriter lWriter (lRingName, 8);
+  TRADEMGEN::SharedRequestRingReader lFastReader (lRingName);
+  TRADEMGEN::SharedRequestRingReader lSlowReader (lRingName);
+  lWriter.waitForReaders (2);
+  BOOST_CHECK_EQUAL (lWriter.getNbOfReaders(), 2);
+
+  std::vector<std::string> lFastRequestList;
+  std::vector<std::string> lSlowRequestList;
+  std::thread lFastThread ([&lFastReader, &lFastRequestList] () {
+      stdair::BookingRequestPtr_T lBookingRequest_ptr;
+      while (lFastReader.read (lBookingRequest_ptr) == true) {
+        lFastRequestList.push_back (lBookingRequest_ptr->describe());
+      }
+    });
+  std::thread lSlowThread ([&lSlowReader, &lSlowRequestList] () {
+      TRADEMGEN::SharedRequestRecord lRecord;
+      while (lSlowReader.read (lRecord) == true) {
+        std::ostringstream oStr;
+        oStr << lRecord._runNumber << ": "
+             << TRADEMGEN::SharedRequestRing::decode (lRecord)->describe();
+        lSlowRequestList.push_back (oStr.str());
+        std::this_thread::yield();
+      }
+    });
+
+  trademgenService.generateFirstRequests (lDemandGenerationMethod);
+  const stdair::DateTime_T lEndDateTime (stdair::Date_T (2100, boost::gregorian::Jan, 1));
+  trademgenService.generateUntil (lEndDateTime, lWriter,
+                                  lDemandGenerationMethod);
+  lWriter.close();
+  lFastThread.join();
+  lSlowThread.join();
+
+  BOOST_CHECK_EQUAL (lWriter.getNbOfWrittenRequests(), lRequestList.size());
+  BOOST_CHECK (lFastReader.isDone() == true);
+  BOOST_CHECK (lFastRequestList == lRequestList);
+  BOOST_REQUIRE_EQUAL (lSlowRequestList.size(), lRequestList.size());
+  BOOST_CHECK_EQUAL (lSlowRequestList.front(), "1: " + lRequestList.front());
+  BOOST_CHECK_EQUAL (lSlowRequestList.back(), "1: " + lRequestList.back());
+
+  // Close the log file
+  logOutputFile.close();
+}
+
+/**
+ * Serve generation sessions from a resident demand generation server
+ */
+BOOST_AUTO_TEST_CASE (trademgen_generation_server_test) {
+
+  // Input file name
+  const stdair::Filename_T lInputFilename (STDAIR_SAMPLE_DIR "/demand01.csv");
+
+  // Generate the date time of the requests with the statistic order method.
+  const stdair::DemandGenerationMethod lDemandGenerationMethod (stdair::DemandGenerationMethod::STA_ORD);
+
+  // Output log File
+  std::ofstream logOutputFile;
+  logOutputFile.open ("DemandGenerationTestSuite_server.log");
+  logOutputFile.clear();
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+
+  TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                 stdair::DEFAULT_RANDOM_SEED);
+  trademgenService.parseAndLoad (lInputFilename);
+
+  // Nobody listens on that socket yet
+  const std::string lSocketPath ("DemandGenerationTestSuite_server.sock");
+  BOOST_CHECK_THROW (TRADEMGEN::DemandGenerationClient lClient (lSocketPath),
+                     TRADEMGEN::DemandGenerationServerException);
+
+  // Tiny frames, so that a session spans many of them
+  TRADEMGEN::DemandGenerationServer lServer (trademgenService, lSocketPath,
+                                             stdair::DEFAULT_RANDOM_SEED,
+                                             lDemandGenerationMethod, 16);
+  std::thread lServerThread ([&lServer] () {
+      lServer.run();
+    });
+
+  std::vector<std::string> lRequestList;
+  {
+    TRADEMGEN::DemandGenerationClient lClient (lSocketPath);
+
+    // The same request gives the same booking requests, whether the
+    // client grants credit or not
+    RequestListSink lSink;
+    lClient.generate ("{\"generate\": {\"seed\": 42, \"method\": \"S\"}}",
+                      lSink);
+    lRequestList = lSink._requestList;
+    BOOST_REQUIRE (lRequestList.empty() == false);
+
+    RequestListSink lCreditSink;
+    lClient.generate ("{\"generate\": {\"seed\": 42, \"credit\": 5}}",
+                      lCreditSink);
+    BOOST_CHECK (lCreditSink._requestList == lRequestList);
+
+    // Two adjacent time windows make up the whole demand
+    RequestListSink lWindowSink;
+    lClient.generate ("{\"generate\": {\"seed\": 42, "
+                      "\"until\": \"2010-01-01 00:00:00\"}}", lWindowSink);
+    const std::size_t lNbOfEarlyRequests = lWindowSink._requestList.size();
+    lClient.generate ("{\"generate\": {\"seed\": 42, "
+                      "\"from\": \"2010-01-01 00:00:00\"}}", lWindowSink);
+    BOOST_CHECK (lNbOfEarlyRequests != 0);
+    BOOST_CHECK (lNbOfEarlyRequests < lRequestList.size());
+    BOOST_CHECK (lWindowSink._requestList == lRequestList);
+
+    // The filtered booking requests keep their order
+    RequestListSink lFilterSink;
+    lClient.generate ("{\"generate\": {\"seed\": 42, "
+                      "\"filter\": {\"origin\": \"SIN\"}}}", lFilterSink);
+    BOOST_CHECK (lFilterSink._requestList.empty() == false);
+    BOOST_CHECK (lFilterSink._requestList.size() < lRequestList.size());
+    std::vector<std::string>::const_iterator itRequest = lRequestList.begin();
+    for (std::vector<std::string>::const_iterator itFilteredRequest =
+           lFilterSink._requestList.begin();
+         itFilteredRequest != lFilterSink._requestList.end();
+         ++itFilteredRequest) {
+      itRequest = std::find (itRequest, lRequestList.end(),
+                             *itFilteredRequest);
+      BOOST_REQUIRE (itRequest != lRequestList.end());
+    }
+
+    // A rejected request leaves the connection usable
+    RequestListSink lRejectedSink;
+    BOOST_CHECK_THROW (lClient.generate ("{\"generate\": {\"from\": \"2010-02-01 00:00:00\", \"until\": \"2010-01-01 00:00:00\"}}",
+                                         lRejectedSink),
+                       TRADEMGEN::DemandGenerationServerException);
+    BOOST_CHECK (lRejectedSink._requestList.empty() == true);
+    BOOST_CHECK (lClient.execute ("not JSON").find ("error")
+                 != std::string::npos);
+
+    BOOST_CHECK (lClient.execute ("{\"shutdown\": {}}").find ("ok")
+                 != std::string::npos);
+  }
+  lServerThread.join();
+  BOOST_CHECK_EQUAL (lServer.getNbOfSessions(), 5);
+
+  // The sessions are the ones of the service reseeded the same way
+  trademgenService.reseed (42);
+  const std::vector<std::string> lDescriptionList =
+    generateAllRequests (trademgenService, lDemandGenerationMethod);
+  BOOST_REQUIRE_EQUAL (lDescriptionList.size(), lRequestList.size());
+  BOOST_CHECK_EQUAL (lRequestList.front(), "0: " + lDescriptionList.front());
+  BOOST_CHECK_EQUAL (lRequestList.back(), "0: " + lDescriptionList.back());
+
+  // Close the log file
+  logOutputFile.close();
+}
+
+/**
+ * Generate the demand in several shards, and merge the request shard files
+ */
+BOOST_AUTO_TEST_CASE (trademgen_request_shard_test) {
+
+  // Input file name
+  const stdair::Filename_T lInputFilename (STDAIR_SAMPLE_DIR "/demand01.csv");
+
+  // Generate the date time of the requests with the statistic order method.
+  const stdair::DemandGenerationMethod lDemandGenerationMethod (stdair::DemandGenerationMethod::STA_ORD);
+
+  // Output log File
+  std::ofstream logOutputFile;
+  logOutputFile.open ("DemandGenerationTestSuite_shard.log");
+  logOutputFile.clear();
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+
+  TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                 stdair::DEFAULT_RANDOM_SEED);
+  trademgenService.parseAndLoad (lInputFilename);
+  const stdair::DateTime_T lEndDateTime (stdair::Date_T (2100, boost::gregorian::Jan, 1));
+
+  // The generation with a single shard is the reference
+  trademgenService.reseed (stdair::DEFAULT_RANDOM_SEED);
+  const stdair::Count_T lNbOfDemandStreams =
+    trademgenService.shardDemand (0, 1);
+  RequestListSink lReferenceSink;
+  lReferenceSink.setRunNumber (1);
+  trademgenService.generateFirstRequests (lDemandGenerationMethod);
+  trademgenService.generateUntil (lEndDateTime, lReferenceSink,
+                                  lDemandGenerationMethod);
+  BOOST_REQUIRE (lReferenceSink._requestList.empty() == false);
+
+  // Every shard in its own request shard file, as if generated by its
+  // own process
+  BOOST_CHECK_THROW (trademgenService.shardDemand (3, 3),
+                     TRADEMGEN::TrademgenGenerationException);
+  const unsigned short lNbOfShards = 3;
+  std::vector<stdair::Filename_T> lShardFilenameList;
+  stdair::Count_T lNbOfShardedDemandStreams = 0;
+  for (unsigned short lShardIdx = 0; lShardIdx != lNbOfShards; ++lShardIdx) {
+    std::ostringstream oFilename;
+    oFilename << "DemandGenerationTestSuite_shard" << lShardIdx << ".bin";
+    lShardFilenameList.push_back (oFilename.str());
+
+    trademgenService.reseed (stdair::DEFAULT_RANDOM_SEED);
+    lNbOfShardedDemandStreams +=
+      trademgenService.shardDemand (lShardIdx, lNbOfShards);
+    TRADEMGEN::RequestShardWriter lWriter (oFilename.str(), lShardIdx,
+                                           lNbOfShards);
+    trademgenService.generateFirstRequests (lDemandGenerationMethod);
+    trademgenService.generateUntil (lEndDateTime, lWriter,
+                                    lDemandGenerationMethod);
+    lWriter.close();
+    BOOST_CHECK (lWriter.getNbOfWrittenRequests() != 0);
+    BOOST_CHECK (lWriter.getNbOfWrittenRequests()
+                 < lReferenceSink._requestList.size());
+  }
+  BOOST_CHECK_EQUAL (lNbOfShardedDemandStreams, lNbOfDemandStreams);
+
+  // The merge of the shards, given in any order, is the reference
+  std::reverse (lShardFilenameList.begin(), lShardFilenameList.end());
+  RequestListSink lMergedSink;
+  BOOST_CHECK_EQUAL (TRADEMGEN::RequestShardMerger::merge (lShardFilenameList,
+                                                           lMergedSink),
+                     lReferenceSink._requestList.size());
+  BOOST_CHECK (lMergedSink._requestList == lReferenceSink._requestList);
+
+  // A missing shard, or an incomplete request shard file, is rejected
+  const std::vector<stdair::Filename_T>
+    lIncompleteShardFilenameList (lShardFilenameList.begin() + 1,
+                                  lShardFilenameList.end());
+  RequestListSink lRejectedSink;
+  BOOST_CHECK_THROW (TRADEMGEN::RequestShardMerger::merge (lIncompleteShardFilenameList,
+                                                           lRejectedSink),
+                     TRADEMGEN::RequestShardException);
+  {
+    TRADEMGEN::RequestShardWriter lWriter (lShardFilenameList.front(),
+                                           lNbOfShards - 1,
+                                           lNbOfShards);
+  }
+  BOOST_CHECK_THROW (TRADEMGEN::RequestShardMerger::merge (lShardFilenameList,
+                                                           lRejectedSink),
+                     TRADEMGEN::RequestShardException);
+  BOOST_CHECK (lRejectedSink._requestList.empty() == true);
+
+  // Close the log file
+  logOutputFile.close();
+}
+
+/**
+ * Generate the demand stream by demand stream, without the event queue
+ */
+BOOST_AUTO_TEST_CASE (trademgen_by_stream_test) {
+
+  // Input file name
+  const stdair::Filename_T lInputFilename (STDAIR_SAMPLE_DIR "/demand01.csv");
+
+  // Generate the date time of the requests with the statistic order method.
+  const stdair::DemandGenerationMethod lDemandGenerationMethod (stdair::DemandGenerationMethod::STA_ORD);
+
+  // Output log File
+  std::ofstream logOutputFile;
+  logOutputFile.open ("DemandGenerationTestSuite_by_stream.log");
+  logOutputFile.clear();
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+
+  TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                 stdair::DEFAULT_RANDOM_SEED);
+  trademgenService.parseAndLoad (lInputFilename);
+
+  // The generation through the event queue is the reference, the WTP
+  // being drawn from the random generators of the demand streams
+  trademgenService.reseed (stdair::DEFAULT_RANDOM_SEED);
+  trademgenService.shardDemand (0, 1);
+  RequestListSink lQueueSink;
+  trademgenService.generateFirstRequests (lDemandGenerationMethod);
+  trademgenService.generateUntil (stdair::DateTime_T (stdair::Date_T (2100, boost::gregorian::Jan, 1)),
+                                  lQueueSink, lDemandGenerationMethod);
+  BOOST_REQUIRE (lQueueSink._requestList.empty() == false);
+
+  // The same booking requests, whatever the number of threads
+  trademgenService.reseed (stdair::DEFAULT_RANDOM_SEED);
+  RequestListSink lSingleThreadSink;
+  BOOST_CHECK_EQUAL (trademgenService.generateRunByStream (lSingleThreadSink,
+                                                           lDemandGenerationMethod,
+                                                           1),
+                     lQueueSink._requestList.size());
+  trademgenService.reseed (stdair::DEFAULT_RANDOM_SEED);
+  RequestListSink lMultiThreadSink;
+  trademgenService.generateRunByStream (lMultiThreadSink,
+                                        lDemandGenerationMethod, 4);
+  BOOST_CHECK (lMultiThreadSink._requestList
+               == lSingleThreadSink._requestList);
+
+  // The booking requests of the event queue, in another order
+  std::vector<std::string> lQueueRequestList (lQueueSink._requestList);
+  std::vector<std::string> lByStreamRequestList (lSingleThreadSink._requestList);
+  std::sort (lQueueRequestList.begin(), lQueueRequestList.end());
+  std::sort (lByStreamRequestList.begin(), lByStreamRequestList.end());
+  BOOST_CHECK (lByStreamRequestList == lQueueRequestList);
+
+  // The booking requests of every demand stream come in a row
+  std::set<std::string> lGeneratedDemandStreamKeySet;
+  const std::vector<std::string>& lDemandStreamKeyList =
+    lSingleThreadSink._demandStreamKeyList;
+  for (std::size_t idx = 1; idx < lDemandStreamKeyList.size(); ++idx) {
+    if (lDemandStreamKeyList[idx] != lDemandStreamKeyList[idx - 1]) {
+      lGeneratedDemandStreamKeySet.insert (lDemandStreamKeyList[idx - 1]);
+      BOOST_CHECK (lGeneratedDemandStreamKeySet.count (lDemandStreamKeyList[idx])
+                   == 0);
+    }
+  }
+  BOOST_CHECK (lGeneratedDemandStreamKeySet.size() > 1);
+
+  // Close the log file
+  logOutputFile.close();
+}
+
+/**
+ * Load only the demand streams selected by a filter
+ */
+BOOST_AUTO_TEST_CASE (trademgen_demand_filter_test) {
+
+  // Input file name
+  const stdair::Filename_T lInputFilename (STDAIR_SAMPLE_DIR "/demand01.csv");
+
+  // Generate the date time of the requests with the statistic order method.
+  const stdair::DemandGenerationMethod lDemandGenerationMethod (stdair::DemandGenerationMethod::STA_ORD);
+
+  // Output log File
+  std::ofstream logOutputFile;
+  logOutputFile.open ("DemandGenerationTestSuite_filter.log");
+  logOutputFile.clear();
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+
+  // The booking requests of all the demand streams, as drawn at load time
+  RequestListSink lFullSink;
+  {
+    TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                   stdair::DEFAULT_RANDOM_SEED);
+    trademgenService.parseAndLoad (lInputFilename);
+    trademgenService.generateRunByStream (lFullSink, lDemandGenerationMethod,
+                                          1);
+  }
+  BOOST_REQUIRE (lFullSink._requestList.empty() == false);
+
+  // Select the demand streams departing from the origin of the first one
+  const std::string& lFirstDemandStreamKey =
+    lFullSink._demandStreamKeyList.front();
+  const std::string lOrigin =
+    lFirstDemandStreamKey.substr (0, lFirstDemandStreamKey.find ('-'));
+  TRADEMGEN::DemandFilterStruct lDemandFilter;
+  lDemandFilter._originSet.insert (lOrigin);
+
+  // The selected demand streams give the same booking requests as when
+  // all the demand streams are loaded
+  RequestListSink lFilteredSink;
+  {
+    TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                   stdair::DEFAULT_RANDOM_SEED);
+    trademgenService.setDemandFilter (lDemandFilter);
+    trademgenService.parseAndLoad (lInputFilename);
+    trademgenService.generateRunByStream (lFilteredSink,
+                                          lDemandGenerationMethod, 1);
+  }
+  std::vector<std::string> lSelectedRequestList;
+  for (std::size_t idx = 0; idx != lFullSink._requestList.size(); ++idx) {
+    if (lFullSink._demandStreamKeyList[idx].compare (0, lOrigin.size() + 1,
+                                                     lOrigin + "-") == 0) {
+      lSelectedRequestList.push_back (lFullSink._requestList[idx]);
+    }
+  }
+  BOOST_CHECK (lSelectedRequestList.empty() == false);
+  BOOST_CHECK (lFilteredSink._requestList == lSelectedRequestList);
+
+  // The same goes through the event queue, the WTP of the selected
+  // demand streams being drawn from their own random generators, as when
+  // all the demand streams are generated as a single shard
+  const stdair::DateTime_T lEndDateTime (stdair::Date_T (2100,
+                                                         boost::gregorian::Jan,
+                                                         1));
+  RequestListSink lFullQueueSink;
+  {
+    TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                   stdair::DEFAULT_RANDOM_SEED);
+    trademgenService.parseAndLoad (lInputFilename);
+    trademgenService.shardDemand (0, 1);
+    trademgenService.generateFirstRequests (lDemandGenerationMethod);
+    trademgenService.generateUntil (lEndDateTime, lFullQueueSink,
+                                    lDemandGenerationMethod);
+  }
+  RequestListSink lFilteredQueueSink;
+  {
+    TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                   stdair::DEFAULT_RANDOM_SEED);
+    trademgenService.setDemandFilter (lDemandFilter);
+    trademgenService.parseAndLoad (lInputFilename);
+    trademgenService.generateFirstRequests (lDemandGenerationMethod);
+    trademgenService.generateUntil (lEndDateTime, lFilteredQueueSink,
+                                    lDemandGenerationMethod);
+  }
+  std::vector<std::string> lSelectedQueueRequestList;
+  for (std::size_t idx = 0; idx != lFullQueueSink._requestList.size(); ++idx) {
+    if (lFullQueueSink._demandStreamKeyList[idx].
+        compare (0, lOrigin.size() + 1, lOrigin + "-") == 0) {
+      lSelectedQueueRequestList.push_back (lFullQueueSink._requestList[idx]);
+    }
+  }
+  BOOST_CHECK (lSelectedQueueRequestList.empty() == false);
+  BOOST_CHECK (lFilteredQueueSink._requestList == lSelectedQueueRequestList);
+
+  // No demand stream departs in 1990
+  lDemandFilter._dateRange =
+    stdair::DatePeriod_T (stdair::Date_T (1990, 1, 1),
+                          stdair::Date_T (1991, 1, 1));
+  stdair::Count_T lEmptyExpectedNbOfEvents (1);
+  {
+    TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                   stdair::DEFAULT_RANDOM_SEED);
+    trademgenService.setDemandFilter (lDemandFilter);
+    trademgenService.parseAndLoad (lInputFilename);
+    lEmptyExpectedNbOfEvents =
+      trademgenService.getExpectedTotalNumberOfRequestsToBeGenerated();
+  }
+  BOOST_CHECK_EQUAL (lEmptyExpectedNbOfEvents, 0);
+
+  // Close the log file
+  logOutputFile.close();
+}
+
+/**
+ * Load a stratified sample of the demand streams, weighting the booking
+ * requests accordingly
+ */
+BOOST_AUTO_TEST_CASE (trademgen_demand_sampling_test) {
+
+  // Input file name
+  const stdair::Filename_T lInputFilename (STDAIR_SAMPLE_DIR "/demand01.csv");
+
+  // Generate the date time of the requests with the statistic order method.
+  const stdair::DemandGenerationMethod lDemandGenerationMethod (stdair::DemandGenerationMethod::STA_ORD);
+
+  // Output log File
+  std::ofstream logOutputFile;
+  logOutputFile.open ("DemandGenerationTestSuite_sampling.log");
+  logOutputFile.clear();
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+
+  // The booking requests of all the demand streams, as drawn at load time
+  RequestListSink lFullSink;
+  {
+    TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                   stdair::DEFAULT_RANDOM_SEED);
+    trademgenService.parseAndLoad (lInputFilename);
+    trademgenService.generateRunByStream (lFullSink, lDemandGenerationMethod,
+                                          1);
+  }
+  BOOST_REQUIRE (lFullSink._requestList.empty() == false);
+
+  // Sample 5% of the demand streams of every stratum
+  TRADEMGEN::DemandFilterStruct lDemandFilter;
+  lDemandFilter._samplingRate = 0.05;
+
+  RequestListSink lSampledSink;
+  stdair::Count_T lSampledExpectedNbOfEvents (0);
+  stdair::Count_T lFullExpectedNbOfEvents (0);
+  {
+    TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                   stdair::DEFAULT_RANDOM_SEED);
+    trademgenService.setDemandFilter (lDemandFilter);
+    trademgenService.parseAndLoad (lInputFilename);
+    lSampledExpectedNbOfEvents =
+      trademgenService.getExpectedTotalNumberOfRequestsToBeGenerated();
+    trademgenService.generateRunByStream (lSampledSink,
+                                          lDemandGenerationMethod, 1);
+
+    // Every booking request stands for at least one demand stream
+    trademgenService.reseed (stdair::DEFAULT_RANDOM_SEED);
+    WeightedRequestSink lWeightedSink (trademgenService);
+    trademgenService.generateRunByStream (lWeightedSink,
+                                          lDemandGenerationMethod, 1);
+    BOOST_CHECK (lWeightedSink._nbOfRequests > 0);
+    BOOST_CHECK (lWeightedSink._minWeight >= 1.0);
+    BOOST_CHECK (lWeightedSink._maxWeight > 1.0);
+    BOOST_CHECK (lWeightedSink._weightedNbOfRequests
+                 > lWeightedSink._nbOfRequests);
+
+    // The sample can not be updated demand by demand
+    BOOST_CHECK_THROW (trademgenService.reloadDemand (lInputFilename),
+                       TRADEMGEN::DemandReloadException);
+  }
+  {
+    TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                   stdair::DEFAULT_RANDOM_SEED);
+    trademgenService.parseAndLoad (lInputFilename);
+    lFullExpectedNbOfEvents =
+      trademgenService.getExpectedTotalNumberOfRequestsToBeGenerated();
+  }
+  BOOST_CHECK (lSampledExpectedNbOfEvents < lFullExpectedNbOfEvents);
+
+  // The sampled demand streams give the same booking requests as when
+  // all the demand streams are loaded
+  BOOST_REQUIRE (lSampledSink._requestList.empty() == false);
+  BOOST_CHECK (lSampledSink._requestList.size()
+               < lFullSink._requestList.size());
+  const std::set<std::string>
+    lSampledDemandStreamKeySet (lSampledSink._demandStreamKeyList.begin(),
+                                lSampledSink._demandStreamKeyList.end());
+  std::vector<std::string> lSelectedRequestList;
+  for (std::size_t idx = 0; idx != lFullSink._requestList.size(); ++idx) {
+    if (lSampledDemandStreamKeySet.count (lFullSink._demandStreamKeyList[idx])
+        != 0) {
+      lSelectedRequestList.push_back (lFullSink._requestList[idx]);
+    }
+  }
+  BOOST_CHECK (lSampledSink._requestList == lSelectedRequestList);
+
+  // Close the log file
+  logOutputFile.close();
+}
+
+/**
+ * Aggregate the booking requests into weighted booking requests
+ */
+BOOST_AUTO_TEST_CASE (trademgen_aggregated_requests_test) {
+
+  // Input file name
+  const stdair::Filename_T lInputFilename (STDAIR_SAMPLE_DIR "/demand01.csv");
+
+  // Generate the date time of the requests with the statistic order method.
+  const stdair::DemandGenerationMethod lDemandGenerationMethod (stdair::DemandGenerationMethod::STA_ORD);
+
+  // Output log File
+  std::ofstream logOutputFile;
+  logOutputFile.open ("DemandGenerationTestSuite_aggregated.log");
+  logOutputFile.clear();
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+
+  TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                 stdair::DEFAULT_RANDOM_SEED);
+  trademgenService.parseAndLoad (lInputFilename);
+
+  // One booking request per passenger
+  trademgenService.reseed (stdair::DEFAULT_RANDOM_SEED);
+  RequestListSink lPerPassengerSink;
+  trademgenService.generateRunByStream (lPerPassengerSink,
+                                        lDemandGenerationMethod, 1);
+  BOOST_REQUIRE (lPerPassengerSink._requestList.empty() == false);
+
+  // Without any aggregation period, nothing changes
+  trademgenService.reseed (stdair::DEFAULT_RANDOM_SEED);
+  RequestListSink lNotAggregatedSink;
+  trademgenService.generateAggregatedRunByStream (lNotAggregatedSink,
+                                                  lDemandGenerationMethod,
+                                                  stdair::Duration_T (0, 0, 0),
+                                                  1);
+  BOOST_CHECK (lNotAggregatedSink._requestList
+               == lPerPassengerSink._requestList);
+
+  // The passengers are all there, whatever the aggregation period, with
+  // fewer booking requests
+  const stdair::Duration_T lAggregationPeriodList[] =
+    { stdair::Duration_T (1, 0, 0), stdair::Duration_T (24, 0, 0),
+      stdair::Duration_T (24 * 365, 0, 0) };
+  unsigned int lPreviousNbOfRequests = lPerPassengerSink._requestList.size();
+  for (std::size_t idx = 0; idx != 3; ++idx) {
+    trademgenService.reseed (stdair::DEFAULT_RANDOM_SEED);
+    PassengerCountSink lAggregatedSink;
+    trademgenService.generateAggregatedRunByStream (lAggregatedSink,
+                                                    lDemandGenerationMethod,
+                                                    lAggregationPeriodList[idx],
+                                                    4);
+    BOOST_CHECK_EQUAL (lAggregatedSink._nbOfPassengers,
+                       lPerPassengerSink._requestList.size());
+    BOOST_CHECK (lAggregatedSink._nbOfRequests <= lPreviousNbOfRequests);
+    lPreviousNbOfRequests = lAggregatedSink._nbOfRequests;
+  }
+  BOOST_CHECK (lPreviousNbOfRequests < lPerPassengerSink._requestList.size());
+
+  // Close the log file
+  logOutputFile.close();
+}
+
+/**
+ * Generate the cabins of every origin, destination and preferred
+ * departure date from a single demand stream
+ */
+BOOST_AUTO_TEST_CASE (trademgen_multi_cabin_test) {
+
+  // Input file name
+  const stdair::Filename_T lInputFilename (STDAIR_SAMPLE_DIR "/demand01.csv");
+
+  // Generate the date time of the requests with the statistic order method.
+  const stdair::DemandGenerationMethod lDemandGenerationMethod (stdair::DemandGenerationMethod::STA_ORD);
+
+  // Output log File
+  std::ofstream logOutputFile;
+  logOutputFile.open ("DemandGenerationTestSuite_multicabin.log");
+  logOutputFile.clear();
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+
+  // One demand stream per cabin
+  CabinRequestSink lPerCabinSink;
+  stdair::Count_T lPerCabinExpectedNbOfEvents (0);
+  {
+    TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                   stdair::DEFAULT_RANDOM_SEED);
+    trademgenService.parseAndLoad (lInputFilename);
+    lPerCabinExpectedNbOfEvents =
+      trademgenService.getExpectedTotalNumberOfRequestsToBeGenerated();
+    trademgenService.generateRunByStream (lPerCabinSink,
+                                          lDemandGenerationMethod, 1);
+  }
+  BOOST_REQUIRE (lPerCabinSink._nbOfRequests != 0);
+
+  // The cabins sharing their arrival pattern share their demand streams
+  CabinRequestSink lMultiCabinSink;
+  CabinRequestSink lAggregatedSink;
+  stdair::Count_T lMultiCabinExpectedNbOfEvents (0);
+  {
+    TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                   stdair::DEFAULT_RANDOM_SEED);
+    trademgenService.setMultiCabinDemand (true);
+    trademgenService.parseAndLoad (lInputFilename);
+    lMultiCabinExpectedNbOfEvents =
+      trademgenService.getExpectedTotalNumberOfRequestsToBeGenerated();
+    trademgenService.reseed (stdair::DEFAULT_RANDOM_SEED);
+    trademgenService.generateRunByStream (lMultiCabinSink,
+                                          lDemandGenerationMethod, 1);
+
+    // The booking requests of different cabins are not merged
+    const stdair::Duration_T lAggregationPeriod (24, 0, 0);
+    trademgenService.reseed (stdair::DEFAULT_RANDOM_SEED);
+    trademgenService.generateAggregatedRunByStream (lAggregatedSink,
+                                                    lDemandGenerationMethod,
+                                                    lAggregationPeriod, 1);
+
+    // The demand streams are not those of the demands anymore
+    BOOST_CHECK_THROW (trademgenService.reloadDemand (lInputFilename),
+                       TRADEMGEN::DemandReloadException);
+
+    // The demand distribution of a demand stream cannot be split among
+    // its cabins
+    TRADEMGEN::DemandAdjustmentStruct lCabinAdjustment;
+    lCabinAdjustment._prefCabin = "Y";
+    lCabinAdjustment._meanMultiplier = 1.1;
+    BOOST_CHECK_THROW (trademgenService.adjustDemand (lCabinAdjustment),
+                       TRADEMGEN::TrademgenGenerationException);
+  }
+
+  // Same expected demand (up to the rounding), with no more demand
+  // streams, every booking request being given one of the cabins of
+  // its demand stream
+  BOOST_REQUIRE (lMultiCabinSink._nbOfRequests != 0);
+  BOOST_CHECK (std::abs (lMultiCabinExpectedNbOfEvents
+                         - lPerCabinExpectedNbOfEvents) <= 1);
+  BOOST_CHECK (lMultiCabinSink._demandStreamKeySet.size()
+               <= lPerCabinSink._demandStreamKeySet.size());
+  BOOST_CHECK_EQUAL (lPerCabinSink._nbOfMisplacedRequests, 0);
+  BOOST_CHECK_EQUAL (lMultiCabinSink._nbOfMisplacedRequests, 0);
+
+  // The aggregation keeps the passengers of every cabin
+  BOOST_CHECK_EQUAL (lAggregatedSink._nbOfMisplacedRequests, 0);
+  BOOST_CHECK (lAggregatedSink._nbOfPassengersByCabin
+               == lMultiCabinSink._nbOfPassengersByCabin);
+
+  // Close the log file
+  logOutputFile.close();
+}
+
+/**
+ * Only draw some fields of the booking requests
+ */
+BOOST_AUTO_TEST_CASE (trademgen_request_field_mask_test) {
+
+  // Input file name
+  const stdair::Filename_T lInputFilename (STDAIR_SAMPLE_DIR "/demand01.csv");
+
+  // Generate the date time of the requests with the statistic order method.
+  const stdair::DemandGenerationMethod lDemandGenerationMethod (stdair::DemandGenerationMethod::STA_ORD);
+
+  // Output log File
+  std::ofstream logOutputFile;
+  logOutputFile.open ("DemandGenerationTestSuite_fieldmask.log");
+  logOutputFile.clear();
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+
+  // Unknown field
+  BOOST_CHECK_THROW (TRADEMGEN::RequestFieldMask ("pos,fare"),
+                     TRADEMGEN::TrademgenGenerationException);
+  BOOST_CHECK_EQUAL (TRADEMGEN::RequestFieldMask ("wtp,pos").describe(),
+                     "pos,wtp");
+
+  // Usual generation
+  RequestListSink lUsualSink;
+  {
+    TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                   stdair::DEFAULT_RANDOM_SEED);
+    trademgenService.parseAndLoad (lInputFilename);
+    trademgenService.generateRunByStream (lUsualSink,
+                                          lDemandGenerationMethod, 1);
+  }
+  BOOST_REQUIRE (lUsualSink._requestList.empty() == false);
+
+  // All the fields drawn from their own sub-streams
+  ProjectedRequestSink lAllFieldSink;
+  {
+    TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                   stdair::DEFAULT_RANDOM_SEED);
+    trademgenService.parseAndLoad (lInputFilename);
+    trademgenService.setRequestFieldMask (TRADEMGEN::RequestFieldMask());
+    trademgenService.generateRunByStream (lAllFieldSink,
+                                          lDemandGenerationMethod, 1);
+  }
+
+  // Only the WTP, for two runs
+  ProjectedRequestSink lWTPSink;
+  ProjectedRequestSink lWTPSecondRunSink;
+  {
+    TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                   stdair::DEFAULT_RANDOM_SEED);
+    trademgenService.parseAndLoad (lInputFilename);
+    trademgenService.setRequestFieldMask (TRADEMGEN::RequestFieldMask ("wtp"));
+    trademgenService.generateRunByStream (lWTPSink,
+                                          lDemandGenerationMethod, 1);
+    trademgenService.generateRunByStream (lWTPSecondRunSink,
+                                          lDemandGenerationMethod, 1);
+  }
+
+  // Back to the usual generation
+  RequestListSink lUnsetSink;
+  {
+    TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                   stdair::DEFAULT_RANDOM_SEED);
+    trademgenService.parseAndLoad (lInputFilename);
+    trademgenService.setRequestFieldMask (TRADEMGEN::RequestFieldMask ("pos"));
+    trademgenService.unsetRequestFieldMask();
+    trademgenService.generateRunByStream (lUnsetSink,
+                                          lDemandGenerationMethod, 1);
+  }
+
+  // The same booking requests, with the same WTP, whatever the mask,
+  // the other fields being left empty
+  BOOST_CHECK (lAllFieldSink._requestList == lWTPSink._requestList);
+  BOOST_CHECK_EQUAL (lAllFieldSink._nbOfRequestsWithPOS,
+                     lAllFieldSink._requestList.size());
+  BOOST_CHECK_EQUAL (lWTPSink._nbOfRequestsWithPOS, 0);
+  BOOST_CHECK_EQUAL (lWTPSink._nbOfRequestsWithChannel, 0);
+
+  // Another run draws other WTP, the first booking request of a demand
+  // stream included
+  BOOST_REQUIRE (lWTPSecondRunSink._requestList.empty() == false);
+  BOOST_CHECK (lWTPSecondRunSink._firstWTPByDemandStream
+               != lWTPSink._firstWTPByDemandStream);
+
+  // No change to the usual generation once the mask is unset
+  BOOST_CHECK (lUnsetSink._requestList == lUsualSink._requestList);
+
+  // Close the log file
+  logOutputFile.close();
+}
+
+/**
+ * Only count the booking requests, by DTD bucket (and by channel)
+ */
+BOOST_AUTO_TEST_CASE (trademgen_arrival_count_test) {
+
+  // Input file name
+  const stdair::Filename_T lInputFilename (STDAIR_SAMPLE_DIR "/demand01.csv");
+
+  // Output log File
+  std::ofstream logOutputFile;
+  logOutputFile.open ("DemandGenerationTestSuite_arrivalcount.log");
+  logOutputFile.clear();
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+
+  // The bounds of the DTD buckets must be decreasing
+  TRADEMGEN::ArrivalCountTable::DTDList_T lDTDBoundaryList;
+  lDTDBoundaryList.push_back (7);
+  lDTDBoundaryList.push_back (30);
+  BOOST_CHECK_THROW (TRADEMGEN::ArrivalCountTable (lDTDBoundaryList, false),
+                     TRADEMGEN::TrademgenGenerationException);
+  std::reverse (lDTDBoundaryList.begin(), lDTDBoundaryList.end());
+  lDTDBoundaryList.insert (lDTDBoundaryList.begin(), 90);
+
+  // Order statistics: the total numbers of requests split among the
+  // DTD buckets, with the channels left aside, ...
+  const stdair::DemandGenerationMethod lStatisticsOrder (stdair::DemandGenerationMethod::STA_ORD);
+  TRADEMGEN::ArrivalCountTable lCountTable (lDTDBoundaryList, false);
+  stdair::Count_T lNbOfArrivals (0);
+  {
+    TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                   stdair::DEFAULT_RANDOM_SEED);
+    trademgenService.parseAndLoad (lInputFilename);
+    lNbOfArrivals =
+      trademgenService.generateArrivalCounts (lCountTable, lStatisticsOrder, 1);
+  }
+  BOOST_REQUIRE (lNbOfArrivals != 0);
+  BOOST_CHECK_EQUAL (lCountTable.getTotalCount(), lNbOfArrivals);
+  BOOST_CHECK_EQUAL (lCountTable.getNbOfBuckets(), 4U);
+  BOOST_CHECK_EQUAL (lCountTable.getNbOfChannels(), 1U);
+
+  // ... and by channel, the DTD buckets being drawn the same way
+  TRADEMGEN::ArrivalCountTable lChannelCountTable (lDTDBoundaryList, true);
+  {
+    TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                   stdair::DEFAULT_RANDOM_SEED);
+    trademgenService.parseAndLoad (lInputFilename);
+    trademgenService.generateArrivalCounts (lChannelCountTable,
+                                            lStatisticsOrder, 1);
+  }
+  BOOST_REQUIRE (lChannelCountTable.getChannelList().empty() == false);
+  BOOST_REQUIRE (lChannelCountTable.getDemandStreamKeyList()
+                 == lCountTable.getDemandStreamKeyList());
+  for (std::size_t lStreamIdx = 0;
+       lStreamIdx != lCountTable.getDemandStreamKeyList().size();
+       ++lStreamIdx) {
+    for (std::size_t lBucketIdx = 0;
+         lBucketIdx != lCountTable.getNbOfBuckets(); ++lBucketIdx) {
+      stdair::Count_T lBucketCount (0);
+      for (std::size_t lChannelIdx = 0;
+           lChannelIdx != lChannelCountTable.getNbOfChannels(); ++lChannelIdx) {
+        lBucketCount +=
+          lChannelCountTable.getCount (lStreamIdx, lChannelIdx, lBucketIdx);
+      }
+      BOOST_CHECK_EQUAL (lBucketCount,
+                         lCountTable.getCount (lStreamIdx, 0, lBucketIdx));
+    }
+  }
+
+  // The same totals as when the booking requests are generated, but for
+  // the ones which would come after the preferred departure date-time,
+  // which are counted but not generated
+  PassengerCountSink lRequestSink;
+  {
+    TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                   stdair::DEFAULT_RANDOM_SEED);
+    trademgenService.parseAndLoad (lInputFilename);
+    trademgenService.generateRunByStream (lRequestSink, lStatisticsOrder, 1);
+  }
+  BOOST_CHECK (static_cast<stdair::Count_T> (lRequestSink._nbOfRequests)
+               <= lNbOfArrivals);
+
+  // Poisson process: a Poisson number of requests within every DTD
+  // bucket, the sum of which is hence around the expected demand
+  const stdair::DemandGenerationMethod lPoissonProcess (stdair::DemandGenerationMethod::POI_PRO);
+  TRADEMGEN::ArrivalCountTable lPoissonCountTable (lDTDBoundaryList, false);
+  {
+    TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                   stdair::DEFAULT_RANDOM_SEED);
+    trademgenService.parseAndLoad (lInputFilename);
+    const stdair::Count_T lExpectedNbOfArrivals =
+      trademgenService.getExpectedTotalNumberOfRequestsToBeGenerated();
+    const stdair::Count_T lPoissonNbOfArrivals =
+      trademgenService.generateArrivalCounts (lPoissonCountTable,
+                                              lPoissonProcess, 1);
+    BOOST_CHECK (std::abs (static_cast<double> (lPoissonNbOfArrivals
+                                                - lExpectedNbOfArrivals))
+                 <= 5.0 * std::sqrt (static_cast<double> (lExpectedNbOfArrivals))
+                 + 1.0);
+  }
+
+  // Poisson process: no arrival within the last day before the
+  // departure, as the Poisson process does not generate any there
+  TRADEMGEN::ArrivalCountTable::DTDList_T lLastDayDTDBoundaryList;
+  lLastDayDTDBoundaryList.push_back (7);
+  lLastDayDTDBoundaryList.push_back (1);
+  TRADEMGEN::ArrivalCountTable lLastDayCountTable (lLastDayDTDBoundaryList,
+                                                   false);
+  {
+    TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                   stdair::DEFAULT_RANDOM_SEED);
+    trademgenService.parseAndLoad (lInputFilename);
+    BOOST_CHECK (trademgenService.generateArrivalCounts (lLastDayCountTable,
+                                                         lPoissonProcess, 1)
+                 > 0);
+  }
+  for (std::size_t lStreamIdx = 0;
+       lStreamIdx != lLastDayCountTable.getDemandStreamKeyList().size();
+       ++lStreamIdx) {
+    BOOST_CHECK_EQUAL (lLastDayCountTable.getCount (lStreamIdx, 0, 2), 0);
+  }
+
+  // Close the log file
+  logOutputFile.close();
+}
+
+/**
+ * Test an error case: the compiled demand model is corrupted
+ */
+BOOST_AUTO_TEST_CASE (trademgen_corrupted_compiled_demand_model_test) {
+
+  // Compiled demand model file name
+  const stdair::Filename_T
+    lCompiledFilename ("DemandGenerationTestSuite_corrupted.tdgm");
+  {
+    std::ofstream lCompiledFile (lCompiledFilename.c_str());
+    lCompiledFile << "This is not a compiled demand model" << std::endl;
+  }
+
+  // Output log File
+  std::ofstream logOutputFile;
+  logOutputFile.open ("DemandGenerationTestSuite_corrupted.log");
+  logOutputFile.clear();
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+
+  TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                 stdair::DEFAULT_RANDOM_SEED);
+  BOOST_CHECK_THROW (trademgenService.loadCompiledModel (lCompiledFilename),
+                     TRADEMGEN::CompiledDemandModelException);
+
+  // Close the log file
+  logOutputFile.close();
+}
+
 // End the test suite
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -0,0 +1,414 @@
+/*!
+ * \page DemandParserTestSuite_cpp Command-Line Test to Compare the Demand Input File Parsers
+ * \code
+ */
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cstdio>
+#include <sstream>
+#include <fstream>
+#include <string>
+// Boost
+#include <boost/version.hpp>
+#include <boost/iostreams/copy.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#if BOOST_VERSION >= 107000
+#include <boost/iostreams/filter/zstd.hpp>
+#endif // BOOST_VERSION >= 107000
+// Boost Unit Test Framework (UTF)
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE DemandParserTest
+#include <boost/test/unit_test.hpp>
+// StdAir
+#include <stdair/stdair_basic_types.hpp>
+#include <stdair/basic/BasConst_General.hpp>
+#include <stdair/basic/BasChronometer.hpp>
+#include <stdair/basic/BasLogParams.hpp>
+#include <stdair/basic/RandomGeneration.hpp>
+// TraDemGen
+#include <trademgen/TRADEMGEN_Exceptions.hpp>
+#include <trademgen/TRADEMGEN_Service.hpp>
+#include <trademgen/basic/BasConst_DemandGeneration.hpp>
+#include <trademgen/command/CompiledDemandModel.hpp>
+#include <trademgen/command/DemandParserHelper.hpp>
+#include <trademgen/command/MappedDemandFileParser.hpp>
+#include <trademgen/config/trademgen-paths.hpp>
+
+namespace boost_utf = boost::unit_test;
+
+// (Boost) Unit Test XML Report
+std::ofstream utfReportStream ("DemandParserTestSuite_utfresults.xml");
+
+/**
+ * Configuration for the Boost Unit Test Framework (UTF)
+ */
+struct UnitTestConfig {
+  /** Constructor. */
+  UnitTestConfig() {
+    boost_utf::unit_test_log.set_stream (utfReportStream);
+#if BOOST_VERSION_MACRO >= 105900
+    boost_utf::unit_test_log.set_format (boost_utf::OF_XML);
+#else // BOOST_VERSION_MACRO
+    boost_utf::unit_test_log.set_format (boost_utf::XML);
+#endif // BOOST_VERSION_MACRO
+    boost_utf::unit_test_log.set_threshold_level (boost_utf::log_test_units);
+  }
+
+  /** Destructor. */
+  ~UnitTestConfig() {
+  }
+};
+
+/**
+ * Demand, as given in the demand input files.
+ */
+const std::string K_DEMAND_LINE ("2010-02-08; 2010-02-28; 0000011; SIN; BKK; Y; "
+                                 "SIN:0.7, BKK:0.2, row:0.1; "
+                                 "DF:0.1, DN:0.3, IF:0.4, IN:0.2; "
+                                 "RO:0.6, RI:0.2, OW:0.2; "
+                                 "0:0.1, 1:0.1, 2:0.15, 3:0.15, 4:0.15, 5:0.35; "
+                                 "P:0.01, G:0.05, S:0.15, M:0.3, N:0.49; "
+                                 "0.3; 30.0; 0.7; 50.0; "
+                                 "6:0, 7:0.1, 9:0.3, 17.30:0.4, 19:0.8, "
+                                 "20:0.95, 22:1; 200; 15:0, 60:1; "
+                                 "330:0, 40:0.2, 20:0.6, 1:1; N, 10.0, 1.0;\n");
+
+// //////////////////////////////////////////////////////////////////////
+/**
+ * Read the whole content of the given file.
+ */
+std::string readFile (const stdair::Filename_T& iFilename) {
+  std::ifstream lFile (iFilename.c_str(), std::ios::binary);
+  std::ostringstream oStr;
+  oStr << lFile.rdbuf();
+  return oStr.str();
+}
+
+// //////////////////////////////////////////////////////////////////////
+/**
+ * Parse the given demand input file with both the (Boost Spirit based)
+ * DemandFileParser and the (hand-written) MappedDemandFileParser, the
+ * demands being compiled, and check that both parsers give the same
+ * compiled demand model, and stop at the same point.
+ */
+void checkParsers (const stdair::Filename_T& iInputFilename,
+                   const bool iShouldBeFullyRead) {
+
+  stdair::RandomGeneration lGenerator (stdair::DEFAULT_RANDOM_SEED);
+  const TRADEMGEN::POSProbabilityMass_T
+    lPOSProbMass (TRADEMGEN::DEFAULT_POS_PROBALILITY_MASS);
+
+  // Reference: the Spirit based parser
+  const stdair::Filename_T lSpiritFilename ("DemandParserTestSuite_spirit.tdgm");
+  TRADEMGEN::CompiledDemandModel lSpiritModel;
+  TRADEMGEN::DemandFileParser lSpiritParser (SEVMGR::SEVMGR_ServicePtr_T(),
+                                             lGenerator, lPOSProbMass,
+                                             iInputFilename, &lSpiritModel);
+  lSpiritParser.generateDemand();
+  lSpiritModel.save (lSpiritFilename);
+
+  // Hand-written parser
+  const stdair::Filename_T lMappedFilename ("DemandParserTestSuite_mapped.tdgm");
+  TRADEMGEN::CompiledDemandModel lMappedModel;
+  TRADEMGEN::MappedDemandFileParser
+    lMappedParser (SEVMGR::SEVMGR_ServicePtr_T(), lGenerator, lPOSProbMass,
+                   iInputFilename, &lMappedModel);
+  lMappedParser.generateDemand();
+  lMappedModel.save (lMappedFilename);
+
+  BOOST_CHECK (lSpiritModel.getNbOfDemands() > 0);
+  BOOST_CHECK_EQUAL (lMappedModel.getNbOfDemands(),
+                     lSpiritModel.getNbOfDemands());
+  BOOST_CHECK_EQUAL (lMappedParser.getNbOfReadCharacters(),
+                     lSpiritParser.getNbOfReadCharacters());
+  BOOST_CHECK_EQUAL (lSpiritParser.hasBeenFullyRead(), iShouldBeFullyRead);
+  BOOST_CHECK_EQUAL (lMappedParser.hasBeenFullyRead(), iShouldBeFullyRead);
+  BOOST_CHECK (readFile (lMappedFilename) == readFile (lSpiritFilename));
+}
+
+// //////////////////////////////////////////////////////////////////////
+/**
+ * Compress the given file with the given compressor (Boost Iostreams
+ * filter).
+ */
+template <typename COMPRESSOR>
+void compressFile (const stdair::Filename_T& iInputFilename,
+                   const stdair::Filename_T& iOutputFilename,
+                   const COMPRESSOR& iCompressor) {
+  std::ifstream lInputFile (iInputFilename.c_str(), std::ios::binary);
+  std::ofstream lOutputFile (iOutputFilename.c_str(), std::ios::binary);
+  boost::iostreams::filtering_ostream lCompressedStream;
+  lCompressedStream.push (iCompressor);
+  lCompressedStream.push (lOutputFile);
+  boost::iostreams::copy (lInputFile, lCompressedStream);
+}
+
+// //////////////////////////////////////////////////////////////////////
+/**
+ * Parse the given (compressed) demand input file, and check that the
+ * parser gives the same compiled demand model as on the (uncompressed)
+ * reference file, and stops at the same point.
+ */
+void checkCompressedParser (const stdair::Filename_T& iInputFilename,
+                            const stdair::Filename_T& iCompressedFilename) {
+
+  stdair::RandomGeneration lGenerator (stdair::DEFAULT_RANDOM_SEED);
+  const TRADEMGEN::POSProbabilityMass_T
+    lPOSProbMass (TRADEMGEN::DEFAULT_POS_PROBALILITY_MASS);
+
+  // Reference: the uncompressed file
+  const stdair::Filename_T lRefFilename ("DemandParserTestSuite_plain.tdgm");
+  TRADEMGEN::CompiledDemandModel lRefModel;
+  TRADEMGEN::MappedDemandFileParser
+    lRefParser (SEVMGR::SEVMGR_ServicePtr_T(), lGenerator, lPOSProbMass,
+                iInputFilename, &lRefModel);
+  lRefParser.generateDemand();
+  lRefModel.save (lRefFilename);
+
+  // Compressed file
+  const stdair::Filename_T
+    lCompressedModelFilename ("DemandParserTestSuite_compressed.tdgm");
+  TRADEMGEN::CompiledDemandModel lCompressedModel;
+  TRADEMGEN::MappedDemandFileParser
+    lCompressedParser (SEVMGR::SEVMGR_ServicePtr_T(), lGenerator, lPOSProbMass,
+                       iCompressedFilename, &lCompressedModel);
+  lCompressedParser.generateDemand();
+  lCompressedModel.save (lCompressedModelFilename);
+
+  BOOST_CHECK (lRefParser.isCompressed() == false);
+  BOOST_CHECK (lCompressedParser.isCompressed() == true);
+  BOOST_CHECK_EQUAL (lCompressedModel.getNbOfDemands(),
+                     lRefModel.getNbOfDemands());
+  BOOST_CHECK_EQUAL (lCompressedParser.getNbOfReadCharacters(),
+                     lRefParser.getNbOfReadCharacters());
+  BOOST_CHECK_EQUAL (lCompressedParser.hasBeenFullyRead(),
+                     lRefParser.hasBeenFullyRead());
+  BOOST_CHECK (readFile (lCompressedModelFilename) == readFile (lRefFilename));
+}
+
+// /////////////// Main: Unit Test Suite //////////////
+
+// Set the UTF configuration (re-direct the output to a specific file)
+BOOST_GLOBAL_FIXTURE (UnitTestConfig);
+
+// Start the test suite
+BOOST_AUTO_TEST_SUITE (master_test_suite)
+
+/**
+ * Test that both parsers give the same demands, on the sample demand
+ * input file
+ */
+BOOST_AUTO_TEST_CASE (trademgen_parser_sample_file_test) {
+
+  // Output log File
+  std::ofstream logOutputFile;
+  logOutputFile.open ("DemandParserTestSuite_sample.log");
+  logOutputFile.clear();
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+  TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                 stdair::DEFAULT_RANDOM_SEED);
+
+  checkParsers (STDAIR_SAMPLE_DIR "/demand01.csv", true);
+
+  // Close the log file
+  logOutputFile.close();
+}
+
+/**
+ * Test that both parsers give the same demands, and stop at the same
+ * point, on a demand input file made of comments, blanks, the various
+ * forms of real numbers, DOS-like ends of line and an invalid demand
+ */
+BOOST_AUTO_TEST_CASE (trademgen_parser_syntax_test) {
+
+  // Output log File
+  std::ofstream logOutputFile;
+  logOutputFile.open ("DemandParserTestSuite_syntax.log");
+  logOutputFile.clear();
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+  TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                 stdair::DEFAULT_RANDOM_SEED);
+
+  // Input file
+  const stdair::Filename_T lInputFilename ("DemandParserTestSuite_syntax.csv");
+  {
+    std::ofstream lInputFile (lInputFilename.c_str(), std::ios::binary);
+    lInputFile << "  // Demand input file\r\n"
+               << "/* C-like\n   comment */\n"
+               << K_DEMAND_LINE
+               << "\t\r\n"
+               << " 2010-03-01 ;2010-03-31;1111111; NCE;  C D G; M;"
+               << "row:1; DN : .5, IN: 5.e-1; OW:1; 0:1; N:1; 0; 0; 0; 0;"
+               << "8.15.30:0, 10:.25, 12.05:1; 1E2; 15:0, 60.5:1; "
+               << "330.7:0, 1.:1; N, 2.5e+0, 0.;  // Trailing comment\r\n"
+               << K_DEMAND_LINE
+               << "2010-04-01; 2010-04-30; 0000011; SIN; BKK; ; "
+               << "SIN:1; DN:1; OW:1; 0:1; N:1; 0; 0; 0; 0; 10:1; 100; "
+               << "15:1; 1:1; N, 1.0, 0.0;\n"
+               << K_DEMAND_LINE;
+  }
+
+  // The last but one demand, having no cabin, stops the parsing
+  checkParsers (lInputFilename, false);
+
+  // Close the log file
+  logOutputFile.close();
+}
+
+/**
+ * Test that the compressed (gzip and zstd) demand input files give the
+ * same demands as the uncompressed ones, on the sample demand input file
+ * and on a demand input file made of many lines (bigger than the
+ * decompression buffer), C-like comments and an invalid demand
+ */
+BOOST_AUTO_TEST_CASE (trademgen_parser_compressed_file_test) {
+
+  // Output log File
+  std::ofstream logOutputFile;
+  logOutputFile.open ("DemandParserTestSuite_compressed.log");
+  logOutputFile.clear();
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+  TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                 stdair::DEFAULT_RANDOM_SEED);
+
+  // Input files
+  const stdair::Filename_T lSampleFilename (STDAIR_SAMPLE_DIR "/demand01.csv");
+  const stdair::Filename_T lBigFilename ("DemandParserTestSuite_big.csv");
+  {
+    std::ofstream lInputFile (lBigFilename.c_str(), std::ios::binary);
+    for (std::size_t idx = 0; idx != 10000; ++idx) {
+      lInputFile << K_DEMAND_LINE;
+      if (idx % 1000 == 0) {
+        lInputFile << "/* C-like\n   comment */ /* spanning\n\n lines */\n";
+      }
+    }
+    lInputFile << "2010-04-01; 2010-04-30; 0000011; SIN; BKK; ; "
+               << "SIN:1; DN:1; OW:1; 0:1; N:1; 0; 0; 0; 0; 10:1; 100; "
+               << "15:1; 1:1; N, 1.0, 0.0;\n"
+               << K_DEMAND_LINE;
+  }
+
+  compressFile (lSampleFilename, "DemandParserTestSuite_sample.csv.gz",
+                boost::iostreams::gzip_compressor());
+  checkCompressedParser (lSampleFilename,
+                         "DemandParserTestSuite_sample.csv.gz");
+  compressFile (lBigFilename, "DemandParserTestSuite_big.csv.gz",
+                boost::iostreams::gzip_compressor());
+  checkCompressedParser (lBigFilename, "DemandParserTestSuite_big.csv.gz");
+
+#if BOOST_VERSION >= 107000
+  compressFile (lSampleFilename, "DemandParserTestSuite_sample.csv.zst",
+                boost::iostreams::zstd_compressor());
+  checkCompressedParser (lSampleFilename,
+                         "DemandParserTestSuite_sample.csv.zst");
+  compressFile (lBigFilename, "DemandParserTestSuite_big.csv.zst",
+                boost::iostreams::zstd_compressor());
+  checkCompressedParser (lBigFilename, "DemandParserTestSuite_big.csv.zst");
+#endif // BOOST_VERSION >= 107000
+
+  // A truncated compressed file can not be parsed
+  const stdair::Filename_T
+    lTruncatedFilename ("DemandParserTestSuite_truncated.csv.gz");
+  {
+    const std::string lCompressedContent =
+      readFile ("DemandParserTestSuite_big.csv.gz");
+    std::ofstream lTruncatedFile (lTruncatedFilename.c_str(),
+                                  std::ios::binary);
+    lTruncatedFile << lCompressedContent.substr (0,
+                                                 lCompressedContent.size() / 2);
+  }
+  stdair::RandomGeneration lGenerator (stdair::DEFAULT_RANDOM_SEED);
+  const TRADEMGEN::POSProbabilityMass_T
+    lPOSProbMass (TRADEMGEN::DEFAULT_POS_PROBALILITY_MASS);
+  TRADEMGEN::MappedDemandFileParser
+    lTruncatedParser (SEVMGR::SEVMGR_ServicePtr_T(), lGenerator, lPOSProbMass,
+                      lTruncatedFilename);
+  BOOST_CHECK_THROW (lTruncatedParser.generateDemand(),
+                     TRADEMGEN::DemandInputFileDecompressionException);
+
+  // Close the log file
+  logOutputFile.close();
+}
+
+/**
+ * Benchmark both parsers on a demand input file of a million lines. The
+ * demands are just parsed (no demand stream is created). The rates are
+ * reported (in the XML report), but not checked, as they depend on the
+ * machine.
+ */
+BOOST_AUTO_TEST_CASE (trademgen_parser_throughput_test) {
+
+  // Output log File
+  std::ofstream logOutputFile;
+  logOutputFile.open ("DemandParserTestSuite_throughput.log");
+  logOutputFile.clear();
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+  TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                 stdair::DEFAULT_RANDOM_SEED);
+
+  // Input file
+  const stdair::Filename_T
+    lInputFilename ("DemandParserTestSuite_throughput.csv");
+  const std::size_t lNbOfLines = 1000000;
+  {
+    std::ofstream lInputFile (lInputFilename.c_str(), std::ios::binary);
+    for (std::size_t idx = 0; idx != lNbOfLines; ++idx) {
+      lInputFile << K_DEMAND_LINE;
+    }
+  }
+
+  stdair::RandomGeneration lGenerator (stdair::DEFAULT_RANDOM_SEED);
+  const TRADEMGEN::POSProbabilityMass_T
+    lPOSProbMass (TRADEMGEN::DEFAULT_POS_PROBALILITY_MASS);
+
+  // Reference: the Spirit based parser
+  stdair::BasChronometer lSpiritChronometer;
+  lSpiritChronometer.start();
+  TRADEMGEN::DemandFileParser lSpiritParser (SEVMGR::SEVMGR_ServicePtr_T(),
+                                             lGenerator, lPOSProbMass,
+                                             lInputFilename);
+  lSpiritParser.generateDemand();
+  const double lSpiritMeasure = lSpiritChronometer.elapsed();
+
+  // Hand-written parser
+  stdair::BasChronometer lMappedChronometer;
+  lMappedChronometer.start();
+  TRADEMGEN::MappedDemandFileParser
+    lMappedParser (SEVMGR::SEVMGR_ServicePtr_T(), lGenerator, lPOSProbMass,
+                   lInputFilename);
+  lMappedParser.generateDemand();
+  const double lMappedMeasure = lMappedChronometer.elapsed();
+
+  BOOST_CHECK_EQUAL (lSpiritParser.getNbOfReadCharacters(),
+                     lMappedParser.getNbOfReadCharacters());
+  BOOST_CHECK (lSpiritParser.hasBeenFullyRead() == true);
+  BOOST_CHECK (lMappedParser.hasBeenFullyRead() == true);
+
+  const double lSpiritLinesPerSecond =
+    (lSpiritMeasure > 0) ? lNbOfLines / lSpiritMeasure : 0;
+  const double lMappedLinesPerSecond =
+    (lMappedMeasure > 0) ? lNbOfLines / lMappedMeasure : 0;
+  BOOST_TEST_MESSAGE ("Parsed " << lNbOfLines << " demand lines in "
+                      << lSpiritMeasure << " s with the Spirit parser, i.e., "
+                      << lSpiritLinesPerSecond << " lines per second, and in "
+                      << lMappedMeasure << " s with the hand-written parser, "
+                      << "i.e., " << lMappedLinesPerSecond
+                      << " lines per second");
+
+  // The input file is rather big
+  std::remove (lInputFilename.c_str());
+
+  // Close the log file
+  logOutputFile.close();
+}
+
+// End the test suite
+BOOST_AUTO_TEST_SUITE_END()
+
+/*!
+ * \endcode
+ */
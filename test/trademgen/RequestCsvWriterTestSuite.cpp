@@ -0,0 +1,225 @@
+/*!
+ * \page RequestCsvWriterTestSuite_cpp Command-Line Test to Demonstrate How To Dump Booking Requests into CSV Files
+ * \code
+ */
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <sstream>
+#include <fstream>
+#include <string>
+// Boost Unit Test Framework (UTF)
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE RequestCsvWriterTest
+#include <boost/test/unit_test.hpp>
+// StdAir
+#include <stdair/stdair_basic_types.hpp>
+#include <stdair/stdair_date_time_types.hpp>
+#include <stdair/basic/BasChronometer.hpp>
+#include <stdair/bom/BookingRequestStruct.hpp>
+// TraDemGen
+#include <trademgen/TRADEMGEN_Exceptions.hpp>
+#include <trademgen/basic/BasConst_RequestOutput.hpp>
+#include <trademgen/command/RequestCsvWriter.hpp>
+
+namespace boost_utf = boost::unit_test;
+
+// (Boost) Unit Test XML Report
+std::ofstream utfReportStream ("RequestCsvWriterTestSuite_utfresults.xml");
+
+/**
+ * Configuration for the Boost Unit Test Framework (UTF)
+ */
+struct UnitTestConfig {
+  /** Constructor. */
+  UnitTestConfig() {
+    boost_utf::unit_test_log.set_stream (utfReportStream);
+#if BOOST_VERSION_MACRO >= 105900
+    boost_utf::unit_test_log.set_format (boost_utf::OF_XML);
+#else // BOOST_VERSION_MACRO
+    boost_utf::unit_test_log.set_format (boost_utf::XML);
+#endif // BOOST_VERSION_MACRO
+    boost_utf::unit_test_log.set_threshold_level (boost_utf::log_test_units);
+  }
+
+  /** Destructor. */
+  ~UnitTestConfig() {
+  }
+};
+
+// //////////////////////////////////////////////////////////////////////
+/**
+ * Build a booking request, similar to the ones generated by the demand
+ * streams.
+ */
+stdair::BookingRequestStruct buildBookingRequest() {
+  const stdair::Date_T lPreferredDepartureDate (2010, boost::gregorian::Feb, 8);
+  const stdair::DateTime_T
+    lRequestDateTime (stdair::Date_T (2010, boost::gregorian::Jan, 15),
+                      boost::posix_time::hours (10)
+                      + boost::posix_time::minutes (2)
+                      + boost::posix_time::millisec (3457));
+  const stdair::Duration_T lPreferredDepartureTime (8, 0, 0);
+
+  return stdair::BookingRequestStruct ("SIN-BKK 2010-Feb-08 Y", "SIN", "BKK",
+                                       "SIN", lPreferredDepartureDate,
+                                       lRequestDateTime, "Y", 1, "DN", "RO",
+                                       7, "M", lPreferredDepartureTime,
+                                       1234.567, 15.5, true, 30.0, false, 50.0);
+}
+
+// /////////////// Main: Unit Test Suite //////////////
+
+// Set the UTF configuration (re-direct the output to a specific file)
+BOOST_GLOBAL_FIXTURE (UnitTestConfig);
+
+// Start the test suite
+BOOST_AUTO_TEST_SUITE (master_test_suite)
+
+/**
+ * Test the content of the CSV rows
+ */
+BOOST_AUTO_TEST_CASE (trademgen_csv_writer_content_test) {
+
+  // Output CSV file
+  const stdair::Filename_T lOutputFilename ("RequestCsvWriterTestSuite.csv");
+
+  stdair::BookingRequestStruct lBookingRequest = buildBookingRequest();
+  {
+    TRADEMGEN::RequestCsvWriter lRequestWriter (lOutputFilename);
+    lRequestWriter.writeHeader();
+    lRequestWriter.write (lBookingRequest);
+    lRequestWriter.setRunNumber (2);
+    lBookingRequest.setPartySize (3);
+    lRequestWriter.write (lBookingRequest);
+    lRequestWriter.close();
+    BOOST_CHECK_EQUAL (lRequestWriter.getNbOfWrittenRequests(), 2U);
+  }
+
+  // Read the CSV file back
+  std::ifstream lCsvFile (lOutputFilename.c_str());
+  std::string lHeader, lFirstRow, lSecondRow;
+  std::getline (lCsvFile, lHeader);
+  std::getline (lCsvFile, lFirstRow);
+  std::getline (lCsvFile, lSecondRow);
+
+  BOOST_CHECK_EQUAL (lHeader.substr (0, 22), "run,request_date_time,");
+  BOOST_CHECK_EQUAL (lFirstRow,
+                     "1,2010-01-15 10:02:03.457,SIN,BKK,SIN,2010-02-08,"
+                     "08:00:00,Y,1,DN,RO,7,M,1234.57,15.50,1,30.00,0,50.00");
+  BOOST_CHECK_EQUAL (lSecondRow,
+                     "2,2010-01-15 10:02:03.457,SIN,BKK,SIN,2010-02-08,"
+                     "08:00:00,Y,3,DN,RO,7,M,1234.57,15.50,1,30.00,0,50.00");
+}
+
+/**
+ * Test an error case: the output file cannot be created
+ */
+BOOST_AUTO_TEST_CASE (trademgen_csv_writer_wrong_path_test) {
+
+  // Output CSV file, within a directory which does not exist
+  const stdair::Filename_T lOutputFilename ("missingDirectory/requests.csv");
+
+  BOOST_CHECK_THROW (TRADEMGEN::RequestCsvWriter lRequestWriter (lOutputFilename),
+                     TRADEMGEN::RequestOutputException);
+}
+
+/**
+ * Test the asynchronous mode: the content must be the same as with
+ * the synchronous mode, even when a lot of (small) blocks are written
+ */
+BOOST_AUTO_TEST_CASE (trademgen_csv_writer_async_test) {
+
+  // Output CSV files
+  const stdair::Filename_T lSyncFilename ("RequestCsvWriterTestSuite_sync.csv");
+  const stdair::Filename_T lAsyncFilename ("RequestCsvWriterTestSuite_async.csv");
+
+  // Number of rows to be written, and (small) size of the blocks
+  const std::size_t lNbOfRows = 10000;
+  const std::size_t lBlockSize = 1024;
+
+  stdair::BookingRequestStruct lBookingRequest = buildBookingRequest();
+  {
+    TRADEMGEN::RequestCsvWriter lSyncWriter (lSyncFilename, lBlockSize, 1);
+    TRADEMGEN::RequestCsvWriter lAsyncWriter (lAsyncFilename, lBlockSize, 3);
+    lSyncWriter.writeHeader();
+    lAsyncWriter.writeHeader();
+    for (std::size_t idx = 0; idx != lNbOfRows; ++idx) {
+      lBookingRequest.setPartySize (idx % 9 + 1);
+      lSyncWriter.write (lBookingRequest);
+      lAsyncWriter.write (lBookingRequest);
+    }
+    lSyncWriter.close();
+    lAsyncWriter.close();
+  }
+
+  // Compare the two files
+  std::ifstream lSyncFile (lSyncFilename.c_str());
+  std::ifstream lAsyncFile (lAsyncFilename.c_str());
+  std::ostringstream lSyncContent, lAsyncContent;
+  lSyncContent << lSyncFile.rdbuf();
+  lAsyncContent << lAsyncFile.rdbuf();
+
+  BOOST_CHECK (lSyncContent.str().size() > lNbOfRows * 90);
+  BOOST_CHECK (lSyncContent.str() == lAsyncContent.str());
+}
+
+/**
+ * Benchmark the throughput of the CSV writer. The rate is reported
+ * (in the XML report), but not checked, as it depends on the machine.
+ */
+BOOST_AUTO_TEST_CASE (trademgen_csv_writer_throughput_test) {
+
+  // Number of rows to be written
+  const std::size_t lNbOfRows = 5000000;
+
+  const stdair::BookingRequestStruct lBookingRequest = buildBookingRequest();
+  TRADEMGEN::RequestCsvWriter lRequestWriter ("/dev/null");
+
+  stdair::BasChronometer lWriteChronometer;
+  lWriteChronometer.start();
+  for (std::size_t idx = 0; idx != lNbOfRows; ++idx) {
+    lRequestWriter.write (lBookingRequest);
+  }
+  lRequestWriter.flush();
+  const double lWriteMeasure = lWriteChronometer.elapsed();
+
+  BOOST_CHECK_EQUAL (lRequestWriter.getNbOfWrittenRequests(), lNbOfRows);
+
+  const double lRowsPerSecond =
+    (lWriteMeasure > 0) ? lNbOfRows / lWriteMeasure : 0;
+  BOOST_TEST_MESSAGE ("Wrote " << lNbOfRows << " CSV rows in "
+                      << lWriteMeasure << " s, i.e., " << lRowsPerSecond
+                      << " rows per second");
+
+  // Same benchmark, with the asynchronous (double-buffered) mode
+  TRADEMGEN::RequestCsvWriter
+    lAsyncRequestWriter ("/dev/null", TRADEMGEN::DEFAULT_REQUEST_OUTPUT_BLOCK_SIZE,
+                         TRADEMGEN::DEFAULT_ASYNC_REQUEST_OUTPUT_NB_OF_BLOCKS);
+
+  stdair::BasChronometer lAsyncWriteChronometer;
+  lAsyncWriteChronometer.start();
+  for (std::size_t idx = 0; idx != lNbOfRows; ++idx) {
+    lAsyncRequestWriter.write (lBookingRequest);
+  }
+  lAsyncRequestWriter.flush();
+  const double lAsyncWriteMeasure = lAsyncWriteChronometer.elapsed();
+
+  BOOST_CHECK_EQUAL (lAsyncRequestWriter.getNbOfWrittenRequests(), lNbOfRows);
+
+  const double lAsyncRowsPerSecond =
+    (lAsyncWriteMeasure > 0) ? lNbOfRows / lAsyncWriteMeasure : 0;
+  BOOST_TEST_MESSAGE ("Wrote " << lNbOfRows << " CSV rows in "
+                      << lAsyncWriteMeasure << " s, i.e., "
+                      << lAsyncRowsPerSecond
+                      << " rows per second (asynchronous mode)");
+}
+
+// End the test suite
+BOOST_AUTO_TEST_SUITE_END()
+
+/*!
+ * \endcode
+ */
@@ -0,0 +1,71 @@
+#ifndef __TRADEMGEN_REQUESTSINK_HPP
+#define __TRADEMGEN_REQUESTSINK_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// StdAir
+#include <stdair/stdair_basic_types.hpp>
+
+// Forward declarations
+namespace stdair {
+  struct BookingRequestStruct;
+}
+
+namespace TRADEMGEN {
+
+  /**
+   * @brief Interface for the consumers of the generated booking requests.
+   *
+   * A sink receives the booking requests, one by one and in the order
+   * in which they have been generated, and does whatever it wants with
+   * them (e.g., dump them into a CSV file, forward them to another
+   * process). The booking request structure is only guaranteed to be
+   * valid for the duration of the write() call.
+   */
+  class RequestSink {
+  public:
+    // /////////// Business methods /////////
+    /**
+     * Consume the given booking request.
+     *
+     * @param const stdair::BookingRequestStruct& The booking request.
+     */
+    virtual void write (const stdair::BookingRequestStruct&) = 0;
+
+    /**
+     * Be told that the subsequent booking requests belong to the given
+     * run (the runs being numbered from 1).
+     *
+     * By default, there is nothing to be done.
+     */
+    virtual void setRunNumber (const unsigned int) {}
+
+    /**
+     * Push downstream whatever has been buffered so far.
+     *
+     * By default, there is nothing to be done.
+     */
+    virtual void flush() {}
+
+    /**
+     * Destructor.
+     */
+    virtual ~RequestSink() {}
+
+  protected:
+    /**
+     * Default constructor, protected in order to ensure the class is
+     * abstract.
+     */
+    RequestSink() {}
+
+  private:
+    /**
+     * Copy constructor (not to be used).
+     */
+    RequestSink (const RequestSink&);
+  };
+
+}
+#endif // __TRADEMGEN_REQUESTSINK_HPP
@@ -37,6 +37,21 @@ namespace TRADEMGEN {
       : stdair::FileNotFoundException (iWhat) {}
   };
 
+  /**
+   * Exception when a compressed demand input file can not be
+   * decompressed (e.g., corrupted or truncated file, or unsupported
+   * compression format)
+   */
+  class DemandInputFileDecompressionException
+    : public stdair::ParserException {
+  public:
+    /**
+     * Constructor.
+     */
+    DemandInputFileDecompressionException (const std::string& iWhat)
+      : stdair::ParserException (iWhat) {}
+  };
+
   /**
    * Exception when index out of range
    */
@@ -49,6 +64,112 @@ namespace TRADEMGEN {
       : TrademgenGenerationException (iWhat) {}
   };
 
+  /**
+   * Exception when the demands cannot be reloaded (e.g., when several
+   * demands of the new demand input file give the same demand stream)
+   */
+  class DemandReloadException : public TrademgenGenerationException {
+  public:
+    /**
+     * Constructor.
+     */
+    DemandReloadException (const std::string& iWhat)
+      : TrademgenGenerationException (iWhat) {}
+  };
+
+  /**
+   * Exception when the generation state of the demand streams cannot be
+   * restored (e.g., no snapshot, or demand streams added since)
+   */
+  class DemandSnapshotException : public TrademgenGenerationException {
+  public:
+    /**
+     * Constructor.
+     */
+    DemandSnapshotException (const std::string& iWhat)
+      : TrademgenGenerationException (iWhat) {}
+  };
+
+  /**
+   * Exception when the generated requests cannot be written out
+   */
+  class RequestOutputException : public stdair::RootException {
+  public:
+    /**
+     * Constructor.
+     */
+    RequestOutputException (const std::string& iWhat)
+      : stdair::RootException (iWhat) {}
+  };
+
+  /**
+   * Exception when the generation of the booking requests in the
+   * background cannot be started (e.g., it is already running)
+   */
+  class RequestPipelineException : public stdair::RootException {
+  public:
+    /**
+     * Constructor.
+     */
+    RequestPipelineException (const std::string& iWhat)
+      : stdair::RootException (iWhat) {}
+  };
+
+  /**
+   * Exception when a shared request ring cannot be created or attached
+   * to (e.g., no such ring, or too many readers), or when a booking
+   * request does not fit into a shared request record
+   */
+  class SharedRequestRingException : public stdair::RootException {
+  public:
+    /**
+     * Constructor.
+     */
+    SharedRequestRingException (const std::string& iWhat)
+      : stdair::RootException (iWhat) {}
+  };
+
+  /**
+   * Exception when the demand generation server and its clients cannot
+   * talk to each other (e.g., no server listening on the socket,
+   * connection lost, or generation session rejected by the server)
+   */
+  class DemandGenerationServerException : public stdair::RootException {
+  public:
+    /**
+     * Constructor.
+     */
+    DemandGenerationServerException (const std::string& iWhat)
+      : stdair::RootException (iWhat) {}
+  };
+
+  /**
+   * Exception when a request shard file cannot be written or read
+   * (e.g., booking requests out of run order, truncated file), or when
+   * request shard files cannot be merged (e.g., missing shard)
+   */
+  class RequestShardException : public stdair::RootException {
+  public:
+    /**
+     * Constructor.
+     */
+    RequestShardException (const std::string& iWhat)
+      : stdair::RootException (iWhat) {}
+  };
+
+  /**
+   * Exception when a compiled demand model cannot be written or loaded
+   * (e.g., corrupted file, or file compiled by another version)
+   */
+  class CompiledDemandModelException : public stdair::RootException {
+  public:
+    /**
+     * Constructor.
+     */
+    CompiledDemandModelException (const std::string& iWhat)
+      : stdair::RootException (iWhat) {}
+  };
+
 }
 #endif // __TRADEMGEN_TRADEMGEN_EXCEPTIONS_HPP
 
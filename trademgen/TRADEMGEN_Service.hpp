@@ -8,6 +8,7 @@
 #include <stdair/stdair_basic_types.hpp>
 #include <stdair/stdair_demand_types.hpp>
 #include <stdair/stdair_maths_types.hpp>
+#include <stdair/stdair_date_time_types.hpp>
 #include <stdair/stdair_json.hpp>
 #include <stdair/stdair_service_types.hpp>
 #include <stdair/basic/DemandGenerationMethod.hpp>
@@ -18,6 +19,7 @@
 #include <sevmgr/SEVMGR_Types.hpp>
 // TraDemGen
 #include <trademgen/TRADEMGEN_Types.hpp>
+#include <trademgen/bom/DemandScenarioStruct.hpp>
 
 // Forward declarations
 namespace stdair {  
@@ -36,7 +38,13 @@ namespace TRADEMGEN {
 
   /// Forward declarations
   class TRADEMGEN_ServiceContext; 
+  struct ArrivalCountTable;
+  struct DemandAdjustmentStruct;
+  struct DemandFilterStruct;
   struct DemandStreamKey;
+  struct RequestFieldMask;
+  class RequestSink;
+  class RequestPipeline;
   
   /**
    * @brief class holding the services related to Travel Demand Generation.
@@ -97,17 +105,200 @@ namespace TRADEMGEN {
     TRADEMGEN_Service (stdair::STDAIR_ServicePtr_T, 
 		       SEVMGR::SEVMGR_ServicePtr_T, 
 		       const stdair::RandomSeed_T&);
+
+    /**
+     * Select the demand streams to be loaded from then on (e.g., a
+     * handful of markets, or a single month of departures, out of a
+     * global demand input file), by parseAndLoad(), loadCompiledModel(),
+     * reloadDemand() and parseAndSchedule().
+     *
+     * The demand streams which are not selected are not created at all,
+     * nor are the distributions of their demands built. The selected
+     * demand streams get the same seeds, and total numbers of requests,
+     * as when all the demand streams are loaded. As for the sharded
+     * generation, the WTP of the selected demand streams is drawn from
+     * their own random generators, rather than from the shared one.
+     * Until the next reset, they hence give the same booking requests
+     * as when all the demand streams are loaded and generated as a
+     * single shard (see shardDemand()), whatever the way they are
+     * generated (through the event queue, or demand stream by demand
+     * stream). The total
+     * numbers of requests drawn at the subsequent resets, and the
+     * seeds given by reseed() and generateScenarios(), only depend on
+     * the loaded demand streams.
+     *
+     * When the filter samples the selected demand streams (see
+     * DemandFilterStruct::_samplingRate), say 5% of every stratum, only
+     * the sampled demand streams are loaded, and the expected total
+     * number of booking requests of the progress status is that of the
+     * sampled demand streams. Every booking request then stands for
+     * the demand streams of its stratum left out of the sample (see
+     * getSamplingWeight()). The demands can then not be reloaded.
+     *
+     * @param const DemandFilterStruct& Selection of the demand streams.
+     */
+    void setDemandFilter (const DemandFilterStruct&);
+
+    /**
+     * State whether the cabins of a given origin, destination and
+     * preferred departure date are to share, from then on, a single
+     * demand stream, i.e., a single arrival process, when loaded by
+     * parseAndLoad() or loadCompiledModel() (see
+     * DemandManager::createMultiCabinDemandCharacteristics()). Every
+     * booking request is then given a cabin, drawn in proportion to the
+     * mean demands of the cabins, before the other characteristics of
+     * that cabin. Only the cabins sharing the same arrival pattern are
+     * gathered.
+     *
+     * That divides the number of demand streams, and the size of the
+     * event queue, by up to the number of cabins. The booking requests
+     * follow the same distributions as with separate demand streams,
+     * but they are not the same. The demand streams can then not be
+     * sampled, nor the demands reloaded or scheduled.
+     *
+     * @param const bool Whether the cabins share their demand streams.
+     */
+    void setMultiCabinDemand (const bool);
     
     /**
      * Parse the demand input file.
      *
      * The CSV file, describing the parameters of the demand to be generated
      * for the simulator, is parsed and instantiated in memory accordingly.
+     * That file may be compressed (with gzip or zstd), in which case it
+     * is decompressed on the fly.
      *
      * @param const DemandFilePath& Filename of the input demand file.
      */
     void parseAndLoad (const DemandFilePath&);
 
+    /**
+     * Parse the given demand input files, and load them concurrently.
+     *
+     * The demand streams are exactly the ones parseAndLoad() would
+     * instantiate, when called on each of those files in turn (the
+     * random generation is thus the same), whatever the number of
+     * threads.
+     *
+     * @param const DemandFilePathList_T& Filenames of the input demand
+     *        files.
+     * @param const unsigned int Number of threads (zero meaning as many
+     *        as the machine can run concurrently).
+     */
+    void parseAndLoad (const DemandFilePathList_T&,
+                       const unsigned int iNbOfThreads = 0);
+
+    /**
+     * Parse the demand input file, and compile it into a (binary)
+     * demand model file.
+     *
+     * No demand stream is created: the compiled demand model is meant
+     * to be loaded later on, by loadCompiledModel(), much faster than
+     * the demand input file can be parsed.
+     *
+     * @param const DemandFilePath& Filename of the input demand file.
+     * @param const stdair::Filename_T& Filename of the compiled demand
+     *        model to be written.
+     */
+    void compileDemand (const DemandFilePath&, const stdair::Filename_T&);
+
+    /**
+     * Load a compiled demand model, as written by compileDemand().
+     *
+     * The compiled demand model file is mapped in memory, and the
+     * demand streams are instantiated accordingly, exactly as
+     * parseAndLoad() does with the corresponding demand input file
+     * (the random generation is thus the same). The distributions of
+     * the demand streams are copied straight from the compiled
+     * distribution tables of the file: the probability distributions of
+     * the demands are not rebuilt (except by reloadDemand() and
+     * adjustDemand(), and when the cabins share their demand streams).
+     *
+     * @param const stdair::Filename_T& Filename of the compiled demand
+     *        model.
+     */
+    void loadCompiledModel (const stdair::Filename_T&);
+
+    /**
+     * Parse the demand input file again (e.g., once it has been
+     * edited), and replace the demands loaded so far by its demands.
+     *
+     * Only the demand streams of the demands which have changed are
+     * rebuilt. The demands are identified by their origin, destination,
+     * preferred cabin, date range and active days of the week:
+     * <ul>
+     *   <li>the demand streams of the unchanged demands are kept as
+     *       they are (seeds and random generators included), so that
+     *       they generate the very same requests;</li>
+     *   <li>the demand streams of the changed demands are updated in
+     *       place, keeping their random generators;</li>
+     *   <li>the demand streams of the new demands are created as
+     *       parseAndLoad() does, but their seeds are drawn from the
+     *       shared generator as it stands when reloading, rather than
+     *       at the position it had when the demands were first
+     *       loaded;</li>
+     *   <li>the demand streams of the removed demands do not generate
+     *       any request anymore, whatever the generation method (their
+     *       mean number of requests being zero).</li>
+     * </ul>
+     * The expected total number of booking requests is adjusted
+     * accordingly. The changes take effect from the next call to
+     * reset(), which draws again the number of requests to be generated
+     * by every demand stream.
+     *
+     * Hence, the booking requests of the new demands (and the seeds
+     * drawn afterwards, e.g., by reseed()) depend on the history of the
+     * reloads: a reloaded demand model does not give the same booking
+     * requests as a fresh parseAndLoad() of the same file, once a
+     * demand which has never been loaded before has been added.
+     *
+     * @param const DemandFilePath& Filename of the input demand file.
+     * @throw DemandReloadException when several demands of the file
+     *        give the same demand stream (the demands loaded so far
+     *        are then left untouched), or when the cabins share their
+     *        demand streams (see setMultiCabinDemand()).
+     */
+    void reloadDemand (const DemandFilePath&);
+
+    /**
+     * Same as above, for a list of demand input files, parsed
+     * concurrently (see parseAndLoad()).
+     *
+     * @param const DemandFilePathList_T& Filenames of the input demand
+     *        files.
+     * @param const unsigned int Number of threads (zero meaning as many
+     *        as the machine can run concurrently).
+     */
+    void reloadDemand (const DemandFilePathList_T&,
+                       const unsigned int iNbOfThreads = 0);
+
+    /**
+     * Parse the demand input file, and schedule its demand streams for
+     * a rolling-horizon demand generation.
+     *
+     * Rather than being all created upfront (as parseAndLoad() does),
+     * the demand streams are created when the simulation clock (i.e.,
+     * the date-time of the popped events) reaches the earliest date-time
+     * at which they may give a booking request, and retired as soon as
+     * they have given all of theirs. The memory taken by the demand
+     * streams thus follows the open booking window, rather than the
+     * whole simulation horizon.
+     *
+     * The first run gives the same booking requests (same demand
+     * streams, same request date-times) as parseAndLoad() does, but for
+     * the willingness-to-pay (drawn with the shared generator, in
+     * another order).
+     *
+     * \note The demand adjustments, the scenarios, the snapshots and
+     *       the reloading of the demand input files are not supported
+     *       by the rolling-horizon demand generation.
+     *
+     * @param const DemandFilePath& Filename of the input demand file.
+     * @throw TrademgenGenerationException when the cabins share their
+     *        demand streams (see setMultiCabinDemand()).
+     */
+    void parseAndSchedule (const DemandFilePath&);
+
     /**
      * Destructor.
      */
@@ -331,6 +522,21 @@ namespace TRADEMGEN {
     generateNextRequest (const stdair::DemandStreamKeyStr_T&,
                          const stdair::DemandGenerationMethod&) const;
 
+    /**
+     * Get the sampling weight of the given booking request, i.e., the
+     * number of demand streams the demand stream which has generated it
+     * stands for, when the demand streams are sampled (see
+     * setDemandFilter()). Summing up the weights of the booking requests
+     * gives an (unbiased) estimate of the number of booking requests
+     * generated without sampling.
+     *
+     * @param const stdair::BookingRequestStruct& The booking request.
+     * @return stdair::RealNumber_T The sampling weight (one when the
+     *   demand streams are not sampled).
+     */
+    stdair::RealNumber_T
+    getSamplingWeight (const stdair::BookingRequestStruct&) const;
+
     /**
      * States whether a demand stream with the given key is used to
      * generate demand.
@@ -340,6 +546,12 @@ namespace TRADEMGEN {
      */
     bool hasDemandStream (const stdair::DemandStreamKeyStr_T&) const;
 
+    /**
+     * Get the number of demand streams currently open, for the
+     * rolling-horizon demand generation (see parseAndSchedule()).
+     */
+    stdair::Count_T getNbOfOpenDemandStreams() const;
+
     /**
      * Pop the next coming (in time) event, and remove it from the
      * event queue thanks to the SEvMgr service.
@@ -358,6 +570,161 @@ namespace TRADEMGEN {
      */
     stdair::ProgressStatusSet popEvent (stdair::EventStruct&) const;
 
+    /**
+     * Generate, in one go, the booking requests dated before the given
+     * date-time (e.g., the end of the simulated day), and hand them over
+     * to the given sink, in the order of their date-times.
+     *
+     * That replaces the popEvent()/generateNextRequest() loop over the
+     * time window: every demand stream is left with its next booking
+     * request lying in the event queue, so that the next call goes on
+     * from there. The first booking requests must have been generated
+     * beforehand (see generateFirstRequests()).
+     *
+     * \note The other events of the time window (e.g., cancellations)
+     *       are discarded. As the event queue orders the events at the
+     *       microsecond, a booking request dated exactly at the given
+     *       date-time may be handed over by either call.
+     *
+     * @param const stdair::DateTime_T& End (excluded) of the time window.
+     * @param RequestSink& Sink receiving the booking requests.
+     * @param const stdair::DemandGenerationMethod& Method of generation
+     *        of the date-time of the requests.
+     * @return stdair::Count_T Number of generated booking requests.
+     */
+    stdair::Count_T generateUntil (const stdair::DateTime_T&, RequestSink&,
+                                   const stdair::DemandGenerationMethod&) const;
+
+    /**
+     * Generate all the booking requests of a single run on a background
+     * thread, which pushes them into the given pipeline, so that the
+     * caller pops them (see RequestPipeline::pop() and
+     * RequestPipeline::tryPop()) while the next ones are being
+     * generated. The demand generation is reset at the end of the run,
+     * as generateScenarios() does.
+     *
+     * \note The service must not be used until the pipeline is done
+     *       (or stopped, in which case the service is to be reset). The
+     *       rolling-horizon demand generation (see parseAndSchedule()) is
+     *       not supported.
+     *
+     * @param RequestPipeline& Pipeline receiving the booking requests.
+     * @param const stdair::DemandGenerationMethod& Method of generation
+     *        of the date-time of the requests.
+     * @throw RequestPipelineException when the generation cannot be
+     *        started.
+     */
+    void startRequestPipeline (RequestPipeline&,
+                               const stdair::DemandGenerationMethod&) const;
+
+    /**
+     * Generate all the booking requests of a single run, demand stream
+     * by demand stream, without going through the event queue, and hand
+     * them over to the given sink. The booking requests of every demand
+     * stream come in a row, in the order of their date-times, but they
+     * are not globally ordered by date-time. The demand streams are
+     * generated concurrently, and the demand generation is reset at the
+     * end of the run, as generateScenarios() does.
+     *
+     * The WTP is drawn from the random generator of every demand stream
+     * (as when the demand generation is sharded, see shardDemand()), so
+     * that the booking requests are the same whatever the number of
+     * threads. When the demand is sharded (be it into a single shard),
+     * they are the very booking requests given by the event queue (see
+     * generateFirstRequests() and generateUntil()), in another order.
+     *
+     * \note The generated booking requests are not logged. The
+     *       rolling-horizon demand generation (see parseAndSchedule())
+     *       is not supported.
+     *
+     * @param RequestSink& Sink receiving the booking requests.
+     * @param const stdair::DemandGenerationMethod& Method of generation
+     *        of the date-time of the requests.
+     * @param const unsigned int Number of threads (zero meaning as many
+     *        as the machine can run concurrently).
+     * @return stdair::Count_T Number of generated booking requests.
+     * @throw TrademgenGenerationException when the rolling-horizon
+     *        demand generation is used.
+     */
+    stdair::Count_T
+    generateRunByStream (RequestSink&, const stdair::DemandGenerationMethod&,
+                         const unsigned int iNbOfThreads = 0) const;
+
+    /**
+     * Generate all the booking requests of a single run, demand stream
+     * by demand stream, as generateRunByStream() does, but aggregated
+     * into weighted booking requests: within every demand stream, the
+     * booking requests lying within the same period before the
+     * preferred departure date (e.g., within the same day, with a
+     * 24-hour period), and sharing the same preferred cabin (when the
+     * cabins share their demand streams), POS, channel, trip type,
+     * stay duration, frequent flyer type, change fees and non
+     * refundable option, are merged into a single booking request.
+     *
+     * The party size of the merged booking request is the number of
+     * passengers it stands for, its WTP and value of time are the means
+     * of theirs, and its date-time and preferred departure time are
+     * those of the first of them. Hence, the total number of passengers
+     * is exactly that of generateRunByStream(), from the same draws,
+     * while the number of booking requests may drop by an order of
+     * magnitude on the high-demand markets.
+     *
+     * @param RequestSink& Sink receiving the booking requests.
+     * @param const stdair::DemandGenerationMethod& Method of generation
+     *        of the date-time of the requests.
+     * @param const stdair::Duration_T& Aggregation period (zero for the
+     *        booking requests not to be aggregated).
+     * @param const unsigned int Number of threads (zero meaning as many
+     *        as the machine can run concurrently).
+     * @return stdair::Count_T Number of (merged) booking requests handed
+     *         over to the sink.
+     * @throw TrademgenGenerationException when the rolling-horizon
+     *        demand generation is used.
+     */
+    stdair::Count_T
+    generateAggregatedRunByStream (RequestSink&,
+                                   const stdair::DemandGenerationMethod&,
+                                   const stdair::Duration_T& iAggregationPeriod,
+                                   const unsigned int iNbOfThreads = 0) const;
+
+    /**
+     * Draw, for a single run, the numbers of booking requests (arrivals)
+     * of every demand stream within every Days-To-Departure (DTD) bucket
+     * of the given table, and optionally within every channel, without
+     * generating any booking request, e.g., for capacity planning.
+     *
+     * The counts are drawn directly from the arrival patterns: with the
+     * order statistics method, the total number of requests of every
+     * demand stream is split among the DTD buckets (multinomial
+     * distribution); with the Poisson process, the count of every DTD
+     * bucket is drawn on its own (Poisson distribution), the arrivals
+     * within the last day before the departure being left out, as the
+     * Poisson process does not generate them. They follow the
+     * distribution of the arrivals of generateRunByStream() for the
+     * same run, but they are not the counts of those very booking
+     * requests. Moreover, they include the arrivals which would come
+     * after the preferred departure date-time of their booking
+     * requests, and which are dropped when the booking requests are
+     * generated: the counts are thus slightly above the numbers of
+     * generated booking requests, mostly within the last DTD bucket.
+     * The demand streams are
+     * drawn concurrently, and the demand generation is reset at the end
+     * of the run, as generateScenarios() does.
+     *
+     * @param ArrivalCountTable& Table receiving the counts (replaced).
+     * @param const stdair::DemandGenerationMethod& Method of generation
+     *        of the date-time of the requests.
+     * @param const unsigned int Number of threads (zero meaning as many
+     *        as the machine can run concurrently).
+     * @return stdair::Count_T Total number of arrivals.
+     * @throw TrademgenGenerationException when the rolling-horizon
+     *        demand generation is used.
+     */
+    stdair::Count_T
+    generateArrivalCounts (ArrivalCountTable&,
+                           const stdair::DemandGenerationMethod&,
+                           const unsigned int iNbOfThreads = 0) const;
+
     /**
      * States whether the event queue has reached the end.
      *
@@ -376,12 +743,228 @@ namespace TRADEMGEN {
                                const stdair::DateTime_T&,
                                const stdair::Date_T&) const;
 
+    /**
+     * Adjust the demand distribution (mean and standard deviation of
+     * the number of requests) of the demand streams selected by the
+     * given adjustment (e.g., "+10% on SIN-BKK", "-20% in February"),
+     * without having to reparse the demand input file.
+     *
+     * The loaded demand streams are adjusted in place, and the expected
+     * total number of requests accordingly. The adjustments add up:
+     * each one applies to the demand distributions as left by the
+     * previous ones. They take effect from the next call to reset(),
+     * which draws again the number of requests to be generated by
+     * every demand stream. A demand stream the mean number of requests
+     * of which drops to zero generates no request, whatever the
+     * generation method.
+     *
+     * When the cabins share their demand streams (see
+     * setMultiCabinDemand()), the demand streams cannot be selected by
+     * cabin, as the demand distribution of a shared demand stream
+     * cannot be split among its cabins.
+     *
+     * @param const DemandAdjustmentStruct& Selection of the demand
+     *        streams, and adjustment of their demand distribution.
+     * @return stdair::Count_T Number of adjusted demand streams.
+     * @throw TrademgenGenerationException when the adjustment selects a
+     *        cabin while the cabins share their demand streams.
+     */
+    stdair::Count_T adjustDemand (const DemandAdjustmentStruct&) const;
+
+    /**
+     * Generate several scenarios (e.g., baseline, +10% demand, -10%
+     * demand) out of the demand streams loaded so far, without having
+     * to reparse the demand input file.
+     *
+     * The scenarios are generated one after the other. For each one,
+     * the demand distributions of the demand input file get the
+     * adjustments of the scenario, the random generators are seeded
+     * from the seed of the scenario, and the given number of runs are
+     * generated, every booking request being handed over to the sink
+     * of the scenario. Hence, a scenario always yields the same booking
+     * requests, whatever the other scenarios of the list.
+     *
+     * Eventually, the demand distributions of the demand input file
+     * are restored, and the demand generation is reset.
+     *
+     * @param const DemandScenarioList_T& Scenarios to be generated.
+     * @param const unsigned int Number of runs per scenario.
+     * @param const stdair::DemandGenerationMethod& Method of generation
+     *        of the date-time of the requests.
+     * @return stdair::Count_T Number of generated booking requests, for
+     *         all the runs of all the scenarios.
+     * @throw TrademgenGenerationException when an adjustment selects a
+     *        cabin while the cabins share their demand streams (see
+     *        adjustDemand()).
+     */
+    stdair::Count_T
+    generateScenarios (const DemandScenarioList_T&,
+                       const unsigned int iNbOfRuns,
+                       const stdair::DemandGenerationMethod&) const;
+
     /**
      * Reset the context of the demand streams for another demand generation
      * without having to reparse the demand input file.
+     *
+     * When total numbers of requests have been drawn in advance (see
+     * drawTotalNumberOfRequests()), the next row of those is used;
+     * otherwise, the total number of requests of every demand stream
+     * is drawn again. Every demand stream is reset, whether or not it
+     * has been used by the last run, as its total number of requests
+     * changes; drawing the totals in advance makes that a mere read.
      */
     void reset() const;  
 
+    /**
+     * Seed again the random generators of the demand streams, from the
+     * given seed (as generateScenarios() does for every scenario), and
+     * reset the demand generation (see reset()). The subsequent runs
+     * then only depend on that seed, whatever has been generated before.
+     *
+     * The total numbers of requests drawn in advance, if any, are
+     * forgotten.
+     *
+     * @param const stdair::RandomSeed_T& Seed of the random generation.
+     * @throw TrademgenGenerationException for the rolling-horizon demand
+     *        generation.
+     */
+    void reseed (const stdair::RandomSeed_T&) const;
+
+    /**
+     * Restrict the demand generation to the given shard, so that
+     * several processes may generate the demand concurrently, each one
+     * its own shard, and the resulting request shard files be merged
+     * afterwards (see RequestShardWriter and RequestShardMerger).
+     *
+     * The demand streams are split among the shards by a hash of their
+     * key (see RequestShard::getShardIndex()). Every process still
+     * loads, seeds and draws the total numbers of requests of all the
+     * demand streams, so that a demand stream generates the same
+     * booking requests whatever the number of shards. To that end, when
+     * the generation is sharded, the WTP is drawn from the random
+     * generator of every demand stream, rather than from the shared
+     * one. The merge of the shards is thus the same as the generation
+     * with a single shard (but not as the generation without any shard).
+     *
+     * To be called once the demand has been loaded; the shard is kept
+     * when the demand input files are reloaded (see reloadDemand()).
+     *
+     * @param const unsigned short Index of the shard (from 0).
+     * @param const unsigned short Number of shards, 0 meaning that the
+     *        generation is no longer sharded.
+     * @return stdair::Count_T Number of demand streams within the shard.
+     * @throw TrademgenGenerationException when the index of the shard is
+     *        out of range, or for the rolling-horizon demand generation.
+     */
+    stdair::Count_T shardDemand (const unsigned short iShardIndex,
+                                 const unsigned short iNbOfShards) const;
+
+    /**
+     * Project the booking requests onto the given fields (e.g., only the
+     * WTP, for a revenue study), the other fields being left to neutral
+     * values (see RequestFieldMask), so that their characteristics are
+     * not drawn at all.
+     *
+     * Every characteristic is then drawn from its own sub-stream of the
+     * random generator of the demand stream, depending only on the run
+     * (counted from the last seeding, each reset() starting another one)
+     * and on the rank of the booking request within the demand stream
+     * (the WTP included, rather than from the shared generator). The
+     * drawn fields are thus the same whatever the mask, while differing
+     * from one run to the next, and the booking requests come at the
+     * same date-times (but the fields are not the same values as when
+     * the booking requests are not projected).
+     *
+     * To be called once the demand has been loaded; the mask is kept
+     * when the demand input files are reloaded (see reloadDemand()).
+     *
+     * \note As the sub-streams are derived from the current seeds of the
+     *       demand streams, restoring a snapshot taken before a call to
+     *       reseed() does not restore the projected fields.
+     *
+     * @param const RequestFieldMask& Fields to be drawn.
+     * @throw TrademgenGenerationException for the rolling-horizon demand
+     *        generation.
+     */
+    void setRequestFieldMask (const RequestFieldMask&) const;
+
+    /**
+     * Draw all the fields of the booking requests again, as usual (see
+     * setRequestFieldMask()).
+     */
+    void unsetRequestFieldMask() const;
+
+    /**
+     * Draw, in a single pass, the total numbers of requests of every
+     * demand stream for the given number of subsequent calls to
+     * reset(), so that those do not need to draw them one at a time.
+     *
+     * \note The totals follow the same distributions, but are not the
+     *       same values as when drawn by reset(). They are forgotten
+     *       when the demand distributions change (e.g., adjustDemand(),
+     *       reloadDemand()) or when demand streams are added.
+     *
+     * @param const unsigned int Number of subsequent runs (i.e., resets).
+     */
+    void drawTotalNumberOfRequests (const unsigned int iNbOfRuns) const;
+
+    /**
+     * Take a snapshot of the generation state of the demand streams
+     * (e.g., right after the demand input file has been loaded), which
+     * restoreSnapshot() goes back to.
+     */
+    void takeSnapshot() const;
+
+    /**
+     * Go back to the generation state saved by the last call to
+     * takeSnapshot(), so that the next demand generation gives the very
+     * same booking requests as the first one following the snapshot.
+     *
+     * Contrary to reset(), which gives another (independent) run, the
+     * run following the snapshot is replayed; it is not a cheaper
+     * reset(). Only the demand streams which have changed since the
+     * snapshot are copied back, i.e., all the demand streams having
+     * requests to generate, once the first requests have been
+     * generated (see DemandStreamSnapshot).
+     *
+     * \note The snapshot is forgotten when the demand input files are
+     *       reloaded (see reloadDemand()).
+     *
+     * @return stdair::Count_T Number of restored demand streams.
+     */
+    stdair::Count_T restoreSnapshot() const;
+
+    /**
+     * Save the current generation state, i.e., that of the demand
+     * streams, of the shared generator and of the booking requests
+     * lying in the event queue, into the given (binary) checkpoint
+     * file, so that the demand generation can be resumed later on,
+     * possibly by another process (see restore()).
+     *
+     * \note Only the booking requests are saved, not the other events
+     *       (e.g., cancellations) of the event queue.
+     *
+     * @param const stdair::Filename_T& Name of the checkpoint file.
+     */
+    void checkpoint (const stdair::Filename_T&) const;
+
+    /**
+     * Restore the generation state saved into the given checkpoint file
+     * (see checkpoint()), so that popping the events resumes where the
+     * demand generation was at the time of the checkpoint. The same
+     * demand input files must have been loaded beforehand.
+     *
+     * \note The file is checked before anything is altered: when it is
+     *       not valid, the generation state is left as is. Only the
+     *       expected number of booking requests is restored within the
+     *       progress status, not the number of those already popped.
+     *
+     * @param const stdair::Filename_T& Name of the checkpoint file.
+     * @throw DemandSnapshotException when the file cannot be read, is
+     *        corrupted, or corresponds to other demand input files.
+     */
+    void restore (const stdair::Filename_T&) const;
+
     /**
      * Get the overall progress status (for the whole event queue).
      */
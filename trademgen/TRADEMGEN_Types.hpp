@@ -4,6 +4,8 @@
 // //////////////////////////////////////////////////////////////////////
 // Import section
 // //////////////////////////////////////////////////////////////////////
+// STL
+#include <list>
 // Boost
 #include <boost/shared_ptr.hpp>
 // StdAir
@@ -35,6 +37,11 @@ namespace TRADEMGEN {
     explicit DemandFilePath (const stdair::Filename_T& iFilename)
       : stdair::InputFilePath (iFilename) {}
   };
+
+  /**
+   * List of demand input files.
+   */
+  typedef std::list<DemandFilePath> DemandFilePathList_T;
   
 }
 #endif // __TRADEMGEN_TRADEMGEN_TYPES_HPP
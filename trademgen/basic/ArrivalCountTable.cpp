@@ -0,0 +1,147 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <algorithm>
+#include <cassert>
+#include <ostream>
+#include <sstream>
+// TraDemGen
+#include <trademgen/TRADEMGEN_Exceptions.hpp>
+#include <trademgen/basic/ArrivalCountTable.hpp>
+
+namespace TRADEMGEN {
+
+  // //////////////////////////////////////////////////////////////////////
+  ArrivalCountTable::ArrivalCountTable() : _isByChannel (false) {
+    assert (false);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  ArrivalCountTable::ArrivalCountTable (const DTDList_T& iDTDBoundaryList,
+                                        const bool iIsByChannel)
+    : _dtdBoundaryList (iDTDBoundaryList), _isByChannel (iIsByChannel) {
+    for (std::size_t idx = 0; idx != _dtdBoundaryList.size(); ++idx) {
+      if (_dtdBoundaryList[idx] < 0
+          || (idx != 0 && _dtdBoundaryList[idx] >= _dtdBoundaryList[idx-1])) {
+        std::ostringstream oMessage;
+        oMessage << "The bounds of the DTD buckets must be strictly "
+                 << "decreasing numbers of days before the departure: "
+                 << describe();
+        throw TrademgenGenerationException (oMessage.str());
+      }
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  ArrivalCountTable::ArrivalCountTable (const ArrivalCountTable& iTable)
+    : _dtdBoundaryList (iTable._dtdBoundaryList),
+      _isByChannel (iTable._isByChannel),
+      _demandStreamKeyList (iTable._demandStreamKeyList),
+      _channelList (iTable._channelList), _countList (iTable._countList) {
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  ArrivalCountTable::~ArrivalCountTable() {
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  stdair::Count_T ArrivalCountTable::getTotalCount() const {
+    stdair::Count_T oTotalCount = 0;
+    for (std::vector<stdair::Count_T>::const_iterator itCount =
+           _countList.begin(); itCount != _countList.end(); ++itCount) {
+      oTotalCount += *itCount;
+    }
+    return oTotalCount;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  std::vector<stdair::FloatDuration_T>
+  ArrivalCountTable::getBucketBoundaryList() const {
+    std::vector<stdair::FloatDuration_T> oBoundaryList;
+    oBoundaryList.reserve (_dtdBoundaryList.size());
+    for (DTDList_T::const_iterator itDTD = _dtdBoundaryList.begin();
+         itDTD != _dtdBoundaryList.end(); ++itDTD) {
+      oBoundaryList.push_back (-static_cast<stdair::FloatDuration_T> (*itDTD));
+    }
+    return oBoundaryList;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void ArrivalCountTable::
+  init (const std::vector<std::string>& iDemandStreamKeyList,
+        const std::vector<stdair::ChannelLabel_T>& iChannelList) {
+    assert (_isByChannel == true || iChannelList.empty() == true);
+    _demandStreamKeyList = iDemandStreamKeyList;
+    _channelList = iChannelList;
+    _countList.assign (_demandStreamKeyList.size() * getNbOfChannels()
+                       * getNbOfBuckets(), 0);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void ArrivalCountTable::
+  setCounts (const std::size_t iDemandStreamIdx,
+             const std::vector<stdair::Count_T>& iCountList) {
+    const std::size_t lNbOfCounts = getNbOfChannels() * getNbOfBuckets();
+    assert (iDemandStreamIdx < _demandStreamKeyList.size());
+    assert (iCountList.size() == lNbOfCounts);
+    std::copy (iCountList.begin(), iCountList.end(),
+               _countList.begin() + iDemandStreamIdx * lNbOfCounts);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void ArrivalCountTable::writeHeader (std::ostream& ioOut) const {
+    ioOut << "run,demand_stream,channel";
+    if (_dtdBoundaryList.empty() == true) {
+      ioOut << ",dtd_all" << std::endl;
+      return;
+    }
+
+    ioOut << ",dtd_gt_" << _dtdBoundaryList.front();
+    for (std::size_t idx = 1; idx < _dtdBoundaryList.size(); ++idx) {
+      ioOut << ",dtd_" << _dtdBoundaryList[idx-1] << "_"
+            << _dtdBoundaryList[idx];
+    }
+    ioOut << ",dtd_lt_" << _dtdBoundaryList.back() << std::endl;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void ArrivalCountTable::write (std::ostream& ioOut,
+                                 const unsigned int iRunNumber) const {
+    const std::size_t lNbOfChannels = getNbOfChannels();
+    const std::size_t lNbOfBuckets = getNbOfBuckets();
+    std::vector<stdair::Count_T>::const_iterator itCount = _countList.begin();
+    for (std::size_t lStreamIdx = 0;
+         lStreamIdx != _demandStreamKeyList.size(); ++lStreamIdx) {
+      for (std::size_t lChannelIdx = 0; lChannelIdx != lNbOfChannels;
+           ++lChannelIdx) {
+        ioOut << iRunNumber << "," << _demandStreamKeyList[lStreamIdx] << ","
+              << ((_channelList.empty() == true) ? "*"
+                  : _channelList[lChannelIdx]);
+        for (std::size_t lBucketIdx = 0; lBucketIdx != lNbOfBuckets;
+             ++lBucketIdx, ++itCount) {
+          ioOut << "," << *itCount;
+        }
+        ioOut << "\n";
+      }
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  const std::string ArrivalCountTable::describe() const {
+    std::ostringstream oStr;
+    oStr << "DTD buckets [";
+    for (std::size_t idx = 0; idx != _dtdBoundaryList.size(); ++idx) {
+      if (idx != 0) {
+        oStr << ", ";
+      }
+      oStr << _dtdBoundaryList[idx];
+    }
+    oStr << "], " << _demandStreamKeyList.size() << " demand stream(s)";
+    if (_isByChannel == true) {
+      oStr << ", " << _channelList.size() << " channel(s)";
+    }
+    return oStr.str();
+  }
+
+}
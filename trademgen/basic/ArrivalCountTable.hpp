@@ -0,0 +1,178 @@
+#ifndef __TRADEMGEN_BAS_ARRIVALCOUNTTABLE_HPP
+#define __TRADEMGEN_BAS_ARRIVALCOUNTTABLE_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <iosfwd>
+#include <string>
+#include <vector>
+// StdAir
+#include <stdair/stdair_basic_types.hpp>
+#include <stdair/stdair_date_time_types.hpp>
+#include <stdair/basic/StructAbstract.hpp>
+
+namespace TRADEMGEN {
+
+  /**
+   * @brief Table of the numbers of booking requests (arrivals) of every
+   * demand stream within every Days-To-Departure (DTD) bucket, and
+   * optionally within every channel, for capacity planning (see
+   * TRADEMGEN_Service::generateArrivalCounts()).
+   *
+   * The DTD buckets are delimited by decreasing numbers of days before
+   * the departure, e.g., {90, 30, 7} for four buckets: more than 90 days
+   * before the departure, from 90 to 30 days, from 30 to 7 days, and
+   * less than 7 days. The counts are stored as a dense tensor (demand
+   * streams x channels x DTD buckets), without any booking request.
+   */
+  struct ArrivalCountTable : public stdair::StructAbstract {
+  public:
+    // ////////// Type definitions ////////////
+    /** List of numbers of days before the departure. */
+    typedef std::vector<stdair::DayDuration_T> DTDList_T;
+
+
+  public:
+    // ////////// Getters /////////
+    /** Get the bounds of the DTD buckets, in days before the departure. */
+    const DTDList_T& getDTDBoundaryList() const {
+      return _dtdBoundaryList;
+    }
+
+    /** Get the number of DTD buckets. */
+    std::size_t getNbOfBuckets() const {
+      return _dtdBoundaryList.size() + 1;
+    }
+
+    /** State whether the counts are split by channel. */
+    bool isByChannel() const {
+      return _isByChannel;
+    }
+
+    /** Get the keys of the demand streams, in the order of the table. */
+    const std::vector<std::string>& getDemandStreamKeyList() const {
+      return _demandStreamKeyList;
+    }
+
+    /**
+     * Get the channels, in the order of the table (empty when the
+     * counts are not split by channel).
+     */
+    const std::vector<stdair::ChannelLabel_T>& getChannelList() const {
+      return _channelList;
+    }
+
+    /** Get the number of channels (one when the counts are not split). */
+    std::size_t getNbOfChannels() const {
+      return (_channelList.empty() == true) ? 1 : _channelList.size();
+    }
+
+    /**
+     * Get the number of arrivals of the given demand stream, channel
+     * (zero when the counts are not split by channel) and DTD bucket.
+     */
+    const stdair::Count_T& getCount (const std::size_t iDemandStreamIdx,
+                                     const std::size_t iChannelIdx,
+                                     const std::size_t iBucketIdx) const {
+      return _countList[(iDemandStreamIdx * getNbOfChannels() + iChannelIdx)
+                        * getNbOfBuckets() + iBucketIdx];
+    }
+
+    /** Get the total number of arrivals. */
+    stdair::Count_T getTotalCount() const;
+
+
+  public:
+    // /////////////// Business Methods //////////
+    /**
+     * Get the bounds of the DTD buckets as offsets (in days) from the
+     * departure, as within the arrival patterns, e.g., {-90, -30, -7}.
+     */
+    std::vector<stdair::FloatDuration_T> getBucketBoundaryList() const;
+
+    /**
+     * Set the demand streams and the channels of the table, all the
+     * counts being reset to zero.
+     *
+     * @param const std::vector<std::string>& Keys of the demand streams.
+     * @param const std::vector<stdair::ChannelLabel_T>& Channels (empty
+     *        when the counts are not split by channel).
+     */
+    void init (const std::vector<std::string>& iDemandStreamKeyList,
+               const std::vector<stdair::ChannelLabel_T>& iChannelList);
+
+    /**
+     * Set the counts of the given demand stream, channel by channel and,
+     * within every channel, DTD bucket by DTD bucket. The demand streams
+     * may be set concurrently, as they do not share any count.
+     */
+    void setCounts (const std::size_t iDemandStreamIdx,
+                    const std::vector<stdair::Count_T>& iCountList);
+
+    /**
+     * Write the header of the (CSV) count file, i.e., the run, demand
+     * stream and channel columns, then one column per DTD bucket.
+     */
+    void writeHeader (std::ostream&) const;
+
+    /**
+     * Write the counts of the given run into the (CSV) count file, one
+     * line per demand stream and channel.
+     */
+    void write (std::ostream&, const unsigned int iRunNumber) const;
+
+
+  public:
+    // ////////////// Display Support Methods //////////
+    /** Give a description of the structure (for display purposes). */
+    const std::string describe() const;
+
+
+  public:
+    // ////////// Constructors and destructors /////////
+    /**
+     * Constructor.
+     *
+     * @param const DTDList_T& Bounds of the DTD buckets, as strictly
+     *        decreasing (non-negative) numbers of days before the
+     *        departure.
+     * @param const bool Whether the counts are split by channel.
+     * @throw TrademgenGenerationException when the bounds are not
+     *        strictly decreasing, or are negative.
+     */
+    ArrivalCountTable (const DTDList_T&, const bool iIsByChannel);
+    /** Copy constructor. */
+    ArrivalCountTable (const ArrivalCountTable&);
+    /** Destructor. */
+    ~ArrivalCountTable();
+
+  private:
+    /** Default constructor (not to be used). */
+    ArrivalCountTable();
+
+
+  private:
+    // ////////// Attributes //////////
+    /** Bounds of the DTD buckets, in days before the departure. */
+    DTDList_T _dtdBoundaryList;
+
+    /** Whether the counts are split by channel. */
+    bool _isByChannel;
+
+    /** Keys of the demand streams. */
+    std::vector<std::string> _demandStreamKeyList;
+
+    /** Channels (empty when the counts are not split by channel). */
+    std::vector<stdair::ChannelLabel_T> _channelList;
+
+    /**
+     * Counts, demand stream by demand stream, channel by channel, and
+     * DTD bucket by DTD bucket.
+     */
+    std::vector<stdair::Count_T> _countList;
+  };
+
+}
+#endif // __TRADEMGEN_BAS_ARRIVALCOUNTTABLE_HPP
@@ -6,6 +6,13 @@
 // TraDemGen
 #include <trademgen/basic/BasConst_TRADEMGEN_Service.hpp>
 #include <trademgen/basic/BasConst_DemandGeneration.hpp>
+#include <trademgen/basic/BasConst_RequestOutput.hpp>
+#include <trademgen/basic/BasConst_CompiledDemandModel.hpp>
+#include <trademgen/basic/BasConst_DemandSnapshot.hpp>
+#include <trademgen/basic/BasConst_DemandLoading.hpp>
+#include <trademgen/basic/BasConst_SharedRequestRing.hpp>
+#include <trademgen/basic/BasConst_DemandGenerationServer.hpp>
+#include <trademgen/basic/BasConst_RequestShard.hpp>
 
 namespace TRADEMGEN {
 
@@ -85,4 +92,106 @@ namespace TRADEMGEN {
   DEFAULT_UNIFORM_GENERATOR (DEFAULT_BASE_GENERATOR,
                              DEFAULT_UNIFORM_REAL_DISTRIBUTION);
 
+  /** Default number of threads used to generate the demand stream by
+      demand stream (all the hardware threads). */
+  const unsigned int DEFAULT_NB_OF_GENERATION_THREADS = 0;
+
+  /** Number of demand streams generated before their booking requests
+      are handed over to the sink, when generating the demand stream by
+      demand stream. */
+  const std::size_t NB_OF_DEMAND_STREAMS_PER_GENERATION_WINDOW = 1024;
+
+  /** Default size (in bytes) of the blocks flushed by the request writers. */
+  const std::size_t DEFAULT_REQUEST_OUTPUT_BLOCK_SIZE = 4 * 1024 * 1024;
+
+  /** Default number of blocks used by the request writers. */
+  const unsigned short DEFAULT_REQUEST_OUTPUT_NB_OF_BLOCKS = 1;
+
+  /** Default number of blocks used by the asynchronous request writers. */
+  const unsigned short DEFAULT_ASYNC_REQUEST_OUTPUT_NB_OF_BLOCKS = 2;
+
+  /** Upper bound (in bytes) of the non-textual part of a CSV request row. */
+  const std::size_t MAX_CSV_REQUEST_ROW_FIXED_SIZE = 512;
+
+  /** Number of days covered by the cache of pre-formatted dates. */
+  const std::size_t MAX_CSV_DATE_CACHE_SIZE = 4096;
+
+  /** Default number of booking requests the background generation may
+      run ahead of the consumer. */
+  const std::size_t DEFAULT_REQUEST_PIPELINE_DEPTH = 4096;
+
+  /** Default number of threads used to load the demands (all the
+      hardware threads). */
+  const unsigned int DEFAULT_NB_OF_LOADING_THREADS = 0;
+
+  /** Minimal size (in bytes) of the parts of a demand input file which
+      are parsed concurrently. */
+  const std::size_t MIN_DEMAND_FILE_CHUNK_SIZE = 1024 * 1024;
+
+  /** Number of parts of a demand input file, per loading thread. */
+  const unsigned int NB_OF_DEMAND_FILE_CHUNKS_PER_THREAD = 4;
+
+  /** Number of demands, the demand streams of which are set up by a
+      loading thread at once. */
+  const std::size_t NB_OF_DEMANDS_PER_LOADING_TASK = 64;
+
+  /** Initial size (in bytes) of the buffer into which a compressed
+      demand input file is decompressed. */
+  const std::size_t DEMAND_FILE_BUFFER_SIZE = 1024 * 1024;
+
+  /** Magic string, starting every compiled demand model file. */
+  const char COMPILED_DEMAND_MODEL_MAGIC[COMPILED_DEMAND_MODEL_MAGIC_SIZE] =
+    { 'T', 'D', 'G', 'M', 'O', 'D', 'E', 'L' };
+
+  /** Version of the format of the compiled demand model files. */
+  const boost::uint32_t COMPILED_DEMAND_MODEL_VERSION = 2;
+
+  /** Marker of the byte order of the compiled demand model files. */
+  const boost::uint32_t COMPILED_DEMAND_MODEL_BYTE_ORDER_MARK = 0x01020304;
+
+  /** Magic string, starting every checkpoint file. */
+  const char DEMAND_SNAPSHOT_MAGIC[DEMAND_SNAPSHOT_MAGIC_SIZE] =
+    { 'T', 'D', 'G', 'C', 'K', 'P', 'N', 'T' };
+
+  /** Version of the format of the checkpoint files. */
+  const boost::uint32_t DEMAND_SNAPSHOT_VERSION = 2;
+
+  /** Marker of the byte order of the checkpoint files. */
+  const boost::uint32_t DEMAND_SNAPSHOT_BYTE_ORDER_MARK = 0x01020304;
+
+  /** Magic string, starting every shared request ring. */
+  const char SHARED_REQUEST_RING_MAGIC[SHARED_REQUEST_RING_MAGIC_SIZE] =
+    { 'T', 'D', 'G', 'R', 'I', 'N', 'G', '1' };
+
+  /** Version of the layout of the shared request rings. */
+  const boost::uint32_t SHARED_REQUEST_RING_VERSION = 1;
+
+  /** Marker of the byte order of the shared request rings. */
+  const boost::uint32_t SHARED_REQUEST_RING_BYTE_ORDER_MARK = 0x01020304;
+
+  /** Default number of records held by a shared request ring (8 MB). */
+  const std::size_t DEFAULT_SHARED_REQUEST_RING_CAPACITY = 64 * 1024;
+
+  /** Version of the protocol of the demand generation server. */
+  const boost::uint32_t DEMAND_GENERATION_PROTOCOL_VERSION = 1;
+
+  /** Default maximal number of request records within a frame (32 kB). */
+  const std::size_t DEFAULT_NB_OF_RECORDS_PER_FRAME = 256;
+
+  /** Maximal size (in bytes) of a command line, or of a frame. */
+  const std::size_t MAX_DEMAND_GENERATION_MESSAGE_SIZE = 16 * 1024 * 1024;
+
+  /** Magic string of the request shard files. */
+  const char REQUEST_SHARD_MAGIC[REQUEST_SHARD_MAGIC_SIZE] =
+    { 'T', 'D', 'G', 'S', 'H', 'R', 'D', '1' };
+
+  /** Version of the format of the request shard files. */
+  const boost::uint32_t REQUEST_SHARD_VERSION = 1;
+
+  /** Marker of the byte order of the request shard files. */
+  const boost::uint32_t REQUEST_SHARD_BYTE_ORDER_MARK = 0x01020304;
+
+  /** Number of records read at once from a request shard file (128 kB). */
+  const std::size_t REQUEST_SHARD_READ_BLOCK_SIZE = 1024;
+
 }
@@ -0,0 +1,32 @@
+#ifndef __TRADEMGEN_BAS_BASCONST_COMPILEDDEMANDMODEL_HPP
+#define __TRADEMGEN_BAS_BASCONST_COMPILEDDEMANDMODEL_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// Boost
+#include <boost/cstdint.hpp>
+
+namespace TRADEMGEN {
+
+  /** Size (in bytes) of the magic string of the compiled demand models. */
+  const unsigned short COMPILED_DEMAND_MODEL_MAGIC_SIZE = 8;
+
+  /** Magic string, starting every compiled demand model file. */
+  extern const char COMPILED_DEMAND_MODEL_MAGIC[COMPILED_DEMAND_MODEL_MAGIC_SIZE];
+
+  /**
+   * Version of the format of the compiled demand model files. It must be
+   * incremented whenever the layout of those files changes.
+   */
+  extern const boost::uint32_t COMPILED_DEMAND_MODEL_VERSION;
+
+  /**
+   * Marker of the byte order of the machine having compiled the demand
+   * model. As the files are mapped as is in memory, they can only be
+   * loaded on machines having the same byte order.
+   */
+  extern const boost::uint32_t COMPILED_DEMAND_MODEL_BYTE_ORDER_MARK;
+
+}
+#endif // __TRADEMGEN_BAS_BASCONST_COMPILEDDEMANDMODEL_HPP
@@ -5,6 +5,7 @@
 // Import section
 // //////////////////////////////////////////////////////////////////////
 // STL
+#include <cstddef>
 #include <string>
 // StdAir
 #include <stdair/stdair_maths_types.hpp>
@@ -47,5 +48,18 @@ namespace TRADEMGEN {
   /** Default random uniform real distribution. */
   extern const stdair::UniformDistribution_T DEFAULT_UNIFORM_REAL_DISTRIBUTION;
 
+  /**
+   * Default number of threads used to generate the demand stream by
+   * demand stream. Zero means as many threads as the machine can run
+   * concurrently.
+   */
+  extern const unsigned int DEFAULT_NB_OF_GENERATION_THREADS;
+
+  /** Number of demand streams generated (and the booking requests of
+      which are held in memory) before those booking requests are handed
+      over to the sink, when generating the demand stream by demand
+      stream. */
+  extern const std::size_t NB_OF_DEMAND_STREAMS_PER_GENERATION_WINDOW;
+
 }
 #endif // __TRADEMGEN_BAS_BASCONST_DEMANDGENERATION_HPP
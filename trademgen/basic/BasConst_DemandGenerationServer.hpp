@@ -0,0 +1,34 @@
+#ifndef __TRADEMGEN_BAS_BASCONST_DEMANDGENERATIONSERVER_HPP
+#define __TRADEMGEN_BAS_BASCONST_DEMANDGENERATIONSERVER_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cstddef>
+// Boost
+#include <boost/cstdint.hpp>
+
+namespace TRADEMGEN {
+
+  /**
+   * Version of the protocol of the demand generation server. It must be
+   * incremented whenever the frames (including the request records)
+   * change.
+   */
+  extern const boost::uint32_t DEMAND_GENERATION_PROTOCOL_VERSION;
+
+  /**
+   * Default maximal number of request records sent by the demand
+   * generation server within a single frame.
+   */
+  extern const std::size_t DEFAULT_NB_OF_RECORDS_PER_FRAME;
+
+  /**
+   * Maximal size (in bytes) of a command line, or of a frame, accepted
+   * by the demand generation server and client.
+   */
+  extern const std::size_t MAX_DEMAND_GENERATION_MESSAGE_SIZE;
+
+}
+#endif // __TRADEMGEN_BAS_BASCONST_DEMANDGENERATIONSERVER_HPP
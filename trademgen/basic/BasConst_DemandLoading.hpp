@@ -0,0 +1,34 @@
+#ifndef __TRADEMGEN_BAS_BASCONST_DEMANDLOADING_HPP
+#define __TRADEMGEN_BAS_BASCONST_DEMANDLOADING_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cstddef>
+
+namespace TRADEMGEN {
+
+  /**
+   * Default number of threads used to load the demands. Zero means as
+   * many threads as the machine can run concurrently.
+   */
+  extern const unsigned int DEFAULT_NB_OF_LOADING_THREADS;
+
+  /** Minimal size (in bytes) of the parts of a demand input file which
+      are parsed concurrently. */
+  extern const std::size_t MIN_DEMAND_FILE_CHUNK_SIZE;
+
+  /** Number of parts of a demand input file, per loading thread. */
+  extern const unsigned int NB_OF_DEMAND_FILE_CHUNKS_PER_THREAD;
+
+  /** Number of demands, the demand streams of which are set up by a
+      loading thread at once. */
+  extern const std::size_t NB_OF_DEMANDS_PER_LOADING_TASK;
+
+  /** Initial size (in bytes) of the buffer into which a compressed
+      demand input file is decompressed. */
+  extern const std::size_t DEMAND_FILE_BUFFER_SIZE;
+
+}
+#endif // __TRADEMGEN_BAS_BASCONST_DEMANDLOADING_HPP
@@ -0,0 +1,32 @@
+#ifndef __TRADEMGEN_BAS_BASCONST_DEMANDSNAPSHOT_HPP
+#define __TRADEMGEN_BAS_BASCONST_DEMANDSNAPSHOT_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// Boost
+#include <boost/cstdint.hpp>
+
+namespace TRADEMGEN {
+
+  /** Size (in bytes) of the magic string of the checkpoint files. */
+  const unsigned short DEMAND_SNAPSHOT_MAGIC_SIZE = 8;
+
+  /** Magic string, starting every checkpoint file. */
+  extern const char DEMAND_SNAPSHOT_MAGIC[DEMAND_SNAPSHOT_MAGIC_SIZE];
+
+  /**
+   * Version of the format of the checkpoint files. It must be
+   * incremented whenever the layout of those files changes.
+   */
+  extern const boost::uint32_t DEMAND_SNAPSHOT_VERSION;
+
+  /**
+   * Marker of the byte order of the machine having written the
+   * checkpoint file, which can only be read on machines having the same
+   * byte order.
+   */
+  extern const boost::uint32_t DEMAND_SNAPSHOT_BYTE_ORDER_MARK;
+
+}
+#endif // __TRADEMGEN_BAS_BASCONST_DEMANDSNAPSHOT_HPP
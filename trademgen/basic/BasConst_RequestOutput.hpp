@@ -0,0 +1,40 @@
+#ifndef __TRADEMGEN_BAS_BASCONST_REQUESTOUTPUT_HPP
+#define __TRADEMGEN_BAS_BASCONST_REQUESTOUTPUT_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cstddef>
+
+namespace TRADEMGEN {
+
+  /** Default size (in bytes) of the blocks flushed by the request writers. */
+  extern const std::size_t DEFAULT_REQUEST_OUTPUT_BLOCK_SIZE;
+
+  /**
+   * Default number of blocks used by the request writers. A single block
+   * means that the writing is synchronous.
+   */
+  extern const unsigned short DEFAULT_REQUEST_OUTPUT_NB_OF_BLOCKS;
+
+  /**
+   * Default number of blocks used by the request writers, when the
+   * writing is asynchronous (i.e., double-buffered).
+   */
+  extern const unsigned short DEFAULT_ASYNC_REQUEST_OUTPUT_NB_OF_BLOCKS;
+
+  /** Upper bound (in bytes) of the non-textual part of a CSV request row. */
+  extern const std::size_t MAX_CSV_REQUEST_ROW_FIXED_SIZE;
+
+  /** Number of days covered by the cache of pre-formatted dates. */
+  extern const std::size_t MAX_CSV_DATE_CACHE_SIZE;
+
+  /**
+   * Default number of booking requests the background generation may
+   * run ahead of the consumer (see RequestPipeline).
+   */
+  extern const std::size_t DEFAULT_REQUEST_PIPELINE_DEPTH;
+
+}
+#endif // __TRADEMGEN_BAS_BASCONST_REQUESTOUTPUT_HPP
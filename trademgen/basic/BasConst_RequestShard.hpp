@@ -0,0 +1,44 @@
+#ifndef __TRADEMGEN_BAS_BASCONST_REQUESTSHARD_HPP
+#define __TRADEMGEN_BAS_BASCONST_REQUESTSHARD_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cstddef>
+// Boost
+#include <boost/cstdint.hpp>
+
+namespace TRADEMGEN {
+
+  /** Size (in bytes) of the magic string of the request shard files. */
+  const unsigned short REQUEST_SHARD_MAGIC_SIZE = 8;
+
+  /**
+   * Magic string, starting (and ending, once the file is complete)
+   * every request shard file.
+   */
+  extern const char REQUEST_SHARD_MAGIC[REQUEST_SHARD_MAGIC_SIZE];
+
+  /**
+   * Version of the format of the request shard files. It must be
+   * incremented whenever the layout of those files (including the one
+   * of the records) changes.
+   */
+  extern const boost::uint32_t REQUEST_SHARD_VERSION;
+
+  /**
+   * Marker of the byte order of the machine having written the request
+   * shard file, which can only be read on machines having the same
+   * byte order.
+   */
+  extern const boost::uint32_t REQUEST_SHARD_BYTE_ORDER_MARK;
+
+  /**
+   * Number of records read at once from every request shard file, when
+   * merging them.
+   */
+  extern const std::size_t REQUEST_SHARD_READ_BLOCK_SIZE;
+
+}
+#endif // __TRADEMGEN_BAS_BASCONST_REQUESTSHARD_HPP
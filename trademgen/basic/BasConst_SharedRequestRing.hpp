@@ -0,0 +1,47 @@
+#ifndef __TRADEMGEN_BAS_BASCONST_SHAREDREQUESTRING_HPP
+#define __TRADEMGEN_BAS_BASCONST_SHAREDREQUESTRING_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cstddef>
+// Boost
+#include <boost/cstdint.hpp>
+
+namespace TRADEMGEN {
+
+  /** Size (in bytes) of the magic string of the shared request rings. */
+  const unsigned short SHARED_REQUEST_RING_MAGIC_SIZE = 8;
+
+  /** Magic string, starting every shared request ring. */
+  extern const char SHARED_REQUEST_RING_MAGIC[SHARED_REQUEST_RING_MAGIC_SIZE];
+
+  /**
+   * Version of the layout of the shared request rings. It must be
+   * incremented whenever that layout (including the one of the records)
+   * changes.
+   */
+  extern const boost::uint32_t SHARED_REQUEST_RING_VERSION;
+
+  /**
+   * Marker of the byte order of the machine having created the shared
+   * request ring.
+   */
+  extern const boost::uint32_t SHARED_REQUEST_RING_BYTE_ORDER_MARK;
+
+  /** Maximal number of readers attached at once to a shared request ring. */
+  const unsigned short MAX_NB_OF_SHARED_REQUEST_RING_READERS = 16;
+
+  /**
+   * Size (in bytes) of the codes (e.g., airport, cabin, channel) held
+   * by the shared request records, including the terminating null
+   * character.
+   */
+  const unsigned short SHARED_REQUEST_CODE_SIZE = 8;
+
+  /** Default number of records held by a shared request ring. */
+  extern const std::size_t DEFAULT_SHARED_REQUEST_RING_CAPACITY;
+
+}
+#endif // __TRADEMGEN_BAS_BASCONST_SHAREDREQUESTRING_HPP
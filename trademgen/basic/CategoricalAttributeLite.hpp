@@ -66,6 +66,30 @@ namespace TRADEMGEN {
       }
       return false;
     }
+
+    /**
+     * Get the values (of strictly positive probability).
+     */
+    const std::vector<T>& getValueList() const {
+      return _valueArray;
+    }
+
+    /**
+     * Get the probability of the given value (zero when it does not
+     * belong to the value list).
+     */
+    stdair::Probability_T getProbability (const T& iValue) const {
+      for (unsigned int idx = 0; idx < _valueArray.size(); ++idx) {
+        if (_valueArray.at(idx) == iValue) {
+          const stdair::Probability_T lPreviousCumulativeProbability =
+            (idx == 0) ? 0.0
+            : DictionaryManager::keyToValue (_cumulativeDistribution.at(idx-1));
+          return DictionaryManager::keyToValue (_cumulativeDistribution.at(idx))
+            - lPreviousCumulativeProbability;
+        }
+      }
+      return 0.0;
+    }
     
 
   public:
@@ -97,6 +121,20 @@ namespace TRADEMGEN {
       init (iValueMap);
     }
 
+    /**
+     * Constructor from already compiled arrays, i.e., the values (of
+     * strictly positive probability) and their dictionary-coded
+     * cumulative probabilities (e.g., as stored within a compiled
+     * demand model).
+     */
+    CategoricalAttributeLite (const std::vector<T>& iValueArray,
+                              const std::vector<DictionaryKey_T>& iCumulativeDistribution)
+      : _size (iValueArray.size()),
+        _cumulativeDistribution (iCumulativeDistribution),
+        _valueArray (iValueArray) {
+      assert (iCumulativeDistribution.size() == iValueArray.size());
+    }
+
     /**
      * Default constructor.
      */
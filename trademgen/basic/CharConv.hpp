@@ -0,0 +1,248 @@
+#ifndef __TRADEMGEN_BAS_CHARCONV_HPP
+#define __TRADEMGEN_BAS_CHARCONV_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+// Boost
+#include <boost/date_time/gregorian/gregorian.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+// StdAir
+#include <stdair/stdair_date_time_types.hpp>
+
+namespace TRADEMGEN {
+
+  /**
+   * @brief Locale-independent conversions between numbers and characters.
+   *
+   * Those helpers write directly into a caller-provided character
+   * buffer, and return the position just after the last written
+   * character. They neither allocate memory nor go through the iostream
+   * machinery, so that they can be used on the hot path of the request
+   * writers (one call per field and per generated request).
+   *
+   * \note The project is compiled with C++14, where std::to_chars() is
+   *       not available; those helpers fill the same role.
+   */
+  namespace CharConv {
+
+    /** Maximum number of characters written by formatUnsigned(). */
+    const unsigned short MAX_UNSIGNED_SIZE = 20;
+
+    /** Maximum number of characters written by formatFixed(). */
+    const unsigned short MAX_FIXED_SIZE = 32;
+
+    /** Number of characters written by formatDate() (YYYY-MM-DD). */
+    const unsigned short DATE_SIZE = 10;
+
+    /** Maximum precision supported by formatFixed(). */
+    const unsigned short MAX_FIXED_PRECISION = 9;
+
+    /** Two-digit representations of the integers from 0 to 99. */
+    static const char K_DIGIT_PAIRS[] =
+      "00010203040506070809"
+      "10111213141516171819"
+      "20212223242526272829"
+      "30313233343536373839"
+      "40414243444546474849"
+      "50515253545556575859"
+      "60616263646566676869"
+      "70717273747576777879"
+      "80818283848586878889"
+      "90919293949596979899";
+
+    /** Powers of ten, up to the maximum supported fixed precision. */
+    static constexpr unsigned long long K_POWERS_OF_TEN[] = {
+      1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL,
+      10000000ULL, 100000000ULL, 1000000000ULL };
+
+    // //////////////////////////////////////////////////////////////////
+    /**
+     * Write the given integer on exactly two digits (from 00 to 99).
+     */
+    inline char* formatTwoDigits (char* ioPtr, const unsigned int iValue) {
+      const char* lPair = K_DIGIT_PAIRS + 2 * (iValue % 100);
+      ioPtr[0] = lPair[0];
+      ioPtr[1] = lPair[1];
+      return ioPtr + 2;
+    }
+
+    // //////////////////////////////////////////////////////////////////
+    /**
+     * Write the given integer, left-padded with zeros so as to span
+     * exactly the given number of digits (at most 20).
+     */
+    inline char* formatPadded (char* ioPtr, unsigned long long iValue,
+                               const unsigned short iNbOfDigits) {
+      char* lEnd = ioPtr + iNbOfDigits;
+      char* lCursor = lEnd;
+      while (lCursor - ioPtr >= 2) {
+        lCursor -= 2;
+        formatTwoDigits (lCursor, static_cast<unsigned int> (iValue % 100));
+        iValue /= 100;
+      }
+      if (lCursor != ioPtr) {
+        *ioPtr = static_cast<char> ('0' + iValue % 10);
+      }
+      return lEnd;
+    }
+
+    // //////////////////////////////////////////////////////////////////
+    /**
+     * Write the decimal representation of the given unsigned integer.
+     */
+    inline char* formatUnsigned (char* ioPtr, unsigned long long iValue) {
+      char lTmp[MAX_UNSIGNED_SIZE];
+      char* lCursor = lTmp + MAX_UNSIGNED_SIZE;
+      while (iValue >= 100) {
+        lCursor -= 2;
+        formatTwoDigits (lCursor, static_cast<unsigned int> (iValue % 100));
+        iValue /= 100;
+      }
+      if (iValue >= 10) {
+        lCursor -= 2;
+        formatTwoDigits (lCursor, static_cast<unsigned int> (iValue));
+      } else {
+        --lCursor;
+        *lCursor = static_cast<char> ('0' + iValue);
+      }
+      const std::size_t lSize = lTmp + MAX_UNSIGNED_SIZE - lCursor;
+      std::memcpy (ioPtr, lCursor, lSize);
+      return ioPtr + lSize;
+    }
+
+    // //////////////////////////////////////////////////////////////////
+    /**
+     * Write the decimal representation of the given signed integer.
+     */
+    inline char* formatSigned (char* ioPtr, const long long iValue) {
+      if (iValue < 0) {
+        *ioPtr++ = '-';
+        // The unsigned negation is well-defined, even for the minimum value
+        return formatUnsigned (ioPtr, 0ULL - static_cast<unsigned long long> (iValue));
+      }
+      return formatUnsigned (ioPtr, static_cast<unsigned long long> (iValue));
+    }
+
+    // //////////////////////////////////////////////////////////////////
+    /**
+     * Write the given floating-point number with a fixed number of
+     * decimals (rounded half away from zero), e.g., "1234.50" for
+     * formatFixed<2>().
+     *
+     * The precision is a template parameter, so that the compiler can
+     * replace the divisions by the power of ten by multiplications.
+     * Numbers too large to be represented on 64 bits, once scaled, are
+     * written in the scientific notation (e.g., "1e+20"); NaN and
+     * infinite values are written as "nan", "inf" and "-inf".
+     */
+    template <unsigned short PRECISION>
+    inline char* formatFixed (char* ioPtr, const double iValue) {
+      static_assert (PRECISION <= MAX_FIXED_PRECISION,
+                     "Unsupported precision for CharConv::formatFixed()");
+
+      if (std::isnan (iValue)) {
+        std::memcpy (ioPtr, "nan", 3);
+        return ioPtr + 3;
+      }
+      if (std::isinf (iValue)) {
+        if (iValue < 0) {
+          *ioPtr++ = '-';
+        }
+        std::memcpy (ioPtr, "inf", 3);
+        return ioPtr + 3;
+      }
+
+      const unsigned long long lScale = K_POWERS_OF_TEN[PRECISION];
+      const double lScaledAbs = std::fabs (iValue) * lScale + 0.5;
+      if (lScaledAbs >= 1e18) {
+        // At most 24 characters (e.g., -1.2345678901234567e+308)
+        const int lSize = std::snprintf (ioPtr, MAX_FIXED_SIZE, "%.17g", iValue);
+        return ioPtr + lSize;
+      }
+
+      const unsigned long long lScaled =
+        static_cast<unsigned long long> (lScaledAbs);
+      if (iValue < 0 && lScaled != 0) {
+        *ioPtr++ = '-';
+      }
+      ioPtr = formatUnsigned (ioPtr, lScaled / lScale);
+      if (PRECISION != 0) {
+        *ioPtr++ = '.';
+        ioPtr = formatPadded (ioPtr, lScaled % lScale, PRECISION);
+      }
+      return ioPtr;
+    }
+
+    // //////////////////////////////////////////////////////////////////
+    /**
+     * Write the given date in the ISO extended format (e.g., 2010-02-08).
+     *
+     * Special dates (e.g., not-a-date-time) are written as Boost does.
+     */
+    inline char* formatDate (char* ioPtr, const stdair::Date_T& iDate) {
+      if (iDate.is_special() == true) {
+        const std::string lDateStr =
+          boost::gregorian::to_iso_extended_string (iDate);
+        std::memcpy (ioPtr, lDateStr.c_str(), lDateStr.size());
+        return ioPtr + lDateStr.size();
+      }
+      const boost::gregorian::date::ymd_type lYMD = iDate.year_month_day();
+      ioPtr = formatPadded (ioPtr, lYMD.year, 4);
+      *ioPtr++ = '-';
+      ioPtr = formatTwoDigits (ioPtr, lYMD.month.as_number());
+      *ioPtr++ = '-';
+      ioPtr = formatTwoDigits (ioPtr, lYMD.day.as_number());
+      return ioPtr;
+    }
+
+    // //////////////////////////////////////////////////////////////////
+    /**
+     * Write the given number of milliseconds as a time of the day,
+     * either as hh:mm:ss or, when the milliseconds are requested, as
+     * hh:mm:ss.fff.
+     */
+    inline char* formatTime (char* ioPtr, long long iNbOfMilliseconds,
+                             const bool iWithMilliseconds) {
+      if (iNbOfMilliseconds < 0) {
+        *ioPtr++ = '-';
+        iNbOfMilliseconds = -iNbOfMilliseconds;
+      }
+      const unsigned long long lNbOfMilliseconds = iNbOfMilliseconds;
+      const unsigned long long lNbOfSeconds = lNbOfMilliseconds / 1000;
+      const unsigned long long lHours = lNbOfSeconds / 3600;
+      if (lHours < 100) {
+        ioPtr = formatTwoDigits (ioPtr, static_cast<unsigned int> (lHours));
+      } else {
+        ioPtr = formatUnsigned (ioPtr, lHours);
+      }
+      *ioPtr++ = ':';
+      ioPtr = formatTwoDigits (ioPtr,
+                               static_cast<unsigned int> ((lNbOfSeconds / 60) % 60));
+      *ioPtr++ = ':';
+      ioPtr = formatTwoDigits (ioPtr,
+                               static_cast<unsigned int> (lNbOfSeconds % 60));
+      if (iWithMilliseconds == true) {
+        *ioPtr++ = '.';
+        ioPtr = formatPadded (ioPtr, lNbOfMilliseconds % 1000, 3);
+      }
+      return ioPtr;
+    }
+
+    // //////////////////////////////////////////////////////////////////
+    /**
+     * Write the given duration as a time of the day.
+     */
+    inline char* formatTime (char* ioPtr, const stdair::Duration_T& iTime,
+                             const bool iWithMilliseconds) {
+      return formatTime (ioPtr, iTime.total_milliseconds(), iWithMilliseconds);
+    }
+
+  }
+}
+#endif // __TRADEMGEN_BAS_CHARCONV_HPP
@@ -76,6 +76,44 @@ namespace TRADEMGEN {
       return oValue;
     }
 
+    /**
+     * Get the cumulative probability of the given value, interpolated
+     * between the points of the cumulative distribution (zero before the
+     * first point, and the cumulative probability of the last point
+     * after it).
+     */
+    const stdair::Probability_T getCumulativeProbability (const T iValue) const {
+      // Find the first value greater than iValue.
+      unsigned int idx = 0;
+      for (; idx < _size; ++idx) {
+        if (_valueArray.at(idx) > iValue) {
+          break;
+        }
+      }
+
+      if (idx == 0) {
+        return 0.0;
+      }
+      const stdair::Probability_T& lCumulativePreviousPoint =
+        DictionaryManager::keyToValue (_cumulativeDistribution.at(idx-1));
+      if (idx == _size) {
+        return lCumulativePreviousPoint;
+      }
+
+      //
+      const stdair::Probability_T& lCumulativeCurrentPoint =
+        DictionaryManager::keyToValue (_cumulativeDistribution.at(idx));
+      const T& lValueCurrentPoint = _valueArray.at(idx);
+      const T& lValuePreviousPoint = _valueArray.at(idx-1);
+
+      const stdair::Probability_T oProbability = lCumulativePreviousPoint
+        + (lCumulativeCurrentPoint - lCumulativePreviousPoint)
+        * (iValue - lValuePreviousPoint)
+        / (lValueCurrentPoint - lValuePreviousPoint);
+
+      return oProbability;
+    }
+
     /**
      * Get the value of the derivative function in a key point.
      */
@@ -158,6 +196,19 @@ namespace TRADEMGEN {
       : _size (iValueMap.size()) {
       init (iValueMap);
     }
+
+    /**
+     * Constructor from already compiled arrays, i.e., the values and
+     * their dictionary-coded cumulative probabilities (e.g., as stored
+     * within a compiled demand model).
+     */
+    ContinuousAttributeLite (const std::vector<T>& iValueArray,
+                             const std::vector<DictionaryKey_T>& iCumulativeDistribution)
+      : _size (iValueArray.size()),
+        _cumulativeDistribution (iCumulativeDistribution),
+        _valueArray (iValueArray) {
+      assert (iCumulativeDistribution.size() == iValueArray.size());
+    }
     
     /**
      * Copy constructor.
@@ -0,0 +1,112 @@
+#ifndef __TRADEMGEN_BAS_PARALLELTASKS_HPP
+#define __TRADEMGEN_BAS_PARALLELTASKS_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace TRADEMGEN {
+
+  // //////////////////////////////////////////////////////////////////////
+  /**
+   * Get the number of threads to be used, when the given one is zero
+   * (i.e., as many as the machine can run concurrently).
+   */
+  inline unsigned int getNbOfThreads (const unsigned int iNbOfThreads) {
+    if (iNbOfThreads != 0) {
+      return iNbOfThreads;
+    }
+    const unsigned int lNbOfHardwareThreads =
+      std::thread::hardware_concurrency();
+    return (lNbOfHardwareThreads == 0)?1:lNbOfHardwareThreads;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  /**
+   * Run the given task for every index within [0, iNbOfTasks), on (at
+   * most) the given number of threads, the calling one included. The
+   * tasks are picked in the order of their indices, but may complete in
+   * any order; they must hence not depend on each other.
+   *
+   * When a task throws, no other task is started, and the exception is
+   * re-thrown by the calling thread, once all the threads are over.
+   *
+   * @param const std::size_t Number of tasks.
+   * @param const unsigned int Number of threads (zero meaning as many as
+   *        the machine can run concurrently).
+   * @param TASK& Task, called with the index of the task to be run.
+   */
+  template <typename TASK>
+  void runParallelTasks (const std::size_t iNbOfTasks,
+                         const unsigned int iNbOfThreads, TASK& ioTask) {
+    std::size_t lNbOfThreads = getNbOfThreads (iNbOfThreads);
+    if (lNbOfThreads > iNbOfTasks) {
+      lNbOfThreads = iNbOfTasks;
+    }
+
+    // No need for any other thread
+    if (lNbOfThreads <= 1) {
+      for (std::size_t idx = 0; idx != iNbOfTasks; ++idx) {
+        ioTask (idx);
+      }
+      return;
+    }
+
+    std::atomic<std::size_t> lNextTaskIdx (0);
+    std::atomic<bool> hasFailed (false);
+    std::exception_ptr lException;
+    std::mutex lExceptionMutex;
+
+    // Main loop of each thread: run the next task, until there is none
+    // left, or one of them has failed
+    auto lRunTasks = [&]() {
+      while (hasFailed.load() == false) {
+        const std::size_t lTaskIdx = lNextTaskIdx.fetch_add (1);
+        if (lTaskIdx >= iNbOfTasks) {
+          break;
+        }
+        try {
+          ioTask (lTaskIdx);
+
+        } catch (...) {
+          std::lock_guard<std::mutex> lLock (lExceptionMutex);
+          if (lException == NULL) {
+            lException = std::current_exception();
+          }
+          hasFailed = true;
+        }
+      }
+    };
+
+    std::vector<std::thread> lThreadList;
+    lThreadList.reserve (lNbOfThreads - 1);
+    for (std::size_t idx = 1; idx != lNbOfThreads; ++idx) {
+      try {
+        lThreadList.push_back (std::thread (lRunTasks));
+
+      } catch (const std::system_error&) {
+        // The tasks are then run by the threads started so far
+        break;
+      }
+    }
+    lRunTasks();
+    for (std::vector<std::thread>::iterator itThread = lThreadList.begin();
+         itThread != lThreadList.end(); ++itThread) {
+      itThread->join();
+    }
+
+    if (lException != NULL) {
+      std::rethrow_exception (lException);
+    }
+  }
+
+}
+#endif // __TRADEMGEN_BAS_PARALLELTASKS_HPP
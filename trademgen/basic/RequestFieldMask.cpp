@@ -0,0 +1,85 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <sstream>
+// TraDemGen
+#include <trademgen/TRADEMGEN_Exceptions.hpp>
+#include <trademgen/basic/RequestFieldMask.hpp>
+
+namespace TRADEMGEN {
+
+  namespace {
+
+    /** Number of the fields which may be left out. */
+    const unsigned short K_NB_OF_REQUEST_FIELDS = 9;
+
+    /**
+     * Names of the fields, in the order of their bits, as in the header
+     * of the (CSV) request files.
+     */
+    const char* K_REQUEST_FIELD_NAMES[K_NB_OF_REQUEST_FIELDS] = {
+      "pos", "channel", "trip_type", "stay_duration", "frequent_flyer",
+      "change_fees", "non_refundable", "value_of_time", "wtp"
+    };
+
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  RequestFieldMask::RequestFieldMask() : _mask (ALL_FIELDS) {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  RequestFieldMask::RequestFieldMask (const unsigned int iMask)
+    : _mask (iMask & ALL_FIELDS) {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  RequestFieldMask::RequestFieldMask (const std::string& iFieldList)
+    : _mask (0) {
+    std::istringstream lFieldList (iFieldList);
+    std::string lField;
+    while (std::getline (lFieldList, lField, ',')) {
+      if (lField == "all") {
+        _mask = ALL_FIELDS;
+        continue;
+      }
+
+      unsigned short idx = 0;
+      while (idx != K_NB_OF_REQUEST_FIELDS
+             && lField != K_REQUEST_FIELD_NAMES[idx]) {
+        ++idx;
+      }
+      if (idx == K_NB_OF_REQUEST_FIELDS) {
+        throw TrademgenGenerationException ("Unknown booking request field: '"
+                                            + lField + "'");
+      }
+      _mask |= (1U << idx);
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  RequestFieldMask::RequestFieldMask (const RequestFieldMask& iFieldMask)
+    : _mask (iFieldMask._mask) {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  RequestFieldMask::~RequestFieldMask() {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const std::string RequestFieldMask::describe() const {
+    std::ostringstream oStr;
+    for (unsigned short idx = 0; idx != K_NB_OF_REQUEST_FIELDS; ++idx) {
+      if ((_mask & (1U << idx)) == 0) {
+        continue;
+      }
+      if (oStr.tellp() != 0) {
+        oStr << ",";
+      }
+      oStr << K_REQUEST_FIELD_NAMES[idx];
+    }
+    return oStr.str();
+  }
+
+}
@@ -0,0 +1,90 @@
+#ifndef __TRADEMGEN_BAS_REQUESTFIELDMASK_HPP
+#define __TRADEMGEN_BAS_REQUESTFIELDMASK_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <string>
+// StdAir
+#include <stdair/basic/StructAbstract.hpp>
+
+namespace TRADEMGEN {
+
+  /**
+   * @brief Fields of the booking requests to be drawn, the other ones
+   * being left to neutral values (empty codes, zero amounts and
+   * durations, false flags), when only a few of them are used (see
+   * TRADEMGEN_Service::setRequestFieldMask()).
+   *
+   * The request date-time, origin, destination, preferred departure
+   * date, preferred cabin and party size are always there. So is the
+   * preferred departure time, as it tells whether the booking request
+   * comes before the departure, i.e., whether it is generated at all.
+   */
+  struct RequestFieldMask : public stdair::StructAbstract {
+  public:
+    // ////////// Type definitions ////////////
+    /** Fields which may be left out, one bit each. */
+    enum EN_RequestField {
+      POS = 1 << 0,
+      CHANNEL = 1 << 1,
+      TRIP_TYPE = 1 << 2,
+      STAY_DURATION = 1 << 3,
+      FREQUENT_FLYER = 1 << 4,
+      CHANGE_FEES = 1 << 5,
+      NON_REFUNDABLE = 1 << 6,
+      VALUE_OF_TIME = 1 << 7,
+      WTP = 1 << 8,
+      LAST_VALUE = 1 << 9
+    };
+
+    /** All the fields. */
+    static const unsigned int ALL_FIELDS = LAST_VALUE - 1;
+
+
+  public:
+    // ////////////////// Business Methods ////////////////
+    /** State whether the given field is to be drawn. */
+    bool isGenerated (const EN_RequestField iField) const {
+      return ((_mask & iField) != 0);
+    }
+
+
+  public:
+    // ////////////////// Display Support Methods ////////////////
+    /**
+     * Give a description of the structure (for display purposes),
+     * i.e., the comma-separated names of the fields to be drawn (e.g.,
+     * "pos,wtp"), as in the header of the (CSV) request files.
+     */
+    const std::string describe() const;
+
+
+  public:
+    // /////////////// Constructors and destructors ///////////////
+    /** Default constructor, with all the fields. */
+    RequestFieldMask();
+    /** Constructor, from the bits of the fields to be drawn. */
+    explicit RequestFieldMask (const unsigned int iMask);
+    /**
+     * Constructor, from the comma-separated names of the fields to be
+     * drawn (see describe()), "all" standing for all of them.
+     *
+     * @throw TrademgenGenerationException when a name is not known.
+     */
+    explicit RequestFieldMask (const std::string& iFieldList);
+    /** Default copy constructor. */
+    RequestFieldMask (const RequestFieldMask&);
+    /** Destructor */
+    ~RequestFieldMask();
+
+
+  public:
+    // ////////////// Attributes ///////////////////
+    /** Bits of the fields to be drawn (see EN_RequestField). */
+    unsigned int _mask;
+  };
+
+}
+#endif // __TRADEMGEN_BAS_REQUESTFIELDMASK_HPP
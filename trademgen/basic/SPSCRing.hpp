@@ -0,0 +1,242 @@
+#ifndef __TRADEMGEN_BAS_SPSCRING_HPP
+#define __TRADEMGEN_BAS_SPSCRING_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace TRADEMGEN {
+
+  /**
+   * @brief Bounded queue between a single producer thread and a single
+   *        consumer thread.
+   *
+   * The items are stored into a ring of slots, the capacity of which is
+   * rounded up to a power of two. The producer only ever writes the
+   * tail index and the consumer the head one, so that pushing and
+   * popping are lock-free as long as the ring is neither full nor
+   * empty. Only the blocking variants, when they actually have to
+   * wait, fall back on a mutex and a condition variable; the other
+   * side then takes the mutex only when it knows that someone waits.
+   *
+   * Once closed (by either side), nothing can be pushed anymore,
+   * whereas the items pushed so far can still be popped.
+   */
+  template <typename T>
+  class SPSCRing {
+  public:
+    // ////////// Constructors and destructors /////////
+    /**
+     * Constructor.
+     *
+     * @param const std::size_t Minimal number of slots (at least one).
+     */
+    explicit SPSCRing (const std::size_t iCapacity)
+      : _slots (getRoundedCapacity (iCapacity)),
+        _mask (_slots.size() - 1), _head (0), _tail (0), _isClosed (false),
+        _isProducerWaiting (false), _isConsumerWaiting (false) {
+    }
+
+
+  public:
+    // ////////// Getters /////////
+    /** Get the number of slots. */
+    std::size_t getCapacity() const {
+      return _slots.size();
+    }
+
+    /** Get the number of items waiting to be popped (a mere estimate). */
+    std::size_t getSize() const {
+      return _tail.load() - _head.load();
+    }
+
+    /** State whether the ring has been closed. */
+    bool isClosed() const {
+      return _isClosed.load();
+    }
+
+
+  public:
+    // ////////// Business methods /////////
+    /**
+     * Push the given item, when there is a free slot (producer side).
+     *
+     * @return bool Whether the item has been pushed, i.e., the ring
+     *         was neither full nor closed.
+     */
+    bool tryPush (const T& iItem) {
+      if (_isClosed.load() == true) {
+        return false;
+      }
+      const std::size_t lTail = _tail.load (std::memory_order_relaxed);
+      if (lTail - _head.load() == _slots.size()) {
+        return false;
+      }
+      _slots[lTail & _mask] = iItem;
+      _tail.store (lTail + 1);
+      if (_isConsumerWaiting.load() == true) {
+        notify();
+      }
+      return true;
+    }
+
+    /**
+     * Push the given item, waiting for a free slot (producer side).
+     *
+     * @return bool Whether the item has been pushed, i.e., the ring has
+     *         not been closed.
+     */
+    bool push (const T& iItem) {
+      while (tryPush (iItem) == false) {
+        if (waitFor (_isProducerWaiting, [this] () {
+              return (_tail.load() - _head.load() != _slots.size());
+            }) == false) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    /**
+     * Pop the next item, when there is one (consumer side).
+     *
+     * @return bool Whether an item has been popped.
+     */
+    bool tryPop (T& oItem) {
+      const std::size_t lHead = _head.load (std::memory_order_relaxed);
+      if (_tail.load() == lHead) {
+        return false;
+      }
+      T& lSlot = _slots[lHead & _mask];
+      oItem = std::move (lSlot);
+      lSlot = T();
+      _head.store (lHead + 1);
+      if (_isProducerWaiting.load() == true) {
+        notify();
+      }
+      return true;
+    }
+
+    /**
+     * Pop the next item, waiting for one to be pushed (consumer side).
+     *
+     * @return bool Whether an item has been popped, i.e., the ring is
+     *         not both empty and closed.
+     */
+    bool pop (T& oItem) {
+      while (tryPop (oItem) == false) {
+        if (waitFor (_isConsumerWaiting, [this] () {
+              return (_tail.load() != _head.load());
+            }) == false) {
+          // The last items may have been pushed right before the closing
+          return tryPop (oItem);
+        }
+      }
+      return true;
+    }
+
+    /**
+     * Close the ring, and wake up the waiting side, if any.
+     */
+    void close() {
+      _isClosed.store (true);
+      notify();
+    }
+
+
+  private:
+    // ////////// Helpers /////////
+    /**
+     * Get the smallest power of two, not below the given capacity.
+     */
+    static std::size_t getRoundedCapacity (const std::size_t iCapacity) {
+      std::size_t oCapacity = 1;
+      while (oCapacity < iCapacity) {
+        oCapacity <<= 1;
+      }
+      return oCapacity;
+    }
+
+    /**
+     * Wake up the waiting side.
+     */
+    void notify() {
+      std::lock_guard<std::mutex> lLock (_mutex);
+      _hasChanged.notify_all();
+    }
+
+    /**
+     * Wait until the given condition holds, or the ring is closed. The
+     * given flag tells the other side that it must notify().
+     *
+     * @return bool Whether the condition holds (rather than the ring
+     *         being closed).
+     */
+    template <typename CONDITION>
+    bool waitFor (std::atomic<bool>& ioIsWaiting,
+                  const CONDITION& iCondition) {
+      std::unique_lock<std::mutex> lLock (_mutex);
+      ioIsWaiting.store (true);
+      _hasChanged.wait (lLock, [this, &iCondition] () {
+          return (iCondition() == true || _isClosed.load() == true);
+        });
+      ioIsWaiting.store (false);
+      return iCondition();
+    }
+
+
+  private:
+    // ////////// Constructors and destructors /////////
+    /** Default constructor (not to be used). */
+    SPSCRing();
+    /** Copy constructor (not to be used). */
+    SPSCRing (const SPSCRing&);
+
+
+  private:
+    // ////////// Attributes /////////
+    /**
+     * Slots of the ring.
+     */
+    std::vector<T> _slots;
+    const std::size_t _mask;
+
+    /**
+     * Number of items popped so far (written by the consumer only), and
+     * number of items pushed so far (written by the producer only). They
+     * are kept on distinct cache lines, so that the two sides do not
+     * invalidate each other's cache on every item.
+     */
+    std::atomic<std::size_t> _head;
+    char _headPadding[64];
+    std::atomic<std::size_t> _tail;
+    char _tailPadding[64];
+
+    /**
+     * Whether the ring has been closed.
+     */
+    std::atomic<bool> _isClosed;
+
+    /**
+     * Whether the producer (resp. consumer) waits for a free slot (resp.
+     * for an item).
+     */
+    std::atomic<bool> _isProducerWaiting;
+    std::atomic<bool> _isConsumerWaiting;
+
+    /**
+     * Synchronisation of the blocking variants.
+     */
+    std::mutex _mutex;
+    std::condition_variable _hasChanged;
+  };
+
+}
+#endif // __TRADEMGEN_BAS_SPSCRING_HPP
@@ -0,0 +1,116 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <cmath>
+#include <sstream>
+// Boost
+#include <boost/math/constants/constants.hpp>
+// TraDemGen
+#include <trademgen/basic/TotalNumberOfRequestsTable.hpp>
+
+namespace TRADEMGEN {
+
+  // //////////////////////////////////////////////////////////////////////
+  TotalNumberOfRequestsTable::TotalNumberOfRequestsTable()
+    : _nbOfRuns (0), _nbOfDemandStreams (0), _nextRun (0) {
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  TotalNumberOfRequestsTable::
+  TotalNumberOfRequestsTable (const TotalNumberOfRequestsTable& iTable)
+    : _nbOfRuns (iTable._nbOfRuns),
+      _nbOfDemandStreams (iTable._nbOfDemandStreams),
+      _nextRun (iTable._nextRun), _totalList (iTable._totalList) {
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  TotalNumberOfRequestsTable::~TotalNumberOfRequestsTable() {
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void TotalNumberOfRequestsTable::
+  draw (const std::vector<stdair::RealNumber_T>& iMeanList,
+        const std::vector<stdair::RealNumber_T>& iStdDevList,
+        const unsigned int iNbOfRuns,
+        stdair::BaseGenerator_T& ioSharedGenerator) {
+    assert (iMeanList.size() == iStdDevList.size());
+
+    _nbOfRuns = iNbOfRuns;
+    _nbOfDemandStreams = iMeanList.size();
+    _nextRun = 0;
+
+    // The Box-Muller transform gives two standard normal variates out of
+    // two uniform ones: draw an even number of them
+    const std::size_t lNbOfTotals =
+      static_cast<std::size_t> (_nbOfRuns) * _nbOfDemandStreams;
+    const std::size_t lNbOfPairs = (lNbOfTotals + 1) / 2;
+
+    // 1. Draw all the uniform variates at once. The first one of every
+    //    pair is taken within ]0, 1], so that its logarithm is finite.
+    stdair::UniformGenerator_T lUniformGenerator (ioSharedGenerator,
+                                                  stdair::UniformDistribution_T());
+    std::vector<stdair::RealNumber_T> lRadiusList (lNbOfPairs);
+    std::vector<stdair::RealNumber_T> lAngleList (lNbOfPairs);
+    for (std::size_t idx = 0; idx != lNbOfPairs; ++idx) {
+      lRadiusList[idx] = 1.0 - lUniformGenerator();
+      lAngleList[idx] = lUniformGenerator();
+    }
+
+    // 2. Transform them into standard normal variates, with straight
+    //    loops over contiguous arrays
+    const stdair::RealNumber_T lTwoPi =
+      boost::math::constants::two_pi<stdair::RealNumber_T>();
+    std::vector<stdair::RealNumber_T> lNormalList (2 * lNbOfPairs);
+    for (std::size_t idx = 0; idx != lNbOfPairs; ++idx) {
+      const stdair::RealNumber_T lRadius =
+        std::sqrt (-2.0 * std::log (lRadiusList[idx]));
+      const stdair::RealNumber_T lAngle = lTwoPi * lAngleList[idx];
+      lNormalList[2 * idx] = lRadius * std::cos (lAngle);
+      lNormalList[2 * idx + 1] = lRadius * std::sin (lAngle);
+    }
+
+    // 3. Scale them, demand stream by demand stream, and round them to
+    //    the nearest (non-negative) integer
+    _totalList.resize (lNbOfTotals);
+    std::size_t lCellIdx = 0;
+    for (unsigned int lRun = 0; lRun != _nbOfRuns; ++lRun) {
+      for (unsigned int lStream = 0; lStream != _nbOfDemandStreams;
+           ++lStream, ++lCellIdx) {
+        const stdair::RealNumber_T lTotal = std::floor (iMeanList[lStream]
+                                                        + iStdDevList[lStream]
+                                                        * lNormalList[lCellIdx]
+                                                        + 0.5);
+        _totalList[lCellIdx] =
+          (lTotal > 0.0) ? static_cast<stdair::Count_T> (lTotal) : 0;
+      }
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  const stdair::Count_T* TotalNumberOfRequestsTable::consumeNextRun() {
+    assert (isEmpty() == false);
+    const stdair::Count_T* oRow_ptr = (_nbOfDemandStreams == 0) ? NULL
+      : &_totalList[static_cast<std::size_t> (_nextRun) * _nbOfDemandStreams];
+    ++_nextRun;
+    return oRow_ptr;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void TotalNumberOfRequestsTable::clear() {
+    _nbOfRuns = 0;
+    _nbOfDemandStreams = 0;
+    _nextRun = 0;
+    _totalList.clear();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  const std::string TotalNumberOfRequestsTable::describe() const {
+    std::ostringstream oStr;
+    oStr << getNbOfRemainingRuns() << "/" << _nbOfRuns << " run(s) x "
+         << _nbOfDemandStreams << " demand stream(s)";
+    return oStr.str();
+  }
+
+}
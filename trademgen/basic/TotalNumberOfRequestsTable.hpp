@@ -0,0 +1,122 @@
+#ifndef __TRADEMGEN_BAS_TOTALNUMBEROFREQUESTSTABLE_HPP
+#define __TRADEMGEN_BAS_TOTALNUMBEROFREQUESTSTABLE_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <string>
+#include <vector>
+// StdAir
+#include <stdair/stdair_basic_types.hpp>
+#include <stdair/stdair_demand_types.hpp>
+#include <stdair/stdair_maths_types.hpp>
+#include <stdair/basic/StructAbstract.hpp>
+
+namespace TRADEMGEN {
+
+  /**
+   * @brief Table of the total numbers of requests to be generated by
+   * every demand stream, drawn in advance for several runs.
+   *
+   * Rather than constructing a normal distribution (and the
+   * corresponding generator) for every demand stream at every reset,
+   * the whole table (runs x demand streams) is drawn in a single pass,
+   * with the Box-Muller transform applied to arrays of uniform draws.
+   * The rows are then consumed, one per reset, in the order of the
+   * runs.
+   */
+  struct TotalNumberOfRequestsTable : public stdair::StructAbstract {
+  public:
+    // ////////// Getters /////////
+    /** Get the number of runs (rows) of the table. */
+    unsigned int getNbOfRuns() const {
+      return _nbOfRuns;
+    }
+
+    /** Get the number of demand streams (columns) of the table. */
+    unsigned int getNbOfDemandStreams() const {
+      return _nbOfDemandStreams;
+    }
+
+    /** Get the number of rows not consumed yet. */
+    unsigned int getNbOfRemainingRuns() const {
+      return _nbOfRuns - _nextRun;
+    }
+
+    /** State whether there is no row left to be consumed. */
+    bool isEmpty() const {
+      return _nextRun >= _nbOfRuns;
+    }
+
+
+  public:
+    // ////////// Constructors and destructors /////////
+    /** Default constructor (empty table). */
+    TotalNumberOfRequestsTable();
+    /** Copy constructor. */
+    TotalNumberOfRequestsTable (const TotalNumberOfRequestsTable&);
+    /** Destructor. */
+    ~TotalNumberOfRequestsTable();
+
+
+  public:
+    // /////////////// Business Methods //////////
+    /**
+     * Draw the total numbers of requests of the given number of runs,
+     * for demand streams following the given normal distributions (the
+     * two lists being in the same order, i.e., that of the demand
+     * streams). The previous content of the table, if any, is
+     * discarded.
+     *
+     * Like when drawn one at a time, the totals are rounded to the
+     * nearest integer; negative totals are stored as zero.
+     *
+     * @param const std::vector<stdair::RealNumber_T>& Mean numbers of
+     *        requests.
+     * @param const std::vector<stdair::RealNumber_T>& Standard deviations
+     *        of the numbers of requests.
+     * @param const unsigned int Number of runs.
+     * @param stdair::BaseGenerator_T& Shared random generator.
+     */
+    void draw (const std::vector<stdair::RealNumber_T>& iMeanList,
+               const std::vector<stdair::RealNumber_T>& iStdDevList,
+               const unsigned int iNbOfRuns,
+               stdair::BaseGenerator_T& ioSharedGenerator);
+
+    /**
+     * Consume the next row of the table.
+     *
+     * @return const stdair::Count_T* Pointer on the total numbers of
+     *         requests of every demand stream for the next run (the
+     *         table must not be empty).
+     */
+    const stdair::Count_T* consumeNextRun();
+
+    /** Empty the table. */
+    void clear();
+
+
+  public:
+    // ////////////// Display Support Methods //////////
+    /** Give a description of the structure (for display purposes). */
+    const std::string describe() const;
+
+
+  private:
+    // ////////// Attributes //////////
+    /** Number of runs (rows). */
+    unsigned int _nbOfRuns;
+
+    /** Number of demand streams (columns). */
+    unsigned int _nbOfDemandStreams;
+
+    /** Index of the next row to be consumed. */
+    unsigned int _nextRun;
+
+    /** Total numbers of requests, row by row (i.e., run by run). */
+    std::vector<stdair::Count_T> _totalList;
+  };
+
+}
+#endif // __TRADEMGEN_BAS_TOTALNUMBEROFREQUESTSTABLE_HPP
@@ -0,0 +1,197 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+//  //// Boost (Extended STL) ////
+// Boost Program Options
+#include <boost/program_options.hpp>
+// StdAir
+#include <stdair/stdair_basic_types.hpp>
+#include <stdair/basic/BasConst_General.hpp>
+#include <stdair/basic/BasLogParams.hpp>
+#include <stdair/service/Logger.hpp>
+// TraDemGen
+#include <trademgen/TRADEMGEN_Service.hpp>
+#include <trademgen/config/trademgen-paths.hpp>
+
+// //////// Constants //////
+/**
+ * Default name and location for the log file.
+ */
+const stdair::Filename_T K_TRADEMGEN_DEFAULT_LOG_FILENAME ("trademgen_compileDemand.log");
+
+/**
+ * Default name and location for the (CSV) input file.
+ */
+const stdair::Filename_T K_TRADEMGEN_DEFAULT_INPUT_FILENAME (STDAIR_SAMPLE_DIR
+                                                             "/demand01.csv");
+
+/**
+ * Default name and location for the compiled demand model (output) file.
+ */
+const stdair::Filename_T K_TRADEMGEN_DEFAULT_OUTPUT_FILENAME ("demand.tdgm");
+
+/**
+ * Early return status (so that it can be differentiated from an error).
+ */
+const int K_TRADEMGEN_EARLY_RETURN_STATUS = 99;
+
+
+// ///////// Parsing of Options & Configuration /////////
+// A helper function to simplify the main part.
+template<class T> std::ostream& operator<< (std::ostream& os,
+                                            const std::vector<T>& v) {
+  std::copy (v.begin(), v.end(), std::ostream_iterator<T> (std::cout, " "));
+  return os;
+}
+
+/**
+ * Read and parse the command line options.
+ */
+int readConfiguration (int argc, char* argv[],
+                       stdair::Filename_T& ioInputFilename,
+                       stdair::Filename_T& ioOutputFilename,
+                       stdair::Filename_T& ioLogFilename) {
+
+  // Declare a group of options that will be allowed only on command line
+  boost::program_options::options_description generic ("Generic options");
+  generic.add_options()
+    ("prefix", "print installation prefix")
+    ("version,v", "print version string")
+    ("help,h", "produce help message");
+
+  // Declare a group of options that will be allowed both on command
+  // line and in config file
+  boost::program_options::options_description config ("Configuration");
+  config.add_options()
+    ("input,i",
+     boost::program_options::value< std::string >(&ioInputFilename)->default_value(K_TRADEMGEN_DEFAULT_INPUT_FILENAME),
+     "(CSV) input file for the demand distributions")
+    ("output,o",
+     boost::program_options::value< std::string >(&ioOutputFilename)->default_value(K_TRADEMGEN_DEFAULT_OUTPUT_FILENAME),
+     "(Binary) output file for the compiled demand model")
+    ("log,l",
+     boost::program_options::value< std::string >(&ioLogFilename)->default_value(K_TRADEMGEN_DEFAULT_LOG_FILENAME),
+     "Filepath for the logs")
+    ;
+
+  // Hidden options, will be allowed both on command line and
+  // in config file, but will not be shown to the user.
+  boost::program_options::options_description hidden ("Hidden options");
+  hidden.add_options()
+    ("copyright",
+     boost::program_options::value< std::vector<std::string> >(),
+     "Show the copyright (license)");
+
+  boost::program_options::options_description cmdline_options;
+  cmdline_options.add(generic).add(config).add(hidden);
+
+  boost::program_options::options_description config_file_options;
+  config_file_options.add(config).add(hidden);
+
+  boost::program_options::options_description visible ("Allowed options");
+  visible.add(generic).add(config);
+
+  boost::program_options::positional_options_description p;
+  p.add ("copyright", -1);
+
+  boost::program_options::variables_map vm;
+  boost::program_options::
+    store (boost::program_options::command_line_parser (argc, argv).
+           options (cmdline_options).positional(p).run(), vm);
+
+  std::ifstream ifs ("trademgen.cfg");
+  boost::program_options::store (parse_config_file (ifs, config_file_options),
+                                 vm);
+  boost::program_options::notify (vm);
+
+  if (vm.count ("help")) {
+    std::cout << visible << std::endl;
+    return K_TRADEMGEN_EARLY_RETURN_STATUS;
+  }
+
+  if (vm.count ("version")) {
+    std::cout << PACKAGE_NAME << ", version " << PACKAGE_VERSION << std::endl;
+    return K_TRADEMGEN_EARLY_RETURN_STATUS;
+  }
+
+  if (vm.count ("prefix")) {
+    std::cout << "Installation prefix: " << PREFIXDIR << std::endl;
+    return K_TRADEMGEN_EARLY_RETURN_STATUS;
+  }
+
+  if (vm.count ("input")) {
+    ioInputFilename = vm["input"].as< std::string >();
+    std::cout << "Input filename is: " << ioInputFilename << std::endl;
+  }
+
+  if (vm.count ("output")) {
+    ioOutputFilename = vm["output"].as< std::string >();
+    std::cout << "Output filename is: " << ioOutputFilename << std::endl;
+  }
+
+  if (vm.count ("log")) {
+    ioLogFilename = vm["log"].as< std::string >();
+    std::cout << "Log filename is: " << ioLogFilename << std::endl;
+  }
+
+  return 0;
+}
+
+
+// /////////////// M A I N /////////////////
+int main (int argc, char* argv[]) {
+
+  // Input file name
+  stdair::Filename_T lInputFilename;
+
+  // Output (compiled demand model) file name
+  stdair::Filename_T lOutputFilename;
+
+  // Output log File
+  stdair::Filename_T lLogFilename;
+
+  // Call the command-line option parser
+  const int lOptionParserStatus =
+    readConfiguration (argc, argv, lInputFilename, lOutputFilename,
+                       lLogFilename);
+
+  if (lOptionParserStatus == K_TRADEMGEN_EARLY_RETURN_STATUS) {
+    return 0;
+  }
+
+  // Set the log parameters
+  std::ofstream logOutputFile;
+  // Open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str());
+  logOutputFile.clear();
+
+  // Set up the log parameters
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+
+  // Initialise the TraDemGen service object. As no demand is generated,
+  // the random generation seed does not matter.
+  TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                 stdair::DEFAULT_RANDOM_SEED);
+
+  // Parse the demand input file, and write the compiled demand model
+  const TRADEMGEN::DemandFilePath lDemandFilePath (lInputFilename);
+  trademgenService.compileDemand (lDemandFilePath, lOutputFilename);
+
+  // Close the Log outputFile
+  logOutputFile.close();
+
+  /*
+    \note: as that program is not intended to be run on a server in
+    production, it is better not to catch the exceptions. When it
+    happens (that an exception is throwned), that way we get the
+    call stack.
+  */
+
+  return 0;
+}
@@ -7,6 +7,7 @@
 #include <fstream>
 #include <vector>
 #include <list>
+#include <memory>
 #include <string>
 //  //// Boost (Extended STL) ////
 // Boost Tokeniser
@@ -34,6 +35,13 @@
 // TraDemGen
 #include <trademgen/TRADEMGEN_Service.hpp>
 #include <trademgen/config/trademgen-paths.hpp>
+#include <trademgen/basic/ArrivalCountTable.hpp>
+#include <trademgen/basic/BasConst_DemandGeneration.hpp>
+#include <trademgen/basic/BasConst_RequestOutput.hpp>
+#include <trademgen/basic/RequestFieldMask.hpp>
+#include <trademgen/command/RequestCsvWriter.hpp>
+#include <trademgen/command/RequestShardWriter.hpp>
+#include <trademgen/command/SharedRequestRingWriter.hpp>
 
 // Aliases for namespaces
 namespace ba = boost::accumulators;
@@ -97,6 +105,17 @@ const NbOfRuns_T K_TRADEMGEN_DEFAULT_RANDOM_DRAWS = 1;
  */
 const bool K_TRADEMGEN_DEFAULT_BUILT_IN_INPUT = false;
 
+/**
+ * Default number of reader processes to wait for, when the requests are
+ * published into a shared memory ring.
+ */
+const unsigned short K_TRADEMGEN_DEFAULT_NB_OF_SHM_READERS = 1;
+
+/**
+ * Default number of shards: the demand generation is not sharded.
+ */
+const unsigned short K_TRADEMGEN_DEFAULT_NB_OF_SHARDS = 0;
+
 /**
  * Early return status (so that it can be differentiated from an error).
  */
@@ -141,16 +160,41 @@ int readConfiguration (int argc, char* argv[], bool& ioIsBuiltin,
                        stdair::RandomSeed_T& ioRandomSeed,
                        NbOfRuns_T& ioRandomRuns,
                        stdair::Filename_T& ioInputFilename,
+                       stdair::Filename_T& ioCompiledInputFilename,
                        stdair::Filename_T& ioOutputFilename,
                        stdair::Filename_T& ioLogFilename,
-                       stdair::DemandGenerationMethod& ioDemandGenerationMethod) {
+                       stdair::DemandGenerationMethod& ioDemandGenerationMethod,
+                       std::size_t& ioOutputBlockSize,
+                       unsigned short& ioNbOfOutputBlocks,
+                       std::string& ioSharedRingName,
+                       unsigned short& ioNbOfSharedRingReaders,
+                       unsigned short& ioNbOfShards,
+                       unsigned short& ioShardIndex,
+                       stdair::Filename_T& ioBinaryOutputFilename,
+                       bool& ioIsByStream,
+                       unsigned int& ioNbOfGenerationThreads,
+                       unsigned int& ioAggregationMinutes,
+                       std::string& ioRequestFields,
+                       bool& ioIsCountOnly,
+                       TRADEMGEN::ArrivalCountTable::DTDList_T& ioDTDBoundaryList,
+                       bool& ioIsCountByChannel) {
 
   // Demand generation method as a single char (e.g., 'P' or 'S').
   char lDemandGenerationMethodChar;
 
+  // Number of output blocks, when the output is asynchronous
+  unsigned short lNbOfAsyncOutputBlocks;
+
   // Default for the built-in input
   ioIsBuiltin = K_TRADEMGEN_DEFAULT_BUILT_IN_INPUT;
 
+  // By default, the requests are generated through the event queue
+  ioIsByStream = false;
+
+  // By default, the requests themselves are generated, not only counted
+  ioIsCountOnly = false;
+  ioIsCountByChannel = false;
+
   // Declare a group of options that will be allowed only on command line
   boost::program_options::options_description generic ("Generic options");
   generic.add_options()
@@ -176,9 +220,51 @@ int readConfiguration (int argc, char* argv[], bool& ioIsBuiltin,
     ("input,i",
      boost::program_options::value< std::string >(&ioInputFilename)->default_value(K_TRADEMGEN_DEFAULT_INPUT_FILENAME),
      "(CSV) input file for the demand distributions")
+    ("compiled-input,c",
+     boost::program_options::value< std::string >(&ioCompiledInputFilename),
+     "Compiled demand model (as written by trademgen_compileDemand), to be loaded instead of the (CSV) input file")
     ("output,o",
      boost::program_options::value< std::string >(&ioOutputFilename)->default_value(K_TRADEMGEN_DEFAULT_OUTPUT_FILENAME),
      "(CSV) output file for the generated requests")
+    ("async-output",
+     "Write the (CSV) output file from a dedicated I/O thread, so that the generation does not wait for the disk")
+    ("output-block-size",
+     boost::program_options::value<std::size_t>(&ioOutputBlockSize)->default_value(TRADEMGEN::DEFAULT_REQUEST_OUTPUT_BLOCK_SIZE),
+     "Size (in bytes) of the blocks written into the (CSV) output file")
+    ("output-blocks",
+     boost::program_options::value<unsigned short>(&lNbOfAsyncOutputBlocks)->default_value(TRADEMGEN::DEFAULT_ASYNC_REQUEST_OUTPUT_NB_OF_BLOCKS),
+     "Number of output blocks (at least 2) with the --async-output option. When all of them wait for being written, the generation waits in turn")
+    ("shm-ring",
+     boost::program_options::value< std::string >(&ioSharedRingName),
+     "Publish the generated requests into the POSIX shared memory ring of that name, for other processes to consume them, rather than into the (CSV) output file")
+    ("shm-readers",
+     boost::program_options::value<unsigned short>(&ioNbOfSharedRingReaders)->default_value(K_TRADEMGEN_DEFAULT_NB_OF_SHM_READERS),
+     "Number of reader processes to wait for, with the --shm-ring option, before publishing the first request")
+    ("shards",
+     boost::program_options::value<unsigned short>(&ioNbOfShards)->default_value(K_TRADEMGEN_DEFAULT_NB_OF_SHARDS),
+     "Number of shards, i.e., of processes generating the demand concurrently, each one the demand streams of its own shard (0 for no sharding)")
+    ("shard-index",
+     boost::program_options::value<unsigned short>(&ioShardIndex)->default_value(0),
+     "Index (from 0) of the shard generated by this process, with the --shards option")
+    ("binary-output",
+     boost::program_options::value< std::string >(&ioBinaryOutputFilename),
+     "Request shard file, to be merged by trademgen_merge, into which the generated requests are dumped, rather than into the (CSV) output file")
+    ("by-stream",
+     "Generate the requests demand stream by demand stream, concurrently and without the event queue: the requests of every demand stream come in a row, but they are not globally ordered by date-time")
+    ("generation-threads",
+     boost::program_options::value<unsigned int>(&ioNbOfGenerationThreads)->default_value(TRADEMGEN::DEFAULT_NB_OF_GENERATION_THREADS),
+     "Number of threads generating the demand streams with the --by-stream option (0 for as many as the machine can run concurrently)")
+    ("aggregation-minutes",
+     boost::program_options::value<unsigned int>(&ioAggregationMinutes)->default_value(0),
+     "With the --by-stream option, merge the requests of every demand stream made within the same period (in minutes) before departure, and sharing the same attributes, into a single request, the party size of which is the number of passengers (0 for no aggregation)")
+    ("counts",
+     boost::program_options::value< std::string >(),
+     "Only count the requests of every demand stream within buckets of days before departure, given by their comma-separated, decreasing bounds (e.g., '90,30,7' for more than 90 days, 90 to 30, 30 to 7 and less than 7), without generating them; the counts are dumped into the (CSV) output file")
+    ("counts-by-channel",
+     "With the --counts option, also split the counts by channel")
+    ("fields",
+     boost::program_options::value< std::string >(&ioRequestFields),
+     "Comma-separated fields of the requests to be drawn, among pos, channel, trip_type, stay_duration, frequent_flyer, change_fees, non_refundable, value_of_time and wtp (e.g., 'pos,wtp'), the other ones being left empty; every field is then drawn from its own random sub-stream, so that it does not depend on the other fields")
     ("log,l",
      boost::program_options::value< std::string >(&ioLogFilename)->default_value(K_TRADEMGEN_DEFAULT_LOG_FILENAME),
      "Filepath for the logs")
@@ -237,8 +323,14 @@ int readConfiguration (int argc, char* argv[], bool& ioIsBuiltin,
 
   if (ioIsBuiltin == false) {
 
-    // The BOM tree should be built from parsing a demand input file
-    if (vm.count ("input")) {
+    // The BOM tree should be built from a compiled demand model, or from
+    // parsing a demand input file
+    if (vm.count ("compiled-input")) {
+      ioCompiledInputFilename = vm["compiled-input"].as< std::string >();
+      std::cout << "Compiled input filename is: " << ioCompiledInputFilename
+                << std::endl;
+
+    } else if (vm.count ("input")) {
       ioInputFilename = vm["input"].as< std::string >();
       std::cout << "Input filename is: " << ioInputFilename << std::endl;
 
@@ -255,6 +347,95 @@ int readConfiguration (int argc, char* argv[], bool& ioIsBuiltin,
     std::cout << "Output filename is: " << ioOutputFilename << std::endl;
   }
 
+  if (vm.count ("shm-ring")) {
+    ioSharedRingName = vm["shm-ring"].as< std::string >();
+    std::cout << "The requests are published into the shared memory ring '"
+              << ioSharedRingName << "', for " << ioNbOfSharedRingReaders
+              << " reader(s)" << std::endl;
+  }
+
+  if (ioNbOfShards != 0) {
+    if (ioShardIndex >= ioNbOfShards) {
+      std::cerr << "The shard index (" << ioShardIndex << ") must be lower "
+                << "than the number of shards (" << ioNbOfShards << ")"
+                << std::endl;
+      return K_TRADEMGEN_EARLY_RETURN_STATUS;
+    }
+    std::cout << "Only the shard #" << ioShardIndex << " out of "
+              << ioNbOfShards << " is generated" << std::endl;
+  }
+
+  if (vm.count ("binary-output")) {
+    ioBinaryOutputFilename = vm["binary-output"].as< std::string >();
+    std::cout << "Binary output (request shard) filename is: "
+              << ioBinaryOutputFilename << std::endl;
+  }
+
+  if (vm.count ("counts")) {
+    // The requests are not generated, hence not published or dumped
+    if (ioSharedRingName.empty() == false
+        || ioBinaryOutputFilename.empty() == false) {
+      std::cerr << "The --counts option cannot be used with the --shm-ring "
+                << "or --binary-output options" << std::endl;
+      return K_TRADEMGEN_EARLY_RETURN_STATUS;
+    }
+    ioIsCountOnly = true;
+    typedef boost::tokenizer<boost::char_separator<char> > Tokeniser_T;
+    const std::string lDTDListStr = vm["counts"].as< std::string >();
+    const Tokeniser_T lTokens (lDTDListStr, boost::char_separator<char> (","));
+    for (Tokeniser_T::const_iterator itToken = lTokens.begin();
+         itToken != lTokens.end(); ++itToken) {
+      std::istringstream lDTDStr (*itToken);
+      stdair::DayDuration_T lDTD;
+      if (!(lDTDStr >> lDTD)) {
+        std::cerr << "The bounds of the --counts option must be numbers of "
+                  << "days, not '" << *itToken << "'" << std::endl;
+        return K_TRADEMGEN_EARLY_RETURN_STATUS;
+      }
+      ioDTDBoundaryList.push_back (lDTD);
+    }
+    ioIsCountByChannel = (vm.count ("counts-by-channel") != 0);
+    std::cout << "Only the requests are counted, by bucket of days before "
+              << "departure" << (ioIsCountByChannel ? " and by channel" : "")
+              << std::endl;
+  }
+
+  if (vm.count ("fields")) {
+    ioRequestFields = vm["fields"].as< std::string >();
+    std::cout << "Only the following fields of the requests are drawn: "
+              << ioRequestFields << std::endl;
+  }
+
+  if (vm.count ("by-stream")) {
+    // The request shard files are merged in time order
+    if (ioBinaryOutputFilename.empty() == false) {
+      std::cerr << "The --by-stream and --binary-output options cannot be "
+                << "used together" << std::endl;
+      return K_TRADEMGEN_EARLY_RETURN_STATUS;
+    }
+    ioIsByStream = true;
+    std::cout << "The requests are generated demand stream by demand stream"
+              << std::endl;
+  }
+
+  if (ioAggregationMinutes != 0) {
+    // The requests are only aggregated demand stream by demand stream
+    if (ioIsByStream == false) {
+      std::cerr << "The --aggregation-minutes option requires the "
+                << "--by-stream option" << std::endl;
+      return K_TRADEMGEN_EARLY_RETURN_STATUS;
+    }
+    std::cout << "The requests are aggregated over periods of "
+              << ioAggregationMinutes << " minutes" << std::endl;
+  }
+
+  ioNbOfOutputBlocks = TRADEMGEN::DEFAULT_REQUEST_OUTPUT_NB_OF_BLOCKS;
+  if (vm.count ("async-output")) {
+    ioNbOfOutputBlocks = (lNbOfAsyncOutputBlocks < 2)?2:lNbOfAsyncOutputBlocks;
+    std::cout << "The output is asynchronous, with " << ioNbOfOutputBlocks
+              << " blocks of " << ioOutputBlockSize << " bytes" << std::endl;
+  }
+
   if (vm.count ("log")) {
     ioLogFilename = vm["log"].as< std::string >();
     std::cout << "Log filename is: " << ioLogFilename << std::endl;
@@ -280,12 +461,48 @@ int readConfiguration (int argc, char* argv[], bool& ioIsBuiltin,
 void generateDemand (TRADEMGEN::TRADEMGEN_Service& ioTrademgenService,
                      const stdair::Filename_T& iOutputFilename,
                      const NbOfRuns_T& iNbOfRuns,
-                     const stdair::DemandGenerationMethod& iDemandGenerationMethod) {
+                     const stdair::DemandGenerationMethod& iDemandGenerationMethod,
+                     const std::size_t iOutputBlockSize,
+                     const unsigned short iNbOfOutputBlocks,
+                     const std::string& iSharedRingName,
+                     const unsigned short iNbOfSharedRingReaders,
+                     const unsigned short iNbOfShards,
+                     const unsigned short iShardIndex,
+                     const stdair::Filename_T& iBinaryOutputFilename,
+                     const bool iIsByStream,
+                     const unsigned int iNbOfGenerationThreads,
+                     const unsigned int iAggregationMinutes) {
+
+  // Either create the shared memory ring, and wait for its readers, or
+  // open and clean the request shard file, or the .csv output file
+  std::unique_ptr<TRADEMGEN::SharedRequestRingWriter> lRingWriter_ptr;
+  std::unique_ptr<TRADEMGEN::RequestShardWriter> lShardWriter_ptr;
+  std::unique_ptr<TRADEMGEN::RequestCsvWriter> lCsvWriter_ptr;
+  TRADEMGEN::RequestSink* lRequestWriter_ptr = NULL;
+  if (iSharedRingName.empty() == false) {
+    lRingWriter_ptr.reset (new TRADEMGEN::SharedRequestRingWriter (iSharedRingName));
+    lRingWriter_ptr->waitForReaders (iNbOfSharedRingReaders);
+    lRequestWriter_ptr = lRingWriter_ptr.get();
+
+  } else if (iBinaryOutputFilename.empty() == false) {
+    // Without sharding, the file is the single shard of the generation
+    const unsigned short lNbOfShards = (iNbOfShards == 0) ? 1 : iNbOfShards;
+    lShardWriter_ptr.reset (new TRADEMGEN::RequestShardWriter (iBinaryOutputFilename,
+                                                               iShardIndex,
+                                                               lNbOfShards,
+                                                               iOutputBlockSize,
+                                                               iNbOfOutputBlocks));
+    lRequestWriter_ptr = lShardWriter_ptr.get();
 
-  // Open and clean the .csv output file
-  std::ofstream output;
-  output.open (iOutputFilename.c_str());
-  output.clear();
+  } else {
+    lCsvWriter_ptr.reset (new TRADEMGEN::RequestCsvWriter (iOutputFilename,
+                                                           iOutputBlockSize,
+                                                           iNbOfOutputBlocks));
+    lCsvWriter_ptr->writeHeader();
+    lRequestWriter_ptr = lCsvWriter_ptr.get();
+  }
+  assert (lRequestWriter_ptr != NULL);
+  TRADEMGEN::RequestSink& lRequestWriter = *lRequestWriter_ptr;
     
   // Initialise the statistics collector/accumulator
   stat_acc_type lStatAccumulator;
@@ -306,7 +523,25 @@ void generateDemand (TRADEMGEN::TRADEMGEN_Service& ioTrademgenService,
   
   for (NbOfRuns_T runIdx = 1; runIdx <= iNbOfRuns; ++runIdx) {
     // /////////////////////////////////////////////////////
-    output << "Run number: " << runIdx << std::endl;
+    lRequestWriter.setRunNumber (runIdx);
+
+    if (iIsByStream == true) {
+      // Generate the run demand stream by demand stream, without the
+      // event queue. The service is reset at the end of the run.
+      const stdair::Duration_T lAggregationPeriod (0, iAggregationMinutes, 0);
+      const stdair::Count_T lNbOfRequests =
+        ioTrademgenService.generateAggregatedRunByStream (lRequestWriter,
+                                                          iDemandGenerationMethod,
+                                                          lAggregationPeriod,
+                                                          iNbOfGenerationThreads);
+
+      // Add the number of events to the statistics accumulator
+      lStatAccumulator (lNbOfRequests);
+
+      // Update the progress display
+      lProgressDisplay += lNbOfRequests;
+      continue;
+    }
 
     /**
        Initialisation step.
@@ -346,8 +581,8 @@ void generateDemand (TRADEMGEN::TRADEMGEN_Service& ioTrademgenService,
       STDAIR_LOG_DEBUG ("[" << runIdx << "] Poped booking request: '"
                         << lPoppedRequest.describe() << "'.");
     
-      // Dump the request into the dedicated CSV file
-      // stdair::BomDisplay::csvDisplay (output, lPoppedRequest);
+      // Dump the request into the dedicated CSV file (or shared memory ring)
+      lRequestWriter.write (lPoppedRequest);
         
       // Retrieve the corresponding demand stream key
       const stdair::DemandGeneratorKey_T& lDemandStreamKey =
@@ -420,8 +655,56 @@ void generateDemand (TRADEMGEN::TRADEMGEN_Service& ioTrademgenService,
   const std::string& lBOMStr = ioTrademgenService.csvDisplay();
   STDAIR_LOG_DEBUG (lBOMStr);
 
+  // Close the output file (or request shard file, or shared memory ring)
+  if (lCsvWriter_ptr != NULL) {
+    lCsvWriter_ptr->close();
+  } else if (lShardWriter_ptr != NULL) {
+    lShardWriter_ptr->close();
+  } else {
+    lRingWriter_ptr->close();
+  }
+}
+
+// /////////////////////////////////////////////////////////////////////////
+void generateArrivalCounts (TRADEMGEN::TRADEMGEN_Service& ioTrademgenService,
+                            const stdair::Filename_T& iOutputFilename,
+                            const NbOfRuns_T& iNbOfRuns,
+                            const stdair::DemandGenerationMethod& iDemandGenerationMethod,
+                            const TRADEMGEN::ArrivalCountTable::DTDList_T& iDTDBoundaryList,
+                            const bool iIsByChannel,
+                            const unsigned int iNbOfGenerationThreads) {
+
+  // Open and clean the .csv output file
+  std::ofstream lOutputFile (iOutputFilename.c_str());
+  TRADEMGEN::ArrivalCountTable lArrivalCountTable (iDTDBoundaryList,
+                                                   iIsByChannel);
+  lArrivalCountTable.writeHeader (lOutputFile);
+
+  // Initialise the statistics collector/accumulator
+  stat_acc_type lStatAccumulator;
+
+  for (NbOfRuns_T runIdx = 1; runIdx <= iNbOfRuns; ++runIdx) {
+    // Draw the counts of the run. The service is reset at the end of
+    // the run.
+    const stdair::Count_T lNbOfRequests =
+      ioTrademgenService.generateArrivalCounts (lArrivalCountTable,
+                                                iDemandGenerationMethod,
+                                                iNbOfGenerationThreads);
+    lArrivalCountTable.write (lOutputFile, runIdx);
+
+    // Add the number of events to the statistics accumulator
+    lStatAccumulator (lNbOfRequests);
+  }
+
+  // DEBUG
+  STDAIR_LOG_DEBUG ("End of the demand counting. Following are some "
+                    "statistics for the " << iNbOfRuns << " runs.");
+  std::ostringstream oStatStr;
+  stat_display (oStatStr, lStatAccumulator);
+  STDAIR_LOG_DEBUG (oStatStr.str());
+
   // Close the output file
-  output.close();
+  lOutputFile.close();
 }
 
 
@@ -440,6 +723,9 @@ int main (int argc, char* argv[]) {
   // Input file name
   stdair::Filename_T lInputFilename;
 
+  // Compiled demand model file name (empty when the input file is parsed)
+  stdair::Filename_T lCompiledInputFilename;
+
   // Output file name
   stdair::Filename_T lOutputFilename;
 
@@ -450,11 +736,53 @@ int main (int argc, char* argv[]) {
   stdair::DemandGenerationMethod
     lDemandGenerationMethod (K_TRADEMGEN_DEFAULT_DEMAND_GENERATION_METHOD);
 
+  // Size and number of the blocks written into the output file
+  std::size_t lOutputBlockSize;
+  unsigned short lNbOfOutputBlocks;
+
+  // Name of the shared memory ring (empty when the requests are dumped
+  // into the output file), and number of its readers
+  std::string lSharedRingName;
+  unsigned short lNbOfSharedRingReaders;
+
+  // Number of shards (0 when the generation is not sharded), index of
+  // the shard generated by this process, and request shard file name
+  // (empty when the requests are not dumped into such a file)
+  unsigned short lNbOfShards;
+  unsigned short lShardIndex;
+  stdair::Filename_T lBinaryOutputFilename;
+
+  // Whether the requests are generated demand stream by demand stream,
+  // and number of threads generating them
+  bool isByStream;
+  unsigned int lNbOfGenerationThreads;
+
+  // Period (in minutes) over which the requests are aggregated (0 when
+  // they are not)
+  unsigned int lAggregationMinutes;
+
+  // Fields of the requests to be drawn (empty when all of them are drawn
+  // as usual)
+  std::string lRequestFields;
+
+  // Whether the requests are only counted, by bucket of days before
+  // departure (and by channel)
+  bool isCountOnly;
+  TRADEMGEN::ArrivalCountTable::DTDList_T lDTDBoundaryList;
+  bool isCountByChannel;
+
   // Call the command-line option parser
   const int lOptionParserStatus = 
     readConfiguration (argc, argv, isBuiltin, lRandomSeed, lNbOfRuns,
-                       lInputFilename, lOutputFilename, lLogFilename,
-                       lDemandGenerationMethod);
+                       lInputFilename, lCompiledInputFilename,
+                       lOutputFilename, lLogFilename,
+                       lDemandGenerationMethod, lOutputBlockSize,
+                       lNbOfOutputBlocks, lSharedRingName,
+                       lNbOfSharedRingReaders, lNbOfShards, lShardIndex,
+                       lBinaryOutputFilename, isByStream,
+                       lNbOfGenerationThreads, lAggregationMinutes,
+                       lRequestFields, isCountOnly, lDTDBoundaryList,
+                       isCountByChannel);
 
   if (lOptionParserStatus == K_TRADEMGEN_EARLY_RETURN_STATUS) {
     return 0;
@@ -477,15 +805,42 @@ int main (int argc, char* argv[]) {
     // Create a sample DemandStream object, and insert it within the BOM tree
     trademgenService.buildSampleBom();
 
+  } else if (lCompiledInputFilename.empty() == false) {
+    // Create the DemandStream objects from the compiled demand model
+    trademgenService.loadCompiledModel (lCompiledInputFilename);
+
   } else {
     // Create the DemandStream objects, and insert them within the BOM tree
     const TRADEMGEN::DemandFilePath lDemandFilePath (lInputFilename);
     trademgenService.parseAndLoad (lDemandFilePath);
   }  
 
+  // Only generate the demand streams of the shard, if any
+  if (lNbOfShards != 0) {
+    trademgenService.shardDemand (lShardIndex, lNbOfShards);
+  }
+
+  // Only draw the given fields of the requests, if any
+  if (lRequestFields.empty() == false) {
+    const TRADEMGEN::RequestFieldMask lRequestFieldMask (lRequestFields);
+    trademgenService.setRequestFieldMask (lRequestFieldMask);
+  }
+
+  // Only count the requests, if so asked
+  if (isCountOnly == true) {
+    generateArrivalCounts (trademgenService, lOutputFilename, lNbOfRuns,
+                           lDemandGenerationMethod, lDTDBoundaryList,
+                           isCountByChannel, lNbOfGenerationThreads);
+    logOutputFile.close();
+    return 0;
+  }
+
   // Calculate the expected number of events to be generated.
   generateDemand (trademgenService, lOutputFilename, lNbOfRuns,
-                  lDemandGenerationMethod);
+                  lDemandGenerationMethod, lOutputBlockSize, lNbOfOutputBlocks,
+                  lSharedRingName, lNbOfSharedRingReaders, lNbOfShards,
+                  lShardIndex, lBinaryOutputFilename, isByStream,
+                  lNbOfGenerationThreads, lAggregationMinutes);
 
   // Close the Log outputFile
   logOutputFile.close();
@@ -0,0 +1,219 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <iostream>
+#include <fstream>
+#include <memory>
+#include <vector>
+#include <string>
+//  //// Boost (Extended STL) ////
+// Boost Program Options
+#include <boost/program_options.hpp>
+// StdAir
+#include <stdair/stdair_basic_types.hpp>
+#include <stdair/basic/BasConst_General.hpp>
+#include <stdair/basic/BasLogParams.hpp>
+#include <stdair/service/Logger.hpp>
+// TraDemGen
+#include <trademgen/TRADEMGEN_Service.hpp>
+#include <trademgen/config/trademgen-paths.hpp>
+#include <trademgen/basic/BasConst_RequestOutput.hpp>
+#include <trademgen/command/RequestCsvWriter.hpp>
+#include <trademgen/command/RequestShardWriter.hpp>
+#include <trademgen/command/RequestShardMerger.hpp>
+
+// //////// Constants //////
+/**
+ * Default name and location for the log file.
+ */
+const stdair::Filename_T K_TRADEMGEN_DEFAULT_LOG_FILENAME ("trademgen_merge.log");
+
+/**
+ * Default name and location for the (CSV) output file.
+ */
+const stdair::Filename_T K_TRADEMGEN_DEFAULT_OUTPUT_FILENAME ("request.csv");
+
+/**
+ * Early return status (so that it can be differentiated from an error).
+ */
+const int K_TRADEMGEN_EARLY_RETURN_STATUS = 99;
+
+
+// ///////// Parsing of Options & Configuration /////////
+/**
+ * Read and parse the command line options.
+ */
+int readConfiguration (int argc, char* argv[],
+                       std::vector<stdair::Filename_T>& ioShardFilenameList,
+                       stdair::Filename_T& ioOutputFilename,
+                       stdair::Filename_T& ioBinaryOutputFilename,
+                       stdair::Filename_T& ioLogFilename) {
+
+  // Declare a group of options that will be allowed only on command line
+  boost::program_options::options_description generic ("Generic options");
+  generic.add_options()
+    ("prefix", "print installation prefix")
+    ("version,v", "print version string")
+    ("help,h", "produce help message");
+
+  // Declare a group of options that will be allowed both on command
+  // line and in config file
+  boost::program_options::options_description config ("Configuration");
+  config.add_options()
+    ("output,o",
+     boost::program_options::value< std::string >(&ioOutputFilename)->default_value(K_TRADEMGEN_DEFAULT_OUTPUT_FILENAME),
+     "(CSV) output file for the merged requests")
+    ("binary-output",
+     boost::program_options::value< std::string >(&ioBinaryOutputFilename),
+     "Request shard file (of a single shard) into which the merged requests are dumped, rather than into the (CSV) output file, so that it can be merged in turn")
+    ("log,l",
+     boost::program_options::value< std::string >(&ioLogFilename)->default_value(K_TRADEMGEN_DEFAULT_LOG_FILENAME),
+     "Filepath for the logs")
+    ;
+
+  // Hidden options, will be allowed only on command line, but will not
+  // be shown to the user.
+  boost::program_options::options_description hidden ("Hidden options");
+  hidden.add_options()
+    ("shard-file",
+     boost::program_options::value< std::vector<std::string> >(&ioShardFilenameList),
+     "Request shard files, as written by trademgen_generateDemand");
+
+  boost::program_options::options_description cmdline_options;
+  cmdline_options.add(generic).add(config).add(hidden);
+
+  boost::program_options::options_description config_file_options;
+  config_file_options.add(config);
+
+  boost::program_options::options_description visible ("Allowed options "
+                                                       "(followed by the "
+                                                       "request shard files)");
+  visible.add(generic).add(config);
+
+  boost::program_options::positional_options_description p;
+  p.add ("shard-file", -1);
+
+  boost::program_options::variables_map vm;
+  boost::program_options::
+    store (boost::program_options::command_line_parser (argc, argv).
+           options (cmdline_options).positional(p).run(), vm);
+
+  std::ifstream ifs ("trademgen.cfg");
+  boost::program_options::store (parse_config_file (ifs, config_file_options),
+                                 vm);
+  boost::program_options::notify (vm);
+
+  if (vm.count ("help")) {
+    std::cout << visible << std::endl;
+    return K_TRADEMGEN_EARLY_RETURN_STATUS;
+  }
+
+  if (vm.count ("version")) {
+    std::cout << PACKAGE_NAME << ", version " << PACKAGE_VERSION << std::endl;
+    return K_TRADEMGEN_EARLY_RETURN_STATUS;
+  }
+
+  if (vm.count ("prefix")) {
+    std::cout << "Installation prefix: " << PREFIXDIR << std::endl;
+    return K_TRADEMGEN_EARLY_RETURN_STATUS;
+  }
+
+  if (ioShardFilenameList.empty() == true) {
+    std::cerr << "The request shard files to be merged must be specified"
+              << std::endl;
+    return K_TRADEMGEN_EARLY_RETURN_STATUS;
+  }
+  std::cout << "Number of request shard files: " << ioShardFilenameList.size()
+            << std::endl;
+
+  if (vm.count ("binary-output")) {
+    ioBinaryOutputFilename = vm["binary-output"].as< std::string >();
+    std::cout << "Binary output (request shard) filename is: "
+              << ioBinaryOutputFilename << std::endl;
+
+  } else if (vm.count ("output")) {
+    ioOutputFilename = vm["output"].as< std::string >();
+    std::cout << "Output filename is: " << ioOutputFilename << std::endl;
+  }
+
+  if (vm.count ("log")) {
+    ioLogFilename = vm["log"].as< std::string >();
+    std::cout << "Log filename is: " << ioLogFilename << std::endl;
+  }
+
+  return 0;
+}
+
+
+// /////////////// M A I N /////////////////
+int main (int argc, char* argv[]) {
+
+  // Request shard files
+  std::vector<stdair::Filename_T> lShardFilenameList;
+
+  // Output file name
+  stdair::Filename_T lOutputFilename;
+
+  // Request shard file name (empty when the requests are dumped into
+  // the output file)
+  stdair::Filename_T lBinaryOutputFilename;
+
+  // Output log File
+  stdair::Filename_T lLogFilename;
+
+  // Call the command-line option parser
+  const int lOptionParserStatus =
+    readConfiguration (argc, argv, lShardFilenameList, lOutputFilename,
+                       lBinaryOutputFilename, lLogFilename);
+
+  if (lOptionParserStatus == K_TRADEMGEN_EARLY_RETURN_STATUS) {
+    return 0;
+  }
+
+  // Set the log parameters
+  std::ofstream logOutputFile;
+  // Open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str());
+  logOutputFile.clear();
+
+  // Set up the log parameters
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+
+  // Initialise the TraDemGen service object, so that the logs go into
+  // the log file (no demand is loaded)
+  TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams,
+                                                 stdair::DEFAULT_RANDOM_SEED);
+
+  // Merge the request shard files, either into a request shard file (of
+  // a single shard), or into the .csv output file
+  boost::uint64_t lNbOfMergedRequests = 0;
+  if (lBinaryOutputFilename.empty() == false) {
+    TRADEMGEN::RequestShardWriter lShardWriter (lBinaryOutputFilename, 0, 1);
+    lNbOfMergedRequests =
+      TRADEMGEN::RequestShardMerger::merge (lShardFilenameList, lShardWriter);
+    lShardWriter.close();
+
+  } else {
+    TRADEMGEN::RequestCsvWriter lCsvWriter (lOutputFilename);
+    lCsvWriter.writeHeader();
+    lNbOfMergedRequests =
+      TRADEMGEN::RequestShardMerger::merge (lShardFilenameList, lCsvWriter);
+    lCsvWriter.close();
+  }
+  std::cout << "Merged " << lNbOfMergedRequests << " booking requests"
+            << std::endl;
+
+  // Close the Log outputFile
+  logOutputFile.close();
+
+  /*
+    \note: as that program is not intended to be run on a server in
+    production, it is better not to catch the exceptions. When it
+    happens (that an exception is throwned), that way we get the
+    call stack.
+  */
+
+  return 0;
+}
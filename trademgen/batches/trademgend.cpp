@@ -0,0 +1,303 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+//  //// Boost (Extended STL) ////
+// Boost Program Options
+#include <boost/program_options.hpp>
+// StdAir
+#include <stdair/stdair_basic_types.hpp>
+#include <stdair/basic/BasConst_General.hpp>
+#include <stdair/basic/BasLogParams.hpp>
+#include <stdair/basic/DemandGenerationMethod.hpp>
+#include <stdair/service/Logger.hpp>
+// TraDemGen
+#include <trademgen/TRADEMGEN_Service.hpp>
+#include <trademgen/config/trademgen-paths.hpp>
+#include <trademgen/basic/BasConst_DemandGenerationServer.hpp>
+#include <trademgen/service/DemandGenerationServer.hpp>
+
+// //////// Constants //////
+/**
+ * Default name and location for the log file.
+ */
+const stdair::Filename_T K_TRADEMGEN_DEFAULT_LOG_FILENAME ("trademgend.log");
+
+/**
+ * Default name and location for the (CSV) input file.
+ */
+const stdair::Filename_T K_TRADEMGEN_DEFAULT_INPUT_FILENAME (STDAIR_SAMPLE_DIR
+                                                             "/demand01.csv");
+
+/**
+ * Default path of the Unix domain socket on which the server listens.
+ */
+const std::string K_TRADEMGEN_DEFAULT_SOCKET_PATH ("trademgend.sock");
+
+/**
+ * Default demand generation method: Poisson Process.
+ */
+const stdair::DemandGenerationMethod
+K_TRADEMGEN_DEFAULT_DEMAND_GENERATION_METHOD =
+  stdair::DemandGenerationMethod::POI_PRO;
+
+/**
+ * Default demand generation method name: 'P' for Poisson Process.
+ */
+const char K_TRADEMGEN_DEFAULT_DEMAND_GENERATION_METHOD_CHAR =
+  K_TRADEMGEN_DEFAULT_DEMAND_GENERATION_METHOD.getMethodAsChar();
+
+/**
+ * Default random generation seed (e.g., 120765987).
+ */
+const stdair::RandomSeed_T K_TRADEMGEN_DEFAULT_RANDOM_SEED =
+  stdair::DEFAULT_RANDOM_SEED;
+
+/**
+ * Default for the input type. It can be either built-in or provided by an
+ * input file. That latter must then be given with the -i option.
+ */
+const bool K_TRADEMGEN_DEFAULT_BUILT_IN_INPUT = false;
+
+/**
+ * Early return status (so that it can be differentiated from an error).
+ */
+const int K_TRADEMGEN_EARLY_RETURN_STATUS = 99;
+
+
+// ///////// Parsing of Options & Configuration /////////
+/**
+ * Read and parse the command line options.
+ */
+int readConfiguration (int argc, char* argv[], bool& ioIsBuiltin,
+                       stdair::RandomSeed_T& ioRandomSeed,
+                       stdair::Filename_T& ioInputFilename,
+                       stdair::Filename_T& ioCompiledInputFilename,
+                       std::string& ioSocketPath,
+                       std::size_t& ioNbOfRecordsPerFrame,
+                       stdair::Filename_T& ioLogFilename,
+                       stdair::DemandGenerationMethod& ioDemandGenerationMethod) {
+
+  // Demand generation method as a single char (e.g., 'P' or 'S').
+  char lDemandGenerationMethodChar;
+
+  // Default for the built-in input
+  ioIsBuiltin = K_TRADEMGEN_DEFAULT_BUILT_IN_INPUT;
+
+  // Declare a group of options that will be allowed only on command line
+  boost::program_options::options_description generic ("Generic options");
+  generic.add_options()
+    ("prefix", "print installation prefix")
+    ("version,v", "print version string")
+    ("help,h", "produce help message");
+
+  // Declare a group of options that will be allowed both on command
+  // line and in config file
+  boost::program_options::options_description config ("Configuration");
+  config.add_options()
+    ("builtin,b",
+     "The sample BOM tree can be either built-in or parsed from an input file. That latter must then be given with the -i/--input option")
+    ("seed,s",
+     boost::program_options::value<stdair::RandomSeed_T>(&ioRandomSeed)->default_value(K_TRADEMGEN_DEFAULT_RANDOM_SEED),
+     "Seed of the generation sessions giving none")
+    ("demandgeneration,G",
+     boost::program_options::value< char >(&lDemandGenerationMethodChar)->default_value(K_TRADEMGEN_DEFAULT_DEMAND_GENERATION_METHOD_CHAR),
+     "Method of the generation sessions giving none: Poisson Process (P) or Order Statistics (S)")
+    ("input,i",
+     boost::program_options::value< std::string >(&ioInputFilename)->default_value(K_TRADEMGEN_DEFAULT_INPUT_FILENAME),
+     "(CSV) input file for the demand distributions")
+    ("compiled-input,c",
+     boost::program_options::value< std::string >(&ioCompiledInputFilename),
+     "Compiled demand model (as written by trademgen_compileDemand), to be loaded instead of the (CSV) input file")
+    ("socket",
+     boost::program_options::value< std::string >(&ioSocketPath)->default_value(K_TRADEMGEN_DEFAULT_SOCKET_PATH),
+     "Path of the Unix domain socket on which the server listens")
+    ("frame-records",
+     boost::program_options::value<std::size_t>(&ioNbOfRecordsPerFrame)->default_value(TRADEMGEN::DEFAULT_NB_OF_RECORDS_PER_FRAME),
+     "Maximal number of request records sent in a single frame")
+    ("log,l",
+     boost::program_options::value< std::string >(&ioLogFilename)->default_value(K_TRADEMGEN_DEFAULT_LOG_FILENAME),
+     "Filepath for the logs")
+    ;
+
+  // Hidden options, will be allowed both on command line and
+  // in config file, but will not be shown to the user.
+  boost::program_options::options_description hidden ("Hidden options");
+  hidden.add_options()
+    ("copyright",
+     boost::program_options::value< std::vector<std::string> >(),
+     "Show the copyright (license)");
+
+  boost::program_options::options_description cmdline_options;
+  cmdline_options.add(generic).add(config).add(hidden);
+
+  boost::program_options::options_description config_file_options;
+  config_file_options.add(config).add(hidden);
+
+  boost::program_options::options_description visible ("Allowed options");
+  visible.add(generic).add(config);
+
+  boost::program_options::positional_options_description p;
+  p.add ("copyright", -1);
+
+  boost::program_options::variables_map vm;
+  boost::program_options::
+    store (boost::program_options::command_line_parser (argc, argv).
+           options (cmdline_options).positional(p).run(), vm);
+
+  std::ifstream ifs ("trademgen.cfg");
+  boost::program_options::store (parse_config_file (ifs, config_file_options),
+                                 vm);
+  boost::program_options::notify (vm);
+
+  if (vm.count ("help")) {
+    std::cout << visible << std::endl;
+    return K_TRADEMGEN_EARLY_RETURN_STATUS;
+  }
+
+  if (vm.count ("version")) {
+    std::cout << PACKAGE_NAME << ", version " << PACKAGE_VERSION << std::endl;
+    return K_TRADEMGEN_EARLY_RETURN_STATUS;
+  }
+
+  if (vm.count ("prefix")) {
+    std::cout << "Installation prefix: " << PREFIXDIR << std::endl;
+    return K_TRADEMGEN_EARLY_RETURN_STATUS;
+  }
+
+  if (vm.count ("builtin")) {
+    ioIsBuiltin = true;
+  }
+  const std::string isBuiltinStr = (ioIsBuiltin == true)?"yes":"no";
+  std::cout << "The BOM should be built-in? " << isBuiltinStr << std::endl;
+
+  if (ioIsBuiltin == false) {
+
+    // The BOM tree should be built from a compiled demand model, or from
+    // parsing a demand input file
+    if (vm.count ("compiled-input")) {
+      ioCompiledInputFilename = vm["compiled-input"].as< std::string >();
+      std::cout << "Compiled input filename is: " << ioCompiledInputFilename
+                << std::endl;
+
+    } else if (vm.count ("input")) {
+      ioInputFilename = vm["input"].as< std::string >();
+      std::cout << "Input filename is: " << ioInputFilename << std::endl;
+
+    } else {
+      // The built-in option is not selected. However, no demand input file
+      // is specified
+      std::cerr << "Either one among the -b/--builtin and -i/--input "
+                << "options must be specified" << std::endl;
+    }
+  }
+
+  if (vm.count ("socket")) {
+    ioSocketPath = vm["socket"].as< std::string >();
+    std::cout << "The server listens on: " << ioSocketPath << std::endl;
+  }
+
+  if (vm.count ("log")) {
+    ioLogFilename = vm["log"].as< std::string >();
+    std::cout << "Log filename is: " << ioLogFilename << std::endl;
+  }
+
+  if (vm.count ("demandgeneration")) {
+    ioDemandGenerationMethod =
+      stdair::DemandGenerationMethod (lDemandGenerationMethodChar);
+    std::cout << "Default date-time request generation method is: "
+              << ioDemandGenerationMethod.describe() << std::endl;
+  }
+
+  //
+  std::cout << "The default random generation seed is: " << ioRandomSeed
+            << std::endl;
+
+  return 0;
+}
+
+
+// /////////////// M A I N /////////////////
+int main (int argc, char* argv[]) {
+
+  // State whether the BOM tree should be built-in or parsed from an input file
+  bool isBuiltin;
+
+  // Default random generation seed of the sessions
+  stdair::RandomSeed_T lRandomSeed;
+
+  // Input file name
+  stdair::Filename_T lInputFilename;
+
+  // Compiled demand model file name (empty when the input file is parsed)
+  stdair::Filename_T lCompiledInputFilename;
+
+  // Path of the socket, and size of the frames
+  std::string lSocketPath;
+  std::size_t lNbOfRecordsPerFrame;
+
+  // Output log File
+  stdair::Filename_T lLogFilename;
+
+  // Default demand generation method of the sessions
+  stdair::DemandGenerationMethod
+    lDemandGenerationMethod (K_TRADEMGEN_DEFAULT_DEMAND_GENERATION_METHOD);
+
+  // Call the command-line option parser
+  const int lOptionParserStatus =
+    readConfiguration (argc, argv, isBuiltin, lRandomSeed, lInputFilename,
+                       lCompiledInputFilename, lSocketPath,
+                       lNbOfRecordsPerFrame, lLogFilename,
+                       lDemandGenerationMethod);
+
+  if (lOptionParserStatus == K_TRADEMGEN_EARLY_RETURN_STATUS) {
+    return 0;
+  }
+
+  // Set the log parameters
+  std::ofstream logOutputFile;
+  // Open and clean the log outputfile
+  logOutputFile.open (lLogFilename.c_str());
+  logOutputFile.clear();
+
+  // Set up the log parameters
+  const stdair::BasLogParams lLogParams (stdair::LOG::DEBUG, logOutputFile);
+
+  // Initialise the TraDemGen service object
+  TRADEMGEN::TRADEMGEN_Service trademgenService (lLogParams, lRandomSeed);
+
+  // Load the demand once for all the generation sessions
+  if (isBuiltin == true) {
+    trademgenService.buildSampleBom();
+
+  } else if (lCompiledInputFilename.empty() == false) {
+    trademgenService.loadCompiledModel (lCompiledInputFilename);
+
+  } else {
+    const TRADEMGEN::DemandFilePath lDemandFilePath (lInputFilename);
+    trademgenService.parseAndLoad (lDemandFilePath);
+  }
+
+  // Serve the generation sessions, until a client shuts the server down
+  {
+    TRADEMGEN::DemandGenerationServer lServer (trademgenService, lSocketPath,
+                                               lRandomSeed,
+                                               lDemandGenerationMethod,
+                                               lNbOfRecordsPerFrame);
+    std::cout << "Listening on '" << lServer.getSocketPath() << "'"
+              << std::endl;
+    lServer.run();
+    std::cout << "Shut down, after " << lServer.getNbOfSessions()
+              << " generation session(s)" << std::endl;
+  }
+
+  // Close the Log outputFile
+  logOutputFile.close();
+
+  return 0;
+}
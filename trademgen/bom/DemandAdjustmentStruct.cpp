@@ -0,0 +1,89 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <sstream>
+// TraDemGen
+#include <trademgen/basic/DemandDistribution.hpp>
+#include <trademgen/bom/DemandStreamKey.hpp>
+#include <trademgen/bom/DemandAdjustmentStruct.hpp>
+
+namespace TRADEMGEN {
+
+  // ////////////////////////////////////////////////////////////////////
+  DemandAdjustmentStruct::DemandAdjustmentStruct()
+    : _origin (""), _destination (""), _prefCabin (""),
+      _dateRange (stdair::Date_T (boost::gregorian::min_date_time),
+                  stdair::Date_T (boost::gregorian::max_date_time)),
+      _meanMultiplier (1.0), _meanIncrement (0.0),
+      _stdDevMultiplier (1.0), _stdDevIncrement (0.0) {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  DemandAdjustmentStruct::
+  DemandAdjustmentStruct (const DemandAdjustmentStruct& iAdjustment)
+    : _origin (iAdjustment._origin),
+      _destination (iAdjustment._destination),
+      _prefCabin (iAdjustment._prefCabin),
+      _dateRange (iAdjustment._dateRange),
+      _meanMultiplier (iAdjustment._meanMultiplier),
+      _meanIncrement (iAdjustment._meanIncrement),
+      _stdDevMultiplier (iAdjustment._stdDevMultiplier),
+      _stdDevIncrement (iAdjustment._stdDevIncrement) {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  DemandAdjustmentStruct::~DemandAdjustmentStruct() {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  bool DemandAdjustmentStruct::matches (const DemandStreamKey& iKey) const {
+    if (_origin.empty() == false && _origin != iKey.getOrigin()) {
+      return false;
+    }
+    if (_destination.empty() == false
+        && _destination != iKey.getDestination()) {
+      return false;
+    }
+    if (_prefCabin.empty() == false
+        && _prefCabin != iKey.getPreferredCabin()) {
+      return false;
+    }
+    return _dateRange.contains (iKey.getPreferredDepartureDate());
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  DemandDistribution DemandAdjustmentStruct::
+  adjust (const DemandDistribution& iDemandDistribution) const {
+    stdair::NbOfRequests_T lMean =
+      iDemandDistribution._meanNumberOfRequests * _meanMultiplier
+      + _meanIncrement;
+    // A zero mean switches the demand stream off, even with the Poisson
+    // process (which would otherwise draw with a zero rate)
+    if (lMean < 0.0) {
+      lMean = 0.0;
+    }
+
+    stdair::StdDevValue_T lStdDev =
+      iDemandDistribution._stdDevNumberOfRequests * _stdDevMultiplier
+      + _stdDevIncrement;
+    if (lStdDev < 0.0) {
+      lStdDev = 0.0;
+    }
+
+    return DemandDistribution (lMean, lStdDev);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const std::string DemandAdjustmentStruct::describe() const {
+    std::ostringstream oStr;
+    oStr << (_origin.empty()?"*":_origin) << "-"
+         << (_destination.empty()?"*":_destination) << " "
+         << (_prefCabin.empty()?"*":_prefCabin) << " " << _dateRange
+         << ": mean x " << _meanMultiplier << " + " << _meanIncrement
+         << ", std dev x " << _stdDevMultiplier << " + " << _stdDevIncrement;
+    return oStr.str();
+  }
+
+}
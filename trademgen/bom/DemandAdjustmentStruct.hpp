@@ -0,0 +1,93 @@
+#ifndef __TRADEMGEN_BOM_DEMANDADJUSTMENTSTRUCT_HPP
+#define __TRADEMGEN_BOM_DEMANDADJUSTMENTSTRUCT_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <string>
+#include <vector>
+// StdAir
+#include <stdair/stdair_basic_types.hpp>
+#include <stdair/stdair_maths_types.hpp>
+#include <stdair/stdair_date_time_types.hpp>
+#include <stdair/basic/StructAbstract.hpp>
+
+namespace TRADEMGEN {
+
+  // Forward declarations
+  struct DemandDistribution;
+  struct DemandStreamKey;
+
+  /**
+   * @brief Adjustment of the demand distribution (mean and standard
+   * deviation of the number of requests) of some demand streams, e.g.,
+   * for what-if studies ("+10% on SIN-BKK", "-20% in February").
+   *
+   * The demand streams are selected by their origin, destination,
+   * preferred cabin and preferred departure date; the default values
+   * select all the demand streams. The mean and the standard deviation
+   * of the selected demand streams become (value * multiplier +
+   * increment), bounded below by zero; the default values leave them
+   * unchanged. A demand stream the mean of which drops to zero is
+   * switched off: it generates no request, whatever the generation
+   * method (see DemandStream::stillHavingRequestsToBeGenerated()).
+   */
+  struct DemandAdjustmentStruct : public stdair::StructAbstract {
+
+  public:
+    // ////////////////// Business Methods ////////////////
+    /** State whether the given demand stream is selected. */
+    bool matches (const DemandStreamKey&) const;
+
+    /** Get the adjusted demand distribution. */
+    DemandDistribution adjust (const DemandDistribution&) const;
+
+
+  public:
+    // ////////////////// Display Support Methods ////////////////
+    /** Give a description of the structure (for display purposes). */
+    const std::string describe() const;
+
+
+  public:
+    // /////////////// Constructors and destructors ///////////////
+    /** Default constructor, selecting all the demand streams and
+        leaving them unchanged. */
+    DemandAdjustmentStruct();
+    /** Default copy constructor. */
+    DemandAdjustmentStruct (const DemandAdjustmentStruct&);
+    /** Destructor */
+    ~DemandAdjustmentStruct();
+
+
+  public:
+    // ////////////// Attributes ///////////////////
+    /** Origin of the selected demand streams (empty for any). */
+    stdair::AirportCode_T _origin;
+
+    /** Destination of the selected demand streams (empty for any). */
+    stdair::AirportCode_T _destination;
+
+    /** Preferred cabin of the selected demand streams (empty for any). */
+    stdair::CabinCode_T _prefCabin;
+
+    /** Preferred departure dates of the selected demand streams (the
+        end date being excluded, as for Boost date periods). */
+    stdair::DatePeriod_T _dateRange;
+
+    /** Multiplier and increment of the mean number of requests. */
+    stdair::RealNumber_T _meanMultiplier;
+    stdair::RealNumber_T _meanIncrement;
+
+    /** Multiplier and increment of the standard deviation of the
+        number of requests. */
+    stdair::RealNumber_T _stdDevMultiplier;
+    stdair::RealNumber_T _stdDevIncrement;
+  };
+
+  /** List of demand adjustments, applied in turn. */
+  typedef std::vector<DemandAdjustmentStruct> DemandAdjustmentList_T;
+
+}
+#endif // __TRADEMGEN_BOM_DEMANDADJUSTMENTSTRUCT_HPP
@@ -0,0 +1,131 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <sstream>
+// StdAir
+#include <stdair/basic/BasConst_General.hpp>
+// TraDemGen
+#include <trademgen/bom/DemandStreamKey.hpp>
+#include <trademgen/bom/DemandFilterStruct.hpp>
+
+namespace TRADEMGEN {
+
+  namespace {
+
+    /** All the Days-Of-the-Week. */
+    const unsigned short K_ALL_DAYS_OF_THE_WEEK_MASK = 0x7F;
+
+    // //////////////////////////////////////////////////////////////////
+    /**
+     * Display the given set of codes (a star for an empty one).
+     */
+    void displaySet (std::ostream& ioOut,
+                     const std::set<std::string>& iCodeSet) {
+      if (iCodeSet.empty() == true) {
+        ioOut << "*";
+        return;
+      }
+      for (std::set<std::string>::const_iterator itCode = iCodeSet.begin();
+           itCode != iCodeSet.end(); ++itCode) {
+        if (itCode != iCodeSet.begin()) {
+          ioOut << ",";
+        }
+        ioOut << *itCode;
+      }
+    }
+
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  DemandFilterStruct::DemandFilterStruct()
+    : _dateRange (stdair::Date_T (boost::gregorian::min_date_time),
+                  stdair::Date_T (boost::gregorian::max_date_time)),
+      _dowMask (K_ALL_DAYS_OF_THE_WEEK_MASK), _samplingRate (1.0),
+      _samplingSeed (stdair::DEFAULT_RANDOM_SEED) {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  DemandFilterStruct::DemandFilterStruct (const DemandFilterStruct& iFilter)
+    : _originSet (iFilter._originSet),
+      _destinationSet (iFilter._destinationSet),
+      _prefCabinSet (iFilter._prefCabinSet),
+      _dateRange (iFilter._dateRange),
+      _dowMask (iFilter._dowMask), _samplingRate (iFilter._samplingRate),
+      _samplingSeed (iFilter._samplingSeed) {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  DemandFilterStruct::~DemandFilterStruct() {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  bool DemandFilterStruct::
+  matchesMarket (const stdair::AirportCode_T& iOrigin,
+                 const stdair::AirportCode_T& iDestination,
+                 const stdair::CabinCode_T& iPrefCabin) const {
+    if (_originSet.empty() == false
+        && _originSet.find (iOrigin) == _originSet.end()) {
+      return false;
+    }
+    if (_destinationSet.empty() == false
+        && _destinationSet.find (iDestination) == _destinationSet.end()) {
+      return false;
+    }
+    if (_prefCabinSet.empty() == false
+        && _prefCabinSet.find (iPrefCabin) == _prefCabinSet.end()) {
+      return false;
+    }
+    return true;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  bool DemandFilterStruct::matchesDate (const stdair::Date_T& iDate) const {
+    if (_dateRange.contains (iDate) == false) {
+      return false;
+    }
+    const unsigned short lDoW = iDate.day_of_week().as_number();
+    return ((_dowMask & (1U << lDoW)) != 0);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  bool DemandFilterStruct::matches (const DemandStreamKey& iKey) const {
+    return (matchesMarket (iKey.getOrigin(), iKey.getDestination(),
+                           iKey.getPreferredCabin()) == true
+            && matchesDate (iKey.getPreferredDepartureDate()) == true);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  bool DemandFilterStruct::isSampled() const {
+    return (_samplingRate < 1.0);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  bool DemandFilterStruct::selectsAll() const {
+    return (_originSet.empty() == true && _destinationSet.empty() == true
+            && _prefCabinSet.empty() == true
+            && _dateRange.begin()
+            == stdair::Date_T (boost::gregorian::min_date_time)
+            && _dateRange.end()
+            == stdair::Date_T (boost::gregorian::max_date_time)
+            && _dowMask == K_ALL_DAYS_OF_THE_WEEK_MASK
+            && isSampled() == false);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const std::string DemandFilterStruct::describe() const {
+    std::ostringstream oStr;
+    displaySet (oStr, _originSet);
+    oStr << "-";
+    displaySet (oStr, _destinationSet);
+    oStr << " ";
+    displaySet (oStr, _prefCabinSet);
+    oStr << " " << _dateRange << " DoW mask " << _dowMask;
+    if (isSampled() == true) {
+      oStr << ", sampling rate " << _samplingRate << " (seed "
+           << _samplingSeed << ")";
+    }
+    return oStr.str();
+  }
+
+}
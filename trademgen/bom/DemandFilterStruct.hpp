@@ -0,0 +1,111 @@
+#ifndef __TRADEMGEN_BOM_DEMANDFILTERSTRUCT_HPP
+#define __TRADEMGEN_BOM_DEMANDFILTERSTRUCT_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <set>
+#include <string>
+// StdAir
+#include <stdair/stdair_basic_types.hpp>
+#include <stdair/stdair_date_time_types.hpp>
+#include <stdair/stdair_maths_types.hpp>
+#include <stdair/basic/StructAbstract.hpp>
+
+namespace TRADEMGEN {
+
+  // Forward declarations
+  struct DemandStreamKey;
+
+  /**
+   * @brief Selection of the demand streams to be loaded, e.g., when only
+   * a handful of markets, or a single month of departures, is studied
+   * out of a global demand input file.
+   *
+   * The demand streams are selected by their origin, destination,
+   * preferred cabin, preferred departure date and Day-Of-the-Week
+   * thereof; the default values select all the demand streams. The
+   * demand streams which are not selected are not created at all (see
+   * TRADEMGEN_Service::setDemandFilter()).
+   *
+   * For quick estimates, the selected demand streams may moreover be
+   * sampled, stratum by stratum, a stratum gathering the demand streams
+   * of a given origin and destination, the preferred departure dates of
+   * which lie within a given month (whatever the preferred cabin).
+   */
+  struct DemandFilterStruct : public stdair::StructAbstract {
+
+  public:
+    // ////////////////// Business Methods ////////////////
+    /** State whether the demand streams of the given origin,
+        destination and preferred cabin may be selected, whatever
+        their preferred departure date. */
+    bool matchesMarket (const stdair::AirportCode_T& iOrigin,
+                        const stdair::AirportCode_T& iDestination,
+                        const stdair::CabinCode_T& iPrefCabin) const;
+
+    /** State whether the demand streams of the given preferred
+        departure date may be selected, whatever their market. */
+    bool matchesDate (const stdair::Date_T&) const;
+
+    /** State whether the given demand stream is selected. */
+    bool matches (const DemandStreamKey&) const;
+
+    /** State whether the selected demand streams are sampled. */
+    bool isSampled() const;
+
+    /** State whether all the demand streams are selected, and none of
+        them is left out of the sample, i.e., whether the filter is the
+        default one. */
+    bool selectsAll() const;
+
+
+  public:
+    // ////////////////// Display Support Methods ////////////////
+    /** Give a description of the structure (for display purposes). */
+    const std::string describe() const;
+
+
+  public:
+    // /////////////// Constructors and destructors ///////////////
+    /** Default constructor, selecting all the demand streams. */
+    DemandFilterStruct();
+    /** Default copy constructor. */
+    DemandFilterStruct (const DemandFilterStruct&);
+    /** Destructor */
+    ~DemandFilterStruct();
+
+
+  public:
+    // ////////////// Attributes ///////////////////
+    /** Origins of the selected demand streams (empty for any). */
+    std::set<stdair::AirportCode_T> _originSet;
+
+    /** Destinations of the selected demand streams (empty for any). */
+    std::set<stdair::AirportCode_T> _destinationSet;
+
+    /** Preferred cabins of the selected demand streams (empty for
+        any). */
+    std::set<stdair::CabinCode_T> _prefCabinSet;
+
+    /** Preferred departure dates of the selected demand streams (the
+        end date being excluded, as for Boost date periods). */
+    stdair::DatePeriod_T _dateRange;
+
+    /** Days-Of-the-Week of the preferred departure dates of the
+        selected demand streams, one bit per day, following the Boost
+        numbering (bit 0 for Sunday, bit 6 for Saturday). */
+    unsigned short _dowMask;
+
+    /** Fraction of the demand streams of every stratum to be sampled,
+        at least one demand stream being sampled per stratum (one, by
+        default, for no sampling). */
+    double _samplingRate;
+
+    /** Seed of the sampling of the demand streams. */
+    stdair::RandomSeed_T _samplingSeed;
+  };
+
+}
+#endif // __TRADEMGEN_BOM_DEMANDFILTERSTRUCT_HPP
@@ -0,0 +1,49 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <sstream>
+// TraDemGen
+#include <trademgen/bom/DemandScenarioStruct.hpp>
+
+namespace TRADEMGEN {
+
+  // ////////////////////////////////////////////////////////////////////
+  DemandScenarioStruct::
+  DemandScenarioStruct (const stdair::RandomSeed_T& iRandomSeed,
+                        RequestSink* ioRequestSink_ptr,
+                        const stdair::RealNumber_T iDemandMultiplier)
+    : _randomSeed (iRandomSeed), _requestSink (ioRequestSink_ptr) {
+    if (iDemandMultiplier != 1.0) {
+      DemandAdjustmentStruct lAdjustment;
+      lAdjustment._meanMultiplier = iDemandMultiplier;
+      _adjustmentList.push_back (lAdjustment);
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  DemandScenarioStruct::
+  DemandScenarioStruct (const DemandScenarioStruct& iScenario)
+    : _randomSeed (iScenario._randomSeed),
+      _requestSink (iScenario._requestSink),
+      _adjustmentList (iScenario._adjustmentList) {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  DemandScenarioStruct::~DemandScenarioStruct() {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const std::string DemandScenarioStruct::describe() const {
+    std::ostringstream oStr;
+    oStr << "Seed: " << _randomSeed;
+    for (DemandAdjustmentList_T::const_iterator itAdjustment =
+           _adjustmentList.begin();
+         itAdjustment != _adjustmentList.end(); ++itAdjustment) {
+      oStr << "; " << itAdjustment->describe();
+    }
+    return oStr.str();
+  }
+
+}
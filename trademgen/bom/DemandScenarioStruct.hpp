@@ -0,0 +1,78 @@
+#ifndef __TRADEMGEN_BOM_DEMANDSCENARIOSTRUCT_HPP
+#define __TRADEMGEN_BOM_DEMANDSCENARIOSTRUCT_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <string>
+#include <vector>
+// StdAir
+#include <stdair/stdair_basic_types.hpp>
+#include <stdair/stdair_maths_types.hpp>
+#include <stdair/basic/StructAbstract.hpp>
+// TraDemGen
+#include <trademgen/bom/DemandAdjustmentStruct.hpp>
+
+namespace TRADEMGEN {
+
+  // Forward declarations
+  class RequestSink;
+
+  /**
+   * @brief Scenario of a multi-scenario demand generation (see
+   * TRADEMGEN_Service::generateScenarios()).
+   *
+   * A scenario is made of adjustments of the demand distributions (on
+   * top of the ones of the demand input file), of a random seed and of
+   * the sink receiving the booking requests generated for that
+   * scenario.
+   */
+  struct DemandScenarioStruct : public stdair::StructAbstract {
+
+  public:
+    // ////////////////// Display Support Methods ////////////////
+    /** Give a description of the structure (for display purposes). */
+    const std::string describe() const;
+
+
+  public:
+    // /////////////// Constructors and destructors ///////////////
+    /**
+     * Constructor.
+     *
+     * @param const stdair::RandomSeed_T& Seed of the random generation.
+     * @param RequestSink* Sink receiving the generated booking requests
+     *        (NULL for the requests to be discarded). It is not owned.
+     * @param const stdair::RealNumber_T Multiplier of the mean number of
+     *        requests of all the demand streams.
+     */
+    DemandScenarioStruct (const stdair::RandomSeed_T&, RequestSink*,
+                          const stdair::RealNumber_T iDemandMultiplier = 1.0);
+    /** Default copy constructor. */
+    DemandScenarioStruct (const DemandScenarioStruct&);
+    /** Destructor */
+    ~DemandScenarioStruct();
+  private:
+    /** Default constructor (not to be used). */
+    DemandScenarioStruct();
+
+
+  public:
+    // ////////////// Attributes ///////////////////
+    /** Seed of the random generation of the scenario. */
+    stdair::RandomSeed_T _randomSeed;
+
+    /** Sink receiving the generated booking requests (not owned). */
+    RequestSink* _requestSink;
+
+    /** Adjustments of the demand distributions, applied in turn to the
+        demand distributions given by the demand input file. */
+    DemandAdjustmentList_T _adjustmentList;
+  };
+
+  /** List of demand scenarios. */
+  typedef std::vector<DemandScenarioStruct> DemandScenarioList_T;
+
+}
+#endif // __TRADEMGEN_BOM_DEMANDSCENARIOSTRUCT_HPP
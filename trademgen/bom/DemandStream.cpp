@@ -2,12 +2,16 @@
 // Import section
 // //////////////////////////////////////////////////////////////////////
 // STL
+#include <algorithm>
 #include <cassert>
 #include <sstream>
 #include <cmath>
 #include <iomanip>
 // Boost
+#include <boost/cstdint.hpp>
 #include <boost/make_shared.hpp>
+#include <boost/random/binomial_distribution.hpp>
+#include <boost/random/poisson_distribution.hpp>
 // StdAir
 #include <stdair/basic/BasConst_General.hpp>
 #include <stdair/basic/BasConst_Inventory.hpp>
@@ -20,6 +24,70 @@
 
 namespace TRADEMGEN {
 
+  namespace {
+
+    /**
+     * Sub-streams of the characteristics which are always drawn, when
+     * the fields of the booking requests are projected (see
+     * DemandStream::drawVariate()), beyond the ones of the fields.
+     */
+    const unsigned int K_CABIN_SUB_STREAM = RequestFieldMask::LAST_VALUE;
+    const unsigned int K_PREFERRED_DEPARTURE_TIME_SUB_STREAM =
+      RequestFieldMask::LAST_VALUE << 1;
+
+    // //////////////////////////////////////////////////////////////////
+    /**
+     * Mix the bits of the given number (finaliser of SplitMix64).
+     */
+    boost::uint64_t mixBits (boost::uint64_t iBits) {
+      iBits += 0x9E3779B97F4A7C15ULL;
+      iBits = (iBits ^ (iBits >> 30)) * 0xBF58476D1CE4E5B9ULL;
+      iBits = (iBits ^ (iBits >> 27)) * 0x94D049BB133111EBULL;
+      return iBits ^ (iBits >> 31);
+    }
+
+    // //////////////////////////////////////////////////////////////////
+    /**
+     * Split the given number of draws among outcomes of the given
+     * probabilities (multinomial distribution), with a binomial draw per
+     * outcome, conditioned on the draws left by the previous outcomes.
+     */
+    std::vector<stdair::Count_T>
+    drawMultinomial (const stdair::Count_T iNbOfDraws,
+                     const std::vector<stdair::Probability_T>& iProbabilityList,
+                     stdair::BaseGenerator_T& ioGenerator) {
+      std::vector<stdair::Count_T> oCountList (iProbabilityList.size(), 0);
+      stdair::Count_T lRemainingNbOfDraws = iNbOfDraws;
+      stdair::Probability_T lRemainingProbability = 0.0;
+      for (std::size_t idx = 0; idx != iProbabilityList.size(); ++idx) {
+        lRemainingProbability += iProbabilityList[idx];
+      }
+
+      for (std::size_t idx = 0;
+           idx != oCountList.size() && lRemainingNbOfDraws > 0; ++idx) {
+        const stdair::Probability_T& lProbability = iProbabilityList[idx];
+
+        // The last outcome takes whatever the rounding errors leave
+        if (idx + 1 == oCountList.size()
+            || lProbability >= lRemainingProbability) {
+          oCountList[idx] = lRemainingNbOfDraws;
+          break;
+        }
+
+        if (lProbability > 0.0) {
+          boost::random::binomial_distribution<stdair::Count_T>
+            lBinomial (lRemainingNbOfDraws,
+                       lProbability / lRemainingProbability);
+          oCountList[idx] = lBinomial (ioGenerator);
+        }
+        lRemainingNbOfDraws -= oCountList[idx];
+        lRemainingProbability -= lProbability;
+      }
+      return oCountList;
+    }
+
+  }
+
   // ////////////////////////////////////////////////////////////////////
   DemandStream::DemandStream()
     : _key (stdair::DEFAULT_ORIGIN, stdair::DEFAULT_DESTINATION,
@@ -36,7 +104,10 @@ namespace TRADEMGEN {
                               0.0,
                               ValueOfTimeContinuousDistribution_T()),
       _posProMass (DEFAULT_POS_PROBALILITY_MASS),
-      _firstDateTimeRequest (true) {
+      _firstDateTimeRequest (true), _isDirty (true), _isSharded (false),
+      _isInShard (true), _isFiltered (false), _isQuiet (false),
+      _samplingWeight (1.0),
+      _demandCharacteristicsSeed (0), _runNumber (0), _isProjected (false) {
     assert (false);
   }
 
@@ -56,13 +127,19 @@ namespace TRADEMGEN {
                               0.0,
                               ValueOfTimeContinuousDistribution_T()),
       _posProMass (DEFAULT_POS_PROBALILITY_MASS),
-      _firstDateTimeRequest (true) {
+      _firstDateTimeRequest (true), _isDirty (true), _isSharded (false),
+      _isInShard (true), _isFiltered (false), _isQuiet (false),
+      _samplingWeight (1.0),
+      _demandCharacteristicsSeed (0), _runNumber (0), _isProjected (false) {
     assert (false);
   }
 
   // ////////////////////////////////////////////////////////////////////
   DemandStream::DemandStream (const Key_T& iKey) :
-    _key (iKey) {
+    _key (iKey), _isDirty (true), _isSharded (false), _isInShard (true),
+    _isFiltered (false), _isQuiet (false), _samplingWeight (1.0),
+    _demandCharacteristicsSeed (0), _runNumber (0),
+    _isProjected (false) {
   }
 
   // ////////////////////////////////////////////////////////////////////
@@ -97,6 +174,43 @@ namespace TRADEMGEN {
           const stdair::RandomSeed_T& iDemandCharacteristicsSeed,
           const POSProbabilityMass_T& iDefaultPOSProbablityMass) {
 
+    // Draw the total number of requests to be generated
+    const stdair::NbOfRequests_T lTotalNumberOfRequests =
+      drawTotalNumberOfRequests (iDemandDistribution, ioSharedGenerator);
+
+    setAll (iArrivalPattern, iPOSProbMass,
+            iChannelProbMass, iTripTypeProbMass,
+            iStayDurationProbMass, iFrequentFlyerProbMass,
+            iChangeFeeProb, iChangeFeeDisutility,
+            iNonRefundableProb, iNonRefundableDisutility,
+            iPreferredDepartureTimeContinuousDistribution,
+            iMinWTP, iValueOfTimeContinuousDistribution,
+            iDemandDistribution, lTotalNumberOfRequests,
+            iRequestDateTimeSeed, iDemandCharacteristicsSeed,
+            iDefaultPOSProbablityMass);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void DemandStream::
+  setAll (const ArrivalPatternCumulativeDistribution_T& iArrivalPattern,
+          const POSProbabilityMassFunction_T& iPOSProbMass,
+          const ChannelProbabilityMassFunction_T& iChannelProbMass,
+          const TripTypeProbabilityMassFunction_T& iTripTypeProbMass,
+          const StayDurationProbabilityMassFunction_T& iStayDurationProbMass,
+          const FrequentFlyerProbabilityMassFunction_T& iFrequentFlyerProbMass,
+          const stdair::ChangeFeesRatio_T& iChangeFeeProb,
+          const stdair::Disutility_T& iChangeFeeDisutility,
+          const stdair::NonRefundableRatio_T& iNonRefundableProb,
+          const stdair::Disutility_T& iNonRefundableDisutility,
+          const PreferredDepartureTimeContinuousDistribution_T& iPreferredDepartureTimeContinuousDistribution,
+          const stdair::WTP_T& iMinWTP,
+          const ValueOfTimeContinuousDistribution_T& iValueOfTimeContinuousDistribution,
+          const DemandDistribution& iDemandDistribution,
+          const stdair::NbOfRequests_T& iTotalNumberOfRequests,
+          const stdair::RandomSeed_T& iRequestDateTimeSeed,
+          const stdair::RandomSeed_T& iDemandCharacteristicsSeed,
+          const POSProbabilityMass_T& iDefaultPOSProbablityMass) {
+
     setDemandCharacteristics (iArrivalPattern, iPOSProbMass,
                               iChannelProbMass, iTripTypeProbMass,
                               iStayDurationProbMass, iFrequentFlyerProbMass,
@@ -112,7 +226,27 @@ namespace TRADEMGEN {
     setPOSProbabilityMass (iDefaultPOSProbablityMass);
 
     //
-    init (ioSharedGenerator);
+    init (iTotalNumberOfRequests);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void DemandStream::
+  setAll (const DemandCharacteristics& iDemandCharacteristics,
+          const DemandDistribution& iDemandDistribution,
+          const stdair::NbOfRequests_T& iTotalNumberOfRequests,
+          const stdair::RandomSeed_T& iRequestDateTimeSeed,
+          const stdair::RandomSeed_T& iDemandCharacteristicsSeed,
+          const POSProbabilityMass_T& iDefaultPOSProbablityMass) {
+
+    setDemandCharacteristics (iDemandCharacteristics);
+    setDemandDistribution (iDemandDistribution);
+    setTotalNumberOfRequestsToBeGenerated (0);
+    setRequestDateTimeRandomGeneratorSeed (iRequestDateTimeSeed);
+    setDemandCharacteristicsRandomGeneratorSeed (iDemandCharacteristicsSeed);
+    setPOSProbabilityMass (iDefaultPOSProbablityMass);
+
+    //
+    init (iTotalNumberOfRequests);
   }
 
   // ////////////////////////////////////////////////////////////////////
@@ -123,6 +257,13 @@ namespace TRADEMGEN {
 
     //
     oStr << _demandCharacteristics.describe();
+    for (CabinDemandList_T::const_iterator itCabinDemand =
+           _cabinDemandList.begin();
+         itCabinDemand != _cabinDemandList.end(); ++itCabinDemand) {
+      oStr << "Cabin " << itCabinDemand->_cabinCode << " (cumulative "
+           << "probability " << itCabinDemand->_cumulativeProbability
+           << "): " << itCabinDemand->_demandCharacteristics.describe();
+    }
 
     //
     oStr << _demandDistribution.describe() << " => "
@@ -146,12 +287,14 @@ namespace TRADEMGEN {
   }    
 
   // ////////////////////////////////////////////////////////////////////
-  void DemandStream::init (stdair::BaseGenerator_T& ioSharedGenerator) {
-    
+  stdair::NbOfRequests_T DemandStream::
+  drawTotalNumberOfRequests (const DemandDistribution& iDemandDistribution,
+                             stdair::BaseGenerator_T& ioSharedGenerator) {
+
     // Generate the number of requests
-    const stdair::RealNumber_T lMu = _demandDistribution._meanNumberOfRequests;
+    const stdair::RealNumber_T lMu = iDemandDistribution._meanNumberOfRequests;
     const stdair::RealNumber_T lSigma =
-      _demandDistribution._stdDevNumberOfRequests;
+      iDemandDistribution._stdDevNumberOfRequests;
 
     stdair::NormalDistribution_T lDistrib (lMu, lSigma);
     stdair::NormalGenerator_T lNormalGen (ioSharedGenerator, lDistrib);
@@ -161,15 +304,33 @@ namespace TRADEMGEN {
     const stdair::NbOfRequests_T lIntegerNumberOfRequestsToBeGenerated = 
       std::floor (lRealNumberOfRequestsToBeGenerated + 0.5);
     
-    _totalNumberOfRequestsToBeGenerated = lIntegerNumberOfRequestsToBeGenerated;
+    return lIntegerNumberOfRequestsToBeGenerated;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void DemandStream::init (stdair::BaseGenerator_T& ioSharedGenerator) {
+    init (drawTotalNumberOfRequests (_demandDistribution, ioSharedGenerator));
+  }  
+
+  // ////////////////////////////////////////////////////////////////////
+  void DemandStream::
+  init (const stdair::NbOfRequests_T& iTotalNumberOfRequests) {
+    _totalNumberOfRequestsToBeGenerated = iTotalNumberOfRequests;
 
     _stillHavingRequestsToBeGenerated = true;
     _firstDateTimeRequest = true;
+    _pendingRequest.reset();
+    _isDirty = true;
   }  
 
   // ////////////////////////////////////////////////////////////////////
   const bool DemandStream::
   stillHavingRequestsToBeGenerated (const stdair::DemandGenerationMethod& iDemandGenerationMethod) const {
+
+    // Out of the shard of the current process, nothing is generated
+    if (_isInShard == false) {
+      return false;
+    }
     
     const stdair::DemandGenerationMethod::EN_DemandGenerationMethod& lENDemandGenerationMethod =
       iDemandGenerationMethod.getMethod();
@@ -189,7 +350,10 @@ namespace TRADEMGEN {
       
       return hasStillHavingRequestsToBeGenerated;
     } else {
-      return _stillHavingRequestsToBeGenerated;
+      // Without any expected request (e.g., for a removed demand), the
+      // rate of the Poisson process is zero: no request is generated
+      return (_stillHavingRequestsToBeGenerated == true
+              && _demandDistribution._meanNumberOfRequests > 0.0);
     }
   }
 
@@ -281,7 +445,9 @@ namespace TRADEMGEN {
       incrementGeneratedRequestsCounter();
 
       const double lRefDateTimeThisRequest = lDateTimeThisRequest + double(28800.001/86400.0);
-      STDAIR_LOG_NOTIFICATION (boost::gregorian::to_iso_string(_key.getPreferredDepartureDate()) << ";" << std::setprecision(10) << lRefDateTimeThisRequest);
+      if (_isQuiet == false) {
+        STDAIR_LOG_NOTIFICATION (boost::gregorian::to_iso_string(_key.getPreferredDepartureDate()) << ";" << std::setprecision(10) << lRefDateTimeThisRequest);
+      }
     } else {
       
       // The current request is not in the given daily rate interval.
@@ -390,7 +556,9 @@ namespace TRADEMGEN {
     // NOTIFICATION
     double lRefNumberOfDaysBetweenDepartureAndThisRequest =
       lNumberOfDaysBetweenDepartureAndThisRequest + double(1.0/3.0);
-    STDAIR_LOG_NOTIFICATION (boost::gregorian::to_iso_string(_key.getPreferredDepartureDate()) << ";" << std::setprecision(10) << lRefNumberOfDaysBetweenDepartureAndThisRequest);
+    if (_isQuiet == false) {
+      STDAIR_LOG_NOTIFICATION (boost::gregorian::to_iso_string(_key.getPreferredDepartureDate()) << ";" << std::setprecision(10) << lRefNumberOfDaysBetweenDepartureAndThisRequest);
+    }
     
     return oDateTimeThisRequest;
   }
@@ -427,79 +595,141 @@ namespace TRADEMGEN {
   }
 
   // ////////////////////////////////////////////////////////////////////
-  const stdair::AirportCode_T DemandStream::generatePOS() {
+  void DemandStream::
+  setRequestFieldMask (const bool iIsProjected,
+                       const RequestFieldMask& iRequestFieldMask) {
+    _isProjected = iIsProjected;
+    _requestFieldMask = iRequestFieldMask;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  bool DemandStream::
+  isGenerated (const RequestFieldMask::EN_RequestField iField) const {
+    return (_isProjected == false
+            || _requestFieldMask.isGenerated (iField) == true);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  stdair::Probability_T DemandStream::
+  drawVariate (const unsigned int iSubStream) {
+    if (_isProjected == false) {
+      return _demandCharacteristicsRandomGenerator();
+    }
+
+    // The variate only depends on the seed, on the run, on the sub-stream
+    // and on the rank of the booking request within the demand stream,
+    // whatever has been drawn before. The 53 upper bits give a number
+    // within (0, 1), excluding 0 so that its logarithm may be taken.
+    const boost::uint64_t lRequestRank = static_cast<boost::uint64_t>
+      (_randomGenerationContext.getNumberOfRequestsGeneratedSoFar());
+    const boost::uint64_t lRunSeed =
+      mixBits (mixBits (_demandCharacteristicsSeed) ^ _runNumber);
+    const boost::uint64_t lBits =
+      mixBits (mixBits (lRunSeed ^ iSubStream) ^ lRequestRank);
+    return (static_cast<double> (lBits >> 11) + 0.5) / 9007199254740992.0;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const DemandStream::CabinDemand& DemandStream::generateCabinDemand() {
+    assert (_cabinDemandList.empty() == false);
+
+    // Generate a random number between 0 and 1.
+    const stdair::Probability_T lVariate = drawVariate (K_CABIN_SUB_STREAM);
+
+    // The last cabin takes whatever the rounding errors leave
+    for (CabinDemandList_T::const_iterator itCabinDemand =
+           _cabinDemandList.begin();
+         itCabinDemand != _cabinDemandList.end(); ++itCabinDemand) {
+      if (lVariate < itCabinDemand->_cumulativeProbability) {
+        return *itCabinDemand;
+      }
+    }
+    return _cabinDemandList.back();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const stdair::AirportCode_T DemandStream::
+  generatePOS (const DemandCharacteristics& iDemandCharacteristics) {
     
     // Generate a random number between 0 and 1.
-    const stdair::Probability_T& lVariate = _demandCharacteristicsRandomGenerator();
-    const stdair::AirportCode_T& oPOS = _demandCharacteristics.getPOSValue (lVariate);
+    const stdair::Probability_T lVariate = drawVariate (RequestFieldMask::POS);
+    const stdair::AirportCode_T& oPOS =
+      iDemandCharacteristics.getPOSValue (lVariate);
 
     return oPOS;
   }
 
   // ////////////////////////////////////////////////////////////////////
-  const stdair::ChannelLabel_T DemandStream::generateChannel() {
+  const stdair::ChannelLabel_T DemandStream::
+  generateChannel (const DemandCharacteristics& iDemandCharacteristics) {
     // Generate a random number between 0 and 1.
     const stdair::Probability_T lVariate =
-      _demandCharacteristicsRandomGenerator();
+      drawVariate (RequestFieldMask::CHANNEL);
 
-    return _demandCharacteristics._channelProbabilityMass.getValue (lVariate);
+    return iDemandCharacteristics._channelProbabilityMass.getValue (lVariate);
   }
 
   // ////////////////////////////////////////////////////////////////////
-  const stdair::TripType_T DemandStream::generateTripType() {
+  const stdair::TripType_T DemandStream::
+  generateTripType (const DemandCharacteristics& iDemandCharacteristics) {
     // Generate a random number between 0 and 1.
     const stdair::Probability_T lVariate =
-      _demandCharacteristicsRandomGenerator(); 
+      drawVariate (RequestFieldMask::TRIP_TYPE);
 
-    return _demandCharacteristics._tripTypeProbabilityMass.getValue (lVariate);
+    return iDemandCharacteristics._tripTypeProbabilityMass.getValue (lVariate);
   }
 
   // ////////////////////////////////////////////////////////////////////
-  const stdair::DayDuration_T DemandStream::generateStayDuration() {
+  const stdair::DayDuration_T DemandStream::
+  generateStayDuration (const DemandCharacteristics& iDemandCharacteristics) {
     // Generate a random number between 0 and 1.
     const stdair::Probability_T lVariate =
-      _demandCharacteristicsRandomGenerator();    
+      drawVariate (RequestFieldMask::STAY_DURATION);
 
-    return _demandCharacteristics._stayDurationProbabilityMass.getValue (lVariate);
+    return iDemandCharacteristics._stayDurationProbabilityMass.getValue (lVariate);
   }
   
   // ////////////////////////////////////////////////////////////////////
-  const stdair::FrequentFlyer_T DemandStream::generateFrequentFlyer() {
+  const stdair::FrequentFlyer_T DemandStream::
+  generateFrequentFlyer (const DemandCharacteristics& iDemandCharacteristics) {
     // Generate a random number between 0 and 1.
     const stdair::Probability_T lVariate =
-      _demandCharacteristicsRandomGenerator();       
+      drawVariate (RequestFieldMask::FREQUENT_FLYER);
 
-    return _demandCharacteristics._frequentFlyerProbabilityMass.getValue (lVariate);
+    return iDemandCharacteristics._frequentFlyerProbabilityMass.getValue (lVariate);
   }
   
   // ////////////////////////////////////////////////////////////////////
-  const stdair::ChangeFees_T DemandStream::generateChangeFees() {
+  const stdair::ChangeFees_T DemandStream::
+  generateChangeFees (const DemandCharacteristics& iDemandCharacteristics) {
     // Generate a random number between 0 and 1.
     const stdair::Probability_T lVariate =
-      _demandCharacteristicsRandomGenerator();
-    if (lVariate < _demandCharacteristics._changeFeeProb) {
+      drawVariate (RequestFieldMask::CHANGE_FEES);
+    if (lVariate < iDemandCharacteristics._changeFeeProb) {
       return true;
     }
     return false;    
   }
   
   // ////////////////////////////////////////////////////////////////////
-  const stdair::NonRefundable_T DemandStream::generateNonRefundable() {
+  const stdair::NonRefundable_T DemandStream::
+  generateNonRefundable (const DemandCharacteristics& iDemandCharacteristics) {
     // Generate a random number between 0 and 1.
     const stdair::Probability_T lVariate =
-      _demandCharacteristicsRandomGenerator();
-    if (lVariate < _demandCharacteristics._nonRefundableProb) {
+      drawVariate (RequestFieldMask::NON_REFUNDABLE);
+    if (lVariate < iDemandCharacteristics._nonRefundableProb) {
       return true;
     }
     return false;    
   }
 
   // ////////////////////////////////////////////////////////////////////
-  const stdair::Duration_T DemandStream::generatePreferredDepartureTime() {
+  const stdair::Duration_T DemandStream::
+  generatePreferredDepartureTime (const DemandCharacteristics& iDemandCharacteristics) {
     // Generate a random number between 0 and 1.
     const stdair::Probability_T lVariate =
-      _demandCharacteristicsRandomGenerator();     
-    const stdair::IntDuration_T lNbOfSeconds = _demandCharacteristics.
+      drawVariate (K_PREFERRED_DEPARTURE_TIME_SUB_STREAM);
+    const stdair::IntDuration_T lNbOfSeconds = iDemandCharacteristics.
       _preferredDepartureTimeCumulativeDistribution.getValue (lVariate);
 
     const stdair::Duration_T oTime = boost::posix_time::seconds (lNbOfSeconds);
@@ -509,7 +739,8 @@ namespace TRADEMGEN {
 
   // ////////////////////////////////////////////////////////////////////
   const stdair::WTP_T DemandStream::
-  generateWTP (stdair::RandomGeneration& ioGenerator,
+  generateWTP (const DemandCharacteristics& iDemandCharacteristics,
+               const stdair::Probability_T& iVariate,
                const stdair::Date_T& iDepartureDate,
                const stdair::DateTime_T& iDateTimeThisRequest,
                const stdair::DayDuration_T& iDurationOfStay) {
@@ -519,21 +750,22 @@ namespace TRADEMGEN {
 
     stdair::RealNumber_T lProb = -lAPInDays;
     stdair::RealNumber_T lFrat5Coef =
-      _demandCharacteristics._frat5Pattern.getValue (lProb);
+      iDemandCharacteristics._frat5Pattern.getValue (lProb);
 
-    const stdair::WTP_T lWTP =  _demandCharacteristics._minWTP
-      * (1.0 + (lFrat5Coef - 1.0) * log(ioGenerator()) / log(0.5));
+    const stdair::WTP_T lWTP =  iDemandCharacteristics._minWTP
+      * (1.0 + (lFrat5Coef - 1.0) * log(iVariate) / log(0.5));
     
     return lWTP;
   }
 
   // ////////////////////////////////////////////////////////////////////
-  const stdair::PriceValue_T DemandStream::generateValueOfTime() {
+  const stdair::PriceValue_T DemandStream::
+  generateValueOfTime (const DemandCharacteristics& iDemandCharacteristics) {
     // Generate a random number between 0 and 1.
     const stdair::Probability_T lVariate =
-      _demandCharacteristicsRandomGenerator();    
+      drawVariate (RequestFieldMask::VALUE_OF_TIME);
 
-    return _demandCharacteristics._valueOfTimeCumulativeDistribution.getValue (lVariate);
+    return iDemandCharacteristics._valueOfTimeCumulativeDistribution.getValue (lVariate);
   }
   
   // ////////////////////////////////////////////////////////////////////
@@ -541,6 +773,9 @@ namespace TRADEMGEN {
   generateNextRequest (stdair::RandomGeneration& ioGenerator,
                        const stdair::DemandGenerationMethod& iDemandGenerationMethod) {
 
+    // The generation state is about to change
+    _isDirty = true;
+
     // Origin
     const stdair::AirportCode_T& lOrigin = _key.getOrigin();
     // Destination
@@ -548,14 +783,11 @@ namespace TRADEMGEN {
     // Preferred departure date
     const stdair::Date_T& lPreferredDepartureDate = 
       _key.getPreferredDepartureDate();
-    // Preferred cabin
-    const stdair::CabinCode_T& lPreferredCabin = _key.getPreferredCabin();
-    // Party size
-    const stdair::NbOfSeats_T lPartySize = stdair::DEFAULT_PARTY_SIZE;
-    // POS
-    const stdair::AirportCode_T lPOS = generatePOS();
-    
-    // Compute the request date time with the correct algorithm.
+
+    // Compute the request date time with the correct algorithm. It comes
+    // first, as it sets the rank of the booking request, from which all
+    // the projected fields are drawn (see drawVariate()); having its own
+    // random generator, it does not change the other draws.
     stdair::DateTime_T lDateTimeThisRequest;
     const stdair::DemandGenerationMethod::EN_DemandGenerationMethod& lENDemandGenerationMethod =
       iDemandGenerationMethod.getMethod();
@@ -566,33 +798,82 @@ namespace TRADEMGEN {
       lDateTimeThisRequest = generateTimeOfRequestStatisticsOrder(); break;
     default: assert (false); break;
     }
-    
+
+    // Preferred cabin, and its demand characteristics (for a multi-cabin
+    // demand stream, the cabin is drawn before any other characteristic)
+    const stdair::CabinCode_T* lPreferredCabin_ptr = &_key.getPreferredCabin();
+    const DemandCharacteristics* lDemandCharacteristics_ptr =
+      &_demandCharacteristics;
+    if (_cabinDemandList.empty() == false) {
+      const CabinDemand& lCabinDemand = generateCabinDemand();
+      lPreferredCabin_ptr = &lCabinDemand._cabinCode;
+      lDemandCharacteristics_ptr = &lCabinDemand._demandCharacteristics;
+    }
+    const stdair::CabinCode_T& lPreferredCabin = *lPreferredCabin_ptr;
+    const DemandCharacteristics& lDemandCharacteristics =
+      *lDemandCharacteristics_ptr;
+    // Party size
+    const stdair::NbOfSeats_T lPartySize = stdair::DEFAULT_PARTY_SIZE;
+    // POS
+    const stdair::AirportCode_T lPOS =
+      (isGenerated (RequestFieldMask::POS) == true) ?
+      generatePOS (lDemandCharacteristics) : stdair::AirportCode_T();
+
+
+    // The fields which are not to be drawn are left to neutral values
     // Booking channel.
-    const stdair::ChannelLabel_T lChannelLabel = generateChannel();
+    const stdair::ChannelLabel_T lChannelLabel =
+      (isGenerated (RequestFieldMask::CHANNEL) == true) ?
+      generateChannel (lDemandCharacteristics) : stdair::ChannelLabel_T();
     // Trip type.
-    const stdair::TripType_T lTripType = generateTripType();
+    const stdair::TripType_T lTripType =
+      (isGenerated (RequestFieldMask::TRIP_TYPE) == true) ?
+      generateTripType (lDemandCharacteristics) : stdair::TripType_T();
     // Stay duration.
-    const stdair::DayDuration_T lStayDuration = generateStayDuration();
+    const stdair::DayDuration_T lStayDuration =
+      (isGenerated (RequestFieldMask::STAY_DURATION) == true) ?
+      generateStayDuration (lDemandCharacteristics) : 0;
     // Frequet flyer type.
-    const stdair::FrequentFlyer_T lFrequentFlyer = generateFrequentFlyer();
+    const stdair::FrequentFlyer_T lFrequentFlyer =
+      (isGenerated (RequestFieldMask::FREQUENT_FLYER) == true) ?
+      generateFrequentFlyer (lDemandCharacteristics) : stdair::FrequentFlyer_T();
     // Change fees
-    const stdair::ChangeFees_T lChangeFees = generateChangeFees();
+    const stdair::ChangeFees_T lChangeFees =
+      (isGenerated (RequestFieldMask::CHANGE_FEES) == true) ?
+      generateChangeFees (lDemandCharacteristics) : false;
     // Change fee disutility
     const stdair::Disutility_T lChangeFeeDisutility =
-      _demandCharacteristics._changeFeeDisutility;
+      lDemandCharacteristics._changeFeeDisutility;
     // Non refundable
-    const stdair::NonRefundable_T lNonRefundable = generateNonRefundable();
+    const stdair::NonRefundable_T lNonRefundable =
+      (isGenerated (RequestFieldMask::NON_REFUNDABLE) == true) ?
+      generateNonRefundable (lDemandCharacteristics) : false;
     // Non refundable disutility
     const stdair::Disutility_T lNonRefundableDisutility =
-      _demandCharacteristics._nonRefundableDisutility;
-    // Preferred departure time.
+      lDemandCharacteristics._nonRefundableDisutility;
+    // Preferred departure time (always drawn, as it tells whether the
+    // booking request comes before the departure).
     const stdair::Duration_T lPreferredDepartureTime =
-      generatePreferredDepartureTime();
+      generatePreferredDepartureTime (lDemandCharacteristics);
     // Value of time
-    const stdair::PriceValue_T lValueOfTime = generateValueOfTime();
-    // WTP
-    const stdair::WTP_T lWTP = generateWTP (ioGenerator,lPreferredDepartureDate,
-                                            lDateTimeThisRequest,lStayDuration);
+    const stdair::PriceValue_T lValueOfTime =
+      (isGenerated (RequestFieldMask::VALUE_OF_TIME) == true) ?
+      generateValueOfTime (lDemandCharacteristics) : 0.0;
+    // WTP (drawn from the generator of the demand stream when the
+    // generation is sharded or filtered, as the shared generator is then
+    // not drawn in the same order as for the whole demand, and from its
+    // own sub-stream when the fields are projected)
+    stdair::WTP_T lWTP = 0.0;
+    if (isGenerated (RequestFieldMask::WTP) == true) {
+      stdair::RandomGeneration& lWTPGenerator =
+        (_isSharded == true || _isFiltered == true) ?
+        _demandCharacteristicsRandomGenerator : ioGenerator;
+      const stdair::Probability_T lWTPVariate = (_isProjected == true) ?
+        drawVariate (RequestFieldMask::WTP) : lWTPGenerator();
+      lWTP = generateWTP (lDemandCharacteristics, lWTPVariate,
+                          lPreferredDepartureDate, lDateTimeThisRequest,
+                          lStayDuration);
+    }
 
     // TODO: move the creation of the structure out of the BOM layer
     //  (into the command layer, e.g., within the DemandManager command).
@@ -616,15 +897,194 @@ namespace TRADEMGEN {
     // DEBUG  
     // Be careful: this specific display is mandatory to retrieve the booking 
     // requests when parsing the demand generation log with python scripts.
-    STDAIR_LOG_NOTIFICATION ("\n[BKG] " << oBookingRequest_ptr->describe());
+    if (_isQuiet == false) {
+      STDAIR_LOG_NOTIFICATION ("\n[BKG] " << oBookingRequest_ptr->describe());
+    }
     
     return oBookingRequest_ptr;
   }
 
+  // ////////////////////////////////////////////////////////////////////
+  stdair::Count_T DemandStream::
+  generateAllRequests (const stdair::DemandGenerationMethod& iDemandGenerationMethod,
+                       std::vector<stdair::BookingRequestPtr_T>& ioRequestList) {
+    stdair::Count_T oNbOfRequests = 0;
+
+    // The StdAir logger cannot be used concurrently
+    _isQuiet = true;
+    setBoolFirstDateTimeRequest (true);
+    while (stillHavingRequestsToBeGenerated (iDemandGenerationMethod) == true) {
+      const stdair::BookingRequestPtr_T lBookingRequest_ptr =
+        generateNextRequest (_demandCharacteristicsRandomGenerator,
+                             iDemandGenerationMethod);
+      assert (lBookingRequest_ptr != NULL);
+
+      // As for the event queue, the booking requests must come before
+      // the preferred departure date-time
+      const stdair::DateTime_T& lBookingRequestDateTime =
+        lBookingRequest_ptr->getRequestDateTime();
+      const stdair::DateTime_T lPreferredDepartureDateTime
+        (lBookingRequest_ptr->getPreferedDepartureDate(),
+         lBookingRequest_ptr->getPreferredDepartureTime());
+      if (lBookingRequestDateTime >= lPreferredDepartureDateTime) {
+        break;
+      }
+
+      ioRequestList.push_back (lBookingRequest_ptr);
+      ++oNbOfRequests;
+    }
+    _isQuiet = false;
+
+    return oNbOfRequests;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  stdair::Count_T DemandStream::
+  generateArrivalCounts (const stdair::DemandGenerationMethod& iDemandGenerationMethod,
+                         const std::vector<stdair::FloatDuration_T>& iBucketBoundaryList,
+                         const std::vector<stdair::ChannelLabel_T>& iChannelList,
+                         std::vector<stdair::Count_T>& ioCountList) {
+    const std::size_t lNbOfBuckets = iBucketBoundaryList.size() + 1;
+    const std::size_t lNbOfChannels =
+      (iChannelList.empty() == true) ? 1 : iChannelList.size();
+    ioCountList.assign (lNbOfChannels * lNbOfBuckets, 0);
+
+    // Out of the shard of the current process, nothing is generated
+    if (_isInShard == false) {
+      return 0;
+    }
+
+    // The generation state is about to change
+    _isDirty = true;
+
+    // 1. Probabilities of the buckets, from the arrival pattern. As the
+    //    Poisson process stops at the last lower bound of the arrival
+    //    pattern (see generateTimeOfRequestPoissonProcess()), the mass
+    //    beyond it is left out.
+    const stdair::DemandGenerationMethod::EN_DemandGenerationMethod& lENDemandGenerationMethod =
+      iDemandGenerationMethod.getMethod();
+    const ContinuousFloatDuration_T& lArrivalPattern =
+      _demandCharacteristics._arrivalPattern;
+    const stdair::Probability_T lLastCumulativeProbability =
+      (lENDemandGenerationMethod == stdair::DemandGenerationMethod::POI_PRO) ?
+      lArrivalPattern.
+      getCumulativeProbability (DEFAULT_LAST_LOWER_BOUND_ARRIVAL_PATTERN) : 1.0;
+    std::vector<stdair::Probability_T> lBucketProbabilityList (lNbOfBuckets);
+    stdair::Probability_T lCumulativeProbabilitySoFar = 0.0;
+    for (std::size_t idx = 0; idx != iBucketBoundaryList.size(); ++idx) {
+      const stdair::Probability_T lCumulativeProbability =
+        std::max (lCumulativeProbabilitySoFar,
+                  std::min (lLastCumulativeProbability,
+                            lArrivalPattern.
+                            getCumulativeProbability (iBucketBoundaryList[idx])));
+      lBucketProbabilityList[idx] =
+        lCumulativeProbability - lCumulativeProbabilitySoFar;
+      lCumulativeProbabilitySoFar = lCumulativeProbability;
+    }
+    lBucketProbabilityList.back() =
+      std::max (0.0, lLastCumulativeProbability - lCumulativeProbabilitySoFar);
+
+    // 2. Arrivals within every bucket
+    stdair::BaseGenerator_T& lRequestDateTimeGenerator =
+      _requestDateTimeRandomGenerator.getBaseGenerator();
+    std::vector<stdair::Count_T> lBucketCountList (lNbOfBuckets, 0);
+    switch (lENDemandGenerationMethod) {
+    case stdair::DemandGenerationMethod::POI_PRO: {
+      const double lDemandMean = _demandDistribution._meanNumberOfRequests;
+      for (std::size_t idx = 0; idx != lNbOfBuckets; ++idx) {
+        const double lBucketMean = lDemandMean * lBucketProbabilityList[idx];
+        if (lBucketMean > 0.0) {
+          boost::random::poisson_distribution<stdair::Count_T>
+            lPoisson (lBucketMean);
+          lBucketCountList[idx] = lPoisson (lRequestDateTimeGenerator);
+        }
+      }
+      break;
+    }
+    case stdair::DemandGenerationMethod::STA_ORD:
+      lBucketCountList =
+        drawMultinomial (static_cast<stdair::Count_T> (_totalNumberOfRequestsToBeGenerated),
+                         lBucketProbabilityList, lRequestDateTimeGenerator);
+      break;
+    default: assert (false); break;
+    }
+
+    stdair::Count_T oNbOfArrivals = 0;
+    for (std::size_t idx = 0; idx != lNbOfBuckets; ++idx) {
+      oNbOfArrivals += lBucketCountList[idx];
+    }
+
+    // 3. Arrivals within every channel (for a multi-cabin demand stream,
+    //    the channel probabilities of its cabins are weighted by their
+    //    own probabilities)
+    if (iChannelList.empty() == true) {
+      ioCountList = lBucketCountList;
+      return oNbOfArrivals;
+    }
+
+    std::vector<stdair::Probability_T> lChannelProbabilityList (lNbOfChannels);
+    for (std::size_t lChannelIdx = 0; lChannelIdx != lNbOfChannels;
+         ++lChannelIdx) {
+      const stdair::ChannelLabel_T& lChannel = iChannelList[lChannelIdx];
+      if (_cabinDemandList.empty() == true) {
+        lChannelProbabilityList[lChannelIdx] =
+          _demandCharacteristics._channelProbabilityMass.getProbability (lChannel);
+        continue;
+      }
+
+      stdair::Probability_T lPreviousCumulativeProbability = 0.0;
+      for (CabinDemandList_T::const_iterator itCabinDemand =
+             _cabinDemandList.begin();
+           itCabinDemand != _cabinDemandList.end(); ++itCabinDemand) {
+        const stdair::Probability_T lCabinProbability =
+          itCabinDemand->_cumulativeProbability - lPreviousCumulativeProbability;
+        lPreviousCumulativeProbability = itCabinDemand->_cumulativeProbability;
+        lChannelProbabilityList[lChannelIdx] += lCabinProbability
+          * itCabinDemand->_demandCharacteristics._channelProbabilityMass.
+          getProbability (lChannel);
+      }
+    }
+
+    stdair::BaseGenerator_T& lDemandCharacteristicsGenerator =
+      _demandCharacteristicsRandomGenerator.getBaseGenerator();
+    for (std::size_t lBucketIdx = 0; lBucketIdx != lNbOfBuckets; ++lBucketIdx) {
+      const std::vector<stdair::Count_T> lChannelCountList =
+        drawMultinomial (lBucketCountList[lBucketIdx], lChannelProbabilityList,
+                         lDemandCharacteristicsGenerator);
+      for (std::size_t lChannelIdx = 0; lChannelIdx != lNbOfChannels;
+           ++lChannelIdx) {
+        ioCountList[lChannelIdx * lNbOfBuckets + lBucketIdx] =
+          lChannelCountList[lChannelIdx];
+      }
+    }
+
+    return oNbOfArrivals;
+  }
+
   // ////////////////////////////////////////////////////////////////////
   void DemandStream::reset (stdair::BaseGenerator_T& ioSharedGenerator) {
     _randomGenerationContext.reset();
+    ++_runNumber;
     init (ioSharedGenerator);
   }
 
+  // ////////////////////////////////////////////////////////////////////
+  void DemandStream::
+  reset (const stdair::NbOfRequests_T& iTotalNumberOfRequests) {
+    _randomGenerationContext.reset();
+    ++_runNumber;
+    init (iTotalNumberOfRequests);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void DemandStream::retire() {
+    _demandCharacteristics = DemandCharacteristics();
+    _cabinDemandList.clear();
+    _totalNumberOfRequestsToBeGenerated =
+      _randomGenerationContext.getNumberOfRequestsGeneratedSoFar();
+    _stillHavingRequestsToBeGenerated = false;
+    _pendingRequest.reset();
+    _isDirty = true;
+  }
+
 }
@@ -4,6 +4,8 @@
 // //////////////////////////////////////////////////////////////////////
 // Import section
 // //////////////////////////////////////////////////////////////////////
+// STL
+#include <vector>
 // StdAir
 #include <stdair/bom/BomAbstract.hpp>
 #include <stdair/bom/BookingRequestTypes.hpp>
@@ -13,6 +15,7 @@
 #include <trademgen/basic/DemandCharacteristics.hpp>
 #include <trademgen/basic/DemandDistribution.hpp>
 #include <trademgen/basic/RandomGenerationContext.hpp>
+#include <trademgen/basic/RequestFieldMask.hpp>
 #include <trademgen/bom/DemandStreamKey.hpp>
 #include <trademgen/bom/DemandStreamTypes.hpp>
 
@@ -30,6 +33,7 @@ namespace TRADEMGEN {
   class DemandStream : public stdair::BomAbstract {
     template <typename BOM> friend class stdair::FacBom;
     friend class stdair::FacBomManager;
+    friend class DemandStreamSnapshot;
 
   public:
     // ////////// Type definitions ////////////
@@ -38,6 +42,20 @@ namespace TRADEMGEN {
      */
     typedef DemandStreamKey Key_T;
 
+    /**
+     * Demand of one of the cabins of a multi-cabin demand stream (see
+     * setCabinDemandList()), along with the cumulative probability of
+     * that cabin and the ones before it.
+     */
+    struct CabinDemand {
+      stdair::CabinCode_T _cabinCode;
+      stdair::Probability_T _cumulativeProbability;
+      DemandCharacteristics _demandCharacteristics;
+    };
+
+    /** List of the cabin demands of a multi-cabin demand stream. */
+    typedef std::vector<CabinDemand> CabinDemandList_T;
+
 
   public:
     // ///////////// Getters ///////////
@@ -81,6 +99,23 @@ namespace TRADEMGEN {
       return _demandCharacteristics;
     }
 
+    /**
+     * Get the cabin demands of the demand stream (empty, unless the
+     * demand stream is a multi-cabin one).
+     */
+    const CabinDemandList_T& getCabinDemandList() const {
+      return _cabinDemandList;
+    }
+
+    /**
+     * State whether the demand stream generates the requests of several
+     * cabins, the preferred cabin of its key then being made of their
+     * codes (e.g., "C/Y").
+     */
+    bool isMultiCabin() const {
+      return (_cabinDemandList.empty() == false);
+    }
+
     /** Get the demand distribution. */
     const DemandDistribution& getDemandDistribution() const {
       return _demandDistribution;
@@ -106,6 +141,42 @@ namespace TRADEMGEN {
       return _randomGenerationContext.getNumberOfRequestsGeneratedSoFar();
     }
 
+    /**
+     * State whether the generation state (total number of requests,
+     * random generation context and generators) may have changed since
+     * it was last saved into, or restored from, a snapshot (see
+     * DemandStreamSnapshot).
+     */
+    bool isDirty() const {
+      return _isDirty;
+    }
+
+    /**
+     * Get the last booking request generated by the demand stream, as
+     * long as it is in the event queue (NULL otherwise).
+     */
+    const stdair::BookingRequestPtr_T& getPendingRequest() const {
+      return _pendingRequest;
+    }
+
+    /**
+     * State whether the demand stream belongs to the shard generated by
+     * the current process (see TRADEMGEN_Service::shardDemand()). Out
+     * of that shard, the demand stream generates no booking request.
+     */
+    bool isInShard() const {
+      return _isInShard;
+    }
+
+    /**
+     * Get the sampling weight of the demand stream, i.e., the number of
+     * demand streams of its stratum it stands for (one when the demand
+     * streams are not sampled, see DemandFilterStruct::_samplingRate).
+     */
+    const stdair::RealNumber_T& getSamplingWeight() const {
+      return _samplingWeight;
+    }
+
     /** Get the change fee disutility. */
     const stdair::Disutility_T& getChangeFeeDisutility() const {
       return _demandCharacteristics._changeFeeDisutility;
@@ -130,6 +201,16 @@ namespace TRADEMGEN {
     /** Set the number of requests generated so far. */
     void setNumberOfRequestsGeneratedSoFar (const stdair:: Count_T& iCount) {
       _randomGenerationContext.setNumberOfRequestsGeneratedSoFar (iCount);
+      _isDirty = true;
+    }
+
+    /**
+     * Set the booking request of the demand stream lying in the event
+     * queue (NULL when none).
+     */
+    void setPendingRequest (const stdair::BookingRequestPtr_T& iRequest_ptr) {
+      _pendingRequest = iRequest_ptr;
+      _isDirty = true;
     }
 
     /** Set the demand distribution. */
@@ -162,19 +243,44 @@ namespace TRADEMGEN {
                                iMinWTP, iValueOfTimeContinuousDistribution);
     }
 
+    /**
+     * Set the (already compiled) demand characteristics, e.g., as built
+     * straight from a compiled demand model.
+     */
+    void setDemandCharacteristics (const DemandCharacteristics& iDemandCharacteristics) {
+      _demandCharacteristics = iDemandCharacteristics;
+    }
+
+    /**
+     * Set the cabin demands, turning the demand stream into a
+     * multi-cabin one: every booking request is first given a cabin,
+     * drawn following the cumulative probabilities of the cabin
+     * demands, and then the other characteristics of that cabin. The
+     * arrival pattern of the demand stream remains the one of its
+     * demand characteristics, which must be shared by all the cabins.
+     */
+    void setCabinDemandList (const CabinDemandList_T& iCabinDemandList) {
+      _cabinDemandList = iCabinDemandList;
+    }
+
     /** Set the total number of requests to be generated. */
     void setTotalNumberOfRequestsToBeGenerated (const stdair::NbOfRequests_T& iNbOfRequests) {
       _totalNumberOfRequestsToBeGenerated = iNbOfRequests;
+      _isDirty = true;
     }
 
     /** Set the seed of the random generator for the request datetime. */
     void setRequestDateTimeRandomGeneratorSeed (const stdair::RandomSeed_T& iSeed) {
       _requestDateTimeRandomGenerator.init (iSeed);
+      _isDirty = true;
     }
 
     /** Set the seed of the random generator for the demand characteristics. */
     void setDemandCharacteristicsRandomGeneratorSeed (const stdair::RandomSeed_T& iSeed) {
       _demandCharacteristicsRandomGenerator.init (iSeed);
+      _demandCharacteristicsSeed = iSeed;
+      _runNumber = 0;
+      _isDirty = true;
     }
 
     /**
@@ -207,13 +313,95 @@ namespace TRADEMGEN {
                  const stdair::RandomSeed_T& iDemandCharacteristicsSeed,
                  const POSProbabilityMass_T&);
 
+    /**
+     * Initialisation, the total number of requests to be generated
+     * having already been drawn (see drawTotalNumberOfRequests()).
+     */
+    void setAll (const ArrivalPatternCumulativeDistribution_T&,
+                 const POSProbabilityMassFunction_T&,
+                 const ChannelProbabilityMassFunction_T&,
+                 const TripTypeProbabilityMassFunction_T&,
+                 const StayDurationProbabilityMassFunction_T&,
+                 const FrequentFlyerProbabilityMassFunction_T&,
+                 const stdair::ChangeFeesRatio_T&,
+                 const stdair::Disutility_T&,
+                 const stdair::NonRefundableRatio_T&,
+                 const stdair::Disutility_T&,
+                 const PreferredDepartureTimeContinuousDistribution_T&,
+                 const stdair::WTP_T&,
+                 const ValueOfTimeContinuousDistribution_T&,
+                 const DemandDistribution&,
+                 const stdair::NbOfRequests_T& iTotalNumberOfRequests,
+                 const stdair::RandomSeed_T& iRequestDateTimeSeed,
+                 const stdair::RandomSeed_T& iDemandCharacteristicsSeed,
+                 const POSProbabilityMass_T&);
+
+    /**
+     * Initialisation from (already compiled) demand characteristics, the
+     * total number of requests to be generated having already been
+     * drawn (see drawTotalNumberOfRequests()).
+     */
+    void setAll (const DemandCharacteristics&,
+                 const DemandDistribution&,
+                 const stdair::NbOfRequests_T& iTotalNumberOfRequests,
+                 const stdair::RandomSeed_T& iRequestDateTimeSeed,
+                 const stdair::RandomSeed_T& iDemandCharacteristicsSeed,
+                 const POSProbabilityMass_T&);
+
     /**
      * Set the boolean describing if it is the first time we generate a
      * request for a demand stream.
      */
     void setBoolFirstDateTimeRequest (const bool& iFirstDateTimeRequest) {
-      _firstDateTimeRequest = iFirstDateTimeRequest;
+      if (_firstDateTimeRequest != iFirstDateTimeRequest) {
+        _firstDateTimeRequest = iFirstDateTimeRequest;
+        _isDirty = true;
+      }
     }
+
+    /**
+     * Set whether the demand generation is sharded and, if so, whether
+     * the demand stream belongs to the shard of the current process.
+     * When the generation is sharded, the WTP is drawn from the random
+     * generator of the demand stream, rather than from the shared one,
+     * so that the booking requests of the demand stream do not depend
+     * on the other demand streams.
+     */
+    void setShard (const bool iIsSharded, const bool iIsInShard) {
+      _isSharded = iIsSharded;
+      _isInShard = iIsInShard;
+    }
+
+    /**
+     * Set whether the demand stream has been loaded through a filter
+     * (see DemandFilterStruct), i.e., whether demand streams may be left
+     * out. As for the sharded generation, the WTP is then drawn from the
+     * random generator of the demand stream, rather than from the shared
+     * one, so that the booking requests of the demand stream do not
+     * depend on the demand streams left out.
+     */
+    void setFiltered (const bool iIsFiltered) {
+      _isFiltered = iIsFiltered;
+    }
+
+    /** Set the sampling weight of the demand stream. */
+    void setSamplingWeight (const stdair::RealNumber_T& iSamplingWeight) {
+      _samplingWeight = iSamplingWeight;
+    }
+
+    /**
+     * Set whether the fields of the booking requests are projected, and
+     * onto which ones: only the fields of the mask are then drawn, the
+     * other ones being left to neutral values. Every characteristic is
+     * then drawn from its own sub-stream, depending only on the seed of
+     * the demand characteristics, on the number of runs since that seed
+     * was set (every reset() starting another run) and on the rank of
+     * the booking request within the demand stream, so that the drawn
+     * fields are the same whatever the mask, while differing from one
+     * run to the next (see drawVariate()).
+     */
+    void setRequestFieldMask (const bool iIsProjected,
+                              const RequestFieldMask&);
     
 
   public:
@@ -223,7 +411,12 @@ namespace TRADEMGEN {
       _randomGenerationContext.incrementGeneratedRequestsCounter();
     }
     
-    /** Check whether enough requests have already been generated. */
+    /**
+     * Check whether enough requests have already been generated. With
+     * the Poisson process, a demand stream the mean number of requests
+     * of which is zero (e.g., switched off by reloadDemand()) has no
+     * request to generate.
+     */
     const bool stillHavingRequestsToBeGenerated (const stdair::DemandGenerationMethod& iDemandGenerationMethod) const;
 
     /** Generate the time of the next request with poisson process. */
@@ -232,38 +425,64 @@ namespace TRADEMGEN {
     /** Generate the time of the next request with statistics order */
     const stdair::DateTime_T generateTimeOfRequestStatisticsOrder();
 
+    /**
+     * Generate the cabin demand of the next request (for a multi-cabin
+     * demand stream only).
+     */
+    const CabinDemand& generateCabinDemand();
+
+    /**
+     * State whether the given field of the booking requests is to be
+     * drawn (see setRequestFieldMask()).
+     */
+    bool isGenerated (const RequestFieldMask::EN_RequestField) const;
+
+    /**
+     * Draw a number between 0 and 1 for a demand characteristic, from
+     * the random generator of the demand characteristics or, when the
+     * fields are projected, from the given sub-stream (the bit of the
+     * field, for the fields of RequestFieldMask) of the current run.
+     */
+    stdair::Probability_T drawVariate (const unsigned int iSubStream);
+
     /** Generate the POS. */
-    const stdair::AirportCode_T generatePOS();
+    const stdair::AirportCode_T generatePOS (const DemandCharacteristics&);
 
     /** Generate the reservation channel. */
-    const stdair::ChannelLabel_T generateChannel();
+    const stdair::ChannelLabel_T generateChannel (const DemandCharacteristics&);
 
     /** Generate the trip type. */
-    const stdair::TripType_T generateTripType();
+    const stdair::TripType_T generateTripType (const DemandCharacteristics&);
 
     /** Generate the stay duration. */
-    const stdair::DayDuration_T generateStayDuration();
+    const stdair::DayDuration_T
+    generateStayDuration (const DemandCharacteristics&);
 
     /** Generate the frequent flyer type. */
-    const stdair::FrequentFlyer_T generateFrequentFlyer();
+    const stdair::FrequentFlyer_T
+    generateFrequentFlyer (const DemandCharacteristics&);
 
     /** Generate the change fee acceptation. */
-    const stdair::ChangeFees_T generateChangeFees();
+    const stdair::ChangeFees_T generateChangeFees (const DemandCharacteristics&);
 
     /** Generate the non refundable acceptation. */
-    const stdair::NonRefundable_T generateNonRefundable();
+    const stdair::NonRefundable_T
+    generateNonRefundable (const DemandCharacteristics&);
 
     /** Generate the preferred departure time. */
-    const stdair::Duration_T generatePreferredDepartureTime();
+    const stdair::Duration_T
+    generatePreferredDepartureTime (const DemandCharacteristics&);
     
     /** Generate the WTP. */
-    const stdair::WTP_T generateWTP (stdair::RandomGeneration&,
+    const stdair::WTP_T generateWTP (const DemandCharacteristics&,
+                                     const stdair::Probability_T&,
                                      const stdair::Date_T&,
                                      const stdair::DateTime_T&,
                                      const stdair::DayDuration_T&);
 
     /** Generate the value of time. */
-    const stdair::PriceValue_T generateValueOfTime();
+    const stdair::PriceValue_T
+    generateValueOfTime (const DemandCharacteristics&);
     
     /**
      * Generate the next request.
@@ -279,8 +498,104 @@ namespace TRADEMGEN {
     generateNextRequest (stdair::RandomGeneration&,
                          const stdair::DemandGenerationMethod&);
 
+    /**
+     * Generate, in a row, all the booking requests of the demand stream,
+     * in the order of their date-times, without going through the event
+     * queue. As for the event queue, the generation stops at the first
+     * booking request which is not dated before the preferred departure
+     * date-time (that request being discarded).
+     *
+     * The WTP is drawn from the random generator of the demand stream,
+     * so that the booking requests do not depend on the other demand
+     * streams; and nothing is logged. Hence, several demand streams may
+     * be generated concurrently.
+     *
+     * @param const stdair::DemandGenerationMethod& Method used to
+     *        generate the date-times of the booking requests.
+     * @param std::vector<stdair::BookingRequestPtr_T>& List to which the
+     *        booking requests are appended.
+     * @return stdair::Count_T Number of generated booking requests.
+     */
+    stdair::Count_T
+    generateAllRequests (const stdair::DemandGenerationMethod&,
+                         std::vector<stdair::BookingRequestPtr_T>&);
+
+    /**
+     * Draw the numbers of booking requests (arrivals) of the demand
+     * stream within the given buckets of the booking horizon, and
+     * optionally within the given channels, without generating any
+     * booking request.
+     *
+     * The counts follow the distribution of the booking requests which
+     * the given method would generate: with the order statistics
+     * method, the total number of requests is split among the buckets
+     * following a multinomial distribution, the probability of a bucket
+     * being the mass of the arrival pattern within it; with the Poisson
+     * process, the count of every bucket is drawn from a Poisson
+     * distribution, the mean of which is the mean number of requests
+     * times that probability. The counts of every bucket are then split
+     * among the channels following a multinomial distribution as well.
+     * Out of the shard of the current process, all the counts are zero.
+     *
+     * As the Poisson process stops generating at the last lower bound
+     * of the arrival pattern (one day before the departure), the
+     * arrivals beyond it are not counted either. However, the counts
+     * still include the arrivals which would come after the preferred
+     * departure date-time of their booking requests, and which would
+     * hence be dropped when the booking requests are generated (that
+     * date-time depending on the preferred departure time, drawn for
+     * every booking request). With the order statistics, for instance,
+     * the total count is the total number of requests to be generated,
+     * whereas fewer booking requests may come out.
+     *
+     * The counts are drawn from the random generators of the demand
+     * stream, so that several demand streams may be drawn concurrently.
+     *
+     * @param const stdair::DemandGenerationMethod& Method used to
+     *        generate the date-times of the booking requests.
+     * @param const std::vector<stdair::FloatDuration_T>& Bounds of the
+     *        buckets, as increasing offsets (in days) from the
+     *        departure, e.g., {-90, -30, -7} for four buckets.
+     * @param const std::vector<stdair::ChannelLabel_T>& Channels (empty
+     *        for the counts not to be split by channel).
+     * @param std::vector<stdair::Count_T>& Counts, channel by channel
+     *        and, within every channel, bucket by bucket (replaced).
+     * @return stdair::Count_T Total number of arrivals.
+     */
+    stdair::Count_T
+    generateArrivalCounts (const stdair::DemandGenerationMethod&,
+                           const std::vector<stdair::FloatDuration_T>& iBucketBoundaryList,
+                           const std::vector<stdair::ChannelLabel_T>& iChannelList,
+                           std::vector<stdair::Count_T>& ioCountList);
+
     /** Reset all the contexts of the demand stream. */
     void reset (stdair::BaseGenerator_T& ioSharedGenerator);
+
+    /**
+     * Reset all the contexts of the demand stream, the total number of
+     * requests to be generated having already been drawn (e.g., see
+     * TotalNumberOfRequestsTable).
+     */
+    void reset (const stdair::NbOfRequests_T& iTotalNumberOfRequests);
+
+    /**
+     * Release the demand characteristics (i.e., the distributions) of
+     * the demand stream, once it has no booking request to give anymore
+     * (see DemandStreamSchedule). As the BOM tree does not allow for
+     * removing objects, the demand stream is left there, but it does
+     * not give any booking request anymore, until its demand
+     * characteristics are set again.
+     */
+    void retire();
+
+    /**
+     * Draw the total number of requests to be generated, following the
+     * given demand distribution. That is the only draw made with the
+     * shared generator, when a demand stream is initialised.
+     */
+    static stdair::NbOfRequests_T
+    drawTotalNumberOfRequests (const DemandDistribution&,
+                               stdair::BaseGenerator_T& ioSharedGenerator);
        
 
   public:
@@ -337,6 +652,9 @@ namespace TRADEMGEN {
     /** Initialisation. */
     void init (stdair::BaseGenerator_T& ioSharedGenerator);
 
+    /** Initialisation, with the given total number of requests. */
+    void init (const stdair::NbOfRequests_T& iTotalNumberOfRequests);
+
     
   protected:
     // ////////// Attributes //////////
@@ -360,6 +678,12 @@ namespace TRADEMGEN {
      */
     DemandCharacteristics _demandCharacteristics;
 
+    /**
+     * Cabin demands, for a multi-cabin demand stream (see
+     * setCabinDemandList()).
+     */
+    CabinDemandList_T _cabinDemandList;
+
     /**
      * Demand distribution.
      */
@@ -395,6 +719,63 @@ namespace TRADEMGEN {
     bool _stillHavingRequestsToBeGenerated;
     bool _firstDateTimeRequest;
     stdair::FloatDuration_T _dateTimeLastRequest;
+
+    /**
+     * Booking request lying in the event queue, if any (see
+     * getPendingRequest()).
+     */
+    stdair::BookingRequestPtr_T _pendingRequest;
+
+    /**
+     * Whether the generation state may have changed since the last
+     * snapshot (see isDirty()).
+     */
+    bool _isDirty;
+
+    /**
+     * Whether the demand generation is sharded, and whether the demand
+     * stream belongs to the shard of the current process (see
+     * setShard()).
+     */
+    bool _isSharded;
+    bool _isInShard;
+
+    /**
+     * Whether the demand stream has been loaded through a filter (see
+     * setFiltered()).
+     */
+    bool _isFiltered;
+
+    /**
+     * Whether the generated booking requests are not logged (see
+     * generateAllRequests()).
+     */
+    bool _isQuiet;
+
+    /**
+     * Sampling weight of the demand stream (see getSamplingWeight()).
+     */
+    stdair::RealNumber_T _samplingWeight;
+
+    /**
+     * Seed of the random generator for the demand characteristics, from
+     * which the sub-streams of the projected fields are derived.
+     */
+    stdair::RandomSeed_T _demandCharacteristicsSeed;
+
+    /**
+     * Number of runs since the seed of the demand characteristics has
+     * been set (incremented by every reset()), from which, along with
+     * that seed, the sub-streams of the projected fields are derived.
+     */
+    stdair::Count_T _runNumber;
+
+    /**
+     * Whether the fields of the booking requests are projected, and
+     * onto which ones (see setRequestFieldMask()).
+     */
+    bool _isProjected;
+    RequestFieldMask _requestFieldMask;
   };
 
 }
@@ -0,0 +1,101 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <sstream>
+// TraDemGen
+#include <trademgen/bom/DemandStream.hpp>
+#include <trademgen/bom/DemandStreamSchedule.hpp>
+
+namespace TRADEMGEN {
+
+  namespace {
+
+    /** Order of the demand streams on their opening date-times. */
+    bool isOpenedBefore (const DemandStreamSchedule::ScheduledDemandStream& iLHS,
+                         const DemandStreamSchedule::ScheduledDemandStream& iRHS) {
+      return iLHS._openingDateTime < iRHS._openingDateTime;
+    }
+
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  DemandStreamSchedule::DemandStreamSchedule()
+    : _nextIdx (0), _nbOfRetiredDemandStreams (0),
+      _demandGenerationMethod (stdair::DemandGenerationMethod::STA_ORD) {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  DemandStreamSchedule::DemandStreamSchedule (const DemandStreamSchedule&)
+    : _nextIdx (0), _nbOfRetiredDemandStreams (0),
+      _demandGenerationMethod (stdair::DemandGenerationMethod::STA_ORD) {
+    assert (false);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  DemandStreamSchedule::~DemandStreamSchedule() {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void DemandStreamSchedule::
+  add (const ScheduledDemandStream& iScheduledDemandStream,
+       const CompiledDemandModelPtr_T& iCompiledDemandModel_ptr) {
+    assert (iScheduledDemandStream._compiledDemandModel
+            == iCompiledDemandModel_ptr.get());
+
+    if (_compiledDemandModelList.empty() == true
+        || _compiledDemandModelList.back() != iCompiledDemandModel_ptr) {
+      _compiledDemandModelList.push_back (iCompiledDemandModel_ptr);
+    }
+    _scheduledList.push_back (iScheduledDemandStream);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void DemandStreamSchedule::sort() {
+    std::stable_sort (_scheduledList.begin(), _scheduledList.end(),
+                      isOpenedBefore);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void DemandStreamSchedule::
+  rewind (const stdair::DemandGenerationMethod& iDemandGenerationMethod) {
+    _nextIdx = 0;
+    _openList.clear();
+    _nbOfRetiredDemandStreams = 0;
+    _demandGenerationMethod = iDemandGenerationMethod.getMethod();
+    _breakPoint_ptr.reset();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const DemandStreamSchedule::ScheduledDemandStream&
+  DemandStreamSchedule::popNextDemandStream() {
+    assert (hasNextDemandStream() == true);
+    return _scheduledList[_nextIdx++];
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void DemandStreamSchedule::addOpenDemandStream (DemandStream& ioDemandStream) {
+    _openList.push_back (&ioDemandStream);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void DemandStreamSchedule::clear() {
+    _compiledDemandModelList.clear();
+    _scheduledList.clear();
+    _nextIdx = 0;
+    _openList.clear();
+    _nbOfRetiredDemandStreams = 0;
+    _breakPoint_ptr.reset();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const std::string DemandStreamSchedule::describe() const {
+    std::ostringstream oStr;
+    oStr << _nextIdx << "/" << _scheduledList.size() << " demand stream(s) "
+         << "opened, " << _openList.size() << " open and "
+         << _nbOfRetiredDemandStreams << " retired";
+    return oStr.str();
+  }
+
+}
@@ -0,0 +1,221 @@
+#ifndef __TRADEMGEN_BOM_DEMANDSTREAMSCHEDULE_HPP
+#define __TRADEMGEN_BOM_DEMANDSTREAMSCHEDULE_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <string>
+#include <vector>
+// StdAir
+#include <stdair/stdair_basic_types.hpp>
+#include <stdair/stdair_demand_types.hpp>
+#include <stdair/stdair_maths_types.hpp>
+#include <stdair/stdair_date_time_types.hpp>
+#include <stdair/basic/DemandGenerationMethod.hpp>
+#include <stdair/basic/StructAbstract.hpp>
+#include <stdair/bom/BreakPointTypes.hpp>
+// TraDemGen
+#include <trademgen/command/CompiledDemandModel.hpp>
+
+namespace TRADEMGEN {
+
+  // Forward declarations
+  class DemandStream;
+
+  /**
+   * @brief Schedule of the demand streams, for the rolling-horizon
+   *        demand generation.
+   *
+   * Rather than being all created when the demand input files are
+   * loaded, the demand streams are only scheduled: each of them is
+   * recorded (compiled demand, preferred departure date, seeds and
+   * total number of requests) along with its opening date-time, i.e.,
+   * the earliest date-time at which it may give a booking request
+   * (preferred departure date minus the largest number of days to
+   * departure of its arrival pattern). The demand streams are then
+   * created when the simulation clock reaches their opening date-time,
+   * and retired as soon as they have no booking request lying in the
+   * event queue anymore (see DemandManager::advanceRollingHorizon()).
+   *
+   * Hence, the memory taken by the demand streams follows the open
+   * booking window, rather than the whole simulation horizon.
+   */
+  class DemandStreamSchedule : public stdair::StructAbstract {
+  public:
+    // ////////// Type definitions /////////
+    /** Demand stream waiting for its opening date-time. */
+    struct ScheduledDemandStream {
+      stdair::DateTime_T _openingDateTime;
+      const CompiledDemandModel* _compiledDemandModel;
+      std::size_t _demandIdx;
+      stdair::Date_T _preferredDepartureDate;
+      stdair::RandomSeed_T _requestDateTimeSeed;
+      stdair::RandomSeed_T _demandCharacteristicsSeed;
+      stdair::NbOfRequests_T _totalNumberOfRequests;
+      stdair::RealNumber_T _samplingWeight;
+      bool _isFiltered;
+    };
+
+    /** List of scheduled demand streams. */
+    typedef std::vector<ScheduledDemandStream> ScheduledDemandStreamList_T;
+
+    /** List of open demand streams. */
+    typedef std::vector<DemandStream*> OpenDemandStreamList_T;
+
+
+  public:
+    // ////////// Getters /////////
+    /** State whether no demand stream has been scheduled. */
+    bool isEmpty() const {
+      return _scheduledList.empty();
+    }
+
+    /** Get the number of scheduled demand streams. */
+    std::size_t getNbOfScheduledDemandStreams() const {
+      return _scheduledList.size();
+    }
+
+    /** State whether some demand streams are still to be opened. */
+    bool hasNextDemandStream() const {
+      return _nextIdx != _scheduledList.size();
+    }
+
+    /** Get the opening date-time of the next demand stream to be opened. */
+    const stdair::DateTime_T& getNextOpeningDateTime() const {
+      assert (hasNextDemandStream() == true);
+      return _scheduledList[_nextIdx]._openingDateTime;
+    }
+
+    /** Get the scheduled demand streams, in the order of their opening. */
+    ScheduledDemandStreamList_T& getScheduledDemandStreamList() {
+      return _scheduledList;
+    }
+
+    /** Get the open (i.e., created and not retired yet) demand streams. */
+    const OpenDemandStreamList_T& getOpenDemandStreamList() const {
+      return _openList;
+    }
+
+    /** Get the number of demand streams retired since the start. */
+    const stdair::Count_T& getNbOfRetiredDemandStreams() const {
+      return _nbOfRetiredDemandStreams;
+    }
+
+    /** Get the method used to generate the booking requests. */
+    stdair::DemandGenerationMethod getDemandGenerationMethod() const {
+      return stdair::DemandGenerationMethod (_demandGenerationMethod);
+    }
+
+    /**
+     * Get the break point standing, within the event queue, for the
+     * next opening date-time (NULL when none).
+     */
+    const stdair::BreakPointPtr_T& getBreakPoint() const {
+      return _breakPoint_ptr;
+    }
+
+
+  public:
+    // ////////// Setters /////////
+    /** Set the break point standing for the next opening date-time. */
+    void setBreakPoint (const stdair::BreakPointPtr_T& iBreakPoint_ptr) {
+      _breakPoint_ptr = iBreakPoint_ptr;
+    }
+
+
+  public:
+    // ////////// Constructors and destructors /////////
+    /** Default constructor (empty schedule). */
+    DemandStreamSchedule();
+    /** Destructor. */
+    ~DemandStreamSchedule();
+  private:
+    /** Copy constructor (not to be used). */
+    DemandStreamSchedule (const DemandStreamSchedule&);
+
+
+  public:
+    // /////////////// Business Methods //////////
+    /**
+     * Schedule the given demand stream. The compiled demand model is
+     * kept alive as long as the schedule.
+     */
+    void add (const ScheduledDemandStream&, const CompiledDemandModelPtr_T&);
+
+    /**
+     * Sort the demand streams on their opening date-times, keeping the
+     * order in which they have been added for the same date-time.
+     */
+    void sort();
+
+    /**
+     * Go back to the start of the schedule, for the given demand
+     * generation method. The open demand streams are forgotten, and
+     * are to be retired beforehand.
+     */
+    void rewind (const stdair::DemandGenerationMethod&);
+
+    /** Get the next demand stream to be opened, and move on to the next. */
+    const ScheduledDemandStream& popNextDemandStream();
+
+    /** Record that the given demand stream has been opened. */
+    void addOpenDemandStream (DemandStream&);
+
+    /**
+     * Forget about the open demand streams for which the given
+     * predicate holds, and count them as retired.
+     *
+     * @return stdair::Count_T Number of forgotten demand streams.
+     */
+    template <typename PREDICATE>
+    stdair::Count_T removeOpenDemandStreams (PREDICATE iPredicate) {
+      OpenDemandStreamList_T::iterator itEnd =
+        std::remove_if (_openList.begin(), _openList.end(), iPredicate);
+      const stdair::Count_T oNbOfRemovedDemandStreams =
+        std::distance (itEnd, _openList.end());
+      _openList.erase (itEnd, _openList.end());
+      _nbOfRetiredDemandStreams += oNbOfRemovedDemandStreams;
+      return oNbOfRemovedDemandStreams;
+    }
+
+    /** Forget about the schedule. */
+    void clear();
+
+
+  public:
+    // ////////////// Display Support Methods //////////
+    /** Give a description of the structure (for display purposes). */
+    const std::string describe() const;
+
+
+  private:
+    // ////////// Attributes //////////
+    /** Compiled demand models, which the scheduled demand streams refer to. */
+    CompiledDemandModelList_T _compiledDemandModelList;
+
+    /** Scheduled demand streams, in the order of their opening. */
+    ScheduledDemandStreamList_T _scheduledList;
+
+    /** Position of the next demand stream to be opened. */
+    std::size_t _nextIdx;
+
+    /** Open demand streams (not owned). */
+    OpenDemandStreamList_T _openList;
+
+    /** Number of demand streams retired since the start. */
+    stdair::Count_T _nbOfRetiredDemandStreams;
+
+    /** Method used to generate the booking requests. */
+    stdair::DemandGenerationMethod::EN_DemandGenerationMethod
+    _demandGenerationMethod;
+
+    /** Break point standing for the next opening date-time, if any. */
+    stdair::BreakPointPtr_T _breakPoint_ptr;
+  };
+
+}
+#endif // __TRADEMGEN_BOM_DEMANDSTREAMSCHEDULE_HPP
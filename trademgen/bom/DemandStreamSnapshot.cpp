@@ -0,0 +1,519 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+// Boost
+#include <boost/cstdint.hpp>
+#include <boost/make_shared.hpp>
+// StdAir
+#include <stdair/bom/BookingRequestStruct.hpp>
+#include <stdair/service/Logger.hpp>
+// TraDemGen
+#include <trademgen/TRADEMGEN_Exceptions.hpp>
+#include <trademgen/basic/BasConst_DemandSnapshot.hpp>
+#include <trademgen/bom/DemandStream.hpp>
+#include <trademgen/bom/DemandStreamSnapshot.hpp>
+
+namespace TRADEMGEN {
+
+  namespace {
+
+    /** Header of the checkpoint files. */
+    struct Header {
+      char _magic[DEMAND_SNAPSHOT_MAGIC_SIZE];
+      boost::uint32_t _version;
+      boost::uint32_t _byteOrderMark;
+      boost::uint64_t _nbOfDemandStreams;
+      boost::uint64_t _nbOfPendingRequests;
+      boost::int64_t _actualNbOfEvents;
+    };
+
+    /** Reference date-time, from which the date-times are counted. */
+    const stdair::DateTime_T K_EPOCH (stdair::Date_T (1970, 1, 1));
+
+    // //////////////////////////////////////////////////////////////////
+    /**
+     * Writer of the checkpoint files, remembering whether all the
+     * writes have succeeded so far.
+     */
+    class Writer {
+    public:
+      Writer (std::FILE* ioFile) : _file (ioFile), _isValid (true) {}
+
+      bool isValid() const { return _isValid; }
+
+      void write (const void* iData, const std::size_t iSize) {
+        _isValid = _isValid
+          && (iSize == 0 || std::fwrite (iData, 1, iSize, _file) == iSize);
+      }
+
+      template <typename T> void writeValue (const T& iValue) {
+        write (&iValue, sizeof (T));
+      }
+
+      template <typename T> void writeArray (const std::vector<T>& iArray) {
+        write (iArray.empty() ? NULL : &iArray[0], iArray.size() * sizeof (T));
+      }
+
+      void writeString (const std::string& iString) {
+        writeValue (static_cast<boost::uint32_t> (iString.size()));
+        write (iString.data(), iString.size());
+      }
+
+      void writeGenerator (const stdair::BaseGenerator_T& iGenerator) {
+        std::ostringstream oStr;
+        oStr << iGenerator;
+        writeString (oStr.str());
+      }
+
+    private:
+      std::FILE* _file;
+      bool _isValid;
+    };
+
+    // //////////////////////////////////////////////////////////////////
+    /**
+     * Reader of the checkpoint files, remembering whether all the
+     * reads have succeeded so far.
+     */
+    class Reader {
+    public:
+      Reader (std::FILE* ioFile) : _file (ioFile), _isValid (true) {}
+
+      bool isValid() const { return _isValid; }
+
+      void read (void* oData, const std::size_t iSize) {
+        _isValid = _isValid
+          && (iSize == 0 || std::fread (oData, 1, iSize, _file) == iSize);
+      }
+
+      template <typename T> T readValue() {
+        T oValue = T();
+        read (&oValue, sizeof (T));
+        return oValue;
+      }
+
+      template <typename T> void readArray (std::vector<T>& ioArray,
+                                            const std::size_t iSize) {
+        ioArray.resize (iSize);
+        read (ioArray.empty() ? NULL : &ioArray[0], iSize * sizeof (T));
+      }
+
+      std::string readString() {
+        const boost::uint32_t lSize = readValue<boost::uint32_t>();
+        // A string never exceeds the size of a demand stream key
+        if (lSize > 1024) {
+          _isValid = false;
+        }
+        std::string oString (_isValid == true ? lSize : 0, '\0');
+        read (oString.empty() ? NULL : &oString[0], oString.size());
+        return oString;
+      }
+
+      stdair::BaseGenerator_T readGenerator() {
+        stdair::BaseGenerator_T oGenerator;
+        std::istringstream iStr (readString());
+        iStr >> oGenerator;
+        _isValid = _isValid && (iStr.fail() == false);
+        return oGenerator;
+      }
+
+    private:
+      std::FILE* _file;
+      bool _isValid;
+    };
+
+    // //////////////////////////////////////////////////////////////////
+    void writeBookingRequest (Writer& ioWriter,
+                              const stdair::BookingRequestStruct& iRequest) {
+      ioWriter.writeString (iRequest.getDemandGeneratorKey());
+      ioWriter.writeString (iRequest.getOrigin());
+      ioWriter.writeString (iRequest.getDestination());
+      ioWriter.writeString (iRequest.getPOS());
+      ioWriter.writeValue (static_cast<boost::int64_t>
+                           ((iRequest.getPreferedDepartureDate()
+                             - K_EPOCH.date()).days()));
+      ioWriter.writeValue (static_cast<boost::int64_t>
+                           ((iRequest.getRequestDateTime() - K_EPOCH).
+                            total_microseconds()));
+      ioWriter.writeString (iRequest.getPreferredCabin());
+      ioWriter.writeValue (static_cast<double> (iRequest.getPartySize()));
+      ioWriter.writeString (iRequest.getBookingChannel());
+      ioWriter.writeString (iRequest.getTripType());
+      ioWriter.writeValue (static_cast<boost::int32_t>
+                           (iRequest.getStayDuration()));
+      ioWriter.writeString (iRequest.getFrequentFlyerType());
+      ioWriter.writeValue (static_cast<boost::int64_t>
+                           (iRequest.getPreferredDepartureTime().
+                            total_microseconds()));
+      ioWriter.writeValue (static_cast<double> (iRequest.getWTP()));
+      ioWriter.writeValue (static_cast<double> (iRequest.getValueOfTime()));
+      ioWriter.writeValue (static_cast<boost::uint8_t>
+                           (iRequest.getChangeFees()));
+      ioWriter.writeValue (static_cast<double>
+                           (iRequest.getChangeFeeDisutility()));
+      ioWriter.writeValue (static_cast<boost::uint8_t>
+                           (iRequest.getNonRefundable()));
+      ioWriter.writeValue (static_cast<double>
+                           (iRequest.getNonRefundableDisutility()));
+    }
+
+    // //////////////////////////////////////////////////////////////////
+    stdair::BookingRequestPtr_T readBookingRequest (Reader& ioReader) {
+      const std::string lKey = ioReader.readString();
+      const std::string lOrigin = ioReader.readString();
+      const std::string lDestination = ioReader.readString();
+      const std::string lPOS = ioReader.readString();
+      const stdair::Date_T lPreferredDepartureDate =
+        K_EPOCH.date() + boost::gregorian::days (ioReader.
+                                                 readValue<boost::int64_t>());
+      const stdair::DateTime_T lRequestDateTime =
+        K_EPOCH + boost::posix_time::microseconds (ioReader.
+                                                   readValue<boost::int64_t>());
+      const std::string lPreferredCabin = ioReader.readString();
+      const double lPartySize = ioReader.readValue<double>();
+      const std::string lChannel = ioReader.readString();
+      const std::string lTripType = ioReader.readString();
+      const boost::int32_t lStayDuration = ioReader.readValue<boost::int32_t>();
+      const std::string lFrequentFlyer = ioReader.readString();
+      const stdair::Duration_T lPreferredDepartureTime =
+        boost::posix_time::microseconds (ioReader.readValue<boost::int64_t>());
+      const double lWTP = ioReader.readValue<double>();
+      const double lValueOfTime = ioReader.readValue<double>();
+      const bool lChangeFees = (ioReader.readValue<boost::uint8_t>() != 0);
+      const double lChangeFeeDisutility = ioReader.readValue<double>();
+      const bool lNonRefundable = (ioReader.readValue<boost::uint8_t>() != 0);
+      const double lNonRefundableDisutility = ioReader.readValue<double>();
+
+      if (ioReader.isValid() == false) {
+        return stdair::BookingRequestPtr_T();
+      }
+
+      return boost::make_shared<stdair::BookingRequestStruct>
+        (lKey, lOrigin, lDestination, lPOS, lPreferredDepartureDate,
+         lRequestDateTime, lPreferredCabin, lPartySize, lChannel, lTripType,
+         lStayDuration, lFrequentFlyer, lPreferredDepartureTime, lWTP,
+         lValueOfTime, lChangeFees, lChangeFeeDisutility, lNonRefundable,
+         lNonRefundableDisutility);
+    }
+
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  DemandStreamSnapshot::DemandStreamSnapshot() : _actualNbOfEvents (0) {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  DemandStreamSnapshot::DemandStreamSnapshot (const DemandStreamSnapshot&)
+    : _actualNbOfEvents (0) {
+    assert (false);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  DemandStreamSnapshot::~DemandStreamSnapshot() {
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void DemandStreamSnapshot::
+  take (const DemandStreamList_T& iDemandStreamList,
+        const stdair::BaseGenerator_T& iSharedGenerator,
+        const stdair::Count_T& iActualNbOfEvents,
+        const bool iIsReference) {
+    clear();
+
+    const std::size_t lNbOfDemandStreams = iDemandStreamList.size();
+    _demandStreamList.reserve (lNbOfDemandStreams);
+    _totalList.reserve (lNbOfDemandStreams);
+    _nbOfRequestsList.reserve (lNbOfDemandStreams);
+    _cumulativeProbabilityList.reserve (lNbOfDemandStreams);
+    _dateTimeLastRequestList.reserve (lNbOfDemandStreams);
+    _stillHavingRequestsList.reserve (lNbOfDemandStreams);
+    _firstDateTimeRequestList.reserve (lNbOfDemandStreams);
+    _runNumberList.reserve (lNbOfDemandStreams);
+    _requestDateTimeGeneratorList.reserve (lNbOfDemandStreams);
+    _demandCharacteristicsGeneratorList.reserve (lNbOfDemandStreams);
+    _pendingRequestList.reserve (lNbOfDemandStreams);
+
+    for (DemandStreamList_T::const_iterator itDemandStream =
+           iDemandStreamList.begin();
+         itDemandStream != iDemandStreamList.end(); ++itDemandStream) {
+      DemandStream* lDemandStream_ptr = *itDemandStream;
+      assert (lDemandStream_ptr != NULL);
+      DemandStream& lDemandStream = *lDemandStream_ptr;
+
+      const RandomGenerationContext& lContext =
+        lDemandStream._randomGenerationContext;
+      _demandStreamList.push_back (lDemandStream_ptr);
+      _totalList.push_back (lDemandStream._totalNumberOfRequestsToBeGenerated);
+      _nbOfRequestsList.
+        push_back (lContext.getNumberOfRequestsGeneratedSoFar());
+      _cumulativeProbabilityList.
+        push_back (lContext.getCumulativeProbabilitySoFar());
+      _dateTimeLastRequestList.push_back (lDemandStream._dateTimeLastRequest);
+      _stillHavingRequestsList.
+        push_back (lDemandStream._stillHavingRequestsToBeGenerated);
+      _firstDateTimeRequestList.
+        push_back (lDemandStream._firstDateTimeRequest);
+      _runNumberList.push_back (lDemandStream._runNumber);
+      _requestDateTimeGeneratorList.
+        push_back (lDemandStream._requestDateTimeRandomGenerator.
+                   getBaseGenerator());
+      _demandCharacteristicsGeneratorList.
+        push_back (lDemandStream._demandCharacteristicsRandomGenerator.
+                   getBaseGenerator());
+      _pendingRequestList.push_back (lDemandStream._pendingRequest);
+
+      // From now on, the demand stream is in the state of the snapshot
+      if (iIsReference == true) {
+        lDemandStream._isDirty = false;
+      }
+    }
+
+    _sharedGenerator = iSharedGenerator;
+    _actualNbOfEvents = iActualNbOfEvents;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  stdair::Count_T DemandStreamSnapshot::
+  restore (stdair::BaseGenerator_T& ioSharedGenerator,
+           const bool iOnlyDirty) {
+    stdair::Count_T oNbOfRestoredDemandStreams = 0;
+
+    const std::size_t lNbOfDemandStreams = _demandStreamList.size();
+    for (std::size_t idx = 0; idx != lNbOfDemandStreams; ++idx) {
+      DemandStream* lDemandStream_ptr = _demandStreamList[idx];
+      assert (lDemandStream_ptr != NULL);
+      DemandStream& lDemandStream = *lDemandStream_ptr;
+
+      // Nothing to be done when the demand stream has not been used
+      if (iOnlyDirty == true && lDemandStream._isDirty == false) {
+        continue;
+      }
+
+      RandomGenerationContext& lContext =
+        lDemandStream._randomGenerationContext;
+      lDemandStream._totalNumberOfRequestsToBeGenerated = _totalList[idx];
+      lContext.setNumberOfRequestsGeneratedSoFar (_nbOfRequestsList[idx]);
+      lContext.setCumulativeProbabilitySoFar (_cumulativeProbabilityList[idx]);
+      lDemandStream._dateTimeLastRequest = _dateTimeLastRequestList[idx];
+      lDemandStream._stillHavingRequestsToBeGenerated =
+        (_stillHavingRequestsList[idx] != 0);
+      lDemandStream._firstDateTimeRequest =
+        (_firstDateTimeRequestList[idx] != 0);
+      lDemandStream._runNumber = _runNumberList[idx];
+      lDemandStream._requestDateTimeRandomGenerator.getBaseGenerator() =
+        _requestDateTimeGeneratorList[idx];
+      lDemandStream._demandCharacteristicsRandomGenerator.getBaseGenerator() =
+        _demandCharacteristicsGeneratorList[idx];
+      lDemandStream._pendingRequest = _pendingRequestList[idx];
+
+      // The state of a demand stream restored from another snapshot
+      // may differ from the one of the reference snapshot
+      lDemandStream._isDirty = (iOnlyDirty == false);
+      ++oNbOfRestoredDemandStreams;
+    }
+
+    ioSharedGenerator = _sharedGenerator;
+
+    return oNbOfRestoredDemandStreams;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void DemandStreamSnapshot::save (const stdair::Filename_T& iFilename) const {
+    std::FILE* lFile = std::fopen (iFilename.c_str(), "wb");
+    if (lFile == NULL) {
+      std::ostringstream oMessage;
+      oMessage << "The checkpoint file '" << iFilename
+               << "' cannot be opened for writing";
+      throw DemandSnapshotException (oMessage.str());
+    }
+
+    // Header
+    const std::size_t lNbOfDemandStreams = _demandStreamList.size();
+    Header lHeader;
+    std::memcpy (lHeader._magic, DEMAND_SNAPSHOT_MAGIC,
+                 DEMAND_SNAPSHOT_MAGIC_SIZE);
+    lHeader._version = DEMAND_SNAPSHOT_VERSION;
+    lHeader._byteOrderMark = DEMAND_SNAPSHOT_BYTE_ORDER_MARK;
+    lHeader._nbOfDemandStreams = lNbOfDemandStreams;
+    lHeader._nbOfPendingRequests = 0;
+    for (std::size_t idx = 0; idx != lNbOfDemandStreams; ++idx) {
+      if (_pendingRequestList[idx] != NULL) {
+        ++lHeader._nbOfPendingRequests;
+      }
+    }
+    lHeader._actualNbOfEvents = _actualNbOfEvents;
+
+    Writer lWriter (lFile);
+    lWriter.writeValue (lHeader);
+    lWriter.writeGenerator (_sharedGenerator);
+
+    // Generation state of the demand streams, column by column, the keys
+    // coming first, so that they can be checked before anything else
+    for (std::size_t idx = 0; idx != lNbOfDemandStreams; ++idx) {
+      const DemandStream* lDemandStream_ptr = _demandStreamList[idx];
+      assert (lDemandStream_ptr != NULL);
+      lWriter.writeString (lDemandStream_ptr->describeKey());
+    }
+    lWriter.writeArray (_totalList);
+    lWriter.writeArray (_nbOfRequestsList);
+    lWriter.writeArray (_cumulativeProbabilityList);
+    lWriter.writeArray (_dateTimeLastRequestList);
+    lWriter.writeArray (_stillHavingRequestsList);
+    lWriter.writeArray (_firstDateTimeRequestList);
+    lWriter.writeArray (_runNumberList);
+    for (std::size_t idx = 0; idx != lNbOfDemandStreams; ++idx) {
+      lWriter.writeGenerator (_requestDateTimeGeneratorList[idx]);
+      lWriter.writeGenerator (_demandCharacteristicsGeneratorList[idx]);
+    }
+
+    // Booking requests lying in the event queue
+    for (std::size_t idx = 0; idx != lNbOfDemandStreams; ++idx) {
+      const stdair::BookingRequestPtr_T& lRequest_ptr =
+        _pendingRequestList[idx];
+      if (lRequest_ptr != NULL) {
+        lWriter.writeValue (static_cast<boost::uint64_t> (idx));
+        writeBookingRequest (lWriter, *lRequest_ptr);
+      }
+    }
+
+    const bool isWritten = (std::fclose (lFile) == 0) && lWriter.isValid();
+    if (isWritten == false) {
+      std::ostringstream oMessage;
+      oMessage << "The checkpoint could not be fully written into '"
+               << iFilename << "'";
+      throw DemandSnapshotException (oMessage.str());
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void DemandStreamSnapshot::
+  load (const stdair::Filename_T& iFilename,
+        const DemandStreamList_T& iDemandStreamList) {
+    clear();
+
+    std::FILE* lFile = std::fopen (iFilename.c_str(), "rb");
+    if (lFile == NULL) {
+      std::ostringstream oMessage;
+      oMessage << "The checkpoint file '" << iFilename
+               << "' cannot be opened for reading";
+      STDAIR_LOG_ERROR (oMessage.str());
+      throw DemandSnapshotException (oMessage.str());
+    }
+
+    // Header
+    Reader lReader (lFile);
+    const Header lHeader = lReader.readValue<Header>();
+    std::ostringstream oMessage;
+    if (lReader.isValid() == false
+        || std::memcmp (lHeader._magic, DEMAND_SNAPSHOT_MAGIC,
+                        DEMAND_SNAPSHOT_MAGIC_SIZE) != 0) {
+      oMessage << "The file '" << iFilename << "' is not a checkpoint file";
+
+    } else if (lHeader._byteOrderMark != DEMAND_SNAPSHOT_BYTE_ORDER_MARK) {
+      oMessage << "The checkpoint '" << iFilename << "' has been written on "
+               << "a machine having another byte order";
+
+    } else if (lHeader._version != DEMAND_SNAPSHOT_VERSION) {
+      oMessage << "The checkpoint '" << iFilename << "' follows the version "
+               << lHeader._version << " of the format, whereas the version "
+               << DEMAND_SNAPSHOT_VERSION << " is expected";
+
+    } else if (lHeader._nbOfDemandStreams != iDemandStreamList.size()
+               || lHeader._nbOfPendingRequests > lHeader._nbOfDemandStreams) {
+      oMessage << "The checkpoint '" << iFilename << "' holds "
+               << lHeader._nbOfDemandStreams << " demand stream(s), whereas "
+               << iDemandStreamList.size() << " of them have been loaded";
+    }
+
+    // Keys of the demand streams
+    const std::size_t lNbOfDemandStreams = iDemandStreamList.size();
+    _sharedGenerator = lReader.readGenerator();
+    DemandStreamList_T::const_iterator itDemandStream =
+      iDemandStreamList.begin();
+    for (std::size_t idx = 0;
+         idx != lNbOfDemandStreams && oMessage.str().empty() == true;
+         ++idx, ++itDemandStream) {
+      DemandStream* lDemandStream_ptr = *itDemandStream;
+      assert (lDemandStream_ptr != NULL);
+      const std::string lKey = lReader.readString();
+      if (lReader.isValid() == true
+          && lKey != lDemandStream_ptr->describeKey()) {
+        oMessage << "The demand stream #" << idx << " of the checkpoint '"
+                 << iFilename << "' is " << lKey << ", whereas "
+                 << lDemandStream_ptr->describeKey() << " has been loaded";
+      }
+      _demandStreamList.push_back (lDemandStream_ptr);
+    }
+
+    // Generation state of the demand streams
+    if (oMessage.str().empty() == true) {
+      lReader.readArray (_totalList, lNbOfDemandStreams);
+      lReader.readArray (_nbOfRequestsList, lNbOfDemandStreams);
+      lReader.readArray (_cumulativeProbabilityList, lNbOfDemandStreams);
+      lReader.readArray (_dateTimeLastRequestList, lNbOfDemandStreams);
+      lReader.readArray (_stillHavingRequestsList, lNbOfDemandStreams);
+      lReader.readArray (_firstDateTimeRequestList, lNbOfDemandStreams);
+      lReader.readArray (_runNumberList, lNbOfDemandStreams);
+      for (std::size_t idx = 0; idx != lNbOfDemandStreams; ++idx) {
+        _requestDateTimeGeneratorList.push_back (lReader.readGenerator());
+        _demandCharacteristicsGeneratorList.
+          push_back (lReader.readGenerator());
+      }
+
+      // Booking requests lying in the event queue
+      _pendingRequestList.resize (lNbOfDemandStreams);
+      for (boost::uint64_t lRequestIdx = 0;
+           lRequestIdx != lHeader._nbOfPendingRequests
+             && lReader.isValid() == true; ++lRequestIdx) {
+        const boost::uint64_t idx = lReader.readValue<boost::uint64_t>();
+        if (idx >= lNbOfDemandStreams) {
+          oMessage << "The checkpoint '" << iFilename << "' is corrupted "
+                   << "(pending request #" << lRequestIdx << ")";
+          break;
+        }
+        _pendingRequestList[idx] = readBookingRequest (lReader);
+      }
+      _actualNbOfEvents = lHeader._actualNbOfEvents;
+    }
+
+    std::fclose (lFile);
+
+    if (oMessage.str().empty() == true && lReader.isValid() == false) {
+      oMessage << "The checkpoint '" << iFilename << "' is truncated";
+    }
+    if (oMessage.str().empty() == false) {
+      clear();
+      STDAIR_LOG_ERROR (oMessage.str());
+      throw DemandSnapshotException (oMessage.str());
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void DemandStreamSnapshot::clear() {
+    _demandStreamList.clear();
+    _totalList.clear();
+    _nbOfRequestsList.clear();
+    _cumulativeProbabilityList.clear();
+    _dateTimeLastRequestList.clear();
+    _stillHavingRequestsList.clear();
+    _firstDateTimeRequestList.clear();
+    _runNumberList.clear();
+    _requestDateTimeGeneratorList.clear();
+    _demandCharacteristicsGeneratorList.clear();
+    _pendingRequestList.clear();
+    _actualNbOfEvents = 0;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  const std::string DemandStreamSnapshot::describe() const {
+    std::ostringstream oStr;
+    oStr << "Snapshot of " << _demandStreamList.size() << " demand stream(s)";
+    return oStr.str();
+  }
+
+}
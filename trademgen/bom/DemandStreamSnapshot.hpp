@@ -0,0 +1,195 @@
+#ifndef __TRADEMGEN_BOM_DEMANDSTREAMSNAPSHOT_HPP
+#define __TRADEMGEN_BOM_DEMANDSTREAMSNAPSHOT_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <string>
+#include <vector>
+// StdAir
+#include <stdair/stdair_basic_types.hpp>
+#include <stdair/stdair_demand_types.hpp>
+#include <stdair/stdair_maths_types.hpp>
+#include <stdair/stdair_date_time_types.hpp>
+#include <stdair/basic/StructAbstract.hpp>
+#include <stdair/bom/BookingRequestTypes.hpp>
+// TraDemGen
+#include <trademgen/bom/DemandStreamTypes.hpp>
+
+namespace TRADEMGEN {
+
+  /**
+   * @brief Snapshot of the generation state of all the demand streams.
+   *
+   * The generation state of a demand stream is made of the total
+   * number of requests to be generated, of the random generation
+   * context, of the run number and of the state of the random
+   * generators; the snapshot also keeps the state of the shared
+   * generator. It is stored column by column (one array per attribute,
+   * indexed by the position of the demand stream), and copied back only
+   * for the demand streams which have changed since (see
+   * DemandStream::isDirty()). Every demand stream is still visited. Moreover, the event-queue generation
+   * generates the first booking request of every demand stream having
+   * requests to generate (see DemandManager::generateFirstRequests()),
+   * so that all of those are copied back: only the demand streams left
+   * aside by the run (e.g., out of the shard, or not opened yet by the
+   * rolling-horizon generation) are skipped.
+   *
+   * When taken in the middle of a demand generation, the snapshot also
+   * keeps the booking requests lying in the event queue, so that the
+   * generation can be resumed from there. A snapshot can be saved into
+   * a (binary) checkpoint file, and loaded back, possibly by another
+   * process having loaded the same demand input files; as for the
+   * compiled demand models, the file can only be loaded on machines
+   * having the same byte order as the one having saved it.
+   */
+  class DemandStreamSnapshot : public stdair::StructAbstract {
+  public:
+    // ////////// Getters /////////
+    /** Get the number of demand streams of the snapshot. */
+    std::size_t getNbOfDemandStreams() const {
+      return _demandStreamList.size();
+    }
+
+    /** State whether no snapshot has been taken. */
+    bool isEmpty() const {
+      return _demandStreamList.empty();
+    }
+
+    /**
+     * Get the booking request which was lying in the event queue, for
+     * the demand stream at the given position (NULL when none).
+     */
+    const stdair::BookingRequestPtr_T&
+    getPendingRequest (const std::size_t iIdx) const {
+      return _pendingRequestList[iIdx];
+    }
+
+    /**
+     * Get the actual total number of booking requests to be generated,
+     * as known by the event queue when the snapshot was taken.
+     */
+    const stdair::Count_T& getActualNbOfEvents() const {
+      return _actualNbOfEvents;
+    }
+
+
+  public:
+    // ////////// Constructors and destructors /////////
+    /** Default constructor (empty snapshot). */
+    DemandStreamSnapshot();
+    /** Destructor. */
+    ~DemandStreamSnapshot();
+  private:
+    /** Copy constructor (not to be used). */
+    DemandStreamSnapshot (const DemandStreamSnapshot&);
+
+
+  public:
+    // /////////////// Business Methods //////////
+    /**
+     * Save the generation state of the given demand streams, and of the
+     * shared generator. The previous snapshot, if any, is discarded.
+     *
+     * @param const DemandStreamList_T& Demand streams.
+     * @param const stdair::BaseGenerator_T& Shared random generator.
+     * @param const stdair::Count_T& Actual total number of booking
+     *        requests to be generated, as known by the event queue.
+     * @param const bool Whether the demand streams are to be flagged as
+     *        being in the state of the snapshot (see
+     *        DemandStream::isDirty()). It should be so for one snapshot
+     *        only, i.e., the one which is restored in place.
+     */
+    void take (const DemandStreamList_T&, const stdair::BaseGenerator_T&,
+               const stdair::Count_T& iActualNbOfEvents,
+               const bool iIsReference);
+
+    /**
+     * Restore the generation state of the demand streams, and that of
+     * the shared generator.
+     *
+     * @param stdair::BaseGenerator_T& Shared random generator.
+     * @param const bool Whether only the demand streams which have
+     *        changed since the snapshot was taken are to be restored.
+     *        Otherwise (e.g., for a snapshot loaded from a checkpoint
+     *        file), all of them are restored, and flagged as dirty.
+     * @return stdair::Count_T Number of restored demand streams.
+     */
+    stdair::Count_T restore (stdair::BaseGenerator_T&,
+                             const bool iOnlyDirty);
+
+    /**
+     * Save the snapshot into the given (checkpoint) file.
+     *
+     * @param const stdair::Filename_T& Name of the checkpoint file.
+     * @throw DemandSnapshotException when the file cannot be written.
+     */
+    void save (const stdair::Filename_T&) const;
+
+    /**
+     * Load the snapshot saved into the given (checkpoint) file, for the
+     * given demand streams. The previous snapshot, if any, is discarded.
+     *
+     * @param const stdair::Filename_T& Name of the checkpoint file.
+     * @param const DemandStreamList_T& Demand streams, which must be the
+     *        same (and in the same order) as the ones of the snapshot.
+     * @throw DemandSnapshotException when the file cannot be read, is
+     *        corrupted, or corresponds to other demand streams.
+     */
+    void load (const stdair::Filename_T&, const DemandStreamList_T&);
+
+    /** Forget about the snapshot. */
+    void clear();
+
+
+  public:
+    // ////////////// Display Support Methods //////////
+    /** Give a description of the structure (for display purposes). */
+    const std::string describe() const;
+
+
+  private:
+    // ////////// Attributes //////////
+    /** Demand streams (not owned). */
+    std::vector<DemandStream*> _demandStreamList;
+
+    /** Total numbers of requests to be generated. */
+    std::vector<stdair::NbOfRequests_T> _totalList;
+
+    /** Numbers of requests generated so far. */
+    std::vector<stdair::Count_T> _nbOfRequestsList;
+
+    /** Cumulative probabilities of the last generated requests. */
+    std::vector<stdair::Probability_T> _cumulativeProbabilityList;
+
+    /** Date-times of the last generated requests (Poisson process). */
+    std::vector<stdair::FloatDuration_T> _dateTimeLastRequestList;
+
+    /** Whether there are still requests to be generated (Poisson process). */
+    std::vector<unsigned char> _stillHavingRequestsList;
+
+    /** Whether no request has been generated yet. */
+    std::vector<unsigned char> _firstDateTimeRequestList;
+
+    /** Numbers of runs since the seeds of the demand characteristics. */
+    std::vector<stdair::Count_T> _runNumberList;
+
+    /** States of the random generators for the request date-times. */
+    std::vector<stdair::BaseGenerator_T> _requestDateTimeGeneratorList;
+
+    /** States of the random generators for the demand characteristics. */
+    std::vector<stdair::BaseGenerator_T> _demandCharacteristicsGeneratorList;
+
+    /** Booking requests lying in the event queue (NULL when none). */
+    std::vector<stdair::BookingRequestPtr_T> _pendingRequestList;
+
+    /** State of the shared generator. */
+    stdair::BaseGenerator_T _sharedGenerator;
+
+    /** Actual total number of booking requests to be generated. */
+    stdair::Count_T _actualNbOfEvents;
+  };
+
+}
+#endif // __TRADEMGEN_BOM_DEMANDSTREAMSNAPSHOT_HPP
@@ -0,0 +1,214 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <sstream>
+// TraDemGen
+#include <trademgen/TRADEMGEN_Exceptions.hpp>
+#include <trademgen/command/BlockFileWriter.hpp>
+
+namespace TRADEMGEN {
+
+  // //////////////////////////////////////////////////////////////////////
+  BlockFileWriter::BlockFileWriter (const stdair::Filename_T& iFilename,
+                                    const std::size_t iBlockSize,
+                                    const unsigned short iNbOfBlocks)
+    : _filename (iFilename), _file (NULL),
+      _blocks ((iNbOfBlocks == 0)?1:iNbOfBlocks,
+               std::vector<char> ((iBlockSize == 0)?1:iBlockSize)),
+      _currentBlockIdx (0), _isWriting (false), _isStopping (false) {
+
+    //
+    _file = std::fopen (_filename.c_str(), "wb");
+    if (_file == NULL) {
+      std::ostringstream oMessage;
+      oMessage << "The output file '" << _filename
+               << "' cannot be opened for writing";
+      throw RequestOutputException (oMessage.str());
+    }
+
+    // The full blocks are written at once; the C library does not need
+    // to buffer anything on its own.
+    std::setvbuf (_file, NULL, _IONBF, 0);
+
+    // All the blocks but the first one (i.e., the one to be filled
+    // first) are free
+    for (std::size_t idx = 1; idx != _blocks.size(); ++idx) {
+      _freeBlocks.push_back (idx);
+    }
+
+    // In the asynchronous mode, the blocks are written by a dedicated thread
+    if (isAsynchronous() == true) {
+      _ioThread = std::thread (&BlockFileWriter::drainBlocks, this);
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  BlockFileWriter::~BlockFileWriter() {
+    // Best effort: a destructor must not throw
+    if (_file != NULL) {
+      stopAndClose();
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool BlockFileWriter::writeChars (const char* iChars, const std::size_t iSize) {
+    assert (_file != NULL);
+    const std::size_t lNbOfWrittenChars = std::fwrite (iChars, 1, iSize, _file);
+    return (lNbOfWrittenChars == iSize);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void BlockFileWriter::checkIOError() {
+    // Note: the mutex is expected to be held by the caller
+    if (_ioErrorMessage.empty() == false) {
+      throw RequestOutputException (_ioErrorMessage);
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  char* BlockFileWriter::submitBlock (const std::size_t iSize) {
+    // Sanity check
+    assert (_file != NULL && iSize <= getBlockSize());
+
+    // Synchronous mode: the block is written straight away, and can then
+    // be filled again
+    if (isAsynchronous() == false) {
+      if (iSize != 0 && writeChars (getBlock(), iSize) == false) {
+        std::ostringstream oMessage;
+        oMessage << "Only part of the " << iSize << " characters could be "
+                 << "written into '" << _filename << "'";
+        throw RequestOutputException (oMessage.str());
+      }
+      return getBlock();
+    }
+
+    // Asynchronous mode
+    std::unique_lock<std::mutex> lLock (_mutex);
+    checkIOError();
+
+    // Nothing to write: the same block can still be filled
+    if (iSize == 0) {
+      return getBlock();
+    }
+
+    // Hand over the block to the I/O thread
+    _submittedBlocks.push_back (std::make_pair (_currentBlockIdx, iSize));
+    _hasSubmittedBlock.notify_one();
+
+    // Backpressure: wait until a block is free
+    _hasWrittenBlock.wait (lLock, [this] () {
+        return (_freeBlocks.empty() == false
+                || _ioErrorMessage.empty() == false);
+      });
+    checkIOError();
+
+    _currentBlockIdx = _freeBlocks.back();
+    _freeBlocks.pop_back();
+    return getBlock();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  char* BlockFileWriter::enlargeBlock (const std::size_t iSize) {
+    // The block being filled is owned by the caller; it can thus be
+    // resized without any synchronisation
+    std::vector<char>& lBlock = _blocks[_currentBlockIdx];
+    if (lBlock.size() < iSize) {
+      lBlock.resize (iSize);
+    }
+    return getBlock();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void BlockFileWriter::flush() {
+    if (isAsynchronous() == false) {
+      return;
+    }
+
+    std::unique_lock<std::mutex> lLock (_mutex);
+    _hasWrittenBlock.wait (lLock, [this] () {
+        return ((_submittedBlocks.empty() == true && _isWriting == false)
+                || _ioErrorMessage.empty() == false);
+      });
+    checkIOError();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void BlockFileWriter::close() {
+    if (_file == NULL) {
+      return;
+    }
+    stopAndClose();
+
+    std::unique_lock<std::mutex> lLock (_mutex);
+    checkIOError();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void BlockFileWriter::stopAndClose() {
+    // Let the I/O thread write the remaining submitted blocks, and stop
+    if (_ioThread.joinable() == true) {
+      {
+        std::unique_lock<std::mutex> lLock (_mutex);
+        _isStopping = true;
+      }
+      _hasSubmittedBlock.notify_one();
+      _ioThread.join();
+    }
+
+    // The last buffered characters are written out by fclose(), which may
+    // therefore fail (e.g., ENOSPC or EIO deferred until then)
+    const bool isClosed = (std::fclose (_file) == 0);
+    _file = NULL;
+    if (isClosed == false) {
+      std::unique_lock<std::mutex> lLock (_mutex);
+      if (_ioErrorMessage.empty() == true) {
+        std::ostringstream oMessage;
+        oMessage << "The file '" << _filename << "' could not be closed "
+                 << "properly: its last characters may not have been written";
+        _ioErrorMessage = oMessage.str();
+      }
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void BlockFileWriter::drainBlocks() {
+    while (true) {
+      std::unique_lock<std::mutex> lLock (_mutex);
+      _hasSubmittedBlock.wait (lLock, [this] () {
+          return (_submittedBlocks.empty() == false || _isStopping == true);
+        });
+
+      // Stop only once all the submitted blocks have been written
+      if (_submittedBlocks.empty() == true) {
+        return;
+      }
+
+      const std::pair<std::size_t, std::size_t> lBlock =
+        _submittedBlocks.front();
+      _submittedBlocks.pop_front();
+      _isWriting = true;
+
+      // Once an error has occurred, the subsequent blocks are discarded
+      const bool hasIOError = (_ioErrorMessage.empty() == false);
+
+      // The caller may fill another block while that one is being written
+      lLock.unlock();
+      const bool isWritten = (hasIOError == false)
+        && writeChars (&_blocks[lBlock.first][0], lBlock.second);
+      lLock.lock();
+
+      if (isWritten == false && hasIOError == false) {
+        std::ostringstream oMessage;
+        oMessage << "Only part of the " << lBlock.second << " characters "
+                 << "could be written into '" << _filename << "'";
+        _ioErrorMessage = oMessage.str();
+      }
+      _isWriting = false;
+      _freeBlocks.push_back (lBlock.first);
+      _hasWrittenBlock.notify_all();
+    }
+  }
+
+}
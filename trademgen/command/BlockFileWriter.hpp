@@ -0,0 +1,218 @@
+#ifndef __TRADEMGEN_CMD_BLOCKFILEWRITER_HPP
+#define __TRADEMGEN_CMD_BLOCKFILEWRITER_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cstdio>
+#include <deque>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+// StdAir
+#include <stdair/stdair_basic_types.hpp>
+
+namespace TRADEMGEN {
+
+  /**
+   * @brief Writer of (large) blocks of characters into a file.
+   *
+   * The caller fills the current block, and then submits it. The
+   * writer hands over another block to be filled in the meantime.
+   *
+   * In the synchronous mode, a single block is used, and it is written
+   * into the file as soon as it is submitted.
+   *
+   * In the asynchronous mode, the blocks are written by a dedicated I/O
+   * thread, so that the caller (e.g., the demand generation loop) may
+   * fill a block while the previously submitted ones are being
+   * written. When all the blocks are waiting to be written, the caller
+   * is blocked until one of them becomes free again (backpressure):
+   * the memory footprint is thus bounded by the number of blocks times
+   * their size.
+   *
+   * An error raised by the I/O thread is reported to the caller, as a
+   * RequestOutputException, by the next submission, flush or close.
+   */
+  class BlockFileWriter {
+  public:
+    // ////////// Constructors and destructors /////////
+    /**
+     * Constructor. The output file is created (or truncated).
+     *
+     * @param const stdair::Filename_T& Path of the output file.
+     * @param const std::size_t Size (in bytes) of the blocks.
+     * @param const unsigned short Number of blocks. A single block means
+     *        that the writing is synchronous; with two blocks or more,
+     *        a dedicated I/O thread writes the submitted blocks.
+     */
+    BlockFileWriter (const stdair::Filename_T&, const std::size_t iBlockSize,
+                     const unsigned short iNbOfBlocks);
+
+    /**
+     * Destructor. The blocks submitted so far are written into the file
+     * (but not the one being filled), errors being ignored.
+     */
+    ~BlockFileWriter();
+
+
+  public:
+    // ////////// Getters /////////
+    /** Get the path of the output file. */
+    const stdair::Filename_T& getFilename() const {
+      return _filename;
+    }
+
+    /** State whether the blocks are written by a dedicated I/O thread. */
+    bool isAsynchronous() const {
+      return _blocks.size() > 1;
+    }
+
+    /** Get the block to be filled. */
+    char* getBlock() {
+      return &_blocks[_currentBlockIdx][0];
+    }
+
+    /** Get the size of the block to be filled. */
+    std::size_t getBlockSize() const {
+      return _blocks[_currentBlockIdx].size();
+    }
+
+
+  public:
+    // ////////// Business methods /////////
+    /**
+     * Hand over the first characters of the current block, so that
+     * they get written into the file.
+     *
+     * @param const std::size_t Number of characters to be written.
+     * @return char* The (new) block to be filled.
+     */
+    char* submitBlock (const std::size_t);
+
+    /**
+     * Enlarge the block to be filled, which must be empty.
+     *
+     * @param const std::size_t New (minimum) size of the block.
+     * @return char* The (new) block to be filled.
+     */
+    char* enlargeBlock (const std::size_t);
+
+    /**
+     * Wait until all the blocks submitted so far have been written.
+     */
+    void flush();
+
+    /**
+     * Wait until all the blocks submitted so far have been written,
+     * stop the I/O thread (if any) and close the file.
+     *
+     * @throw RequestOutputException when a block could not be written,
+     *        or when the file could not be closed.
+     */
+    void close();
+
+
+  private:
+    // ////////// Helpers /////////
+    /**
+     * Write the given characters into the file.
+     *
+     * @return bool Whether all the characters have been written.
+     */
+    bool writeChars (const char*, const std::size_t);
+
+    /**
+     * Main loop of the I/O thread: write the submitted blocks, in the
+     * order of their submission, until the writer is closed.
+     */
+    void drainBlocks();
+
+    /**
+     * Throw a RequestOutputException, when the I/O thread failed to
+     * write a block.
+     */
+    void checkIOError();
+
+    /**
+     * Stop the I/O thread and close the file. A failure to close the file
+     * is recorded as an I/O error.
+     */
+    void stopAndClose();
+
+
+  private:
+    // ////////// Constructors and destructors /////////
+    /** Default constructor (not to be used). */
+    BlockFileWriter();
+    /** Copy constructor (not to be used). */
+    BlockFileWriter (const BlockFileWriter&);
+
+
+  private:
+    // ////////// Attributes /////////
+    /**
+     * Path of the output file.
+     */
+    const stdair::Filename_T _filename;
+
+    /**
+     * Handler on the output file.
+     */
+    std::FILE* _file;
+
+    /**
+     * Blocks of characters.
+     */
+    std::vector<std::vector<char> > _blocks;
+
+    /**
+     * Index of the block being filled.
+     */
+    std::size_t _currentBlockIdx;
+
+    /**
+     * Blocks submitted, but not written yet (index of the block and
+     * number of characters to be written), in the order of submission.
+     */
+    std::deque<std::pair<std::size_t, std::size_t> > _submittedBlocks;
+
+    /**
+     * Blocks neither being filled nor submitted.
+     */
+    std::vector<std::size_t> _freeBlocks;
+
+    /**
+     * Whether the I/O thread is writing a block.
+     */
+    bool _isWriting;
+
+    /**
+     * Whether the I/O thread must stop, once all the submitted blocks
+     * have been written.
+     */
+    bool _isStopping;
+
+    /**
+     * Description of the error raised by the I/O thread, if any.
+     */
+    std::string _ioErrorMessage;
+
+    /**
+     * Synchronisation between the caller and the I/O thread.
+     */
+    std::mutex _mutex;
+    std::condition_variable _hasSubmittedBlock;
+    std::condition_variable _hasWrittenBlock;
+
+    /**
+     * I/O thread (only in the asynchronous mode).
+     */
+    std::thread _ioThread;
+  };
+
+}
+#endif // __TRADEMGEN_CMD_BLOCKFILEWRITER_HPP
@@ -0,0 +1,725 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <sstream>
+// StdAir
+#include <stdair/stdair_date_time_types.hpp>
+#include <stdair/service/Logger.hpp>
+// TraDemGen
+#include <trademgen/TRADEMGEN_Exceptions.hpp>
+#include <trademgen/basic/DemandCharacteristics.hpp>
+#include <trademgen/basic/DictionaryManager.hpp>
+#include <trademgen/bom/DemandStruct.hpp>
+#include <trademgen/command/CompiledDemandModel.hpp>
+
+namespace TRADEMGEN {
+
+  // The records are mapped as is: their layout must not depend on the
+  // compiler padding
+  static_assert (sizeof (CompiledDemandModel::Header) == 80,
+                 "Unexpected layout of the compiled demand model header");
+  static_assert (sizeof (CompiledDemandModel::Pair) == 24,
+                 "Unexpected layout of the compiled distribution pairs");
+  static_assert (sizeof (CompiledDemandModel::String) == 8,
+                 "Unexpected layout of the compiled string entries");
+  static_assert (sizeof (CompiledDemandModel::Demand) == 144,
+                 "Unexpected layout of the compiled demand records");
+
+  /** Alignment (in bytes) of the sections of the file. */
+  static const std::size_t K_SECTION_ALIGNMENT = 8;
+
+  /** Reference date, from which the dates are counted. */
+  static const stdair::Date_T K_EPOCH_DATE (1970, boost::gregorian::Jan, 1);
+
+  // //////////////////////////////////////////////////////////////////////
+  static std::size_t alignSection (const std::size_t iOffset) {
+    return (iOffset + K_SECTION_ALIGNMENT - 1) & ~(K_SECTION_ALIGNMENT - 1);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  CompiledDemandModel::CompiledDemandModel()
+    : _demands (NULL), _nbOfDemands (0), _pairs (NULL), _nbOfPairs (0),
+      _strings (NULL), _nbOfStrings (0), _stringData (NULL),
+      _stringDataSize (0) {
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  CompiledDemandModel::~CompiledDemandModel() {
+    if (_mappedFile.is_open() == true) {
+      _mappedFile.close();
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void CompiledDemandModel::pointToVectors() {
+    _demands = (_demandVector.empty() == true) ? NULL : &_demandVector[0];
+    _nbOfDemands = _demandVector.size();
+    _pairs = (_pairVector.empty() == true) ? NULL : &_pairVector[0];
+    _nbOfPairs = _pairVector.size();
+    _strings = (_stringVector.empty() == true) ? NULL : &_stringVector[0];
+    _nbOfStrings = _stringVector.size();
+    _stringData =
+      (_stringDataVector.empty() == true) ? NULL : &_stringDataVector[0];
+    _stringDataSize = _stringDataVector.size();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  boost::uint32_t CompiledDemandModel::internString (const std::string& iStr) {
+    std::map<std::string, boost::uint32_t>::const_iterator itString =
+      _stringIndex.find (iStr);
+    if (itString != _stringIndex.end()) {
+      return itString->second;
+    }
+
+    String lString;
+    lString._offset = static_cast<boost::uint32_t> (_stringDataVector.size());
+    lString._length = static_cast<boost::uint32_t> (iStr.size());
+    _stringDataVector.insert (_stringDataVector.end(), iStr.begin(), iStr.end());
+
+    const boost::uint32_t oIdx =
+      static_cast<boost::uint32_t> (_stringVector.size());
+    _stringVector.push_back (lString);
+    _stringIndex.insert (std::make_pair (iStr, oIdx));
+    return oIdx;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  std::string CompiledDemandModel::getString (const boost::uint32_t iIdx) const {
+    if (iIdx >= _nbOfStrings) {
+      std::ostringstream oMessage;
+      oMessage << "The compiled demand model refers to the string #" << iIdx
+               << ", whereas it holds only " << _nbOfStrings << " strings";
+      throw CompiledDemandModelException (oMessage.str());
+    }
+    const String& lString = _strings[iIdx];
+    return std::string (_stringData + lString._offset, lString._length);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  template <typename PMF>
+  CompiledDemandModel::Distribution CompiledDemandModel::
+  addCategoricalDistribution (const PMF& iPMF) {
+    Distribution oDistribution;
+    oDistribution._firstPairIdx =
+      static_cast<boost::uint32_t> (_pairVector.size());
+    oDistribution._nbOfPairs = static_cast<boost::uint32_t> (iPMF.size());
+
+    // The cumulative probabilities are accumulated as done by
+    // CategoricalAttributeLite, the values of zero probability being
+    // left out
+    stdair::Probability_T lCumulativeProbability = 0.0;
+    for (typename PMF::const_iterator itPair = iPMF.begin();
+         itPair != iPMF.end(); ++itPair) {
+      if (itPair->second > 0) {
+        lCumulativeProbability += itPair->second;
+      }
+      Pair lPair;
+      lPair._value = static_cast<double> (internString (itPair->first));
+      lPair._probability = itPair->second;
+      lPair._cumulativeKey =
+        DictionaryManager::valueToKey (lCumulativeProbability);
+      _pairVector.push_back (lPair);
+    }
+    return oDistribution;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  template <typename PMF>
+  CompiledDemandModel::Distribution CompiledDemandModel::
+  addNumericalDistribution (const PMF& iPMF, const bool iIsCumulative) {
+    Distribution oDistribution;
+    oDistribution._firstPairIdx =
+      static_cast<boost::uint32_t> (_pairVector.size());
+    oDistribution._nbOfPairs = static_cast<boost::uint32_t> (iPMF.size());
+
+    stdair::Probability_T lCumulativeProbability = 0.0;
+    for (typename PMF::const_iterator itPair = iPMF.begin();
+         itPair != iPMF.end(); ++itPair) {
+      if (iIsCumulative == true) {
+        lCumulativeProbability = itPair->second;
+      } else if (itPair->second > 0) {
+        lCumulativeProbability += itPair->second;
+      }
+      Pair lPair;
+      lPair._value = static_cast<double> (itPair->first);
+      lPair._probability = itPair->second;
+      lPair._cumulativeKey =
+        DictionaryManager::valueToKey (lCumulativeProbability);
+      _pairVector.push_back (lPair);
+    }
+    return oDistribution;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  template <typename PMF>
+  void CompiledDemandModel::
+  fillCategoricalDistribution (const Distribution& iDistribution,
+                               PMF& ioPMF) const {
+    ioPMF.clear();
+    const Pair* itPair = _pairs + iDistribution._firstPairIdx;
+    const Pair* itPairEnd = itPair + iDistribution._nbOfPairs;
+    for ( ; itPair != itPairEnd; ++itPair) {
+      const boost::uint32_t lStringIdx =
+        static_cast<boost::uint32_t> (itPair->_value);
+      ioPMF.insert (typename PMF::value_type (getString (lStringIdx),
+                                              itPair->_probability));
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  template <typename PMF>
+  void CompiledDemandModel::
+  fillNumericalDistribution (const Distribution& iDistribution,
+                             PMF& ioPMF) const {
+    ioPMF.clear();
+    const Pair* itPair = _pairs + iDistribution._firstPairIdx;
+    const Pair* itPairEnd = itPair + iDistribution._nbOfPairs;
+    for ( ; itPair != itPairEnd; ++itPair) {
+      const typename PMF::key_type lValue =
+        static_cast<typename PMF::key_type> (itPair->_value);
+      ioPMF.insert (typename PMF::value_type (lValue, itPair->_probability));
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void CompiledDemandModel::
+  buildCodeAttribute (const Distribution& iDistribution,
+                      CategoricalAttributeLite<std::string>& ioAttribute) const {
+    std::vector<std::string> lValueArray;
+    std::vector<DictionaryKey_T> lCumulativeDistribution;
+    lValueArray.reserve (iDistribution._nbOfPairs);
+    lCumulativeDistribution.reserve (iDistribution._nbOfPairs);
+
+    const Pair* itPair = _pairs + iDistribution._firstPairIdx;
+    const Pair* itPairEnd = itPair + iDistribution._nbOfPairs;
+    for ( ; itPair != itPairEnd; ++itPair) {
+      if (itPair->_probability > 0) {
+        const boost::uint32_t lStringIdx =
+          static_cast<boost::uint32_t> (itPair->_value);
+        lValueArray.push_back (getString (lStringIdx));
+        lCumulativeDistribution.push_back (itPair->_cumulativeKey);
+      }
+    }
+    ioAttribute = CategoricalAttributeLite<std::string> (lValueArray,
+                                                         lCumulativeDistribution);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  template <typename T>
+  void CompiledDemandModel::
+  buildNumberAttribute (const Distribution& iDistribution,
+                        CategoricalAttributeLite<T>& ioAttribute) const {
+    std::vector<T> lValueArray;
+    std::vector<DictionaryKey_T> lCumulativeDistribution;
+    lValueArray.reserve (iDistribution._nbOfPairs);
+    lCumulativeDistribution.reserve (iDistribution._nbOfPairs);
+
+    const Pair* itPair = _pairs + iDistribution._firstPairIdx;
+    const Pair* itPairEnd = itPair + iDistribution._nbOfPairs;
+    for ( ; itPair != itPairEnd; ++itPair) {
+      if (itPair->_probability > 0) {
+        lValueArray.push_back (static_cast<T> (itPair->_value));
+        lCumulativeDistribution.push_back (itPair->_cumulativeKey);
+      }
+    }
+    ioAttribute = CategoricalAttributeLite<T> (lValueArray,
+                                               lCumulativeDistribution);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  template <typename T>
+  void CompiledDemandModel::
+  buildContinuousAttribute (const Distribution& iDistribution,
+                            ContinuousAttributeLite<T>& ioAttribute) const {
+    std::vector<T> lValueArray;
+    std::vector<DictionaryKey_T> lCumulativeDistribution;
+    lValueArray.reserve (iDistribution._nbOfPairs);
+    lCumulativeDistribution.reserve (iDistribution._nbOfPairs);
+
+    const Pair* itPair = _pairs + iDistribution._firstPairIdx;
+    const Pair* itPairEnd = itPair + iDistribution._nbOfPairs;
+    for ( ; itPair != itPairEnd; ++itPair) {
+      lValueArray.push_back (static_cast<T> (itPair->_value));
+      lCumulativeDistribution.push_back (itPair->_cumulativeKey);
+    }
+    ioAttribute = ContinuousAttributeLite<T> (lValueArray,
+                                              lCumulativeDistribution);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void CompiledDemandModel::addDemand (const DemandStruct& iDemand) {
+    // A loaded model cannot be extended
+    assert (_mappedFile.is_open() == false);
+
+    Demand lDemand;
+    std::memset (&lDemand, 0, sizeof (lDemand));
+
+    // Scalar attributes
+    lDemand._demandMean = iDemand._demandMean;
+    lDemand._demandStdDev = iDemand._demandStdDev;
+    lDemand._changeFeeProb = iDemand._changeFeeProb;
+    lDemand._changeFeeDisutility = iDemand._changeFeeDisutility;
+    lDemand._nonRefundableProb = iDemand._nonRefundableProb;
+    lDemand._nonRefundableDisutility = iDemand._nonRefundableDisutility;
+    lDemand._minWTP = iDemand._minWTP;
+
+    // Date range and active days of the week
+    lDemand._dateRangeStart = static_cast<boost::int32_t>
+      ((iDemand._dateRange.begin() - K_EPOCH_DATE).days());
+    lDemand._dateRangeEnd = static_cast<boost::int32_t>
+      ((iDemand._dateRange.end() - K_EPOCH_DATE).days());
+    for (unsigned short lDoW = 0; lDoW != 7; ++lDoW) {
+      if (iDemand._dow.getStandardDayOfWeek (lDoW) == true) {
+        lDemand._dowMask |= (1U << lDoW);
+      }
+    }
+
+    // Codes
+    lDemand._originIdx = internString (iDemand._origin);
+    lDemand._destinationIdx = internString (iDemand._destination);
+    lDemand._prefCabinIdx = internString (iDemand._prefCabin);
+
+    // Distributions
+    lDemand._posDist = addCategoricalDistribution (iDemand._posProbDist);
+    lDemand._channelDist = addCategoricalDistribution (iDemand._channelProbDist);
+    lDemand._tripDist = addCategoricalDistribution (iDemand._tripProbDist);
+    lDemand._stayDist = addNumericalDistribution (iDemand._stayProbDist,
+                                                  false);
+    lDemand._ffDist = addCategoricalDistribution (iDemand._ffProbDist);
+    lDemand._prefDepTimeDist =
+      addNumericalDistribution (iDemand._prefDepTimeProbDist, true);
+    lDemand._timeValueDist =
+      addNumericalDistribution (iDemand._timeValueProbDist, true);
+    lDemand._dtdDist = addNumericalDistribution (iDemand._dtdProbDist, true);
+
+    _demandVector.push_back (lDemand);
+    pointToVectors();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void CompiledDemandModel::fillDemand (const std::size_t iIdx,
+                                        DemandStruct& ioDemand) const {
+    // Sanity check
+    assert (iIdx < _nbOfDemands);
+    const Demand& lDemand = _demands[iIdx];
+
+    // Scalar attributes
+    ioDemand._demandMean = lDemand._demandMean;
+    ioDemand._demandStdDev = lDemand._demandStdDev;
+    ioDemand._changeFeeProb = lDemand._changeFeeProb;
+    ioDemand._changeFeeDisutility = lDemand._changeFeeDisutility;
+    ioDemand._nonRefundableProb = lDemand._nonRefundableProb;
+    ioDemand._nonRefundableDisutility = lDemand._nonRefundableDisutility;
+    ioDemand._minWTP = lDemand._minWTP;
+
+    // Date range
+    ioDemand._dateRange = getDateRange (iIdx);
+
+    // Active days of the week. Within the string, the week starts on
+    // Monday, whereas the bits of the mask start on Sunday
+    stdair::DOW_String_T lDoWStr (7, '0');
+    for (unsigned short lDoW = 0; lDoW != 7; ++lDoW) {
+      if ((lDemand._dowMask & (1U << ((lDoW + 1) % 7))) != 0) {
+        lDoWStr[lDoW] = '1';
+      }
+    }
+    ioDemand._dow = lDoWStr;
+
+    // Codes
+    ioDemand._origin = getString (lDemand._originIdx);
+    ioDemand._destination = getString (lDemand._destinationIdx);
+    ioDemand._prefCabin = getString (lDemand._prefCabinIdx);
+
+    // Distributions
+    fillCategoricalDistribution (lDemand._posDist, ioDemand._posProbDist);
+    fillCategoricalDistribution (lDemand._channelDist,
+                                 ioDemand._channelProbDist);
+    fillCategoricalDistribution (lDemand._tripDist, ioDemand._tripProbDist);
+    fillNumericalDistribution (lDemand._stayDist, ioDemand._stayProbDist);
+    fillCategoricalDistribution (lDemand._ffDist, ioDemand._ffProbDist);
+    fillNumericalDistribution (lDemand._prefDepTimeDist,
+                               ioDemand._prefDepTimeProbDist);
+    fillNumericalDistribution (lDemand._timeValueDist,
+                               ioDemand._timeValueProbDist);
+    fillNumericalDistribution (lDemand._dtdDist, ioDemand._dtdProbDist);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void CompiledDemandModel::
+  fillDemandCharacteristics (const std::size_t iIdx,
+                             DemandCharacteristics& ioDemandCharacteristics) const {
+    // Sanity check
+    assert (iIdx < _nbOfDemands);
+    const Demand& lDemand = _demands[iIdx];
+
+    // Scalar attributes
+    ioDemandCharacteristics._changeFeeProb = lDemand._changeFeeProb;
+    ioDemandCharacteristics._changeFeeDisutility = lDemand._changeFeeDisutility;
+    ioDemandCharacteristics._nonRefundableProb = lDemand._nonRefundableProb;
+    ioDemandCharacteristics._nonRefundableDisutility =
+      lDemand._nonRefundableDisutility;
+    ioDemandCharacteristics._minWTP = lDemand._minWTP;
+
+    // Compiled distributions, straight from the tables
+    buildContinuousAttribute (lDemand._dtdDist,
+                              ioDemandCharacteristics._arrivalPattern);
+    buildCodeAttribute (lDemand._posDist,
+                        ioDemandCharacteristics._posProbabilityMass);
+    buildCodeAttribute (lDemand._channelDist,
+                        ioDemandCharacteristics._channelProbabilityMass);
+    buildCodeAttribute (lDemand._tripDist,
+                        ioDemandCharacteristics._tripTypeProbabilityMass);
+    buildNumberAttribute (lDemand._stayDist,
+                          ioDemandCharacteristics._stayDurationProbabilityMass);
+    buildCodeAttribute (lDemand._ffDist,
+                        ioDemandCharacteristics._frequentFlyerProbabilityMass);
+    buildContinuousAttribute (lDemand._prefDepTimeDist, ioDemandCharacteristics.
+                              _preferredDepartureTimeCumulativeDistribution);
+    buildContinuousAttribute (lDemand._timeValueDist, ioDemandCharacteristics.
+                              _valueOfTimeCumulativeDistribution);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  stdair::DatePeriod_T CompiledDemandModel::
+  getDateRange (const std::size_t iIdx) const {
+    const Demand& lDemand = getDemand (iIdx);
+    return stdair::DatePeriod_T (K_EPOCH_DATE
+                                 + stdair::DateOffset_T (lDemand._dateRangeStart),
+                                 K_EPOCH_DATE
+                                 + stdair::DateOffset_T (lDemand._dateRangeEnd));
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  std::string CompiledDemandModel::
+  describeDemandKey (const std::size_t iIdx) const {
+    const Demand& lDemand = getDemand (iIdx);
+    std::ostringstream oStr;
+    oStr << getString (lDemand._originIdx)
+         << "-" << getString (lDemand._destinationIdx)
+         << "-" << getString (lDemand._prefCabinIdx)
+         << "-" << lDemand._dateRangeStart << "-" << lDemand._dateRangeEnd
+         << "-" << lDemand._dowMask;
+    return oStr.str();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool CompiledDemandModel::
+  isSameDistribution (const Distribution& iDistribution,
+                      const CompiledDemandModel& iOtherModel,
+                      const Distribution& iOtherDistribution,
+                      const bool iIsCategorical) const {
+    if (iDistribution._nbOfPairs != iOtherDistribution._nbOfPairs) {
+      return false;
+    }
+
+    const Pair* itPair = _pairs + iDistribution._firstPairIdx;
+    const Pair* itOtherPair =
+      iOtherModel._pairs + iOtherDistribution._firstPairIdx;
+    for (boost::uint32_t idx = 0; idx != iDistribution._nbOfPairs;
+         ++idx, ++itPair, ++itOtherPair) {
+      if (itPair->_probability != itOtherPair->_probability) {
+        return false;
+      }
+
+      if (iIsCategorical == false) {
+        if (itPair->_value != itOtherPair->_value) {
+          return false;
+        }
+        continue;
+      }
+
+      const boost::uint32_t lStringIdx =
+        static_cast<boost::uint32_t> (itPair->_value);
+      const boost::uint32_t lOtherStringIdx =
+        static_cast<boost::uint32_t> (itOtherPair->_value);
+      if (getString (lStringIdx) != iOtherModel.getString (lOtherStringIdx)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool CompiledDemandModel::
+  isSameDemand (const std::size_t iIdx, const CompiledDemandModel& iOtherModel,
+                const std::size_t iOtherIdx) const {
+    const Demand& lDemand = getDemand (iIdx);
+    const Demand& lOtherDemand = iOtherModel.getDemand (iOtherIdx);
+
+    // Scalar attributes
+    if (lDemand._demandMean != lOtherDemand._demandMean
+        || lDemand._demandStdDev != lOtherDemand._demandStdDev
+        || lDemand._changeFeeProb != lOtherDemand._changeFeeProb
+        || lDemand._changeFeeDisutility != lOtherDemand._changeFeeDisutility
+        || lDemand._nonRefundableProb != lOtherDemand._nonRefundableProb
+        || lDemand._nonRefundableDisutility
+        != lOtherDemand._nonRefundableDisutility
+        || lDemand._minWTP != lOtherDemand._minWTP
+        || lDemand._dateRangeStart != lOtherDemand._dateRangeStart
+        || lDemand._dateRangeEnd != lOtherDemand._dateRangeEnd
+        || lDemand._dowMask != lOtherDemand._dowMask) {
+      return false;
+    }
+
+    // Codes
+    if (getString (lDemand._originIdx)
+        != iOtherModel.getString (lOtherDemand._originIdx)
+        || getString (lDemand._destinationIdx)
+        != iOtherModel.getString (lOtherDemand._destinationIdx)
+        || getString (lDemand._prefCabinIdx)
+        != iOtherModel.getString (lOtherDemand._prefCabinIdx)) {
+      return false;
+    }
+
+    // Distributions
+    return isSameDistribution (lDemand._posDist, iOtherModel,
+                               lOtherDemand._posDist, true)
+      && isSameDistribution (lDemand._channelDist, iOtherModel,
+                             lOtherDemand._channelDist, true)
+      && isSameDistribution (lDemand._tripDist, iOtherModel,
+                             lOtherDemand._tripDist, true)
+      && isSameDistribution (lDemand._stayDist, iOtherModel,
+                             lOtherDemand._stayDist, false)
+      && isSameDistribution (lDemand._ffDist, iOtherModel,
+                             lOtherDemand._ffDist, true)
+      && isSameDistribution (lDemand._prefDepTimeDist, iOtherModel,
+                             lOtherDemand._prefDepTimeDist, false)
+      && isSameDistribution (lDemand._timeValueDist, iOtherModel,
+                             lOtherDemand._timeValueDist, false)
+      && isSameDistribution (lDemand._dtdDist, iOtherModel,
+                             lOtherDemand._dtdDist, false);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool CompiledDemandModel::
+  hasSameArrivalPattern (const std::size_t iIdx,
+                         const CompiledDemandModel& iOtherModel,
+                         const std::size_t iOtherIdx) const {
+    const Demand& lDemand = getDemand (iIdx);
+    const Demand& lOtherDemand = iOtherModel.getDemand (iOtherIdx);
+    return isSameDistribution (lDemand._dtdDist, iOtherModel,
+                               lOtherDemand._dtdDist, false);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void CompiledDemandModel::save (const stdair::Filename_T& iFilename) const {
+    // Layout of the file
+    Header lHeader;
+    std::memset (&lHeader, 0, sizeof (lHeader));
+    std::memcpy (lHeader._magic, COMPILED_DEMAND_MODEL_MAGIC,
+                 COMPILED_DEMAND_MODEL_MAGIC_SIZE);
+    lHeader._version = COMPILED_DEMAND_MODEL_VERSION;
+    lHeader._byteOrderMark = COMPILED_DEMAND_MODEL_BYTE_ORDER_MARK;
+    lHeader._nbOfDemands = _nbOfDemands;
+    lHeader._nbOfPairs = _nbOfPairs;
+    lHeader._nbOfStrings = _nbOfStrings;
+    lHeader._stringDataSize = _stringDataSize;
+    lHeader._demandOffset = alignSection (sizeof (Header));
+    lHeader._pairOffset =
+      alignSection (lHeader._demandOffset + _nbOfDemands * sizeof (Demand));
+    lHeader._stringOffset =
+      alignSection (lHeader._pairOffset + _nbOfPairs * sizeof (Pair));
+    lHeader._stringDataOffset =
+      alignSection (lHeader._stringOffset + _nbOfStrings * sizeof (String));
+
+    // Sections, along with their position within the file
+    const std::pair<const char*, std::size_t> lSections[] = {
+      std::make_pair (reinterpret_cast<const char*> (&lHeader),
+                      sizeof (Header)),
+      std::make_pair (reinterpret_cast<const char*> (_demands),
+                      _nbOfDemands * sizeof (Demand)),
+      std::make_pair (reinterpret_cast<const char*> (_pairs),
+                      _nbOfPairs * sizeof (Pair)),
+      std::make_pair (reinterpret_cast<const char*> (_strings),
+                      _nbOfStrings * sizeof (String)),
+      std::make_pair (_stringData, _stringDataSize)
+    };
+    const boost::uint64_t lSectionOffsets[] = {
+      0, lHeader._demandOffset, lHeader._pairOffset, lHeader._stringOffset,
+      lHeader._stringDataOffset
+    };
+
+    //
+    std::FILE* lFile = std::fopen (iFilename.c_str(), "wb");
+    if (lFile == NULL) {
+      std::ostringstream oMessage;
+      oMessage << "The compiled demand model file '" << iFilename
+               << "' cannot be opened for writing";
+      throw CompiledDemandModelException (oMessage.str());
+    }
+
+    bool isWritten = true;
+    std::size_t lFilePosition = 0;
+    const char lPadding[K_SECTION_ALIGNMENT] = { 0 };
+    for (unsigned short idx = 0; idx != 5 && isWritten == true; ++idx) {
+      const std::size_t lPaddingSize = lSectionOffsets[idx] - lFilePosition;
+      const std::size_t lSectionSize = lSections[idx].second;
+      isWritten = (std::fwrite (lPadding, 1, lPaddingSize, lFile)
+                   == lPaddingSize)
+        && (lSectionSize == 0
+            || std::fwrite (lSections[idx].first, 1, lSectionSize, lFile)
+            == lSectionSize);
+      lFilePosition += lPaddingSize + lSectionSize;
+    }
+    isWritten = (std::fclose (lFile) == 0) && isWritten;
+
+    if (isWritten == false) {
+      std::ostringstream oMessage;
+      oMessage << "The compiled demand model could not be fully written into '"
+               << iFilename << "'";
+      throw CompiledDemandModelException (oMessage.str());
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void CompiledDemandModel::load (const stdair::Filename_T& iFilename) {
+    // Discard the current content, if any
+    _demandVector.clear(); _pairVector.clear();
+    _stringVector.clear(); _stringDataVector.clear();
+    _stringIndex.clear();
+    pointToVectors();
+    if (_mappedFile.is_open() == true) {
+      _mappedFile.close();
+    }
+
+    // Map the file in memory
+    try {
+      _mappedFile.open (iFilename);
+
+    } catch (const std::exception& lException) {
+      std::ostringstream oMessage;
+      oMessage << "The compiled demand model file '" << iFilename
+               << "' cannot be mapped in memory: " << lException.what();
+      STDAIR_LOG_ERROR (oMessage.str());
+      throw CompiledDemandModelException (oMessage.str());
+    }
+    const char* lData = _mappedFile.data();
+    const std::size_t lSize = _mappedFile.size();
+
+    // Check the header
+    Header lHeader;
+    std::memset (&lHeader, 0, sizeof (lHeader));
+    if (lSize >= sizeof (Header)) {
+      std::memcpy (&lHeader, lData, sizeof (Header));
+    }
+
+    std::ostringstream oMessage;
+    if (lSize < sizeof (Header)) {
+      oMessage << "The file '" << iFilename << "' is too small to be a "
+               << "compiled demand model";
+
+    } else if (std::memcmp (lHeader._magic, COMPILED_DEMAND_MODEL_MAGIC,
+                            COMPILED_DEMAND_MODEL_MAGIC_SIZE) != 0) {
+      oMessage << "The file '" << iFilename << "' is not a compiled "
+               << "demand model";
+
+    } else if (lHeader._byteOrderMark != COMPILED_DEMAND_MODEL_BYTE_ORDER_MARK) {
+      oMessage << "The compiled demand model '" << iFilename << "' has been "
+               << "compiled on a machine having another byte order";
+
+    } else if (lHeader._version != COMPILED_DEMAND_MODEL_VERSION) {
+      oMessage << "The compiled demand model '" << iFilename << "' is of "
+               << "version " << lHeader._version << ", whereas version "
+               << COMPILED_DEMAND_MODEL_VERSION << " is expected. It has "
+               << "to be compiled again";
+    }
+
+    // Check that the sections lie within the file
+    const boost::uint64_t lSectionOffsets[] = {
+      lHeader._demandOffset, lHeader._pairOffset, lHeader._stringOffset,
+      lHeader._stringDataOffset
+    };
+    const boost::uint64_t lSectionSizes[] = {
+      lHeader._nbOfDemands, lHeader._nbOfPairs, lHeader._nbOfStrings,
+      lHeader._stringDataSize
+    };
+    const std::size_t lSectionItemSizes[] = {
+      sizeof (Demand), sizeof (Pair), sizeof (String), 1
+    };
+    for (unsigned short idx = 0; idx != 4 && oMessage.str().empty(); ++idx) {
+      const boost::uint64_t lOffset = lSectionOffsets[idx];
+      if (lOffset < sizeof (Header) || lOffset > lSize
+          || lOffset % K_SECTION_ALIGNMENT != 0
+          || lSectionSizes[idx] > (lSize - lOffset) / lSectionItemSizes[idx]) {
+        oMessage << "The compiled demand model '" << iFilename
+                 << "' is corrupted (section #" << idx << ")";
+      }
+    }
+
+    if (oMessage.str().empty() == false) {
+      _mappedFile.close();
+      STDAIR_LOG_ERROR (oMessage.str());
+      throw CompiledDemandModelException (oMessage.str());
+    }
+
+    // Point to the sections of the mapped file
+    _demands = reinterpret_cast<const Demand*> (lData + lHeader._demandOffset);
+    _nbOfDemands = lHeader._nbOfDemands;
+    _pairs = reinterpret_cast<const Pair*> (lData + lHeader._pairOffset);
+    _nbOfPairs = lHeader._nbOfPairs;
+    _strings = reinterpret_cast<const String*> (lData + lHeader._stringOffset);
+    _nbOfStrings = lHeader._nbOfStrings;
+    _stringData = lData + lHeader._stringDataOffset;
+    _stringDataSize = lHeader._stringDataSize;
+
+    //
+    try {
+      checkDemands();
+
+    } catch (const CompiledDemandModelException& lException) {
+      _mappedFile.close();
+      pointToVectors();
+      STDAIR_LOG_ERROR ("The compiled demand model '" << iFilename
+                        << "' is corrupted: " << lException.what());
+      throw;
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void CompiledDemandModel::checkDemands() const {
+    // Strings
+    for (std::size_t idx = 0; idx != _nbOfStrings; ++idx) {
+      const String& lString = _strings[idx];
+      if (static_cast<boost::uint64_t> (lString._offset) + lString._length
+          > _stringDataSize) {
+        std::ostringstream oMessage;
+        oMessage << "the string #" << idx << " lies outside of the file";
+        throw CompiledDemandModelException (oMessage.str());
+      }
+    }
+
+    // Demands
+    for (std::size_t idx = 0; idx != _nbOfDemands; ++idx) {
+      const Demand& lDemand = _demands[idx];
+      const Distribution* lDistributions[] = {
+        &lDemand._posDist, &lDemand._channelDist, &lDemand._tripDist,
+        &lDemand._stayDist, &lDemand._ffDist, &lDemand._prefDepTimeDist,
+        &lDemand._timeValueDist, &lDemand._dtdDist
+      };
+
+      bool isValid = (lDemand._originIdx < _nbOfStrings
+                      && lDemand._destinationIdx < _nbOfStrings
+                      && lDemand._prefCabinIdx < _nbOfStrings
+                      && lDemand._dateRangeStart <= lDemand._dateRangeEnd);
+      for (unsigned short lDistIdx = 0; lDistIdx != 8; ++lDistIdx) {
+        const Distribution& lDistribution = *lDistributions[lDistIdx];
+        isValid = isValid
+          && (static_cast<boost::uint64_t> (lDistribution._firstPairIdx)
+              + lDistribution._nbOfPairs <= _nbOfPairs);
+      }
+
+      if (isValid == false) {
+        std::ostringstream oMessage;
+        oMessage << "the demand #" << idx << " refers to non-existing "
+                 << "strings or distributions";
+        throw CompiledDemandModelException (oMessage.str());
+      }
+    }
+  }
+
+}
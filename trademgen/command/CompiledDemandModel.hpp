@@ -0,0 +1,363 @@
+#ifndef __TRADEMGEN_CMD_COMPILEDDEMANDMODEL_HPP
+#define __TRADEMGEN_CMD_COMPILEDDEMANDMODEL_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <map>
+#include <string>
+#include <vector>
+// Boost
+#include <boost/cstdint.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+// StdAir
+#include <stdair/stdair_basic_types.hpp>
+#include <stdair/stdair_date_time_types.hpp>
+// TraDemGen
+#include <trademgen/basic/BasConst_CompiledDemandModel.hpp>
+
+namespace TRADEMGEN {
+
+  // Forward declarations
+  struct DemandStruct;
+  struct DemandCharacteristics;
+  template <typename T> struct CategoricalAttributeLite;
+  template <typename T> struct ContinuousAttributeLite;
+
+  /**
+   * @brief Compiled (binary) form of the demand input file.
+   *
+   * A compiled demand model holds, for every demand of the input file
+   * and in the same order, a fixed-size record made of the scalar
+   * attributes of the demand. The codes (airports, cabins, channels,
+   * trip types and frequent flyer types) are interned, i.e., stored
+   * once for all within a table of strings, and referred to by their
+   * index. The probability distributions are stored as slices of a
+   * single table of (value, probability, cumulative probability)
+   * triplets: the cumulative probabilities are the compiled distribution
+   * tables, as held by the demand streams, so that the latter are built
+   * straight from the mapped tables.
+   *
+   * The file is made of the following sections, all aligned on 8 bytes:
+   * <ul>
+   *   <li>the header (magic string, version, byte order marker, and
+   *       size and position of the other sections);</li>
+   *   <li>the demand records;</li>
+   *   <li>the (value, probability, cumulative probability) triplets of
+   *       the distributions;</li>
+   *   <li>the (position, length) entries of the table of strings;</li>
+   *   <li>the characters of the strings.</li>
+   * </ul>
+   *
+   * Loading a compiled demand model just maps that file in memory
+   * (read-only, so that several processes share the same pages) and
+   * points to its sections: nothing is parsed anymore. Hence, the file
+   * can only be loaded on machines having the same byte order as the
+   * one having compiled it; it is checked, as well as the version of
+   * the format, when the file is loaded.
+   */
+  class CompiledDemandModel {
+  public:
+    // ////////// Type definitions /////////
+    /** Header of the file. */
+    struct Header {
+      char _magic[COMPILED_DEMAND_MODEL_MAGIC_SIZE];
+      boost::uint32_t _version;
+      boost::uint32_t _byteOrderMark;
+      boost::uint64_t _nbOfDemands;
+      boost::uint64_t _nbOfPairs;
+      boost::uint64_t _nbOfStrings;
+      boost::uint64_t _stringDataSize;
+      boost::uint64_t _demandOffset;
+      boost::uint64_t _pairOffset;
+      boost::uint64_t _stringOffset;
+      boost::uint64_t _stringDataOffset;
+    };
+
+    /**
+     * (Value, probability) pair of a distribution, along with the
+     * dictionary-coded cumulative probability of the value, as held by
+     * the compiled distributions (see CategoricalAttributeLite and
+     * ContinuousAttributeLite). For a distribution given by its
+     * cumulative probabilities (e.g., the arrival pattern), both
+     * probabilities are the same.
+     */
+    struct Pair {
+      double _value;
+      double _probability;
+      double _cumulativeKey;
+    };
+
+    /** Slice of the table of pairs, corresponding to a distribution. */
+    struct Distribution {
+      boost::uint32_t _firstPairIdx;
+      boost::uint32_t _nbOfPairs;
+    };
+
+    /** Entry of the table of strings. */
+    struct String {
+      boost::uint32_t _offset;
+      boost::uint32_t _length;
+    };
+
+    /**
+     * Record corresponding to a demand. The dates are given as numbers
+     * of days since the 1st of January 1970, the end date being
+     * excluded (as for Boost date periods). The bits of the
+     * day-of-the-week mask follow the Boost numbering (0 for Sunday).
+     */
+    struct Demand {
+      double _demandMean;
+      double _demandStdDev;
+      double _changeFeeProb;
+      double _changeFeeDisutility;
+      double _nonRefundableProb;
+      double _nonRefundableDisutility;
+      double _minWTP;
+      boost::int32_t _dateRangeStart;
+      boost::int32_t _dateRangeEnd;
+      boost::uint32_t _dowMask;
+      boost::uint32_t _originIdx;
+      boost::uint32_t _destinationIdx;
+      boost::uint32_t _prefCabinIdx;
+      Distribution _posDist;
+      Distribution _channelDist;
+      Distribution _tripDist;
+      Distribution _stayDist;
+      Distribution _ffDist;
+      Distribution _prefDepTimeDist;
+      Distribution _timeValueDist;
+      Distribution _dtdDist;
+    };
+
+
+  public:
+    // ////////// Constructors and destructors /////////
+    /** Default constructor, for an empty model. */
+    CompiledDemandModel();
+
+    /** Destructor. The compiled demand model file (if any) is unmapped. */
+    ~CompiledDemandModel();
+
+
+  public:
+    // ////////// Getters /////////
+    /** Get the number of demands. */
+    std::size_t getNbOfDemands() const {
+      return _nbOfDemands;
+    }
+
+    /**
+     * Get the (compiled) record of the given demand, in the order of
+     * the demand input file.
+     */
+    const Demand& getDemand (const std::size_t iIdx) const {
+      assert (iIdx < _nbOfDemands);
+      return _demands[iIdx];
+    }
+
+    /** Get the string corresponding to the given index. */
+    std::string getString (const boost::uint32_t) const;
+
+    /** Get the date range of the given demand. */
+    stdair::DatePeriod_T getDateRange (const std::size_t) const;
+
+    /**
+     * Get the key identifying the given demand within a demand input
+     * file, made of its origin, destination, preferred cabin, date range
+     * and active days of the week (e.g., "SIN-BKK-Y-14648-14676-127").
+     */
+    std::string describeDemandKey (const std::size_t) const;
+
+    /**
+     * Tell whether the given demand has the same attributes (including
+     * the probability distributions) as the given demand of the given
+     * model. The models may have been compiled separately.
+     *
+     * @param const std::size_t Index of the demand, within that model.
+     * @param const CompiledDemandModel& Other model.
+     * @param const std::size_t Index of the demand, within the other model.
+     */
+    bool isSameDemand (const std::size_t, const CompiledDemandModel&,
+                       const std::size_t) const;
+
+    /**
+     * Tell whether the given demand has the same arrival pattern as the
+     * given demand of the given model.
+     *
+     * @param const std::size_t Index of the demand, within that model.
+     * @param const CompiledDemandModel& Other model.
+     * @param const std::size_t Index of the demand, within the other model.
+     */
+    bool hasSameArrivalPattern (const std::size_t,
+                                const CompiledDemandModel&,
+                                const std::size_t) const;
+
+
+  public:
+    // ////////// Business methods /////////
+    /**
+     * Compile the given demand, and append it to the model.
+     */
+    void addDemand (const DemandStruct&);
+
+    /**
+     * Write the model into the given (binary) file.
+     */
+    void save (const stdair::Filename_T&) const;
+
+    /**
+     * Map the given compiled demand model file in memory. The demands
+     * added so far, if any, are discarded.
+     *
+     * @throw CompiledDemandModelException when the file cannot be read,
+     *        is corrupted or has been compiled by another version.
+     */
+    void load (const stdair::Filename_T&);
+
+    /**
+     * Rebuild the given (parsed) demand from its compiled form.
+     *
+     * @param const std::size_t Index of the demand, in the order of the
+     *        demand input file.
+     * @param DemandStruct& Demand to be filled.
+     */
+    void fillDemand (const std::size_t, DemandStruct&) const;
+
+    /**
+     * Build the (compiled) demand characteristics of the given demand,
+     * straight from the compiled distribution tables, i.e., without
+     * rebuilding the probability distributions of the parsed demand.
+     *
+     * @param const std::size_t Index of the demand, in the order of the
+     *        demand input file.
+     * @param DemandCharacteristics& Demand characteristics to be set.
+     */
+    void fillDemandCharacteristics (const std::size_t,
+                                    DemandCharacteristics&) const;
+
+
+  private:
+    // ////////// Helpers /////////
+    /** Get the index of the given string, adding it if needed. */
+    boost::uint32_t internString (const std::string&);
+
+    /** Append the given distribution of codes to the table of pairs. */
+    template <typename PMF>
+    Distribution addCategoricalDistribution (const PMF&);
+
+    /**
+     * Append the given distribution of numbers to the table of pairs.
+     *
+     * @param const PMF& Distribution, given either by its probability
+     *        masses or by its cumulative probabilities.
+     * @param const bool Whether the distribution is given by its
+     *        cumulative probabilities.
+     */
+    template <typename PMF>
+    Distribution addNumericalDistribution (const PMF&,
+                                           const bool iIsCumulative);
+
+    /** Rebuild the given distribution of codes. */
+    template <typename PMF>
+    void fillCategoricalDistribution (const Distribution&, PMF&) const;
+
+    /** Rebuild the given distribution of numbers. */
+    template <typename PMF>
+    void fillNumericalDistribution (const Distribution&, PMF&) const;
+
+    /**
+     * Build the given compiled distribution of codes, from its slice of
+     * the table of pairs.
+     */
+    void buildCodeAttribute (const Distribution&,
+                             CategoricalAttributeLite<std::string>&) const;
+
+    /**
+     * Build the given compiled distribution of numbers, from its slice
+     * of the table of pairs.
+     */
+    template <typename T>
+    void buildNumberAttribute (const Distribution&,
+                               CategoricalAttributeLite<T>&) const;
+
+    /**
+     * Build the given compiled cumulative distribution, from its slice
+     * of the table of pairs.
+     */
+    template <typename T>
+    void buildContinuousAttribute (const Distribution&,
+                                   ContinuousAttributeLite<T>&) const;
+
+    /**
+     * Tell whether the given distribution is the same as the given
+     * distribution of the given model. For distributions of codes, the
+     * (interned) codes are compared, rather than their indices.
+     */
+    bool isSameDistribution (const Distribution&, const CompiledDemandModel&,
+                             const Distribution&,
+                             const bool iIsCategorical) const;
+
+    /** Point to the tables held in memory (i.e., not mapped). */
+    void pointToVectors();
+
+    /**
+     * Check that the indices held by the demand records refer to actual
+     * pairs and strings.
+     */
+    void checkDemands() const;
+
+
+  private:
+    // ////////// Constructors and destructors /////////
+    /** Copy constructor (not to be used). */
+    CompiledDemandModel (const CompiledDemandModel&);
+
+
+  private:
+    // ////////// Attributes /////////
+    /**
+     * Tables being filled, when the model is being compiled.
+     */
+    std::vector<Demand> _demandVector;
+    std::vector<Pair> _pairVector;
+    std::vector<String> _stringVector;
+    std::vector<char> _stringDataVector;
+
+    /**
+     * Index of the interned strings, when the model is being compiled.
+     */
+    std::map<std::string, boost::uint32_t> _stringIndex;
+
+    /**
+     * Compiled demand model file, mapped in memory (when loaded).
+     */
+    boost::iostreams::mapped_file_source _mappedFile;
+
+    /**
+     * Tables, pointing either within the mapped file or to the vectors.
+     */
+    const Demand* _demands;
+    std::size_t _nbOfDemands;
+    const Pair* _pairs;
+    std::size_t _nbOfPairs;
+    const String* _strings;
+    std::size_t _nbOfStrings;
+    const char* _stringData;
+    std::size_t _stringDataSize;
+  };
+
+  /** (Smart) Pointer on a compiled demand model. */
+  typedef boost::shared_ptr<CompiledDemandModel> CompiledDemandModelPtr_T;
+
+  /**
+   * List of compiled demand models, e.g., one per part of the demand
+   * input files, the demands of which are loaded in that order.
+   */
+  typedef std::vector<CompiledDemandModelPtr_T> CompiledDemandModelList_T;
+
+}
+#endif // __TRADEMGEN_CMD_COMPILEDDEMANDMODEL_HPP
@@ -0,0 +1,172 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <unistd.h>
+// TraDemGen
+#include <trademgen/TRADEMGEN_Exceptions.hpp>
+#include <trademgen/basic/BasConst_DemandGenerationServer.hpp>
+#include <trademgen/command/DemandGenerationChannel.hpp>
+
+namespace TRADEMGEN {
+
+  namespace {
+
+    /** Header of the frames. */
+    struct FrameHeader {
+      boost::uint32_t _type;
+      boost::uint32_t _size;
+    };
+
+    /** Size (in bytes) of the chunks read from the socket. */
+    const std::size_t K_RECEIVE_SIZE = 64 * 1024;
+
+#if defined(MSG_NOSIGNAL)
+    /** A lost connection must not raise SIGPIPE. */
+    const int K_SEND_FLAGS = MSG_NOSIGNAL;
+#else // if defined(MSG_NOSIGNAL)
+    const int K_SEND_FLAGS = 0;
+#endif // if defined(MSG_NOSIGNAL)
+
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  DemandGenerationChannel::DemandGenerationChannel (const int iSocket,
+                                                    const std::string& iPeerName)
+    : _socket (iSocket), _peerName (iPeerName) {
+    assert (_socket != -1);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  DemandGenerationChannel::~DemandGenerationChannel() {
+    ::close (_socket);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void DemandGenerationChannel::throwConnectionLost (const int iErrorNumber) const {
+    std::ostringstream oMessage;
+    oMessage << "The connection with " << _peerName << " has been lost";
+    if (iErrorNumber != 0) {
+      oMessage << ": " << std::strerror (iErrorNumber);
+    }
+    throw DemandGenerationServerException (oMessage.str());
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void DemandGenerationChannel::writeAll (const void* iData,
+                                          const std::size_t iSize) {
+    const char* lData = static_cast<const char*> (iData);
+    std::size_t lRemainingSize = iSize;
+    while (lRemainingSize != 0) {
+      const ssize_t lSentSize = send (_socket, lData, lRemainingSize,
+                                      K_SEND_FLAGS);
+      if (lSentSize < 0 && errno == EINTR) {
+        continue;
+      }
+      if (lSentSize <= 0) {
+        throwConnectionLost (errno);
+      }
+      lData += lSentSize;
+      lRemainingSize -= lSentSize;
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool DemandGenerationChannel::receive() {
+    char lChunk[K_RECEIVE_SIZE];
+    while (true) {
+      const ssize_t lReceivedSize = recv (_socket, lChunk, K_RECEIVE_SIZE, 0);
+      if (lReceivedSize < 0 && errno == EINTR) {
+        continue;
+      }
+      if (lReceivedSize < 0) {
+        throwConnectionLost (errno);
+      }
+      _inputBuffer.append (lChunk, lReceivedSize);
+      return (lReceivedSize != 0);
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void DemandGenerationChannel::writeLine (const std::string& iLine) {
+    assert (iLine.find ('\n') == std::string::npos);
+    const std::string lLine = iLine + '\n';
+    writeAll (lLine.data(), lLine.size());
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool DemandGenerationChannel::readLine (std::string& oLine) {
+    std::size_t lEndPos = _inputBuffer.find ('\n');
+    while (lEndPos == std::string::npos) {
+      if (_inputBuffer.size() > MAX_DEMAND_GENERATION_MESSAGE_SIZE) {
+        std::ostringstream oMessage;
+        oMessage << "The command sent by " << _peerName << " is longer than "
+                 << MAX_DEMAND_GENERATION_MESSAGE_SIZE << " bytes";
+        throw DemandGenerationServerException (oMessage.str());
+      }
+
+      const std::size_t lSize = _inputBuffer.size();
+      if (receive() == false) {
+        // An unterminated last line is given as is
+        if (_inputBuffer.empty() == true) {
+          return false;
+        }
+        oLine.swap (_inputBuffer);
+        _inputBuffer.clear();
+        return true;
+      }
+      lEndPos = _inputBuffer.find ('\n', lSize);
+    }
+
+    oLine.assign (_inputBuffer, 0, lEndPos);
+    _inputBuffer.erase (0, lEndPos + 1);
+    return true;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void DemandGenerationChannel::writeFrame (const EN_FrameType iType,
+                                            const void* iPayload,
+                                            const std::size_t iSize) {
+    assert (iSize <= MAX_DEMAND_GENERATION_MESSAGE_SIZE);
+    FrameHeader lHeader;
+    lHeader._type = iType;
+    lHeader._size = iSize;
+    writeAll (&lHeader, sizeof (lHeader));
+    writeAll (iPayload, iSize);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void DemandGenerationChannel::readFrame (EN_FrameType& oType,
+                                           std::string& oPayload) {
+    while (_inputBuffer.size() < sizeof (FrameHeader)) {
+      if (receive() == false) {
+        throwConnectionLost (0);
+      }
+    }
+    FrameHeader lHeader;
+    std::memcpy (&lHeader, _inputBuffer.data(), sizeof (lHeader));
+    if ((lHeader._type != JSON_FRAME && lHeader._type != RECORD_FRAME)
+        || lHeader._size > MAX_DEMAND_GENERATION_MESSAGE_SIZE) {
+      std::ostringstream oMessage;
+      oMessage << "The frame sent by " << _peerName << " is malformed (type "
+               << lHeader._type << ", " << lHeader._size << " bytes)";
+      throw DemandGenerationServerException (oMessage.str());
+    }
+
+    while (_inputBuffer.size() < sizeof (FrameHeader) + lHeader._size) {
+      if (receive() == false) {
+        throwConnectionLost (0);
+      }
+    }
+    oType = static_cast<EN_FrameType> (lHeader._type);
+    oPayload.assign (_inputBuffer, sizeof (FrameHeader), lHeader._size);
+    _inputBuffer.erase (0, sizeof (FrameHeader) + lHeader._size);
+  }
+
+}
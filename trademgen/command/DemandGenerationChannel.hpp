@@ -0,0 +1,144 @@
+#ifndef __TRADEMGEN_CMD_DEMANDGENERATIONCHANNEL_HPP
+#define __TRADEMGEN_CMD_DEMANDGENERATIONCHANNEL_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cstddef>
+#include <string>
+// Boost
+#include <boost/cstdint.hpp>
+
+namespace TRADEMGEN {
+
+  /**
+   * @brief End of a connection between the demand generation server
+   *        (see DemandGenerationServer) and one of its clients (see
+   *        DemandGenerationClient), over a Unix domain socket.
+   *
+   * The client sends commands, i.e., JSON documents, one per line. The
+   * server answers with frames, each one made of a header (type and
+   * size of the payload, in the byte order of the machine) followed by
+   * the payload:
+   * <ul>
+   *   <li>a JSON frame holds a JSON document (e.g., the status of a
+   *       generation session, or the answer to a command);</li>
+   *   <li>a record frame holds fixed-size request records (see
+   *       SharedRequestRecord).</li>
+   * </ul>
+   */
+  class DemandGenerationChannel {
+  public:
+    // ////////// Type definitions /////////
+    /** Type of the frames. */
+    enum EN_FrameType {
+      JSON_FRAME = 1,
+      RECORD_FRAME
+    };
+
+
+  public:
+    // ////////// Constructors and destructors /////////
+    /**
+     * Constructor.
+     *
+     * @param const int Connected socket, owned from then on.
+     * @param const std::string& Description of the other end (for the
+     *        error messages).
+     */
+    DemandGenerationChannel (const int iSocket, const std::string& iPeerName);
+
+    /**
+     * Destructor. The socket is closed.
+     */
+    ~DemandGenerationChannel();
+
+
+  public:
+    // ////////// Business methods /////////
+    /**
+     * Send the given command, followed by a line feed.
+     *
+     * @throw DemandGenerationServerException when the connection is lost.
+     */
+    void writeLine (const std::string&);
+
+    /**
+     * Receive the next command.
+     *
+     * @param std::string& Received command (without the line feed).
+     * @return bool Whether a command has been received, i.e., the other
+     *         end has not closed the connection.
+     * @throw DemandGenerationServerException when the connection is lost,
+     *        or when the command is too long.
+     */
+    bool readLine (std::string&);
+
+    /**
+     * Send a frame of the given type, made of the given payload.
+     *
+     * @throw DemandGenerationServerException when the connection is lost.
+     */
+    void writeFrame (const EN_FrameType, const void*, const std::size_t);
+
+    /**
+     * Receive the next frame.
+     *
+     * @param EN_FrameType& Type of the received frame.
+     * @param std::string& Payload of the received frame.
+     * @throw DemandGenerationServerException when the connection is lost,
+     *        or when the frame is malformed.
+     */
+    void readFrame (EN_FrameType&, std::string&);
+
+
+  private:
+    // ////////// Helpers /////////
+    /**
+     * Send the given bytes, whatever the number of system calls needed.
+     */
+    void writeAll (const void*, const std::size_t);
+
+    /**
+     * Receive more bytes into the input buffer.
+     *
+     * @return bool Whether bytes have been received, i.e., the other end
+     *         has not closed the connection.
+     */
+    bool receive();
+
+    /**
+     * Throw an exception telling that the connection is lost.
+     */
+    void throwConnectionLost (const int iErrorNumber) const;
+
+
+  private:
+    // ////////// Constructors and destructors /////////
+    /** Default constructor (not to be used). */
+    DemandGenerationChannel();
+    /** Copy constructor (not to be used). */
+    DemandGenerationChannel (const DemandGenerationChannel&);
+
+
+  private:
+    // ////////// Attributes /////////
+    /**
+     * Connected socket.
+     */
+    int _socket;
+
+    /**
+     * Description of the other end.
+     */
+    std::string _peerName;
+
+    /**
+     * Bytes received but not consumed yet.
+     */
+    std::string _inputBuffer;
+  };
+
+}
+#endif // __TRADEMGEN_CMD_DEMANDGENERATIONCHANNEL_HPP
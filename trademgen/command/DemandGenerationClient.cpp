@@ -0,0 +1,169 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+// Boost
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+// TraDemGen
+#include <trademgen/TRADEMGEN_Exceptions.hpp>
+#include <trademgen/RequestSink.hpp>
+#include <trademgen/basic/BasConst_DemandGenerationServer.hpp>
+#include <trademgen/command/SharedRequestRing.hpp>
+#include <trademgen/command/DemandGenerationClient.hpp>
+
+namespace TRADEMGEN {
+
+  namespace {
+
+    // //////////////////////////////////////////////////////////////////
+    /**
+     * Parse the given JSON document.
+     */
+    boost::property_tree::ptree parseJSON (const std::string& iJSON) {
+      boost::property_tree::ptree oTree;
+      std::istringstream lStream (iJSON);
+      try {
+        boost::property_tree::read_json (lStream, oTree);
+
+      } catch (const boost::property_tree::json_parser_error& iError) {
+        std::ostringstream oMessage;
+        oMessage << "The JSON document '" << iJSON << "' cannot be parsed: "
+                 << iError.what();
+        throw DemandGenerationServerException (oMessage.str());
+      }
+      return oTree;
+    }
+
+    // //////////////////////////////////////////////////////////////////
+    /**
+     * Parse the given session status, and throw when it is an error.
+     */
+    boost::property_tree::ptree parseStatus (const std::string& iStatus) {
+      const boost::property_tree::ptree oStatus = parseJSON (iStatus);
+      if (oStatus.get<std::string> ("status", "") == "error") {
+        throw DemandGenerationServerException (oStatus.get<std::string>
+                                               ("message", iStatus));
+      }
+      return oStatus;
+    }
+
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  DemandGenerationClient::DemandGenerationClient (const std::string& iSocketPath)
+    : _nbOfReceivedRequests (0) {
+
+    struct sockaddr_un lAddress;
+    std::memset (&lAddress, 0, sizeof (lAddress));
+    lAddress.sun_family = AF_UNIX;
+    if (iSocketPath.size() >= sizeof (lAddress.sun_path)) {
+      std::ostringstream oMessage;
+      oMessage << "The socket path '" << iSocketPath << "' is too long";
+      throw DemandGenerationServerException (oMessage.str());
+    }
+    std::memcpy (lAddress.sun_path, iSocketPath.data(), iSocketPath.size());
+
+    const int lSocket = socket (AF_UNIX, SOCK_STREAM, 0);
+    if (lSocket == -1
+        || connect (lSocket, reinterpret_cast<struct sockaddr*> (&lAddress),
+                    sizeof (lAddress)) != 0) {
+      const int lErrorNumber = errno;
+      if (lSocket != -1) {
+        ::close (lSocket);
+      }
+      std::ostringstream oMessage;
+      oMessage << "No demand generation server can be reached on '"
+               << iSocketPath << "': " << std::strerror (lErrorNumber);
+      throw DemandGenerationServerException (oMessage.str());
+    }
+
+    _channel.reset (new DemandGenerationChannel (lSocket, "the demand "
+                                                 "generation server on '"
+                                                 + iSocketPath + "'"));
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  DemandGenerationClient::~DemandGenerationClient() {
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  std::string DemandGenerationClient::execute (const std::string& iCommand) {
+    assert (_channel != NULL);
+    _channel->writeLine (iCommand);
+
+    DemandGenerationChannel::EN_FrameType lFrameType;
+    std::string oAnswer;
+    _channel->readFrame (lFrameType, oAnswer);
+    if (lFrameType != DemandGenerationChannel::JSON_FRAME) {
+      throw DemandGenerationServerException ("The demand generation server "
+                                             "has not answered the command");
+    }
+    return oAnswer;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  std::string DemandGenerationClient::generate (const std::string& iRequest,
+                                                RequestSink& ioRequestSink) {
+    assert (_channel != NULL);
+
+    // With a credit, the server waits for the client to grant more
+    const boost::property_tree::ptree lRequest = parseJSON (iRequest);
+    const bool hasCredit = (lRequest.get<boost::uint64_t> ("generate.credit",
+                                                           0) != 0);
+
+    // The server first tells whether it accepts the request
+    const std::string lStartStatus = execute (iRequest);
+    const boost::property_tree::ptree lStatus = parseStatus (lStartStatus);
+    if (lStatus.get<boost::uint32_t> ("version", 0)
+        != DEMAND_GENERATION_PROTOCOL_VERSION
+        || lStatus.get<std::size_t> ("record_size", 0)
+        != sizeof (SharedRequestRecord)) {
+      throw DemandGenerationServerException ("The demand generation server "
+                                             "speaks another version of the "
+                                             "protocol: " + lStartStatus);
+    }
+
+    // Then come the booking requests, and eventually the final status
+    DemandGenerationChannel::EN_FrameType lFrameType;
+    std::string lPayload;
+    while (true) {
+      _channel->readFrame (lFrameType, lPayload);
+      if (lFrameType == DemandGenerationChannel::JSON_FRAME) {
+        break;
+      }
+
+      const std::size_t lNbOfRecords =
+        lPayload.size() / sizeof (SharedRequestRecord);
+      if (lPayload.size() % sizeof (SharedRequestRecord) != 0) {
+        throw DemandGenerationServerException ("The demand generation server "
+                                               "has sent truncated records");
+      }
+      SharedRequestRecord lRecord;
+      for (std::size_t idx = 0; idx != lNbOfRecords; ++idx) {
+        std::memcpy (&lRecord, lPayload.data() + idx * sizeof (lRecord),
+                     sizeof (lRecord));
+        ioRequestSink.write (*SharedRequestRing::decode (lRecord));
+      }
+      _nbOfReceivedRequests += lNbOfRecords;
+
+      if (hasCredit == true) {
+        std::ostringstream oCommand;
+        oCommand << "{\"credit\": " << lNbOfRecords << "}";
+        _channel->writeLine (oCommand.str());
+      }
+    }
+    ioRequestSink.flush();
+
+    parseStatus (lPayload);
+    return lPayload;
+  }
+
+}
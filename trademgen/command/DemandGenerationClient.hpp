@@ -0,0 +1,104 @@
+#ifndef __TRADEMGEN_CMD_DEMANDGENERATIONCLIENT_HPP
+#define __TRADEMGEN_CMD_DEMANDGENERATIONCLIENT_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <string>
+// Boost
+#include <boost/cstdint.hpp>
+#include <boost/scoped_ptr.hpp>
+// TraDemGen
+#include <trademgen/command/DemandGenerationChannel.hpp>
+
+namespace TRADEMGEN {
+
+  // Forward declarations
+  class RequestSink;
+
+  /**
+   * @brief Client of a demand generation server (see
+   *        DemandGenerationServer), i.e., of a resident process having
+   *        loaded the demand once for all.
+   *
+   * The booking requests of a generation session are handed over to a
+   * sink, as if they were generated by the current process.
+   */
+  class DemandGenerationClient {
+  public:
+    // ////////// Constructors and destructors /////////
+    /**
+     * Constructor. The client connects to the server.
+     *
+     * @param const std::string& Path of the Unix domain socket on which
+     *        the server listens.
+     * @throw DemandGenerationServerException when no server listens on
+     *        that socket.
+     */
+    explicit DemandGenerationClient (const std::string& iSocketPath);
+
+    /**
+     * Destructor. The connection is closed.
+     */
+    ~DemandGenerationClient();
+
+
+  public:
+    // ////////// Getters /////////
+    /** Get the number of booking requests received so far. */
+    const boost::uint64_t& getNbOfReceivedRequests() const {
+      return _nbOfReceivedRequests;
+    }
+
+
+  public:
+    // ////////// Business methods /////////
+    /**
+     * Send the given command (e.g., {"shutdown": {}}, or a command of
+     * TRADEMGEN_Service::jsonHandler()), and get the answer.
+     *
+     * @param const std::string& Command, as a JSON document.
+     * @return std::string Answer, as a JSON document.
+     */
+    std::string execute (const std::string& iCommand);
+
+    /**
+     * Run a generation session (see DemandGenerationServer for the
+     * format of the request), handing over the generated booking
+     * requests to the given sink. With a credit, the client grants the
+     * server more credit as it consumes the booking requests, so that
+     * the server is never more than that credit ahead.
+     *
+     * @param const std::string& Generation request, as a JSON document.
+     * @param RequestSink& Sink receiving the booking requests.
+     * @return std::string Final status of the session, as a JSON document.
+     * @throw DemandGenerationServerException when the server rejects the
+     *        request, or when the connection is lost.
+     */
+    std::string generate (const std::string& iRequest, RequestSink&);
+
+
+  private:
+    // ////////// Constructors and destructors /////////
+    /** Default constructor (not to be used). */
+    DemandGenerationClient();
+    /** Copy constructor (not to be used). */
+    DemandGenerationClient (const DemandGenerationClient&);
+
+
+  private:
+    // ////////// Attributes /////////
+    /**
+     * Connection with the server.
+     */
+    boost::scoped_ptr<DemandGenerationChannel> _channel;
+
+    /**
+     * Number of booking requests received so far.
+     */
+    boost::uint64_t _nbOfReceivedRequests;
+  };
+
+}
+#endif // __TRADEMGEN_CMD_DEMANDGENERATIONCLIENT_HPP
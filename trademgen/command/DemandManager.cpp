@@ -2,15 +2,24 @@
 // Import section
 // //////////////////////////////////////////////////////////////////////
 // STL
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <map>
+#include <set>
+#include <sstream>
+#include <tuple>
+#include <vector>
 // Boost
 #include <boost/make_shared.hpp>
 // StdAir
 #include <stdair/basic/ProgressStatusSet.hpp>
+#include <stdair/basic/BasConst_General.hpp>
 #include <stdair/basic/BasConst_Request.hpp>
 #include <stdair/bom/BomManager.hpp>
 #include <stdair/bom/EventStruct.hpp>
 #include <stdair/bom/BookingRequestStruct.hpp>
+#include <stdair/bom/BreakPointStruct.hpp>
 #include <stdair/bom/TravelSolutionStruct.hpp>
 #include <stdair/bom/CancellationStruct.hpp>
 #include <stdair/factory/FacBom.hpp>
@@ -19,10 +28,22 @@
 // SEvMgr
 #include <sevmgr/SEVMGR_Service.hpp>
 // TraDemGen
+#include <trademgen/TRADEMGEN_Exceptions.hpp>
+#include <trademgen/RequestSink.hpp>
+#include <trademgen/basic/ArrivalCountTable.hpp>
 #include <trademgen/basic/DemandCharacteristics.hpp>
 #include <trademgen/basic/DemandDistribution.hpp>
+#include <trademgen/basic/BasConst_DemandGeneration.hpp>
+#include <trademgen/basic/BasConst_DemandLoading.hpp>
+#include <trademgen/basic/ParallelTasks.hpp>
+#include <trademgen/basic/TotalNumberOfRequestsTable.hpp>
+#include <trademgen/bom/DemandAdjustmentStruct.hpp>
+#include <trademgen/bom/DemandFilterStruct.hpp>
 #include <trademgen/bom/DemandStruct.hpp>
 #include <trademgen/bom/DemandStream.hpp>
+#include <trademgen/bom/DemandStreamSchedule.hpp>
+#include <trademgen/bom/DemandStreamSnapshot.hpp>
+#include <trademgen/command/RequestShard.hpp>
 #include <trademgen/command/DemandManager.hpp>
 
 namespace TRADEMGEN {
@@ -305,6 +326,1551 @@ namespace TRADEMGEN {
     }
   }
 
+  // //////////////////////////////////////////////////////////////////////
+  /**
+   * What a demand stream gets from the shared random generator.
+   */
+  struct DemandStreamDraw {
+    DemandStream* _demandStream;
+    stdair::RandomSeed_T _requestDateTimeSeed;
+    stdair::RandomSeed_T _demandCharacteristicsSeed;
+    stdair::NbOfRequests_T _totalNumberOfRequests;
+  };
+
+  // //////////////////////////////////////////////////////////////////////
+  /**
+   * Demand of a compiled demand model, along with the index of the
+   * draws of its first demand stream.
+   */
+  struct CompiledDemandRef {
+    const CompiledDemandModel* _compiledDemandModel;
+    std::size_t _demandIdx;
+    std::size_t _firstDrawIdx;
+  };
+
+  // //////////////////////////////////////////////////////////////////////
+  /**
+   * Get the keys of the demand streams of the given compiled demand
+   * selected by the given filter, in the order of their preferred
+   * departure dates.
+   */
+  static void
+  getDemandStreamKeyList (const CompiledDemandModel& iCompiledDemandModel,
+                          const std::size_t iDemandIdx,
+                          const DemandFilterStruct& iDemandFilter,
+                          std::vector<DemandStreamKey>& ioDemandStreamKeyList) {
+    ioDemandStreamKeyList.clear();
+
+    const CompiledDemandModel::Demand& lDemand =
+      iCompiledDemandModel.getDemand (iDemandIdx);
+    const stdair::AirportCode_T lOrigin =
+      iCompiledDemandModel.getString (lDemand._originIdx);
+    const stdair::AirportCode_T lDestination =
+      iCompiledDemandModel.getString (lDemand._destinationIdx);
+    const stdair::CabinCode_T lPrefCabin =
+      iCompiledDemandModel.getString (lDemand._prefCabinIdx);
+    if (iDemandFilter.matchesMarket (lOrigin, lDestination,
+                                     lPrefCabin) == false) {
+      return;
+    }
+
+    const stdair::DatePeriod_T lDateRange =
+      iCompiledDemandModel.getDateRange (iDemandIdx);
+    for (boost::gregorian::day_iterator itDate = lDateRange.begin();
+         itDate != lDateRange.end(); ++itDate) {
+      const stdair::Date_T& currentDate = *itDate;
+
+      // The bits of the mask follow the Boost numbering of the
+      // Days-Of-the-Week
+      const unsigned short currentDoW = currentDate.day_of_week().as_number();
+      if ((lDemand._dowMask & (1U << currentDoW)) == 0
+          || iDemandFilter.matchesDate (currentDate) == false) {
+        continue;
+      }
+
+      ioDemandStreamKeyList.push_back (DemandStreamKey (lOrigin, lDestination,
+                                                        currentDate,
+                                                        lPrefCabin));
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  /**
+   * Sampling weights of the sampled demand streams, by key.
+   */
+  typedef std::map<stdair::DemandStreamKeyStr_T,
+                   stdair::RealNumber_T> DemandStreamSample_T;
+
+  // //////////////////////////////////////////////////////////////////////
+  /**
+   * Sample, stratum by stratum, the demand streams of the given compiled
+   * demand models selected by the given filter (see
+   * DemandFilterStruct::_samplingRate). The demand streams of every
+   * stratum are drawn, by selection sampling, from their list sorted on
+   * the keys, so that the sample depends neither on the order of the
+   * demands nor on the shared generator.
+   */
+  static void
+  sampleDemandStreams (const CompiledDemandModelList_T& iCompiledDemandModelList,
+                       const DemandFilterStruct& iDemandFilter,
+                       DemandStreamSample_T& ioDemandStreamSample) {
+    ioDemandStreamSample.clear();
+
+    // Gather the selected demand streams by origin, destination and
+    // month of the preferred departure date
+    typedef std::map<std::string,
+                     std::set<stdair::DemandStreamKeyStr_T> > StratumMap_T;
+    StratumMap_T lStratumMap;
+    std::vector<DemandStreamKey> lDemandStreamKeyList;
+    for (CompiledDemandModelList_T::const_iterator itModel =
+           iCompiledDemandModelList.begin();
+         itModel != iCompiledDemandModelList.end(); ++itModel) {
+      const CompiledDemandModel& lCompiledDemandModel = **itModel;
+      const std::size_t lNbOfDemands = lCompiledDemandModel.getNbOfDemands();
+      for (std::size_t idx = 0; idx != lNbOfDemands; ++idx) {
+        getDemandStreamKeyList (lCompiledDemandModel, idx, iDemandFilter,
+                                lDemandStreamKeyList);
+        for (std::vector<DemandStreamKey>::const_iterator itKey =
+               lDemandStreamKeyList.begin();
+             itKey != lDemandStreamKeyList.end(); ++itKey) {
+          const stdair::Date_T& lDate = itKey->getPreferredDepartureDate();
+          std::ostringstream lStratumStr;
+          lStratumStr << itKey->getOrigin() << "-" << itKey->getDestination()
+                      << " " << lDate.year() << "-"
+                      << lDate.month().as_number();
+          lStratumMap[lStratumStr.str()].insert (itKey->toString());
+        }
+      }
+    }
+
+    // Draw the demand streams of every stratum, with Knuth's selection
+    // sampling. The weight of a sampled demand stream is the number of
+    // demand streams of its stratum it stands for.
+    stdair::RandomGeneration lSamplingGenerator (iDemandFilter._samplingSeed);
+    for (StratumMap_T::const_iterator itStratum = lStratumMap.begin();
+         itStratum != lStratumMap.end(); ++itStratum) {
+      const std::set<stdair::DemandStreamKeyStr_T>& lKeySet =
+        itStratum->second;
+      const std::size_t lNbOfDemandStreams = lKeySet.size();
+      std::size_t lNbOfSampledDemandStreams =
+        static_cast<std::size_t> (std::floor (iDemandFilter._samplingRate
+                                              * lNbOfDemandStreams + 0.5));
+      if (lNbOfSampledDemandStreams == 0) {
+        lNbOfSampledDemandStreams = 1;
+      } else if (lNbOfSampledDemandStreams > lNbOfDemandStreams) {
+        lNbOfSampledDemandStreams = lNbOfDemandStreams;
+      }
+      const stdair::RealNumber_T lSamplingWeight =
+        static_cast<stdair::RealNumber_T> (lNbOfDemandStreams)
+        / lNbOfSampledDemandStreams;
+
+      std::size_t lNbOfVisitedDemandStreams = 0;
+      std::size_t lNbOfSelectedDemandStreams = 0;
+      for (std::set<stdair::DemandStreamKeyStr_T>::const_iterator itKey =
+             lKeySet.begin(); itKey != lKeySet.end(); ++itKey) {
+        const stdair::RealNumber_T lVariateUnif = lSamplingGenerator();
+        if ((lNbOfDemandStreams - lNbOfVisitedDemandStreams) * lVariateUnif
+            < lNbOfSampledDemandStreams - lNbOfSelectedDemandStreams) {
+          ioDemandStreamSample.
+            insert (DemandStreamSample_T::value_type (*itKey,
+                                                      lSamplingWeight));
+          ++lNbOfSelectedDemandStreams;
+        }
+        ++lNbOfVisitedDemandStreams;
+      }
+    }
+
+    // DEBUG
+    STDAIR_LOG_DEBUG ("Demand streams sampled: "
+                      << ioDemandStreamSample.size() << " out of "
+                      << lStratumMap.size() << " strata, with the filter "
+                      << iDemandFilter.describe());
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  /**
+   * Get the sampling weight of the given demand stream, selected by the
+   * given filter: zero when it has not been sampled, and one when the
+   * demand streams are not sampled.
+   */
+  static stdair::RealNumber_T
+  findSamplingWeight (const DemandFilterStruct& iDemandFilter,
+                      const DemandStreamSample_T& iDemandStreamSample,
+                      const DemandStreamKey& iKey) {
+    if (iDemandFilter.isSampled() == false) {
+      return 1.0;
+    }
+    const DemandStreamSample_T::const_iterator itSample =
+      iDemandStreamSample.find (iKey.toString());
+    if (itSample == iDemandStreamSample.end()) {
+      return 0.0;
+    }
+    return itSample->second;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void DemandManager::
+  createDemandCharacteristics (SEVMGR::SEVMGR_ServicePtr_T ioSEVMGR_ServicePtr,
+                               stdair::RandomGeneration& ioSharedGenerator,
+                               const POSProbabilityMass_T& iPOSProbMass,
+                               const CompiledDemandModelList_T& iCompiledDemandModelList,
+                               const DemandFilterStruct& iDemandFilter,
+                               const unsigned int iNbOfThreads) {
+    // Sanity check
+    assert (ioSEVMGR_ServicePtr != NULL);
+
+    //
+    stdair::BaseGenerator_T& lSharedGenerator =
+      ioSharedGenerator.getBaseGenerator();
+
+    /**
+     * 1. Walk through the demands and their active dates, in the same
+     *    order as createDemandCharacteristics() does, so as to create
+     *    the demand streams and to make the same draws with the shared
+     *    generator: the two seeds, and then the total number of
+     *    requests, of every demand stream. The demand streams not
+     *    selected by the filter, or not sampled, only get their draws.
+     */
+    DemandStreamSample_T lDemandStreamSample;
+    if (iDemandFilter.isSampled() == true) {
+      sampleDemandStreams (iCompiledDemandModelList, iDemandFilter,
+                           lDemandStreamSample);
+    }
+    std::vector<CompiledDemandRef> lDemandList;
+    std::vector<DemandStreamDraw> lDrawList;
+    for (CompiledDemandModelList_T::const_iterator itModel =
+           iCompiledDemandModelList.begin();
+         itModel != iCompiledDemandModelList.end(); ++itModel) {
+      const CompiledDemandModel& lCompiledDemandModel = **itModel;
+      const std::size_t lNbOfDemands = lCompiledDemandModel.getNbOfDemands();
+      for (std::size_t idx = 0; idx != lNbOfDemands; ++idx) {
+        const CompiledDemandRef lDemandRef = { &lCompiledDemandModel, idx,
+                                               lDrawList.size() };
+        lDemandList.push_back (lDemandRef);
+
+        const CompiledDemandModel::Demand& lDemand =
+          lCompiledDemandModel.getDemand (idx);
+        const stdair::AirportCode_T lOrigin =
+          lCompiledDemandModel.getString (lDemand._originIdx);
+        const stdair::AirportCode_T lDestination =
+          lCompiledDemandModel.getString (lDemand._destinationIdx);
+        const stdair::CabinCode_T lPrefCabin =
+          lCompiledDemandModel.getString (lDemand._prefCabinIdx);
+        const DemandDistribution lDemandDistribution (lDemand._demandMean,
+                                                      lDemand._demandStdDev);
+        const bool isMarketSelected =
+          iDemandFilter.matchesMarket (lOrigin, lDestination, lPrefCabin);
+
+        const stdair::DatePeriod_T lDateRange =
+          lCompiledDemandModel.getDateRange (idx);
+        for (boost::gregorian::day_iterator itDate = lDateRange.begin();
+             itDate != lDateRange.end(); ++itDate) {
+          const stdair::Date_T& currentDate = *itDate;
+
+          // The bits of the mask follow the Boost numbering of the
+          // Days-Of-the-Week
+          const unsigned short currentDoW =
+            currentDate.day_of_week().as_number();
+          if ((lDemand._dowMask & (1U << currentDoW)) == 0) {
+            continue;
+          }
+
+          // The demand stream is not selected: it is not created
+          if (isMarketSelected == false
+              || iDemandFilter.matchesDate (currentDate) == false) {
+            skipDemandStreamDraws (ioSharedGenerator, lDemandDistribution);
+            continue;
+          }
+
+          const DemandStreamKey lDemandStreamKey (lOrigin, lDestination,
+                                                  currentDate, lPrefCabin);
+          const stdair::RealNumber_T lSamplingWeight =
+            findSamplingWeight (iDemandFilter, lDemandStreamSample,
+                                lDemandStreamKey);
+          if (lSamplingWeight == 0.0) {
+            skipDemandStreamDraws (ioSharedGenerator, lDemandDistribution);
+            continue;
+          }
+
+          DemandStreamDraw lDraw;
+          lDraw._requestDateTimeSeed = generateSeed (ioSharedGenerator);
+          lDraw._demandCharacteristicsSeed = generateSeed (ioSharedGenerator);
+          lDraw._demandStream =
+            &stdair::FacBom<DemandStream>::instance().create (lDemandStreamKey);
+          lDraw._demandStream->setFiltered (iDemandFilter.selectsAll()
+                                            == false);
+          lDraw._demandStream->setSamplingWeight (lSamplingWeight);
+          lDraw._totalNumberOfRequests =
+            DemandStream::drawTotalNumberOfRequests (lDemandDistribution,
+                                                     lSharedGenerator);
+          lDrawList.push_back (lDraw);
+        }
+      }
+    }
+
+    /**
+     * 2. Set up the demand streams concurrently, by batches of demands.
+     *    That is where most of the time goes, as the distributions of
+     *    every demand stream are built there, straight from the compiled
+     *    distribution tables of the demand.
+     */
+    const std::size_t lNbOfDemands = lDemandList.size();
+    const std::size_t lNbOfTasks =
+      (lNbOfDemands + NB_OF_DEMANDS_PER_LOADING_TASK - 1)
+      / NB_OF_DEMANDS_PER_LOADING_TASK;
+    auto lSetUpDemandStreams = [&] (const std::size_t iTaskIdx) {
+      const std::size_t lFirstDemandIdx =
+        iTaskIdx * NB_OF_DEMANDS_PER_LOADING_TASK;
+      std::size_t lLastDemandIdx =
+        lFirstDemandIdx + NB_OF_DEMANDS_PER_LOADING_TASK;
+      if (lLastDemandIdx > lNbOfDemands) {
+        lLastDemandIdx = lNbOfDemands;
+      }
+
+      DemandCharacteristics lDemandCharacteristics;
+      for (std::size_t idx = lFirstDemandIdx; idx != lLastDemandIdx; ++idx) {
+        const CompiledDemandRef& lDemandRef = lDemandList[idx];
+        const std::size_t lEndDrawIdx = (idx + 1 == lNbOfDemands)?
+          lDrawList.size():lDemandList[idx + 1]._firstDrawIdx;
+        if (lDemandRef._firstDrawIdx == lEndDrawIdx) {
+          continue;
+        }
+
+        const CompiledDemandModel& lCompiledDemandModel =
+          *lDemandRef._compiledDemandModel;
+        lCompiledDemandModel.fillDemandCharacteristics (lDemandRef._demandIdx,
+                                                        lDemandCharacteristics);
+        const CompiledDemandModel::Demand& lDemand =
+          lCompiledDemandModel.getDemand (lDemandRef._demandIdx);
+        const DemandDistribution lDemandDistribution (lDemand._demandMean,
+                                                      lDemand._demandStdDev);
+        for (std::size_t lDrawIdx = lDemandRef._firstDrawIdx;
+             lDrawIdx != lEndDrawIdx; ++lDrawIdx) {
+          const DemandStreamDraw& lDraw = lDrawList[lDrawIdx];
+          lDraw._demandStream->setAll (lDemandCharacteristics,
+                                       lDemandDistribution,
+                                       lDraw._totalNumberOfRequests,
+                                       lDraw._requestDateTimeSeed,
+                                       lDraw._demandCharacteristicsSeed,
+                                       iPOSProbMass);
+        }
+      }
+    };
+    runParallelTasks (lNbOfTasks, iNbOfThreads, lSetUpDemandStreams);
+
+    /**
+     * 3. Add the demand streams to the EventQueue, and initialise the
+     *    progress statuses, in the order of the demands.
+     */
+    for (std::vector<DemandStreamDraw>::const_iterator itDraw =
+           lDrawList.begin(); itDraw != lDrawList.end(); ++itDraw) {
+      DemandStream& lDemandStream = *itDraw->_demandStream;
+      ioSEVMGR_ServicePtr->addEventGenerator (lDemandStream);
+
+      // Calculate the expected total number of events for the current
+      // demand stream
+      const stdair::NbOfRequests_T& lExpectedTotalNbOfEvents =
+        lDemandStream.getMeanNumberOfRequests();
+      ioSEVMGR_ServicePtr->addStatus (stdair::EventType::BKG_REQ,
+                                      lExpectedTotalNbOfEvents);
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  /**
+   * Demands of a given origin, destination and preferred departure
+   * date, i.e., indices within the list of the selected demands.
+   */
+  struct ODDateDemandList {
+    stdair::AirportCode_T _origin;
+    stdair::AirportCode_T _destination;
+    stdair::Date_T _date;
+    std::vector<std::size_t> _demandIdxList;
+  };
+
+  // //////////////////////////////////////////////////////////////////////
+  void DemandManager::
+  createMultiCabinDemandCharacteristics (SEVMGR::SEVMGR_ServicePtr_T ioSEVMGR_ServicePtr,
+                                         stdair::RandomGeneration& ioSharedGenerator,
+                                         const POSProbabilityMass_T& iPOSProbMass,
+                                         const CompiledDemandModelList_T& iCompiledDemandModelList,
+                                         const DemandFilterStruct& iDemandFilter) {
+    // Sanity check
+    assert (ioSEVMGR_ServicePtr != NULL);
+
+    // The strata of the sampling are not made of whole demand streams
+    // anymore
+    if (iDemandFilter.isSampled() == true) {
+      throw TrademgenGenerationException ("The demand streams cannot be "
+                                          "sampled when the cabins share "
+                                          "their demand streams");
+    }
+
+    //
+    stdair::BaseGenerator_T& lSharedGenerator =
+      ioSharedGenerator.getBaseGenerator();
+
+    /**
+     * 1. Rebuild the selected demands, and gather them by origin,
+     *    destination and preferred departure date, in the order of the
+     *    demands.
+     */
+    std::vector<CompiledDemandRef> lDemandRefList;
+    std::vector<DemandStruct> lDemandList;
+    std::vector<ODDateDemandList> lODDateList;
+    std::map<std::string, std::size_t> lODDateIdxMap;
+    for (CompiledDemandModelList_T::const_iterator itModel =
+           iCompiledDemandModelList.begin();
+         itModel != iCompiledDemandModelList.end(); ++itModel) {
+      const CompiledDemandModel& lCompiledDemandModel = **itModel;
+      const std::size_t lNbOfDemands = lCompiledDemandModel.getNbOfDemands();
+      for (std::size_t idx = 0; idx != lNbOfDemands; ++idx) {
+        const CompiledDemandModel::Demand& lDemand =
+          lCompiledDemandModel.getDemand (idx);
+        const stdair::AirportCode_T lOrigin =
+          lCompiledDemandModel.getString (lDemand._originIdx);
+        const stdair::AirportCode_T lDestination =
+          lCompiledDemandModel.getString (lDemand._destinationIdx);
+        const stdair::CabinCode_T lPrefCabin =
+          lCompiledDemandModel.getString (lDemand._prefCabinIdx);
+        if (iDemandFilter.matchesMarket (lOrigin, lDestination,
+                                         lPrefCabin) == false) {
+          continue;
+        }
+
+        // No draw is made beforehand
+        const std::size_t lDemandIdx = lDemandList.size();
+        const CompiledDemandRef lDemandRef = { &lCompiledDemandModel, idx, 0 };
+        lDemandRefList.push_back (lDemandRef);
+        lDemandList.push_back (DemandStruct());
+        lCompiledDemandModel.fillDemand (idx, lDemandList.back());
+
+        const stdair::DatePeriod_T lDateRange =
+          lCompiledDemandModel.getDateRange (idx);
+        for (boost::gregorian::day_iterator itDate = lDateRange.begin();
+             itDate != lDateRange.end(); ++itDate) {
+          const stdair::Date_T& currentDate = *itDate;
+
+          // The bits of the mask follow the Boost numbering of the
+          // Days-Of-the-Week
+          const unsigned short currentDoW =
+            currentDate.day_of_week().as_number();
+          if ((lDemand._dowMask & (1U << currentDoW)) == 0
+              || iDemandFilter.matchesDate (currentDate) == false) {
+            continue;
+          }
+
+          std::ostringstream lODDateKey;
+          lODDateKey << lOrigin << "-" << lDestination << "-"
+                     << boost::gregorian::to_iso_string (currentDate);
+          std::map<std::string, std::size_t>::const_iterator itODDate =
+            lODDateIdxMap.find (lODDateKey.str());
+          if (itODDate == lODDateIdxMap.end()) {
+            itODDate = lODDateIdxMap.insert (std::make_pair (lODDateKey.str(),
+                                                             lODDateList.size())).first;
+            ODDateDemandList lODDate;
+            lODDate._origin = lOrigin;
+            lODDate._destination = lDestination;
+            lODDate._date = currentDate;
+            lODDateList.push_back (lODDate);
+          }
+          lODDateList[itODDate->second]._demandIdxList.push_back (lDemandIdx);
+        }
+      }
+    }
+
+    /**
+     * 2. Create the demand streams of every origin, destination and
+     *    preferred departure date, one per arrival pattern.
+     */
+    for (std::vector<ODDateDemandList>::const_iterator itODDate =
+           lODDateList.begin(); itODDate != lODDateList.end(); ++itODDate) {
+      const ODDateDemandList& lODDate = *itODDate;
+
+      // Gather the cabins by arrival pattern
+      std::vector<std::vector<std::size_t> > lCabinGroupList;
+      for (std::vector<std::size_t>::const_iterator itDemandIdx =
+             lODDate._demandIdxList.begin();
+           itDemandIdx != lODDate._demandIdxList.end(); ++itDemandIdx) {
+        const CompiledDemandRef& lDemandRef = lDemandRefList[*itDemandIdx];
+        std::vector<std::vector<std::size_t> >::iterator itCabinGroup =
+          lCabinGroupList.begin();
+        for ( ; itCabinGroup != lCabinGroupList.end(); ++itCabinGroup) {
+          const CompiledDemandRef& lFirstDemandRef =
+            lDemandRefList[itCabinGroup->front()];
+          if (lDemandRef._compiledDemandModel->
+              hasSameArrivalPattern (lDemandRef._demandIdx,
+                                     *lFirstDemandRef._compiledDemandModel,
+                                     lFirstDemandRef._demandIdx) == true) {
+            break;
+          }
+        }
+        if (itCabinGroup == lCabinGroupList.end()) {
+          lCabinGroupList.push_back (std::vector<std::size_t>());
+          itCabinGroup = lCabinGroupList.end() - 1;
+        }
+        itCabinGroup->push_back (*itDemandIdx);
+      }
+
+      for (std::vector<std::vector<std::size_t> >::const_iterator itCabinGroup =
+             lCabinGroupList.begin();
+           itCabinGroup != lCabinGroupList.end(); ++itCabinGroup) {
+        const std::vector<std::size_t>& lCabinGroup = *itCabinGroup;
+        const DemandStruct& lFirstDemand = lDemandList[lCabinGroup.front()];
+
+        // The cabins (and their demand distributions) of the demand stream
+        std::ostringstream lPrefCabin;
+        stdair::MeanValue_T lDemandMean = 0.0;
+        stdair::RealNumber_T lDemandVariance = 0.0;
+        for (std::vector<std::size_t>::const_iterator itDemandIdx =
+               lCabinGroup.begin(); itDemandIdx != lCabinGroup.end();
+             ++itDemandIdx) {
+          const DemandStruct& lDemand = lDemandList[*itDemandIdx];
+          if (itDemandIdx != lCabinGroup.begin()) {
+            lPrefCabin << "/";
+          }
+          lPrefCabin << lDemand._prefCabin;
+          lDemandMean += lDemand._demandMean;
+          lDemandVariance += lDemand._demandStdDev * lDemand._demandStdDev;
+        }
+        const DemandStreamKey lDemandStreamKey (lODDate._origin,
+                                                lODDate._destination,
+                                                lODDate._date,
+                                                lPrefCabin.str());
+        const DemandDistribution lDemandDistribution (lDemandMean,
+                                                      std::sqrt (lDemandVariance));
+
+        // Seed
+        const stdair::RandomSeed_T& lRequestDateTimeSeed =
+          generateSeed (ioSharedGenerator);
+        const stdair::RandomSeed_T& lDemandCharacteristicsSeed =
+          generateSeed (ioSharedGenerator);
+
+        // The arrival pattern, shared by the cabins, is the one of the
+        // first of them
+        DemandStream& lDemandStream =
+          createDemandStream (ioSEVMGR_ServicePtr, lDemandStreamKey,
+                              lFirstDemand._dtdProbDist,
+                              lFirstDemand._posProbDist,
+                              lFirstDemand._channelProbDist,
+                              lFirstDemand._tripProbDist,
+                              lFirstDemand._stayProbDist,
+                              lFirstDemand._ffProbDist,
+                              lFirstDemand._changeFeeProb,
+                              lFirstDemand._changeFeeDisutility,
+                              lFirstDemand._nonRefundableProb,
+                              lFirstDemand._nonRefundableDisutility,
+                              lFirstDemand._prefDepTimeProbDist,
+                              lFirstDemand._minWTP,
+                              lFirstDemand._timeValueProbDist,
+                              lDemandDistribution, lSharedGenerator,
+                              lRequestDateTimeSeed,
+                              lDemandCharacteristicsSeed,
+                              iPOSProbMass);
+        lDemandStream.setFiltered (iDemandFilter.selectsAll() == false);
+
+        // The cabins are drawn in proportion to their mean numbers of
+        // requests (uniformly, when none is expected)
+        if (lCabinGroup.size() > 1) {
+          const stdair::NbOfRequests_T lNbOfCabins =
+            static_cast<stdair::NbOfRequests_T> (lCabinGroup.size());
+          DemandStream::CabinDemandList_T lCabinDemandList;
+          stdair::Probability_T lCumulativeProbability = 0.0;
+          for (std::vector<std::size_t>::const_iterator itDemandIdx =
+                 lCabinGroup.begin(); itDemandIdx != lCabinGroup.end();
+               ++itDemandIdx) {
+            const DemandStruct& lDemand = lDemandList[*itDemandIdx];
+            lCumulativeProbability += (lDemandMean > 0.0)?
+              lDemand._demandMean / lDemandMean : 1.0 / lNbOfCabins;
+            const DemandStream::CabinDemand lCabinDemand =
+              { lDemand._prefCabin, lCumulativeProbability,
+                DemandCharacteristics (lDemand._dtdProbDist,
+                                       lDemand._posProbDist,
+                                       lDemand._channelProbDist,
+                                       lDemand._tripProbDist,
+                                       lDemand._stayProbDist,
+                                       lDemand._ffProbDist,
+                                       lDemand._changeFeeProb,
+                                       lDemand._changeFeeDisutility,
+                                       lDemand._nonRefundableProb,
+                                       lDemand._nonRefundableDisutility,
+                                       lDemand._prefDepTimeProbDist,
+                                       lDemand._minWTP,
+                                       lDemand._timeValueProbDist) };
+            lCabinDemandList.push_back (lCabinDemand);
+          }
+          lDemandStream.setCabinDemandList (lCabinDemandList);
+        }
+
+        // Calculate the expected total number of events for the current
+        // demand stream
+        const stdair::NbOfRequests_T& lExpectedTotalNbOfEvents =
+          lDemandStream.getMeanNumberOfRequests();
+        ioSEVMGR_ServicePtr->addStatus (stdair::EventType::BKG_REQ,
+                                        lExpectedTotalNbOfEvents);
+      }
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  /**
+   * Demand loaded so far, and whether it has been matched by one of the
+   * demands to be loaded instead.
+   */
+  struct LoadedDemandRef {
+    const CompiledDemandModel* _compiledDemandModel;
+    std::size_t _demandIdx;
+    bool _isMatched;
+  };
+
+  // //////////////////////////////////////////////////////////////////////
+  /**
+   * Demand to be loaded, along with the loaded demand it matches (if
+   * any), and whether both are the same.
+   */
+  struct ReloadedDemandRef {
+    const CompiledDemandModel* _compiledDemandModel;
+    std::size_t _demandIdx;
+    const LoadedDemandRef* _loadedDemand;
+    bool _isUnchanged;
+  };
+
+  // //////////////////////////////////////////////////////////////////////
+  void DemandManager::
+  reloadDemandCharacteristics (SEVMGR::SEVMGR_ServicePtr_T ioSEVMGR_ServicePtr,
+                               stdair::RandomGeneration& ioSharedGenerator,
+                               const POSProbabilityMass_T& iPOSProbMass,
+                               const CompiledDemandModelList_T& iLoadedDemandModelList,
+                               const CompiledDemandModelList_T& iNewDemandModelList,
+                               const DemandFilterStruct& iDemandFilter) {
+    // Sanity check
+    assert (ioSEVMGR_ServicePtr != NULL);
+
+    // The sample of a stratum depends on all its demand streams, and can
+    // hence not be updated demand by demand
+    if (iDemandFilter.isSampled() == true) {
+      std::ostringstream oMessage;
+      oMessage << "The demand streams are sampled ("
+               << iDemandFilter.describe() << "): the demands can not be "
+               << "reloaded";
+      STDAIR_LOG_ERROR (oMessage.str());
+      throw DemandReloadException (oMessage.str());
+    }
+
+    //
+    stdair::BaseGenerator_T& lSharedGenerator =
+      ioSharedGenerator.getBaseGenerator();
+
+    /**
+     * 1. Index the demands loaded so far, on their origin, destination,
+     *    preferred cabin, date range and active days of the week.
+     */
+    typedef std::multimap<std::string, std::size_t> LoadedDemandIndex_T;
+    std::vector<LoadedDemandRef> lLoadedDemandList;
+    LoadedDemandIndex_T lLoadedDemandIndex;
+    for (CompiledDemandModelList_T::const_iterator itModel =
+           iLoadedDemandModelList.begin();
+         itModel != iLoadedDemandModelList.end(); ++itModel) {
+      const CompiledDemandModel& lCompiledDemandModel = **itModel;
+      const std::size_t lNbOfDemands = lCompiledDemandModel.getNbOfDemands();
+      for (std::size_t idx = 0; idx != lNbOfDemands; ++idx) {
+        lLoadedDemandIndex.
+          insert (LoadedDemandIndex_T::value_type (lCompiledDemandModel.
+                                                   describeDemandKey (idx),
+                                                   lLoadedDemandList.size()));
+        const LoadedDemandRef lDemandRef = { &lCompiledDemandModel, idx,
+                                             false };
+        lLoadedDemandList.push_back (lDemandRef);
+      }
+    }
+
+    /**
+     * 2. Match every demand to be loaded with a loaded demand having
+     *    the same key, if any, and check that no demand stream would
+     *    be given by several demands. Nothing is altered so far, so
+     *    that the loaded demands are kept as they are when the new
+     *    demands are rejected.
+     */
+    std::vector<ReloadedDemandRef> lReloadedDemandList;
+    std::set<stdair::DemandStreamKeyStr_T> lDemandStreamKeySet;
+    std::vector<DemandStreamKey> lDemandStreamKeyList;
+    for (CompiledDemandModelList_T::const_iterator itModel =
+           iNewDemandModelList.begin();
+         itModel != iNewDemandModelList.end(); ++itModel) {
+      const CompiledDemandModel& lCompiledDemandModel = **itModel;
+      const std::size_t lNbOfDemands = lCompiledDemandModel.getNbOfDemands();
+      for (std::size_t idx = 0; idx != lNbOfDemands; ++idx) {
+        ReloadedDemandRef lDemandRef = { &lCompiledDemandModel, idx, NULL,
+                                         false };
+
+        const std::pair<LoadedDemandIndex_T::const_iterator,
+                        LoadedDemandIndex_T::const_iterator> lRange =
+          lLoadedDemandIndex.equal_range (lCompiledDemandModel.
+                                          describeDemandKey (idx));
+        for (LoadedDemandIndex_T::const_iterator itLoadedDemand = lRange.first;
+             itLoadedDemand != lRange.second; ++itLoadedDemand) {
+          LoadedDemandRef& lLoadedDemand =
+            lLoadedDemandList[itLoadedDemand->second];
+          if (lLoadedDemand._isMatched == false) {
+            lLoadedDemand._isMatched = true;
+            lDemandRef._loadedDemand = &lLoadedDemand;
+            lDemandRef._isUnchanged = lLoadedDemand._compiledDemandModel->
+              isSameDemand (lLoadedDemand._demandIdx, lCompiledDemandModel,
+                            idx);
+            break;
+          }
+        }
+        lReloadedDemandList.push_back (lDemandRef);
+
+        getDemandStreamKeyList (lCompiledDemandModel, idx, iDemandFilter,
+                                lDemandStreamKeyList);
+        for (std::vector<DemandStreamKey>::const_iterator itKey =
+               lDemandStreamKeyList.begin();
+             itKey != lDemandStreamKeyList.end(); ++itKey) {
+          const stdair::DemandStreamKeyStr_T lKeyStr = itKey->toString();
+          const bool hasBeenInserted =
+            lDemandStreamKeySet.insert (lKeyStr).second;
+          if (hasBeenInserted == false) {
+            std::ostringstream oMessage;
+            oMessage << "The demand stream '" << lKeyStr
+                     << "' is given by several demands: the demands can "
+                     << "not be reloaded";
+            STDAIR_LOG_ERROR (oMessage.str());
+            throw DemandReloadException (oMessage.str());
+          }
+        }
+      }
+    }
+
+    /**
+     * 3. Update (in place) the demand streams of the changed demands,
+     *    and create the ones of the new demands, in the order of the
+     *    demands (and of their active dates), as
+     *    createDemandCharacteristics() does.
+     */
+    stdair::NbOfRequests_T lExpectedNbOfEventsDelta = 0.0;
+    stdair::Count_T lNbOfUnchangedDemands = 0;
+    stdair::Count_T lNbOfChangedDemands = 0;
+    stdair::Count_T lNbOfAddedDemands = 0;
+    DemandStruct lDemand;
+    for (std::vector<ReloadedDemandRef>::const_iterator itDemand =
+           lReloadedDemandList.begin();
+         itDemand != lReloadedDemandList.end(); ++itDemand) {
+      const ReloadedDemandRef& lDemandRef = *itDemand;
+      if (lDemandRef._isUnchanged == true) {
+        ++lNbOfUnchangedDemands;
+        continue;
+      }
+      if (lDemandRef._loadedDemand != NULL) {
+        ++lNbOfChangedDemands;
+      } else {
+        ++lNbOfAddedDemands;
+      }
+
+      const CompiledDemandModel& lCompiledDemandModel =
+        *lDemandRef._compiledDemandModel;
+      lCompiledDemandModel.fillDemand (lDemandRef._demandIdx, lDemand);
+      const DemandDistribution lDemandDistribution (lDemand._demandMean,
+                                                    lDemand._demandStdDev);
+
+      getDemandStreamKeyList (lCompiledDemandModel, lDemandRef._demandIdx,
+                              iDemandFilter, lDemandStreamKeyList);
+      for (std::vector<DemandStreamKey>::const_iterator itKey =
+             lDemandStreamKeyList.begin();
+           itKey != lDemandStreamKeyList.end(); ++itKey) {
+        const stdair::DemandStreamKeyStr_T lKeyStr = itKey->toString();
+        const bool hasDemandStream = ioSEVMGR_ServicePtr->
+          hasEventGenerator<DemandStream,stdair::DemandStreamKeyStr_T>(lKeyStr);
+
+        if (hasDemandStream == false) {
+          // Seed, drawn from the shared generator as it stands now (and
+          // not at its position when the demands were first loaded)
+          const stdair::RandomSeed_T& lRequestDateTimeSeed =
+            generateSeed (ioSharedGenerator);
+          const stdair::RandomSeed_T& lDemandCharacteristicsSeed =
+            generateSeed (ioSharedGenerator);
+
+          // Delegate the call to the dedicated command
+          DemandStream& lDemandStream =
+            createDemandStream (ioSEVMGR_ServicePtr, *itKey,
+                                lDemand._dtdProbDist, lDemand._posProbDist,
+                                lDemand._channelProbDist,
+                                lDemand._tripProbDist,
+                                lDemand._stayProbDist, lDemand._ffProbDist,
+                                lDemand._changeFeeProb,
+                                lDemand._changeFeeDisutility,
+                                lDemand._nonRefundableProb,
+                                lDemand._nonRefundableDisutility,
+                                lDemand._prefDepTimeProbDist,
+                                lDemand._minWTP,
+                                lDemand._timeValueProbDist,
+                                lDemandDistribution, lSharedGenerator,
+                                lRequestDateTimeSeed,
+                                lDemandCharacteristicsSeed,
+                                iPOSProbMass);
+          lDemandStream.setFiltered (iDemandFilter.selectsAll() == false);
+          lExpectedNbOfEventsDelta += lDemandStream.getMeanNumberOfRequests();
+          continue;
+        }
+
+        // The demand stream already exists (the demand has changed, or
+        // a removed demand used to give it): it keeps its random
+        // generators
+        DemandStream& lDemandStream = ioSEVMGR_ServicePtr->
+          getEventGenerator<DemandStream,stdair::DemandStreamKeyStr_T>(lKeyStr);
+        lExpectedNbOfEventsDelta -= lDemandStream.getMeanNumberOfRequests();
+        lDemandStream.setDemandCharacteristics (lDemand._dtdProbDist,
+                                                lDemand._posProbDist,
+                                                lDemand._channelProbDist,
+                                                lDemand._tripProbDist,
+                                                lDemand._stayProbDist,
+                                                lDemand._ffProbDist,
+                                                lDemand._changeFeeProb,
+                                                lDemand._changeFeeDisutility,
+                                                lDemand._nonRefundableProb,
+                                                lDemand._nonRefundableDisutility,
+                                                lDemand._prefDepTimeProbDist,
+                                                lDemand._minWTP,
+                                                lDemand._timeValueProbDist);
+        lDemandStream.setDemandDistribution (lDemandDistribution);
+        lExpectedNbOfEventsDelta += lDemandStream.getMeanNumberOfRequests();
+      }
+    }
+
+    /**
+     * 4. Switch off the demand streams of the removed demands (unless
+     *    given by a demand to be loaded), as the DemandStream objects
+     *    can not be removed from the BOM tree. With a zero mean number
+     *    of requests, they generate no request, neither with the order
+     *    statistics (zero total) nor with the Poisson process (see
+     *    DemandStream::stillHavingRequestsToBeGenerated()).
+     */
+    stdair::Count_T lNbOfRemovedDemands = 0;
+    const DemandDistribution lNoDemandDistribution (0.0, 0.0);
+    for (std::vector<LoadedDemandRef>::const_iterator itDemand =
+           lLoadedDemandList.begin();
+         itDemand != lLoadedDemandList.end(); ++itDemand) {
+      const LoadedDemandRef& lDemandRef = *itDemand;
+      if (lDemandRef._isMatched == true) {
+        continue;
+      }
+      ++lNbOfRemovedDemands;
+
+      getDemandStreamKeyList (*lDemandRef._compiledDemandModel,
+                              lDemandRef._demandIdx, iDemandFilter,
+                              lDemandStreamKeyList);
+      for (std::vector<DemandStreamKey>::const_iterator itKey =
+             lDemandStreamKeyList.begin();
+           itKey != lDemandStreamKeyList.end(); ++itKey) {
+        const stdair::DemandStreamKeyStr_T lKeyStr = itKey->toString();
+        if (lDemandStreamKeySet.find (lKeyStr) != lDemandStreamKeySet.end()) {
+          continue;
+        }
+
+        // The demand stream may have been left out by another filter
+        const bool hasDemandStream = ioSEVMGR_ServicePtr->
+          hasEventGenerator<DemandStream,stdair::DemandStreamKeyStr_T>(lKeyStr);
+        if (hasDemandStream == false) {
+          continue;
+        }
+
+        DemandStream& lDemandStream = ioSEVMGR_ServicePtr->
+          getEventGenerator<DemandStream,stdair::DemandStreamKeyStr_T>(lKeyStr);
+        lExpectedNbOfEventsDelta -= lDemandStream.getMeanNumberOfRequests();
+        lDemandStream.setDemandDistribution (lNoDemandDistribution);
+      }
+    }
+
+    /**
+     * 5. Adjust the expected total number of booking requests.
+     */
+    if (lExpectedNbOfEventsDelta != 0.0) {
+      ioSEVMGR_ServicePtr->addStatus (stdair::EventType::BKG_REQ,
+                                      lExpectedNbOfEventsDelta);
+    }
+
+    // DEBUG
+    STDAIR_LOG_DEBUG ("Reloaded demands: " << lNbOfUnchangedDemands
+                      << " unchanged, " << lNbOfChangedDemands << " changed, "
+                      << lNbOfAddedDemands << " added and "
+                      << lNbOfRemovedDemands << " removed. Expected number "
+                      << "of booking requests adjusted by "
+                      << lExpectedNbOfEventsDelta);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  stdair::Count_T DemandManager::
+  adjustDemandDistributions (SEVMGR::SEVMGR_ServicePtr_T ioSEVMGR_ServicePtr,
+                             const DemandAdjustmentStruct& iAdjustment) {
+    // Sanity check
+    assert (ioSEVMGR_ServicePtr != NULL);
+
+    stdair::Count_T oNbOfAdjustedDemandStreams = 0;
+    stdair::NbOfRequests_T lExpectedNbOfEventsDelta = 0.0;
+
+    // Retrieve the DemandStream list
+    const DemandStreamList_T& lDemandStreamList =
+      ioSEVMGR_ServicePtr->getEventGeneratorList<DemandStream>();
+    for (DemandStreamList_T::const_iterator itDemandStream =
+           lDemandStreamList.begin();
+         itDemandStream != lDemandStreamList.end(); ++itDemandStream) {
+      DemandStream* lDemandStream_ptr = *itDemandStream;
+      assert (lDemandStream_ptr != NULL);
+
+      if (iAdjustment.matches (lDemandStream_ptr->getKey()) == false) {
+        continue;
+      }
+      ++oNbOfAdjustedDemandStreams;
+
+      const DemandDistribution& lDemandDistribution =
+        lDemandStream_ptr->getDemandDistribution();
+      const DemandDistribution lAdjustedDemandDistribution =
+        iAdjustment.adjust (lDemandDistribution);
+      lExpectedNbOfEventsDelta +=
+        lAdjustedDemandDistribution._meanNumberOfRequests
+        - lDemandDistribution._meanNumberOfRequests;
+      lDemandStream_ptr->setDemandDistribution (lAdjustedDemandDistribution);
+    }
+
+    // Adjust the expected total number of booking requests
+    if (lExpectedNbOfEventsDelta != 0.0) {
+      ioSEVMGR_ServicePtr->addStatus (stdair::EventType::BKG_REQ,
+                                      lExpectedNbOfEventsDelta);
+    }
+
+    // DEBUG
+    STDAIR_LOG_DEBUG ("Demand adjustment (" << iAdjustment.describe()
+                      << "): " << oNbOfAdjustedDemandStreams
+                      << " demand stream(s) adjusted. Expected number of "
+                      << "booking requests adjusted by "
+                      << lExpectedNbOfEventsDelta);
+
+    return oNbOfAdjustedDemandStreams;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  stdair::Count_T DemandManager::
+  generateRun (SEVMGR::SEVMGR_ServicePtr_T ioSEVMGR_ServicePtr,
+               stdair::RandomGeneration& ioGenerator,
+               const stdair::DemandGenerationMethod& iDemandGenerationMethod,
+               RequestSink* ioRequestSink_ptr) {
+    // Sanity check
+    assert (ioSEVMGR_ServicePtr != NULL);
+
+    stdair::Count_T oNbOfRequests = 0;
+
+    // Generate the first event for each demand stream
+    generateFirstRequests (ioSEVMGR_ServicePtr, ioGenerator,
+                           iDemandGenerationMethod);
+
+    while (ioSEVMGR_ServicePtr->isQueueDone() == false) {
+      // Extract the next event from the event queue
+      stdair::EventStruct lEventStruct;
+      stdair::ProgressStatusSet lProgressStatusSet =
+        popEvent (ioSEVMGR_ServicePtr, lEventStruct);
+
+      // Hand over the corresponding booking request to the sink
+      const stdair::BookingRequestStruct& lPoppedRequest =
+        lEventStruct.getBookingRequest();
+      if (ioRequestSink_ptr != NULL) {
+        ioRequestSink_ptr->write (lPoppedRequest);
+      }
+      ++oNbOfRequests;
+
+      // Generate the next event for the same demand stream, if needed
+      const stdair::DemandGeneratorKey_T& lDemandStreamKey =
+        lPoppedRequest.getDemandGeneratorKey();
+      const bool stillHavingRequestsToBeGenerated =
+        DemandManager::
+        stillHavingRequestsToBeGenerated (ioSEVMGR_ServicePtr,
+                                          lDemandStreamKey,
+                                          lProgressStatusSet,
+                                          iDemandGenerationMethod);
+      if (stillHavingRequestsToBeGenerated == true) {
+        generateNextRequest (ioSEVMGR_ServicePtr, ioGenerator,
+                             lDemandStreamKey, iDemandGenerationMethod);
+      }
+    }
+
+    // Reset the demand streams (and the event queue) for the next run
+    reset (ioSEVMGR_ServicePtr, ioGenerator.getBaseGenerator());
+
+    return oNbOfRequests;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  /**
+   * Aggregate the given booking requests of a single demand stream, in
+   * the order of their date-times, into weighted booking requests: the
+   * booking requests lying within the same period before the preferred
+   * departure date (the periods being counted from the midnight of
+   * that latter), and sharing the same preferred cabin (several
+   * cabins may share the demand stream), POS, channel, trip type, stay
+   * duration, frequent flyer type, change fees and non refundable
+   * option, are merged into a single booking request.
+   *
+   * The party size of the merged booking request is the total party
+   * size of the booking requests it stands for, its WTP and value of
+   * time are their means, and its date-time and preferred departure
+   * time are those of the first of them. The merged booking requests
+   * are still in the order of their date-times.
+   */
+  static void
+  aggregateRequests (const stdair::Duration_T& iAggregationPeriod,
+                     std::vector<stdair::BookingRequestPtr_T>& ioRequestList) {
+    if (ioRequestList.empty() == true) {
+      return;
+    }
+
+    /**
+     * Booking requests merged so far, along with the sums of their WTP
+     * and value of time, weighted by their party sizes.
+     */
+    struct AggregatedRequest {
+      stdair::BookingRequestPtr_T _firstRequest;
+      stdair::NbOfSeats_T _partySize;
+      stdair::WTP_T _sumOfWTP;
+      stdair::PriceValue_T _sumOfValueOfTime;
+    };
+    std::vector<AggregatedRequest> lAggregatedRequestList;
+
+    /**
+     * Attributes which the booking requests of a period must share to be
+     * merged.
+     */
+    struct AggregationKey {
+      stdair::CabinCode_T _prefCabin;
+      stdair::CityCode_T _pos;
+      stdair::ChannelLabel_T _channel;
+      stdair::TripType_T _tripType;
+      stdair::DayDuration_T _stayDuration;
+      stdair::FrequentFlyer_T _frequentFlyerType;
+      stdair::ChangeFees_T _changeFees;
+      stdair::NonRefundable_T _nonRefundable;
+
+      bool operator< (const AggregationKey& iKey) const {
+        return std::tie (_prefCabin, _pos, _channel, _tripType,
+                         _stayDuration, _frequentFlyerType, _changeFees,
+                         _nonRefundable)
+          < std::tie (iKey._prefCabin, iKey._pos, iKey._channel,
+                      iKey._tripType, iKey._stayDuration,
+                      iKey._frequentFlyerType, iKey._changeFees,
+                      iKey._nonRefundable);
+      }
+    };
+
+    // The aggregated requests of the current period, by attributes
+    typedef std::map<AggregationKey, std::size_t> AggregatedRequestIndex_T;
+    AggregatedRequestIndex_T lAggregatedRequestIndex;
+
+    const stdair::DateTime_T lDepartureDateTime
+      (ioRequestList.front()->getPreferedDepartureDate());
+    const long lAggregationPeriodInSeconds =
+      iAggregationPeriod.total_seconds();
+    long lCurrentPeriodIdx = -1;
+    for (std::vector<stdair::BookingRequestPtr_T>::const_iterator itRequest =
+           ioRequestList.begin(); itRequest != ioRequestList.end();
+         ++itRequest) {
+      const stdair::BookingRequestPtr_T& lRequest_ptr = *itRequest;
+      assert (lRequest_ptr != NULL);
+      const stdair::BookingRequestStruct& lRequest = *lRequest_ptr;
+
+      // A period ends when the following one starts
+      const long lPeriodIdx =
+        (lDepartureDateTime - lRequest.getRequestDateTime()).total_seconds()
+        / lAggregationPeriodInSeconds;
+      if (lPeriodIdx != lCurrentPeriodIdx) {
+        lCurrentPeriodIdx = lPeriodIdx;
+        lAggregatedRequestIndex.clear();
+      }
+
+      const AggregationKey lAggregationKey = {
+        lRequest.getPreferredCabin(), lRequest.getPOS(),
+        lRequest.getBookingChannel(),
+        lRequest.getTripType(), lRequest.getStayDuration(),
+        lRequest.getFrequentFlyerType(), lRequest.getChangeFees(),
+        lRequest.getNonRefundable() };
+      const std::pair<AggregatedRequestIndex_T::iterator, bool> lInsertion =
+        lAggregatedRequestIndex.
+        insert (AggregatedRequestIndex_T::value_type (lAggregationKey,
+                                                      lAggregatedRequestList.
+                                                      size()));
+      if (lInsertion.second == true) {
+        const AggregatedRequest lAggregatedRequest = { lRequest_ptr, 0, 0.0,
+                                                       0.0 };
+        lAggregatedRequestList.push_back (lAggregatedRequest);
+      }
+
+      AggregatedRequest& lAggregatedRequest =
+        lAggregatedRequestList[lInsertion.first->second];
+      const stdair::NbOfSeats_T& lPartySize = lRequest.getPartySize();
+      lAggregatedRequest._partySize += lPartySize;
+      lAggregatedRequest._sumOfWTP += lPartySize * lRequest.getWTP();
+      lAggregatedRequest._sumOfValueOfTime +=
+        lPartySize * lRequest.getValueOfTime();
+    }
+
+    // Replace the booking requests by the merged ones
+    ioRequestList.clear();
+    for (std::vector<AggregatedRequest>::const_iterator itAggregatedRequest =
+           lAggregatedRequestList.begin();
+         itAggregatedRequest != lAggregatedRequestList.end();
+         ++itAggregatedRequest) {
+      const AggregatedRequest& lAggregatedRequest = *itAggregatedRequest;
+      const stdair::BookingRequestStruct& lRequest =
+        *lAggregatedRequest._firstRequest;
+      if (lAggregatedRequest._partySize == lRequest.getPartySize()) {
+        ioRequestList.push_back (lAggregatedRequest._firstRequest);
+        continue;
+      }
+
+      const stdair::WTP_T lWTP =
+        lAggregatedRequest._sumOfWTP / lAggregatedRequest._partySize;
+      const stdair::PriceValue_T lValueOfTime =
+        lAggregatedRequest._sumOfValueOfTime / lAggregatedRequest._partySize;
+      ioRequestList.
+        push_back (boost::make_shared<stdair::BookingRequestStruct>
+                   (lRequest.getDemandGeneratorKey(), lRequest.getOrigin(),
+                    lRequest.getDestination(), lRequest.getPOS(),
+                    lRequest.getPreferedDepartureDate(),
+                    lRequest.getRequestDateTime(),
+                    lRequest.getPreferredCabin(),
+                    lAggregatedRequest._partySize,
+                    lRequest.getBookingChannel(), lRequest.getTripType(),
+                    lRequest.getStayDuration(),
+                    lRequest.getFrequentFlyerType(),
+                    lRequest.getPreferredDepartureTime(), lWTP,
+                    lValueOfTime, lRequest.getChangeFees(),
+                    lRequest.getChangeFeeDisutility(),
+                    lRequest.getNonRefundable(),
+                    lRequest.getNonRefundableDisutility()));
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  stdair::Count_T DemandManager::
+  generateRunByStream (SEVMGR::SEVMGR_ServicePtr_T ioSEVMGR_ServicePtr,
+                       stdair::RandomGeneration& ioGenerator,
+                       const stdair::DemandGenerationMethod& iDemandGenerationMethod,
+                       const unsigned int iNbOfThreads,
+                       const stdair::Duration_T& iAggregationPeriod,
+                       RequestSink& ioRequestSink) {
+    // Sanity check
+    assert (ioSEVMGR_ServicePtr != NULL);
+
+    stdair::Count_T oNbOfRequests = 0;
+
+    // Retrieve the DemandStream list, so that the demand streams can be
+    // accessed by index
+    const DemandStreamList_T& lDemandStreamList =
+      ioSEVMGR_ServicePtr->getEventGeneratorList<DemandStream>();
+    const std::vector<DemandStream*> lDemandStreamArray (lDemandStreamList.begin(),
+                                                         lDemandStreamList.end());
+    const std::size_t lNbOfDemandStreams = lDemandStreamArray.size();
+
+    // Whether the booking requests are aggregated
+    const bool isAggregated =
+      (iAggregationPeriod > stdair::Duration_T (0, 0, 0));
+
+    // Booking requests of every demand stream of the current window
+    std::vector<std::vector<stdair::BookingRequestPtr_T> >
+      lRequestLists (std::min (lNbOfDemandStreams,
+                               NB_OF_DEMAND_STREAMS_PER_GENERATION_WINDOW));
+
+    for (std::size_t lFirstDemandStreamIdx = 0;
+         lFirstDemandStreamIdx < lNbOfDemandStreams;
+         lFirstDemandStreamIdx += NB_OF_DEMAND_STREAMS_PER_GENERATION_WINDOW) {
+      const std::size_t lNbOfTasks =
+        std::min (lNbOfDemandStreams - lFirstDemandStreamIdx,
+                  NB_OF_DEMAND_STREAMS_PER_GENERATION_WINDOW);
+
+      // Generate the demand streams of the window concurrently. Out of
+      // the shard of the current process, nothing is generated
+      auto lGenerateDemandStream = [&] (const std::size_t iTaskIdx) {
+        DemandStream* lDemandStream_ptr =
+          lDemandStreamArray[lFirstDemandStreamIdx + iTaskIdx];
+        assert (lDemandStream_ptr != NULL);
+        lDemandStream_ptr->generateAllRequests (iDemandGenerationMethod,
+                                                lRequestLists[iTaskIdx]);
+        if (isAggregated == true) {
+          aggregateRequests (iAggregationPeriod, lRequestLists[iTaskIdx]);
+        }
+      };
+      runParallelTasks (lNbOfTasks, iNbOfThreads, lGenerateDemandStream);
+
+      // Hand over the booking requests to the sink, demand stream by
+      // demand stream
+      for (std::size_t idx = 0; idx != lNbOfTasks; ++idx) {
+        std::vector<stdair::BookingRequestPtr_T>& lRequestList =
+          lRequestLists[idx];
+        for (std::vector<stdair::BookingRequestPtr_T>::const_iterator
+               itRequest = lRequestList.begin();
+             itRequest != lRequestList.end(); ++itRequest) {
+          ioRequestSink.write (**itRequest);
+        }
+        oNbOfRequests += lRequestList.size();
+        lRequestList.clear();
+      }
+    }
+    ioRequestSink.flush();
+
+    // Reset the demand streams (and the event queue) for the next run
+    reset (ioSEVMGR_ServicePtr, ioGenerator.getBaseGenerator());
+
+    return oNbOfRequests;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  stdair::Count_T DemandManager::
+  generateArrivalCounts (SEVMGR::SEVMGR_ServicePtr_T ioSEVMGR_ServicePtr,
+                         stdair::RandomGeneration& ioGenerator,
+                         const stdair::DemandGenerationMethod& iDemandGenerationMethod,
+                         const unsigned int iNbOfThreads,
+                         ArrivalCountTable& ioArrivalCountTable) {
+    // Sanity check
+    assert (ioSEVMGR_ServicePtr != NULL);
+
+    // Retrieve the DemandStream list, so that the demand streams can be
+    // accessed by index
+    const DemandStreamList_T& lDemandStreamList =
+      ioSEVMGR_ServicePtr->getEventGeneratorList<DemandStream>();
+    const std::vector<DemandStream*> lDemandStreamArray (lDemandStreamList.begin(),
+                                                         lDemandStreamList.end());
+
+    // Gather the keys, and the channels, of the demand streams
+    std::vector<std::string> lDemandStreamKeyList;
+    lDemandStreamKeyList.reserve (lDemandStreamArray.size());
+    std::set<stdair::ChannelLabel_T> lChannelSet;
+    for (std::vector<DemandStream*>::const_iterator itDemandStream =
+           lDemandStreamArray.begin();
+         itDemandStream != lDemandStreamArray.end(); ++itDemandStream) {
+      const DemandStream* lDemandStream_ptr = *itDemandStream;
+      assert (lDemandStream_ptr != NULL);
+      lDemandStreamKeyList.push_back (lDemandStream_ptr->getKey().toString());
+      if (ioArrivalCountTable.isByChannel() == false) {
+        continue;
+      }
+
+      std::vector<const DemandCharacteristics*> lDemandCharacteristicsList;
+      lDemandCharacteristicsList.
+        push_back (&lDemandStream_ptr->getDemandCharacteristics());
+      const DemandStream::CabinDemandList_T& lCabinDemandList =
+        lDemandStream_ptr->getCabinDemandList();
+      for (DemandStream::CabinDemandList_T::const_iterator itCabinDemand =
+             lCabinDemandList.begin();
+           itCabinDemand != lCabinDemandList.end(); ++itCabinDemand) {
+        lDemandCharacteristicsList.
+          push_back (&itCabinDemand->_demandCharacteristics);
+      }
+      for (std::vector<const DemandCharacteristics*>::const_iterator
+             itDemandCharacteristics = lDemandCharacteristicsList.begin();
+           itDemandCharacteristics != lDemandCharacteristicsList.end();
+           ++itDemandCharacteristics) {
+        const std::vector<stdair::ChannelLabel_T>& lChannelList =
+          (*itDemandCharacteristics)->_channelProbabilityMass.getValueList();
+        lChannelSet.insert (lChannelList.begin(), lChannelList.end());
+      }
+    }
+    ioArrivalCountTable.
+      init (lDemandStreamKeyList,
+            std::vector<stdair::ChannelLabel_T> (lChannelSet.begin(),
+                                                 lChannelSet.end()));
+
+    // Draw the counts of the demand streams concurrently, every demand
+    // stream filling its own part of the table
+    const std::vector<stdair::FloatDuration_T> lBucketBoundaryList =
+      ioArrivalCountTable.getBucketBoundaryList();
+    const std::vector<stdair::ChannelLabel_T>& lChannelList =
+      ioArrivalCountTable.getChannelList();
+    auto lDrawDemandStream = [&] (const std::size_t iTaskIdx) {
+      DemandStream* lDemandStream_ptr = lDemandStreamArray[iTaskIdx];
+      assert (lDemandStream_ptr != NULL);
+      std::vector<stdair::Count_T> lCountList;
+      lDemandStream_ptr->generateArrivalCounts (iDemandGenerationMethod,
+                                                lBucketBoundaryList,
+                                                lChannelList, lCountList);
+      ioArrivalCountTable.setCounts (iTaskIdx, lCountList);
+    };
+    runParallelTasks (lDemandStreamArray.size(), iNbOfThreads,
+                      lDrawDemandStream);
+
+    // Reset the demand streams (and the event queue) for the next run
+    reset (ioSEVMGR_ServicePtr, ioGenerator.getBaseGenerator());
+
+    return ioArrivalCountTable.getTotalCount();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  stdair::Count_T DemandManager::
+  generateUntil (SEVMGR::SEVMGR_ServicePtr_T ioSEVMGR_ServicePtr,
+                 stdair::RandomGeneration& ioGenerator,
+                 const POSProbabilityMass_T& iPOSProbMass,
+                 const stdair::DemandGenerationMethod& iDemandGenerationMethod,
+                 const stdair::DateTime_T& iDateTime,
+                 DemandStreamSchedule& ioDemandStreamSchedule,
+                 RequestSink& ioRequestSink) {
+    // Sanity check
+    assert (ioSEVMGR_ServicePtr != NULL);
+
+    stdair::Count_T oNbOfRequests = 0;
+    if (ioSEVMGR_ServicePtr->isQueueDone() == true) {
+      return oNbOfRequests;
+    }
+
+    // Stand for the end of the time window within the event queue
+    const stdair::BreakPointPtr_T lBreakPoint_ptr =
+      boost::make_shared<stdair::BreakPointStruct> (iDateTime);
+    stdair::EventStruct lBreakPointEventStruct (stdair::EventType::BRK_PT,
+                                                lBreakPoint_ptr);
+    ioSEVMGR_ServicePtr->addEvent (lBreakPointEventStruct);
+    ioSEVMGR_ServicePtr->addStatus (stdair::EventType::BRK_PT, 1.0);
+
+    const bool isRollingHorizon = (ioDemandStreamSchedule.isEmpty() == false);
+    while (ioSEVMGR_ServicePtr->isQueueDone() == false) {
+      // Extract the next event from the event queue
+      stdair::EventStruct lEventStruct;
+      stdair::ProgressStatusSet lProgressStatusSet =
+        (isRollingHorizon == true)
+        ? popEvent (ioSEVMGR_ServicePtr, ioGenerator, iPOSProbMass,
+                    ioDemandStreamSchedule, lEventStruct)
+        : popEvent (ioSEVMGR_ServicePtr, lEventStruct);
+
+      // The end of the time window has been reached
+      const stdair::EventType::EN_EventType& lEventType =
+        lEventStruct.getEventType();
+      if (lEventType == stdair::EventType::BRK_PT
+          && &lEventStruct.getBreakPoint() == lBreakPoint_ptr.get()) {
+        break;
+      }
+      if (lEventType != stdair::EventType::BKG_REQ) {
+        continue;
+      }
+
+      // Hand over the corresponding booking request to the sink
+      const stdair::BookingRequestStruct& lPoppedRequest =
+        lEventStruct.getBookingRequest();
+      ioRequestSink.write (lPoppedRequest);
+      ++oNbOfRequests;
+
+      // Generate the next event for the same demand stream, if needed
+      const stdair::DemandGeneratorKey_T& lDemandStreamKey =
+        lPoppedRequest.getDemandGeneratorKey();
+      const bool stillHavingRequestsToBeGenerated =
+        DemandManager::
+        stillHavingRequestsToBeGenerated (ioSEVMGR_ServicePtr,
+                                          lDemandStreamKey,
+                                          lProgressStatusSet,
+                                          iDemandGenerationMethod);
+      if (stillHavingRequestsToBeGenerated == true) {
+        generateNextRequest (ioSEVMGR_ServicePtr, ioGenerator,
+                             lDemandStreamKey, iDemandGenerationMethod);
+      }
+    }
+    ioRequestSink.flush();
+
+    // DEBUG
+    STDAIR_LOG_DEBUG (oNbOfRequests << " booking request(s) generated until "
+                      << iDateTime);
+
+    return oNbOfRequests;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void DemandManager::
+  seedDemandStreams (SEVMGR::SEVMGR_ServicePtr_T ioSEVMGR_ServicePtr,
+                     stdair::RandomGeneration& ioSharedGenerator,
+                     const stdair::RandomSeed_T& iRandomSeed) {
+    // Sanity check
+    assert (ioSEVMGR_ServicePtr != NULL);
+
+    ioSharedGenerator.init (iRandomSeed);
+    const DemandStreamList_T& lDemandStreamList =
+      ioSEVMGR_ServicePtr->getEventGeneratorList<DemandStream>();
+    for (DemandStreamList_T::const_iterator itDemandStream =
+           lDemandStreamList.begin();
+         itDemandStream != lDemandStreamList.end(); ++itDemandStream) {
+      DemandStream* lDemandStream_ptr = *itDemandStream;
+      assert (lDemandStream_ptr != NULL);
+
+      lDemandStream_ptr->
+        setRequestDateTimeRandomGeneratorSeed (generateSeed (ioSharedGenerator));
+      lDemandStream_ptr->
+        setDemandCharacteristicsRandomGeneratorSeed (generateSeed (ioSharedGenerator));
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  stdair::Count_T DemandManager::
+  shardDemandStreams (SEVMGR::SEVMGR_ServicePtr_T ioSEVMGR_ServicePtr,
+                      const unsigned short iShardIndex,
+                      const unsigned short iNbOfShards) {
+    // Sanity check
+    assert (ioSEVMGR_ServicePtr != NULL);
+    assert (iNbOfShards == 0 || iShardIndex < iNbOfShards);
+
+    const bool isSharded = (iNbOfShards != 0);
+    stdair::Count_T oNbOfDemandStreams = 0;
+    const DemandStreamList_T& lDemandStreamList =
+      ioSEVMGR_ServicePtr->getEventGeneratorList<DemandStream>();
+    for (DemandStreamList_T::const_iterator itDemandStream =
+           lDemandStreamList.begin();
+         itDemandStream != lDemandStreamList.end(); ++itDemandStream) {
+      DemandStream* lDemandStream_ptr = *itDemandStream;
+      assert (lDemandStream_ptr != NULL);
+
+      const bool isInShard = (isSharded == false
+                              || RequestShard::
+                              getShardIndex (lDemandStream_ptr->getKey().toString(),
+                                             iNbOfShards) == iShardIndex);
+      lDemandStream_ptr->setShard (isSharded, isInShard);
+      if (isInShard == true) {
+        ++oNbOfDemandStreams;
+      }
+    }
+
+    // DEBUG
+    STDAIR_LOG_DEBUG ("Shard #" << iShardIndex << " out of " << iNbOfShards
+                      << ": " << oNbOfDemandStreams << " demand stream(s) out "
+                      << "of " << lDemandStreamList.size());
+
+    return oNbOfDemandStreams;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void DemandManager::
+  projectDemandStreams (SEVMGR::SEVMGR_ServicePtr_T ioSEVMGR_ServicePtr,
+                        const bool iIsProjected,
+                        const RequestFieldMask& iRequestFieldMask) {
+    // Sanity check
+    assert (ioSEVMGR_ServicePtr != NULL);
+
+    const DemandStreamList_T& lDemandStreamList =
+      ioSEVMGR_ServicePtr->getEventGeneratorList<DemandStream>();
+    for (DemandStreamList_T::const_iterator itDemandStream =
+           lDemandStreamList.begin();
+         itDemandStream != lDemandStreamList.end(); ++itDemandStream) {
+      DemandStream* lDemandStream_ptr = *itDemandStream;
+      assert (lDemandStream_ptr != NULL);
+
+      lDemandStream_ptr->setRequestFieldMask (iIsProjected, iRequestFieldMask);
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  stdair::Count_T DemandManager::
+  generateScenarios (SEVMGR::SEVMGR_ServicePtr_T ioSEVMGR_ServicePtr,
+                     stdair::RandomGeneration& ioSharedGenerator,
+                     const DemandScenarioList_T& iScenarioList,
+                     const unsigned int iNbOfRuns,
+                     const stdair::DemandGenerationMethod& iDemandGenerationMethod) {
+    // Sanity check
+    assert (ioSEVMGR_ServicePtr != NULL);
+
+    // Retrieve the DemandStream list, and keep the demand distributions
+    // of the demand input file, on top of which the adjustments of
+    // every scenario are applied
+    const DemandStreamList_T& lDemandStreamList =
+      ioSEVMGR_ServicePtr->getEventGeneratorList<DemandStream>();
+    std::vector<DemandDistribution> lDemandDistributionList;
+    lDemandDistributionList.reserve (lDemandStreamList.size());
+    for (DemandStreamList_T::const_iterator itDemandStream =
+           lDemandStreamList.begin();
+         itDemandStream != lDemandStreamList.end(); ++itDemandStream) {
+      const DemandStream* lDemandStream_ptr = *itDemandStream;
+      assert (lDemandStream_ptr != NULL);
+      lDemandDistributionList.
+        push_back (lDemandStream_ptr->getDemandDistribution());
+    }
+
+    stdair::Count_T oNbOfRequests = 0;
+    for (DemandScenarioList_T::const_iterator itScenario =
+           iScenarioList.begin();
+         itScenario != iScenarioList.end(); ++itScenario) {
+      const DemandScenarioStruct& lScenario = *itScenario;
+
+      /**
+       * 1. Adjust the demand distributions, and seed the random
+       *    generators, in the order of the demand streams.
+       */
+      stdair::NbOfRequests_T lExpectedNbOfEventsDelta = 0.0;
+      std::vector<DemandDistribution>::const_iterator itDemandDistribution =
+        lDemandDistributionList.begin();
+      for (DemandStreamList_T::const_iterator itDemandStream =
+             lDemandStreamList.begin();
+           itDemandStream != lDemandStreamList.end();
+           ++itDemandStream, ++itDemandDistribution) {
+        DemandStream* lDemandStream_ptr = *itDemandStream;
+        assert (lDemandStream_ptr != NULL);
+
+        DemandDistribution lDemandDistribution (*itDemandDistribution);
+        for (DemandAdjustmentList_T::const_iterator itAdjustment =
+               lScenario._adjustmentList.begin();
+             itAdjustment != lScenario._adjustmentList.end(); ++itAdjustment) {
+          if (itAdjustment->matches (lDemandStream_ptr->getKey()) == true) {
+            lDemandDistribution = itAdjustment->adjust (lDemandDistribution);
+          }
+        }
+        lExpectedNbOfEventsDelta += lDemandDistribution._meanNumberOfRequests
+          - lDemandStream_ptr->getMeanNumberOfRequests();
+        lDemandStream_ptr->setDemandDistribution (lDemandDistribution);
+      }
+      if (lExpectedNbOfEventsDelta != 0.0) {
+        ioSEVMGR_ServicePtr->addStatus (stdair::EventType::BKG_REQ,
+                                        lExpectedNbOfEventsDelta);
+      }
+      seedDemandStreams (ioSEVMGR_ServicePtr, ioSharedGenerator,
+                         lScenario._randomSeed);
+
+      /**
+       * 2. Draw the total numbers of requests, and generate the runs.
+       */
+      reset (ioSEVMGR_ServicePtr, ioSharedGenerator.getBaseGenerator());
+      stdair::Count_T lNbOfScenarioRequests = 0;
+      for (unsigned int lRunNumber = 1; lRunNumber <= iNbOfRuns;
+           ++lRunNumber) {
+        if (lScenario._requestSink != NULL) {
+          lScenario._requestSink->setRunNumber (lRunNumber);
+        }
+        lNbOfScenarioRequests +=
+          generateRun (ioSEVMGR_ServicePtr, ioSharedGenerator,
+                       iDemandGenerationMethod, lScenario._requestSink);
+      }
+      if (lScenario._requestSink != NULL) {
+        lScenario._requestSink->flush();
+      }
+      oNbOfRequests += lNbOfScenarioRequests;
+
+      // DEBUG
+      STDAIR_LOG_DEBUG ("Scenario #" << (itScenario - iScenarioList.begin())
+                        << " (" << lScenario.describe() << "): "
+                        << lNbOfScenarioRequests << " requests generated in "
+                        << iNbOfRuns << " run(s)");
+    }
+
+    /**
+     * 3. Restore the demand distributions of the demand input file.
+     */
+    stdair::NbOfRequests_T lExpectedNbOfEventsDelta = 0.0;
+    std::vector<DemandDistribution>::const_iterator itDemandDistribution =
+      lDemandDistributionList.begin();
+    for (DemandStreamList_T::const_iterator itDemandStream =
+           lDemandStreamList.begin();
+         itDemandStream != lDemandStreamList.end();
+         ++itDemandStream, ++itDemandDistribution) {
+      DemandStream* lDemandStream_ptr = *itDemandStream;
+      assert (lDemandStream_ptr != NULL);
+      lExpectedNbOfEventsDelta += itDemandDistribution->_meanNumberOfRequests
+        - lDemandStream_ptr->getMeanNumberOfRequests();
+      lDemandStream_ptr->setDemandDistribution (*itDemandDistribution);
+    }
+    if (lExpectedNbOfEventsDelta != 0.0) {
+      ioSEVMGR_ServicePtr->addStatus (stdair::EventType::BKG_REQ,
+                                      lExpectedNbOfEventsDelta);
+    }
+
+    return oNbOfRequests;
+  }
+
   // ////////////////////////////////////////////////////////////////////
   stdair::RandomSeed_T DemandManager::
   generateSeed (stdair::RandomGeneration& ioSharedGenerator) {
@@ -313,6 +1879,17 @@ namespace TRADEMGEN {
     return oSeed;
   }
   
+  // ////////////////////////////////////////////////////////////////////
+  void DemandManager::
+  skipDemandStreamDraws (stdair::RandomGeneration& ioSharedGenerator,
+                         const DemandDistribution& iDemandDistribution) {
+    generateSeed (ioSharedGenerator);
+    generateSeed (ioSharedGenerator);
+    DemandStream::drawTotalNumberOfRequests (iDemandDistribution,
+                                             ioSharedGenerator.
+                                             getBaseGenerator());
+  }
+
   // ////////////////////////////////////////////////////////////////////
   const bool DemandManager::
   stillHavingRequestsToBeGenerated (SEVMGR::SEVMGR_ServicePtr_T ioSEVMGR_ServicePtr,
@@ -382,8 +1959,14 @@ namespace TRADEMGEN {
       */
       ioSEVMGR_ServicePtr->addEvent (lEventStruct);
 
+      // Remember the booking request lying in the event queue, for the
+      // checkpoints (see saveCheckpoint())
+      lDemandStream.setPendingRequest (lBookingRequest);
+
     } else {
 
+      lDemandStream.setPendingRequest (stdair::BookingRequestPtr_T());
+
       // Update the expected number of eventss for the given event type (i.e.,
       // booking request)
       stdair::Count_T lCurrentBRNumber = 
@@ -396,6 +1979,26 @@ namespace TRADEMGEN {
     return lBookingRequest;
   }
 
+  // ////////////////////////////////////////////////////////////////////
+  stdair::RealNumber_T DemandManager::
+  getSamplingWeight (SEVMGR::SEVMGR_ServicePtr_T ioSEVMGR_ServicePtr,
+                     const stdair::BookingRequestStruct& iRequest) {
+    // Sanity check
+    assert (ioSEVMGR_ServicePtr != NULL);
+
+    const stdair::DemandStreamKeyStr_T& lKeyStr =
+      iRequest.getDemandGeneratorKey();
+    const bool hasDemandStream = ioSEVMGR_ServicePtr->
+      hasEventGenerator<DemandStream,stdair::DemandStreamKeyStr_T>(lKeyStr);
+    if (hasDemandStream == false) {
+      return 1.0;
+    }
+
+    const DemandStream& lDemandStream = ioSEVMGR_ServicePtr->
+      getEventGenerator<DemandStream,stdair::DemandStreamKeyStr_T>(lKeyStr);
+    return lDemandStream.getSamplingWeight();
+  }
+
   // ////////////////////////////////////////////////////////////////////
   stdair::Count_T DemandManager::
   generateFirstRequests (SEVMGR::SEVMGR_ServicePtr_T ioSEVMGR_ServicePtr,
@@ -419,6 +2022,11 @@ namespace TRADEMGEN {
 
       lDemandStream_ptr->setBoolFirstDateTimeRequest(true);
 
+      // Out of the shard of the current process, nothing is generated
+      if (lDemandStream_ptr->isInShard() == false) {
+        continue;
+      }
+
       // Calculate the expected total number of events for the current
       // demand stream
       const stdair::NbOfRequests_T& lActualNbOfEvents =
@@ -483,7 +2091,625 @@ namespace TRADEMGEN {
      */
     ioSEVMGR_ServicePtr->reset();
   }
-  
+
+  // ////////////////////////////////////////////////////////////////////
+  void DemandManager::
+  reset (SEVMGR::SEVMGR_ServicePtr_T ioSEVMGR_ServicePtr,
+         stdair::BaseGenerator_T& ioShareGenerator,
+         TotalNumberOfRequestsTable& ioTotalNumberOfRequestsTable) {
+    // Sanity check
+    assert (ioSEVMGR_ServicePtr != NULL);
+
+    const DemandStreamList_T& lDemandStreamList =
+      ioSEVMGR_ServicePtr->getEventGeneratorList<DemandStream>();
+
+    // Check that the table may be used for the current demand streams
+    if (ioTotalNumberOfRequestsTable.isEmpty() == true
+        || ioTotalNumberOfRequestsTable.getNbOfDemandStreams()
+        != lDemandStreamList.size()) {
+      ioTotalNumberOfRequestsTable.clear();
+      reset (ioSEVMGR_ServicePtr, ioShareGenerator);
+      return;
+    }
+
+    // Reset all the DemandStream objects, with the drawn totals
+    const stdair::Count_T* lTotal_ptr =
+      ioTotalNumberOfRequestsTable.consumeNextRun();
+    for (DemandStreamList_T::const_iterator itDS = lDemandStreamList.begin();
+         itDS != lDemandStreamList.end(); ++itDS, ++lTotal_ptr) {
+      DemandStream* lCurrentDS_ptr = *itDS;
+      assert (lCurrentDS_ptr != NULL);
+
+      lCurrentDS_ptr->reset (static_cast<stdair::NbOfRequests_T> (*lTotal_ptr));
+    }
+
+    // Reset the EventQueue object (after the DemandStream objects)
+    ioSEVMGR_ServicePtr->reset();
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void DemandManager::
+  drawTotalNumberOfRequests (SEVMGR::SEVMGR_ServicePtr_T ioSEVMGR_ServicePtr,
+                             stdair::BaseGenerator_T& ioShareGenerator,
+                             const unsigned int iNbOfRuns,
+                             TotalNumberOfRequestsTable& ioTotalNumberOfRequestsTable) {
+    // Sanity check
+    assert (ioSEVMGR_ServicePtr != NULL);
+
+    // Gather the demand distributions, in the order of the demand streams
+    const DemandStreamList_T& lDemandStreamList =
+      ioSEVMGR_ServicePtr->getEventGeneratorList<DemandStream>();
+    std::vector<stdair::RealNumber_T> lMeanList;
+    std::vector<stdair::RealNumber_T> lStdDevList;
+    lMeanList.reserve (lDemandStreamList.size());
+    lStdDevList.reserve (lDemandStreamList.size());
+    for (DemandStreamList_T::const_iterator itDS = lDemandStreamList.begin();
+         itDS != lDemandStreamList.end(); ++itDS) {
+      const DemandStream* lCurrentDS_ptr = *itDS;
+      assert (lCurrentDS_ptr != NULL);
+
+      const DemandDistribution& lDemandDistribution =
+        lCurrentDS_ptr->getDemandDistribution();
+      lMeanList.push_back (lDemandDistribution._meanNumberOfRequests);
+      lStdDevList.push_back (lDemandDistribution._stdDevNumberOfRequests);
+    }
+
+    ioTotalNumberOfRequestsTable.draw (lMeanList, lStdDevList, iNbOfRuns,
+                                       ioShareGenerator);
+
+    // DEBUG
+    STDAIR_LOG_DEBUG ("Total numbers of requests drawn in advance: "
+                      << ioTotalNumberOfRequestsTable.describe());
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void DemandManager::
+  takeSnapshot (SEVMGR::SEVMGR_ServicePtr_T ioSEVMGR_ServicePtr,
+                const stdair::BaseGenerator_T& iShareGenerator,
+                DemandStreamSnapshot& ioDemandStreamSnapshot) {
+    // Sanity check
+    assert (ioSEVMGR_ServicePtr != NULL);
+
+    const DemandStreamList_T& lDemandStreamList =
+      ioSEVMGR_ServicePtr->getEventGeneratorList<DemandStream>();
+    const stdair::Count_T lActualNbOfEvents = ioSEVMGR_ServicePtr->
+      getActualTotalNumberOfEventsToBeGenerated (stdair::EventType::BKG_REQ);
+    ioDemandStreamSnapshot.take (lDemandStreamList, iShareGenerator,
+                                 lActualNbOfEvents, true);
+
+    // DEBUG
+    STDAIR_LOG_DEBUG (ioDemandStreamSnapshot.describe() << " taken");
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  stdair::Count_T DemandManager::
+  restoreSnapshot (SEVMGR::SEVMGR_ServicePtr_T ioSEVMGR_ServicePtr,
+                   stdair::BaseGenerator_T& ioShareGenerator,
+                   DemandStreamSnapshot& ioDemandStreamSnapshot) {
+    // Sanity check
+    assert (ioSEVMGR_ServicePtr != NULL);
+
+    // Check that the snapshot corresponds to the current demand streams
+    const DemandStreamList_T& lDemandStreamList =
+      ioSEVMGR_ServicePtr->getEventGeneratorList<DemandStream>();
+    if (ioDemandStreamSnapshot.isEmpty() == true) {
+      throw DemandSnapshotException ("No snapshot of the demand streams "
+                                     "has been taken");
+    }
+    if (ioDemandStreamSnapshot.getNbOfDemandStreams()
+        != lDemandStreamList.size()) {
+      std::ostringstream oStr;
+      oStr << "The snapshot holds " << ioDemandStreamSnapshot.
+        getNbOfDemandStreams() << " demand stream(s), whereas there are "
+           << lDemandStreamList.size() << " of them now";
+      throw DemandSnapshotException (oStr.str());
+    }
+
+    // Restore the demand streams which have been used since the snapshot
+    const stdair::Count_T oNbOfRestoredDemandStreams =
+      ioDemandStreamSnapshot.restore (ioShareGenerator, true);
+
+    // Reset the EventQueue object (after the DemandStream objects)
+    restoreEventQueue (ioSEVMGR_ServicePtr, ioDemandStreamSnapshot);
+
+    // DEBUG
+    STDAIR_LOG_DEBUG (oNbOfRestoredDemandStreams << " demand stream(s) "
+                      << "restored out of " << lDemandStreamList.size());
+
+    return oNbOfRestoredDemandStreams;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void DemandManager::
+  restoreEventQueue (SEVMGR::SEVMGR_ServicePtr_T ioSEVMGR_ServicePtr,
+                     const DemandStreamSnapshot& iDemandStreamSnapshot) {
+    // Sanity check
+    assert (ioSEVMGR_ServicePtr != NULL);
+
+    ioSEVMGR_ServicePtr->reset();
+
+    // Put back the booking requests which were lying in the event queue
+    const std::size_t lNbOfDemandStreams =
+      iDemandStreamSnapshot.getNbOfDemandStreams();
+    stdair::Count_T lNbOfPendingRequests = 0;
+    for (std::size_t idx = 0; idx != lNbOfDemandStreams; ++idx) {
+      const stdair::BookingRequestPtr_T& lBookingRequest_ptr =
+        iDemandStreamSnapshot.getPendingRequest (idx);
+      if (lBookingRequest_ptr != NULL) {
+        stdair::EventStruct lEventStruct (stdair::EventType::BKG_REQ,
+                                          lBookingRequest_ptr);
+        ioSEVMGR_ServicePtr->addEvent (lEventStruct);
+        ++lNbOfPendingRequests;
+      }
+    }
+
+    // The expected number of booking requests is only known once the
+    // first requests have been generated
+    if (lNbOfPendingRequests != 0) {
+      ioSEVMGR_ServicePtr->
+        updateStatus (stdair::EventType::BKG_REQ,
+                      iDemandStreamSnapshot.getActualNbOfEvents());
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  stdair::ProgressStatusSet DemandManager::
+  popEvent (SEVMGR::SEVMGR_ServicePtr_T ioSEVMGR_ServicePtr,
+            stdair::EventStruct& ioEventStruct) {
+    // Sanity check
+    assert (ioSEVMGR_ServicePtr != NULL);
+
+    const stdair::ProgressStatusSet oProgressStatusSet =
+      ioSEVMGR_ServicePtr->popEvent (ioEventStruct);
+
+    // The booking request does not lie in the event queue anymore
+    if (ioEventStruct.getEventType() == stdair::EventType::BKG_REQ) {
+      const stdair::DemandGeneratorKey_T& lDemandStreamKey =
+        ioEventStruct.getBookingRequest().getDemandGeneratorKey();
+      const bool hasDemandStream = ioSEVMGR_ServicePtr->
+        hasEventGenerator<DemandStream,
+                          stdair::DemandStreamKeyStr_T> (lDemandStreamKey);
+      if (hasDemandStream == true) {
+        DemandStream& lDemandStream = ioSEVMGR_ServicePtr->
+          getEventGenerator<DemandStream,
+                            stdair::DemandStreamKeyStr_T> (lDemandStreamKey);
+        lDemandStream.setPendingRequest (stdair::BookingRequestPtr_T());
+      }
+    }
+
+    return oProgressStatusSet;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void DemandManager::
+  saveCheckpoint (SEVMGR::SEVMGR_ServicePtr_T ioSEVMGR_ServicePtr,
+                  const stdair::BaseGenerator_T& iShareGenerator,
+                  const stdair::Filename_T& iFilename) {
+    // Sanity check
+    assert (ioSEVMGR_ServicePtr != NULL);
+
+    // The snapshot is not the reference one: the dirty flags of the
+    // demand streams are left untouched
+    const DemandStreamList_T& lDemandStreamList =
+      ioSEVMGR_ServicePtr->getEventGeneratorList<DemandStream>();
+    const stdair::Count_T lActualNbOfEvents = ioSEVMGR_ServicePtr->
+      getActualTotalNumberOfEventsToBeGenerated (stdair::EventType::BKG_REQ);
+    DemandStreamSnapshot lDemandStreamSnapshot;
+    lDemandStreamSnapshot.take (lDemandStreamList, iShareGenerator,
+                                lActualNbOfEvents, false);
+    lDemandStreamSnapshot.save (iFilename);
+
+    // DEBUG
+    STDAIR_LOG_DEBUG (lDemandStreamSnapshot.describe() << " saved into '"
+                      << iFilename << "'");
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void DemandManager::
+  restoreCheckpoint (SEVMGR::SEVMGR_ServicePtr_T ioSEVMGR_ServicePtr,
+                     stdair::BaseGenerator_T& ioShareGenerator,
+                     const stdair::Filename_T& iFilename) {
+    // Sanity check
+    assert (ioSEVMGR_ServicePtr != NULL);
+
+    // Nothing is altered, should the checkpoint not be valid
+    const DemandStreamList_T& lDemandStreamList =
+      ioSEVMGR_ServicePtr->getEventGeneratorList<DemandStream>();
+    DemandStreamSnapshot lDemandStreamSnapshot;
+    lDemandStreamSnapshot.load (iFilename, lDemandStreamList);
+
+    // All the demand streams are restored, whatever their state
+    lDemandStreamSnapshot.restore (ioShareGenerator, false);
+    restoreEventQueue (ioSEVMGR_ServicePtr, lDemandStreamSnapshot);
+
+    // DEBUG
+    STDAIR_LOG_DEBUG (lDemandStreamSnapshot.describe() << " restored from '"
+                      << iFilename << "'");
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void DemandManager::
+  scheduleDemandCharacteristics (SEVMGR::SEVMGR_ServicePtr_T ioSEVMGR_ServicePtr,
+                                 stdair::RandomGeneration& ioSharedGenerator,
+                                 const CompiledDemandModelList_T& iCompiledDemandModelList,
+                                 const DemandFilterStruct& iDemandFilter,
+                                 DemandStreamSchedule& ioDemandStreamSchedule) {
+    // Sanity check
+    assert (ioSEVMGR_ServicePtr != NULL);
+
+    //
+    stdair::BaseGenerator_T& lSharedGenerator =
+      ioSharedGenerator.getBaseGenerator();
+
+    // The selected demand streams may moreover be sampled
+    DemandStreamSample_T lDemandStreamSample;
+    if (iDemandFilter.isSampled() == true) {
+      sampleDemandStreams (iCompiledDemandModelList, iDemandFilter,
+                           lDemandStreamSample);
+    }
+
+    // Walk through the demands and their active dates, in the same order
+    // as createDemandCharacteristics() does, so as to make the same draws
+    // with the shared generator (be the demand streams selected, or
+    // sampled, or not)
+    stdair::NbOfRequests_T lExpectedTotalNbOfEvents = 0.0;
+    DemandStruct lDemandStruct;
+    for (CompiledDemandModelList_T::const_iterator itModel =
+           iCompiledDemandModelList.begin();
+         itModel != iCompiledDemandModelList.end(); ++itModel) {
+      const CompiledDemandModelPtr_T& lCompiledDemandModel_ptr = *itModel;
+      assert (lCompiledDemandModel_ptr != NULL);
+      const CompiledDemandModel& lCompiledDemandModel =
+        *lCompiledDemandModel_ptr;
+      const std::size_t lNbOfDemands = lCompiledDemandModel.getNbOfDemands();
+      for (std::size_t idx = 0; idx != lNbOfDemands; ++idx) {
+        const CompiledDemandModel::Demand& lDemand =
+          lCompiledDemandModel.getDemand (idx);
+        const DemandDistribution lDemandDistribution (lDemand._demandMean,
+                                                      lDemand._demandStdDev);
+        const bool isMarketSelected = iDemandFilter.
+          matchesMarket (lCompiledDemandModel.getString (lDemand._originIdx),
+                         lCompiledDemandModel.getString (lDemand._destinationIdx),
+                         lCompiledDemandModel.getString (lDemand._prefCabinIdx));
+
+        // The earliest booking request comes at the lower bound of the
+        // arrival pattern (a negative number of days), counted from the
+        // midnight of the preferred departure date, so as to be on the
+        // safe side
+        lCompiledDemandModel.fillDemand (idx, lDemandStruct);
+        const stdair::FloatDuration_T lEarliestDTD =
+          (lDemandStruct._dtdProbDist.empty() == true) ? 0.0
+          : lDemandStruct._dtdProbDist.begin()->first;
+        const stdair::Duration_T lOpeningOffset =
+          boost::posix_time::seconds (static_cast<long>
+                                      (std::floor (lEarliestDTD * stdair::
+                                                   SECONDS_IN_ONE_DAY)));
+
+        const stdair::DatePeriod_T lDateRange =
+          lCompiledDemandModel.getDateRange (idx);
+        for (boost::gregorian::day_iterator itDate = lDateRange.begin();
+             itDate != lDateRange.end(); ++itDate) {
+          const stdair::Date_T& currentDate = *itDate;
+
+          // The bits of the mask follow the Boost numbering of the
+          // Days-Of-the-Week
+          const unsigned short currentDoW =
+            currentDate.day_of_week().as_number();
+          if ((lDemand._dowMask & (1U << currentDoW)) == 0) {
+            continue;
+          }
+
+          // The demand stream is not selected: it is not scheduled
+          if (isMarketSelected == false
+              || iDemandFilter.matchesDate (currentDate) == false) {
+            skipDemandStreamDraws (ioSharedGenerator, lDemandDistribution);
+            continue;
+          }
+          const DemandStreamKey lDemandStreamKey (lDemandStruct._origin,
+                                                  lDemandStruct._destination,
+                                                  currentDate,
+                                                  lDemandStruct._prefCabin);
+          const stdair::RealNumber_T lSamplingWeight =
+            findSamplingWeight (iDemandFilter, lDemandStreamSample,
+                                lDemandStreamKey);
+          if (lSamplingWeight == 0.0) {
+            skipDemandStreamDraws (ioSharedGenerator, lDemandDistribution);
+            continue;
+          }
+
+          DemandStreamSchedule::ScheduledDemandStream lScheduledDemandStream;
+          lScheduledDemandStream._openingDateTime =
+            stdair::DateTime_T (currentDate) + lOpeningOffset;
+          lScheduledDemandStream._compiledDemandModel = &lCompiledDemandModel;
+          lScheduledDemandStream._demandIdx = idx;
+          lScheduledDemandStream._preferredDepartureDate = currentDate;
+          lScheduledDemandStream._requestDateTimeSeed =
+            generateSeed (ioSharedGenerator);
+          lScheduledDemandStream._demandCharacteristicsSeed =
+            generateSeed (ioSharedGenerator);
+          lScheduledDemandStream._totalNumberOfRequests =
+            DemandStream::drawTotalNumberOfRequests (lDemandDistribution,
+                                                     lSharedGenerator);
+          lScheduledDemandStream._samplingWeight = lSamplingWeight;
+          lScheduledDemandStream._isFiltered =
+            (iDemandFilter.selectsAll() == false);
+          ioDemandStreamSchedule.add (lScheduledDemandStream,
+                                      lCompiledDemandModel_ptr);
+
+          lExpectedTotalNbOfEvents += lDemandDistribution._meanNumberOfRequests;
+        }
+      }
+    }
+    ioDemandStreamSchedule.sort();
+
+    // Initialise the progress status, specific to the booking request type
+    ioSEVMGR_ServicePtr->addStatus (stdair::EventType::BKG_REQ,
+                                    lExpectedTotalNbOfEvents);
+
+    // DEBUG
+    STDAIR_LOG_DEBUG ("Demand streams scheduled: "
+                      << ioDemandStreamSchedule.describe());
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  /**
+   * Retire the given demand stream, whatever its state.
+   */
+  static bool retireDemandStream (DemandStream* ioDemandStream_ptr) {
+    assert (ioDemandStream_ptr != NULL);
+    ioDemandStream_ptr->retire();
+    return true;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  /**
+   * Retire the given demand stream, when it has no booking request lying
+   * in the event queue. As the next booking request of a demand stream
+   * is only generated when the previous one is popped, such a demand
+   * stream will not give any more.
+   */
+  static bool retireExhaustedDemandStream (DemandStream* ioDemandStream_ptr) {
+    assert (ioDemandStream_ptr != NULL);
+    if (ioDemandStream_ptr->getPendingRequest() != NULL) {
+      return false;
+    }
+    return retireDemandStream (ioDemandStream_ptr);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  /**
+   * Add a break point into the event queue, at the opening date-time of
+   * the next demand stream of the given schedule (if any).
+   */
+  static void addBreakPoint (SEVMGR::SEVMGR_ServicePtr_T ioSEVMGR_ServicePtr,
+                             DemandStreamSchedule& ioDemandStreamSchedule) {
+    if (ioDemandStreamSchedule.hasNextDemandStream() == false) {
+      ioDemandStreamSchedule.setBreakPoint (stdair::BreakPointPtr_T());
+      return;
+    }
+
+    const stdair::BreakPointPtr_T lBreakPoint_ptr =
+      boost::make_shared<stdair::BreakPointStruct> (ioDemandStreamSchedule.
+                                                    getNextOpeningDateTime());
+    stdair::EventStruct lEventStruct (stdair::EventType::BRK_PT,
+                                      lBreakPoint_ptr);
+    ioSEVMGR_ServicePtr->addEvent (lEventStruct);
+    ioSEVMGR_ServicePtr->addStatus (stdair::EventType::BRK_PT, 1.0);
+    ioDemandStreamSchedule.setBreakPoint (lBreakPoint_ptr);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  stdair::Count_T DemandManager::
+  startRollingHorizon (SEVMGR::SEVMGR_ServicePtr_T ioSEVMGR_ServicePtr,
+                       const stdair::DemandGenerationMethod& iDemandGenerationMethod,
+                       DemandStreamSchedule& ioDemandStreamSchedule) {
+    // Sanity check
+    assert (ioSEVMGR_ServicePtr != NULL);
+
+    // Retire the demand streams left open by a former run, if any
+    ioDemandStreamSchedule.removeOpenDemandStreams (retireDemandStream);
+    ioDemandStreamSchedule.rewind (iDemandGenerationMethod);
+
+    // The total numbers of requests are known beforehand
+    stdair::NbOfRequests_T lActualTotalNbOfEvents = 0.0;
+    const DemandStreamSchedule::ScheduledDemandStreamList_T& lScheduledList =
+      ioDemandStreamSchedule.getScheduledDemandStreamList();
+    for (DemandStreamSchedule::ScheduledDemandStreamList_T::const_iterator
+           itScheduled = lScheduledList.begin();
+         itScheduled != lScheduledList.end(); ++itScheduled) {
+      lActualTotalNbOfEvents += itScheduled->_totalNumberOfRequests;
+    }
+    ioSEVMGR_ServicePtr->updateStatus (stdair::EventType::BKG_REQ,
+                                       lActualTotalNbOfEvents);
+
+    // The demand streams are opened when the break point is popped
+    addBreakPoint (ioSEVMGR_ServicePtr, ioDemandStreamSchedule);
+
+    return std::floor (lActualTotalNbOfEvents);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  stdair::Count_T DemandManager::
+  advanceRollingHorizon (SEVMGR::SEVMGR_ServicePtr_T ioSEVMGR_ServicePtr,
+                         stdair::RandomGeneration& ioSharedGenerator,
+                         const POSProbabilityMass_T& iPOSProbMass,
+                         const stdair::DateTime_T& iDateTime,
+                         DemandStreamSchedule& ioDemandStreamSchedule) {
+    // Sanity check
+    assert (ioSEVMGR_ServicePtr != NULL);
+
+    const stdair::DemandGenerationMethod lDemandGenerationMethod =
+      ioDemandStreamSchedule.getDemandGenerationMethod();
+
+    /**
+     * 1. Retire the demand streams which will not give any booking
+     *    request anymore.
+     */
+    const stdair::Count_T lNbOfRetiredDemandStreams =
+      ioDemandStreamSchedule.removeOpenDemandStreams (retireExhaustedDemandStream);
+
+    /**
+     * 2. Open the demand streams up to the given date-time. Should no
+     *    demand stream be left open, the next demand streams are opened
+     *    as well, as no booking request may come in-between (and so
+     *    that the break point is not left alone in the event queue).
+     */
+    stdair::Count_T oNbOfOpenedDemandStreams = 0;
+    DemandCharacteristics lDemandCharacteristics;
+    const CompiledDemandModel* lFilledModel_ptr = NULL;
+    std::size_t lFilledDemandIdx = 0;
+    while (ioDemandStreamSchedule.hasNextDemandStream() == true
+           && (ioDemandStreamSchedule.getNextOpeningDateTime() <= iDateTime
+               || ioDemandStreamSchedule.getOpenDemandStreamList().empty()
+               == true)) {
+      const DemandStreamSchedule::ScheduledDemandStream& lScheduled =
+        ioDemandStreamSchedule.popNextDemandStream();
+      assert (lScheduled._compiledDemandModel != NULL);
+
+      // The demand streams of a same demand often open together
+      const CompiledDemandModel& lCompiledDemandModel =
+        *lScheduled._compiledDemandModel;
+      if (lScheduled._compiledDemandModel != lFilledModel_ptr
+          || lScheduled._demandIdx != lFilledDemandIdx) {
+        lCompiledDemandModel.fillDemandCharacteristics (lScheduled._demandIdx,
+                                                        lDemandCharacteristics);
+        lFilledModel_ptr = lScheduled._compiledDemandModel;
+        lFilledDemandIdx = lScheduled._demandIdx;
+      }
+      const CompiledDemandModel::Demand& lDemand =
+        lCompiledDemandModel.getDemand (lScheduled._demandIdx);
+      const DemandDistribution lDemandDistribution (lDemand._demandMean,
+                                                    lDemand._demandStdDev);
+      const DemandStreamKey
+        lDemandStreamKey (lCompiledDemandModel.getString (lDemand._originIdx),
+                          lCompiledDemandModel.getString (lDemand._destinationIdx),
+                          lScheduled._preferredDepartureDate,
+                          lCompiledDemandModel.getString (lDemand._prefCabinIdx));
+      const stdair::DemandStreamKeyStr_T lKeyStr = lDemandStreamKey.toString();
+
+      const bool hasDemandStream = ioSEVMGR_ServicePtr->
+        hasEventGenerator<DemandStream,stdair::DemandStreamKeyStr_T>(lKeyStr);
+      DemandStream* lDemandStream_ptr = NULL;
+      if (hasDemandStream == false) {
+        DemandStream& lDemandStream =
+          stdair::FacBom<DemandStream>::instance().create (lDemandStreamKey);
+        lDemandStream.setAll (lDemandCharacteristics, lDemandDistribution,
+                              lScheduled._totalNumberOfRequests,
+                              lScheduled._requestDateTimeSeed,
+                              lScheduled._demandCharacteristicsSeed,
+                              iPOSProbMass);
+        lDemandStream.setFiltered (lScheduled._isFiltered);
+        lDemandStream.setSamplingWeight (lScheduled._samplingWeight);
+        ioSEVMGR_ServicePtr->addEventGenerator (lDemandStream);
+        lDemandStream_ptr = &lDemandStream;
+
+      } else {
+        // The demand stream has been opened by a former run: it keeps
+        // its random generators
+        DemandStream& lDemandStream = ioSEVMGR_ServicePtr->
+          getEventGenerator<DemandStream,stdair::DemandStreamKeyStr_T>(lKeyStr);
+        lDemandStream.setDemandCharacteristics (lDemandCharacteristics);
+        lDemandStream.setDemandDistribution (lDemandDistribution);
+        lDemandStream.reset (lScheduled._totalNumberOfRequests);
+        lDemandStream_ptr = &lDemandStream;
+      }
+      assert (lDemandStream_ptr != NULL);
+      ++oNbOfOpenedDemandStreams;
+
+      // Generate the first booking request, and insert it into the
+      // event queue. A demand stream giving no booking request at all
+      // is retired straight away.
+      const bool stillHavingRequestsToBeGenerated =
+        lDemandStream_ptr->stillHavingRequestsToBeGenerated (lDemandGenerationMethod);
+      if (stillHavingRequestsToBeGenerated == true) {
+        generateNextRequest (ioSEVMGR_ServicePtr, ioSharedGenerator, lKeyStr,
+                             lDemandGenerationMethod);
+        ioDemandStreamSchedule.addOpenDemandStream (*lDemandStream_ptr);
+      } else {
+        lDemandStream_ptr->retire();
+      }
+    }
+
+    /**
+     * 3. Stand for the next opening date-time within the event queue.
+     */
+    addBreakPoint (ioSEVMGR_ServicePtr, ioDemandStreamSchedule);
+
+    // DEBUG
+    STDAIR_LOG_DEBUG ("Rolling horizon at " << iDateTime << ": "
+                      << oNbOfOpenedDemandStreams << " demand stream(s) "
+                      << "opened and " << lNbOfRetiredDemandStreams
+                      << " retired; " << ioDemandStreamSchedule.describe());
+
+    return oNbOfOpenedDemandStreams;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  stdair::ProgressStatusSet DemandManager::
+  popEvent (SEVMGR::SEVMGR_ServicePtr_T ioSEVMGR_ServicePtr,
+            stdair::RandomGeneration& ioSharedGenerator,
+            const POSProbabilityMass_T& iPOSProbMass,
+            DemandStreamSchedule& ioDemandStreamSchedule,
+            stdair::EventStruct& ioEventStruct) {
+    // Sanity check
+    assert (ioSEVMGR_ServicePtr != NULL);
+
+    stdair::ProgressStatusSet oProgressStatusSet =
+      popEvent (ioSEVMGR_ServicePtr, ioEventStruct);
+
+    // Move the rolling horizon forward, whenever its break point is
+    // reached (the other break points, if any, are handed over)
+    while (ioEventStruct.getEventType() == stdair::EventType::BRK_PT
+           && ioDemandStreamSchedule.getBreakPoint() != NULL
+           && &ioEventStruct.getBreakPoint()
+           == ioDemandStreamSchedule.getBreakPoint().get()) {
+      const stdair::DateTime_T lDateTime =
+        ioDemandStreamSchedule.getNextOpeningDateTime();
+      advanceRollingHorizon (ioSEVMGR_ServicePtr, ioSharedGenerator,
+                             iPOSProbMass, lDateTime, ioDemandStreamSchedule);
+
+      if (ioSEVMGR_ServicePtr->isQueueDone() == true) {
+        break;
+      }
+      oProgressStatusSet = popEvent (ioSEVMGR_ServicePtr, ioEventStruct);
+    }
+
+    return oProgressStatusSet;
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void DemandManager::
+  resetRollingHorizon (SEVMGR::SEVMGR_ServicePtr_T ioSEVMGR_ServicePtr,
+                       stdair::BaseGenerator_T& ioShareGenerator,
+                       DemandStreamSchedule& ioDemandStreamSchedule) {
+    // Sanity check
+    assert (ioSEVMGR_ServicePtr != NULL);
+
+    ioDemandStreamSchedule.removeOpenDemandStreams (retireDemandStream);
+    ioDemandStreamSchedule.
+      rewind (ioDemandStreamSchedule.getDemandGenerationMethod());
+
+    // Draw again the total number of requests of every demand stream
+    DemandStreamSchedule::ScheduledDemandStreamList_T& lScheduledList =
+      ioDemandStreamSchedule.getScheduledDemandStreamList();
+    for (DemandStreamSchedule::ScheduledDemandStreamList_T::iterator
+           itScheduled = lScheduledList.begin();
+         itScheduled != lScheduledList.end(); ++itScheduled) {
+      DemandStreamSchedule::ScheduledDemandStream& lScheduled = *itScheduled;
+      assert (lScheduled._compiledDemandModel != NULL);
+      const CompiledDemandModel::Demand& lDemand =
+        lScheduled._compiledDemandModel->getDemand (lScheduled._demandIdx);
+      const DemandDistribution lDemandDistribution (lDemand._demandMean,
+                                                    lDemand._demandStdDev);
+      lScheduled._totalNumberOfRequests =
+        DemandStream::drawTotalNumberOfRequests (lDemandDistribution,
+                                                 ioShareGenerator);
+    }
+
+    // Reset the EventQueue object
+    ioSEVMGR_ServicePtr->reset();
+  }
+
   // ////////////////////////////////////////////////////////////////////
   bool DemandManager::
   generateCancellation (stdair::RandomGeneration& ioGenerator,
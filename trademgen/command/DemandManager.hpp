@@ -6,6 +6,7 @@
 // //////////////////////////////////////////////////////////////////////
 // StdAir
 #include <stdair/stdair_basic_types.hpp>
+#include <stdair/stdair_date_time_types.hpp>
 #include <stdair/basic/RandomGeneration.hpp>
 #include <stdair/basic/DemandGenerationMethod.hpp>
 #include <stdair/bom/BookingRequestTypes.hpp>
@@ -15,7 +16,10 @@
 // TraDemGen
 #include <trademgen/TRADEMGEN_Types.hpp>
 #include <trademgen/basic/DemandCharacteristicsTypes.hpp>
+#include <trademgen/basic/RequestFieldMask.hpp>
+#include <trademgen/bom/DemandScenarioStruct.hpp>
 #include <trademgen/bom/DemandStreamKey.hpp>
+#include <trademgen/command/CompiledDemandModel.hpp>
 
 // Forward declarations
 namespace stdair {
@@ -27,9 +31,16 @@ namespace stdair {
 namespace TRADEMGEN {
 
   // Forward declarations
+  struct ArrivalCountTable;
+  struct DemandAdjustmentStruct;
   struct DemandDistribution;
+  struct DemandFilterStruct;
   struct DemandStruct;
   class DemandStream;
+  class RequestSink;
+  class DemandStreamSnapshot;
+  class DemandStreamSchedule;
+  struct TotalNumberOfRequestsTable;
   namespace DemandParserHelper {
     struct doEndDemand;
   }
@@ -39,6 +50,7 @@ namespace TRADEMGEN {
    */
   class DemandManager : public stdair::CmdAbstract {
     friend struct DemandParserHelper::doEndDemand;
+    friend class DemandParser;
     friend class TRADEMGEN_Service;
     
   private:
@@ -145,6 +157,354 @@ namespace TRADEMGEN {
                                              const POSProbabilityMass_T&,
                                              const DemandStruct&);
 
+    /**
+     * Generate the Demand objects corresponding to the demands of the
+     * given compiled demand models, exactly as
+     * createDemandCharacteristics() does for each of those demands in
+     * turn, but concurrently.
+     *
+     * Only the draws made with the shared random generator (i.e., the
+     * seeds and the total number of requests of the demand streams)
+     * are made beforehand, in the order of the demands. The demand
+     * streams are then set up concurrently, and eventually added to
+     * the EventQueue, again in the order of the demands.
+     *
+     * The demand streams not selected by the given filter are not
+     * created, nor are the distributions of their demands built. The
+     * shared generator still makes their draws (see
+     * skipDemandStreamDraws()), so that the selected demand streams get
+     * the same draws as without any filter. When the filter samples the
+     * demand streams, the same goes for the demand streams left out of
+     * the sample, the sampled ones being given their sampling weight.
+     *
+     * @param SEVMGR::SEVMGR_ServicePtr_T Pointer on the SEvMgr service
+     * handler.
+     * @param stdair::RandomGeneration& Boost uniform generator.
+     * @param const POSProbabilityMass_T& Default POS distribution.
+     * @param const CompiledDemandModelList_T& Compiled demand models.
+     * @param const DemandFilterStruct& Selection of the demand streams
+     *        to be created.
+     * @param const unsigned int Number of threads (zero meaning as many
+     *        as the machine can run concurrently).
+     */
+    static void
+    createDemandCharacteristics (SEVMGR::SEVMGR_ServicePtr_T,
+                                 stdair::RandomGeneration&,
+                                 const POSProbabilityMass_T&,
+                                 const CompiledDemandModelList_T&,
+                                 const DemandFilterStruct&,
+                                 const unsigned int iNbOfThreads);
+
+    /**
+     * Generate the Demand objects corresponding to the demands of the
+     * given compiled demand models, the cabins of a given origin,
+     * destination and preferred departure date sharing a single demand
+     * stream, i.e., a single arrival process, as long as they share the
+     * same arrival pattern.
+     *
+     * Such a multi-cabin demand stream (see
+     * DemandStream::setCabinDemandList()) is given, as preferred cabin,
+     * the codes of its cabins (e.g., "C/Y"), and, as demand
+     * distribution, the sum of the (independent) demand distributions
+     * of its cabins. Every cabin is drawn in proportion to its mean
+     * number of requests. A cabin not sharing its arrival pattern with
+     * any other cabin gets a demand stream of its own, as with
+     * createDemandCharacteristics().
+     *
+     * The demand streams are created in the order of the first demand
+     * of each origin, destination and preferred departure date. Hence,
+     * neither the draws made with the shared generator nor the booking
+     * requests are the same as with createDemandCharacteristics(): only
+     * their distributions are.
+     *
+     * @param SEVMGR::SEVMGR_ServicePtr_T Pointer on the SEvMgr service
+     * handler.
+     * @param stdair::RandomGeneration& Boost uniform generator.
+     * @param const POSProbabilityMass_T& Default POS distribution.
+     * @param const CompiledDemandModelList_T& Compiled demand models.
+     * @param const DemandFilterStruct& Selection of the demand streams
+     *        to be created.
+     * @throw TrademgenGenerationException when the filter samples the
+     *        demand streams.
+     */
+    static void
+    createMultiCabinDemandCharacteristics (SEVMGR::SEVMGR_ServicePtr_T,
+                                           stdair::RandomGeneration&,
+                                           const POSProbabilityMass_T&,
+                                           const CompiledDemandModelList_T&,
+                                           const DemandFilterStruct&);
+
+    /**
+     * Replace the demands loaded so far by the given ones, touching
+     * only the demand streams of the demands which have changed.
+     *
+     * The demands are matched on their origin, destination, preferred
+     * cabin, date range and active days of the week:
+     * <ul>
+     *   <li>the demand streams of the unchanged demands are left
+     *       untouched (including the state of their random
+     *       generators);</li>
+     *   <li>the demand streams of the changed demands get, in place,
+     *       the new demand characteristics and distribution, while
+     *       keeping their random generators;</li>
+     *   <li>the demand streams of the new demands are created (and
+     *       seeded with the shared generator), exactly as
+     *       createDemandCharacteristics() does;</li>
+     *   <li>the demand streams of the removed demands can not be
+     *       removed from the BOM tree: their demand distribution is set
+     *       to zero, so that they do not generate any request
+     *       anymore.</li>
+     * </ul>
+     * The expected total number of booking requests is adjusted
+     * accordingly. The actual numbers of requests to be generated are
+     * drawn again, with the new distributions, when the demand
+     * generation is reset (see reset()). Only the demand streams
+     * selected by the given filter are considered.
+     *
+     * @param SEVMGR::SEVMGR_ServicePtr_T Pointer on the SEvMgr service
+     * handler.
+     * @param stdair::RandomGeneration& Boost uniform generator.
+     * @param const POSProbabilityMass_T& Default POS distribution.
+     * @param const CompiledDemandModelList_T& Demands loaded so far.
+     * @param const CompiledDemandModelList_T& Demands to be loaded
+     *        instead.
+     * @param const DemandFilterStruct& Selection of the demand streams.
+     * @throw DemandReloadException when a demand stream would be given
+     *        by several demands, or when the demand streams are sampled.
+     */
+    static void
+    reloadDemandCharacteristics (SEVMGR::SEVMGR_ServicePtr_T,
+                                 stdair::RandomGeneration&,
+                                 const POSProbabilityMass_T&,
+                                 const CompiledDemandModelList_T& iLoadedDemandModelList,
+                                 const CompiledDemandModelList_T& iNewDemandModelList,
+                                 const DemandFilterStruct&);
+
+    /**
+     * Adjust, in place, the demand distribution of the demand streams
+     * selected by the given adjustment, and the expected total number
+     * of booking requests accordingly. The actual numbers of requests
+     * to be generated are drawn again, with the adjusted distributions,
+     * when the demand generation is reset (see reset()).
+     *
+     * @param SEVMGR::SEVMGR_ServicePtr_T Pointer on the SEvMgr service
+     * handler.
+     * @param const DemandAdjustmentStruct& Selection of the demand
+     *        streams, and adjustment of their demand distribution.
+     * @return stdair::Count_T Number of adjusted demand streams.
+     */
+    static stdair::Count_T
+    adjustDemandDistributions (SEVMGR::SEVMGR_ServicePtr_T,
+                               const DemandAdjustmentStruct&);
+
+    /**
+     * Generate all the booking requests of a single run, i.e., until
+     * the event queue is done, and hand them over to the given sink.
+     * The demand generation is then reset for the next run.
+     *
+     * @param SEVMGR::SEVMGR_ServicePtr_T Pointer on the SEvMgr service
+     * handler.
+     * @param stdair::RandomGeneration& Random generator.
+     * @param const stdair::DemandGenerationMethod& Method of generation
+     *        of the date-time of the requests.
+     * @param RequestSink* Sink receiving the requests (NULL for the
+     *        requests to be discarded).
+     * @return stdair::Count_T Number of generated booking requests.
+     */
+    static stdair::Count_T generateRun (SEVMGR::SEVMGR_ServicePtr_T,
+                                        stdair::RandomGeneration&,
+                                        const stdair::DemandGenerationMethod&,
+                                        RequestSink*);
+
+    /**
+     * Generate all the booking requests of a single run, demand stream
+     * by demand stream, without going through the event queue, and hand
+     * them over to the given sink. The booking requests of every demand
+     * stream come in a row, in the order of their date-times, and the
+     * demand streams in the order in which they have been loaded; but
+     * the booking requests are not globally ordered by date-time.
+     *
+     * The demand streams are generated concurrently, by windows of
+     * NB_OF_DEMAND_STREAMS_PER_GENERATION_WINDOW demand streams (see
+     * DemandStream::generateAllRequests()), the booking requests of a
+     * window being handed over to the sink by the calling thread. The
+     * demand generation is then reset for the next run.
+     *
+     * With a (strictly positive) aggregation period, the booking
+     * requests of every demand stream lying within the same period
+     * before the preferred departure date, and sharing the same
+     * categorical attributes, are merged into a single booking request,
+     * the party size of which is the number of passengers it stands
+     * for. The total number of passengers is hence the same as without
+     * aggregation, with far fewer booking requests for the high-demand
+     * markets.
+     *
+     * @param SEVMGR::SEVMGR_ServicePtr_T Pointer on the SEvMgr service
+     * handler.
+     * @param stdair::RandomGeneration& Random generator.
+     * @param const stdair::DemandGenerationMethod& Method of generation
+     *        of the date-time of the requests.
+     * @param const unsigned int Number of threads (zero meaning as many
+     *        as the machine can run concurrently).
+     * @param const stdair::Duration_T& Aggregation period (zero for the
+     *        booking requests not to be aggregated).
+     * @param RequestSink& Sink receiving the requests.
+     * @return stdair::Count_T Number of booking requests handed over to
+     *         the sink.
+     */
+    static stdair::Count_T
+    generateRunByStream (SEVMGR::SEVMGR_ServicePtr_T,
+                         stdair::RandomGeneration&,
+                         const stdair::DemandGenerationMethod&,
+                         const unsigned int iNbOfThreads,
+                         const stdair::Duration_T& iAggregationPeriod,
+                         RequestSink&);
+
+    /**
+     * Draw the numbers of booking requests (arrivals) of every demand
+     * stream within the DTD buckets, and optionally within the channels,
+     * of the given table, for a single run, without generating any
+     * booking request (see DemandStream::generateArrivalCounts()). When
+     * the table is split by channel, its channels are all those of the
+     * demand streams, in alphabetical order.
+     *
+     * The demand streams are drawn concurrently, and the demand
+     * generation is then reset for the next run.
+     *
+     * @param SEVMGR::SEVMGR_ServicePtr_T Pointer on the SEvMgr service
+     * handler.
+     * @param stdair::RandomGeneration& Random generator.
+     * @param const stdair::DemandGenerationMethod& Method of generation
+     *        of the date-time of the requests.
+     * @param const unsigned int Number of threads (zero meaning as many
+     *        as the machine can run concurrently).
+     * @param ArrivalCountTable& Table receiving the counts.
+     * @return stdair::Count_T Total number of arrivals.
+     */
+    static stdair::Count_T
+    generateArrivalCounts (SEVMGR::SEVMGR_ServicePtr_T,
+                           stdair::RandomGeneration&,
+                           const stdair::DemandGenerationMethod&,
+                           const unsigned int iNbOfThreads,
+                           ArrivalCountTable&);
+
+    /**
+     * Generate the booking requests dated before the given date-time,
+     * and hand them over to the given sink, in the order of their
+     * date-times. Every demand stream is left with its next booking
+     * request lying in the event queue, so that the next call goes on
+     * from there.
+     *
+     * A break point is added into the event queue at the given
+     * date-time, and the events are popped until it is reached. The
+     * other events (e.g., cancellations, or the break points of the
+     * caller) popped in-between are discarded. As the event queue
+     * orders the events at the microsecond, a booking request dated
+     * exactly at the given date-time may fall on either side.
+     *
+     * @param SEVMGR::SEVMGR_ServicePtr_T Pointer on the SEvMgr service
+     * handler.
+     * @param stdair::RandomGeneration& Random generator.
+     * @param const POSProbabilityMass_T& Default POS distribution (used
+     *        by the rolling-horizon demand generation only).
+     * @param const stdair::DemandGenerationMethod& Method of generation
+     *        of the date-time of the requests.
+     * @param const stdair::DateTime_T& End (excluded) of the time window.
+     * @param DemandStreamSchedule& Schedule of the demand streams (empty
+     *        unless the rolling-horizon demand generation is used).
+     * @param RequestSink& Sink receiving the requests.
+     * @return stdair::Count_T Number of generated booking requests.
+     */
+    static stdair::Count_T generateUntil (SEVMGR::SEVMGR_ServicePtr_T,
+                                          stdair::RandomGeneration&,
+                                          const POSProbabilityMass_T&,
+                                          const stdair::DemandGenerationMethod&,
+                                          const stdair::DateTime_T&,
+                                          DemandStreamSchedule&,
+                                          RequestSink&);
+
+    /**
+     * Generate several runs of several scenarios, with the demand
+     * streams loaded so far.
+     *
+     * For every scenario in turn:
+     * <ul>
+     *   <li>the demand distributions of the demand input file get the
+     *       adjustments of the scenario (and the expected total number
+     *       of booking requests accordingly);</li>
+     *   <li>the shared generator is seeded with the seed of the
+     *       scenario, and then seeds the random generators of every
+     *       demand stream;</li>
+     *   <li>the runs are generated (see generateRun()), the requests
+     *       being handed over to the sink of the scenario.</li>
+     * </ul>
+     * Eventually, the demand distributions of the demand input file are
+     * restored, whereas the random generators are left as they are.
+     *
+     * @param SEVMGR::SEVMGR_ServicePtr_T Pointer on the SEvMgr service
+     * handler.
+     * @param stdair::RandomGeneration& Shared random generator.
+     * @param const DemandScenarioList_T& Scenarios.
+     * @param const unsigned int Number of runs per scenario.
+     * @param const stdair::DemandGenerationMethod& Method of generation
+     *        of the date-time of the requests.
+     * @return stdair::Count_T Number of generated booking requests, for
+     *         all the runs of all the scenarios.
+     */
+    static stdair::Count_T
+    generateScenarios (SEVMGR::SEVMGR_ServicePtr_T, stdair::RandomGeneration&,
+                       const DemandScenarioList_T&,
+                       const unsigned int iNbOfRuns,
+                       const stdair::DemandGenerationMethod&);
+
+    /**
+     * Seed the shared generator with the given seed, and then, in the
+     * order of the demand streams, the random generators of every demand
+     * stream (as for every scenario of generateScenarios()).
+     *
+     * @param SEVMGR::SEVMGR_ServicePtr_T Pointer on the SEvMgr service
+     * handler.
+     * @param stdair::RandomGeneration& Shared random generator.
+     * @param const stdair::RandomSeed_T& Seed of the shared generator.
+     */
+    static void seedDemandStreams (SEVMGR::SEVMGR_ServicePtr_T,
+                                   stdair::RandomGeneration&,
+                                   const stdair::RandomSeed_T&);
+
+    /**
+     * Restrict the generation to the demand streams of the given shard
+     * (see RequestShard::getShardIndex()), the other demand streams
+     * generating no booking request. All the demand streams are still
+     * seeded, and their total numbers of requests drawn, so that the
+     * demand streams of the shard generate the same booking requests
+     * whatever the number of shards.
+     *
+     * @param SEVMGR::SEVMGR_ServicePtr_T Pointer on the SEvMgr service
+     * handler.
+     * @param const unsigned short Index of the shard (from 0).
+     * @param const unsigned short Number of shards, 0 meaning that the
+     *        generation is no longer sharded.
+     * @return stdair::Count_T Number of demand streams within the shard.
+     */
+    static stdair::Count_T
+    shardDemandStreams (SEVMGR::SEVMGR_ServicePtr_T,
+                        const unsigned short iShardIndex,
+                        const unsigned short iNbOfShards);
+
+    /**
+     * Set whether the fields of the booking requests of all the demand
+     * streams are projected, and onto which ones (see
+     * DemandStream::setRequestFieldMask()).
+     *
+     * @param SEVMGR::SEVMGR_ServicePtr_T Pointer on the SEvMgr service
+     *        handler.
+     * @param const bool Whether the fields are projected.
+     * @param const RequestFieldMask& Fields to be drawn.
+     */
+    static void projectDemandStreams (SEVMGR::SEVMGR_ServicePtr_T,
+                                      const bool iIsProjected,
+                                      const RequestFieldMask&);
+
     /**
      * Generate the random seed for the demand characteristic
      * distributions.
@@ -154,6 +514,24 @@ namespace TRADEMGEN {
      */
     static stdair::RandomSeed_T generateSeed (stdair::RandomGeneration&);
 
+    /**
+     * Make, with the shared generator, the draws a demand stream of the
+     * given demand distribution would get (i.e., its two seeds and its
+     * total number of requests), without creating it. That keeps the
+     * draws of the next demand streams as they would be, had that
+     * demand stream been created.
+     *
+     * \note The draws cannot merely be skipped, as the total number of
+     *       requests, drawn following a normal distribution, takes a
+     *       varying number of draws from the shared generator.
+     *
+     * @param stdair::RandomGeneration& Boost uniform generator.
+     * @param const DemandDistribution& Demand distribution of the
+     *        demand stream.
+     */
+    static void skipDemandStreamDraws (stdair::RandomGeneration&,
+                                       const DemandDistribution&);
+
     /**
      * Create a demand stream object and add it into the BOM tree.
      *
@@ -270,6 +648,21 @@ namespace TRADEMGEN {
                          const stdair::DemandStreamKeyStr_T&,
                          const stdair::DemandGenerationMethod&);
 
+    /**
+     * Get the sampling weight of the given booking request, i.e., that
+     * of the demand stream which has generated it (see
+     * DemandStream::getSamplingWeight()).
+     *
+     * @param SEVMGR::SEVMGR_ServicePtr_T Pointer on the SEvMgr service
+     * handler.
+     * @param const stdair::BookingRequestStruct& The booking request.
+     * @return stdair::RealNumber_T The sampling weight, one when the
+     *   demand stream is unknown.
+     */
+    static stdair::RealNumber_T
+    getSamplingWeight (SEVMGR::SEVMGR_ServicePtr_T,
+                       const stdair::BookingRequestStruct&);
+
     /**
      * Reset the context of the demand streams for another demand
      * generation without having to reparse the demand input file.
@@ -281,6 +674,230 @@ namespace TRADEMGEN {
      */
     static void reset (SEVMGR::SEVMGR_ServicePtr_T, stdair::BaseGenerator_T&);
 
+    /**
+     * Reset the context of the demand streams for another demand
+     * generation, the total numbers of requests being read from the
+     * next row of the given table rather than drawn.
+     *
+     * When the table is empty, or does not correspond to the demand
+     * streams (e.g., some have been added since it was drawn), it is
+     * emptied and the totals are drawn with the shared generator, as
+     * with the other reset() method.
+     *
+     * @param SEVMGR::SEVMGR_ServicePtr_T Pointer on the SEvMgr service
+     * handler.
+     * @param stdair::BaseGenerator_T& The shared generator for the number
+     *   of requests generation.
+     * @param TotalNumberOfRequestsTable& Total numbers of requests drawn
+     *   in advance.
+     */
+    static void reset (SEVMGR::SEVMGR_ServicePtr_T, stdair::BaseGenerator_T&,
+                       TotalNumberOfRequestsTable&);
+
+    /**
+     * Draw, in a single pass, the total numbers of requests of every
+     * demand stream for the given number of subsequent runs (i.e.,
+     * resets).
+     *
+     * @param SEVMGR::SEVMGR_ServicePtr_T Pointer on the SEvMgr service
+     * handler.
+     * @param stdair::BaseGenerator_T& The shared generator for the number
+     *   of requests generation.
+     * @param const unsigned int Number of runs.
+     * @param TotalNumberOfRequestsTable& Table to be filled.
+     */
+    static void drawTotalNumberOfRequests (SEVMGR::SEVMGR_ServicePtr_T,
+                                           stdair::BaseGenerator_T&,
+                                           const unsigned int iNbOfRuns,
+                                           TotalNumberOfRequestsTable&);
+
+    /**
+     * Save the generation state of all the demand streams, and of the
+     * shared generator, into the given snapshot.
+     *
+     * @param SEVMGR::SEVMGR_ServicePtr_T Pointer on the SEvMgr service
+     * handler.
+     * @param stdair::BaseGenerator_T& The shared generator.
+     * @param DemandStreamSnapshot& Snapshot to be filled.
+     */
+    static void takeSnapshot (SEVMGR::SEVMGR_ServicePtr_T,
+                              const stdair::BaseGenerator_T&,
+                              DemandStreamSnapshot&);
+
+    /**
+     * Restore the generation state saved into the given snapshot, for
+     * the demand streams which have changed since, and reset the event
+     * queue. The next demand generation then gives the same booking
+     * requests as the first one following the snapshot.
+     *
+     * @param SEVMGR::SEVMGR_ServicePtr_T Pointer on the SEvMgr service
+     * handler.
+     * @param stdair::BaseGenerator_T& The shared generator.
+     * @param DemandStreamSnapshot& Snapshot.
+     * @return stdair::Count_T Number of restored demand streams.
+     */
+    static stdair::Count_T restoreSnapshot (SEVMGR::SEVMGR_ServicePtr_T,
+                                            stdair::BaseGenerator_T&,
+                                            DemandStreamSnapshot&);
+
+    /**
+     * Reset the event queue, and put back into it the booking requests
+     * which were lying there when the given snapshot was taken.
+     *
+     * @param SEVMGR::SEVMGR_ServicePtr_T Pointer on the SEvMgr service
+     * handler.
+     * @param const DemandStreamSnapshot& Snapshot.
+     */
+    static void restoreEventQueue (SEVMGR::SEVMGR_ServicePtr_T,
+                                   const DemandStreamSnapshot&);
+
+    /**
+     * Pop the next event out of the event queue, keeping track of the
+     * booking requests still lying in that latter.
+     *
+     * @param SEVMGR::SEVMGR_ServicePtr_T Pointer on the SEvMgr service
+     * handler.
+     * @param stdair::EventStruct& Popped event.
+     * @return stdair::ProgressStatusSet Progress statuses after the pop.
+     */
+    static stdair::ProgressStatusSet popEvent (SEVMGR::SEVMGR_ServicePtr_T,
+                                               stdair::EventStruct&);
+
+    /**
+     * Save the generation state of all the demand streams, of the shared
+     * generator and of the booking requests lying in the event queue,
+     * into the given (binary) checkpoint file.
+     *
+     * @param SEVMGR::SEVMGR_ServicePtr_T Pointer on the SEvMgr service
+     * handler.
+     * @param const stdair::BaseGenerator_T& The shared generator.
+     * @param const stdair::Filename_T& Name of the checkpoint file.
+     */
+    static void saveCheckpoint (SEVMGR::SEVMGR_ServicePtr_T,
+                                const stdair::BaseGenerator_T&,
+                                const stdair::Filename_T&);
+
+    /**
+     * Restore the generation state saved into the given checkpoint
+     * file, and refill the event queue accordingly. The demand
+     * generation then resumes where it was when the checkpoint was
+     * saved.
+     *
+     * @param SEVMGR::SEVMGR_ServicePtr_T Pointer on the SEvMgr service
+     * handler.
+     * @param stdair::BaseGenerator_T& The shared generator.
+     * @param const stdair::Filename_T& Name of the checkpoint file.
+     */
+    static void restoreCheckpoint (SEVMGR::SEVMGR_ServicePtr_T,
+                                   stdair::BaseGenerator_T&,
+                                   const stdair::Filename_T&);
+
+    /**
+     * Schedule the demand streams of the given compiled demands, for the
+     * rolling-horizon demand generation (see DemandStreamSchedule),
+     * rather than creating them.
+     *
+     * The shared generator makes the same draws as
+     * createDemandCharacteristics() does, so that the demand streams,
+     * once opened, give booking requests at the same date-times. The
+     * demand streams not selected (or not sampled) by the given filter
+     * are not scheduled.
+     *
+     * @param SEVMGR::SEVMGR_ServicePtr_T Pointer on the SEvMgr service
+     * handler.
+     * @param stdair::RandomGeneration& The shared generator.
+     * @param const CompiledDemandModelList_T& Compiled demands.
+     * @param const DemandFilterStruct& Selection of the demand streams
+     *        to be scheduled.
+     * @param DemandStreamSchedule& Schedule to be filled.
+     */
+    static void scheduleDemandCharacteristics (SEVMGR::SEVMGR_ServicePtr_T,
+                                               stdair::RandomGeneration&,
+                                               const CompiledDemandModelList_T&,
+                                               const DemandFilterStruct&,
+                                               DemandStreamSchedule&);
+
+    /**
+     * Start a rolling-horizon demand generation: no demand stream is
+     * opened yet, but a break point is added into the event queue, at
+     * the opening date-time of the first demand stream.
+     *
+     * @param SEVMGR::SEVMGR_ServicePtr_T Pointer on the SEvMgr service
+     * handler.
+     * @param const stdair::DemandGenerationMethod& Method used to
+     *        generate the booking requests.
+     * @param DemandStreamSchedule& Schedule of the demand streams.
+     * @return stdair::Count_T Actual total number of booking requests
+     *         to be generated.
+     */
+    static stdair::Count_T
+    startRollingHorizon (SEVMGR::SEVMGR_ServicePtr_T,
+                         const stdair::DemandGenerationMethod&,
+                         DemandStreamSchedule&);
+
+    /**
+     * Move the rolling horizon forward, up to the given date-time:
+     * <ul>
+     *   <li>the open demand streams having no booking request lying in
+     *       the event queue are retired, as they will not give any
+     *       more;</li>
+     *   <li>the demand streams opening up to the given date-time are
+     *       opened (i.e., created, or set again when opened by a former
+     *       run), and their first booking request is generated;</li>
+     *   <li>a break point is added into the event queue, at the opening
+     *       date-time of the next demand stream.</li>
+     * </ul>
+     *
+     * @param SEVMGR::SEVMGR_ServicePtr_T Pointer on the SEvMgr service
+     * handler.
+     * @param stdair::RandomGeneration& The shared generator.
+     * @param const POSProbabilityMass_T& Default POS distribution.
+     * @param const stdair::DateTime_T& Date-time of the simulation clock.
+     * @param DemandStreamSchedule& Schedule of the demand streams.
+     * @return stdair::Count_T Number of opened demand streams.
+     */
+    static stdair::Count_T
+    advanceRollingHorizon (SEVMGR::SEVMGR_ServicePtr_T,
+                           stdair::RandomGeneration&,
+                           const POSProbabilityMass_T&,
+                           const stdair::DateTime_T&,
+                           DemandStreamSchedule&);
+
+    /**
+     * Pop the next event out of the event queue, moving the rolling
+     * horizon forward whenever the break point standing for the next
+     * opening date-time is reached. That break point is not handed over,
+     * unless nothing else is left in the event queue.
+     *
+     * @param SEVMGR::SEVMGR_ServicePtr_T Pointer on the SEvMgr service
+     * handler.
+     * @param stdair::RandomGeneration& The shared generator.
+     * @param const POSProbabilityMass_T& Default POS distribution.
+     * @param DemandStreamSchedule& Schedule of the demand streams.
+     * @param stdair::EventStruct& Popped event.
+     * @return stdair::ProgressStatusSet Progress statuses after the pop.
+     */
+    static stdair::ProgressStatusSet popEvent (SEVMGR::SEVMGR_ServicePtr_T,
+                                               stdair::RandomGeneration&,
+                                               const POSProbabilityMass_T&,
+                                               DemandStreamSchedule&,
+                                               stdair::EventStruct&);
+
+    /**
+     * Reset the rolling-horizon demand generation: the open demand
+     * streams are retired, the total number of requests of every
+     * scheduled demand stream is drawn again, and the event queue is
+     * reset.
+     *
+     * @param SEVMGR::SEVMGR_ServicePtr_T Pointer on the SEvMgr service
+     * handler.
+     * @param stdair::BaseGenerator_T& The shared generator.
+     * @param DemandStreamSchedule& Schedule of the demand streams.
+     */
+    static void resetRollingHorizon (SEVMGR::SEVMGR_ServicePtr_T,
+                                     stdair::BaseGenerator_T&,
+                                     DemandStreamSchedule&);
+
     /**
      * Generate the potential cancellation event.
      */
@@ -3,12 +3,21 @@
 // //////////////////////////////////////////////////////////////////////
 // STL
 #include <cassert>
+#include <vector>
+// Boost
+#include <boost/make_shared.hpp>
 // StdAir
+#include <stdair/stdair_exceptions.hpp>
 #include <stdair/basic/BasFileMgr.hpp>
 #include <stdair/basic/RandomGeneration.hpp>
 #include <stdair/bom/Inventory.hpp>
+#include <stdair/service/Logger.hpp>
 // TraDemGen
-#include <trademgen/command/DemandParserHelper.hpp>
+#include <trademgen/basic/BasConst_DemandLoading.hpp>
+#include <trademgen/basic/ParallelTasks.hpp>
+#include <trademgen/bom/DemandFilterStruct.hpp>
+#include <trademgen/command/DemandManager.hpp>
+#include <trademgen/command/MappedDemandFileParser.hpp>
 #include <trademgen/command/DemandParser.hpp>
 
 namespace TRADEMGEN {
@@ -35,12 +44,244 @@ namespace TRADEMGEN {
     }
 
     // Initialise the demand file parser.
-    DemandFileParser lDemandParser (ioSEVMGR_ServicePtr, ioSharedGenerator,
-                                    iDefaultPOSProbablityMass, lFilename);
+    MappedDemandFileParser lDemandParser (ioSEVMGR_ServicePtr,
+                                          ioSharedGenerator,
+                                          iDefaultPOSProbablityMass, lFilename);
 
     // Parse the CSV-formatted demand input file, and generate the
     // corresponding DemandCharacteristic objects.
     lDemandParser.generateDemand();
   }
 
+  // //////////////////////////////////////////////////////////////////////
+  void DemandParser::
+  compileDemand (const DemandFilePath& iDemandFilename,
+                 stdair::RandomGeneration& ioSharedGenerator,
+                 const POSProbabilityMass_T& iDefaultPOSProbablityMass,
+                 CompiledDemandModel& ioCompiledDemandModel) {
+
+    const stdair::Filename_T lFilename = iDemandFilename.name();
+
+    // Check that the file path given as input corresponds to an actual file
+    const bool doesExistAndIsReadable =
+      stdair::BasFileMgr::doesExistAndIsReadable (lFilename);
+    if (doesExistAndIsReadable == false) {
+      STDAIR_LOG_ERROR ("The demand input file '" << lFilename
+                        << "' does not exist or can not be read");
+      
+      throw DemandInputFileNotFoundException ("The demand file '" + lFilename
+                                              + "' does not exist or can not "
+                                              "be read");
+    }
+
+    // Initialise the demand file parser. As the demands are just
+    // compiled, no SEvMgr service is needed.
+    MappedDemandFileParser lDemandParser (SEVMGR::SEVMGR_ServicePtr_T(),
+                                          ioSharedGenerator,
+                                          iDefaultPOSProbablityMass, lFilename,
+                                          &ioCompiledDemandModel);
+
+    // Parse the CSV-formatted demand input file, and compile the demands
+    lDemandParser.generateDemand();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void DemandParser::
+  generateDemand (const DemandFilePathList_T& iDemandFilePathList,
+                  SEVMGR::SEVMGR_ServicePtr_T ioSEVMGR_ServicePtr,
+                  stdair::RandomGeneration& ioSharedGenerator,
+                  const POSProbabilityMass_T& iDefaultPOSProbablityMass,
+                  const unsigned int iNbOfThreads) {
+
+    // Parse and compile the demand input files
+    CompiledDemandModelList_T lCompiledDemandModelList;
+    compileDemand (iDemandFilePathList, ioSharedGenerator,
+                   iDefaultPOSProbablityMass, lCompiledDemandModelList,
+                   iNbOfThreads);
+
+    // Generate the corresponding DemandCharacteristic objects
+    DemandManager::createDemandCharacteristics (ioSEVMGR_ServicePtr,
+                                                ioSharedGenerator,
+                                                iDefaultPOSProbablityMass,
+                                                lCompiledDemandModelList,
+                                                DemandFilterStruct(),
+                                                iNbOfThreads);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  /**
+   * Part of a demand input file, made of whole lines, and parsed on its
+   * own.
+   */
+  struct DemandFileChunk {
+    /** Index of the file, within the list of demand input files. */
+    std::size_t _fileIdx;
+    /** Parser, holding the state of the parsing of that part. */
+    boost::shared_ptr<MappedDemandFileParser> _parser;
+    /** Offsets of the start and of the end of that part. */
+    std::size_t _beginOffset;
+    std::size_t _endOffset;
+    /** Compiled demand model, filled by the parser. */
+    CompiledDemandModelPtr_T _compiledDemandModel;
+    /** Whether that part has been fully (and successfully) parsed. */
+    bool _hasBeenFullyRead;
+  };
+
+  // //////////////////////////////////////////////////////////////////////
+  void DemandParser::
+  compileDemand (const DemandFilePathList_T& iDemandFilePathList,
+                 stdair::RandomGeneration& ioSharedGenerator,
+                 const POSProbabilityMass_T& iDefaultPOSProbablityMass,
+                 CompiledDemandModelList_T& ioCompiledDemandModelList,
+                 const unsigned int iNbOfThreads) {
+
+    const unsigned int lNbOfThreads = getNbOfThreads (iNbOfThreads);
+
+    /**
+     * 1. Split the demand input files into parts made of whole lines.
+     *    A parser (mapping the file on its own) is created for every
+     *    part, as it holds the state of the parsing. The parsers are
+     *    created here, as they may log and throw when the file can not
+     *    be read.
+     */
+    std::vector<stdair::Filename_T> lFilenameList;
+    std::vector<DemandFileChunk> lChunkList;
+    for (DemandFilePathList_T::const_iterator itPath =
+           iDemandFilePathList.begin();
+         itPath != iDemandFilePathList.end(); ++itPath) {
+      const stdair::Filename_T lFilename = itPath->name();
+
+      // Check that the file path given as input corresponds to an actual file
+      const bool doesExistAndIsReadable =
+        stdair::BasFileMgr::doesExistAndIsReadable (lFilename);
+      if (doesExistAndIsReadable == false) {
+        STDAIR_LOG_ERROR ("The demand input file '" << lFilename
+                          << "' does not exist or can not be read");
+      
+        throw DemandInputFileNotFoundException ("The demand file '" + lFilename
+                                                + "' does not exist or can not "
+                                                "be read");
+      }
+
+      DemandFileChunk lChunk;
+      lChunk._fileIdx = lFilenameList.size();
+      lChunk._beginOffset = 0;
+      lChunk._compiledDemandModel = boost::make_shared<CompiledDemandModel>();
+      lChunk._parser = boost::make_shared<MappedDemandFileParser>
+        (SEVMGR::SEVMGR_ServicePtr_T(), ioSharedGenerator,
+         iDefaultPOSProbablityMass, lFilename,
+         lChunk._compiledDemandModel.get());
+      lChunk._hasBeenFullyRead = false;
+      lFilenameList.push_back (lFilename);
+
+      // A compressed file can only be decompressed sequentially: it is
+      // hence parsed as a whole, by a single thread
+      if (lChunk._parser->isCompressed() == true) {
+        lChunk._endOffset = 0;
+        lChunkList.push_back (lChunk);
+        continue;
+      }
+
+      // Number of parts, so that every thread gets a few of them, and
+      // that they are not too small
+      const std::size_t lFileSize = lChunk._parser->getFileSize();
+      std::size_t lNbOfChunks = lFileSize / MIN_DEMAND_FILE_CHUNK_SIZE;
+      if (lNbOfChunks > lNbOfThreads * NB_OF_DEMAND_FILE_CHUNKS_PER_THREAD) {
+        lNbOfChunks = lNbOfThreads * NB_OF_DEMAND_FILE_CHUNKS_PER_THREAD;
+      }
+      if (lNbOfChunks == 0 || lNbOfThreads == 1) {
+        lNbOfChunks = 1;
+      }
+
+      // The parts start at the beginning of the lines following evenly
+      // spaced offsets
+      for (std::size_t idx = 1; ; ++idx) {
+        const std::size_t lEndOffset = (idx >= lNbOfChunks)?lFileSize:
+          lChunk._parser->getLineStart (idx * (lFileSize / lNbOfChunks));
+        if (lEndOffset == lChunk._beginOffset) {
+          // Very long line, spanning several of those offsets
+          continue;
+        }
+        lChunk._endOffset = lEndOffset;
+        lChunkList.push_back (lChunk);
+        if (lEndOffset == lFileSize) {
+          break;
+        }
+
+        lChunk._beginOffset = lEndOffset;
+        lChunk._compiledDemandModel = boost::make_shared<CompiledDemandModel>();
+        lChunk._parser = boost::make_shared<MappedDemandFileParser>
+          (SEVMGR::SEVMGR_ServicePtr_T(), ioSharedGenerator,
+           iDefaultPOSProbablityMass, lFilename,
+           lChunk._compiledDemandModel.get());
+      }
+    }
+
+    /**
+     * 2. Parse the parts concurrently. Nothing is logged there (the
+     *    StdAir logger being not thread-safe).
+     */
+    auto lParseChunk = [&lChunkList] (const std::size_t iChunkIdx) {
+      DemandFileChunk& lChunk = lChunkList[iChunkIdx];
+      try {
+        lChunk._hasBeenFullyRead =
+          (lChunk._parser->isCompressed() == true)?
+          lChunk._parser->parseFile():
+          lChunk._parser->parseLines (lChunk._beginOffset,
+                                      lChunk._endOffset);
+
+      } catch (const stdair::RootException&) {
+        // The file is parsed again as a whole (see below), which
+        // reports the error
+        lChunk._hasBeenFullyRead = false;
+      }
+    };
+    runParallelTasks (lChunkList.size(), lNbOfThreads, lParseChunk);
+
+    /**
+     * 3. Gather the compiled demand models, in the order of the files.
+     *    When the parts of a file have not all been fully read (e.g.,
+     *    because of a syntax error, or of a C-like comment spanning
+     *    several parts), that file is parsed again, as a whole, so that
+     *    its demands (and the errors) are exactly the ones of a serial
+     *    parsing.
+     */
+    std::vector<DemandFileChunk>::const_iterator itChunk = lChunkList.begin();
+    for (std::size_t lFileIdx = 0; lFileIdx != lFilenameList.size();
+         ++lFileIdx) {
+      const stdair::Filename_T& lFilename = lFilenameList[lFileIdx];
+
+      std::vector<DemandFileChunk>::const_iterator itFirstChunk = itChunk;
+      bool hasBeenFullyRead = true;
+      std::size_t lNbOfReadCharacters = 0;
+      for ( ; itChunk != lChunkList.end() && itChunk->_fileIdx == lFileIdx;
+            ++itChunk) {
+        hasBeenFullyRead = hasBeenFullyRead && itChunk->_hasBeenFullyRead;
+        lNbOfReadCharacters += itChunk->_parser->getNbOfReadCharacters();
+      }
+
+      if (hasBeenFullyRead == true) {
+        STDAIR_LOG_DEBUG ("Parsing of demand input file: " << lFilename
+                          << " succeeded: read " << lNbOfReadCharacters
+                          << " characters (in " << (itChunk - itFirstChunk)
+                          << " parts). The input file has been fully read.");
+
+        for ( ; itFirstChunk != itChunk; ++itFirstChunk) {
+          ioCompiledDemandModelList.push_back (itFirstChunk->_compiledDemandModel);
+        }
+        continue;
+      }
+
+      CompiledDemandModelPtr_T lCompiledDemandModel_ptr =
+        boost::make_shared<CompiledDemandModel>();
+      MappedDemandFileParser lDemandParser (SEVMGR::SEVMGR_ServicePtr_T(),
+                                            ioSharedGenerator,
+                                            iDefaultPOSProbablityMass,
+                                            lFilename,
+                                            lCompiledDemandModel_ptr.get());
+      lDemandParser.generateDemand();
+      ioCompiledDemandModelList.push_back (lCompiledDemandModel_ptr);
+    }
+  }
+
 }
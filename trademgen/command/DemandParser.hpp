@@ -14,6 +14,7 @@
 // TraDemGen
 #include <trademgen/TRADEMGEN_Types.hpp>
 #include <trademgen/basic/DemandCharacteristicsTypes.hpp>
+#include <trademgen/command/CompiledDemandModel.hpp>
 
 /// Forward declarations
 namespace stdair {
@@ -21,7 +22,7 @@ namespace stdair {
 }
 
 namespace TRADEMGEN {
-  
+
   /**
    * @brief Class wrapping the parser entry point.
    */
@@ -44,6 +45,73 @@ namespace TRADEMGEN {
                                 SEVMGR::SEVMGR_ServicePtr_T,
                                 stdair::RandomGeneration&,
                                 const POSProbabilityMass_T&);
+
+    /**
+     * Parse the CSV file describing travel demand, and compile it into
+     * the given (binary) demand model. No demand stream is created.
+     *
+     * @param const DemandFilePath& The file-name of the
+              CSV-formatted demand input file.
+     * @param stdair::RandomGeneration& Random generator (not altered, as
+     *        no demand stream is created).
+     * @param const POSProbabilityMass_T& Default POS distribution.
+     * @param CompiledDemandModel& Compiled demand model to be filled.
+     */
+    static void compileDemand (const DemandFilePath&,
+                               stdair::RandomGeneration&,
+                               const POSProbabilityMass_T&,
+                               CompiledDemandModel&);
+
+    /**
+     * Parse the given CSV files describing travel demand, and generate
+     * the demand streams, as generateDemand() does for each of those
+     * files in turn, but concurrently.
+     *
+     * The files are split into parts made of whole lines, which are
+     * parsed (and compiled) concurrently (the compressed files, which
+     * can only be decompressed sequentially, are not split). The demand
+     * streams are then set up concurrently as well, only what depends on
+     * the shared random generator (i.e., the seeds and the total number
+     * of requests of the demand streams) being drawn beforehand, in the
+     * order of the files and of their lines. Hence, the demand streams
+     * are exactly the same as with generateDemand().
+     *
+     * @param const DemandFilePathList_T& The file-names of the
+     *        CSV-formatted demand input files.
+     * @param SEVMGR::SEVMGR_ServicePtr_T Pointer on the SEvMgr service
+     *        handler to update the queue with the parsed information.
+     * @param stdair::RandomGeneration& Random generator.
+     * @param const POSProbabilityMass_T& Default POS distribution.
+     * @param const unsigned int Number of threads (zero meaning as many
+     *        as the machine can run concurrently).
+     */
+    static void generateDemand (const DemandFilePathList_T&,
+                                SEVMGR::SEVMGR_ServicePtr_T,
+                                stdair::RandomGeneration&,
+                                const POSProbabilityMass_T&,
+                                const unsigned int iNbOfThreads);
+
+    /**
+     * Parse the given CSV files describing travel demand concurrently,
+     * and compile them into a list of (binary) demand models, holding
+     * the demands in the order of the files and of their lines. No
+     * demand stream is created.
+     *
+     * @param const DemandFilePathList_T& The file-names of the
+     *        CSV-formatted demand input files.
+     * @param stdair::RandomGeneration& Random generator (not altered, as
+     *        no demand stream is created).
+     * @param const POSProbabilityMass_T& Default POS distribution.
+     * @param CompiledDemandModelList_T& List of compiled demand models,
+     *        to which the models are appended.
+     * @param const unsigned int Number of threads (zero meaning as many
+     *        as the machine can run concurrently).
+     */
+    static void compileDemand (const DemandFilePathList_T&,
+                               stdair::RandomGeneration&,
+                               const POSProbabilityMass_T&,
+                               CompiledDemandModelList_T&,
+                               const unsigned int iNbOfThreads);
   };
 }
 #endif // __TRADEMGEN_CMD_DEMANDPARSER_HPP
@@ -12,6 +12,7 @@
 //#define BOOST_SPIRIT_DEBUG
 #include <trademgen/command/DemandParserHelper.hpp>
 #include <trademgen/command/DemandManager.hpp>
+#include <trademgen/command/CompiledDemandModel.hpp>
 
 namespace bsc = boost::spirit::classic;
 
@@ -457,24 +458,40 @@ namespace TRADEMGEN {
     doEndDemand::doEndDemand (SEVMGR::SEVMGR_ServicePtr_T ioSEVMGR_ServicePtr,
                               stdair::RandomGeneration& ioSharedGenerator,
                               const POSProbabilityMass_T& iPOSProbMass,
+                              CompiledDemandModel* ioCompiledDemandModel,
                               DemandStruct& ioDemand)
       : ParserSemanticAction (ioDemand),
         _sevmgrServicePtr (ioSEVMGR_ServicePtr),
         _uniformGenerator (ioSharedGenerator),
-        _posProbabilityMass (iPOSProbMass) {
+        _posProbabilityMass (iPOSProbMass),
+        _compiledDemandModel (ioCompiledDemandModel) {
     }
     
     // //////////////////////////////////////////////////////////////////
     // void doEndDemand::operator() (char iChar) const {
     void doEndDemand::operator() (iterator_t iStr, iterator_t iStrEnd) const {
+      (*this)();
+    }
+
+    // //////////////////////////////////////////////////////////////////
+    void doEndDemand::operator() () const {
         
       // DEBUG: Display the result
       // STDAIR_LOG_DEBUG ("Demand: " << _demand.describe());
 
-      // Create the Demand BOM objects
-      DemandManager::createDemandCharacteristics (_sevmgrServicePtr,
-                                                  _uniformGenerator,
-                                                  _posProbabilityMass, _demand);
+      if (_compiledDemandModel != NULL) {
+        // Just compile the demand; the Demand BOM objects will be created
+        // when the compiled demand model is loaded
+        _compiledDemandModel->addDemand (_demand);
+
+      } else if (_sevmgrServicePtr != NULL) {
+        // Create the Demand BOM objects
+        DemandManager::createDemandCharacteristics (_sevmgrServicePtr,
+                                                    _uniformGenerator,
+                                                    _posProbabilityMass,
+                                                    _demand);
+      }
+      // Otherwise, the demand is just parsed (e.g., for checking the file)
                                  
       // Clean the lists
       _demand._posProbDist.clear();
@@ -568,10 +585,12 @@ namespace TRADEMGEN {
     DemandParser::DemandParser (SEVMGR::SEVMGR_ServicePtr_T ioSEVMGR_ServicePtr,
                                 stdair::RandomGeneration& ioSharedGenerator,
                                 const POSProbabilityMass_T& iPOSProbMass,
+                                CompiledDemandModel* ioCompiledDemandModel,
                                 DemandStruct& ioDemand) 
       : _sevmgrServicePtr (ioSEVMGR_ServicePtr),
         _uniformGenerator (ioSharedGenerator),
-        _posProbabilityMass (iPOSProbMass), _demand (ioDemand) {
+        _posProbabilityMass (iPOSProbMass),
+        _compiledDemandModel (ioCompiledDemandModel), _demand (ioDemand) {
     }
 
     // //////////////////////////////////////////////////////////////////
@@ -607,7 +626,8 @@ namespace TRADEMGEN {
         >> ';' >> demand_params
         >> demand_end[doEndDemand (self._sevmgrServicePtr,
                                    self._uniformGenerator,
-                                   self._posProbabilityMass, self._demand)]
+                                   self._posProbabilityMass,
+                                   self._compiledDemandModel, self._demand)]
         ;
 
       demand_end = bsc::ch_p(';')
@@ -854,11 +874,14 @@ namespace TRADEMGEN {
   DemandFileParser (SEVMGR::SEVMGR_ServicePtr_T ioSEVMGR_ServicePtr,
                     stdair::RandomGeneration& ioSharedGenerator,
                     const POSProbabilityMass_T& iPOSProbMass,
-                    const std::string& iFilename)
-    : _filename (iFilename),
+                    const std::string& iFilename,
+                    CompiledDemandModel* ioCompiledDemandModel)
+    : _filename (iFilename), _nbOfReadCharacters (0),
+      _hasBeenFullyRead (false),
       _sevmgrServicePtr (ioSEVMGR_ServicePtr),
       _uniformGenerator (ioSharedGenerator),
-      _posProbabilityMass (iPOSProbMass) {
+      _posProbabilityMass (iPOSProbMass),
+      _compiledDemandModel (ioCompiledDemandModel) {
     init();
   }
 
@@ -903,6 +926,7 @@ namespace TRADEMGEN {
     DemandParserHelper::DemandParser lDemandParser (_sevmgrServicePtr,
                                                     _uniformGenerator,
                                                     _posProbabilityMass,
+                                                    _compiledDemandModel,
                                                     _demand);
       
     // Launch the parsing of the file and, thanks to the doEndDemand
@@ -914,6 +938,8 @@ namespace TRADEMGEN {
 
     // Retrieves whether or not the parsing was successful
     oResult = info.hit;
+    _nbOfReadCharacters = info.length;
+    _hasBeenFullyRead = info.full;
       
     const std::string hasBeenFullyReadStr = (info.full == true)?"":"not ";
     if (oResult == true) {
@@ -22,6 +22,9 @@ namespace stdair {
 
 namespace TRADEMGEN {
 
+  // Forward declarations
+  class CompiledDemandModel;
+
   namespace DemandParserHelper {
     
     // ///////////////////////////////////////////////////////////////////
@@ -271,17 +274,25 @@ namespace TRADEMGEN {
       void operator() (double iReal) const;
     };
   
-    /** Mark the end of the demand parsing. */
+    /**
+     * Mark the end of the demand parsing. The demand is either compiled
+     * (when a compiled demand model is given), or used to create the
+     * demand streams.
+     */
     struct doEndDemand : public ParserSemanticAction {
       /** Actor Constructor. */
       doEndDemand (SEVMGR::SEVMGR_ServicePtr_T, stdair::RandomGeneration&,
-                   const POSProbabilityMass_T&, DemandStruct&);
+                   const POSProbabilityMass_T&, CompiledDemandModel*,
+                   DemandStruct&);
       /** Actor Function (functor). */
       void operator() (iterator_t iStr, iterator_t iStrEnd) const;
+      /** Actor Function, when called out of the Spirit grammar. */
+      void operator() () const;
       /** Actor Specific Context. */
       SEVMGR::SEVMGR_ServicePtr_T _sevmgrServicePtr;
       stdair::RandomGeneration& _uniformGenerator;
       const POSProbabilityMass_T& _posProbabilityMass;
+      CompiledDemandModel* _compiledDemandModel;
     };
   
 
@@ -385,7 +396,8 @@ namespace TRADEMGEN {
       public boost::spirit::classic::grammar<DemandParser> {
 
       DemandParser (SEVMGR::SEVMGR_ServicePtr_T, stdair::RandomGeneration&,
-                    const POSProbabilityMass_T&, DemandStruct&);
+                    const POSProbabilityMass_T&, CompiledDemandModel*,
+                    DemandStruct&);
 
       template <typename ScannerT>
       struct definition {
@@ -415,6 +427,7 @@ namespace TRADEMGEN {
       SEVMGR::SEVMGR_ServicePtr_T _sevmgrServicePtr;
       stdair::RandomGeneration& _uniformGenerator;
       const POSProbabilityMass_T& _posProbabilityMass;
+      CompiledDemandModel* _compiledDemandModel;
       DemandStruct& _demand;
     };
 
@@ -433,13 +446,32 @@ namespace TRADEMGEN {
       code. */
   class DemandFileParser : public stdair::CmdAbstract {
   public:
-    /** Constructor. */
+    /**
+     * Constructor.
+     *
+     * When a compiled demand model is given, the parsed demands are
+     * compiled into it, rather than being used to create the demand
+     * streams. When neither a SEvMgr service nor a compiled demand
+     * model is given, the demands are just parsed (e.g., in order to
+     * check the demand input file).
+     */
     DemandFileParser (SEVMGR::SEVMGR_ServicePtr_T, stdair::RandomGeneration&,
                       const POSProbabilityMass_T&,
-                      const stdair::Filename_T& iDemandInputFilename);
+                      const stdair::Filename_T& iDemandInputFilename,
+                      CompiledDemandModel* ioCompiledDemandModel = NULL);
 
     /** Parse the demand input file. */
     bool generateDemand ();
+
+    /** Get the number of characters read by the parser. */
+    std::size_t getNbOfReadCharacters() const {
+      return _nbOfReadCharacters;
+    }
+
+    /** State whether the demand input file has been fully read. */
+    bool hasBeenFullyRead() const {
+      return _hasBeenFullyRead;
+    }
       
   private:
     /** Initialise. */
@@ -450,6 +482,12 @@ namespace TRADEMGEN {
     /** File-name of the CSV-formatted demand input file. */
     stdair::Filename_T _filename;
 
+    /** Number of characters read by the parser. */
+    std::size_t _nbOfReadCharacters;
+
+    /** Whether the demand input file has been fully read. */
+    bool _hasBeenFullyRead;
+
     /** Start iterator for the parser. */
     iterator_t _startIterator;
       
@@ -465,6 +503,9 @@ namespace TRADEMGEN {
     /** Default POS distribution. */
     const POSProbabilityMass_T& _posProbabilityMass;
 
+    /** Compiled demand model to be filled, if any. */
+    CompiledDemandModel* _compiledDemandModel;
+
     /** Demand Structure. */
     DemandStruct _demand;
   };
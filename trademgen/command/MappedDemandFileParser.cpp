@@ -0,0 +1,1002 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <limits>
+#include <sstream>
+// Boost
+#include <boost/make_shared.hpp>
+#include <boost/version.hpp>
+#include <boost/iostreams/device/file.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#if BOOST_VERSION >= 107000
+#include <boost/iostreams/filter/zstd.hpp>
+#endif // BOOST_VERSION >= 107000
+// StdAir
+#include <stdair/stdair_exceptions.hpp>
+#include <stdair/basic/BasFileMgr.hpp>
+#include <stdair/service/Logger.hpp>
+// TraDemGen
+#include <trademgen/TRADEMGEN_Exceptions.hpp>
+#include <trademgen/basic/BasConst_DemandLoading.hpp>
+#include <trademgen/command/DemandParserHelper.hpp>
+#include <trademgen/command/MappedDemandFileParser.hpp>
+
+namespace TRADEMGEN {
+
+  // //////////////////////////////////////////////////////////////////////
+  /** Blanks, i.e., the characters skipped by the parser (Spirit
+      space_p - eol_p). */
+  static inline bool isBlank (const char iChar) {
+    return (iChar == ' ' || iChar == '\t' || iChar == '\v' || iChar == '\f');
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  static inline bool isDigit (const char iChar) {
+    return (iChar >= '0' && iChar <= '9');
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  static inline bool isUpper (const char iChar) {
+    return (iChar >= 'A' && iChar <= 'Z');
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  /**
+   * Store the probability mass of the given code, as the
+   * DemandParserHelper semantic actions do. As several parsers may run
+   * concurrently, nothing is logged here: the exception is logged by
+   * generateDemand().
+   */
+  template <typename PROB_MASS_FUNCTION>
+  static void storeProbMass (PROB_MASS_FUNCTION& ioProbMassFunction,
+                             const typename PROB_MASS_FUNCTION::key_type& iCode,
+                             const double iProbMass,
+                             const char* iCodeDescription) {
+    const bool hasInsertBeenSuccessfull = ioProbMassFunction.
+      insert (typename PROB_MASS_FUNCTION::value_type (iCode, iProbMass)).second;
+    if (hasInsertBeenSuccessfull == false) {
+      std::ostringstream oStr;
+      oStr << "The same " << iCodeDescription << " ('" << iCode
+           << "') has probably been given twice";
+      throw stdair::CodeDuplicationException (oStr.str());
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  /** Magic bytes, starting the gzip and zstd compressed files. */
+  static const unsigned char K_GZIP_MAGIC[] = { 0x1f, 0x8b };
+  static const unsigned char K_ZSTD_MAGIC[] = { 0x28, 0xb5, 0x2f, 0xfd };
+
+  // //////////////////////////////////////////////////////////////////////
+  MappedDemandFileParser::
+  MappedDemandFileParser (SEVMGR::SEVMGR_ServicePtr_T ioSEVMGR_ServicePtr,
+                          stdair::RandomGeneration& ioSharedGenerator,
+                          const POSProbabilityMass_T& iPOSProbMass,
+                          const stdair::Filename_T& iFilename,
+                          CompiledDemandModel* ioCompiledDemandModel)
+    : _filename (iFilename), _compressionFormat (NO_COMPRESSION),
+      _bufferOffset (0), _itChar (NULL), _endChar (NULL), _stopOffset (0),
+      _nbOfReadCharacters (0), _hasBeenFullyRead (false),
+      _sevmgrServicePtr (ioSEVMGR_ServicePtr),
+      _uniformGenerator (ioSharedGenerator),
+      _posProbabilityMass (iPOSProbMass),
+      _compiledDemandModel (ioCompiledDemandModel) {
+    init();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void MappedDemandFileParser::init() {
+    // Check that the file exists and is readable
+    const bool doesExistAndIsReadable =
+      stdair::BasFileMgr::doesExistAndIsReadable (_filename);
+
+    if (doesExistAndIsReadable == false) {
+      STDAIR_LOG_ERROR ("The demand file " << _filename
+                        << " does not exist or can not be read.");
+
+      throw DemandInputFileNotFoundException ("The demand file " + _filename
+                                              + " does not exist or can not "
+                                              + "be read");
+    }
+
+    // Detect, thanks to their magic bytes, the compressed files
+    unsigned char lMagic[sizeof (K_ZSTD_MAGIC)] = { 0 };
+    {
+      std::ifstream lFile (_filename.c_str(), std::ios::binary);
+      lFile.read (reinterpret_cast<char*> (lMagic), sizeof (lMagic));
+    }
+    if (std::memcmp (lMagic, K_GZIP_MAGIC, sizeof (K_GZIP_MAGIC)) == 0) {
+      _compressionFormat = GZIP;
+    } else if (std::memcmp (lMagic, K_ZSTD_MAGIC, sizeof (K_ZSTD_MAGIC)) == 0) {
+      _compressionFormat = ZSTD;
+    }
+    if (_compressionFormat != NO_COMPRESSION) {
+      openDecompressedStream();
+      return;
+    }
+
+    // Map the file in memory. As with the Spirit file iterator, an empty
+    // file can not be open.
+    try {
+      _mappedFile.open (_filename);
+
+    } catch (const std::exception&) {
+    }
+
+    if (_mappedFile.is_open() == false || _mappedFile.size() == 0) {
+      STDAIR_LOG_ERROR ("The demand file " << _filename << " can not be open.");
+
+      throw DemandInputFileNotFoundException ("The demand file " + _filename
+                                              + " does not exist or can not "
+                                              + "be read");
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void MappedDemandFileParser::openDecompressedStream() {
+    _decompressedStream =
+      boost::make_shared<boost::iostreams::filtering_istream>();
+
+    switch (_compressionFormat) {
+    case GZIP:
+      _decompressedStream->push (boost::iostreams::gzip_decompressor());
+      break;
+    case ZSTD:
+#if BOOST_VERSION >= 107000
+      _decompressedStream->push (boost::iostreams::zstd_decompressor());
+      break;
+#else // BOOST_VERSION >= 107000
+      STDAIR_LOG_ERROR ("The demand file " << _filename << " is compressed "
+                        << "with zstd, which is not supported by that "
+                        << "version of Boost.Iostreams.");
+      throw DemandInputFileDecompressionException ("The demand file "
+                                                   + _filename + " is "
+                                                   + "compressed with zstd, "
+                                                   + "which is not supported");
+#endif // BOOST_VERSION >= 107000
+    default:
+      assert (false);
+      break;
+    }
+
+    _decompressedStream->
+      push (boost::iostreams::file_source (_filename, std::ios::binary));
+
+    // The decompression errors are reported as exceptions
+    _decompressedStream->exceptions (std::ios::badbit);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void MappedDemandFileParser::skipBlanks() {
+    while (_itChar != _endChar && isBlank (*_itChar) == true) {
+      ++_itChar;
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool MappedDemandFileParser::matchChar (const char iChar) {
+    if (_itChar == _endChar || *_itChar != iChar) {
+      return false;
+    }
+    ++_itChar;
+    ++_nbOfReadCharacters;
+    return true;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool MappedDemandFileParser::parseChar (const char iChar) {
+    skipBlanks();
+    return matchChar (iChar);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool MappedDemandFileParser::parseKeyword (const char* iKeyword,
+                                             std::string& ioKeyword) {
+    skipBlanks();
+    const char* lStart = _itChar;
+
+    /**
+     * As for the Spirit character sequences (chseq_p), the blanks are
+     * skipped between the characters, and after the last one. They are
+     * then part of the stored keyword.
+     */
+    const char* lKeywordChar = iKeyword;
+    for ( ; *lKeywordChar != '\0'; ++lKeywordChar) {
+      skipBlanks();
+      if (_itChar == _endChar || *_itChar != *lKeywordChar) {
+        _itChar = lStart;
+        return false;
+      }
+      ++_itChar;
+      skipBlanks();
+    }
+
+    ioKeyword.assign (lStart, _itChar);
+    _nbOfReadCharacters += lKeywordChar - iKeyword;
+    return true;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool MappedDemandFileParser::parseEndOfLine() {
+    std::size_t lLength = 0;
+    if (_itChar != _endChar && *_itChar == '\r') {
+      ++_itChar;
+      ++lLength;
+    }
+    if (_itChar != _endChar && *_itChar == '\n') {
+      ++_itChar;
+      ++lLength;
+    }
+    _nbOfReadCharacters += lLength;
+    return (lLength != 0);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool MappedDemandFileParser::parseComment() {
+    if (_endChar - _itChar < 2 || _itChar[0] != '/') {
+      return false;
+    }
+
+    // Comment up to the end of the line (which is part of the comment),
+    // or up to the end of the file
+    if (_itChar[1] == '/') {
+      const char* lChar = _itChar + 2;
+      while (lChar != _endChar && *lChar != '\r' && *lChar != '\n') {
+        ++lChar;
+      }
+      _nbOfReadCharacters += lChar - _itChar;
+      _itChar = lChar;
+      parseEndOfLine();
+      return true;
+    }
+
+    // C-like (non nested) comment, which must be closed
+    if (_itChar[1] == '*') {
+      for (const char* lChar = _itChar + 2; _endChar - lChar >= 2; ++lChar) {
+        if (lChar[0] == '*' && lChar[1] == '/') {
+          _nbOfReadCharacters += lChar + 2 - _itChar;
+          _itChar = lChar + 2;
+          return true;
+        }
+      }
+    }
+
+    return false;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool MappedDemandFileParser::
+  parseUnsigned (const unsigned short iMinNbOfDigits,
+                 const unsigned short iMaxNbOfDigits, unsigned int& oValue) {
+    const char* lChar = _itChar;
+    unsigned int lValue = 0;
+    unsigned short lNbOfDigits = 0;
+    while (lNbOfDigits < iMaxNbOfDigits && lChar != _endChar
+           && isDigit (*lChar) == true) {
+      lValue = 10 * lValue + (*lChar - '0');
+      ++lChar;
+      ++lNbOfDigits;
+    }
+
+    if (lNbOfDigits < iMinNbOfDigits) {
+      return false;
+    }
+
+    _nbOfReadCharacters += lNbOfDigits;
+    _itChar = lChar;
+    oValue = lValue;
+    return true;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool MappedDemandFileParser::parseReal (double& oReal) {
+    skipBlanks();
+
+    /**
+     * The number is converted exactly the way the Spirit unsigned real
+     * parser (ureal_p) does, so that the values are the same, bit for
+     * bit: the integral and fractional parts are accumulated separately,
+     * the latter being then scaled down and added to the former. The
+     * number of read characters is also counted the Spirit way, i.e.,
+     * neither a trailing dot nor, when there is no integral part, the
+     * leading dot are counted.
+     */
+    static const double lMaxValue = std::numeric_limits<double>::max();
+    const char* lChar = _itChar;
+    std::ptrdiff_t lLength = 0;
+
+    // Integral part
+    double lValue = 0.0;
+    const char* lIntStart = lChar;
+    while (lChar != _endChar && isDigit (*lChar) == true) {
+      const double lDigit = *lChar - '0';
+      if (lValue > lMaxValue / 10) {
+        return false;
+      }
+      lValue *= 10;
+      if (lValue > lMaxValue - lDigit) {
+        return false;
+      }
+      lValue += lDigit;
+      ++lChar;
+    }
+    const bool hasIntegralPart = (lChar != lIntStart);
+    lLength = hasIntegralPart ? lChar - lIntStart : -1;
+
+    // Fractional part
+    if (lChar != _endChar && *lChar == '.') {
+      ++lChar;
+      double lFraction = 0.0;
+      const char* lFracStart = lChar;
+      while (lChar != _endChar && isDigit (*lChar) == true) {
+        const double lDigit = *lChar - '0';
+        if (lFraction > lMaxValue / 10) {
+          return false;
+        }
+        lFraction *= 10;
+        if (lFraction > lMaxValue - lDigit) {
+          return false;
+        }
+        lFraction += lDigit;
+        ++lChar;
+      }
+      const std::ptrdiff_t lNbOfFracDigits = lChar - lFracStart;
+
+      if (lNbOfFracDigits != 0) {
+        lFraction *= std::pow (10.0, static_cast<double> (-lNbOfFracDigits));
+        lValue += lFraction;
+        lLength += lNbOfFracDigits + 1;
+
+      } else if (hasIntegralPart == false) {
+        return false;
+      }
+
+    } else if (hasIntegralPart == false) {
+      return false;
+    }
+
+    // Exponent, which must be given when introduced
+    if (lChar != _endChar && (*lChar == 'e' || *lChar == 'E')) {
+      ++lChar;
+      const char* lExpStart = lChar;
+      bool isNegative = false;
+      if (lChar != _endChar && (*lChar == '+' || *lChar == '-')) {
+        isNegative = (*lChar == '-');
+        ++lChar;
+      }
+
+      int lExponent = 0;
+      const char* lExpDigitStart = lChar;
+      while (lChar != _endChar && isDigit (*lChar) == true) {
+        const int lDigit = *lChar - '0';
+        if (isNegative == false) {
+          if (lExponent > std::numeric_limits<int>::max() / 10
+              || 10 * lExponent > std::numeric_limits<int>::max() - lDigit) {
+            return false;
+          }
+          lExponent = 10 * lExponent + lDigit;
+
+        } else {
+          if (lExponent < std::numeric_limits<int>::min() / 10
+              || 10 * lExponent < std::numeric_limits<int>::min() + lDigit) {
+            return false;
+          }
+          lExponent = 10 * lExponent - lDigit;
+        }
+        ++lChar;
+      }
+      if (lChar == lExpDigitStart) {
+        return false;
+      }
+
+      lValue *= std::pow (10.0, static_cast<double> (lExponent));
+      lLength += lChar - lExpStart + 1;
+    }
+
+    // Sanity check
+    assert (lLength > 0);
+
+    _nbOfReadCharacters += lLength;
+    _itChar = lChar;
+    oReal = lValue;
+    return true;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool MappedDemandFileParser::parseCode (const unsigned short iNbOfChars,
+                                          const bool iAllowDigits,
+                                          std::string& ioCode) {
+    skipBlanks();
+    const char* lStart = _itChar;
+
+    // As for Spirit, the blanks are skipped between the characters
+    for (unsigned short idx = 0; idx != iNbOfChars; ++idx) {
+      skipBlanks();
+      if (_itChar == _endChar
+          || (isUpper (*_itChar) == false
+              && (iAllowDigits == false || isDigit (*_itChar) == false))) {
+        _itChar = lStart;
+        return false;
+      }
+      ++_itChar;
+    }
+
+    ioCode.assign (lStart, _itChar);
+    _nbOfReadCharacters += iNbOfChars;
+    return true;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool MappedDemandFileParser::parseNotToBeParsed() {
+    skipBlanks();
+    return (parseComment() == true || parseEndOfLine() == true);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool MappedDemandFileParser::parseDate() {
+    skipBlanks();
+
+    // No blank is allowed within a date
+    unsigned int lYear = 0;
+    if (parseUnsigned (4, 4, lYear) == false || lYear < 2000 || lYear > 2099) {
+      return false;
+    }
+    _demand._itYear = lYear;
+
+    unsigned int lMonth = 0;
+    if (matchChar ('-') == false || parseUnsigned (2, 2, lMonth) == false
+        || lMonth < 1 || lMonth > 12) {
+      return false;
+    }
+    _demand._itMonth = lMonth;
+
+    unsigned int lDay = 0;
+    if (matchChar ('-') == false || parseUnsigned (2, 2, lDay) == false
+        || lDay < 1 || lDay > 31) {
+      return false;
+    }
+    _demand._itDay = lDay;
+
+    return true;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool MappedDemandFileParser::parseDoW() {
+    skipBlanks();
+
+    const std::ptrdiff_t lNbOfDays = 7;
+    if (_endChar - _itChar < lNbOfDays) {
+      return false;
+    }
+    for (std::ptrdiff_t idx = 0; idx != lNbOfDays; ++idx) {
+      if (_itChar[idx] != '0' && _itChar[idx] != '1') {
+        return false;
+      }
+    }
+
+    const stdair::DOW_String_T lDow (_itChar, _itChar + lNbOfDays);
+    _demand._dow = lDow;
+    _itChar += lNbOfDays;
+    _nbOfReadCharacters += lNbOfDays;
+    return true;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool MappedDemandFileParser::parseTime() {
+    skipBlanks();
+
+    // No blank is allowed within a time
+    unsigned int lHours = 0;
+    if (parseUnsigned (1, 2, lHours) == false || lHours > 23) {
+      return false;
+    }
+    _demand._itHours = lHours;
+
+    // The minutes, and then the seconds, are optional
+    const char* lSavedChar = _itChar;
+    std::size_t lSavedNbOfReadCharacters = _nbOfReadCharacters;
+    unsigned int lMinutes = 0;
+    if (matchChar ('.') == true && parseUnsigned (2, 2, lMinutes) == true
+        && lMinutes <= 59) {
+      _demand._itMinutes = lMinutes;
+
+    } else {
+      _itChar = lSavedChar;
+      _nbOfReadCharacters = lSavedNbOfReadCharacters;
+    }
+
+    lSavedChar = _itChar;
+    lSavedNbOfReadCharacters = _nbOfReadCharacters;
+    unsigned int lSeconds = 0;
+    if (matchChar ('.') == true && parseUnsigned (2, 2, lSeconds) == true
+        && lSeconds <= 59) {
+      _demand._itSeconds = lSeconds;
+
+    } else {
+      _itChar = lSavedChar;
+      _nbOfReadCharacters = lSavedNbOfReadCharacters;
+    }
+
+    return true;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool MappedDemandFileParser::parsePosCode() {
+    return (parseCode (3, true, _demand._itPosCode) == true
+            || parseKeyword ("row", _demand._itPosCode) == true);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool MappedDemandFileParser::parsePosDist() {
+    do {
+      double lProbMass = 0.0;
+      if (parsePosCode() == false || parseChar (':') == false
+          || parseReal (lProbMass) == false) {
+        return false;
+      }
+      storeProbMass (_demand._posProbDist, _demand._itPosCode, lProbMass,
+                     "POS code");
+    } while (parseChar (',') == true);
+    return true;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool MappedDemandFileParser::parseChannelDist() {
+    do {
+      std::string& lChannelCode = _demand._itChannelCode;
+      if (parseKeyword ("DF", lChannelCode) == false
+          && parseKeyword ("DN", lChannelCode) == false
+          && parseKeyword ("IF", lChannelCode) == false
+          && parseKeyword ("IN", lChannelCode) == false) {
+        return false;
+      }
+
+      double lProbMass = 0.0;
+      if (parseChar (':') == false || parseReal (lProbMass) == false) {
+        return false;
+      }
+      storeProbMass (_demand._channelProbDist, lChannelCode, lProbMass,
+                     "channel type code");
+    } while (parseChar (',') == true);
+    return true;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool MappedDemandFileParser::parseTripDist() {
+    do {
+      std::string& lTripCode = _demand._itTripCode;
+      if (parseKeyword ("RO", lTripCode) == false
+          && parseKeyword ("RI", lTripCode) == false
+          && parseKeyword ("OW", lTripCode) == false) {
+        return false;
+      }
+
+      double lProbMass = 0.0;
+      if (parseChar (':') == false || parseReal (lProbMass) == false) {
+        return false;
+      }
+      storeProbMass (_demand._tripProbDist, lTripCode, lProbMass,
+                     "trip type code");
+    } while (parseChar (',') == true);
+    return true;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool MappedDemandFileParser::parseStayDist() {
+    const DemandParserHelper::storeStayCode lStoreStayCode (_demand);
+    do {
+      skipBlanks();
+      unsigned int lStayDuration = 0;
+      if (parseUnsigned (1, 3, lStayDuration) == false) {
+        return false;
+      }
+      lStoreStayCode (lStayDuration);
+
+      double lProbMass = 0.0;
+      if (parseChar (':') == false || parseReal (lProbMass) == false) {
+        return false;
+      }
+      storeProbMass (_demand._stayProbDist, _demand._itStayDuration, lProbMass,
+                     "stay duration");
+    } while (parseChar (',') == true);
+    return true;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool MappedDemandFileParser::parseFFDist() {
+    do {
+      double lProbMass = 0.0;
+      if (parseCode (1, false, _demand._itFFCode) == false
+          || parseChar (':') == false || parseReal (lProbMass) == false) {
+        return false;
+      }
+      storeProbMass (_demand._ffProbDist, _demand._itFFCode, lProbMass,
+                     "Frequent Flyer code");
+    } while (parseChar (',') == true);
+    return true;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool MappedDemandFileParser::parsePrefDepTimeDist() {
+    const DemandParserHelper::
+      storePrefDepTimeProbMass lStorePrefDepTimeProbMass (_demand);
+    do {
+      if (parseTime() == false) {
+        return false;
+      }
+      _demand._itPrefDepTime = _demand.getTime();
+
+      // Reset the number of minutes and seconds
+      _demand._itMinutes = 0;
+      _demand._itSeconds = 0;
+
+      double lProbMass = 0.0;
+      if (parseChar (':') == false || parseReal (lProbMass) == false) {
+        return false;
+      }
+      lStorePrefDepTimeProbMass (lProbMass);
+    } while (parseChar (',') == true);
+    return true;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool MappedDemandFileParser::parseTimeValueDist() {
+    const DemandParserHelper::storeTimeValue lStoreTimeValue (_demand);
+    const DemandParserHelper::
+      storeTimeValueProbMass lStoreTimeValueProbMass (_demand);
+    do {
+      double lTimeValue = 0.0;
+      if (parseReal (lTimeValue) == false) {
+        return false;
+      }
+      lStoreTimeValue (lTimeValue);
+
+      double lProbMass = 0.0;
+      if (parseChar (':') == false || parseReal (lProbMass) == false) {
+        return false;
+      }
+      lStoreTimeValueProbMass (lProbMass);
+    } while (parseChar (',') == true);
+    return true;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool MappedDemandFileParser::parseDTDDist() {
+    const DemandParserHelper::storeDTD lStoreDTD (_demand);
+    const DemandParserHelper::storeDTDProbMass lStoreDTDProbMass (_demand);
+    do {
+      double lDTD = 0.0;
+      if (parseReal (lDTD) == false) {
+        return false;
+      }
+      // As with Spirit, the (real) DTD is truncated
+      lStoreDTD (static_cast<unsigned int> (lDTD));
+
+      double lProbMass = 0.0;
+      if (parseChar (':') == false || parseReal (lProbMass) == false) {
+        return false;
+      }
+      lStoreDTDProbMass (lProbMass);
+    } while (parseChar (',') == true);
+    return true;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool MappedDemandFileParser::parseDemand() {
+    // Preferred departure date range
+    if (parseDate() == false) {
+      return false;
+    }
+    _demand._prefDepDateStart = _demand.getDate();
+    _demand._itSeconds = 0;
+
+    if (parseChar (';') == false || parseDate() == false) {
+      return false;
+    }
+    // As a Boost date period (DatePeriod_T) defines the last day of
+    // the period to be end-date - one day, we have to add one day to that
+    // end date before.
+    const stdair::DateOffset_T oneDay (1);
+    _demand._prefDepDateEnd = _demand.getDate() + oneDay;
+    _demand._dateRange = stdair::DatePeriod_T (_demand._prefDepDateStart,
+                                               _demand._prefDepDateEnd);
+    _demand._itSeconds = 0;
+
+    // Days of the week, origin, destination and preferred cabin
+    if (parseChar (';') == false || parseDoW() == false
+        || parseChar (';') == false
+        || parseCode (3, true, _demand._origin) == false
+        || parseChar (';') == false
+        || parseCode (3, true, _demand._destination) == false
+        || parseChar (';') == false
+        || parseCode (1, false, _demand._prefCabin) == false) {
+      return false;
+    }
+
+    // Distributions of the POS, channel, trip type, stay duration and
+    // frequent flyer type
+    if (parseChar (';') == false || parsePosDist() == false
+        || parseChar (';') == false || parseChannelDist() == false
+        || parseChar (';') == false || parseTripDist() == false
+        || parseChar (';') == false || parseStayDist() == false
+        || parseChar (';') == false || parseFFDist() == false) {
+      return false;
+    }
+
+    // Change fees and non refundable restrictions
+    const DemandParserHelper::
+      storeDemandChangeFeeProb lStoreDemandChangeFeeProb (_demand);
+    const DemandParserHelper::
+      storeDemandChangeFeeDisutility lStoreDemandChangeFeeDisutility (_demand);
+    const DemandParserHelper::
+      storeDemandNonRefundableProb lStoreDemandNonRefundableProb (_demand);
+    const DemandParserHelper::
+      storeDemandNonRefundableDisutility
+      lStoreDemandNonRefundableDisutility (_demand);
+    double lReal = 0.0;
+    if (parseChar (';') == false || parseReal (lReal) == false) {
+      return false;
+    }
+    lStoreDemandChangeFeeProb (lReal);
+    if (parseChar (';') == false || parseReal (lReal) == false) {
+      return false;
+    }
+    lStoreDemandChangeFeeDisutility (lReal);
+    if (parseChar (';') == false || parseReal (lReal) == false) {
+      return false;
+    }
+    lStoreDemandNonRefundableProb (lReal);
+    if (parseChar (';') == false || parseReal (lReal) == false) {
+      return false;
+    }
+    lStoreDemandNonRefundableDisutility (lReal);
+
+    // Preferred departure time distribution and WTP
+    if (parseChar (';') == false || parsePrefDepTimeDist() == false
+        || parseChar (';') == false || parseReal (lReal) == false) {
+      return false;
+    }
+    const DemandParserHelper::storeWTP lStoreWTP (_demand);
+    lStoreWTP (lReal);
+
+    // Value of time and arrival pattern distributions
+    if (parseChar (';') == false || parseTimeValueDist() == false
+        || parseChar (';') == false || parseDTDDist() == false) {
+      return false;
+    }
+
+    // Demand parameters
+    const DemandParserHelper::storeDemandMean lStoreDemandMean (_demand);
+    const DemandParserHelper::storeDemandStdDev lStoreDemandStdDev (_demand);
+    if (parseChar (';') == false || parseChar ('N') == false
+        || parseChar (',') == false || parseReal (lReal) == false) {
+      return false;
+    }
+    lStoreDemandMean (lReal);
+    if (parseChar (',') == false || parseReal (lReal) == false) {
+      return false;
+    }
+    lStoreDemandStdDev (lReal);
+
+    // End of the demand
+    if (parseChar (';') == false) {
+      return false;
+    }
+    const DemandParserHelper::doEndDemand lDoEndDemand (_sevmgrServicePtr,
+                                                        _uniformGenerator,
+                                                        _posProbabilityMass,
+                                                        _compiledDemandModel,
+                                                        _demand);
+    lDoEndDemand();
+    return true;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  std::size_t MappedDemandFileParser::
+  getLineStart (const std::size_t iOffset) const {
+    const std::size_t lFileSize = getFileSize();
+    if (iOffset == 0 || iOffset >= lFileSize) {
+      return (iOffset == 0)?0:lFileSize;
+    }
+
+    // The line starts just after the first line feed before the offset,
+    // if any, or after the offset
+    const char* lData = _mappedFile.data();
+    if (lData[iOffset - 1] == '\n') {
+      return iOffset;
+    }
+    const char* itChar = static_cast<const char*>
+      (std::memchr (lData + iOffset, '\n', lFileSize - iOffset));
+    return (itChar == NULL)?lFileSize:(itChar - lData + 1);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void MappedDemandFileParser::parseItems() {
+    /**
+     * Lines which are not demands (comments and empty lines) or demands,
+     * as many as possible. When a line can not be parsed, the parsing
+     * stops at its beginning (the demands already parsed being kept).
+     */
+    while (true) {
+      const char* lSavedChar = _itChar;
+      const std::size_t lSavedNbOfReadCharacters = _nbOfReadCharacters;
+
+      if (parseNotToBeParsed() == true) {
+        continue;
+      }
+      _itChar = lSavedChar;
+      _nbOfReadCharacters = lSavedNbOfReadCharacters;
+
+      if (parseDemand() == true) {
+        continue;
+      }
+      _itChar = lSavedChar;
+      _nbOfReadCharacters = lSavedNbOfReadCharacters;
+      break;
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool MappedDemandFileParser::parseLines (const std::size_t iBeginOffset,
+                                           const std::size_t iEndOffset) {
+    // Sanity check
+    assert (isCompressed() == false);
+    assert (iBeginOffset <= iEndOffset && iEndOffset <= getFileSize());
+
+    _itChar = _mappedFile.data() + iBeginOffset;
+    _endChar = _mappedFile.data() + iEndOffset;
+    _nbOfReadCharacters = 0;
+
+    // As with the Spirit scanner, the leading blanks are always skipped
+    skipBlanks();
+
+    parseItems();
+
+    _stopOffset = _itChar - _mappedFile.data();
+    _hasBeenFullyRead = (_itChar == _endChar);
+    return _hasBeenFullyRead;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool MappedDemandFileParser::fillBuffer (std::size_t& ioBufferedSize) {
+    try {
+      while (ioBufferedSize != _buffer.size()) {
+        _decompressedStream->read (&_buffer[ioBufferedSize],
+                                   _buffer.size() - ioBufferedSize);
+        ioBufferedSize += _decompressedStream->gcount();
+        if (_decompressedStream->eof() == true) {
+          return true;
+        }
+      }
+
+    } catch (const std::exception& lException) {
+      throw DemandInputFileDecompressionException ("The demand file "
+                                                   + _filename + " can not "
+                                                   + "be decompressed: "
+                                                   + lException.what());
+    }
+    return false;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool MappedDemandFileParser::isWithinOpenComment() const {
+    const char* lChar = _itChar;
+    while (lChar != _endChar && isBlank (*lChar) == true) {
+      ++lChar;
+    }
+    if (_endChar - lChar < 2 || lChar[0] != '/' || lChar[1] != '*') {
+      return false;
+    }
+    for (lChar += 2; _endChar - lChar >= 2; ++lChar) {
+      if (lChar[0] == '*' && lChar[1] == '/') {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool MappedDemandFileParser::parseDecompressedStream() {
+    // Sanity check
+    assert (_decompressedStream != NULL);
+
+    _buffer.resize (DEMAND_FILE_BUFFER_SIZE);
+    _bufferOffset = 0;
+    _nbOfReadCharacters = 0;
+    std::size_t lBufferedSize = 0;
+    bool isStartOfFile = true;
+
+    while (true) {
+      const bool isEndOfFile = fillBuffer (lBufferedSize);
+
+      // As for the mapped files, an empty file can not be open
+      if (isEndOfFile == true && isStartOfFile == true && lBufferedSize == 0) {
+        throw DemandInputFileNotFoundException ("The demand file " + _filename
+                                                + " does not exist or can "
+                                                + "not be read");
+      }
+
+      // Only the whole lines are parsed, the last (partial) one waiting
+      // for the next decompressed data
+      const char* lBeginChar = &_buffer[0];
+      const char* lEndChar = lBeginChar + lBufferedSize;
+      if (isEndOfFile == false) {
+        while (lEndChar != lBeginChar && lEndChar[-1] != '\n') {
+          --lEndChar;
+        }
+      }
+
+      _itChar = lBeginChar;
+      _endChar = lEndChar;
+
+      // As with the Spirit scanner, the leading blanks are always skipped
+      if (isStartOfFile == true && _itChar != _endChar) {
+        skipBlanks();
+        isStartOfFile = false;
+      }
+
+      parseItems();
+
+      // The parsing stops at the end of the file, or on a line which can
+      // not be parsed, unless that line starts a C-like comment, which
+      // may be closed further in the file
+      const std::size_t lNbOfParsedBytes = _itChar - lBeginChar;
+      if (isEndOfFile == true
+          || (_itChar != _endChar && isWithinOpenComment() == false)) {
+        _stopOffset = _bufferOffset + lNbOfParsedBytes;
+        _hasBeenFullyRead = (isEndOfFile == true && _itChar == _endChar);
+        break;
+      }
+
+      // Keep the data not parsed yet, and make room for the next ones,
+      // enlarging the buffer when a single line (or comment) fills it
+      lBufferedSize -= lNbOfParsedBytes;
+      std::memmove (&_buffer[0], &_buffer[lNbOfParsedBytes], lBufferedSize);
+      _bufferOffset += lNbOfParsedBytes;
+      if (lBufferedSize == _buffer.size()) {
+        _buffer.resize (2 * _buffer.size());
+      }
+    }
+
+    return _hasBeenFullyRead;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool MappedDemandFileParser::parseFile() {
+    if (isCompressed() == true) {
+      return parseDecompressedStream();
+    }
+    return parseLines (0, getFileSize());
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool MappedDemandFileParser::generateDemand () {
+    STDAIR_LOG_DEBUG ("Parsing demand input file: " << _filename);
+
+    try {
+      parseFile();
+
+    } catch (const stdair::RootException& lParsingException) {
+      STDAIR_LOG_ERROR (lParsingException.what());
+      throw;
+    }
+
+    const std::string hasBeenFullyReadStr =
+      (_hasBeenFullyRead == true)?"":"not ";
+    STDAIR_LOG_DEBUG ("Parsing of demand input file: " << _filename
+                      << " succeeded: read " << _nbOfReadCharacters
+                      << " characters. The input file has "
+                      << hasBeenFullyReadStr
+                      << "been fully read. Stop point: byte #"
+                      << _stopOffset);
+
+    return true;
+  }
+
+}
@@ -0,0 +1,284 @@
+#ifndef __TRADEMGEN_CMD_MAPPEDDEMANDFILEPARSER_HPP
+#define __TRADEMGEN_CMD_MAPPEDDEMANDFILEPARSER_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <string>
+#include <vector>
+// Boost
+#include <boost/shared_ptr.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+// StdAir
+#include <stdair/stdair_basic_types.hpp>
+#include <stdair/command/CmdAbstract.hpp>
+// SEvMgr
+#include <sevmgr/SEVMGR_Types.hpp>
+// TraDemGen
+#include <trademgen/basic/DemandCharacteristicsTypes.hpp>
+#include <trademgen/bom/DemandStruct.hpp>
+
+// Forward declarations
+namespace stdair {
+  struct RandomGeneration;
+}
+
+namespace TRADEMGEN {
+
+  // Forward declarations
+  class CompiledDemandModel;
+
+  /**
+   * @brief Hand-written parser of the demand input file.
+   *
+   * The file is mapped in memory, and scanned with plain character
+   * pointers: the codes are copied straight from the mapped buffer into
+   * the (reused) staging strings of the DemandStruct, and the numbers
+   * are converted in place.
+   *
+   * That parser accepts exactly the same grammar as the (Boost Spirit)
+   * DemandFileParser, including its handling of blanks (which are
+   * skipped between the tokens, but not within the dates, times,
+   * days-of-the-week and numbers) and its conversion of the real
+   * numbers, so that the parsed values are the same, bit for bit. It
+   * also reports the same number of read characters, which, as for
+   * Spirit, is the sum of the lengths of the matched tokens (the
+   * skipped blanks being not counted).
+   *
+   * A compressed (gzip or zstd) demand input file, detected thanks to
+   * its magic bytes, is rather decompressed on the fly, into a buffer of
+   * bounded size (see DEMAND_FILE_BUFFER_SIZE), which is parsed line
+   * after line. The buffer only grows when a single line, or a C-like
+   * comment, does not fit in it.
+   */
+  class MappedDemandFileParser : public stdair::CmdAbstract {
+  public:
+    /**
+     * Constructor.
+     *
+     * When a compiled demand model is given, the parsed demands are
+     * compiled into it, rather than being used to create the demand
+     * streams. When neither a SEvMgr service nor a compiled demand
+     * model is given, the demands are just parsed (e.g., in order to
+     * check the demand input file).
+     */
+    MappedDemandFileParser (SEVMGR::SEVMGR_ServicePtr_T,
+                            stdair::RandomGeneration&,
+                            const POSProbabilityMass_T&,
+                            const stdair::Filename_T& iDemandInputFilename,
+                            CompiledDemandModel* ioCompiledDemandModel = NULL);
+
+    /** Parse the demand input file. */
+    bool generateDemand ();
+
+    /**
+     * Parse the whole demand input file, decompressing it when needed.
+     * As nothing is logged, several parsers may parse distinct files
+     * concurrently.
+     *
+     * @return bool Whether the file has been fully read.
+     * @throw stdair::CodeDuplicationException when the same code is
+     *        given twice within a distribution.
+     * @throw DemandInputFileDecompressionException when the compressed
+     *        file is corrupted.
+     */
+    bool parseFile();
+
+    /**
+     * Parse the lines of the demand input file lying between the given
+     * offsets, the first one being the start of a line (see
+     * getLineStart()). As nothing is logged, several parsers may parse
+     * distinct parts of the same file concurrently. The file must not be
+     * compressed.
+     *
+     * @return bool Whether those lines have been fully read.
+     * @throw stdair::CodeDuplicationException when the same code is
+     *        given twice within a distribution.
+     */
+    bool parseLines (const std::size_t iBeginOffset,
+                     const std::size_t iEndOffset);
+
+    /** Get the size (in bytes) of the demand input file (zero when it
+        is compressed, as it is then not mapped in memory). */
+    std::size_t getFileSize() const {
+      return _mappedFile.size();
+    }
+
+    /** State whether the demand input file is compressed. */
+    bool isCompressed() const {
+      return (_compressionFormat != NO_COMPRESSION);
+    }
+
+    /**
+     * Get the offset of the start of the first line of the demand input
+     * file, at or after the given offset (the size of the file, when
+     * there is none).
+     */
+    std::size_t getLineStart (const std::size_t) const;
+
+    /**
+     * Get the number of characters read by the parser, as reported by
+     * Spirit (i.e., not counting the skipped blanks).
+     */
+    std::size_t getNbOfReadCharacters() const {
+      return _nbOfReadCharacters;
+    }
+
+    /** State whether the demand input file has been fully read. */
+    bool hasBeenFullyRead() const {
+      return _hasBeenFullyRead;
+    }
+
+  private:
+    /** Compression formats of the demand input file. */
+    enum EN_CompressionFormat {
+      NO_COMPRESSION = 0,
+      GZIP,
+      ZSTD
+    };
+
+    /** Initialise. */
+    void init();
+
+    /** Set up the decompression of the demand input file. */
+    void openDecompressedStream();
+
+    /**
+     * Append the next decompressed data to the buffer, until it is full.
+     *
+     * @return bool Whether the end of the demand input file has been
+     *         reached.
+     */
+    bool fillBuffer (std::size_t& ioBufferedSize);
+
+    /** Parse the decompressed demand input file, buffer after buffer. */
+    bool parseDecompressedStream();
+
+    /** Parse the lines not to be parsed and the demands, from the
+        current position, as many as possible. */
+    void parseItems();
+
+    /** State whether, at the current position, a C-like comment starts,
+        which is not closed before the end of the buffer. */
+    bool isWithinOpenComment() const;
+
+    // ////////// Scanner /////////
+    /** Skip the blanks, but not the ends of line. */
+    void skipBlanks();
+
+    /** Parse the given character, without skipping the blanks. */
+    bool matchChar (const char);
+
+    /** Parse the given character (after the blanks). */
+    bool parseChar (const char);
+
+    /** Parse the given keyword, the blanks being skipped between (and
+        after) its characters. The keyword is stored into the given
+        string, as it appears in the file. */
+    bool parseKeyword (const char*, std::string&);
+
+    /** Parse an end of line (CR, LF or CR-LF). */
+    bool parseEndOfLine();
+
+    /** Parse a comment, either up to the end of the line or C-like. */
+    bool parseComment();
+
+    /** Parse an unsigned integer, without skipping the blanks. */
+    bool parseUnsigned (const unsigned short iMinNbOfDigits,
+                        const unsigned short iMaxNbOfDigits,
+                        unsigned int&);
+
+    /** Parse an unsigned real number (after the blanks). */
+    bool parseReal (double&);
+
+    /** Parse a code made of the given number of upper case letters
+        (and digits, if so stated), after the blanks. */
+    bool parseCode (const unsigned short iNbOfChars, const bool iAllowDigits,
+                    std::string&);
+
+    // ////////// Grammar /////////
+    /** Parse a line which is not a demand (comment or empty line). */
+    bool parseNotToBeParsed();
+
+    /** Parse a demand, and create the corresponding demand stream. */
+    bool parseDemand();
+
+    /** Parse a date (yyyy-mm-dd). */
+    bool parseDate();
+
+    /** Parse a day-of-the-week mask. */
+    bool parseDoW();
+
+    /** Parse a time (hh[.mm[.ss]]). */
+    bool parseTime();
+
+    /** Parse a POS code (airport code or "row"). */
+    bool parsePosCode();
+
+    /** Parse the distribution of the given kind. */
+    bool parsePosDist();
+    bool parseChannelDist();
+    bool parseTripDist();
+    bool parseStayDist();
+    bool parseFFDist();
+    bool parsePrefDepTimeDist();
+    bool parseTimeValueDist();
+    bool parseDTDDist();
+
+  private:
+    // Attributes
+    /** File-name of the CSV-formatted demand input file. */
+    stdair::Filename_T _filename;
+
+    /** Compression format of the demand input file. */
+    EN_CompressionFormat _compressionFormat;
+
+    /** Demand input file, mapped in memory (when not compressed). */
+    boost::iostreams::mapped_file_source _mappedFile;
+
+    /** Decompressed demand input file (when compressed). */
+    boost::shared_ptr<boost::iostreams::filtering_istream> _decompressedStream;
+
+    /** Buffer holding the decompressed lines being parsed. */
+    std::vector<char> _buffer;
+
+    /** Offset, within the (decompressed) demand input file, of the
+        start of the buffer. */
+    std::size_t _bufferOffset;
+
+    /** Current position of the parser. */
+    const char* _itChar;
+
+    /** End of the mapped buffer. */
+    const char* _endChar;
+
+    /** Offset, within the (decompressed) demand input file, where the
+        parsing has stopped. */
+    std::size_t _stopOffset;
+
+    /** Number of characters read, as reported by Spirit. */
+    std::size_t _nbOfReadCharacters;
+
+    /** Whether the demand input file has been fully read. */
+    bool _hasBeenFullyRead;
+
+    /** Pointer on the SEvMgr service handler. */
+    SEVMGR::SEVMGR_ServicePtr_T _sevmgrServicePtr;
+
+    /** Shared uniform generator. */
+    stdair::RandomGeneration& _uniformGenerator;
+
+    /** Default POS distribution. */
+    const POSProbabilityMass_T& _posProbabilityMass;
+
+    /** Compiled demand model to be filled, if any. */
+    CompiledDemandModel* _compiledDemandModel;
+
+    /** Demand Structure. */
+    DemandStruct _demand;
+  };
+
+}
+#endif // __TRADEMGEN_CMD_MAPPEDDEMANDFILEPARSER_HPP
@@ -0,0 +1,299 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <cstring>
+// StdAir
+#include <stdair/bom/BookingRequestStruct.hpp>
+// TraDemGen
+#include <trademgen/TRADEMGEN_Exceptions.hpp>
+#include <trademgen/command/RequestCsvWriter.hpp>
+
+namespace TRADEMGEN {
+
+  /** Names of the fields, as written in the header row. */
+  static const char K_CSV_REQUEST_HEADER[] =
+    "run,request_date_time,origin,destination,pos,preferred_departure_date,"
+    "preferred_departure_time,preferred_cabin,party_size,channel,trip_type,"
+    "stay_duration,frequent_flyer,wtp,value_of_time,change_fees,"
+    "change_fee_disutility,non_refundable,non_refundable_disutility\n";
+
+  // //////////////////////////////////////////////////////////////////////
+  RequestCsvWriter::RequestCsvWriter (const stdair::Filename_T& iFilename,
+                                      const std::size_t iBlockSize,
+                                      const unsigned short iNbOfBlocks)
+    : _blockWriter (iFilename,
+                    (iBlockSize < MAX_CSV_REQUEST_ROW_FIXED_SIZE)
+                    ? MAX_CSV_REQUEST_ROW_FIXED_SIZE : iBlockSize,
+                    iNbOfBlocks),
+      _block (NULL), _blockSize (0), _blockFilling (0), _runFieldSize (0),
+      _dateCache (MAX_CSV_DATE_CACHE_SIZE * CharConv::DATE_SIZE),
+      _isDateCached (MAX_CSV_DATE_CACHE_SIZE, 0), _isDateCacheCentered (false),
+      _dateCacheOriginDayNumber (0), _nbOfWrittenRequests (0),
+      _isClosed (false) {
+
+    // Note: a block is at least able to hold a row
+    _block = _blockWriter.getBlock();
+    _blockSize = _blockWriter.getBlockSize();
+
+    //
+    setRunNumber (1);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  RequestCsvWriter::~RequestCsvWriter() {
+    if (_isClosed == true) {
+      return;
+    }
+
+    // Best effort: a destructor must not throw
+    try {
+      close();
+
+    } catch (const RequestOutputException&) {
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void RequestCsvWriter::setRunNumber (const unsigned int iRunNumber) {
+    char* lEnd = CharConv::formatUnsigned (_runField, iRunNumber);
+    *lEnd++ = ',';
+    _runFieldSize = lEnd - _runField;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  char* RequestCsvWriter::reserve (const std::size_t iSize) {
+    if (_blockFilling + iSize > _blockSize) {
+      writeBlock();
+
+      // A single row may exceed the block size, when some of the textual
+      // fields are very long
+      if (iSize > _blockSize) {
+        _block = _blockWriter.enlargeBlock (iSize);
+        _blockSize = _blockWriter.getBlockSize();
+      }
+    }
+    return _block + _blockFilling;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  char* RequestCsvWriter::appendField (char* ioPtr, const std::string& iStr) {
+    const std::size_t lSize = iStr.size();
+    std::memcpy (ioPtr, iStr.data(), lSize);
+    ioPtr[lSize] = ',';
+    return ioPtr + lSize + 1;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void RequestCsvWriter::centerDateCache (const stdair::Date_T& iDate) {
+    _dateCacheOrigin = iDate - boost::gregorian::days (MAX_CSV_DATE_CACHE_SIZE / 2);
+    _dateCacheOriginDayNumber = static_cast<long> (_dateCacheOrigin.day_number());
+    _dateCacheOriginDateTime = stdair::DateTime_T (_dateCacheOrigin);
+    _isDateCacheCentered = true;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  char* RequestCsvWriter::appendCachedDate (char* ioPtr, const long iIndex) {
+    // Sanity check
+    assert (iIndex >= 0 && iIndex < static_cast<long> (MAX_CSV_DATE_CACHE_SIZE));
+
+    char* lCachedDate = &_dateCache[iIndex * CharConv::DATE_SIZE];
+    if (_isDateCached[iIndex] == 0) {
+      const stdair::Date_T lDate =
+        _dateCacheOrigin + boost::gregorian::days (iIndex);
+      CharConv::formatDate (lCachedDate, lDate);
+      _isDateCached[iIndex] = 1;
+    }
+    std::memcpy (ioPtr, lCachedDate, CharConv::DATE_SIZE);
+    return ioPtr + CharConv::DATE_SIZE;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  char* RequestCsvWriter::appendDate (char* ioPtr, const stdair::Date_T& iDate) {
+    // Special dates (e.g., not-a-date-time) are not cached
+    if (iDate.is_special() == true) {
+      return CharConv::formatDate (ioPtr, iDate);
+    }
+
+    // The cache is centered on the very first date to be written
+    if (_isDateCacheCentered == false) {
+      centerDateCache (iDate);
+    }
+
+    // Dates too far away from the origin of the cache are not cached
+    const long lIndex =
+      static_cast<long> (iDate.day_number()) - _dateCacheOriginDayNumber;
+    if (lIndex < 0 || lIndex >= static_cast<long> (MAX_CSV_DATE_CACHE_SIZE)) {
+      return CharConv::formatDate (ioPtr, iDate);
+    }
+    return appendCachedDate (ioPtr, lIndex);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  char* RequestCsvWriter::appendDateTime (char* ioPtr,
+                                          const stdair::DateTime_T& iDateTime) {
+    // Special date-times (e.g., not-a-date-time) are not cached
+    if (iDateTime.is_special() == true) {
+      const std::string lDateTimeStr =
+        boost::posix_time::to_simple_string (iDateTime);
+      std::memcpy (ioPtr, lDateTimeStr.c_str(), lDateTimeStr.size());
+      return ioPtr + lDateTimeStr.size();
+    }
+
+    // The cache is centered on the very first date to be written
+    if (_isDateCacheCentered == false) {
+      centerDateCache (iDateTime.date());
+    }
+
+    /**
+     * Both the date and the time of the day are derived from the
+     * distance to the origin of the cache, which is much cheaper
+     * than extracting the date from the date-time (as the latter
+     * involves a round trip through the year/month/day representation).
+     */
+    const long long lNbOfMillisecondsInOneDay = 86400000LL;
+    const long long lNbOfMilliseconds =
+      (iDateTime - _dateCacheOriginDateTime).total_milliseconds();
+    long long lIndex = lNbOfMilliseconds / lNbOfMillisecondsInOneDay;
+    if (lNbOfMilliseconds < 0
+        && lIndex * lNbOfMillisecondsInOneDay != lNbOfMilliseconds) {
+      --lIndex;
+    }
+    const long long lTimeOfDay =
+      lNbOfMilliseconds - lIndex * lNbOfMillisecondsInOneDay;
+
+    // Dates too far away from the origin of the cache are not cached
+    if (lIndex < 0 || lIndex >= static_cast<long long> (MAX_CSV_DATE_CACHE_SIZE)) {
+      ioPtr = CharConv::formatDate (ioPtr, iDateTime.date());
+    } else {
+      ioPtr = appendCachedDate (ioPtr, static_cast<long> (lIndex));
+    }
+    *ioPtr++ = ' ';
+    return CharConv::formatTime (ioPtr, lTimeOfDay, true);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void RequestCsvWriter::writeHeader() {
+    const std::size_t lSize = sizeof (K_CSV_REQUEST_HEADER) - 1;
+    char* lPtr = reserve (lSize);
+    std::memcpy (lPtr, K_CSV_REQUEST_HEADER, lSize);
+    _blockFilling += lSize;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void RequestCsvWriter::write (const stdair::BookingRequestStruct& iRequest) {
+    // Sanity check
+    assert (_isClosed == false);
+
+    //
+    const stdair::AirportCode_T& lOrigin = iRequest.getOrigin();
+    const stdair::AirportCode_T& lDestination = iRequest.getDestination();
+    const stdair::CityCode_T& lPOS = iRequest.getPOS();
+    const stdair::CabinCode_T& lCabin = iRequest.getPreferredCabin();
+    const stdair::ChannelLabel_T& lChannel = iRequest.getBookingChannel();
+    const stdair::TripType_T& lTripType = iRequest.getTripType();
+    const stdair::FrequentFlyer_T& lFrequentFlyer =
+      iRequest.getFrequentFlyerType();
+
+    // Upper bound of the size of the row
+    const std::size_t lMaxRowSize = MAX_CSV_REQUEST_ROW_FIXED_SIZE
+      + lOrigin.size() + lDestination.size() + lPOS.size() + lCabin.size()
+      + lChannel.size() + lTripType.size() + lFrequentFlyer.size();
+    char* const lRowStart = reserve (lMaxRowSize);
+    char* lPtr = lRowStart;
+
+    // Run
+    std::memcpy (lPtr, _runField, _runFieldSize);
+    lPtr += _runFieldSize;
+
+    // Request date-time
+    lPtr = appendDateTime (lPtr, iRequest.getRequestDateTime());
+    *lPtr++ = ',';
+
+    // Origin, destination and POS
+    lPtr = appendField (lPtr, lOrigin);
+    lPtr = appendField (lPtr, lDestination);
+    lPtr = appendField (lPtr, lPOS);
+
+    // Preferred departure date and time
+    lPtr = appendDate (lPtr, iRequest.getPreferedDepartureDate());
+    *lPtr++ = ',';
+    lPtr = CharConv::formatTime (lPtr, iRequest.getPreferredDepartureTime(),
+                                 false);
+    *lPtr++ = ',';
+
+    // Preferred cabin and party size
+    lPtr = appendField (lPtr, lCabin);
+    lPtr = CharConv::formatFixed<0> (lPtr, iRequest.getPartySize());
+    *lPtr++ = ',';
+
+    // Channel, trip type, stay duration and frequent flyer type
+    lPtr = appendField (lPtr, lChannel);
+    lPtr = appendField (lPtr, lTripType);
+    lPtr = CharConv::formatSigned (lPtr, iRequest.getStayDuration());
+    *lPtr++ = ',';
+    lPtr = appendField (lPtr, lFrequentFlyer);
+
+    // WTP and value of time
+    lPtr = CharConv::formatFixed<2> (lPtr, iRequest.getWTP());
+    *lPtr++ = ',';
+    lPtr = CharConv::formatFixed<2> (lPtr, iRequest.getValueOfTime());
+    *lPtr++ = ',';
+
+    // Change fees and non refundable, along with their disutilities
+    *lPtr++ = (iRequest.getChangeFees() == true)?'1':'0';
+    *lPtr++ = ',';
+    lPtr = CharConv::formatFixed<2> (lPtr, iRequest.getChangeFeeDisutility());
+    *lPtr++ = ',';
+    *lPtr++ = (iRequest.getNonRefundable() == true)?'1':'0';
+    *lPtr++ = ',';
+    lPtr = CharConv::formatFixed<2> (lPtr,
+                                     iRequest.getNonRefundableDisutility());
+    *lPtr++ = '\n';
+
+    // Sanity check
+    assert (static_cast<std::size_t> (lPtr - lRowStart) <= lMaxRowSize);
+
+    _blockFilling += lPtr - lRowStart;
+    ++_nbOfWrittenRequests;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void RequestCsvWriter::writeBlock() {
+    // Sanity check
+    assert (_isClosed == false);
+
+    // In the asynchronous mode, another block is handed over, while the
+    // filled one is being written
+    _block = _blockWriter.submitBlock (_blockFilling);
+    _blockSize = _blockWriter.getBlockSize();
+    _blockFilling = 0;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void RequestCsvWriter::flush() {
+    writeBlock();
+    _blockWriter.flush();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void RequestCsvWriter::close() {
+    if (_isClosed == true) {
+      return;
+    }
+    _isClosed = true;
+
+    // The file is closed, even when the last block cannot be written
+    try {
+      _block = _blockWriter.submitBlock (_blockFilling);
+      _blockFilling = 0;
+
+    } catch (const RequestOutputException&) {
+      _blockWriter.close();
+      throw;
+    }
+    _blockWriter.close();
+  }
+
+}
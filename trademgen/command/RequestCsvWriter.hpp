@@ -0,0 +1,207 @@
+#ifndef __TRADEMGEN_CMD_REQUESTCSVWRITER_HPP
+#define __TRADEMGEN_CMD_REQUESTCSVWRITER_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <string>
+#include <vector>
+// StdAir
+#include <stdair/stdair_basic_types.hpp>
+#include <stdair/stdair_date_time_types.hpp>
+// TraDemGen
+#include <trademgen/RequestSink.hpp>
+#include <trademgen/basic/BasConst_RequestOutput.hpp>
+#include <trademgen/basic/CharConv.hpp>
+#include <trademgen/command/BlockFileWriter.hpp>
+
+namespace TRADEMGEN {
+
+  /**
+   * @brief Sink dumping the booking requests into a CSV file.
+   *
+   * Every request is formatted, field by field, directly into an
+   * in-memory block, which is re-used all along the generation. Only
+   * when that block is full is it written into the file, with a single
+   * (large) write system call. With two blocks or more, the writing is
+   * delegated to a dedicated I/O thread (see BlockFileWriter), so that
+   * the generation does not wait for the disk.
+   *
+   * The dates (request and preferred departure dates) are formatted
+   * once for all and cached, as a lot of requests share the same dates.
+   *
+   * Each row is made of the following fields:
+   * run, request date-time, origin, destination, POS, preferred
+   * departure date, preferred departure time, preferred cabin, party
+   * size, channel, trip type, stay duration, frequent flyer type, WTP,
+   * value of time, change fees, change fee disutility, non refundable
+   * and non refundable disutility.
+   */
+  class RequestCsvWriter : public RequestSink {
+  public:
+    // ////////// Constructors and destructors /////////
+    /**
+     * Constructor. The output file is created (or truncated).
+     *
+     * @param const stdair::Filename_T& Path of the output CSV file.
+     * @param const std::size_t Size (in bytes) of the blocks written
+     *        into the file.
+     * @param const unsigned short Number of blocks. With a single block,
+     *        the writing is synchronous.
+     */
+    RequestCsvWriter (const stdair::Filename_T&,
+                      const std::size_t iBlockSize =
+                      DEFAULT_REQUEST_OUTPUT_BLOCK_SIZE,
+                      const unsigned short iNbOfBlocks =
+                      DEFAULT_REQUEST_OUTPUT_NB_OF_BLOCKS);
+
+    /**
+     * Destructor. Whatever remains in the block is written into the file
+     * (errors being ignored).
+     */
+    ~RequestCsvWriter();
+
+
+  public:
+    // ////////// Getters /////////
+    /** Get the number of requests written so far. */
+    const std::size_t& getNbOfWrittenRequests() const {
+      return _nbOfWrittenRequests;
+    }
+
+
+  public:
+    // ////////// Setters /////////
+    /**
+     * Set the run number, reported as the first field of every
+     * subsequent row.
+     */
+    void setRunNumber (const unsigned int);
+
+
+  public:
+    // ////////// Business methods /////////
+    /**
+     * Write the header row, i.e., the names of the fields.
+     */
+    void writeHeader();
+
+    /**
+     * Format the given booking request as a CSV row.
+     */
+    void write (const stdair::BookingRequestStruct&);
+
+    /**
+     * Write into the file whatever has been formatted so far, and wait
+     * until it has actually been written.
+     */
+    void flush();
+
+    /**
+     * Flush and close the output file. No more request can be written
+     * afterwards.
+     */
+    void close();
+
+
+  private:
+    // ////////// Helpers /////////
+    /**
+     * Make room, within the block, for at least the given number of
+     * characters, and return the position where to write them.
+     */
+    char* reserve (const std::size_t);
+
+    /**
+     * Write the given string, followed by the field separator.
+     */
+    static char* appendField (char* ioPtr, const std::string&);
+
+    /**
+     * Write the given date, thanks to the cache of pre-formatted dates.
+     */
+    char* appendDate (char* ioPtr, const stdair::Date_T&);
+
+    /**
+     * Write the given date-time (with a millisecond precision), thanks
+     * to the cache of pre-formatted dates.
+     */
+    char* appendDateTime (char* ioPtr, const stdair::DateTime_T&);
+
+    /**
+     * Write the pre-formatted date, corresponding to the given position
+     * within the cache. The date is formatted first, if needed.
+     */
+    char* appendCachedDate (char* ioPtr, const long iIndex);
+
+    /**
+     * Center the cache of pre-formatted dates on the given date.
+     */
+    void centerDateCache (const stdair::Date_T&);
+
+    /**
+     * Hand over the block to the block writer, and get a new one to be
+     * filled.
+     */
+    void writeBlock();
+
+
+  private:
+    // ////////// Constructors and destructors /////////
+    /** Default constructor (not to be used). */
+    RequestCsvWriter();
+    /** Copy constructor (not to be used). */
+    RequestCsvWriter (const RequestCsvWriter&);
+
+
+  private:
+    // ////////// Attributes /////////
+    /**
+     * Writer of the blocks into the output file.
+     */
+    BlockFileWriter _blockWriter;
+
+    /**
+     * Block in which the rows are formatted (owned by the block writer).
+     */
+    char* _block;
+    std::size_t _blockSize;
+
+    /**
+     * Number of characters formatted so far within the block.
+     */
+    std::size_t _blockFilling;
+
+    /**
+     * Run number, already formatted, followed by the field separator.
+     */
+    char _runField[CharConv::MAX_UNSIGNED_SIZE + 1];
+    std::size_t _runFieldSize;
+
+    /**
+     * Cache of pre-formatted dates (CharConv::DATE_SIZE characters per
+     * date), indexed by the distance (in days) to a reference date,
+     * namely the origin of the cache. That origin is known only when
+     * the first date is written.
+     */
+    std::vector<char> _dateCache;
+    std::vector<char> _isDateCached;
+    bool _isDateCacheCentered;
+    stdair::Date_T _dateCacheOrigin;
+    long _dateCacheOriginDayNumber;
+    stdair::DateTime_T _dateCacheOriginDateTime;
+
+    /**
+     * Number of requests written so far.
+     */
+    std::size_t _nbOfWrittenRequests;
+
+    /**
+     * Whether the output file has been closed.
+     */
+    bool _isClosed;
+  };
+
+}
+#endif // __TRADEMGEN_CMD_REQUESTCSVWRITER_HPP
@@ -0,0 +1,123 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+// Boost
+#include <boost/make_shared.hpp>
+// StdAir
+#include <stdair/bom/BookingRequestStruct.hpp>
+// TraDemGen
+#include <trademgen/TRADEMGEN_Exceptions.hpp>
+#include <trademgen/command/RequestPipeline.hpp>
+
+namespace TRADEMGEN {
+
+  namespace {
+
+    /**
+     * Raised within the generation when the pipeline has been stopped,
+     * so as to unwind it.
+     */
+    struct PipelineStopped {
+    };
+
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  RequestPipeline::RequestPipeline (const std::size_t iLookaheadDepth)
+    : _ring (iLookaheadDepth) {
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  RequestPipeline::~RequestPipeline() {
+    stop();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void RequestPipeline::start (const GenerationTask_T& iGenerationTask) {
+    if (_thread.joinable() == true || _ring.isClosed() == true) {
+      throw RequestPipelineException ("The demand generation of the "
+                                      "pipeline has already been started");
+    }
+    _thread = std::thread (&RequestPipeline::run, this, iGenerationTask);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void RequestPipeline::run (const GenerationTask_T iGenerationTask) {
+    try {
+      iGenerationTask (*this);
+
+    } catch (const PipelineStopped&) {
+      // The consumer does not want any more booking request
+
+    } catch (...) {
+      _exception = std::current_exception();
+    }
+
+    // The consumer gets the booking requests pushed so far, and then
+    // the exception, if any
+    _ring.close();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void RequestPipeline::write (const stdair::BookingRequestStruct& iRequest) {
+    // The booking request structure is only valid for the duration of
+    // the call
+    const stdair::BookingRequestPtr_T lBookingRequest_ptr =
+      boost::make_shared<stdair::BookingRequestStruct> (iRequest);
+    if (_ring.push (lBookingRequest_ptr) == false) {
+      throw PipelineStopped();
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool RequestPipeline::pop (stdair::BookingRequestPtr_T& oBookingRequest_ptr) {
+    if (_ring.pop (oBookingRequest_ptr) == true) {
+      return true;
+    }
+    finish();
+    return false;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool RequestPipeline::
+  tryPop (stdair::BookingRequestPtr_T& oBookingRequest_ptr) {
+    if (_ring.tryPop (oBookingRequest_ptr) == true) {
+      return true;
+    }
+    if (isDone() == true) {
+      finish();
+    }
+    return false;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void RequestPipeline::finish() {
+    if (_thread.joinable() == true) {
+      _thread.join();
+    }
+
+    // The exception is re-thrown only once
+    if (_exception != NULL) {
+      std::exception_ptr lException = _exception;
+      _exception = NULL;
+      std::rethrow_exception (lException);
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void RequestPipeline::stop() {
+    _ring.close();
+    if (_thread.joinable() == true) {
+      _thread.join();
+    }
+    _exception = NULL;
+
+    // Release the booking requests not popped yet
+    stdair::BookingRequestPtr_T lBookingRequest_ptr;
+    while (_ring.tryPop (lBookingRequest_ptr) == true) {
+    }
+  }
+
+}
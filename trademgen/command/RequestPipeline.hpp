@@ -0,0 +1,169 @@
+#ifndef __TRADEMGEN_CMD_REQUESTPIPELINE_HPP
+#define __TRADEMGEN_CMD_REQUESTPIPELINE_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <exception>
+#include <functional>
+#include <thread>
+// StdAir
+#include <stdair/stdair_basic_types.hpp>
+#include <stdair/bom/BookingRequestTypes.hpp>
+// TraDemGen
+#include <trademgen/RequestSink.hpp>
+#include <trademgen/basic/BasConst_RequestOutput.hpp>
+#include <trademgen/basic/SPSCRing.hpp>
+
+namespace TRADEMGEN {
+
+  /**
+   * @brief Pipeline between a demand generation running on a background
+   *        thread and the consumer of its booking requests.
+   *
+   * The background thread generates the booking requests and pushes
+   * them into a bounded single-producer/single-consumer ring (see
+   * SPSCRing), from which the consumer (e.g., the simulator) pops them,
+   * in the order of the generation, on its own thread. The generation
+   * may thus run ahead of the consumer, by at most the lookahead depth
+   * (i.e., the capacity of the ring), the sampling of the requests
+   * overlapping the consumer's own work.
+   *
+   * An exception raised by the generation is re-thrown to the consumer,
+   * once the booking requests generated before have been popped.
+   */
+  class RequestPipeline : public RequestSink {
+  public:
+    // ////////// Type definitions /////////
+    /**
+     * Demand generation, to be run on the background thread, handing
+     * over the booking requests to the given sink.
+     */
+    typedef std::function<void (RequestSink&)> GenerationTask_T;
+
+
+  public:
+    // ////////// Constructors and destructors /////////
+    /**
+     * Constructor.
+     *
+     * @param const std::size_t Lookahead depth, i.e., maximal number of
+     *        booking requests generated but not popped yet (rounded up
+     *        to a power of two).
+     */
+    explicit RequestPipeline (const std::size_t iLookaheadDepth =
+                              DEFAULT_REQUEST_PIPELINE_DEPTH);
+
+    /**
+     * Destructor. The generation, if still running, is stopped (see
+     * stop()).
+     */
+    ~RequestPipeline();
+
+
+  public:
+    // ////////// Getters /////////
+    /** Get the lookahead depth. */
+    std::size_t getLookaheadDepth() const {
+      return _ring.getCapacity();
+    }
+
+    /**
+     * State whether the generation is over, and all its booking requests
+     * have been popped.
+     */
+    bool isDone() const {
+      return (_ring.isClosed() == true && _ring.getSize() == 0);
+    }
+
+
+  public:
+    // ////////// Business methods /////////
+    /**
+     * Run the given demand generation on the background thread. A
+     * pipeline runs a single demand generation.
+     *
+     * @param const GenerationTask_T& Demand generation.
+     * @throw RequestPipelineException when a generation has already
+     *        been started.
+     */
+    void start (const GenerationTask_T&);
+
+    /**
+     * Pop the next booking request, waiting for it to be generated.
+     *
+     * @param stdair::BookingRequestPtr_T& Popped booking request.
+     * @return bool Whether a booking request has been popped, i.e., the
+     *         generation is not over.
+     */
+    bool pop (stdair::BookingRequestPtr_T&);
+
+    /**
+     * Pop the next booking request, when it has already been generated.
+     *
+     * @param stdair::BookingRequestPtr_T& Popped booking request.
+     * @return bool Whether a booking request has been popped. When not,
+     *         isDone() tells whether the generation is over.
+     */
+    bool tryPop (stdair::BookingRequestPtr_T&);
+
+    /**
+     * Stop the generation (when still running), and wait for the
+     * background thread to be over. The booking requests not popped
+     * yet are discarded.
+     *
+     * \note The demand generation is then left in the middle of the
+     *       run: it is to be reset before being used again.
+     */
+    void stop();
+
+    /**
+     * Push the given booking request into the ring, waiting for a free
+     * slot (called by the generation, on the background thread).
+     */
+    void write (const stdair::BookingRequestStruct&);
+
+
+  private:
+    // ////////// Helpers /////////
+    /**
+     * Main function of the background thread.
+     */
+    void run (const GenerationTask_T);
+
+    /**
+     * Once the ring is empty and closed, wait for the background thread
+     * to be over, and re-throw the exception raised by the generation,
+     * if any.
+     */
+    void finish();
+
+
+  private:
+    // ////////// Constructors and destructors /////////
+    /** Copy constructor (not to be used). */
+    RequestPipeline (const RequestPipeline&);
+
+
+  private:
+    // ////////// Attributes /////////
+    /**
+     * Ring of the booking requests generated but not popped yet.
+     */
+    SPSCRing<stdair::BookingRequestPtr_T> _ring;
+
+    /**
+     * Exception raised by the generation, if any (written by the
+     * background thread before the ring is closed).
+     */
+    std::exception_ptr _exception;
+
+    /**
+     * Background thread.
+     */
+    std::thread _thread;
+  };
+
+}
+#endif // __TRADEMGEN_CMD_REQUESTPIPELINE_HPP
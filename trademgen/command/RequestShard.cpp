@@ -0,0 +1,45 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+// TraDemGen
+#include <trademgen/command/RequestShard.hpp>
+
+namespace TRADEMGEN {
+
+  namespace {
+
+    /** Offset basis of the 64-bit FNV-1a hash. */
+    const boost::uint64_t K_FNV_OFFSET_BASIS = 14695981039346656037ULL;
+
+    /** Prime of the 64-bit FNV-1a hash. */
+    const boost::uint64_t K_FNV_PRIME = 1099511628211ULL;
+
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  unsigned short RequestShard::
+  getShardIndex (const std::string& iDemandStreamKey,
+                 const unsigned short iNbOfShards) {
+    assert (iNbOfShards != 0);
+
+    boost::uint64_t lHash = K_FNV_OFFSET_BASIS;
+    for (std::string::const_iterator itChar = iDemandStreamKey.begin();
+         itChar != iDemandStreamKey.end(); ++itChar) {
+      lHash ^= static_cast<unsigned char> (*itChar);
+      lHash *= K_FNV_PRIME;
+    }
+    return static_cast<unsigned short> (lHash % iNbOfShards);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool RequestShard::isBefore (const SharedRequestRecord& iRecord,
+                               const SharedRequestRecord& iOtherRecord) {
+    if (iRecord._runNumber != iOtherRecord._runNumber) {
+      return (iRecord._runNumber < iOtherRecord._runNumber);
+    }
+    return (iRecord._requestDateTime < iOtherRecord._requestDateTime);
+  }
+
+}
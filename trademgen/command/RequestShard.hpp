@@ -0,0 +1,79 @@
+#ifndef __TRADEMGEN_CMD_REQUESTSHARD_HPP
+#define __TRADEMGEN_CMD_REQUESTSHARD_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <string>
+// Boost
+#include <boost/cstdint.hpp>
+// TraDemGen
+#include <trademgen/basic/BasConst_RequestShard.hpp>
+#include <trademgen/command/SharedRequestRing.hpp>
+
+namespace TRADEMGEN {
+
+  /**
+   * @brief Layout of, and helpers shared by the writer and the readers
+   *        of, the request shard files (see RequestShardWriter and
+   *        RequestShardReader).
+   *
+   * When the demand generation is sharded (see
+   * TRADEMGEN_Service::shardDemand()), every process generates the
+   * booking requests of the demand streams of its own shard, and writes
+   * them, in time order, into a request shard file. That file is made
+   * of a header, of the request records (see SharedRequestRecord) and,
+   * once the file has been closed, of a trailer, which tells that the
+   * file is complete. The request shard files of all the shards are
+   * then merged into a single time-ordered stream (see
+   * RequestShardMerger).
+   */
+  class RequestShard {
+  public:
+    // ////////// Type definitions /////////
+    /** Header of the request shard files. */
+    struct Header {
+      char _magic[REQUEST_SHARD_MAGIC_SIZE];
+      boost::uint32_t _version;
+      boost::uint32_t _byteOrderMark;
+      boost::uint32_t _recordSize;
+      boost::uint32_t _shardIndex;
+      boost::uint32_t _nbOfShards;
+      boost::uint32_t _reserved;
+    };
+
+    /** Trailer of the (complete) request shard files. */
+    struct Trailer {
+      char _magic[REQUEST_SHARD_MAGIC_SIZE];
+      boost::uint64_t _nbOfRecords;
+    };
+
+
+  public:
+    // ////////// Business methods /////////
+    /**
+     * Get the shard of the demand stream having the given key. The key
+     * is hashed (FNV-1a), so that the shard does not depend on the
+     * platform, nor on the order in which the demand streams have been
+     * loaded.
+     *
+     * @param const std::string& Key of the demand stream (see
+     *        DemandStreamKey::toString()).
+     * @param const unsigned short Number of shards (at least 1).
+     * @return unsigned short Index of the shard (from 0).
+     */
+    static unsigned short getShardIndex (const std::string& iDemandStreamKey,
+                                         const unsigned short iNbOfShards);
+
+    /**
+     * State whether the first record comes before the second one, i.e.,
+     * belongs to an earlier run, or to the same run with an earlier
+     * request date-time.
+     */
+    static bool isBefore (const SharedRequestRecord&,
+                          const SharedRequestRecord&);
+  };
+
+}
+#endif // __TRADEMGEN_CMD_REQUESTSHARD_HPP
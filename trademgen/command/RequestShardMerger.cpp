@@ -0,0 +1,156 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <queue>
+#include <sstream>
+// Boost
+#include <boost/shared_ptr.hpp>
+// StdAir
+#include <stdair/bom/BookingRequestStruct.hpp>
+#include <stdair/service/Logger.hpp>
+// TraDemGen
+#include <trademgen/TRADEMGEN_Exceptions.hpp>
+#include <trademgen/RequestSink.hpp>
+#include <trademgen/command/RequestShard.hpp>
+#include <trademgen/command/RequestShardReader.hpp>
+#include <trademgen/command/RequestShardMerger.hpp>
+
+namespace TRADEMGEN {
+
+  namespace {
+
+    /** Pointer on a reader of request shard file. */
+    typedef boost::shared_ptr<RequestShardReader> RequestShardReaderPtr_T;
+
+    /**
+     * Next record of a request shard file, waiting to be merged.
+     */
+    struct PendingRecord {
+      SharedRequestRecord _record;
+      boost::uint32_t _shardIndex;
+      std::size_t _readerIdx;
+    };
+
+    /**
+     * Order of the pending records, the earliest one coming first out
+     * of the priority queue (which gives the greatest element first).
+     */
+    struct ComesAfter {
+      bool operator() (const PendingRecord& iRecord,
+                       const PendingRecord& iOtherRecord) const {
+        if (RequestShard::isBefore (iOtherRecord._record,
+                                    iRecord._record) == true) {
+          return true;
+        }
+        if (RequestShard::isBefore (iRecord._record,
+                                    iOtherRecord._record) == true) {
+          return false;
+        }
+        return (iRecord._shardIndex > iOtherRecord._shardIndex);
+      }
+    };
+
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  boost::uint64_t RequestShardMerger::
+  merge (const std::vector<stdair::Filename_T>& iFilenameList,
+         RequestSink& ioRequestSink) {
+
+    if (iFilenameList.empty() == true) {
+      throw RequestShardException ("No request shard file has been given");
+    }
+
+    // Open and check all the files, before merging anything
+    std::vector<RequestShardReaderPtr_T> lReaderList;
+    for (std::vector<stdair::Filename_T>::const_iterator itFilename =
+           iFilenameList.begin(); itFilename != iFilenameList.end();
+         ++itFilename) {
+      lReaderList.push_back (RequestShardReaderPtr_T (new RequestShardReader
+                                                      (*itFilename)));
+    }
+
+    // The files must be the shards of a single sharded generation, each
+    // shard being given exactly once
+    const boost::uint32_t lNbOfShards = lReaderList.front()->getNbOfShards();
+    std::vector<stdair::Filename_T> lShardFilenameList (lNbOfShards);
+    for (std::vector<RequestShardReaderPtr_T>::const_iterator itReader =
+           lReaderList.begin(); itReader != lReaderList.end(); ++itReader) {
+      const RequestShardReader& lReader = **itReader;
+      std::ostringstream oMessage;
+      if (lReader.getNbOfShards() != lNbOfShards) {
+        oMessage << "The request shard file '" << lReader.getFilename()
+                 << "' belongs to a generation with "
+                 << lReader.getNbOfShards() << " shards, whereas '"
+                 << lReaderList.front()->getFilename() << "' belongs to one "
+                 << "with " << lNbOfShards << " shards";
+
+      } else if (lShardFilenameList[lReader.getShardIndex()].empty() == false) {
+        oMessage << "The shard #" << lReader.getShardIndex() << " is given "
+                 << "twice, by '" << lShardFilenameList[lReader.getShardIndex()]
+                 << "' and by '" << lReader.getFilename() << "'";
+      }
+      if (oMessage.str().empty() == false) {
+        STDAIR_LOG_ERROR (oMessage.str());
+        throw RequestShardException (oMessage.str());
+      }
+      lShardFilenameList[lReader.getShardIndex()] = lReader.getFilename();
+    }
+    if (lReaderList.size() != lNbOfShards) {
+      std::ostringstream oMessage;
+      oMessage << "Only " << lReaderList.size() << " request shard file(s) "
+               << "out of " << lNbOfShards << " have been given (missing "
+               << "shard(s):";
+      for (boost::uint32_t lShardIdx = 0; lShardIdx != lNbOfShards;
+           ++lShardIdx) {
+        if (lShardFilenameList[lShardIdx].empty() == true) {
+          oMessage << " #" << lShardIdx;
+        }
+      }
+      oMessage << ")";
+      STDAIR_LOG_ERROR (oMessage.str());
+      throw RequestShardException (oMessage.str());
+    }
+
+    // K-way merge
+    std::priority_queue<PendingRecord, std::vector<PendingRecord>,
+                        ComesAfter> lPendingRecordQueue;
+    for (std::size_t idx = 0; idx != lReaderList.size(); ++idx) {
+      PendingRecord lPendingRecord;
+      lPendingRecord._shardIndex = lReaderList[idx]->getShardIndex();
+      lPendingRecord._readerIdx = idx;
+      if (lReaderList[idx]->read (lPendingRecord._record) == true) {
+        lPendingRecordQueue.push (lPendingRecord);
+      }
+    }
+
+    boost::uint64_t oNbOfMergedRequests = 0;
+    boost::uint32_t lRunNumber = 0;
+    while (lPendingRecordQueue.empty() == false) {
+      PendingRecord lPendingRecord = lPendingRecordQueue.top();
+      lPendingRecordQueue.pop();
+
+      // Tell the sink when a new run starts
+      if (lPendingRecord._record._runNumber != lRunNumber) {
+        lRunNumber = lPendingRecord._record._runNumber;
+        ioRequestSink.setRunNumber (lRunNumber);
+      }
+      ioRequestSink.write (*SharedRequestRing::decode (lPendingRecord._record));
+      ++oNbOfMergedRequests;
+
+      // Replace the merged record by the next one of the same shard
+      RequestShardReader& lReader = *lReaderList[lPendingRecord._readerIdx];
+      if (lReader.read (lPendingRecord._record) == true) {
+        lPendingRecordQueue.push (lPendingRecord);
+      }
+    }
+    ioRequestSink.flush();
+
+    STDAIR_LOG_DEBUG ("Merged " << oNbOfMergedRequests << " booking requests "
+                      << "out of " << lNbOfShards << " request shard files");
+    return oNbOfMergedRequests;
+  }
+
+}
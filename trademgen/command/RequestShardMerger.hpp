@@ -0,0 +1,58 @@
+#ifndef __TRADEMGEN_CMD_REQUESTSHARDMERGER_HPP
+#define __TRADEMGEN_CMD_REQUESTSHARDMERGER_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <vector>
+// Boost
+#include <boost/cstdint.hpp>
+// StdAir
+#include <stdair/stdair_basic_types.hpp>
+
+namespace TRADEMGEN {
+
+  // Forward declarations
+  class RequestSink;
+
+  /**
+   * @brief Merger of the request shard files of a sharded generation
+   *        (see TRADEMGEN_Service::shardDemand()) into a single
+   *        time-ordered stream of booking requests.
+   *
+   * As every request shard file is in time order, the files are merged
+   * on the fly (k-way merge), by run and then by request date-time. The
+   * ties are broken by the index of the shard, so that the merge does
+   * not depend on the order in which the files are given. The order of
+   * the booking requests of every shard is kept.
+   */
+  class RequestShardMerger {
+  public:
+    // ////////// Business methods /////////
+    /**
+     * Merge the given request shard files, handing over the booking
+     * requests to the given sink.
+     *
+     * @param const std::vector<stdair::Filename_T>& Paths of the request
+     *        shard files, one per shard (in any order).
+     * @param RequestSink& Sink receiving the booking requests.
+     * @return boost::uint64_t Number of merged booking requests.
+     * @throw RequestShardException when one of the files is not a
+     *        complete request shard file, or when the files are not the
+     *        shards of a single sharded generation (e.g., a shard is
+     *        missing, or given twice).
+     */
+    static boost::uint64_t merge (const std::vector<stdair::Filename_T>&,
+                                  RequestSink&);
+
+  private:
+    // ////////// Constructors and destructors /////////
+    /** Default constructor (not to be used). */
+    RequestShardMerger();
+    /** Copy constructor (not to be used). */
+    RequestShardMerger (const RequestShardMerger&);
+  };
+
+}
+#endif // __TRADEMGEN_CMD_REQUESTSHARDMERGER_HPP
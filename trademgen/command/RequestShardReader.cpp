@@ -0,0 +1,144 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <cstring>
+#include <sstream>
+// StdAir
+#include <stdair/service/Logger.hpp>
+// TraDemGen
+#include <trademgen/TRADEMGEN_Exceptions.hpp>
+#include <trademgen/command/RequestShard.hpp>
+#include <trademgen/command/RequestShardReader.hpp>
+
+namespace TRADEMGEN {
+
+  // //////////////////////////////////////////////////////////////////////
+  RequestShardReader::RequestShardReader (const stdair::Filename_T& iFilename,
+                                          const std::size_t iReadBlockSize)
+    : _filename (iFilename), _file (NULL), _shardIndex (0), _nbOfShards (0),
+      _nbOfRecords (0), _nbOfReadRecords (0),
+      _block ((iReadBlockSize == 0) ? 1 : iReadBlockSize), _blockFilling (0),
+      _blockPosition (0) {
+
+    _file = std::fopen (iFilename.c_str(), "rb");
+    if (_file == NULL) {
+      std::ostringstream oMessage;
+      oMessage << "The request shard file '" << iFilename
+               << "' cannot be opened for reading";
+      STDAIR_LOG_ERROR (oMessage.str());
+      throw RequestShardException (oMessage.str());
+    }
+
+    checkFile();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  RequestShardReader::~RequestShardReader() {
+    if (_file != NULL) {
+      std::fclose (_file);
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void RequestShardReader::fail (const std::string& iMessage) {
+    std::fclose (_file);
+    _file = NULL;
+    STDAIR_LOG_ERROR (iMessage);
+    throw RequestShardException (iMessage);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void RequestShardReader::checkFile() {
+    assert (_file != NULL);
+
+    // Header
+    RequestShard::Header lHeader;
+    if (std::fread (&lHeader, sizeof (lHeader), 1, _file) != 1) {
+      fail ("The request shard file '" + _filename + "' is truncated");
+    }
+    if (std::memcmp (lHeader._magic, REQUEST_SHARD_MAGIC,
+                     REQUEST_SHARD_MAGIC_SIZE) != 0) {
+      fail ("The file '" + _filename + "' is not a request shard file");
+    }
+    if (lHeader._byteOrderMark != REQUEST_SHARD_BYTE_ORDER_MARK) {
+      fail ("The request shard file '" + _filename
+            + "' has been written on a machine having another byte order");
+    }
+    if (lHeader._version != REQUEST_SHARD_VERSION
+        || lHeader._recordSize != sizeof (SharedRequestRecord)) {
+      std::ostringstream oMessage;
+      oMessage << "The request shard file '" << _filename
+               << "' has been written by another version of TraDemGen "
+               << "(format version " << lHeader._version << ", whereas "
+               << REQUEST_SHARD_VERSION << " is expected)";
+      fail (oMessage.str());
+    }
+    if (lHeader._shardIndex >= lHeader._nbOfShards) {
+      std::ostringstream oMessage;
+      oMessage << "The request shard file '" << _filename
+               << "' is corrupted (shard #" << lHeader._shardIndex
+               << " out of " << lHeader._nbOfShards << ")";
+      fail (oMessage.str());
+    }
+    _shardIndex = lHeader._shardIndex;
+    _nbOfShards = lHeader._nbOfShards;
+
+    // Trailer, which is written only once the file is complete
+    RequestShard::Trailer lTrailer;
+    if (std::fseek (_file, -static_cast<long> (sizeof (lTrailer)),
+                    SEEK_END) != 0
+        || std::fread (&lTrailer, sizeof (lTrailer), 1, _file) != 1
+        || std::memcmp (lTrailer._magic, REQUEST_SHARD_MAGIC,
+                        REQUEST_SHARD_MAGIC_SIZE) != 0) {
+      fail ("The request shard file '" + _filename + "' is truncated");
+    }
+
+    // The number of records must match the size of the file
+    const long lFileSize = std::ftell (_file);
+    const boost::uint64_t lRecordsSize =
+      static_cast<boost::uint64_t> (lFileSize) - sizeof (lHeader)
+      - sizeof (lTrailer);
+    if (lFileSize < 0
+        || lRecordsSize != lTrailer._nbOfRecords * sizeof (SharedRequestRecord)) {
+      fail ("The request shard file '" + _filename + "' is truncated");
+    }
+    _nbOfRecords = lTrailer._nbOfRecords;
+
+    // Back to the first record
+    if (std::fseek (_file, sizeof (lHeader), SEEK_SET) != 0) {
+      fail ("The request shard file '" + _filename + "' cannot be read");
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool RequestShardReader::read (SharedRequestRecord& oRecord) {
+    if (_nbOfReadRecords == _nbOfRecords) {
+      return false;
+    }
+
+    // Read the next block of records
+    if (_blockPosition == _blockFilling) {
+      assert (_file != NULL);
+
+      const boost::uint64_t lNbOfRemainingRecords =
+        _nbOfRecords - _nbOfReadRecords;
+      const std::size_t lNbOfRecordsToRead =
+        (lNbOfRemainingRecords < _block.size())
+        ? static_cast<std::size_t> (lNbOfRemainingRecords) : _block.size();
+      if (std::fread (&_block[0], sizeof (SharedRequestRecord),
+                      lNbOfRecordsToRead, _file) != lNbOfRecordsToRead) {
+        fail ("The request shard file '" + _filename + "' cannot be read");
+      }
+      _blockFilling = lNbOfRecordsToRead;
+      _blockPosition = 0;
+    }
+
+    oRecord = _block[_blockPosition];
+    ++_blockPosition;
+    ++_nbOfReadRecords;
+    return true;
+  }
+
+}
@@ -0,0 +1,145 @@
+#ifndef __TRADEMGEN_CMD_REQUESTSHARDREADER_HPP
+#define __TRADEMGEN_CMD_REQUESTSHARDREADER_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cstdio>
+#include <vector>
+// Boost
+#include <boost/cstdint.hpp>
+// StdAir
+#include <stdair/stdair_basic_types.hpp>
+// TraDemGen
+#include <trademgen/basic/BasConst_RequestShard.hpp>
+#include <trademgen/command/SharedRequestRing.hpp>
+
+namespace TRADEMGEN {
+
+  /**
+   * @brief Reader of the booking requests recorded into a request shard
+   *        file (see RequestShardWriter).
+   *
+   * The file is checked, as a whole, when it is opened: it must have
+   * been written by the same version of TraDemGen, on a machine having
+   * the same byte order, and it must be complete (i.e., have been
+   * closed by its writer). The records are then read by blocks.
+   */
+  class RequestShardReader {
+  public:
+    // ////////// Constructors and destructors /////////
+    /**
+     * Constructor. The request shard file is opened and checked.
+     *
+     * @param const stdair::Filename_T& Path of the request shard file.
+     * @param const std::size_t Number of records read at once.
+     * @throw RequestShardException when the file cannot be opened, or
+     *        is not a complete request shard file.
+     */
+    RequestShardReader (const stdair::Filename_T&,
+                        const std::size_t iReadBlockSize =
+                        REQUEST_SHARD_READ_BLOCK_SIZE);
+
+    /**
+     * Destructor. The file is closed.
+     */
+    ~RequestShardReader();
+
+
+  public:
+    // ////////// Getters /////////
+    /** Get the path of the request shard file. */
+    const stdair::Filename_T& getFilename() const {
+      return _filename;
+    }
+
+    /** Get the index of the shard (from 0). */
+    const boost::uint32_t& getShardIndex() const {
+      return _shardIndex;
+    }
+
+    /** Get the number of shards of the sharded generation. */
+    const boost::uint32_t& getNbOfShards() const {
+      return _nbOfShards;
+    }
+
+    /** Get the number of records held by the file. */
+    const boost::uint64_t& getNbOfRecords() const {
+      return _nbOfRecords;
+    }
+
+    /** Get the number of records read so far. */
+    const boost::uint64_t& getNbOfReadRecords() const {
+      return _nbOfReadRecords;
+    }
+
+
+  public:
+    // ////////// Business methods /////////
+    /**
+     * Read the next record. The booking request may be re-built with
+     * SharedRequestRing::decode().
+     *
+     * @param SharedRequestRecord& Read record.
+     * @return bool Whether a record has been read, i.e., the end of the
+     *         file has not been reached yet.
+     * @throw RequestShardException when the file cannot be read.
+     */
+    bool read (SharedRequestRecord&);
+
+
+  private:
+    // ////////// Helpers /////////
+    /**
+     * Check the header and the trailer of the file.
+     */
+    void checkFile();
+
+    /**
+     * Close the file, and throw a RequestShardException with the given
+     * message.
+     */
+    void fail (const std::string& iMessage);
+
+
+  private:
+    // ////////// Constructors and destructors /////////
+    /** Default constructor (not to be used). */
+    RequestShardReader();
+    /** Copy constructor (not to be used). */
+    RequestShardReader (const RequestShardReader&);
+
+
+  private:
+    // ////////// Attributes /////////
+    /**
+     * Path of, and handler on, the request shard file.
+     */
+    const stdair::Filename_T _filename;
+    std::FILE* _file;
+
+    /**
+     * Shard, as recorded by the header.
+     */
+    boost::uint32_t _shardIndex;
+    boost::uint32_t _nbOfShards;
+
+    /**
+     * Number of records held by the file, as recorded by the trailer,
+     * and number of records read so far.
+     */
+    boost::uint64_t _nbOfRecords;
+    boost::uint64_t _nbOfReadRecords;
+
+    /**
+     * Block of records read at once, and position of the next record
+     * to be handed over within that block.
+     */
+    std::vector<SharedRequestRecord> _block;
+    std::size_t _blockFilling;
+    std::size_t _blockPosition;
+  };
+
+}
+#endif // __TRADEMGEN_CMD_REQUESTSHARDREADER_HPP
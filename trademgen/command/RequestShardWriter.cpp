@@ -0,0 +1,154 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <cstring>
+#include <sstream>
+// TraDemGen
+#include <trademgen/TRADEMGEN_Exceptions.hpp>
+#include <trademgen/basic/BasConst_RequestShard.hpp>
+#include <trademgen/command/RequestShard.hpp>
+#include <trademgen/command/RequestShardWriter.hpp>
+
+namespace TRADEMGEN {
+
+  // //////////////////////////////////////////////////////////////////////
+  RequestShardWriter::RequestShardWriter (const stdair::Filename_T& iFilename,
+                                          const unsigned short iShardIndex,
+                                          const unsigned short iNbOfShards,
+                                          const std::size_t iBlockSize,
+                                          const unsigned short iNbOfBlocks)
+    : _blockWriter (iFilename,
+                    (iBlockSize < sizeof (SharedRequestRecord))
+                    ? sizeof (SharedRequestRecord) : iBlockSize,
+                    iNbOfBlocks),
+      _block (NULL), _blockSize (0), _blockFilling (0), _runNumber (1),
+      _lastRunNumber (0), _nbOfWrittenRequests (0), _isClosed (false) {
+
+    // Sanity check
+    assert (iShardIndex < iNbOfShards);
+
+    _block = _blockWriter.getBlock();
+    _blockSize = _blockWriter.getBlockSize();
+
+    //
+    RequestShard::Header lHeader;
+    std::memset (&lHeader, 0, sizeof (lHeader));
+    std::memcpy (lHeader._magic, REQUEST_SHARD_MAGIC, REQUEST_SHARD_MAGIC_SIZE);
+    lHeader._version = REQUEST_SHARD_VERSION;
+    lHeader._byteOrderMark = REQUEST_SHARD_BYTE_ORDER_MARK;
+    lHeader._recordSize = sizeof (SharedRequestRecord);
+    lHeader._shardIndex = iShardIndex;
+    lHeader._nbOfShards = iNbOfShards;
+    append (&lHeader, sizeof (lHeader));
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  RequestShardWriter::~RequestShardWriter() {
+    if (_isClosed == true) {
+      return;
+    }
+
+    // Best effort: a destructor must not throw. The trailer is not
+    // written, so that the file is known to be incomplete
+    try {
+      _blockWriter.submitBlock (_blockFilling);
+      _blockWriter.close();
+
+    } catch (const RequestOutputException&) {
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void RequestShardWriter::setRunNumber (const unsigned int iRunNumber) {
+    _runNumber = iRunNumber;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void RequestShardWriter::append (const void* iBytes, const std::size_t iSize) {
+    const char* lBytes = static_cast<const char*> (iBytes);
+    std::size_t lRemainingSize = iSize;
+    while (lRemainingSize != 0) {
+      if (_blockFilling == _blockSize) {
+        _block = _blockWriter.submitBlock (_blockFilling);
+        _blockSize = _blockWriter.getBlockSize();
+        _blockFilling = 0;
+      }
+
+      const std::size_t lAvailableSize = _blockSize - _blockFilling;
+      const std::size_t lSize =
+        (lRemainingSize < lAvailableSize) ? lRemainingSize : lAvailableSize;
+      std::memcpy (_block + _blockFilling, lBytes, lSize);
+      _blockFilling += lSize;
+      lBytes += lSize;
+      lRemainingSize -= lSize;
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void RequestShardWriter::write (const stdair::BookingRequestStruct& iRequest) {
+    // Sanity check
+    assert (_isClosed == false);
+
+    SharedRequestRecord lRecord;
+    SharedRequestRing::encode (iRequest, _runNumber, lRecord);
+
+    // The merge relies on every shard being in run order. Within a run,
+    // the booking requests come in the order of the event queue, which
+    // may swap booking requests a few milliseconds apart (when several
+    // of them share the same millisecond); they are recorded as such
+    if (_runNumber < _lastRunNumber) {
+      std::ostringstream oMessage;
+      oMessage << "The booking request #" << _nbOfWrittenRequests + 1
+               << " of the request shard file '"
+               << _blockWriter.getFilename() << "' belongs to the run #"
+               << _runNumber << ", which comes before the run #"
+               << _lastRunNumber << " of the previous one";
+      throw RequestShardException (oMessage.str());
+    }
+
+    append (&lRecord, sizeof (lRecord));
+    _lastRunNumber = _runNumber;
+    ++_nbOfWrittenRequests;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void RequestShardWriter::flush() {
+    // Sanity check
+    assert (_isClosed == false);
+
+    _block = _blockWriter.submitBlock (_blockFilling);
+    _blockSize = _blockWriter.getBlockSize();
+    _blockFilling = 0;
+    _blockWriter.flush();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void RequestShardWriter::close() {
+    if (_isClosed == true) {
+      return;
+    }
+    _isClosed = true;
+
+    //
+    RequestShard::Trailer lTrailer;
+    std::memset (&lTrailer, 0, sizeof (lTrailer));
+    std::memcpy (lTrailer._magic, REQUEST_SHARD_MAGIC,
+                 REQUEST_SHARD_MAGIC_SIZE);
+    lTrailer._nbOfRecords = _nbOfWrittenRequests;
+
+    // The file is closed, even when the last block cannot be written
+    try {
+      append (&lTrailer, sizeof (lTrailer));
+      _block = _blockWriter.submitBlock (_blockFilling);
+      _blockFilling = 0;
+
+    } catch (const RequestOutputException&) {
+      _blockWriter.close();
+      throw;
+    }
+    _blockWriter.close();
+  }
+
+}
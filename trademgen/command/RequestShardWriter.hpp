@@ -0,0 +1,157 @@
+#ifndef __TRADEMGEN_CMD_REQUESTSHARDWRITER_HPP
+#define __TRADEMGEN_CMD_REQUESTSHARDWRITER_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// Boost
+#include <boost/cstdint.hpp>
+// StdAir
+#include <stdair/stdair_basic_types.hpp>
+// TraDemGen
+#include <trademgen/RequestSink.hpp>
+#include <trademgen/basic/BasConst_RequestOutput.hpp>
+#include <trademgen/command/BlockFileWriter.hpp>
+
+namespace TRADEMGEN {
+
+  /**
+   * @brief Sink dumping the booking requests of a shard into a request
+   *        shard file (see RequestShard), to be merged later on with
+   *        the files of the other shards (see RequestShardMerger).
+   *
+   * The booking requests must come run after run, and, within every
+   * run, in the order given by the demand generation (i.e., in time
+   * order, up to the booking requests sharing the same millisecond). The trailer is written only when
+   * the file is explicitly closed, so that a file left incomplete
+   * (e.g., by a crashed process) is rejected by the merge.
+   */
+  class RequestShardWriter : public RequestSink {
+  public:
+    // ////////// Constructors and destructors /////////
+    /**
+     * Constructor. The output file is created (or truncated), and the
+     * header is written.
+     *
+     * @param const stdair::Filename_T& Path of the request shard file.
+     * @param const unsigned short Index of the shard (from 0).
+     * @param const unsigned short Number of shards.
+     * @param const std::size_t Size (in bytes) of the blocks written
+     *        into the file.
+     * @param const unsigned short Number of blocks. With a single block,
+     *        the writing is synchronous.
+     */
+    RequestShardWriter (const stdair::Filename_T&,
+                        const unsigned short iShardIndex,
+                        const unsigned short iNbOfShards,
+                        const std::size_t iBlockSize =
+                        DEFAULT_REQUEST_OUTPUT_BLOCK_SIZE,
+                        const unsigned short iNbOfBlocks =
+                        DEFAULT_REQUEST_OUTPUT_NB_OF_BLOCKS);
+
+    /**
+     * Destructor. Whatever remains in the block is written into the file
+     * (errors being ignored), but not the trailer: unless it has been
+     * closed, the file is incomplete.
+     */
+    ~RequestShardWriter();
+
+
+  public:
+    // ////////// Getters /////////
+    /** Get the number of requests written so far. */
+    const boost::uint64_t& getNbOfWrittenRequests() const {
+      return _nbOfWrittenRequests;
+    }
+
+
+  public:
+    // ////////// Setters /////////
+    /**
+     * Set the run number, recorded with every subsequent request.
+     */
+    void setRunNumber (const unsigned int);
+
+
+  public:
+    // ////////// Business methods /////////
+    /**
+     * Record the given booking request.
+     *
+     * @throw RequestShardException when the booking request belongs to
+     *        a run coming before the one of the previous request.
+     */
+    void write (const stdair::BookingRequestStruct&);
+
+    /**
+     * Write into the file whatever has been recorded so far, and wait
+     * until it has actually been written.
+     */
+    void flush();
+
+    /**
+     * Write the trailer, and close the output file. No more request can
+     * be written afterwards.
+     */
+    void close();
+
+
+  private:
+    // ////////// Helpers /////////
+    /**
+     * Append the given bytes to the block, handing the block over to
+     * the block writer whenever it is full.
+     */
+    void append (const void*, const std::size_t);
+
+
+  private:
+    // ////////// Constructors and destructors /////////
+    /** Default constructor (not to be used). */
+    RequestShardWriter();
+    /** Copy constructor (not to be used). */
+    RequestShardWriter (const RequestShardWriter&);
+
+
+  private:
+    // ////////// Attributes /////////
+    /**
+     * Writer of the blocks into the output file.
+     */
+    BlockFileWriter _blockWriter;
+
+    /**
+     * Block in which the records are copied (owned by the block writer).
+     */
+    char* _block;
+    std::size_t _blockSize;
+
+    /**
+     * Number of bytes copied so far within the block.
+     */
+    std::size_t _blockFilling;
+
+    /**
+     * Run number of the subsequent requests.
+     */
+    unsigned int _runNumber;
+
+    /**
+     * Run number of the last written request, against which the run of
+     * the next one is checked.
+     */
+    unsigned int _lastRunNumber;
+
+    /**
+     * Number of requests written so far.
+     */
+    boost::uint64_t _nbOfWrittenRequests;
+
+    /**
+     * Whether the output file has been closed.
+     */
+    bool _isClosed;
+  };
+
+}
+#endif // __TRADEMGEN_CMD_REQUESTSHARDWRITER_HPP
@@ -0,0 +1,178 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <cstring>
+#include <sstream>
+#if defined(__linux__)
+#include <climits>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else // if defined(__linux__)
+#include <chrono>
+#include <thread>
+#endif // if defined(__linux__)
+// Boost
+#include <boost/make_shared.hpp>
+// StdAir
+#include <stdair/bom/BookingRequestStruct.hpp>
+// TraDemGen
+#include <trademgen/TRADEMGEN_Exceptions.hpp>
+#include <trademgen/bom/DemandStreamKey.hpp>
+#include <trademgen/command/SharedRequestRing.hpp>
+
+namespace TRADEMGEN {
+
+  namespace {
+
+    /** Reference date-time, from which the date-times are counted. */
+    const stdair::DateTime_T K_EPOCH (stdair::Date_T (1970, 1, 1));
+
+    /** Alignment (in bytes) of the record slots within the segment. */
+    const std::size_t K_RECORD_ALIGNMENT = 64;
+
+    // //////////////////////////////////////////////////////////////////
+    void encodeCode (const std::string& iCode, const char* iFieldName,
+                     char (&oCode)[SHARED_REQUEST_CODE_SIZE]) {
+      if (iCode.size() >= SHARED_REQUEST_CODE_SIZE) {
+        std::ostringstream oStr;
+        oStr << "The " << iFieldName << " '" << iCode << "' is longer than "
+             << SHARED_REQUEST_CODE_SIZE - 1 << " characters, and does not "
+             << "fit into a shared request record";
+        throw SharedRequestRingException (oStr.str());
+      }
+      std::memset (oCode, 0, SHARED_REQUEST_CODE_SIZE);
+      std::memcpy (oCode, iCode.data(), iCode.size());
+    }
+
+    // //////////////////////////////////////////////////////////////////
+    std::string decodeCode (const char (&iCode)[SHARED_REQUEST_CODE_SIZE]) {
+      const void* lEnd = std::memchr (iCode, '\0', SHARED_REQUEST_CODE_SIZE);
+      const std::size_t lSize = (lEnd == NULL) ? SHARED_REQUEST_CODE_SIZE
+        : static_cast<const char*> (lEnd) - iCode;
+      return std::string (iCode, lSize);
+    }
+
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  std::size_t SharedRequestRing::getRoundedCapacity (const std::size_t iCapacity) {
+    std::size_t oCapacity = 1;
+    while (oCapacity < iCapacity) {
+      oCapacity <<= 1;
+    }
+    return oCapacity;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  std::size_t SharedRequestRing::getSegmentSize (const std::size_t iCapacity) {
+    const std::size_t lHeaderSize =
+      (sizeof (Header) + K_RECORD_ALIGNMENT - 1)
+      / K_RECORD_ALIGNMENT * K_RECORD_ALIGNMENT;
+    return lHeaderSize + iCapacity * sizeof (SharedRequestRecord);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  SharedRequestRecord* SharedRequestRing::getRecords (void* ioSegment) {
+    char* lRecords = static_cast<char*> (ioSegment) + getSegmentSize (0);
+    return reinterpret_cast<SharedRequestRecord*> (lRecords);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  std::string SharedRequestRing::getObjectName (const std::string& iRingName) {
+    if (iRingName.empty() == false && iRingName[0] == '/') {
+      return iRingName;
+    }
+    return "/" + iRingName;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void SharedRequestRing::encode (const stdair::BookingRequestStruct& iRequest,
+                                  const unsigned int iRunNumber,
+                                  SharedRequestRecord& oRecord) {
+    encodeCode (iRequest.getOrigin(), "origin", oRecord._origin);
+    encodeCode (iRequest.getDestination(), "destination",
+                oRecord._destination);
+    encodeCode (iRequest.getPOS(), "point of sale", oRecord._pos);
+    encodeCode (iRequest.getPreferredCabin(), "preferred cabin",
+                oRecord._preferredCabin);
+    encodeCode (iRequest.getBookingChannel(), "channel", oRecord._channel);
+    encodeCode (iRequest.getTripType(), "trip type", oRecord._tripType);
+    encodeCode (iRequest.getFrequentFlyerType(), "frequent flyer type",
+                oRecord._frequentFlyerType);
+
+    oRecord._requestDateTime =
+      (iRequest.getRequestDateTime() - K_EPOCH).total_microseconds();
+    oRecord._preferredDepartureTime =
+      iRequest.getPreferredDepartureTime().total_microseconds();
+    oRecord._partySize = iRequest.getPartySize();
+    oRecord._wtp = iRequest.getWTP();
+    oRecord._valueOfTime = iRequest.getValueOfTime();
+    oRecord._changeFeeDisutility = iRequest.getChangeFeeDisutility();
+    oRecord._nonRefundableDisutility = iRequest.getNonRefundableDisutility();
+    oRecord._preferredDepartureDate =
+      (iRequest.getPreferedDepartureDate() - K_EPOCH.date()).days();
+    oRecord._stayDuration = iRequest.getStayDuration();
+    oRecord._runNumber = iRunNumber;
+    oRecord._changeFees = (iRequest.getChangeFees() == true) ? 1 : 0;
+    oRecord._nonRefundable = (iRequest.getNonRefundable() == true) ? 1 : 0;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  stdair::BookingRequestPtr_T SharedRequestRing::
+  decode (const SharedRequestRecord& iRecord) {
+    const std::string lOrigin = decodeCode (iRecord._origin);
+    const std::string lDestination = decodeCode (iRecord._destination);
+    const std::string lPreferredCabin = decodeCode (iRecord._preferredCabin);
+    const stdair::Date_T lPreferredDepartureDate =
+      K_EPOCH.date() + boost::gregorian::days (iRecord._preferredDepartureDate);
+    const stdair::DateTime_T lRequestDateTime =
+      K_EPOCH + boost::posix_time::microseconds (iRecord._requestDateTime);
+    const stdair::Duration_T lPreferredDepartureTime =
+      boost::posix_time::microseconds (iRecord._preferredDepartureTime);
+
+    // The demand stream key is re-built from its components
+    const DemandStreamKey lKey (lOrigin, lDestination, lPreferredDepartureDate,
+                                lPreferredCabin);
+
+    return boost::make_shared<stdair::BookingRequestStruct>
+      (lKey.toString(), lOrigin, lDestination, decodeCode (iRecord._pos),
+       lPreferredDepartureDate, lRequestDateTime, lPreferredCabin,
+       iRecord._partySize, decodeCode (iRecord._channel),
+       decodeCode (iRecord._tripType), iRecord._stayDuration,
+       decodeCode (iRecord._frequentFlyerType), lPreferredDepartureTime,
+       iRecord._wtp, iRecord._valueOfTime, iRecord._changeFees != 0,
+       iRecord._changeFeeDisutility, iRecord._nonRefundable != 0,
+       iRecord._nonRefundableDisutility);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void SharedRequestRing::wait (std::atomic<boost::uint32_t>& ioSequence,
+                                const boost::uint32_t iExpectedValue) {
+    static_assert (sizeof (std::atomic<boost::uint32_t>)
+                   == sizeof (boost::uint32_t),
+                   "The futex words must be plain 32-bit integers");
+#if defined(__linux__)
+    // Note: the futex is not private, as it is shared among processes
+    syscall (SYS_futex, reinterpret_cast<boost::uint32_t*> (&ioSequence),
+             FUTEX_WAIT, iExpectedValue, NULL, NULL, 0);
+#else // if defined(__linux__)
+    // No futex: poll the futex word
+    while (ioSequence.load() == iExpectedValue) {
+      std::this_thread::sleep_for (std::chrono::microseconds (100));
+    }
+#endif // if defined(__linux__)
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void SharedRequestRing::wakeAll (std::atomic<boost::uint32_t>& ioSequence) {
+    ioSequence.fetch_add (1);
+#if defined(__linux__)
+    syscall (SYS_futex, reinterpret_cast<boost::uint32_t*> (&ioSequence),
+             FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+#endif // if defined(__linux__)
+  }
+
+}
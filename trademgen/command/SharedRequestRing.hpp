@@ -0,0 +1,172 @@
+#ifndef __TRADEMGEN_CMD_SHAREDREQUESTRING_HPP
+#define __TRADEMGEN_CMD_SHAREDREQUESTRING_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <atomic>
+#include <cstddef>
+#include <string>
+// Boost
+#include <boost/cstdint.hpp>
+// StdAir
+#include <stdair/stdair_basic_types.hpp>
+#include <stdair/bom/BookingRequestTypes.hpp>
+// TraDemGen
+#include <trademgen/basic/BasConst_SharedRequestRing.hpp>
+
+namespace TRADEMGEN {
+
+  /**
+   * @brief Compact, fixed-size, representation of a booking request,
+   *        as published into a shared request ring.
+   *
+   * The date-times and durations are counted in microseconds, and the
+   * dates in days, since 1970-01-01. The codes are null-terminated. The
+   * demand stream key is not recorded, as it is made of the origin, the
+   * destination, the preferred departure date and the preferred cabin.
+   */
+  struct SharedRequestRecord {
+    boost::int64_t _requestDateTime;
+    boost::int64_t _preferredDepartureTime;
+    double _partySize;
+    double _wtp;
+    double _valueOfTime;
+    double _changeFeeDisutility;
+    double _nonRefundableDisutility;
+    boost::int32_t _preferredDepartureDate;
+    boost::int32_t _stayDuration;
+    boost::uint32_t _runNumber;
+    char _origin[SHARED_REQUEST_CODE_SIZE];
+    char _destination[SHARED_REQUEST_CODE_SIZE];
+    char _pos[SHARED_REQUEST_CODE_SIZE];
+    char _preferredCabin[SHARED_REQUEST_CODE_SIZE];
+    char _channel[SHARED_REQUEST_CODE_SIZE];
+    char _tripType[SHARED_REQUEST_CODE_SIZE];
+    char _frequentFlyerType[SHARED_REQUEST_CODE_SIZE];
+    boost::uint8_t _changeFees;
+    boost::uint8_t _nonRefundable;
+  };
+
+  /**
+   * @brief Layout of, and helpers shared by the writer and the readers
+   *        of, the rings of booking requests held in POSIX shared
+   *        memory (see SharedRequestRingWriter and SharedRequestRingReader).
+   *
+   * A shared memory segment is made of a header, followed by a
+   * power-of-two number of record slots. The writer publishes the
+   * records by moving its cursor forward; every reader has its own
+   * cursor, within a slot of the header, and the writer never goes
+   * further than one ring ahead of the slowest reader. The two sides
+   * only wake each other up (thanks to futexes, on Linux) when the
+   * other side is known to wait.
+   */
+  class SharedRequestRing {
+  public:
+    // ////////// Type definitions /////////
+    /** State of a reader slot. */
+    enum EN_ReaderState {
+      FREE_READER = 0,
+      ATTACHING_READER,
+      ATTACHED_READER
+    };
+
+    /** Reader slot, on its own cache line. */
+    struct ReaderSlot {
+      std::atomic<boost::uint32_t> _state;
+      std::atomic<boost::uint64_t> _cursor;
+      char _padding[48];
+    };
+
+    /** Header of the shared memory segment. */
+    struct Header {
+      char _magic[SHARED_REQUEST_RING_MAGIC_SIZE];
+      boost::uint32_t _version;
+      boost::uint32_t _byteOrderMark;
+      boost::uint32_t _recordSize;
+      boost::uint32_t _maxNbOfReaders;
+      boost::uint64_t _capacity;
+      char _descriptionPadding[32];
+
+      /** Number of records published so far (written by the writer). */
+      std::atomic<boost::uint64_t> _writeCursor;
+      /** Whether the writer has closed the ring. */
+      std::atomic<boost::uint32_t> _isClosed;
+      /** Futex word, bumped by the writer to wake up the readers. */
+      std::atomic<boost::uint32_t> _writeSequence;
+      /** Number of readers waiting for a record. */
+      std::atomic<boost::uint32_t> _nbOfWaitingReaders;
+      char _writerPadding[44];
+
+      /** Futex word, bumped by the readers to wake up the writer. */
+      std::atomic<boost::uint32_t> _readSequence;
+      /** Whether the writer waits for a free slot (or for readers). */
+      std::atomic<boost::uint32_t> _isWriterWaiting;
+      char _readerPadding[56];
+
+      ReaderSlot _readerSlots[MAX_NB_OF_SHARED_REQUEST_RING_READERS];
+    };
+
+
+  public:
+    // ////////// Layout /////////
+    /**
+     * Get the smallest power of two, not below the given capacity.
+     */
+    static std::size_t getRoundedCapacity (const std::size_t);
+
+    /**
+     * Get the size (in bytes) of a shared memory segment holding the
+     * given number of records.
+     */
+    static std::size_t getSegmentSize (const std::size_t iCapacity);
+
+    /**
+     * Get the record slots of the given shared memory segment.
+     */
+    static SharedRequestRecord* getRecords (void* ioSegment);
+
+    /**
+     * Get the POSIX name of the shared memory object of the given ring
+     * (i.e., with a leading slash).
+     */
+    static std::string getObjectName (const std::string& iRingName);
+
+
+  public:
+    // ////////// Conversions /////////
+    /**
+     * Fill the given record from the given booking request.
+     *
+     * @throw SharedRequestRingException when one of the codes is too
+     *        long for the record.
+     */
+    static void encode (const stdair::BookingRequestStruct&,
+                        const unsigned int iRunNumber,
+                        SharedRequestRecord&);
+
+    /**
+     * Re-build the booking request from the given record.
+     */
+    static stdair::BookingRequestPtr_T decode (const SharedRequestRecord&);
+
+
+  public:
+    // ////////// Synchronisation /////////
+    /**
+     * Wait until the given futex word is no longer equal to the given
+     * value (spurious wake-ups being possible).
+     */
+    static void wait (std::atomic<boost::uint32_t>& ioSequence,
+                      const boost::uint32_t iExpectedValue);
+
+    /**
+     * Bump the given futex word, and wake up all the processes waiting
+     * on it.
+     */
+    static void wakeAll (std::atomic<boost::uint32_t>& ioSequence);
+  };
+
+}
+#endif // __TRADEMGEN_CMD_SHAREDREQUESTRING_HPP
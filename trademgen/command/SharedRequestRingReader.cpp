@@ -0,0 +1,236 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+// TraDemGen
+#include <trademgen/TRADEMGEN_Exceptions.hpp>
+#include <trademgen/command/SharedRequestRingReader.hpp>
+
+namespace TRADEMGEN {
+
+  namespace {
+
+    /**
+     * Number of times a reader, having caught up with the writer, yields
+     * before going to sleep, so that the writer does not have to wake it
+     * up for every record.
+     */
+    const unsigned int K_NB_OF_SPINS_BEFORE_WAITING = 64;
+
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  SharedRequestRingReader::SharedRequestRingReader (const std::string& iName)
+    : _name (iName), _segment (NULL), _segmentSize (0), _header (NULL),
+      _records (NULL), _mask (0), _wakeUpMask (0), _slot (NULL),
+      _writeCursor (0), _readCursor (0), _nbOfReadRequests (0) {
+
+    const std::string lObjectName = SharedRequestRing::getObjectName (iName);
+    const int lFileDescriptor = shm_open (lObjectName.c_str(), O_RDWR, 0);
+    if (lFileDescriptor == -1) {
+      std::ostringstream oMessage;
+      oMessage << "The shared request ring '" << _name
+               << "' cannot be opened: " << std::strerror (errno);
+      throw SharedRequestRingException (oMessage.str());
+    }
+
+    struct stat lStat;
+    if (fstat (lFileDescriptor, &lStat) == 0
+        && lStat.st_size >= static_cast<off_t> (sizeof (SharedRequestRing::
+                                                         Header))) {
+      _segmentSize = lStat.st_size;
+      _segment = mmap (NULL, _segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED,
+                       lFileDescriptor, 0);
+    }
+    ::close (lFileDescriptor);
+    if (_segment == NULL || _segment == MAP_FAILED) {
+      _segment = NULL;
+      std::ostringstream oMessage;
+      oMessage << "The shared request ring '" << _name
+               << "' cannot be mapped";
+      throw SharedRequestRingException (oMessage.str());
+    }
+
+    // The magic string is written last by the writer
+    _header = static_cast<SharedRequestRing::Header*> (_segment);
+    const bool hasMagic =
+      (std::memcmp (_header->_magic, SHARED_REQUEST_RING_MAGIC,
+                    SHARED_REQUEST_RING_MAGIC_SIZE) == 0);
+    std::atomic_thread_fence (std::memory_order_acquire);
+
+    const boost::uint64_t lCapacity = _header->_capacity;
+    std::ostringstream oMessage;
+    if (hasMagic == false) {
+      oMessage << "The shared memory object '" << _name
+               << "' is not a shared request ring (or is not ready yet)";
+
+    } else if (_header->_byteOrderMark != SHARED_REQUEST_RING_BYTE_ORDER_MARK
+               || _header->_version != SHARED_REQUEST_RING_VERSION
+               || _header->_recordSize != sizeof (SharedRequestRecord)
+               || _header->_maxNbOfReaders
+               != MAX_NB_OF_SHARED_REQUEST_RING_READERS) {
+      oMessage << "The shared request ring '" << _name << "' has been "
+               << "created by another version of TraDemGen (layout version "
+               << _header->_version << ", whereas " << SHARED_REQUEST_RING_VERSION
+               << " is expected)";
+
+    } else if (lCapacity == 0 || (lCapacity & (lCapacity - 1)) != 0
+               || SharedRequestRing::getSegmentSize (lCapacity)
+               != _segmentSize) {
+      oMessage << "The shared request ring '" << _name << "' is corrupted";
+    }
+    if (oMessage.str().empty() == false) {
+      munmap (_segment, _segmentSize);
+      _segment = NULL;
+      throw SharedRequestRingException (oMessage.str());
+    }
+    _records = SharedRequestRing::getRecords (_segment);
+    _mask = lCapacity - 1;
+    _wakeUpMask = (lCapacity >= 4) ? (lCapacity / 4 - 1) : 0;
+
+    // Claim a free reader slot. Until the slot is seen as attached by the
+    // writer, the latter may have gone further than one ring ahead of
+    // the provisional cursor: the reader starts from the write cursor as
+    // seen once attached
+    for (unsigned short idx = 0;
+         idx != MAX_NB_OF_SHARED_REQUEST_RING_READERS; ++idx) {
+      SharedRequestRing::ReaderSlot& lSlot = _header->_readerSlots[idx];
+      boost::uint32_t lState = SharedRequestRing::FREE_READER;
+      if (lSlot._state.compare_exchange_strong
+          (lState, SharedRequestRing::ATTACHING_READER) == true) {
+        lSlot._cursor.store (_header->_writeCursor.load());
+        lSlot._state.store (SharedRequestRing::ATTACHED_READER);
+        _readCursor = _header->_writeCursor.load();
+        lSlot._cursor.store (_readCursor);
+        _writeCursor = _readCursor;
+        _slot = &lSlot;
+        break;
+      }
+    }
+    if (_slot == NULL) {
+      munmap (_segment, _segmentSize);
+      _segment = NULL;
+      std::ostringstream oMessage;
+      oMessage << "There are already " << MAX_NB_OF_SHARED_REQUEST_RING_READERS
+               << " readers attached to the shared request ring '"
+               << _name << "'";
+      throw SharedRequestRingException (oMessage.str());
+    }
+
+    // The writer may wait for readers
+    if (_header->_isWriterWaiting.load() != 0) {
+      SharedRequestRing::wakeAll (_header->_readSequence);
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  SharedRequestRingReader::~SharedRequestRingReader() {
+    detach();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool SharedRequestRingReader::isDone() const {
+    return (_slot == NULL
+            || (_header->_isClosed.load() != 0
+                && _header->_writeCursor.load() == _readCursor));
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool SharedRequestRingReader::tryRead (SharedRequestRecord& oRecord) {
+    if (_slot == NULL) {
+      return false;
+    }
+
+    if (_readCursor == _writeCursor) {
+      _writeCursor = _header->_writeCursor.load();
+      if (_readCursor == _writeCursor) {
+        return false;
+      }
+    }
+    assert (_writeCursor - _readCursor <= _mask + 1);
+
+    oRecord = _records[_readCursor & _mask];
+    ++_readCursor;
+    ++_nbOfReadRequests;
+
+    // Free the slot. The writer, when waiting for that reader, is woken
+    // up only every quarter of a ring, rather than for every record
+    _slot->_cursor.store (_readCursor);
+    if ((_readCursor & _wakeUpMask) == 0
+        && _header->_isWriterWaiting.load() != 0) {
+      SharedRequestRing::wakeAll (_header->_readSequence);
+    }
+    return true;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool SharedRequestRingReader::read (SharedRequestRecord& oRecord) {
+    unsigned int lNbOfSpins = 0;
+    while (tryRead (oRecord) == false) {
+      if (_slot == NULL) {
+        return false;
+      }
+      if (_header->_isClosed.load() != 0) {
+        // The last records may have been published right before the closing
+        return tryRead (oRecord);
+      }
+
+      if (lNbOfSpins < K_NB_OF_SPINS_BEFORE_WAITING) {
+        ++lNbOfSpins;
+        std::this_thread::yield();
+        continue;
+      }
+
+      // The waiting count is raised before checking the write cursor, so
+      // that the writer publishing a record in the meantime bumps the
+      // futex word
+      _header->_nbOfWaitingReaders.fetch_add (1);
+      const boost::uint32_t lSequence = _header->_writeSequence.load();
+      if (_header->_writeCursor.load() == _readCursor
+          && _header->_isClosed.load() == 0) {
+        SharedRequestRing::wait (_header->_writeSequence, lSequence);
+      }
+      _header->_nbOfWaitingReaders.fetch_sub (1);
+    }
+    return true;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  bool SharedRequestRingReader::read (stdair::BookingRequestPtr_T& oRequest) {
+    SharedRequestRecord lRecord;
+    if (read (lRecord) == false) {
+      return false;
+    }
+    oRequest = SharedRequestRing::decode (lRecord);
+    return true;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void SharedRequestRingReader::detach() {
+    if (_slot == NULL) {
+      return;
+    }
+
+    // The writer may wait for that reader
+    _slot->_state.store (SharedRequestRing::FREE_READER);
+    _slot = NULL;
+    if (_header->_isWriterWaiting.load() != 0) {
+      SharedRequestRing::wakeAll (_header->_readSequence);
+    }
+
+    munmap (_segment, _segmentSize);
+    _segment = NULL;
+    _header = NULL;
+    _records = NULL;
+  }
+
+}
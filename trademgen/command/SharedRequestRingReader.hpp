@@ -0,0 +1,156 @@
+#ifndef __TRADEMGEN_CMD_SHAREDREQUESTRINGREADER_HPP
+#define __TRADEMGEN_CMD_SHAREDREQUESTRINGREADER_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <string>
+// Boost
+#include <boost/cstdint.hpp>
+// StdAir
+#include <stdair/stdair_basic_types.hpp>
+#include <stdair/bom/BookingRequestTypes.hpp>
+// TraDemGen
+#include <trademgen/command/SharedRequestRing.hpp>
+
+namespace TRADEMGEN {
+
+  /**
+   * @brief Reader of the booking requests published into a ring held in
+   *        POSIX shared memory (see SharedRequestRingWriter).
+   *
+   * The reader gets, in the order of their publication, all the booking
+   * requests published after it has attached to the ring. Each reader
+   * has its own cursor, so that several reader processes may consume
+   * the same booking requests, at their own pace (the writer waiting for
+   * the slowest of them).
+   */
+  class SharedRequestRingReader {
+  public:
+    // ////////// Constructors and destructors /////////
+    /**
+     * Constructor. The reader attaches to the ring.
+     *
+     * @param const std::string& Name of the ring, as given to the writer.
+     * @throw SharedRequestRingException when there is no such ring (or
+     *        it has been created by another version of TraDemGen), or
+     *        when the maximal number of readers is already attached.
+     */
+    explicit SharedRequestRingReader (const std::string& iName);
+
+    /**
+     * Destructor. The reader detaches from the ring (see detach()).
+     */
+    ~SharedRequestRingReader();
+
+
+  public:
+    // ////////// Getters /////////
+    /** Get the name of the ring. */
+    const std::string& getName() const {
+      return _name;
+    }
+
+    /** Get the number of records held by the ring. */
+    std::size_t getCapacity() const {
+      return _mask + 1;
+    }
+
+    /** Get the number of booking requests read so far. */
+    const boost::uint64_t& getNbOfReadRequests() const {
+      return _nbOfReadRequests;
+    }
+
+    /**
+     * State whether the writer has closed the ring, and all the
+     * booking requests published before have been read.
+     */
+    bool isDone() const;
+
+
+  public:
+    // ////////// Business methods /////////
+    /**
+     * Read the next record, waiting for it to be published. The booking
+     * request may be re-built with SharedRequestRing::decode().
+     *
+     * @param SharedRequestRecord& Read record.
+     * @return bool Whether a record has been read, i.e., the ring has
+     *         not been closed by the writer (nor the reader detached).
+     */
+    bool read (SharedRequestRecord&);
+
+    /**
+     * Read the next booking request, waiting for it to be published.
+     *
+     * @param stdair::BookingRequestPtr_T& Read booking request.
+     * @return bool Whether a booking request has been read.
+     */
+    bool read (stdair::BookingRequestPtr_T&);
+
+    /**
+     * Read the next record, when it has already been published.
+     *
+     * @param SharedRequestRecord& Read record.
+     * @return bool Whether a record has been read. When not, isDone()
+     *         tells whether the ring has been closed.
+     */
+    bool tryRead (SharedRequestRecord&);
+
+    /**
+     * Detach from the ring, freeing the reader slot, so that the writer
+     * no longer waits for that reader.
+     */
+    void detach();
+
+
+  private:
+    // ////////// Constructors and destructors /////////
+    /** Default constructor (not to be used). */
+    SharedRequestRingReader();
+    /** Copy constructor (not to be used). */
+    SharedRequestRingReader (const SharedRequestRingReader&);
+
+
+  private:
+    // ////////// Attributes /////////
+    /**
+     * Name of the ring.
+     */
+    std::string _name;
+
+    /**
+     * Mapping of the shared memory segment.
+     */
+    void* _segment;
+    std::size_t _segmentSize;
+    SharedRequestRing::Header* _header;
+    const SharedRequestRecord* _records;
+    std::size_t _mask;
+
+    /**
+     * Mask of the cursors at which the writer, when waiting, is woken up.
+     */
+    std::size_t _wakeUpMask;
+
+    /**
+     * Reader slot, within the header, holding the cursor of the reader.
+     */
+    SharedRequestRing::ReaderSlot* _slot;
+
+    /**
+     * Number of records published so far, as last seen, and number of
+     * records read so far (i.e., cursor of the reader).
+     */
+    boost::uint64_t _writeCursor;
+    boost::uint64_t _readCursor;
+
+    /**
+     * Number of booking requests read so far.
+     */
+    boost::uint64_t _nbOfReadRequests;
+  };
+
+}
+#endif // __TRADEMGEN_CMD_SHAREDREQUESTRINGREADER_HPP
@@ -0,0 +1,206 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <sstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+// TraDemGen
+#include <trademgen/TRADEMGEN_Exceptions.hpp>
+#include <trademgen/command/SharedRequestRingWriter.hpp>
+
+namespace TRADEMGEN {
+
+  // //////////////////////////////////////////////////////////////////////
+  SharedRequestRingWriter::
+  SharedRequestRingWriter (const std::string& iName,
+                           const std::size_t iCapacity)
+    : _name (iName), _objectName (SharedRequestRing::getObjectName (iName)),
+      _segment (NULL), _segmentSize (0), _header (NULL), _records (NULL),
+      _mask (SharedRequestRing::getRoundedCapacity (iCapacity) - 1),
+      _writeCursor (0), _writeLimit (0), _runNumber (1), _isClosed (false) {
+
+    // A stale shared memory object (e.g., left by a crashed writer) is
+    // replaced, the readers still attached to it keeping their mapping
+    shm_unlink (_objectName.c_str());
+    const int lFileDescriptor =
+      shm_open (_objectName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (lFileDescriptor == -1) {
+      std::ostringstream oMessage;
+      oMessage << "The shared request ring '" << _name
+               << "' cannot be created: " << std::strerror (errno);
+      throw SharedRequestRingException (oMessage.str());
+    }
+
+    // The memory of the new object is zero-filled
+    _segmentSize = SharedRequestRing::getSegmentSize (_mask + 1);
+    if (ftruncate (lFileDescriptor, _segmentSize) == 0) {
+      _segment = mmap (NULL, _segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED,
+                       lFileDescriptor, 0);
+    }
+    const int lErrorNumber = errno;
+    ::close (lFileDescriptor);
+    if (_segment == NULL || _segment == MAP_FAILED) {
+      _segment = NULL;
+      shm_unlink (_objectName.c_str());
+      std::ostringstream oMessage;
+      oMessage << "The shared request ring '" << _name << "' ("
+               << _segmentSize << " bytes) cannot be mapped: "
+               << std::strerror (lErrorNumber);
+      throw SharedRequestRingException (oMessage.str());
+    }
+
+    _header = new (_segment) SharedRequestRing::Header();
+    _header->_version = SHARED_REQUEST_RING_VERSION;
+    _header->_byteOrderMark = SHARED_REQUEST_RING_BYTE_ORDER_MARK;
+    _header->_recordSize = sizeof (SharedRequestRecord);
+    _header->_maxNbOfReaders = MAX_NB_OF_SHARED_REQUEST_RING_READERS;
+    _header->_capacity = _mask + 1;
+    _records = SharedRequestRing::getRecords (_segment);
+
+    // The magic string comes last: the readers do not attach before
+    std::atomic_thread_fence (std::memory_order_release);
+    std::memcpy (_header->_magic, SHARED_REQUEST_RING_MAGIC,
+                 SHARED_REQUEST_RING_MAGIC_SIZE);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  SharedRequestRingWriter::~SharedRequestRingWriter() {
+    close();
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  unsigned int SharedRequestRingWriter::getNbOfReaders() const {
+    if (_header == NULL) {
+      return 0;
+    }
+
+    unsigned int oNbOfReaders = 0;
+    for (unsigned short idx = 0;
+         idx != MAX_NB_OF_SHARED_REQUEST_RING_READERS; ++idx) {
+      if (_header->_readerSlots[idx]._state.load()
+          == SharedRequestRing::ATTACHED_READER) {
+        ++oNbOfReaders;
+      }
+    }
+    return oNbOfReaders;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void SharedRequestRingWriter::setRunNumber (const unsigned int iRunNumber) {
+    _runNumber = iRunNumber;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  boost::uint64_t SharedRequestRingWriter::getWriteLimit() const {
+    // Note: a reader being attached starts at a cursor not below the
+    // cursors of the readers already attached
+    bool hasReader = false;
+    boost::uint64_t lMinCursor = _writeCursor;
+    for (unsigned short idx = 0;
+         idx != MAX_NB_OF_SHARED_REQUEST_RING_READERS; ++idx) {
+      const SharedRequestRing::ReaderSlot& lSlot = _header->_readerSlots[idx];
+      if (lSlot._state.load() == SharedRequestRing::ATTACHED_READER) {
+        const boost::uint64_t lCursor = lSlot._cursor.load();
+        if (lCursor < lMinCursor) {
+          lMinCursor = lCursor;
+        }
+        hasReader = true;
+      }
+    }
+
+    // Without any reader, the readers are checked again for every record
+    if (hasReader == false) {
+      return _writeCursor + 1;
+    }
+    return lMinCursor + _mask + 1;
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  template <typename CONDITION>
+  void SharedRequestRingWriter::waitFor (const CONDITION& iCondition) {
+    // The flag is raised before checking the condition, so that a reader
+    // moving forward in the meantime bumps the futex word
+    _header->_isWriterWaiting.store (1);
+    while (true) {
+      const boost::uint32_t lSequence = _header->_readSequence.load();
+      if (iCondition() == true) {
+        break;
+      }
+      SharedRequestRing::wait (_header->_readSequence, lSequence);
+    }
+    _header->_isWriterWaiting.store (0);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void SharedRequestRingWriter::waitForReaders (const unsigned int iNbOfReaders) {
+    if (_isClosed == true) {
+      return;
+    }
+    waitFor ([this, iNbOfReaders] () {
+        return (getNbOfReaders() >= iNbOfReaders);
+      });
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void SharedRequestRingWriter::
+  write (const stdair::BookingRequestStruct& iRequest) {
+    if (_isClosed == true) {
+      std::ostringstream oMessage;
+      oMessage << "The shared request ring '" << _name << "' has been closed";
+      throw SharedRequestRingException (oMessage.str());
+    }
+
+    // Wait, if needed, for the slowest reader to free the slot
+    if (_writeCursor >= _writeLimit) {
+      _writeLimit = getWriteLimit();
+      if (_writeCursor >= _writeLimit) {
+        waitFor ([this] () {
+            _writeLimit = getWriteLimit();
+            return (_writeCursor < _writeLimit);
+          });
+      }
+    }
+
+    // When the booking request does not fit into the record, nothing
+    // has been published
+    SharedRequestRing::encode (iRequest, _runNumber,
+                               _records[_writeCursor & _mask]);
+
+    // Publish the record, and wake up the readers waiting for it, if any
+    ++_writeCursor;
+    _header->_writeCursor.store (_writeCursor);
+    if (_header->_nbOfWaitingReaders.load() != 0) {
+      SharedRequestRing::wakeAll (_header->_writeSequence);
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void SharedRequestRingWriter::close() {
+    if (_isClosed == true) {
+      return;
+    }
+    _isClosed = true;
+
+    if (_segment == NULL) {
+      return;
+    }
+
+    //
+    _header->_isClosed.store (1);
+    SharedRequestRing::wakeAll (_header->_writeSequence);
+
+    //
+    munmap (_segment, _segmentSize);
+    shm_unlink (_objectName.c_str());
+    _segment = NULL;
+    _header = NULL;
+    _records = NULL;
+  }
+
+}
@@ -0,0 +1,179 @@
+#ifndef __TRADEMGEN_CMD_SHAREDREQUESTRINGWRITER_HPP
+#define __TRADEMGEN_CMD_SHAREDREQUESTRINGWRITER_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <string>
+// Boost
+#include <boost/cstdint.hpp>
+// StdAir
+#include <stdair/stdair_basic_types.hpp>
+// TraDemGen
+#include <trademgen/RequestSink.hpp>
+#include <trademgen/basic/BasConst_SharedRequestRing.hpp>
+#include <trademgen/command/SharedRequestRing.hpp>
+
+namespace TRADEMGEN {
+
+  /**
+   * @brief Sink publishing the booking requests into a ring held in
+   *        POSIX shared memory, for other processes to consume them.
+   *
+   * Each booking request is published as a compact, fixed-size, record
+   * (see SharedRequestRecord). Up to MAX_NB_OF_SHARED_REQUEST_RING_READERS
+   * reader processes may attach to the ring (see SharedRequestRingReader),
+   * each one with its own cursor, and all of them receive all the
+   * booking requests published after they have attached. The writer
+   * waits for the slowest attached reader, when it is a whole ring
+   * ahead of it; when no reader is attached, the booking requests are
+   * published for nobody.
+   *
+   * A given demand may thus be generated once, and consumed by several
+   * simulator processes on the same machine.
+   *
+   * \note A reader process which dies without detaching from the ring
+   *       stalls the writer, once the latter is a whole ring ahead.
+   */
+  class SharedRequestRingWriter : public RequestSink {
+  public:
+    // ////////// Constructors and destructors /////////
+    /**
+     * Constructor. The shared memory object is created, replacing any
+     * (stale) one of the same name.
+     *
+     * @param const std::string& Name of the ring (e.g., "trademgen").
+     * @param const std::size_t Minimal number of records held by the
+     *        ring (rounded up to a power of two).
+     * @throw SharedRequestRingException when the shared memory object
+     *        cannot be created.
+     */
+    SharedRequestRingWriter (const std::string& iName,
+                             const std::size_t iCapacity =
+                             DEFAULT_SHARED_REQUEST_RING_CAPACITY);
+
+    /**
+     * Destructor. The ring is closed (see close()).
+     */
+    ~SharedRequestRingWriter();
+
+
+  public:
+    // ////////// Getters /////////
+    /** Get the name of the ring. */
+    const std::string& getName() const {
+      return _name;
+    }
+
+    /** Get the number of records held by the ring. */
+    std::size_t getCapacity() const {
+      return _mask + 1;
+    }
+
+    /** Get the number of booking requests published so far. */
+    const boost::uint64_t& getNbOfWrittenRequests() const {
+      return _writeCursor;
+    }
+
+    /** Get the number of readers currently attached to the ring. */
+    unsigned int getNbOfReaders() const;
+
+
+  public:
+    // ////////// Setters /////////
+    /**
+     * Set the run number, recorded along with every subsequent booking
+     * request.
+     */
+    void setRunNumber (const unsigned int);
+
+
+  public:
+    // ////////// Business methods /////////
+    /**
+     * Wait until at least the given number of readers are attached to
+     * the ring, typically before publishing the first booking request.
+     */
+    void waitForReaders (const unsigned int iNbOfReaders);
+
+    /**
+     * Publish the given booking request, waiting, when the ring is full,
+     * for the slowest reader to consume a record.
+     *
+     * @throw SharedRequestRingException when the ring has been closed,
+     *        or when the booking request does not fit into a record.
+     */
+    void write (const stdair::BookingRequestStruct&);
+
+    /**
+     * Close the ring: the readers get the records published so far, and
+     * are then told that there is nothing more to come. The shared
+     * memory object is removed (the readers still attached keeping
+     * their mapping).
+     */
+    void close();
+
+
+  private:
+    // ////////// Helpers /////////
+    /**
+     * Get the cursor up to which records may be published without
+     * overwriting a record not consumed yet by an attached reader.
+     * When no reader is attached, only the next record may be.
+     */
+    boost::uint64_t getWriteLimit() const;
+
+    /**
+     * Wait until the given condition holds (checked whenever a reader
+     * moves forward, attaches or detaches).
+     */
+    template <typename CONDITION>
+    void waitFor (const CONDITION& iCondition);
+
+
+  private:
+    // ////////// Constructors and destructors /////////
+    /** Default constructor (not to be used). */
+    SharedRequestRingWriter();
+    /** Copy constructor (not to be used). */
+    SharedRequestRingWriter (const SharedRequestRingWriter&);
+
+
+  private:
+    // ////////// Attributes /////////
+    /**
+     * Name of the ring, and of the underlying POSIX shared memory object.
+     */
+    std::string _name;
+    std::string _objectName;
+
+    /**
+     * Mapping of the shared memory segment.
+     */
+    void* _segment;
+    std::size_t _segmentSize;
+    SharedRequestRing::Header* _header;
+    SharedRequestRecord* _records;
+    std::size_t _mask;
+
+    /**
+     * Number of records published so far, and cursor up to which
+     * records may be published without checking the readers again.
+     */
+    boost::uint64_t _writeCursor;
+    boost::uint64_t _writeLimit;
+
+    /**
+     * Run number of the booking requests.
+     */
+    unsigned int _runNumber;
+
+    /**
+     * Whether the ring has been closed.
+     */
+    bool _isClosed;
+  };
+
+}
+#endif // __TRADEMGEN_CMD_SHAREDREQUESTRINGWRITER_HPP
@@ -0,0 +1,463 @@
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+// Boost
+#include <boost/scoped_ptr.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+// StdAir
+#include <stdair/stdair_json.hpp>
+#include <stdair/bom/BookingRequestStruct.hpp>
+#include <stdair/service/Logger.hpp>
+// TraDemGen
+#include <trademgen/TRADEMGEN_Exceptions.hpp>
+#include <trademgen/TRADEMGEN_Service.hpp>
+#include <trademgen/RequestSink.hpp>
+#include <trademgen/command/SharedRequestRing.hpp>
+#include <trademgen/command/DemandGenerationChannel.hpp>
+#include <trademgen/service/DemandGenerationServer.hpp>
+
+namespace TRADEMGEN {
+
+  namespace {
+
+    /**
+     * Thrown when the client cancels the generation session.
+     */
+    struct SessionCancelled {
+    };
+
+    // //////////////////////////////////////////////////////////////////
+    /**
+     * Quote the given string as a JSON string.
+     */
+    std::string quoteJSON (const std::string& iString) {
+      std::ostringstream oString;
+      oString << '"';
+      for (std::string::const_iterator itChar = iString.begin();
+           itChar != iString.end(); ++itChar) {
+        const char lChar = *itChar;
+        switch (lChar) {
+        case '"': oString << "\\\""; break;
+        case '\\': oString << "\\\\"; break;
+        case '\n': oString << "\\n"; break;
+        case '\r': oString << "\\r"; break;
+        case '\t': oString << "\\t"; break;
+        default:
+          if (static_cast<unsigned char> (lChar) < 0x20) {
+            oString << ' ';
+          } else {
+            oString << lChar;
+          }
+        }
+      }
+      oString << '"';
+      return oString.str();
+    }
+
+    // //////////////////////////////////////////////////////////////////
+    /**
+     * Send the given JSON document as a JSON frame.
+     */
+    void writeJSON (DemandGenerationChannel& ioChannel,
+                    const std::string& iJSON) {
+      ioChannel.writeFrame (DemandGenerationChannel::JSON_FRAME,
+                            iJSON.data(), iJSON.size());
+    }
+
+    // //////////////////////////////////////////////////////////////////
+    /**
+     * Send the given error message.
+     */
+    void writeError (DemandGenerationChannel& ioChannel,
+                     const std::string& iMessage) {
+      writeJSON (ioChannel, "{\"status\": \"error\", \"message\": "
+                 + quoteJSON (iMessage) + "}");
+    }
+
+    /**
+     * @brief Sink sending the booking requests of a generation session,
+     *        as record frames, to the client.
+     *
+     * The booking requests outside the time window, or not matching the
+     * filter, are discarded. With a credit, the sink reads the commands
+     * of the client whenever the credit is exhausted.
+     */
+    class RequestFrameSink : public RequestSink {
+    public:
+      /** Constructor. */
+      RequestFrameSink (DemandGenerationChannel& ioChannel,
+                        const std::size_t iNbOfRecordsPerFrame,
+                        const boost::property_tree::ptree& iRequest)
+        : _channel (ioChannel), _nbOfRecordsPerFrame (iNbOfRecordsPerFrame),
+          _from (boost::posix_time::neg_infin),
+          _until (boost::posix_time::pos_infin),
+          _credit (iRequest.get<boost::uint64_t> ("credit", 0)),
+          _hasCredit (_credit != 0), _nbOfSentRequests (0) {
+        assert (_nbOfRecordsPerFrame != 0);
+        _records.reserve (_nbOfRecordsPerFrame);
+
+        const std::string lFrom = iRequest.get<std::string> ("from", "");
+        if (lFrom.empty() == false) {
+          _from = boost::posix_time::time_from_string (lFrom);
+        }
+        const std::string lUntil = iRequest.get<std::string> ("until", "");
+        if (lUntil.empty() == false) {
+          _until = boost::posix_time::time_from_string (lUntil);
+        }
+        if (_from.is_not_a_date_time() == true
+            || _until.is_not_a_date_time() == true || _until < _from) {
+          throw DemandGenerationServerException ("The time window ['"
+                                                 + lFrom + "', '" + lUntil
+                                                 + "') is not valid");
+        }
+
+        _origin = iRequest.get<std::string> ("filter.origin", "");
+        _destination = iRequest.get<std::string> ("filter.destination", "");
+        _pos = iRequest.get<std::string> ("filter.pos", "");
+        _cabin = iRequest.get<std::string> ("filter.cabin", "");
+        _channelCode = iRequest.get<std::string> ("filter.channel", "");
+        _tripType = iRequest.get<std::string> ("filter.trip_type", "");
+      }
+
+      /** End of the time window (pos_infin when open). */
+      const stdair::DateTime_T& getUntil() const {
+        return _until;
+      }
+
+      /** Number of booking requests sent so far. */
+      const boost::uint64_t& getNbOfSentRequests() const {
+        return _nbOfSentRequests;
+      }
+
+      /** Keep the booking request when it matches the request. */
+      void write (const stdair::BookingRequestStruct& iRequest) {
+        const stdair::DateTime_T& lDateTime = iRequest.getRequestDateTime();
+        if (lDateTime < _from || lDateTime >= _until
+            || matches (_origin, iRequest.getOrigin()) == false
+            || matches (_destination, iRequest.getDestination()) == false
+            || matches (_pos, iRequest.getPOS()) == false
+            || matches (_cabin, iRequest.getPreferredCabin()) == false
+            || matches (_channelCode, iRequest.getBookingChannel()) == false
+            || matches (_tripType, iRequest.getTripType()) == false) {
+          return;
+        }
+
+        while (_hasCredit == true && _credit == 0) {
+          flush();
+          readCommand();
+        }
+
+        _records.push_back (SharedRequestRecord());
+        SharedRequestRing::encode (iRequest, 0, _records.back());
+        if (_hasCredit == true) {
+          --_credit;
+        }
+        if (_records.size() == _nbOfRecordsPerFrame) {
+          flush();
+        }
+      }
+
+      /** Send the pending records. */
+      void flush() {
+        if (_records.empty() == true) {
+          return;
+        }
+        _channel.writeFrame (DemandGenerationChannel::RECORD_FRAME,
+                             &_records[0], _records.size()
+                             * sizeof (SharedRequestRecord));
+        _nbOfSentRequests += _records.size();
+        _records.clear();
+      }
+
+    private:
+      /** Whether the given code matches the filter (empty for any). */
+      static bool matches (const std::string& iFilter,
+                           const std::string& iCode) {
+        return (iFilter.empty() == true || iFilter == iCode);
+      }
+
+      /** Wait for the client to grant more credit, or to cancel. */
+      void readCommand() {
+        std::string lCommand;
+        if (_channel.readLine (lCommand) == false) {
+          throw DemandGenerationServerException ("The client has closed the "
+                                                 "connection during a "
+                                                 "generation session");
+        }
+
+        boost::property_tree::ptree lTree;
+        std::istringstream lStream (lCommand);
+        try {
+          boost::property_tree::read_json (lStream, lTree);
+        } catch (const boost::property_tree::json_parser_error& iError) {
+          STDAIR_LOG_DEBUG ("Ignored command during a generation session: "
+                            << lCommand);
+          return;
+        }
+
+        if (lTree.count ("cancel") != 0) {
+          throw SessionCancelled();
+        }
+        _credit += lTree.get<boost::uint64_t> ("credit", 0);
+      }
+
+    private:
+      DemandGenerationChannel& _channel;
+      const std::size_t _nbOfRecordsPerFrame;
+      std::vector<SharedRequestRecord> _records;
+      stdair::DateTime_T _from;
+      stdair::DateTime_T _until;
+      std::string _origin;
+      std::string _destination;
+      std::string _pos;
+      std::string _cabin;
+      std::string _channelCode;
+      std::string _tripType;
+      boost::uint64_t _credit;
+      const bool _hasCredit;
+      boost::uint64_t _nbOfSentRequests;
+    };
+
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  DemandGenerationServer::
+  DemandGenerationServer (const TRADEMGEN_Service& iTRADEMGEN_Service,
+                          const std::string& iSocketPath,
+                          const stdair::RandomSeed_T& iDefaultRandomSeed,
+                          const stdair::DemandGenerationMethod& iDefaultMethod,
+                          const std::size_t iNbOfRecordsPerFrame)
+    : _trademgenService (iTRADEMGEN_Service), _socketPath (iSocketPath),
+      _listeningSocket (-1), _defaultRandomSeed (iDefaultRandomSeed),
+      _defaultDemandGenerationMethod (iDefaultMethod),
+      _nbOfRecordsPerFrame (iNbOfRecordsPerFrame), _nbOfSessions (0),
+      _isShutdown (false) {
+
+    if (_nbOfRecordsPerFrame == 0 || _nbOfRecordsPerFrame
+        > MAX_DEMAND_GENERATION_MESSAGE_SIZE / sizeof (SharedRequestRecord)) {
+      std::ostringstream oMessage;
+      oMessage << "The number of records per frame (" << _nbOfRecordsPerFrame
+               << ") must be between 1 and "
+               << MAX_DEMAND_GENERATION_MESSAGE_SIZE
+        / sizeof (SharedRequestRecord);
+      throw DemandGenerationServerException (oMessage.str());
+    }
+
+    struct sockaddr_un lAddress;
+    std::memset (&lAddress, 0, sizeof (lAddress));
+    lAddress.sun_family = AF_UNIX;
+    if (_socketPath.size() >= sizeof (lAddress.sun_path)) {
+      std::ostringstream oMessage;
+      oMessage << "The socket path '" << _socketPath << "' is too long";
+      throw DemandGenerationServerException (oMessage.str());
+    }
+    std::memcpy (lAddress.sun_path, _socketPath.data(), _socketPath.size());
+
+    // A socket left behind by a previous server is replaced, but not
+    // any other kind of file
+    struct stat lStatus;
+    if (stat (_socketPath.c_str(), &lStatus) == 0) {
+      if (S_ISSOCK (lStatus.st_mode) == false) {
+        std::ostringstream oMessage;
+        oMessage << "The socket path '" << _socketPath
+                 << "' is already taken by a file which is not a socket";
+        throw DemandGenerationServerException (oMessage.str());
+      }
+      unlink (_socketPath.c_str());
+    }
+
+    _listeningSocket = socket (AF_UNIX, SOCK_STREAM, 0);
+    if (_listeningSocket == -1
+        || bind (_listeningSocket,
+                 reinterpret_cast<struct sockaddr*> (&lAddress),
+                 sizeof (lAddress)) != 0
+        || listen (_listeningSocket, SOMAXCONN) != 0) {
+      const int lErrorNumber = errno;
+      if (_listeningSocket != -1) {
+        ::close (_listeningSocket);
+      }
+      std::ostringstream oMessage;
+      oMessage << "The demand generation server cannot listen on '"
+               << _socketPath << "': " << std::strerror (lErrorNumber);
+      throw DemandGenerationServerException (oMessage.str());
+    }
+
+    STDAIR_LOG_DEBUG ("The demand generation server listens on '"
+                      << _socketPath << "'");
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  DemandGenerationServer::~DemandGenerationServer() {
+    ::close (_listeningSocket);
+    unlink (_socketPath.c_str());
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void DemandGenerationServer::run() {
+    stdair::Count_T lNbOfConnections = 0;
+
+    while (_isShutdown == false) {
+      const int lSocket = accept (_listeningSocket, NULL, NULL);
+      if (lSocket == -1) {
+        if (errno == EINTR || errno == ECONNABORTED) {
+          continue;
+        }
+        std::ostringstream oMessage;
+        oMessage << "The demand generation server cannot accept connections "
+                 << "on '" << _socketPath << "': " << std::strerror (errno);
+        throw DemandGenerationServerException (oMessage.str());
+      }
+
+      ++lNbOfConnections;
+      std::ostringstream lPeerName;
+      lPeerName << "client #" << lNbOfConnections;
+      DemandGenerationChannel lChannel (lSocket, lPeerName.str());
+
+      // A lost connection only ends that connection
+      try {
+        std::string lCommand;
+        while (_isShutdown == false && lChannel.readLine (lCommand) == true) {
+          if (lCommand.empty() == false) {
+            serve (lChannel, lCommand);
+          }
+        }
+
+      } catch (const DemandGenerationServerException& iError) {
+        STDAIR_LOG_ERROR (iError.what());
+      }
+    }
+
+    STDAIR_LOG_DEBUG ("The demand generation server on '" << _socketPath
+                      << "' has been shut down, after " << _nbOfSessions
+                      << " generation sessions");
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void DemandGenerationServer::serve (DemandGenerationChannel& ioChannel,
+                                      const std::string& iCommand) {
+    boost::property_tree::ptree lTree;
+    std::istringstream lStream (iCommand);
+    try {
+      boost::property_tree::read_json (lStream, lTree);
+
+    } catch (const boost::property_tree::json_parser_error& iError) {
+      writeError (ioChannel, "The command '" + iCommand + "' cannot be "
+                  + "parsed: " + iError.what());
+      return;
+    }
+
+    if (lTree.count ("generate") != 0) {
+      generate (ioChannel, lTree.get_child ("generate"));
+
+    } else if (lTree.count ("credit") != 0 || lTree.count ("cancel") != 0) {
+      // Left over from a session which has already ended
+
+    } else if (lTree.count ("shutdown") != 0) {
+      _isShutdown = true;
+      writeJSON (ioChannel, "{\"status\": \"ok\"}");
+
+    } else {
+      const stdair::JSONString lJSONCommand (iCommand);
+      writeJSON (ioChannel, _trademgenService.jsonHandler (lJSONCommand));
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void DemandGenerationServer::
+  generate (DemandGenerationChannel& ioChannel,
+            const boost::property_tree::ptree& iRequest) {
+
+    // Validate the request, before telling the client it is accepted
+    boost::scoped_ptr<RequestFrameSink> lRequestFrameSink_ptr;
+    stdair::RandomSeed_T lRandomSeed = _defaultRandomSeed;
+    stdair::DemandGenerationMethod lDemandGenerationMethod =
+      _defaultDemandGenerationMethod;
+    try {
+      lRandomSeed = iRequest.get<stdair::RandomSeed_T> ("seed",
+                                                        _defaultRandomSeed);
+      const std::string lMethod = iRequest.get<std::string> ("method", "");
+      if (lMethod.empty() == false) {
+        lDemandGenerationMethod = stdair::DemandGenerationMethod (lMethod[0]);
+      }
+      lRequestFrameSink_ptr.reset (new RequestFrameSink (ioChannel,
+                                                         _nbOfRecordsPerFrame,
+                                                         iRequest));
+
+    } catch (const DemandGenerationServerException& iError) {
+      writeError (ioChannel, iError.what());
+      return;
+
+    } catch (const std::exception& iError) {
+      writeError (ioChannel, std::string ("The generation request is not "
+                                          "valid: ") + iError.what());
+      return;
+    }
+    assert (lRequestFrameSink_ptr != NULL);
+    RequestFrameSink& lRequestFrameSink = *lRequestFrameSink_ptr;
+
+    ++_nbOfSessions;
+    std::ostringstream oStartStatus;
+    oStartStatus << "{\"status\": \"started\", \"version\": "
+                 << DEMAND_GENERATION_PROTOCOL_VERSION
+                 << ", \"record_size\": " << sizeof (SharedRequestRecord)
+                 << ", \"session\": " << _nbOfSessions << "}";
+    writeJSON (ioChannel, oStartStatus.str());
+
+    // The whole demand is generated when no end is given
+    stdair::DateTime_T lUntil = lRequestFrameSink.getUntil();
+    if (lUntil.is_pos_infinity() == true) {
+      lUntil = stdair::DateTime_T (stdair::Date_T (9999, 12, 31));
+    }
+
+    std::string lFinalStatus = "done";
+    std::string lMessage;
+    try {
+      _trademgenService.reseed (lRandomSeed);
+      _trademgenService.generateFirstRequests (lDemandGenerationMethod);
+      _trademgenService.generateUntil (lUntil, lRequestFrameSink,
+                                       lDemandGenerationMethod);
+      lRequestFrameSink.flush();
+
+    } catch (const SessionCancelled&) {
+      lFinalStatus = "cancelled";
+
+    } catch (const DemandGenerationServerException& iError) {
+      // The connection is lost
+      throw;
+
+    } catch (const std::exception& iError) {
+      lFinalStatus = "error";
+      lMessage = iError.what();
+      STDAIR_LOG_ERROR ("The generation session #" << _nbOfSessions
+                        << " has failed: " << lMessage);
+    }
+
+    std::ostringstream oFinalStatus;
+    oFinalStatus << "{\"status\": \"" << lFinalStatus << "\", "
+                 << "\"nb_of_requests\": "
+                 << lRequestFrameSink.getNbOfSentRequests();
+    if (lMessage.empty() == false) {
+      oFinalStatus << ", \"message\": " << quoteJSON (lMessage);
+    }
+    oFinalStatus << "}";
+    writeJSON (ioChannel, oFinalStatus.str());
+
+    STDAIR_LOG_DEBUG ("Generation session #" << _nbOfSessions << ": "
+                      << lFinalStatus << ", "
+                      << lRequestFrameSink.getNbOfSentRequests()
+                      << " booking requests sent");
+  }
+
+}
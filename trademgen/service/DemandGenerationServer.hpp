@@ -0,0 +1,165 @@
+#ifndef __TRADEMGEN_SVC_DEMANDGENERATIONSERVER_HPP
+#define __TRADEMGEN_SVC_DEMANDGENERATIONSERVER_HPP
+
+// //////////////////////////////////////////////////////////////////////
+// Import section
+// //////////////////////////////////////////////////////////////////////
+// STL
+#include <string>
+// Boost
+#include <boost/property_tree/ptree_fwd.hpp>
+// StdAir
+#include <stdair/stdair_basic_types.hpp>
+#include <stdair/stdair_maths_types.hpp>
+#include <stdair/basic/DemandGenerationMethod.hpp>
+// TraDemGen
+#include <trademgen/basic/BasConst_DemandGenerationServer.hpp>
+
+namespace TRADEMGEN {
+
+  // Forward declarations
+  class TRADEMGEN_Service;
+  class DemandGenerationChannel;
+
+  /**
+   * @brief Resident demand generation server, serving generation
+   *        sessions over a Unix domain socket, with the demand loaded
+   *        once for all.
+   *
+   * The clients (see DemandGenerationClient) connect to the socket, and
+   * send commands, i.e., JSON documents, one per line (see
+   * DemandGenerationChannel for the answers):
+   * <ul>
+   *   <li>{"generate": {...}} runs a generation session. All the fields
+   *       are optional: "seed" (the seed of the server by default),
+   *       "method" ("P" or "S", the method of the server by default),
+   *       "from" and "until" (e.g., "2010-01-15 00:00:00", the requests
+   *       of which the date-time lies outside [from, until) being
+   *       discarded), "filter" (with any of the "origin", "destination",
+   *       "pos", "cabin", "channel" and "trip_type" fields, the requests
+   *       not matching all of them being discarded) and "credit".
+   *       The server answers with a JSON frame, either {"status":
+   *       "started", ...} or {"status": "error", "message": ...}, then
+   *       with record frames, and eventually with a JSON frame giving
+   *       the final status ("done", "cancelled" or "error") and the
+   *       number of sent requests;</li>
+   *   <li>with a credit, the server sends no more than that number of
+   *       requests, until the client grants more with {"credit": N}
+   *       (not answered); {"cancel": {}} then stops the session;</li>
+   *   <li>{"shutdown": {}} stops the server, once the answer sent;</li>
+   *   <li>any other command is handed over to
+   *       TRADEMGEN_Service::jsonHandler(), the answer of which is sent
+   *       back as a JSON frame.</li>
+   * </ul>
+   *
+   * Every session seeds the demand streams again from its seed (see
+   * TRADEMGEN_Service::reseed()), so that the same request always gives
+   * the same booking requests. The sessions are served one at a time.
+   */
+  class DemandGenerationServer {
+  public:
+    // ////////// Constructors and destructors /////////
+    /**
+     * Constructor. The server listens on the socket, replacing any
+     * (stale) socket at the same path.
+     *
+     * @param const TRADEMGEN_Service& TraDemGen service, the demand of
+     *        which has been loaded.
+     * @param const std::string& Path of the Unix domain socket.
+     * @param const stdair::RandomSeed_T& Default seed of the sessions.
+     * @param const stdair::DemandGenerationMethod& Default method of the
+     *        sessions.
+     * @param const std::size_t Maximal number of request records per
+     *        frame.
+     * @throw DemandGenerationServerException when the socket cannot be
+     *        created.
+     */
+    DemandGenerationServer (const TRADEMGEN_Service&, const std::string&,
+                            const stdair::RandomSeed_T&,
+                            const stdair::DemandGenerationMethod&,
+                            const std::size_t iNbOfRecordsPerFrame =
+                            DEFAULT_NB_OF_RECORDS_PER_FRAME);
+
+    /**
+     * Destructor. The socket is closed and removed.
+     */
+    ~DemandGenerationServer();
+
+
+  public:
+    // ////////// Getters /////////
+    /** Get the path of the socket. */
+    const std::string& getSocketPath() const {
+      return _socketPath;
+    }
+
+    /** Get the number of generation sessions served so far. */
+    const stdair::Count_T& getNbOfSessions() const {
+      return _nbOfSessions;
+    }
+
+
+  public:
+    // ////////// Business methods /////////
+    /**
+     * Serve the clients, one connection at a time, until one of them
+     * sends the shutdown command.
+     */
+    void run();
+
+
+  private:
+    // ////////// Helpers /////////
+    /**
+     * Serve the given command, received on the given connection.
+     */
+    void serve (DemandGenerationChannel&, const std::string& iCommand);
+
+    /**
+     * Run the generation session described by the given request.
+     */
+    void generate (DemandGenerationChannel&,
+                   const boost::property_tree::ptree& iRequest);
+
+
+  private:
+    // ////////// Constructors and destructors /////////
+    /** Default constructor (not to be used). */
+    DemandGenerationServer();
+    /** Copy constructor (not to be used). */
+    DemandGenerationServer (const DemandGenerationServer&);
+
+
+  private:
+    // ////////// Attributes /////////
+    /**
+     * TraDemGen service, generating the requests.
+     */
+    const TRADEMGEN_Service& _trademgenService;
+
+    /**
+     * Path of the socket, and listening socket.
+     */
+    std::string _socketPath;
+    int _listeningSocket;
+
+    /**
+     * Defaults of the generation sessions.
+     */
+    stdair::RandomSeed_T _defaultRandomSeed;
+    stdair::DemandGenerationMethod _defaultDemandGenerationMethod;
+    std::size_t _nbOfRecordsPerFrame;
+
+    /**
+     * Number of generation sessions served so far.
+     */
+    stdair::Count_T _nbOfSessions;
+
+    /**
+     * Whether a client has sent the shutdown command.
+     */
+    bool _isShutdown;
+  };
+
+}
+#endif // __TRADEMGEN_SVC_DEMANDGENERATIONSERVER_HPP
@@ -27,13 +27,22 @@
 // SEvMgr
 #include <sevmgr/SEVMGR_Service.hpp>
 // TraDemGen
+#include <trademgen/basic/ArrivalCountTable.hpp>
 #include <trademgen/basic/BasConst_TRADEMGEN_Service.hpp>
+#include <trademgen/basic/BasConst_DemandLoading.hpp>
+#include <trademgen/basic/ParallelTasks.hpp>
+#include <trademgen/basic/RequestFieldMask.hpp>
 #include <trademgen/bom/BomDisplay.hpp>
+#include <trademgen/bom/DemandAdjustmentStruct.hpp>
+#include <trademgen/bom/DemandFilterStruct.hpp>
 #include <trademgen/bom/DemandStream.hpp>
+#include <trademgen/bom/DemandStreamSchedule.hpp>
 #include <trademgen/bom/DemandStreamTypes.hpp>
 #include <trademgen/factory/FacTRADEMGENServiceContext.hpp>
 #include <trademgen/command/DemandParser.hpp>
 #include <trademgen/command/DemandManager.hpp>
+#include <trademgen/command/CompiledDemandModel.hpp>
+#include <trademgen/command/RequestPipeline.hpp>
 #include <trademgen/service/TRADEMGEN_ServiceContext.hpp>
 #include <trademgen/TRADEMGEN_Service.hpp>
 
@@ -236,9 +245,58 @@ namespace TRADEMGEN {
     // calling the buildSampleBom() method
   }
 
+  // //////////////////////////////////////////////////////////////////////
+  void TRADEMGEN_Service::
+  setDemandFilter (const DemandFilterStruct& iDemandFilter) {
+
+    // Retrieve the TraDemGen service context
+    if (_trademgenServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The TraDemGen service has "
+                                                    "not been initialised");
+    }
+    assert (_trademgenServiceContext != NULL);
+    TRADEMGEN_ServiceContext& lTRADEMGEN_ServiceContext =
+      *_trademgenServiceContext;
+
+    lTRADEMGEN_ServiceContext.setDemandFilter (iDemandFilter);
+
+    // DEBUG
+    STDAIR_LOG_DEBUG ("Demand streams to be loaded: "
+                      << iDemandFilter.describe());
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void TRADEMGEN_Service::
+  setMultiCabinDemand (const bool iIsMultiCabinDemand) {
+
+    // Retrieve the TraDemGen service context
+    if (_trademgenServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The TraDemGen service has "
+                                                    "not been initialised");
+    }
+    assert (_trademgenServiceContext != NULL);
+    TRADEMGEN_ServiceContext& lTRADEMGEN_ServiceContext =
+      *_trademgenServiceContext;
+
+    lTRADEMGEN_ServiceContext.setMultiCabinDemand (iIsMultiCabinDemand);
+
+    // DEBUG
+    STDAIR_LOG_DEBUG ("The cabins share their demand streams: "
+                      << iIsMultiCabinDemand);
+  }
+
   // //////////////////////////////////////////////////////////////////////
   void TRADEMGEN_Service::
   parseAndLoad (const DemandFilePath& iDemandFilePath) { 
+    DemandFilePathList_T lDemandFilePathList;
+    lDemandFilePathList.push_back (iDemandFilePath);
+    parseAndLoad (lDemandFilePathList, DEFAULT_NB_OF_LOADING_THREADS);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void TRADEMGEN_Service::
+  parseAndLoad (const DemandFilePathList_T& iDemandFilePathList,
+                const unsigned int iNbOfThreads) { 
 
     // Retrieve the TraDemGen service context
     if (_trademgenServiceContext == NULL) {
@@ -275,11 +333,34 @@ namespace TRADEMGEN {
       lTRADEMGEN_ServiceContext.getPOSProbabilityMass();
 
     /**
-     * 1. Parse the input file and initialise the demand generators
+     * 1. Parse and compile the input files, and initialise the demand
+     *    generators. The compiled demands are kept, so that the input
+     *    files can later be reloaded incrementally (see reloadDemand()).
      */
     stdair::BasChronometer lDemandGeneration; lDemandGeneration.start();
-    DemandParser::generateDemand (iDemandFilePath, lSEVMGR_Service_ptr,
-                                  lSharedGenerator, lDefaultPOSProbabilityMass);
+    const unsigned int lNbOfThreads = getNbOfThreads (iNbOfThreads);
+    CompiledDemandModelList_T lCompiledDemandModelList;
+    DemandParser::compileDemand (iDemandFilePathList, lSharedGenerator,
+                                 lDefaultPOSProbabilityMass,
+                                 lCompiledDemandModelList, lNbOfThreads);
+    if (lTRADEMGEN_ServiceContext.isMultiCabinDemand() == true) {
+      DemandManager::
+        createMultiCabinDemandCharacteristics (lSEVMGR_Service_ptr,
+                                               lSharedGenerator,
+                                               lDefaultPOSProbabilityMass,
+                                               lCompiledDemandModelList,
+                                               lTRADEMGEN_ServiceContext.
+                                               getDemandFilter());
+    } else {
+      DemandManager::createDemandCharacteristics (lSEVMGR_Service_ptr,
+                                                  lSharedGenerator,
+                                                  lDefaultPOSProbabilityMass,
+                                                  lCompiledDemandModelList,
+                                                  lTRADEMGEN_ServiceContext.
+                                                  getDemandFilter(),
+                                                  lNbOfThreads);
+    }
+    lTRADEMGEN_ServiceContext.addLoadedDemandModelList (lCompiledDemandModelList);
     const double lGenerationMeasure = lDemandGeneration.elapsed();  
 
     /**
@@ -294,7 +375,264 @@ namespace TRADEMGEN {
     buildComplementaryLinks (lPersistentBomRoot);
 
     // DEBUG
-    STDAIR_LOG_DEBUG ("Demand generation time: " << lGenerationMeasure);
+    STDAIR_LOG_DEBUG ("Demand generation time: " << lGenerationMeasure
+                      << " (" << iDemandFilePathList.size() << " file(s), "
+                      << lNbOfThreads << " thread(s))");
+
+    /**
+     * 4. Have TraDemGen clone the whole persistent BOM tree, only when the StdAir
+     *    service is owned by the current component (TraDemGen here)
+     */
+    if (doesOwnStdairService == true) {
+      //
+      clonePersistentBom ();
+    }
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void TRADEMGEN_Service::
+  compileDemand (const DemandFilePath& iDemandFilePath,
+                 const stdair::Filename_T& iCompiledModelFilename) {
+
+    // Retrieve the TraDemGen service context
+    if (_trademgenServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The TraDemGen service has "
+                                                    "not been initialised");
+    }
+    assert (_trademgenServiceContext != NULL);
+
+    TRADEMGEN_ServiceContext& lTRADEMGEN_ServiceContext =
+      *_trademgenServiceContext;
+
+    // Retrieve the shared generator
+    stdair::RandomGeneration& lSharedGenerator =
+      lTRADEMGEN_ServiceContext.getUniformGenerator();
+
+    // Retrieve the default POS distribution
+    const POSProbabilityMass_T& lDefaultPOSProbabilityMass =
+      lTRADEMGEN_ServiceContext.getPOSProbabilityMass();
+
+    /**
+     * 1. Parse the input file and compile the demands
+     */
+    stdair::BasChronometer lDemandCompilation; lDemandCompilation.start();
+    CompiledDemandModel lCompiledDemandModel;
+    DemandParser::compileDemand (iDemandFilePath, lSharedGenerator,
+                                 lDefaultPOSProbabilityMass,
+                                 lCompiledDemandModel);
+
+    /**
+     * 2. Write the compiled demand model
+     */
+    lCompiledDemandModel.save (iCompiledModelFilename);
+    const double lCompilationMeasure = lDemandCompilation.elapsed();
+
+    // DEBUG
+    STDAIR_LOG_DEBUG ("Demand compilation time: " << lCompilationMeasure
+                      << " (" << lCompiledDemandModel.getNbOfDemands()
+                      << " demands written into '" << iCompiledModelFilename
+                      << "')");
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void TRADEMGEN_Service::
+  loadCompiledModel (const stdair::Filename_T& iCompiledModelFilename) {
+
+    // Retrieve the TraDemGen service context
+    if (_trademgenServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The TraDemGen service has "
+                                                    "not been initialised");
+    }
+    assert (_trademgenServiceContext != NULL);
+
+    // Retrieve the TraDemGen service context and whether it owns the Stdair
+    // service
+    TRADEMGEN_ServiceContext& lTRADEMGEN_ServiceContext =
+      *_trademgenServiceContext;
+    const bool doesOwnStdairService =
+      lTRADEMGEN_ServiceContext.getOwnStdairServiceFlag();   
+
+    // Retrieve the StdAir service object from the (TRADEMGEN) service context
+    stdair::STDAIR_Service& lSTDAIR_Service =
+      lTRADEMGEN_ServiceContext.getSTDAIR_Service();
+
+    // Retrieve the persistent BOM root object.
+    stdair::BomRoot& lPersistentBomRoot = 
+      lSTDAIR_Service.getPersistentBomRoot();
+
+    // Retrieve the pointer on the SEvMgr service handler.
+    SEVMGR::SEVMGR_ServicePtr_T lSEVMGR_Service_ptr =
+      lTRADEMGEN_ServiceContext.getSEVMGR_ServicePtr();
+    
+    // Retrieve the shared generator
+    stdair::RandomGeneration& lSharedGenerator =
+      lTRADEMGEN_ServiceContext.getUniformGenerator();
+
+    // Retrieve the default POS distribution
+    const POSProbabilityMass_T& lDefaultPOSProbabilityMass =
+      lTRADEMGEN_ServiceContext.getPOSProbabilityMass();
+
+    /**
+     * 1. Map the compiled demand model, and initialise the demand
+     *    generators, as if it were in the order of the demand input file
+     */
+    stdair::BasChronometer lDemandGeneration; lDemandGeneration.start();
+    CompiledDemandModelPtr_T lCompiledDemandModel_ptr =
+      boost::make_shared<CompiledDemandModel>();
+    lCompiledDemandModel_ptr->load (iCompiledModelFilename);
+
+    CompiledDemandModelList_T lCompiledDemandModelList;
+    lCompiledDemandModelList.push_back (lCompiledDemandModel_ptr);
+    if (lTRADEMGEN_ServiceContext.isMultiCabinDemand() == true) {
+      DemandManager::
+        createMultiCabinDemandCharacteristics (lSEVMGR_Service_ptr,
+                                               lSharedGenerator,
+                                               lDefaultPOSProbabilityMass,
+                                               lCompiledDemandModelList,
+                                               lTRADEMGEN_ServiceContext.
+                                               getDemandFilter());
+    } else {
+      DemandManager::createDemandCharacteristics (lSEVMGR_Service_ptr,
+                                                  lSharedGenerator,
+                                                  lDefaultPOSProbabilityMass,
+                                                  lCompiledDemandModelList,
+                                                  lTRADEMGEN_ServiceContext.
+                                                  getDemandFilter(),
+                                                  DEFAULT_NB_OF_LOADING_THREADS);
+    }
+    lTRADEMGEN_ServiceContext.addLoadedDemandModelList (lCompiledDemandModelList);
+    const double lGenerationMeasure = lDemandGeneration.elapsed();  
+
+    /**
+     * 2. Build the complementary links
+     */
+    buildComplementaryLinks (lPersistentBomRoot);
+
+    // DEBUG
+    STDAIR_LOG_DEBUG ("Demand generation time (from the compiled model): "
+                      << lGenerationMeasure);
+
+    /**
+     * 3. Have TraDemGen clone the whole persistent BOM tree, only when the
+     *    StdAir service is owned by the current component (TraDemGen here)
+     */
+    if (doesOwnStdairService == true) {
+      //
+      clonePersistentBom ();
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void TRADEMGEN_Service::
+  reloadDemand (const DemandFilePath& iDemandFilePath) { 
+    DemandFilePathList_T lDemandFilePathList;
+    lDemandFilePathList.push_back (iDemandFilePath);
+    reloadDemand (lDemandFilePathList, DEFAULT_NB_OF_LOADING_THREADS);
+  }
+
+  // //////////////////////////////////////////////////////////////////////
+  void TRADEMGEN_Service::
+  reloadDemand (const DemandFilePathList_T& iDemandFilePathList,
+                const unsigned int iNbOfThreads) { 
+
+    // Retrieve the TraDemGen service context
+    if (_trademgenServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The TraDemGen service has "
+                                                    "not been initialised");
+    }
+    assert (_trademgenServiceContext != NULL);
+
+    // Retrieve the TraDemGen service context and whether it owns the Stdair
+    // service
+    TRADEMGEN_ServiceContext& lTRADEMGEN_ServiceContext =
+      *_trademgenServiceContext;
+    const bool doesOwnStdairService =
+      lTRADEMGEN_ServiceContext.getOwnStdairServiceFlag();   
+
+    // Retrieve the StdAir service object from the (TRADEMGEN) service context
+    stdair::STDAIR_Service& lSTDAIR_Service =
+      lTRADEMGEN_ServiceContext.getSTDAIR_Service();
+
+    // Retrieve the persistent BOM root object.
+    stdair::BomRoot& lPersistentBomRoot = 
+      lSTDAIR_Service.getPersistentBomRoot();
+
+    // Retrieve the pointer on the SEvMgr service handler.
+    SEVMGR::SEVMGR_ServicePtr_T lSEVMGR_Service_ptr =
+      lTRADEMGEN_ServiceContext.getSEVMGR_ServicePtr();
+    
+    // Retrieve the shared generator
+    stdair::RandomGeneration& lSharedGenerator =
+      lTRADEMGEN_ServiceContext.getUniformGenerator();
+
+    // Retrieve the default POS distribution
+    const POSProbabilityMass_T& lDefaultPOSProbabilityMass =
+      lTRADEMGEN_ServiceContext.getPOSProbabilityMass();
+
+    // The scheduled demand streams are not known by the event queue
+    if (lTRADEMGEN_ServiceContext.getDemandStreamSchedule().isEmpty() == false) {
+      throw DemandReloadException ("The demand input files cannot be reloaded "
+                                   "for the rolling-horizon demand generation");
+    }
+
+    // The demand streams are not those of the demands anymore
+    if (lTRADEMGEN_ServiceContext.isMultiCabinDemand() == true) {
+      throw DemandReloadException ("The demand input files cannot be reloaded "
+                                   "when the cabins share their demand "
+                                   "streams");
+    }
+
+    /**
+     * 1. Parse and compile the input files
+     */
+    stdair::BasChronometer lDemandReloading; lDemandReloading.start();
+    const unsigned int lNbOfThreads = getNbOfThreads (iNbOfThreads);
+    CompiledDemandModelList_T lCompiledDemandModelList;
+    DemandParser::compileDemand (iDemandFilePathList, lSharedGenerator,
+                                 lDefaultPOSProbabilityMass,
+                                 lCompiledDemandModelList, lNbOfThreads);
+
+    /**
+     * 2. Compare the new demands with the ones loaded so far, and
+     *    update the demand generators accordingly
+     */
+    DemandManager::
+      reloadDemandCharacteristics (lSEVMGR_Service_ptr, lSharedGenerator,
+                                   lDefaultPOSProbabilityMass,
+                                   lTRADEMGEN_ServiceContext.
+                                   getLoadedDemandModelList(),
+                                   lCompiledDemandModelList,
+                                   lTRADEMGEN_ServiceContext.
+                                   getDemandFilter());
+    lTRADEMGEN_ServiceContext.setLoadedDemandModelList (lCompiledDemandModelList);
+    lTRADEMGEN_ServiceContext.getTotalNumberOfRequestsTable().clear();
+    lTRADEMGEN_ServiceContext.getDemandStreamSnapshot().clear();
+
+    // The new demand streams belong to the shard, if any, as well
+    if (lTRADEMGEN_ServiceContext.getNbOfShards() != 0) {
+      DemandManager::
+        shardDemandStreams (lSEVMGR_Service_ptr,
+                            lTRADEMGEN_ServiceContext.getShardIndex(),
+                            lTRADEMGEN_ServiceContext.getNbOfShards());
+    }
+
+    // So are their fields projected, if any
+    if (lTRADEMGEN_ServiceContext.isProjected() == true) {
+      DemandManager::
+        projectDemandStreams (lSEVMGR_Service_ptr, true,
+                              lTRADEMGEN_ServiceContext.getRequestFieldMask());
+    }
+    const double lReloadingMeasure = lDemandReloading.elapsed();  
+
+    /**
+     * 3. Build the complementary links
+     */
+    buildComplementaryLinks (lPersistentBomRoot);
+
+    // DEBUG
+    STDAIR_LOG_DEBUG ("Demand reloading time: " << lReloadingMeasure
+                      << " (" << iDemandFilePathList.size() << " file(s), "
+                      << lNbOfThreads << " thread(s))");
 
     /**
      * 4. Have TraDemGen clone the whole persistent BOM tree, only when the StdAir
@@ -306,6 +644,91 @@ namespace TRADEMGEN {
     }
   }
 
+  // //////////////////////////////////////////////////////////////////////
+  void TRADEMGEN_Service::
+  parseAndSchedule (const DemandFilePath& iDemandFilePath) { 
+
+    // Retrieve the TraDemGen service context
+    if (_trademgenServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The TraDemGen service has "
+                                                    "not been initialised");
+    }
+    assert (_trademgenServiceContext != NULL);
+
+    // Retrieve the TraDemGen service context and whether it owns the Stdair
+    // service
+    TRADEMGEN_ServiceContext& lTRADEMGEN_ServiceContext =
+      *_trademgenServiceContext;
+    const bool doesOwnStdairService =
+      lTRADEMGEN_ServiceContext.getOwnStdairServiceFlag();   
+
+    // Retrieve the StdAir service object from the (TRADEMGEN) service context
+    stdair::STDAIR_Service& lSTDAIR_Service =
+      lTRADEMGEN_ServiceContext.getSTDAIR_Service();
+
+    // Retrieve the persistent BOM root object.
+    stdair::BomRoot& lPersistentBomRoot = 
+      lSTDAIR_Service.getPersistentBomRoot();
+
+    // Retrieve the pointer on the SEvMgr service handler.
+    SEVMGR::SEVMGR_ServicePtr_T lSEVMGR_Service_ptr =
+      lTRADEMGEN_ServiceContext.getSEVMGR_ServicePtr();
+    
+    // Retrieve the shared generator
+    stdair::RandomGeneration& lSharedGenerator =
+      lTRADEMGEN_ServiceContext.getUniformGenerator();
+
+    // Retrieve the default POS distribution
+    const POSProbabilityMass_T& lDefaultPOSProbabilityMass =
+      lTRADEMGEN_ServiceContext.getPOSProbabilityMass();
+
+    // The schedule is made of the demand streams of the demands
+    if (lTRADEMGEN_ServiceContext.isMultiCabinDemand() == true) {
+      throw TrademgenGenerationException ("The demand streams cannot be "
+                                          "scheduled when the cabins share "
+                                          "their demand streams");
+    }
+
+    /**
+     * 1. Parse and compile the input file, and schedule the demand
+     *    streams. Those are created later on, along the generation (see
+     *    DemandManager::advanceRollingHorizon()).
+     */
+    stdair::BasChronometer lDemandScheduling; lDemandScheduling.start();
+    DemandFilePathList_T lDemandFilePathList;
+    lDemandFilePathList.push_back (iDemandFilePath);
+    CompiledDemandModelList_T lCompiledDemandModelList;
+    DemandParser::compileDemand (lDemandFilePathList, lSharedGenerator,
+                                 lDefaultPOSProbabilityMass,
+                                 lCompiledDemandModelList,
+                                 getNbOfThreads (DEFAULT_NB_OF_LOADING_THREADS));
+    DemandManager::
+      scheduleDemandCharacteristics (lSEVMGR_Service_ptr, lSharedGenerator,
+                                     lCompiledDemandModelList,
+                                     lTRADEMGEN_ServiceContext.
+                                     getDemandFilter(),
+                                     lTRADEMGEN_ServiceContext.
+                                     getDemandStreamSchedule());
+    const double lSchedulingMeasure = lDemandScheduling.elapsed();  
+
+    /**
+     * 2. Build the complementary links
+     */
+    buildComplementaryLinks (lPersistentBomRoot);
+
+    // DEBUG
+    STDAIR_LOG_DEBUG ("Demand scheduling time: " << lSchedulingMeasure);
+
+    /**
+     * 3. Have TraDemGen clone the whole persistent BOM tree, only when the StdAir
+     *    service is owned by the current component (TraDemGen here)
+     */
+    if (doesOwnStdairService == true) {
+      //
+      clonePersistentBom ();
+    }
+  }
+
   // ////////////////////////////////////////////////////////////////////
   void TRADEMGEN_Service::buildSampleBom() {
 
@@ -675,7 +1098,17 @@ namespace TRADEMGEN {
     stdair::RandomGeneration& lGenerator =
       lTRADEMGEN_ServiceContext.getUniformGenerator();
 
-    // Delegate the call to the dedicated command
+    // The scheduled demand streams, if any, are opened along the
+    // generation
+    DemandStreamSchedule& lDemandStreamSchedule =
+      lTRADEMGEN_ServiceContext.getDemandStreamSchedule();
+    if (lDemandStreamSchedule.isEmpty() == false) {
+      return DemandManager::startRollingHorizon (lSEVMGR_Service_ptr,
+                                                 iDemandGenerationMethod,
+                                                 lDemandStreamSchedule);
+    }
+
+    // Delegate the call to the dedicated command
     const stdair::Count_T& oActualTotalNbOfEvents =
       DemandManager::generateFirstRequests (lSEVMGR_Service_ptr, lGenerator,
                                             iDemandGenerationMethod);
@@ -708,6 +1141,27 @@ namespace TRADEMGEN {
                                                iDemandGenerationMethod);
   }
 
+  // ////////////////////////////////////////////////////////////////////
+  stdair::RealNumber_T TRADEMGEN_Service::
+  getSamplingWeight (const stdair::BookingRequestStruct& iRequest) const {
+
+    // Retrieve the TraDemGen service context
+    if (_trademgenServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The TraDemGen service has "
+                                                    "not been initialised");
+    }
+    assert (_trademgenServiceContext != NULL);
+    TRADEMGEN_ServiceContext& lTRADEMGEN_ServiceContext =
+      *_trademgenServiceContext;
+
+    // Retrieve the pointer on the SEvMgr service handler.
+    SEVMGR::SEVMGR_ServicePtr_T lSEVMGR_Service_ptr =
+      lTRADEMGEN_ServiceContext.getSEVMGR_ServicePtr();
+
+    // Delegate the call to the dedicated command
+    return DemandManager::getSamplingWeight (lSEVMGR_Service_ptr, iRequest);
+  }
+
   // ////////////////////////////////////////////////////////////////////
   stdair::ProgressStatusSet TRADEMGEN_Service::
   popEvent (stdair::EventStruct& ioEventStruct) const {
@@ -717,12 +1171,184 @@ namespace TRADEMGEN {
     TRADEMGEN_ServiceContext& lTRADEMGEN_ServiceContext =
       *_trademgenServiceContext;
 
-    // Retrieve the SEvMgr service context
-    SEVMGR::SEVMGR_Service& lSEVMGR_Service =
-      lTRADEMGEN_ServiceContext.getSEVMGR_Service();
+    // Retrieve the pointer on the SEvMgr service handler.
+    SEVMGR::SEVMGR_ServicePtr_T lSEVMGR_Service_ptr =
+      lTRADEMGEN_ServiceContext.getSEVMGR_ServicePtr();
     
+    // Extract the next event from the queue, opening the scheduled
+    // demand streams, if any, along the way
+    DemandStreamSchedule& lDemandStreamSchedule =
+      lTRADEMGEN_ServiceContext.getDemandStreamSchedule();
+    if (lDemandStreamSchedule.isEmpty() == false) {
+      return DemandManager::popEvent (lSEVMGR_Service_ptr,
+                                      lTRADEMGEN_ServiceContext.
+                                      getUniformGenerator(),
+                                      lTRADEMGEN_ServiceContext.
+                                      getPOSProbabilityMass(),
+                                      lDemandStreamSchedule, ioEventStruct);
+    }
+
     // Extract the next event from the queue
-    return lSEVMGR_Service.popEvent (ioEventStruct);
+    return DemandManager::popEvent (lSEVMGR_Service_ptr, ioEventStruct);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  stdair::Count_T TRADEMGEN_Service::
+  generateUntil (const stdair::DateTime_T& iDateTime,
+                 RequestSink& ioRequestSink,
+                 const stdair::DemandGenerationMethod& iDemandGenerationMethod) const {
+
+    // Retrieve the TraDemGen service context
+    if (_trademgenServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The TraDemGen service has "
+                                                    "not been initialised");
+    }
+    assert (_trademgenServiceContext != NULL);
+    TRADEMGEN_ServiceContext& lTRADEMGEN_ServiceContext =
+      *_trademgenServiceContext;
+
+    // Retrieve the pointer on the SEvMgr service handler.
+    SEVMGR::SEVMGR_ServicePtr_T lSEVMGR_Service_ptr =
+      lTRADEMGEN_ServiceContext.getSEVMGR_ServicePtr();
+
+    // Retrieve the random generator
+    stdair::RandomGeneration& lGenerator =
+      lTRADEMGEN_ServiceContext.getUniformGenerator();
+
+    // Delegate the call to the dedicated command
+    return DemandManager::generateUntil (lSEVMGR_Service_ptr, lGenerator,
+                                         lTRADEMGEN_ServiceContext.
+                                         getPOSProbabilityMass(),
+                                         iDemandGenerationMethod, iDateTime,
+                                         lTRADEMGEN_ServiceContext.
+                                         getDemandStreamSchedule(),
+                                         ioRequestSink);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void TRADEMGEN_Service::
+  startRequestPipeline (RequestPipeline& ioRequestPipeline,
+                        const stdair::DemandGenerationMethod& iDemandGenerationMethod) const {
+
+    // Retrieve the TraDemGen service context
+    if (_trademgenServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The TraDemGen service has "
+                                                    "not been initialised");
+    }
+    assert (_trademgenServiceContext != NULL);
+    TRADEMGEN_ServiceContext& lTRADEMGEN_ServiceContext =
+      *_trademgenServiceContext;
+
+    // The scheduled demand streams are only opened along the generation
+    if (lTRADEMGEN_ServiceContext.getDemandStreamSchedule().isEmpty() == false) {
+      throw RequestPipelineException ("The rolling-horizon demand generation "
+                                      "cannot be run in the background");
+    }
+
+    // Retrieve the pointer on the SEvMgr service handler.
+    SEVMGR::SEVMGR_ServicePtr_T lSEVMGR_Service_ptr =
+      lTRADEMGEN_ServiceContext.getSEVMGR_ServicePtr();
+
+    // Retrieve the random generator
+    stdair::RandomGeneration& lGenerator =
+      lTRADEMGEN_ServiceContext.getUniformGenerator();
+
+    // Delegate the generation to the dedicated command, on the
+    // background thread of the pipeline
+    const stdair::DemandGenerationMethod lDemandGenerationMethod =
+      iDemandGenerationMethod;
+    ioRequestPipeline.start ([lSEVMGR_Service_ptr, &lGenerator,
+                              lDemandGenerationMethod] (RequestSink& ioSink) {
+        DemandManager::generateRun (lSEVMGR_Service_ptr, lGenerator,
+                                    lDemandGenerationMethod, &ioSink);
+      });
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  stdair::Count_T TRADEMGEN_Service::
+  generateRunByStream (RequestSink& ioRequestSink,
+                       const stdair::DemandGenerationMethod& iDemandGenerationMethod,
+                       const unsigned int iNbOfThreads) const {
+    // The booking requests are not aggregated
+    return generateAggregatedRunByStream (ioRequestSink,
+                                          iDemandGenerationMethod,
+                                          stdair::Duration_T (0, 0, 0),
+                                          iNbOfThreads);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  stdair::Count_T TRADEMGEN_Service::
+  generateAggregatedRunByStream (RequestSink& ioRequestSink,
+                                 const stdair::DemandGenerationMethod& iDemandGenerationMethod,
+                                 const stdair::Duration_T& iAggregationPeriod,
+                                 const unsigned int iNbOfThreads) const {
+
+    // Retrieve the TraDemGen service context
+    if (_trademgenServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The TraDemGen service has "
+                                                    "not been initialised");
+    }
+    assert (_trademgenServiceContext != NULL);
+    TRADEMGEN_ServiceContext& lTRADEMGEN_ServiceContext =
+      *_trademgenServiceContext;
+
+    // The scheduled demand streams are only opened along the generation
+    if (lTRADEMGEN_ServiceContext.getDemandStreamSchedule().isEmpty() == false) {
+      throw TrademgenGenerationException ("The rolling-horizon demand "
+                                          "generation cannot be run demand "
+                                          "stream by demand stream");
+    }
+
+    // Retrieve the pointer on the SEvMgr service handler.
+    SEVMGR::SEVMGR_ServicePtr_T lSEVMGR_Service_ptr =
+      lTRADEMGEN_ServiceContext.getSEVMGR_ServicePtr();
+
+    // Retrieve the random generator
+    stdair::RandomGeneration& lGenerator =
+      lTRADEMGEN_ServiceContext.getUniformGenerator();
+
+    // Delegate the call to the dedicated command
+    return DemandManager::generateRunByStream (lSEVMGR_Service_ptr, lGenerator,
+                                               iDemandGenerationMethod,
+                                               iNbOfThreads, iAggregationPeriod,
+                                               ioRequestSink);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  stdair::Count_T TRADEMGEN_Service::
+  generateArrivalCounts (ArrivalCountTable& ioArrivalCountTable,
+                         const stdair::DemandGenerationMethod& iDemandGenerationMethod,
+                         const unsigned int iNbOfThreads) const {
+
+    // Retrieve the TraDemGen service context
+    if (_trademgenServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The TraDemGen service has "
+                                                    "not been initialised");
+    }
+    assert (_trademgenServiceContext != NULL);
+    TRADEMGEN_ServiceContext& lTRADEMGEN_ServiceContext =
+      *_trademgenServiceContext;
+
+    // The scheduled demand streams are only opened along the generation
+    if (lTRADEMGEN_ServiceContext.getDemandStreamSchedule().isEmpty() == false) {
+      throw TrademgenGenerationException ("The arrivals cannot be counted for "
+                                          "the rolling-horizon demand "
+                                          "generation");
+    }
+
+    // Retrieve the pointer on the SEvMgr service handler.
+    SEVMGR::SEVMGR_ServicePtr_T lSEVMGR_Service_ptr =
+      lTRADEMGEN_ServiceContext.getSEVMGR_ServicePtr();
+
+    // Retrieve the random generator
+    stdair::RandomGeneration& lGenerator =
+      lTRADEMGEN_ServiceContext.getUniformGenerator();
+
+    // Delegate the call to the dedicated command
+    return DemandManager::generateArrivalCounts (lSEVMGR_Service_ptr, lGenerator,
+                                                 iDemandGenerationMethod,
+                                                 iNbOfThreads,
+                                                 ioArrivalCountTable);
   }
 
   // ////////////////////////////////////////////////////////////////////
@@ -823,10 +1449,388 @@ namespace TRADEMGEN {
     stdair::RandomGeneration& lSharedGenerator =
       lTRADEMGEN_ServiceContext.getUniformGenerator();
     
+    // The scheduled demand streams, if any, are retired, and their total
+    // numbers of requests drawn again
+    DemandStreamSchedule& lDemandStreamSchedule =
+      lTRADEMGEN_ServiceContext.getDemandStreamSchedule();
+    if (lDemandStreamSchedule.isEmpty() == false) {
+      DemandManager::resetRollingHorizon (lSEVMGR_Service_ptr,
+                                          lSharedGenerator.getBaseGenerator(),
+                                          lDemandStreamSchedule);
+      return;
+    }
+
+    // Delegate the call to the dedicated command, which consumes the
+    // total numbers of requests drawn in advance, if any
+    DemandManager::reset (lSEVMGR_Service_ptr,
+                          lSharedGenerator.getBaseGenerator(),
+                          lTRADEMGEN_ServiceContext.
+                          getTotalNumberOfRequestsTable());
+  }  
+
+  // ////////////////////////////////////////////////////////////////////
+  void TRADEMGEN_Service::reseed (const stdair::RandomSeed_T& iRandomSeed) const {
+
+    // Retrieve the TraDemGen service context
+    if (_trademgenServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The TraDemGen service has "
+                                                    "not been initialised");
+    }
+    assert (_trademgenServiceContext != NULL);
+    TRADEMGEN_ServiceContext& lTRADEMGEN_ServiceContext =
+      *_trademgenServiceContext;
+
+    // The scheduled demand streams are seeded when they are scheduled
+    if (lTRADEMGEN_ServiceContext.getDemandStreamSchedule().isEmpty() == false) {
+      throw TrademgenGenerationException ("The demand streams cannot be seeded "
+                                          "again for the rolling-horizon "
+                                          "demand generation");
+    }
+
+    // Retrieve the pointer on the SEvMgr service handler.
+    SEVMGR::SEVMGR_ServicePtr_T lSEVMGR_Service_ptr =
+      lTRADEMGEN_ServiceContext.getSEVMGR_ServicePtr();
+
+    // Retrieve the shared generator
+    stdair::RandomGeneration& lSharedGenerator =
+      lTRADEMGEN_ServiceContext.getUniformGenerator();
+
+    // Delegate the call to the dedicated command, and draw the total
+    // numbers of requests with the new seeds
+    DemandManager::seedDemandStreams (lSEVMGR_Service_ptr, lSharedGenerator,
+                                      iRandomSeed);
+    lTRADEMGEN_ServiceContext.getTotalNumberOfRequestsTable().clear();
+    DemandManager::reset (lSEVMGR_Service_ptr,
+                          lSharedGenerator.getBaseGenerator());
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  stdair::Count_T TRADEMGEN_Service::
+  shardDemand (const unsigned short iShardIndex,
+               const unsigned short iNbOfShards) const {
+
+    // Retrieve the TraDemGen service context
+    if (_trademgenServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The TraDemGen service has "
+                                                    "not been initialised");
+    }
+    assert (_trademgenServiceContext != NULL);
+    TRADEMGEN_ServiceContext& lTRADEMGEN_ServiceContext =
+      *_trademgenServiceContext;
+
+    // The scheduled demand streams are created along the generation
+    if (lTRADEMGEN_ServiceContext.getDemandStreamSchedule().isEmpty() == false) {
+      throw TrademgenGenerationException ("The demand generation cannot be "
+                                          "sharded for the rolling-horizon "
+                                          "demand generation");
+    }
+
+    //
+    if (iNbOfShards != 0 && iShardIndex >= iNbOfShards) {
+      std::ostringstream oMessage;
+      oMessage << "The shard #" << iShardIndex << " does not exist, as there "
+               << "are only " << iNbOfShards << " shards";
+      throw TrademgenGenerationException (oMessage.str());
+    }
+
+    // Retrieve the pointer on the SEvMgr service handler.
+    SEVMGR::SEVMGR_ServicePtr_T lSEVMGR_Service_ptr =
+      lTRADEMGEN_ServiceContext.getSEVMGR_ServicePtr();
+
+    // Delegate the call to the dedicated command
+    lTRADEMGEN_ServiceContext.setShard (iShardIndex, iNbOfShards);
+    return DemandManager::shardDemandStreams (lSEVMGR_Service_ptr, iShardIndex,
+                                              iNbOfShards);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void TRADEMGEN_Service::
+  setRequestFieldMask (const RequestFieldMask& iRequestFieldMask) const {
+
+    // Retrieve the TraDemGen service context
+    if (_trademgenServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The TraDemGen service has "
+                                                    "not been initialised");
+    }
+    assert (_trademgenServiceContext != NULL);
+    TRADEMGEN_ServiceContext& lTRADEMGEN_ServiceContext =
+      *_trademgenServiceContext;
+
+    // The scheduled demand streams are created along the generation
+    if (lTRADEMGEN_ServiceContext.getDemandStreamSchedule().isEmpty() == false) {
+      throw TrademgenGenerationException ("The booking requests cannot be "
+                                          "projected for the rolling-horizon "
+                                          "demand generation");
+    }
+
+    // Retrieve the pointer on the SEvMgr service handler.
+    SEVMGR::SEVMGR_ServicePtr_T lSEVMGR_Service_ptr =
+      lTRADEMGEN_ServiceContext.getSEVMGR_ServicePtr();
+
+    // Delegate the call to the dedicated command
+    lTRADEMGEN_ServiceContext.setRequestFieldMask (true, iRequestFieldMask);
+    DemandManager::projectDemandStreams (lSEVMGR_Service_ptr, true,
+                                         iRequestFieldMask);
+
+    // DEBUG
+    STDAIR_LOG_DEBUG ("Fields of the booking requests: "
+                      << iRequestFieldMask.describe());
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void TRADEMGEN_Service::unsetRequestFieldMask() const {
+
+    // Retrieve the TraDemGen service context
+    if (_trademgenServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The TraDemGen service has "
+                                                    "not been initialised");
+    }
+    assert (_trademgenServiceContext != NULL);
+    TRADEMGEN_ServiceContext& lTRADEMGEN_ServiceContext =
+      *_trademgenServiceContext;
+
+    // Retrieve the pointer on the SEvMgr service handler.
+    SEVMGR::SEVMGR_ServicePtr_T lSEVMGR_Service_ptr =
+      lTRADEMGEN_ServiceContext.getSEVMGR_ServicePtr();
+
     // Delegate the call to the dedicated command
+    const RequestFieldMask lAllFields;
+    lTRADEMGEN_ServiceContext.setRequestFieldMask (false, lAllFields);
+    DemandManager::projectDemandStreams (lSEVMGR_Service_ptr, false,
+                                         lAllFields);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void TRADEMGEN_Service::
+  drawTotalNumberOfRequests (const unsigned int iNbOfRuns) const {
+
+    // Retrieve the TraDemGen service context
+    if (_trademgenServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The TraDemGen service has "
+                                                    "not been initialised");
+    }
+    assert (_trademgenServiceContext != NULL);
+    TRADEMGEN_ServiceContext& lTRADEMGEN_ServiceContext =
+      *_trademgenServiceContext;
+
+    // Retrieve the pointer on the SEvMgr service handler.
+    SEVMGR::SEVMGR_ServicePtr_T lSEVMGR_Service_ptr =
+      lTRADEMGEN_ServiceContext.getSEVMGR_ServicePtr();
+
+    // Retrieve the shared generator
+    stdair::RandomGeneration& lSharedGenerator =
+      lTRADEMGEN_ServiceContext.getUniformGenerator();
+
+    // Delegate the call to the dedicated command
+    DemandManager::
+      drawTotalNumberOfRequests (lSEVMGR_Service_ptr,
+                                 lSharedGenerator.getBaseGenerator(),
+                                 iNbOfRuns,
+                                 lTRADEMGEN_ServiceContext.
+                                 getTotalNumberOfRequestsTable());
+  }
+  // ////////////////////////////////////////////////////////////////////
+  void TRADEMGEN_Service::takeSnapshot() const {
+
+    // Retrieve the TraDemGen service context
+    if (_trademgenServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The TraDemGen service has "
+                                                    "not been initialised");
+    }
+    assert (_trademgenServiceContext != NULL);
+    TRADEMGEN_ServiceContext& lTRADEMGEN_ServiceContext =
+      *_trademgenServiceContext;
+
+    // Retrieve the pointer on the SEvMgr service handler.
+    SEVMGR::SEVMGR_ServicePtr_T lSEVMGR_Service_ptr =
+      lTRADEMGEN_ServiceContext.getSEVMGR_ServicePtr();
+
+    // Retrieve the shared generator
+    stdair::RandomGeneration& lSharedGenerator =
+      lTRADEMGEN_ServiceContext.getUniformGenerator();
+
+    // Delegate the call to the dedicated command
+    DemandManager::takeSnapshot (lSEVMGR_Service_ptr,
+                                 lSharedGenerator.getBaseGenerator(),
+                                 lTRADEMGEN_ServiceContext.
+                                 getDemandStreamSnapshot());
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  stdair::Count_T TRADEMGEN_Service::restoreSnapshot() const {
+
+    // Retrieve the TraDemGen service context
+    if (_trademgenServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The TraDemGen service has "
+                                                    "not been initialised");
+    }
+    assert (_trademgenServiceContext != NULL);
+    TRADEMGEN_ServiceContext& lTRADEMGEN_ServiceContext =
+      *_trademgenServiceContext;
+
+    // Retrieve the pointer on the SEvMgr service handler.
+    SEVMGR::SEVMGR_ServicePtr_T lSEVMGR_Service_ptr =
+      lTRADEMGEN_ServiceContext.getSEVMGR_ServicePtr();
+
+    // Retrieve the shared generator
+    stdair::RandomGeneration& lSharedGenerator =
+      lTRADEMGEN_ServiceContext.getUniformGenerator();
+
+    // Delegate the call to the dedicated command
+    return DemandManager::restoreSnapshot (lSEVMGR_Service_ptr,
+                                           lSharedGenerator.getBaseGenerator(),
+                                           lTRADEMGEN_ServiceContext.
+                                           getDemandStreamSnapshot());
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void TRADEMGEN_Service::
+  checkpoint (const stdair::Filename_T& iFilename) const {
+
+    // Retrieve the TraDemGen service context
+    if (_trademgenServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The TraDemGen service has "
+                                                    "not been initialised");
+    }
+    assert (_trademgenServiceContext != NULL);
+    TRADEMGEN_ServiceContext& lTRADEMGEN_ServiceContext =
+      *_trademgenServiceContext;
+
+    // Retrieve the pointer on the SEvMgr service handler.
+    SEVMGR::SEVMGR_ServicePtr_T lSEVMGR_Service_ptr =
+      lTRADEMGEN_ServiceContext.getSEVMGR_ServicePtr();
+
+    // Retrieve the shared generator
+    stdair::RandomGeneration& lSharedGenerator =
+      lTRADEMGEN_ServiceContext.getUniformGenerator();
+
+    // Delegate the call to the dedicated command
+    DemandManager::saveCheckpoint (lSEVMGR_Service_ptr,
+                                   lSharedGenerator.getBaseGenerator(),
+                                   iFilename);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  void TRADEMGEN_Service::restore (const stdair::Filename_T& iFilename) const {
+
+    // Retrieve the TraDemGen service context
+    if (_trademgenServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The TraDemGen service has "
+                                                    "not been initialised");
+    }
+    assert (_trademgenServiceContext != NULL);
+    TRADEMGEN_ServiceContext& lTRADEMGEN_ServiceContext =
+      *_trademgenServiceContext;
+
+    // Retrieve the pointer on the SEvMgr service handler.
+    SEVMGR::SEVMGR_ServicePtr_T lSEVMGR_Service_ptr =
+      lTRADEMGEN_ServiceContext.getSEVMGR_ServicePtr();
+
+    // Retrieve the shared generator
+    stdair::RandomGeneration& lSharedGenerator =
+      lTRADEMGEN_ServiceContext.getUniformGenerator();
+
+    // Delegate the call to the dedicated command
+    DemandManager::restoreCheckpoint (lSEVMGR_Service_ptr,
+                                      lSharedGenerator.getBaseGenerator(),
+                                      iFilename);
+  }
+
+
+  // ////////////////////////////////////////////////////////////////////
+  stdair::Count_T TRADEMGEN_Service::
+  adjustDemand (const DemandAdjustmentStruct& iAdjustment) const {
+
+    // Retrieve the TraDemGen service context
+    if (_trademgenServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The TraDemGen service has "
+                                                    "not been initialised");
+    }
+    assert (_trademgenServiceContext != NULL);
+    TRADEMGEN_ServiceContext& lTRADEMGEN_ServiceContext =
+      *_trademgenServiceContext;
+
+    // Retrieve the pointer on the SEvMgr service handler.
+    SEVMGR::SEVMGR_ServicePtr_T lSEVMGR_Service_ptr =
+      lTRADEMGEN_ServiceContext.getSEVMGR_ServicePtr();
+
+    // The demand distribution of a demand stream shared by several
+    // cabins cannot be split among them
+    if (lTRADEMGEN_ServiceContext.isMultiCabinDemand() == true
+        && iAdjustment._prefCabin.empty() == false) {
+      throw TrademgenGenerationException ("The demand cannot be adjusted by "
+                                          "cabin when the cabins share their "
+                                          "demand streams");
+    }
+
+    // The totals drawn in advance, if any, follow the former demand
+    // distributions
+    lTRADEMGEN_ServiceContext.getTotalNumberOfRequestsTable().clear();
+
+    // Delegate the call to the dedicated command
+    return DemandManager::adjustDemandDistributions (lSEVMGR_Service_ptr,
+                                                     iAdjustment);
+  }
+
+  // ////////////////////////////////////////////////////////////////////
+  stdair::Count_T TRADEMGEN_Service::
+  generateScenarios (const DemandScenarioList_T& iScenarioList,
+                     const unsigned int iNbOfRuns,
+                     const stdair::DemandGenerationMethod& iDemandGenerationMethod) const {
+
+    // Retrieve the TraDemGen service context
+    if (_trademgenServiceContext == NULL) {
+      throw stdair::NonInitialisedServiceException ("The TraDemGen service has "
+                                                    "not been initialised");
+    }
+    assert (_trademgenServiceContext != NULL);
+    TRADEMGEN_ServiceContext& lTRADEMGEN_ServiceContext =
+      *_trademgenServiceContext;
+
+    // Retrieve the pointer on the SEvMgr service handler.
+    SEVMGR::SEVMGR_ServicePtr_T lSEVMGR_Service_ptr =
+      lTRADEMGEN_ServiceContext.getSEVMGR_ServicePtr();
+
+    // The demand distribution of a demand stream shared by several
+    // cabins cannot be split among them
+    if (lTRADEMGEN_ServiceContext.isMultiCabinDemand() == true) {
+      for (DemandScenarioList_T::const_iterator itScenario =
+             iScenarioList.begin(); itScenario != iScenarioList.end();
+           ++itScenario) {
+        const DemandAdjustmentList_T& lAdjustmentList =
+          itScenario->_adjustmentList;
+        for (DemandAdjustmentList_T::const_iterator itAdjustment =
+               lAdjustmentList.begin(); itAdjustment != lAdjustmentList.end();
+             ++itAdjustment) {
+          if (itAdjustment->_prefCabin.empty() == false) {
+            throw TrademgenGenerationException ("The demand cannot be "
+                                                "adjusted by cabin when the "
+                                                "cabins share their demand "
+                                                "streams");
+          }
+        }
+      }
+    }
+
+    // Retrieve the shared generator
+    stdair::RandomGeneration& lSharedGenerator =
+      lTRADEMGEN_ServiceContext.getUniformGenerator();
+
+    // Delegate the call to the dedicated command
+    const stdair::Count_T oNbOfRequests =
+      DemandManager::generateScenarios (lSEVMGR_Service_ptr, lSharedGenerator,
+                                        iScenarioList, iNbOfRuns,
+                                        iDemandGenerationMethod);
+
+    // Leave the demand generation ready for another one. The totals
+    // drawn in advance, if any, are forgotten, as the random generators
+    // have been seeded again.
+    lTRADEMGEN_ServiceContext.getTotalNumberOfRequestsTable().clear();
     DemandManager::reset (lSEVMGR_Service_ptr,
                           lSharedGenerator.getBaseGenerator());
-  }  
+
+    return oNbOfRequests;
+  }
 
   //////////////////////////////////////////////////////////////////////
   const stdair::ProgressStatus& TRADEMGEN_Service::getProgressStatus() const {    
@@ -881,6 +1885,20 @@ namespace TRADEMGEN {
                                                   stdair::DemandStreamKeyStr_T>(iDemandStreamKey);
   }
 
+  //////////////////////////////////////////////////////////////////////
+  stdair::Count_T TRADEMGEN_Service::getNbOfOpenDemandStreams() const {
+
+    // Retrieve the TraDemGen service context
+    assert (_trademgenServiceContext != NULL);
+    TRADEMGEN_ServiceContext& lTRADEMGEN_ServiceContext =
+      *_trademgenServiceContext;
+
+    //
+    const DemandStreamSchedule& lDemandStreamSchedule =
+      lTRADEMGEN_ServiceContext.getDemandStreamSchedule();
+    return lDemandStreamSchedule.getOpenDemandStreamList().size();
+  }
+
   //////////////////////////////////////////////////////////////////////
   std::string TRADEMGEN_Service::displayDemandStream () const {
 
@@ -16,21 +16,27 @@ namespace TRADEMGEN {
   // //////////////////////////////////////////////////////////////////////
   TRADEMGEN_ServiceContext::TRADEMGEN_ServiceContext ()
     : _ownStdairService (false), _uniformGenerator (stdair::DEFAULT_RANDOM_SEED),
-      _posProbabilityMass (DEFAULT_POS_PROBALILITY_MASS) {
+      _posProbabilityMass (DEFAULT_POS_PROBALILITY_MASS), _shardIndex (0),
+      _nbOfShards (0), _isMultiCabinDemand (false),
+      _isProjected (false) {
   }
 
   // //////////////////////////////////////////////////////////////////////
   TRADEMGEN_ServiceContext::
   TRADEMGEN_ServiceContext (const TRADEMGEN_ServiceContext& iServiceContext)
     : _ownStdairService (false), _uniformGenerator (stdair::DEFAULT_RANDOM_SEED),
-      _posProbabilityMass (DEFAULT_POS_PROBALILITY_MASS) {
+      _posProbabilityMass (DEFAULT_POS_PROBALILITY_MASS), _shardIndex (0),
+      _nbOfShards (0), _isMultiCabinDemand (false),
+      _isProjected (false) {
   }
 
   // //////////////////////////////////////////////////////////////////////
   TRADEMGEN_ServiceContext::
   TRADEMGEN_ServiceContext (const stdair::RandomSeed_T& iRandomSeed)
     : _ownStdairService (false), _uniformGenerator (iRandomSeed),
-      _posProbabilityMass (DEFAULT_POS_PROBALILITY_MASS) {
+      _posProbabilityMass (DEFAULT_POS_PROBALILITY_MASS), _shardIndex (0),
+      _nbOfShards (0), _isMultiCabinDemand (false),
+      _isProjected (false) {
   }
 
   // //////////////////////////////////////////////////////////////////////
@@ -69,6 +75,32 @@ namespace TRADEMGEN {
 
     // Reset the sevmgr shared pointer
     _sevmgrService.reset();
+
+    // Forget about the loaded demands
+    _loadedDemandModelList.clear();
+
+    // Forget about the total numbers of requests drawn in advance
+    _totalNumberOfRequestsTable.clear();
+
+    // Forget about the snapshot of the demand streams
+    _demandStreamSnapshot.clear();
+
+    // Forget about the schedule of the demand streams
+    _demandStreamSchedule.clear();
+
+    // Forget about the shard
+    _shardIndex = 0;
+    _nbOfShards = 0;
+
+    // Forget about the selection of the demand streams
+    _demandFilter = DemandFilterStruct();
+
+    // Back to one demand stream per cabin
+    _isMultiCabinDemand = false;
+
+    // Back to drawing all the fields of the booking requests
+    _isProjected = false;
+    _requestFieldMask = RequestFieldMask();
   }
 
 }
@@ -19,6 +19,12 @@
 // TraDemGen
 #include <trademgen/TRADEMGEN_Types.hpp>
 #include <trademgen/basic/DemandCharacteristicsTypes.hpp>
+#include <trademgen/basic/RequestFieldMask.hpp>
+#include <trademgen/basic/TotalNumberOfRequestsTable.hpp>
+#include <trademgen/bom/DemandFilterStruct.hpp>
+#include <trademgen/bom/DemandStreamSchedule.hpp>
+#include <trademgen/bom/DemandStreamSnapshot.hpp>
+#include <trademgen/command/CompiledDemandModel.hpp>
 
 // Forward declarations
 namespace stdair {
@@ -93,6 +99,80 @@ namespace TRADEMGEN {
       return *_sevmgrService;
     }
 
+    /**
+     * Get the (compiled) demands loaded so far, in the order in which
+     * they have been loaded.
+     */
+    const CompiledDemandModelList_T& getLoadedDemandModelList() const {
+      return _loadedDemandModelList;
+    }
+
+    /**
+     * Get the total numbers of requests drawn in advance for the
+     * subsequent resets.
+     */
+    TotalNumberOfRequestsTable& getTotalNumberOfRequestsTable() {
+      return _totalNumberOfRequestsTable;
+    }
+
+    /**
+     * Get the snapshot of the generation state of the demand streams.
+     */
+    DemandStreamSnapshot& getDemandStreamSnapshot() {
+      return _demandStreamSnapshot;
+    }
+
+    /**
+     * Get the schedule of the demand streams, for the rolling-horizon
+     * demand generation.
+     */
+    DemandStreamSchedule& getDemandStreamSchedule() {
+      return _demandStreamSchedule;
+    }
+
+    /**
+     * Get the index of the shard generated by the current process.
+     */
+    const unsigned short& getShardIndex() const {
+      return _shardIndex;
+    }
+
+    /**
+     * Get the number of shards (0 when the generation is not sharded).
+     */
+    const unsigned short& getNbOfShards() const {
+      return _nbOfShards;
+    }
+
+    /**
+     * Get the selection of the demand streams to be loaded.
+     */
+    const DemandFilterStruct& getDemandFilter() const {
+      return _demandFilter;
+    }
+
+    /**
+     * State whether the cabins share their demand streams.
+     */
+    bool isMultiCabinDemand() const {
+      return _isMultiCabinDemand;
+    }
+
+    /**
+     * State whether the fields of the booking requests are projected.
+     */
+    bool isProjected() const {
+      return _isProjected;
+    }
+
+    /**
+     * Get the fields of the booking requests to be drawn, when they are
+     * projected.
+     */
+    const RequestFieldMask& getRequestFieldMask() const {
+      return _requestFieldMask;
+    }
+
     
   private:
     // ///////// Setters //////////
@@ -112,6 +192,56 @@ namespace TRADEMGEN {
       _sevmgrService = ioSEVMGR_ServicePtr;
     }
 
+    /**
+     * Append the given (compiled) demands to the ones loaded so far.
+     */
+    void addLoadedDemandModelList (const CompiledDemandModelList_T& iDemandModelList) {
+      _loadedDemandModelList.insert (_loadedDemandModelList.end(),
+                                     iDemandModelList.begin(),
+                                     iDemandModelList.end());
+    }
+
+    /**
+     * Replace the (compiled) demands loaded so far, e.g., when the
+     * demand input files are reloaded.
+     */
+    void setLoadedDemandModelList (const CompiledDemandModelList_T& iDemandModelList) {
+      _loadedDemandModelList = iDemandModelList;
+    }
+
+    /**
+     * Set the shard generated by the current process.
+     */
+    void setShard (const unsigned short iShardIndex,
+                   const unsigned short iNbOfShards) {
+      _shardIndex = iShardIndex;
+      _nbOfShards = iNbOfShards;
+    }
+
+    /**
+     * Set the selection of the demand streams to be loaded.
+     */
+    void setDemandFilter (const DemandFilterStruct& iDemandFilter) {
+      _demandFilter = iDemandFilter;
+    }
+
+    /**
+     * Set whether the cabins share their demand streams.
+     */
+    void setMultiCabinDemand (const bool iIsMultiCabinDemand) {
+      _isMultiCabinDemand = iIsMultiCabinDemand;
+    }
+
+    /**
+     * Set whether the fields of the booking requests are projected, and
+     * onto which ones.
+     */
+    void setRequestFieldMask (const bool iIsProjected,
+                              const RequestFieldMask& iRequestFieldMask) {
+      _isProjected = iIsProjected;
+      _requestFieldMask = iRequestFieldMask;
+    }
+
     
   private:
     // ///////// Display Methods //////////
@@ -189,6 +319,59 @@ namespace TRADEMGEN {
      * POS probability mass, used when the POS is 'RoW'.
      */
     const POSProbabilityMass_T _posProbabilityMass;
+
+    /**
+     * Demands loaded so far (from the demand input files or from the
+     * compiled demand models), kept so that the demand input files can
+     * be reloaded incrementally.
+     */
+    CompiledDemandModelList_T _loadedDemandModelList;
+
+    /**
+     * Total numbers of requests drawn in advance, consumed by the
+     * subsequent resets.
+     */
+    TotalNumberOfRequestsTable _totalNumberOfRequestsTable;
+
+    /**
+     * Snapshot of the generation state of the demand streams, restored
+     * by restoreSnapshot().
+     */
+    DemandStreamSnapshot _demandStreamSnapshot;
+
+    /**
+     * Schedule of the demand streams, filled by parseAndSchedule()
+     * (empty unless the rolling-horizon demand generation is used).
+     */
+    DemandStreamSchedule _demandStreamSchedule;
+
+    /**
+     * Shard generated by the current process, set by
+     * TRADEMGEN_Service::shardDemand() (no shard by default).
+     */
+    unsigned short _shardIndex;
+    unsigned short _nbOfShards;
+
+    /**
+     * Selection of the demand streams to be loaded, set by
+     * TRADEMGEN_Service::setDemandFilter() (all of them by default).
+     */
+    DemandFilterStruct _demandFilter;
+
+    /**
+     * Whether the cabins of a given origin, destination and preferred
+     * departure date share a single demand stream, set by
+     * TRADEMGEN_Service::setMultiCabinDemand() (no by default).
+     */
+    bool _isMultiCabinDemand;
+
+    /**
+     * Whether the fields of the booking requests are projected, and
+     * onto which ones, set by TRADEMGEN_Service::setRequestFieldMask()
+     * (all the fields being drawn, as usual, by default).
+     */
+    bool _isProjected;
+    RequestFieldMask _requestFieldMask;
   };
 
 }